@@ -0,0 +1,70 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Licensed as a Memgraph Enterprise file under the Memgraph Enterprise
+// License (the "License"); by using this file, you agree to be bound by the terms of the License, and you may not use
+// this file except in compliance with the License. You may obtain a copy of the License at https://memgraph.com/legal.
+//
+//
+
+#include <gflags/gflags.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "audit/encoding.hpp"
+#include "utils/logging.hpp"
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(input, "", "Path to the binary audit log file (audit.bin).");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(output, "", "Path to the text audit log file. The text is written to stdout if it isn't set.");
+
+namespace {
+
+constexpr size_t kReadSize = 1U << 20U;
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  gflags::SetUsageMessage("Convert a binary Memgraph audit log to the text audit log format.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  MG_ASSERT(!FLAGS_input.empty(), "The --input flag is required!");
+  std::ifstream input(FLAGS_input, std::ios::binary);
+  MG_ASSERT(input.is_open(), "Couldn't open the audit log file {}!", FLAGS_input);
+
+  std::ofstream output_file;
+  if (!FLAGS_output.empty()) {
+    output_file.open(FLAGS_output);
+    MG_ASSERT(output_file.is_open(), "Couldn't open the output file {}!", FLAGS_output);
+  }
+  auto &output = FLAGS_output.empty() ? std::cout : output_file;
+
+  std::string magic(memgraph::audit::kBinaryMagic.size(), '\0');
+  input.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+  MG_ASSERT(input && magic == memgraph::audit::kBinaryMagic, "{} isn't a binary audit log file!", FLAGS_input);
+
+  // The file is read in large chunks. A record that spans two chunks is kept
+  // in the buffer until the rest of it is read.
+  std::string buffer;
+  uint64_t records = 0;
+  while (input) {
+    const auto size = buffer.size();
+    buffer.resize(size + kReadSize);
+    input.read(buffer.data() + size, kReadSize);
+    buffer.resize(size + input.gcount());
+
+    std::string_view data = buffer;
+    while (auto record = memgraph::audit::DecodeRecord(&data)) {
+      output << memgraph::audit::FormatRecord(*record);
+      ++records;
+    }
+    buffer.erase(0, buffer.size() - data.size());
+  }
+  MG_ASSERT(buffer.empty(), "The audit log file {} ends with a truncated record!", FLAGS_input);
+  spdlog::info("Converted {} audit log records.", records);
+
+  return 0;
+}
@@ -0,0 +1,238 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Licensed as a Memgraph Enterprise file under the Memgraph Enterprise
+// License (the "License"); by using this file, you agree to be bound by the terms of the License, and you may not use
+// this file except in compliance with the License. You may obtain a copy of the License at https://memgraph.com/legal.
+//
+//
+
+#include "audit/encoding.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <json/json.hpp>
+
+#include "storage/v2/temporal.hpp"
+#include "utils/string.hpp"
+#include "utils/temporal.hpp"
+
+namespace memgraph::audit {
+
+namespace {
+
+// Markers of the encoded property values. Booleans are encoded in the marker
+// so they take a single byte.
+enum class Marker : uint8_t {
+  NULL_VALUE = 0,
+  BOOL_FALSE = 1,
+  BOOL_TRUE = 2,
+  INT = 3,
+  DOUBLE = 4,
+  STRING = 5,
+  LIST = 6,
+  MAP = 7,
+  TEMPORAL_DATA = 8,
+};
+
+template <typename T>
+void Write(std::string *buffer, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto size = buffer->size();
+  buffer->resize(size + sizeof(T));
+  memcpy(buffer->data() + size, &value, sizeof(T));
+}
+
+void WriteString(std::string *buffer, std::string_view value) {
+  Write(buffer, static_cast<uint32_t>(value.size()));
+  buffer->append(value);
+}
+
+void WriteValue(std::string *buffer, const storage::PropertyValue &value) {
+  switch (value.type()) {
+    case storage::PropertyValue::Type::Null:
+      Write(buffer, Marker::NULL_VALUE);
+      break;
+    case storage::PropertyValue::Type::Bool:
+      Write(buffer, value.ValueBool() ? Marker::BOOL_TRUE : Marker::BOOL_FALSE);
+      break;
+    case storage::PropertyValue::Type::Int:
+      Write(buffer, Marker::INT);
+      Write(buffer, value.ValueInt());
+      break;
+    case storage::PropertyValue::Type::Double:
+      Write(buffer, Marker::DOUBLE);
+      Write(buffer, value.ValueDouble());
+      break;
+    case storage::PropertyValue::Type::String:
+      Write(buffer, Marker::STRING);
+      WriteString(buffer, value.ValueString());
+      break;
+    case storage::PropertyValue::Type::List:
+      Write(buffer, Marker::LIST);
+      Write(buffer, static_cast<uint32_t>(value.ValueList().size()));
+      for (const auto &item : value.ValueList()) {
+        WriteValue(buffer, item);
+      }
+      break;
+    case storage::PropertyValue::Type::Map:
+      Write(buffer, Marker::MAP);
+      Write(buffer, static_cast<uint32_t>(value.ValueMap().size()));
+      for (const auto &[key, item] : value.ValueMap()) {
+        WriteString(buffer, key);
+        WriteValue(buffer, item);
+      }
+      break;
+    case storage::PropertyValue::Type::TemporalData: {
+      const auto temporal_data = value.ValueTemporalData();
+      Write(buffer, Marker::TEMPORAL_DATA);
+      Write(buffer, temporal_data.type);
+      Write(buffer, temporal_data.microseconds);
+      break;
+    }
+  }
+}
+
+template <typename T>
+std::optional<T> Read(std::string_view *data) {
+  if (data->size() < sizeof(T)) return std::nullopt;
+  T value;
+  memcpy(&value, data->data(), sizeof(T));
+  data->remove_prefix(sizeof(T));
+  return value;
+}
+
+std::optional<std::string_view> ReadString(std::string_view *data) {
+  auto size = Read<uint32_t>(data);
+  if (!size || data->size() < *size) return std::nullopt;
+  auto value = data->substr(0, *size);
+  data->remove_prefix(*size);
+  return value;
+}
+
+std::string TemporalDataToString(storage::TemporalType type, int64_t microseconds) {
+  std::stringstream ss;
+  switch (type) {
+    case storage::TemporalType::Date:
+      ss << utils::Date(microseconds);
+      break;
+    case storage::TemporalType::Duration:
+      ss << utils::Duration(microseconds);
+      break;
+    case storage::TemporalType::LocalTime:
+      ss << utils::LocalTime(microseconds);
+      break;
+    case storage::TemporalType::LocalDateTime:
+      ss << utils::LocalDateTime(microseconds);
+      break;
+  }
+  return ss.str();
+}
+
+// Converts an encoded property value to `nlohmann::json` and advances `data`
+// past it.
+nlohmann::json ReadValueAsJson(std::string_view *data) {
+  const auto malformed = [] { return std::invalid_argument("Malformed audit log record parameters!"); };
+  auto marker = Read<Marker>(data);
+  if (!marker) throw malformed();
+  switch (*marker) {
+    case Marker::NULL_VALUE:
+      return {};
+    case Marker::BOOL_FALSE:
+      return false;
+    case Marker::BOOL_TRUE:
+      return true;
+    case Marker::INT: {
+      auto value = Read<int64_t>(data);
+      if (!value) throw malformed();
+      return *value;
+    }
+    case Marker::DOUBLE: {
+      auto value = Read<double>(data);
+      if (!value) throw malformed();
+      return *value;
+    }
+    case Marker::STRING: {
+      auto value = ReadString(data);
+      if (!value) throw malformed();
+      return std::string(*value);
+    }
+    case Marker::LIST: {
+      auto size = Read<uint32_t>(data);
+      if (!size) throw malformed();
+      auto ret = nlohmann::json::array();
+      for (uint32_t i = 0; i < *size; ++i) {
+        ret.push_back(ReadValueAsJson(data));
+      }
+      return ret;
+    }
+    case Marker::MAP: {
+      auto size = Read<uint32_t>(data);
+      if (!size) throw malformed();
+      auto ret = nlohmann::json::object();
+      for (uint32_t i = 0; i < *size; ++i) {
+        auto key = ReadString(data);
+        if (!key) throw malformed();
+        ret.push_back(nlohmann::json::object_t::value_type(std::string(*key), ReadValueAsJson(data)));
+      }
+      return ret;
+    }
+    case Marker::TEMPORAL_DATA: {
+      auto type = Read<storage::TemporalType>(data);
+      auto microseconds = Read<int64_t>(data);
+      if (!type || !microseconds) throw malformed();
+      return TemporalDataToString(*type, *microseconds);
+    }
+  }
+  throw malformed();
+}
+
+}  // namespace
+
+void EncodeRecord(std::string *buffer, int64_t timestamp, std::string_view address, std::string_view username,
+                  std::string_view query, const storage::PropertyValue &params) {
+  // The sizes of the record and of the parameters are written once they are
+  // encoded.
+  const auto begin = buffer->size();
+  Write(buffer, uint32_t{0});
+  Write(buffer, timestamp);
+  WriteString(buffer, address);
+  WriteString(buffer, username);
+  WriteString(buffer, query);
+  Write(buffer, uint32_t{0});
+  const auto params_begin = buffer->size();
+  WriteValue(buffer, params);
+  const auto params_size = static_cast<uint32_t>(buffer->size() - params_begin);
+  memcpy(buffer->data() + params_begin - sizeof(uint32_t), &params_size, sizeof(uint32_t));
+  const auto size = static_cast<uint32_t>(buffer->size() - begin - sizeof(uint32_t));
+  memcpy(buffer->data() + begin, &size, sizeof(uint32_t));
+}
+
+std::optional<Record> DecodeRecord(std::string_view *data) {
+  auto rest = *data;
+  auto size = Read<uint32_t>(&rest);
+  if (!size || rest.size() < *size) return std::nullopt;
+  auto payload = rest.substr(0, *size);
+  rest.remove_prefix(*size);
+
+  auto timestamp = Read<int64_t>(&payload);
+  auto address = ReadString(&payload);
+  auto username = ReadString(&payload);
+  auto query = ReadString(&payload);
+  auto params = ReadString(&payload);
+  if (!timestamp || !address || !username || !query || !params || !payload.empty()) return std::nullopt;
+  *data = rest;
+  return Record{*timestamp, *address, *username, *query, *params};
+}
+
+std::string FormatRecord(const Record &record) {
+  auto params = record.params;
+  auto json = ReadValueAsJson(&params);
+  if (!params.empty()) throw std::invalid_argument("Malformed audit log record parameters!");
+  return fmt::format("{}.{:06d},{},{},{},{}\n", record.timestamp / 1000000, record.timestamp % 1000000, record.address,
+                     record.username, utils::Escape(record.query), utils::Escape(json.dump()));
+}
+
+}  // namespace memgraph::audit
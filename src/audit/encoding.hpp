@@ -0,0 +1,49 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Licensed as a Memgraph Enterprise file under the Memgraph Enterprise
+// License (the "License"); by using this file, you agree to be bound by the terms of the License, and you may not use
+// this file except in compliance with the License. You may obtain a copy of the License at https://memgraph.com/legal.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "storage/v2/property_value.hpp"
+
+namespace memgraph::audit {
+
+/// Every binary audit log file starts with this magic. The last byte is the
+/// version of the format.
+inline constexpr std::string_view kBinaryMagic{"MGAUDIT\x01", 8};
+
+/// A decoded audit log record. The views point into the data the record was
+/// decoded from. The query parameters are kept in the compact binary form
+/// until they are formatted.
+struct Record {
+  int64_t timestamp;
+  std::string_view address;
+  std::string_view username;
+  std::string_view query;
+  std::string_view params;
+};
+
+/// Appends a length-prefixed audit log record to `buffer`. This is the format
+/// used both in the in-memory buffers and in the binary audit log file.
+void EncodeRecord(std::string *buffer, int64_t timestamp, std::string_view address, std::string_view username,
+                  std::string_view query, const storage::PropertyValue &params);
+
+/// Decodes the record at the beginning of `data` and advances `data` past it.
+/// Returns `std::nullopt` if the data is truncated or malformed.
+std::optional<Record> DecodeRecord(std::string_view *data);
+
+/// Formats the record as a line of the text audit log: a CSV line with the
+/// timestamp, address, username, query and the query parameters as JSON.
+/// @throw std::invalid_argument if the parameters are malformed
+std::string FormatRecord(const Record &record);
+
+}  // namespace memgraph::audit
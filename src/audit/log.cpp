@@ -8,89 +8,40 @@
 
 #include "audit/log.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <sstream>
+#include <thread>
+#include <utility>
 
-#include <fmt/format.h>
-#include <json/json.hpp>
-
-#include "storage/v2/temporal.hpp"
+#include "audit/encoding.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/logging.hpp"
-#include "utils/string.hpp"
+
+namespace EventCounter {
+extern const Event AuditRecordsDropped;
+extern const Event AuditBufferFullWaits;
+}  // namespace EventCounter
 
 namespace memgraph::audit {
 
-// Helper function that converts a `storage::PropertyValue` to `nlohmann::json`.
-inline nlohmann::json PropertyValueToJson(const storage::PropertyValue &pv) {
-  nlohmann::json ret;
-  switch (pv.type()) {
-    case storage::PropertyValue::Type::Null:
-      break;
-    case storage::PropertyValue::Type::Bool:
-      ret = pv.ValueBool();
-      break;
-    case storage::PropertyValue::Type::Int:
-      ret = pv.ValueInt();
-      break;
-    case storage::PropertyValue::Type::Double:
-      ret = pv.ValueDouble();
-      break;
-    case storage::PropertyValue::Type::String:
-      ret = pv.ValueString();
-      break;
-    case storage::PropertyValue::Type::List: {
-      ret = nlohmann::json::array();
-      for (const auto &item : pv.ValueList()) {
-        ret.push_back(PropertyValueToJson(item));
-      }
-      break;
-    }
-    case storage::PropertyValue::Type::Map: {
-      ret = nlohmann::json::object();
-      for (const auto &item : pv.ValueMap()) {
-        ret.push_back(nlohmann::json::object_t::value_type(item.first, PropertyValueToJson(item.second)));
-      }
-      break;
-    }
-    case storage::PropertyValue::Type::TemporalData: {
-      const auto temporal_data = pv.ValueTemporalData();
-      auto to_string = [](auto temporal_data) {
-        std::stringstream ss;
-        const auto ms = temporal_data.microseconds;
-        switch (temporal_data.type) {
-          case storage::TemporalType::Date: {
-            const auto date = utils::Date(ms);
-            ss << date;
-            return ss.str();
-          }
-          case storage::TemporalType::Duration: {
-            const auto dur = utils::Duration(ms);
-            ss << dur;
-            return ss.str();
-          }
-          case storage::TemporalType::LocalTime: {
-            const auto lt = utils::LocalTime(ms);
-            ss << lt;
-            return ss.str();
-          }
-          case storage::TemporalType::LocalDateTime: {
-            const auto ldt = utils::LocalDateTime(ms);
-            ss << ldt;
-            return ss.str();
-          }
-        }
-      };
-      ret = to_string(temporal_data);
-      break;
-    }
-  }
-  return ret;
-}
+namespace {
 
-Log::Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis)
+// Entries that grew larger than this aren't kept for reuse after they are
+// flushed, so a single huge query doesn't pin its memory.
+constexpr size_t kMaxReusedEntrySize = 4096;
+
+}  // namespace
+
+std::atomic<uint64_t> Log::next_log_id_{1};
+thread_local Log::CachedBuffer Log::local_buffer_;
+
+Log::Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis,
+         Format format, bool drop_on_full)
     : storage_directory_(storage_directory),
       buffer_size_(buffer_size),
       buffer_flush_interval_millis_(buffer_flush_interval_millis),
+      format_(format),
+      drop_on_full_(drop_on_full),
       started_(false) {}
 
 void Log::Start() {
@@ -98,7 +49,6 @@ void Log::Start() {
 
   utils::EnsureDirOrDie(storage_directory_);
 
-  buffer_.emplace(buffer_size_);
   started_ = true;
 
   ReopenLog();
@@ -115,32 +65,122 @@ Log::~Log() {
   Flush();
 }
 
+Log::Buffer *Log::LocalBuffer() {
+  if (local_buffer_.log_id == log_id_) return local_buffer_.buffer.get();
+  auto buffer = std::make_shared<Buffer>();
+  {
+    std::lock_guard<std::mutex> guard(buffers_lock_);
+    buffers_.push_back(buffer);
+  }
+  local_buffer_ = {log_id_, std::move(buffer)};
+  return local_buffer_.buffer.get();
+}
+
 void Log::Record(const std::string &address, const std::string &username, const std::string &query,
                  const storage::PropertyValue &params) {
   if (!started_.load(std::memory_order_relaxed)) return;
   auto timestamp =
       std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
           .count();
-  buffer_->emplace(Item{timestamp, address, username, query, params});
+  auto reserve = [this] {
+    if (buffered_.fetch_add(1, std::memory_order_acq_rel) < static_cast<uint64_t>(buffer_size_)) return true;
+    buffered_.fetch_sub(1, std::memory_order_acq_rel);
+    return false;
+  };
+  if (!reserve()) {
+    if (drop_on_full_) {
+      EventCounter::IncrementCounter(EventCounter::AuditRecordsDropped);
+      return;
+    }
+    EventCounter::IncrementCounter(EventCounter::AuditBufferFullWaits);
+    SPDLOG_WARN("Audit log buffer full: worker waiting");
+    do {
+      std::this_thread::sleep_for(std::chrono::microseconds(250));
+    } while (!reserve());
+  }
+  auto *buffer = LocalBuffer();
+  std::lock_guard<utils::SpinLock> guard(buffer->lock);
+  if (buffer->size == buffer->entries.size()) buffer->entries.emplace_back();
+  auto &entry = buffer->entries[buffer->size];
+  entry.clear();
+  EncodeRecord(&entry, timestamp, address, username, query, params);
+  ++buffer->size;
 }
 
 void Log::ReopenLog() {
   if (!started_.load(std::memory_order_relaxed)) return;
   std::lock_guard<std::mutex> guard(lock_);
   if (log_.IsOpen()) log_.Close();
-  log_.Open(storage_directory_ / "audit.log", utils::OutputFile::Mode::APPEND_TO_EXISTING);
+  if (format_ == Format::BINARY) {
+    log_.Open(storage_directory_ / "audit.bin", utils::OutputFile::Mode::APPEND_TO_EXISTING);
+    if (log_.GetSize() == 0) log_.Write(kBinaryMagic);
+  } else {
+    log_.Open(storage_directory_ / "audit.log", utils::OutputFile::Mode::APPEND_TO_EXISTING);
+  }
 }
 
 void Log::Flush() {
   std::lock_guard<std::mutex> guard(lock_);
-  for (uint64_t i = 0; i < buffer_size_; ++i) {
-    auto item = buffer_->pop();
-    if (!item) break;
-    log_.Write(fmt::format("{}.{:06d},{},{},{},{}\n", item->timestamp / 1000000, item->timestamp % 1000000,
-                           item->address, item->username, utils::Escape(item->query),
-                           utils::Escape(PropertyValueToJson(item->params).dump())));
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  {
+    std::lock_guard<std::mutex> buffers_guard(buffers_lock_);
+    // A buffer that is owned only by the log belongs to a thread that exited,
+    // so it is freed once everything in it was written.
+    std::erase_if(buffers_, [](const auto &buffer) {
+      if (buffer.use_count() != 1) return false;
+      std::lock_guard<utils::SpinLock> buffer_guard(buffer->lock);
+      return buffer->size == 0;
+    });
+    buffers = buffers_;
+  }
+
+  // Collect the entries of all threads so they can be written in a single
+  // batch ordered by their timestamps.
+  std::vector<std::pair<int64_t, std::string_view>> entries;
+  std::vector<std::pair<Buffer *, uint64_t>> flushed;
+  for (const auto &buffer : buffers) {
+    uint64_t size = 0;
+    {
+      std::lock_guard<utils::SpinLock> buffer_guard(buffer->lock);
+      if (buffer->size == 0) continue;
+      std::swap(buffer->entries, buffer->flushed);
+      size = std::exchange(buffer->size, 0);
+    }
+    for (uint64_t i = 0; i < size; ++i) {
+      std::string_view data = buffer->flushed[i];
+      auto record = DecodeRecord(&data);
+      MG_ASSERT(record, "Invalid audit log entry!");
+      entries.emplace_back(record->timestamp, buffer->flushed[i]);
+    }
+    flushed.emplace_back(buffer.get(), size);
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto &first, const auto &second) { return first.first < second.first; });
+
+  std::string batch;
+  for (auto [timestamp, data] : entries) {
+    if (format_ == Format::BINARY) {
+      batch.append(data);
+    } else {
+      batch.append(FormatRecord(*DecodeRecord(&data)));
+    }
   }
+  if (!batch.empty()) log_.Write(batch);
   log_.Sync();
+
+  // Keep only as many entries as were recorded since the last flush, so the
+  // memory of a burst is released once it is written.
+  uint64_t written = 0;
+  for (auto [buffer, size] : flushed) {
+    auto &strings = buffer->flushed;
+    strings.resize(size);
+    if (strings.capacity() > 2 * size) strings.shrink_to_fit();
+    for (auto &entry : strings) {
+      if (entry.capacity() > kMaxReusedEntrySize) std::string().swap(entry);
+    }
+    written += size;
+  }
+  buffered_.fetch_sub(written, std::memory_order_acq_rel);
 }
 
 }  // namespace memgraph::audit
@@ -10,12 +10,15 @@
 
 #include <atomic>
 #include <filesystem>
-#include <optional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
-#include "data_structures/ring_buffer.hpp"
 #include "storage/v2/property_value.hpp"
 #include "utils/file.hpp"
 #include "utils/scheduler.hpp"
+#include "utils/spin_lock.hpp"
 
 namespace memgraph::audit {
 
@@ -24,18 +27,29 @@ const uint64_t kBufferFlushIntervalMillisDefault = 200;
 
 /// This class implements an audit log. Functions used for logging are
 /// thread-safe, functions used for setup aren't thread-safe.
+///
+/// Every thread that records entries appends them to its own buffer, so
+/// recording contends only with the flush and never with other threads. The
+/// total number of buffered entries is limited across all threads. The entries
+/// are encoded in a compact binary form when they are recorded and are only
+/// converted to text when they are flushed. Entries of different threads are
+/// ordered by their timestamps within each flush.
 class Log {
- private:
-  struct Item {
-    int64_t timestamp;
-    std::string address;
-    std::string username;
-    std::string query;
-    storage::PropertyValue params;
+ public:
+  enum class Format : uint8_t {
+    // CSV lines with the query parameters as JSON, written to `audit.log`.
+    TEXT,
+    // Length-prefixed binary records, written to `audit.bin`. The records can
+    // be converted to text using the `mg_audit_convert` tool.
+    BINARY,
   };
 
- public:
-  Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis);
+  /// `buffer_size` is the maximum number of entries that are buffered by all
+  /// threads together. If `drop_on_full` is set, entries are dropped when the
+  /// limit is reached, otherwise the recording thread waits until the buffers
+  /// are flushed.
+  Log(const std::filesystem::path &storage_directory, int32_t buffer_size, int32_t buffer_flush_interval_millis,
+      Format format = Format::TEXT, bool drop_on_full = false);
 
   ~Log();
 
@@ -57,14 +71,49 @@ class Log {
   void ReopenLog();
 
  private:
+  // Encoded entries of a single thread. The owning thread appends entries and
+  // the flush swaps them with the entries it wrote the last time, so the lock
+  // is contended only for the swap. The strings are reused, so recording
+  // doesn't allocate once the buffer is warmed up.
+  struct Buffer {
+    utils::SpinLock lock;
+    // The first `size` strings are recorded entries, the rest are kept for
+    // reuse.
+    std::vector<std::string> entries;
+    uint64_t size{0};
+    // Entries that were swapped out by the flush. Accessed only by the flush.
+    std::vector<std::string> flushed;
+  };
+
+  struct CachedBuffer {
+    uint64_t log_id{0};
+    // The buffer is shared with the log, so the log frees it once it is the
+    // only owner left, i.e. after the thread exited.
+    std::shared_ptr<Buffer> buffer;
+  };
+
+  Buffer *LocalBuffer();
+
   void Flush();
 
   std::filesystem::path storage_directory_;
   int32_t buffer_size_;
   int32_t buffer_flush_interval_millis_;
+  Format format_;
+  bool drop_on_full_;
   std::atomic<bool> started_;
+  // Number of entries that are recorded but not yet written.
+  std::atomic<uint64_t> buffered_{0};
+
+  // Cached buffers are tagged with the ID of the log so that buffers of a
+  // destroyed log are never used.
+  static std::atomic<uint64_t> next_log_id_;
+  static thread_local CachedBuffer local_buffer_;
+  const uint64_t log_id_{next_log_id_.fetch_add(1, std::memory_order_relaxed)};
+
+  std::mutex buffers_lock_;
+  std::vector<std::shared_ptr<Buffer>> buffers_;
 
-  std::optional<RingBuffer<Item>> buffer_;
   utils::Scheduler scheduler_;
 
   utils::OutputFile log_;
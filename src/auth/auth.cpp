@@ -196,6 +196,7 @@ void Auth::SaveUser(const User &user) {
   if (!success) {
     throw AuthException("Couldn't save user '{}'!", user.username());
   }
+  version_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 std::optional<User> Auth::AddUser(const std::string &username, const std::optional<std::string> &password) {
@@ -216,6 +217,7 @@ bool Auth::RemoveUser(const std::string &username_orig) {
   if (!storage_.DeleteMultiple(keys)) {
     throw AuthException("Couldn't remove user '{}'!", username);
   }
+  version_.fetch_add(1, std::memory_order_acq_rel);
   return true;
 }
 
@@ -253,6 +255,7 @@ void Auth::SaveRole(const Role &role) {
   if (!storage_.Put(kRolePrefix + role.rolename(), role.Serialize().dump())) {
     throw AuthException("Couldn't save role '{}'!", role.rolename());
   }
+  version_.fetch_add(1, std::memory_order_acq_rel);
 }
 
 std::optional<Role> Auth::AddRole(const std::string &rolename) {
@@ -278,6 +281,7 @@ bool Auth::RemoveRole(const std::string &rolename_orig) {
   if (!storage_.DeleteMultiple(keys)) {
     throw AuthException("Couldn't remove role '{}'!", rolename);
   }
+  version_.fetch_add(1, std::memory_order_acq_rel);
   return true;
 }
 
@@ -315,4 +319,18 @@ std::vector<auth::User> Auth::AllUsersForRole(const std::string &rolename_orig)
   return ret;
 }
 
+CompiledPermissions Auth::CompilePermissions(const std::optional<std::string> &username) const {
+  // The version is read first, so the compiled permissions are recompiled if
+  // the data changes while they are being compiled.
+  CompiledPermissions compiled{.version = version_.load(std::memory_order_acquire), .has_users = HasUsers()};
+  if (username) {
+    if (auto user = GetUser(*username)) {
+      compiled.permissions = user->GetPermissions();
+    }
+  }
+  return compiled;
+}
+
+const std::atomic<uint64_t> &Auth::version() const { return version_; }
+
 }  // namespace memgraph::auth
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -19,6 +21,18 @@
 #include "utils/settings.hpp"
 
 namespace memgraph::auth {
+/**
+ * Permissions of a user compiled from the permissions of the user and the
+ * user's role, together with the version of the auth data they were compiled
+ * from. The compiled permissions stay valid until the version changes.
+ */
+struct CompiledPermissions {
+  uint64_t version;
+  bool has_users;
+  // `std::nullopt` if the user doesn't exist.
+  std::optional<Permissions> permissions;
+};
+
 /**
  * This class serves as the main Authentication/Authorization storage.
  * It provides functions for managing Users, Roles and Permissions.
@@ -155,11 +169,31 @@ class Auth final {
    */
   std::vector<User> AllUsersForRole(const std::string &rolename) const;
 
+  /**
+   * Compiles the permissions of a user.
+   *
+   * @param username
+   *
+   * @return the compiled permissions, which don't contain any permissions if
+   *         the username isn't given or the user doesn't exist
+   * @throw AuthException if unable to load user data.
+   */
+  CompiledPermissions CompilePermissions(const std::optional<std::string> &username) const;
+
+  /**
+   * Returns the version of the auth data. The version is incremented whenever
+   * a user or a role is saved or removed, so it can be used to check whether
+   * compiled permissions are still valid. The counter can be read without
+   * holding a lock on the `Auth` object.
+   */
+  const std::atomic<uint64_t> &version() const;
+
  private:
   // Even though the `kvstore::KVStore` class is guaranteed to be thread-safe,
   // Auth is not thread-safe because modifying users and roles might require
   // more than one operation on the storage.
   kvstore::KVStore storage_;
   auth::Module module_;
+  std::atomic<uint64_t> version_{0};
 };
 }  // namespace memgraph::auth
@@ -85,7 +85,11 @@ class Session {
    */
   virtual std::map<std::string, Value> Discard(std::optional<int> n, std::optional<int> qid) = 0;
 
-  virtual void BeginTransaction() = 0;
+  /**
+   * Begin an explicit transaction. `read_only` is set if the client has
+   * declared that the transaction won't modify the database.
+   */
+  virtual void BeginTransaction(bool read_only) = 0;
   virtual void CommitTransaction() = 0;
   virtual void RollbackTransaction() = 0;
 
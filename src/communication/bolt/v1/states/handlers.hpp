@@ -330,8 +330,13 @@ State HandleBegin(TSession &session, const State state, const Marker marker) {
     return State::Close;
   }
 
+  // Drivers send mode "r" for transactions that only read data.
+  const auto &extra_map = extra.ValueMap();
+  const bool read_only =
+      extra_map.count("mode") && extra_map.at("mode").IsString() && extra_map.at("mode").ValueString() == "r";
+
   try {
-    session.BeginTransaction();
+    session.BeginTransaction(read_only);
   } catch (const std::exception &e) {
     return HandleFailure(session, e);
   }
@@ -0,0 +1,122 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "communication/metrics/prometheus.hpp"
+
+#include <cctype>
+
+#include <fmt/format.h>
+
+#include "utils/event_counter.hpp"
+#include "utils/event_gauge.hpp"
+#include "utils/event_histogram.hpp"
+
+namespace memgraph::communication::metrics {
+namespace {
+constexpr double kMicrosecondsInSecond = 1000000.0;
+
+std::string EscapeLabelValue(std::string_view value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (const auto c : value) {
+    if (c == '\\') {
+      escaped += "\\\\";
+    } else if (c == '"') {
+      escaped += "\\\"";
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void AppendHeader(std::string *out, std::string_view name, std::string_view documentation, std::string_view type) {
+  fmt::format_to(std::back_inserter(*out), "# HELP {} {}\n# TYPE {} {}\n", name, documentation, name, type);
+}
+}  // namespace
+
+std::string MetricName(std::string_view name) {
+  std::string ret = "memgraph_";
+  for (size_t i = 0; i < name.size(); ++i) {
+    const auto c = static_cast<unsigned char>(name[i]);
+    if (std::isupper(c)) {
+      // Acronyms such as `GC` are kept together.
+      const bool previous_lower = i > 0 && !std::isupper(static_cast<unsigned char>(name[i - 1]));
+      const bool next_lower = i + 1 < name.size() && std::islower(static_cast<unsigned char>(name[i + 1]));
+      if (i > 0 && (previous_lower || next_lower)) ret += '_';
+      ret += static_cast<char>(std::tolower(c));
+    } else {
+      ret += static_cast<char>(c);
+    }
+  }
+  return ret;
+}
+
+std::string RenderMetrics(const std::vector<Sample> &samples) {
+  std::string out;
+  auto inserter = std::back_inserter(out);
+
+  for (EventCounter::Event i = 0; i < EventCounter::End(); ++i) {
+    const auto name = MetricName(EventCounter::GetName(i)) + "_total";
+    AppendHeader(&out, name, EventCounter::GetDocumentation(i), "counter");
+    fmt::format_to(inserter, "{} {}\n", name, EventCounter::global_counters[i].load(std::memory_order_relaxed));
+  }
+
+  for (EventGauge::Event i = 0; i < EventGauge::End(); ++i) {
+    const auto name = MetricName(EventGauge::GetName(i));
+    AppendHeader(&out, name, EventGauge::GetDocumentation(i), "gauge");
+    fmt::format_to(inserter, "{} {}\n", name, EventGauge::global_gauges[i].load(std::memory_order_relaxed));
+  }
+
+  for (EventHistogram::Event i = 0; i < EventHistogram::End(); ++i) {
+    const auto name = MetricName(EventHistogram::GetName(i)) + "_seconds";
+    const auto &histogram = EventHistogram::global_histograms[i];
+    AppendHeader(&out, name, EventHistogram::GetDocumentation(i), "histogram");
+    // The buckets are read one by one while other threads keep measuring, so
+    // the count is computed from the buckets to keep them consistent.
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < EventHistogram::Histogram::kNumBounds; ++bucket) {
+      cumulative += histogram.BucketCount(bucket);
+      fmt::format_to(inserter, "{}_bucket{{le=\"{}\"}} {}\n", name,
+                     static_cast<double>(EventHistogram::Histogram::UpperBound(bucket)) / kMicrosecondsInSecond,
+                     cumulative);
+    }
+    cumulative += histogram.BucketCount(EventHistogram::Histogram::kNumBounds);
+    fmt::format_to(inserter, "{}_bucket{{le=\"+Inf\"}} {}\n", name, cumulative);
+    fmt::format_to(inserter, "{}_sum {}\n", name, static_cast<double>(histogram.Sum()) / kMicrosecondsInSecond);
+    fmt::format_to(inserter, "{}_count {}\n", name, cumulative);
+  }
+
+  const std::string *previous_name{nullptr};
+  for (const auto &sample : samples) {
+    const auto name = MetricName(sample.name);
+    if (!previous_name || *previous_name != sample.name) {
+      AppendHeader(&out, name, sample.documentation, "gauge");
+      previous_name = &sample.name;
+    }
+    out += name;
+    if (!sample.labels.empty()) {
+      out += '{';
+      for (size_t i = 0; i < sample.labels.size(); ++i) {
+        if (i > 0) out += ',';
+        fmt::format_to(inserter, "{}=\"{}\"", sample.labels[i].first, EscapeLabelValue(sample.labels[i].second));
+      }
+      out += '}';
+    }
+    fmt::format_to(inserter, " {}\n", sample.value);
+  }
+
+  return out;
+}
+
+}  // namespace memgraph::communication::metrics
@@ -0,0 +1,38 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace memgraph::communication::metrics {
+
+/// Value of a gauge which is computed when the metrics are scraped.
+struct Sample {
+  std::string name;
+  std::string documentation;
+  std::vector<std::pair<std::string, std::string>> labels;
+  double value;
+};
+
+/// Converts a CamelCase event name into a Prometheus metric name with the
+/// `memgraph_` prefix.
+std::string MetricName(std::string_view name);
+
+/// Renders the global event counters, gauges and histograms together with the
+/// given samples in the Prometheus text exposition format (version 0.0.4).
+/// Samples with the same name must be adjacent.
+std::string RenderMetrics(const std::vector<Sample> &samples);
+
+}  // namespace memgraph::communication::metrics
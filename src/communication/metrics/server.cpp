@@ -0,0 +1,198 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "communication/metrics/server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+#include <boost/beast/http.hpp>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::communication::metrics {
+namespace {
+namespace http = boost::beast::http;
+
+constexpr const char *kMetricsTarget = "/metrics";
+constexpr const char *kContentType = "text/plain; version=0.0.4";
+constexpr auto kSessionTimeout = std::chrono::seconds(30);
+constexpr auto kMinAcceptBackoff = std::chrono::milliseconds(10);
+constexpr auto kMaxAcceptBackoff = std::chrono::milliseconds(1000);
+
+void LogError(boost::beast::error_code ec, const std::string_view what) {
+  spdlog::warn("Metrics server failed on {}: {}", what, ec.message());
+}
+
+class Session : public std::enable_shared_from_this<Session> {
+ public:
+  Session(boost::asio::ip::tcp::socket &&socket, const Server::Collector &collector)
+      : stream_(std::move(socket)), collector_(collector) {}
+
+  void Run() { DoRead(); }
+
+ private:
+  void DoRead() {
+    request_ = {};
+    stream_.expires_after(kSessionTimeout);
+    http::async_read(stream_, buffer_, request_,
+                     [shared_this = shared_from_this()](auto ec, auto /*bytes*/) { shared_this->OnRead(ec); });
+  }
+
+  void OnRead(boost::beast::error_code ec) {
+    if (ec == http::error::end_of_stream) {
+      return DoClose();
+    }
+    if (ec) {
+      return LogError(ec, "read");
+    }
+
+    response_ = {};
+    response_.version(request_.version());
+    response_.keep_alive(request_.keep_alive());
+    response_.set(http::field::server, "Memgraph Metrics");
+    if (request_.method() != http::verb::get && request_.method() != http::verb::head) {
+      response_.result(http::status::method_not_allowed);
+    } else if (request_.target() != kMetricsTarget) {
+      response_.result(http::status::not_found);
+    } else {
+      response_.result(http::status::ok);
+      response_.set(http::field::content_type, kContentType);
+      if (request_.method() == http::verb::get) {
+        response_.body() = RenderMetrics(collector_ ? collector_() : std::vector<Sample>{});
+      }
+    }
+    response_.prepare_payload();
+
+    http::async_write(stream_, response_,
+                      [shared_this = shared_from_this()](auto ec, auto /*bytes*/) { shared_this->OnWrite(ec); });
+  }
+
+  void OnWrite(boost::beast::error_code ec) {
+    if (ec) {
+      return LogError(ec, "write");
+    }
+    if (!response_.keep_alive()) {
+      return DoClose();
+    }
+    DoRead();
+  }
+
+  void DoClose() {
+    boost::beast::error_code ec;
+    stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
+  }
+
+  boost::beast::tcp_stream stream_;
+  boost::beast::flat_buffer buffer_;
+  http::request<http::string_body> request_;
+  http::response<http::string_body> response_;
+  const Server::Collector &collector_;
+};
+}  // namespace
+
+Server::Server(io::network::Endpoint endpoint, Collector collector)
+    : acceptor_(ioc_), accept_timer_(ioc_), collector_(std::move(collector)) {
+  const tcp::endpoint tcp_endpoint{boost::asio::ip::make_address(endpoint.address), endpoint.port};
+  boost::beast::error_code ec;
+  // On failure the acceptor is closed, so the server isn't started.
+  auto fail = [&](const std::string_view what) {
+    LogError(ec, what);
+    boost::beast::error_code close_ec;
+    acceptor_.close(close_ec);
+  };
+
+  acceptor_.open(tcp_endpoint.protocol(), ec);
+  if (ec) {
+    fail("open");
+    return;
+  }
+
+  acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
+  if (ec) {
+    fail("set_option");
+    return;
+  }
+
+  acceptor_.bind(tcp_endpoint, ec);
+  if (ec) {
+    fail("bind");
+    return;
+  }
+
+  acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+  if (ec) {
+    fail("listen");
+    return;
+  }
+
+  spdlog::info("Metrics server is listening on {}:{}", endpoint.address, acceptor_.local_endpoint().port());
+}
+
+Server::~Server() {
+  MG_ASSERT(!background_thread_ || (ioc_.stopped() && !background_thread_->joinable()),
+            "Server wasn't shutdown properly");
+}
+
+void Server::Start() {
+  MG_ASSERT(!background_thread_, "The server was already started!");
+  if (!acceptor_.is_open()) {
+    spdlog::warn("Metrics server isn't started because it couldn't listen for connections.");
+    return;
+  }
+  DoAccept();
+  background_thread_.emplace([this] { ioc_.run(); });
+}
+
+void Server::Shutdown() { ioc_.stop(); }
+
+void Server::AwaitShutdown() {
+  if (background_thread_ && background_thread_->joinable()) {
+    background_thread_->join();
+  }
+}
+
+bool Server::IsRunning() const { return background_thread_ && !ioc_.stopped(); }
+
+boost::asio::ip::tcp::endpoint Server::GetEndpoint() const { return acceptor_.local_endpoint(); }
+
+void Server::DoAccept() {
+  acceptor_.async_accept([this](auto ec, auto socket) { OnAccept(ec, std::move(socket)); });
+}
+
+void Server::OnAccept(boost::beast::error_code ec, tcp::socket socket) {
+  if (ec == boost::asio::error::operation_aborted) {
+    return;
+  }
+  // A failed accept (e.g. because of too many open files) only drops that
+  // connection, the server keeps accepting new ones after a backoff which
+  // doubles with every consecutive failure.
+  if (ec) {
+    LogError(ec, "accept");
+    accept_backoff_ = std::clamp(accept_backoff_ * 2, kMinAcceptBackoff, kMaxAcceptBackoff);
+    accept_timer_.expires_after(accept_backoff_);
+    accept_timer_.async_wait([this](auto timer_ec) {
+      if (timer_ec == boost::asio::error::operation_aborted) {
+        return;
+      }
+      DoAccept();
+    });
+    return;
+  }
+  accept_backoff_ = std::chrono::milliseconds(0);
+  std::make_shared<Session>(std::move(socket), collector_)->Run();
+  DoAccept();
+}
+
+}  // namespace memgraph::communication::metrics
@@ -0,0 +1,70 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+
+#include "communication/metrics/prometheus.hpp"
+#include "io/network/endpoint.hpp"
+
+namespace memgraph::communication::metrics {
+
+/// HTTP server which serves the metrics in the Prometheus text format on
+/// `GET /metrics`. All connections are handled by a single background thread
+/// because scrapes are rare and cheap.
+class Server final {
+  using tcp = boost::asio::ip::tcp;
+
+ public:
+  /// The collector is called on every scrape to compute the samples which
+  /// aren't tracked by the global event counters, gauges and histograms.
+  using Collector = std::function<std::vector<Sample>()>;
+
+  Server(io::network::Endpoint endpoint, Collector collector);
+
+  Server(const Server &) = delete;
+  Server(Server &&) = delete;
+  Server &operator=(const Server &) = delete;
+  Server &operator=(Server &&) = delete;
+
+  ~Server();
+
+  void Start();
+  void Shutdown();
+  void AwaitShutdown();
+  bool IsRunning() const;
+  tcp::endpoint GetEndpoint() const;
+
+ private:
+  void DoAccept();
+  void OnAccept(boost::beast::error_code ec, tcp::socket socket);
+
+  boost::asio::io_context ioc_;
+  tcp::acceptor acceptor_;
+  // After a failed accept the server waits before accepting again, so errors
+  // such as running out of file descriptors don't make it spin.
+  boost::asio::steady_timer accept_timer_;
+  std::chrono::milliseconds accept_backoff_{0};
+  Collector collector_;
+  std::optional<std::thread> background_thread_;
+};
+
+}  // namespace memgraph::communication::metrics
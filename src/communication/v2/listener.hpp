@@ -32,6 +32,7 @@
 #include "communication/v2/session.hpp"
 #include "utils/spin_lock.hpp"
 #include "utils/synchronized.hpp"
+#include "utils/work_stealing_scheduler.hpp"
 
 namespace memgraph::communication::v2 {
 
@@ -59,14 +60,16 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
 
  private:
   Listener(boost::asio::io_context &io_context, TSessionData *data, ServerContext *server_context,
-           tcp::endpoint &endpoint, const std::string_view service_name, const uint64_t inactivity_timeout_sec)
+           tcp::endpoint &endpoint, const std::string_view service_name, const uint64_t inactivity_timeout_sec,
+           utils::WorkStealingScheduler *executor)
       : io_context_(io_context),
         data_(data),
         server_context_(server_context),
         acceptor_(io_context_),
         endpoint_{endpoint},
         service_name_{service_name},
-        inactivity_timeout_{inactivity_timeout_sec} {
+        inactivity_timeout_{inactivity_timeout_sec},
+        executor_{executor} {
     boost::system::error_code ec;
     // Open the acceptor
     acceptor_.open(endpoint.protocol(), ec);
@@ -111,7 +114,7 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
     }
 
     auto session = SessionHandler::Create(std::move(socket), data_, *server_context_, endpoint_, inactivity_timeout_,
-                                          service_name_);
+                                          service_name_, executor_);
     session->Start();
     DoAccept();
   }
@@ -129,6 +132,7 @@ class Listener final : public std::enable_shared_from_this<Listener<TSession, TS
   tcp::endpoint endpoint_;
   std::string_view service_name_;
   std::chrono::seconds inactivity_timeout_;
+  utils::WorkStealingScheduler *executor_;
 
   std::atomic<bool> alive_;
 };
@@ -32,6 +32,7 @@
 #include "utils/logging.hpp"
 #include "utils/message.hpp"
 #include "utils/thread.hpp"
+#include "utils/work_stealing_scheduler.hpp"
 
 namespace memgraph::communication::v2 {
 
@@ -52,6 +53,10 @@ using ServerEndpoint = boost::asio::ip::tcp::endpoint;
  * on a single strand per session. The only exception is write which is
  * synchronous since the nature of the clients conenction is synchronous as
  * well.
+ * Optionally, the received messages can be executed on a work stealing
+ * executor instead of the I/O threads. Then a demanding query occupies only an
+ * executor slot until it is classified as long running, and it never blocks
+ * the io_context.
  *
  * Current Server architecture:
  * incoming connection -> server -> listener -> session
@@ -70,17 +75,18 @@ class Server final {
  public:
   /**
    * Constructs and binds server to endpoint, operates on session data and
-   * invokes workers_count workers
+   * invokes workers_count workers. If the executor is given, the messages are
+   * executed on it and the workers only handle I/O.
    */
   Server(ServerEndpoint &endpoint, TSessionData *session_data, ServerContext *server_context,
          const int inactivity_timeout_sec, const std::string_view service_name,
-         size_t workers_count = std::thread::hardware_concurrency())
+         size_t workers_count = std::thread::hardware_concurrency(), utils::WorkStealingScheduler *executor = nullptr)
       : endpoint_{endpoint},
         service_name_{service_name},
         context_thread_pool_{workers_count},
         listener_{Listener<TSession, TSessionData>::Create(context_thread_pool_.GetIOContext(), session_data,
                                                            server_context, endpoint_, service_name_,
-                                                           inactivity_timeout_sec)} {}
+                                                           inactivity_timeout_sec, executor)} {}
 
   ~Server() { MG_ASSERT(!IsRunning(), "Server wasn't shutdown properly"); }
 
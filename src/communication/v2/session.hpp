@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -27,6 +28,7 @@
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/ssl/stream.hpp>
@@ -45,6 +47,7 @@
 #include "communication/exceptions.hpp"
 #include "utils/logging.hpp"
 #include "utils/variant_helpers.hpp"
+#include "utils/work_stealing_scheduler.hpp"
 
 namespace memgraph::communication::v2 {
 
@@ -312,7 +315,8 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
 
  private:
   explicit Session(tcp::socket &&socket, TSessionData *data, ServerContext &server_context, tcp::endpoint endpoint,
-                   const std::chrono::seconds inactivity_timeout_sec, std::string_view service_name)
+                   const std::chrono::seconds inactivity_timeout_sec, std::string_view service_name,
+                   utils::WorkStealingScheduler *executor = nullptr)
       : socket_(CreateSocket(std::move(socket), server_context)),
         strand_{boost::asio::make_strand(GetExecutor())},
         output_stream_([this](const uint8_t *data, size_t len, bool have_more) { return Write(data, len, have_more); }),
@@ -322,7 +326,8 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
         remote_endpoint_{GetRemoteEndpoint()},
         service_name_{service_name},
         timeout_seconds_(inactivity_timeout_sec),
-        timeout_timer_(GetExecutor()) {
+        timeout_timer_(GetExecutor()),
+        executor_{executor} {
     ExecuteForSocket([](auto &&socket) {
       socket.lowest_layer().set_option(tcp::no_delay(true));                         // enable PSH
       socket.lowest_layer().set_option(boost::asio::socket_base::keep_alive(true));  // enable SO_KEEPALIVE
@@ -383,21 +388,50 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
       }
     }
 
+    if (executor_ != nullptr) {
+      // The messages are executed on the executor so that a long running query
+      // doesn't block the I/O thread, and with it the other sessions. The next
+      // read is issued only after the execution is done, so no other handler of
+      // this session runs in the meantime. The inactivity timeout doesn't apply
+      // while the query is running.
+      timeout_timer_.expires_at(boost::asio::steady_timer::time_point::max());
+      executor_->Schedule([shared_this = shared_from_this()] {
+        const bool success = shared_this->Execute();
+        boost::asio::post(shared_this->strand_, [shared_this, success] {
+          if (success) {
+            shared_this->DoRead();
+          } else {
+            shared_this->DoShutdown();
+          }
+        });
+      });
+      return;
+    }
+
+    if (Execute()) {
+      DoRead();
+    } else {
+      DoShutdown();
+    }
+  }
+
+  /// Executes the received messages. Returns `false` if the session has to
+  /// be shut down.
+  bool Execute() {
     try {
       session_.Execute();
-      DoRead();
+      return true;
     } catch (const SessionClosedException &e) {
       spdlog::info("{} client {}:{} closed the connection.", service_name_, remote_endpoint_.address(),
                    remote_endpoint_.port());
-      DoShutdown();
     } catch (const std::exception &e) {
       spdlog::error(
           "Exception was thrown while processing event in {} session "
           "associated with {}:{}",
           service_name_, remote_endpoint_.address(), remote_endpoint_.port());
       spdlog::debug("Exception message: {}", e.what());
-      DoShutdown();
     }
+    return false;
   }
 
   void OnError(const boost::system::error_code &ec) {
@@ -510,7 +544,9 @@ class Session final : public std::enable_shared_from_this<Session<TSession, TSes
   std::string_view service_name_;
   std::chrono::seconds timeout_seconds_;
   boost::asio::steady_timer timeout_timer_;
-  bool execution_active_{false};
+  utils::WorkStealingScheduler *executor_;
+  // Read by the executor thread that writes the results.
+  std::atomic<bool> execution_active_{false};
   bool has_received_msg_{false};
 };
 }  // namespace memgraph::communication::v2
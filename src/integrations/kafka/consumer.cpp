@@ -108,6 +108,11 @@ int64_t Message::Offset() const {
   return c_message->offset;
 }
 
+int32_t Message::Partition() const {
+  const auto *c_message = message_->c_ptr();
+  return c_message->partition;
+}
+
 Consumer::Consumer(ConsumerInfo info, ConsumerFunction consumer_function)
     : info_{std::move(info)}, consumer_function_(std::move(consumer_function)), cb_(info_.consumer_name) {
   MG_ASSERT(consumer_function_, "Empty consumer function for Kafka consumer");
@@ -388,6 +393,10 @@ void Consumer::StartConsuming() {
           spdlog::warn("Committing offset of consumer {} failed: {}", info_.consumer_name, RdKafka::err2str(err));
           break;
         }
+      } catch (const BatchPartiallyProcessedException &e) {
+        spdlog::warn("Error happened in consumer {} while processing a batch: {}!", info_.consumer_name, e.what());
+        CommitProcessedPartitions(e.Processed());
+        break;
       } catch (const std::exception &e) {
         spdlog::warn("Error happened in consumer {} while processing a batch: {}!", info_.consumer_name, e.what());
         break;
@@ -398,6 +407,20 @@ void Consumer::StartConsuming() {
   });
 }
 
+void Consumer::CommitProcessedPartitions(
+    const std::vector<BatchPartiallyProcessedException::PartitionOffset> &processed) const {
+  std::vector<RdKafka::TopicPartition *> partitions;
+  utils::OnScopeExit clear_partitions([&]() { RdKafka::TopicPartition::destroy(partitions); });
+  partitions.reserve(processed.size());
+  for (const auto &[topic, partition, offset] : processed) {
+    partitions.push_back(RdKafka::TopicPartition::create(topic, partition, offset));
+  }
+  if (const auto err = consumer_->commitSync(partitions); err != RdKafka::ERR_NO_ERROR) {
+    spdlog::warn("Committing offsets of the processed partitions of consumer {} failed: {}", info_.consumer_name,
+                 RdKafka::err2str(err));
+  }
+}
+
 void Consumer::StopConsuming() {
   is_running_.store(false);
   if (thread_.joinable()) thread_.join();
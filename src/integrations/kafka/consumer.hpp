@@ -24,6 +24,8 @@
 
 #include <librdkafka/rdkafka.h>
 #include <librdkafka/rdkafkacpp.h>
+
+#include "integrations/kafka/exceptions.hpp"
 #include "utils/result.hpp"
 
 namespace memgraph::integrations::kafka {
@@ -72,6 +74,9 @@ class Message final {
   /// Returns the offset of the message
   int64_t Offset() const;
 
+  /// Returns the partition of the topic from which the message was consumed.
+  int32_t Partition() const;
+
  private:
   std::unique_ptr<RdKafka::Message> message_;
 };
@@ -160,6 +165,8 @@ class Consumer final : public RdKafka::EventCb {
 
   void StopConsuming();
 
+  void CommitProcessedPartitions(const std::vector<BatchPartiallyProcessedException::PartitionOffset> &processed) const;
+
   class ConsumerRebalanceCb : public RdKafka::RebalanceCb {
    public:
     ConsumerRebalanceCb(std::string consumer_name);
@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "utils/exceptions.hpp"
 
@@ -64,4 +67,26 @@ class TopicNotFoundException : public KafkaStreamException {
   TopicNotFoundException(const std::string_view consumer_name, const std::string_view topic_name)
       : KafkaStreamException("Kafka consumer {} cannot find topic {}", consumer_name, topic_name) {}
 };
+
+/// Thrown by a consumer function which failed after the messages of some of the
+/// partitions of the batch were already processed. The consumer commits the
+/// offsets of those partitions before it stops, so their messages aren't
+/// consumed again when the stream is restarted.
+class BatchPartiallyProcessedException : public KafkaStreamException {
+ public:
+  /// Offset of the first message that wasn't processed in a partition.
+  struct PartitionOffset {
+    std::string topic;
+    int32_t partition;
+    int64_t offset;
+  };
+
+  BatchPartiallyProcessedException(const std::string_view error, std::vector<PartitionOffset> processed)
+      : KafkaStreamException(error), processed_(std::move(processed)) {}
+
+  const std::vector<PartitionOffset> &Processed() const { return processed_; }
+
+ private:
+  std::vector<PartitionOffset> processed_;
+};
 }  // namespace memgraph::integrations::kafka
@@ -107,6 +107,8 @@ std::span<const char> Message::Payload() const {
 
 std::string_view Message::TopicName() const { return message_.getTopicName(); }
 
+int64_t Message::Timestamp() const { return static_cast<int64_t>(message_.getPublishTimestamp()); }
+
 Consumer::Consumer(ConsumerInfo info, ConsumerFunction consumer_function)
     : info_{std::move(info)},
       client_{CreateClient(info_.service_url)},
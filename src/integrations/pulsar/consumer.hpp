@@ -30,6 +30,10 @@ class Message final {
   std::span<const char> Payload() const;
   std::string_view TopicName() const;
 
+  /// Returns the number of milliseconds since the epoch (UTC) when the message
+  /// was published.
+  int64_t Timestamp() const;
+
  private:
   pulsar_client::Message message_;
 
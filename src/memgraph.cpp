@@ -10,6 +10,7 @@
 // licenses/APL.txt.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -24,6 +25,7 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
 
 #include <fmt/format.h>
 #include <gflags/gflags.h>
@@ -33,6 +35,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 #include "communication/bolt/v1/constants.hpp"
+#include "communication/metrics/server.hpp"
 #include "communication/websocket/auth.hpp"
 #include "communication/websocket/server.hpp"
 #include "helpers.hpp"
@@ -51,6 +54,7 @@
 #include "storage/v2/view.hpp"
 #include "telemetry/telemetry.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/event_gauge.hpp"
 #include "utils/file.hpp"
 #include "utils/flag_validation.hpp"
 #include "utils/license.hpp"
@@ -61,10 +65,13 @@
 #include "utils/rw_lock.hpp"
 #include "utils/settings.hpp"
 #include "utils/signals.hpp"
+#include "utils/spin_lock.hpp"
+#include "utils/stat.hpp"
 #include "utils/string.hpp"
 #include "utils/synchronized.hpp"
 #include "utils/sysinfo/memory.hpp"
 #include "utils/terminate_handler.hpp"
+#include "utils/work_stealing_scheduler.hpp"
 #include "version.hpp"
 
 // Communication libraries must be included after query libraries are included.
@@ -92,6 +99,10 @@
 #include "audit/log.hpp"
 #endif
 
+namespace EventGauge {
+extern const Event ActiveBoltSessions;
+}  // namespace EventGauge
+
 namespace {
 std::string GetAllowedEnumValuesString(const auto &mappings) {
   std::vector<std::string> allowed_values;
@@ -140,11 +151,40 @@ DEFINE_VALIDATED_int32(monitoring_port, 7444,
                        "Port on which the websocket server for Memgraph monitoring should listen.",
                        FLAG_IN_RANGE(0, std::numeric_limits<uint16_t>::max()));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(metrics_address, "127.0.0.1",
+              "IP address on which the HTTP server exposing metrics in the Prometheus format should listen. The "
+              "metrics aren't authenticated, so by default they are only served on the loopback interface.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(metrics_port, 9091,
+                       "Port on which the HTTP server exposing metrics in the Prometheus format should listen.",
+                       FLAG_IN_RANGE(0, std::numeric_limits<uint16_t>::max()));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(bolt_num_workers, std::max(std::thread::hardware_concurrency(), 1U),
                        "Number of workers used by the Bolt server. By default, this will be the "
                        "number of processing units available on the machine.",
                        FLAG_IN_RANGE(1, INT32_MAX));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(bolt_query_executor, true,
+            "Execute Bolt queries on a work stealing executor with bolt_num_workers workers instead of "
+            "on the threads that handle the connections. Queries that run for longer than "
+            "bolt_long_query_threshold_ms give up their worker to the short ones. The executor uses at "
+            "most bolt_num_workers + bolt_max_long_queries threads, plus one for every long query that "
+            "waits for the others to finish and every query that waits in the admission queue.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_num_io_workers, std::max(std::thread::hardware_concurrency() / 4, 1U),
+                       "Number of threads that handle the Bolt connections when bolt_query_executor is enabled.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_long_query_threshold_ms, 100,
+                       "Time in milliseconds after which a running query is treated as a long one by the Bolt "
+                       "query executor.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(bolt_max_long_queries, std::max(std::thread::hardware_concurrency(), 1U),
+                       "Maximum number of long queries that the Bolt query executor runs at the same time. "
+                       "Other long queries give up their worker and wait until one of them finishes.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(bolt_session_inactivity_timeout, 1800,
                        "Time in seconds after which inactive Bolt sessions will be "
                        "closed.",
@@ -197,6 +237,16 @@ DEFINE_bool(storage_wal_enabled, false,
 DEFINE_VALIDATED_uint64(storage_snapshot_retention_count, 3, "The number of snapshots that should always be kept.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_snapshot_differential_count, 0,
+                        "The number of differential snapshots, which contain only the data modified since the "
+                        "previous snapshot, that are created after each full snapshot. Set to 0 to always create "
+                        "full snapshots.",
+                        FLAG_IN_RANGE(0, 1000000));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_recovery_thread_count, memgraph::storage::Config::Durability().recovery_thread_count,
+                        "The number of threads used to recover the data from the snapshot and WAL files.",
+                        FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_uint64(storage_wal_file_size_kib, memgraph::storage::Config::Durability().wal_file_size_kibibytes,
                         "Minimum file size of each WAL file.",
                         FLAG_IN_RANGE(1, static_cast<unsigned long>(1000) * 1024));
@@ -207,6 +257,14 @@ DEFINE_VALIDATED_uint64(storage_wal_file_flush_every_n_tx,
                         "WAL file. Set to 1 for fully synchronous operation.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_wal_compression, false,
+            "Controls whether the deltas of the WAL files are compressed once a WAL file is finalized.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_io_uring, false,
+            "Experimental. Controls whether the WAL and snapshot files are written using io_uring. Commits don't "
+            "share submissions, so with many concurrent writers this can be slower than regular system calls. If "
+            "io_uring isn't available regular system calls are used.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(storage_snapshot_on_exit, false, "Controls whether the storage creates another snapshot on exit.");
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -226,6 +284,17 @@ DEFINE_uint32(
     stream_transaction_retry_interval, 500,
     "Retry interval in milliseconds when a stream transformation fails to commit because of conflicting transactions");
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(stream_query_batching, true,
+            "Execute consecutive transformation results with the same query text as a single UNWIND query when the "
+            "query allows it.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int32(stream_partition_threads, 1,
+                       "Number of threads which consume the partitions of a Kafka stream batch in parallel. Each "
+                       "partition is processed in its own transaction, so a batch is no longer committed "
+                       "atomically when this is larger than 1. If a partition fails, the offsets of the partitions "
+                       "that were already committed are committed to Kafka as well.",
+                       FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_string(kafka_bootstrap_servers, "",
               "List of default Kafka brokers as a comma separated list of broker host or host:port.");
 
@@ -243,6 +312,13 @@ DEFINE_VALIDATED_int32(audit_buffer_size, memgraph::audit::kBufferSizeDefault,
 DEFINE_VALIDATED_int32(audit_buffer_flush_interval_ms, memgraph::audit::kBufferFlushIntervalMillisDefault,
                        "Interval (in milliseconds) used for flushing the audit log buffer.",
                        FLAG_IN_RANGE(10, INT32_MAX));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(audit_binary_format, false,
+            "Set to true to write the audit log in a compact binary format to audit.bin instead of audit.log. "
+            "Use mg_audit_convert to convert it to text.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(audit_drop_on_full, false,
+            "Set to true to drop audit log entries when the buffer is full instead of waiting for it to be flushed.");
 #endif
 
 // Query flags.
@@ -252,6 +328,38 @@ DEFINE_double(query_execution_timeout_sec, 600,
               "Maximum allowed query execution time. Queries exceeding this "
               "limit will be aborted. Value of 0 means no limit.");
 
+// Admission control flags. The quotas apply to the Cypher queries of every
+// user separately.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_max_running_per_user, 0,
+              "Maximum number of queries a single user can run at the same time. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_max_memory_per_user_mb, 0,
+              "Maximum sum of the memory limits of the queries a single user runs at the same time, in MiB. "
+              "Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_default_memory_reservation_mb, 0,
+              "Memory in MiB that the admission control reserves for a query without QUERY MEMORY LIMIT.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_max_cpu_time_per_user_ms, 0,
+              "Maximum CPU time in milliseconds the queries of a single user can use in every "
+              "query_cpu_time_window_sec. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(query_cpu_time_window_sec, 60, "Window in which the CPU time of the queries is limited.",
+                        FLAG_IN_RANGE(1, std::numeric_limits<uint32_t>::max()));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_max_queue_wait_ms, 0,
+              "Time in milliseconds a query waits for the quotas of its user before it is rejected. Value of 0 "
+              "means that such queries are rejected right away.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_max_queued_per_user, 0,
+              "Maximum number of queries of a single user that wait for the quotas. Value of 0 means no limit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(query_limit_total_reserved_memory, false,
+            "Controls whether the queries are held back while the memory limits of all running queries would "
+            "exceed the memory limit of the server. Like the quotas, such queries wait for at most "
+            "query_max_queue_wait_ms.");
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_uint64(replication_replica_check_frequency_sec, 1,
               "The time duration between two replica checks/pings. If < 1, replicas will NOT be checked at all. NOTE: "
@@ -816,35 +924,75 @@ class AuthChecker final : public memgraph::query::AuthChecker {
  public:
   explicit AuthChecker(
       memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth)
-      : auth_{auth} {}
+      : auth_{auth}, auth_version_{&auth->ReadLock()->version()} {}
 
   static bool IsUserAuthorized(const memgraph::auth::User &user,
                                const std::vector<memgraph::query::AuthQuery::Privilege> &privileges) {
-    const auto user_permissions = user.GetPermissions();
-    return std::all_of(privileges.begin(), privileges.end(), [&user_permissions](const auto privilege) {
-      return user_permissions.Has(memgraph::glue::PrivilegeToPermission(privilege)) ==
-             memgraph::auth::PermissionLevel::GRANT;
-    });
+    return IsAuthorized(user.GetPermissions(), privileges);
+  }
+
+  static bool IsUserAuthorized(const memgraph::auth::CompiledPermissions &compiled,
+                               const std::vector<memgraph::query::AuthQuery::Privilege> &privileges) {
+    if (!compiled.has_users) {
+      return true;
+    }
+    return compiled.permissions.has_value() && IsAuthorized(*compiled.permissions, privileges);
   }
 
   bool IsUserAuthorized(const std::optional<std::string> &username,
                         const std::vector<memgraph::query::AuthQuery::Privilege> &privileges) const final {
-    std::optional<memgraph::auth::User> maybe_user;
-    {
-      auto locked_auth = auth_->ReadLock();
-      if (!locked_auth->HasUsers()) {
-        return true;
+    // The permissions are compiled once per version of the auth data, so the
+    // auth lock is taken only after a user or a role was changed.
+    const auto version = auth_version_->load(std::memory_order_acquire);
+    auto cached = cache_.WithLock([&](auto &cache) -> std::optional<memgraph::auth::CompiledPermissions> {
+      if (cache.version != version) {
+        return std::nullopt;
       }
-      if (username.has_value()) {
-        maybe_user = locked_auth->GetUser(*username);
+      auto it = cache.permissions.find(username);
+      if (it == cache.permissions.end()) {
+        return std::nullopt;
       }
+      return it->second;
+    });
+    if (!cached) {
+      cached = auth_->ReadLock()->CompilePermissions(username);
+      cache_.WithLock([&](auto &cache) {
+        // The cache only holds the permissions of the newest version, so the
+        // entries of removed users are dropped with the version they were
+        // compiled for.
+        if (cached->version < cache.version) {
+          return;
+        }
+        if (cached->version > cache.version || cache.permissions.size() >= kMaxCachedPermissions) {
+          cache.permissions.clear();
+          cache.version = cached->version;
+        }
+        cache.permissions.insert_or_assign(username, *cached);
+      });
     }
-
-    return maybe_user.has_value() && IsUserAuthorized(*maybe_user, privileges);
+    return IsUserAuthorized(*cached, privileges);
   }
 
  private:
+  static bool IsAuthorized(const memgraph::auth::Permissions &permissions,
+                           const std::vector<memgraph::query::AuthQuery::Privilege> &privileges) {
+    return std::all_of(privileges.begin(), privileges.end(), [&permissions](const auto privilege) {
+      return permissions.Has(memgraph::glue::PrivilegeToPermission(privilege)) ==
+             memgraph::auth::PermissionLevel::GRANT;
+    });
+  }
+
+  // Upper bound on the number of users whose permissions are cached.
+  static constexpr size_t kMaxCachedPermissions = 1024;
+
+  struct PermissionsCache {
+    uint64_t version{0};
+    std::unordered_map<std::optional<std::string>, memgraph::auth::CompiledPermissions> permissions;
+  };
+
   memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth_;
+  const std::atomic<uint64_t> *auth_version_;
+  mutable memgraph::utils::Synchronized<PermissionsCache, memgraph::utils::SpinLock> cache_;
 };
 
 class BoltSession final : public memgraph::communication::bolt::Session<memgraph::communication::v2::InputStream,
@@ -858,16 +1006,25 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
         db_(data->db),
         interpreter_(data->interpreter_context),
         auth_(data->auth),
+        auth_version_(&data->auth->ReadLock()->version()),
 #if MG_ENTERPRISE
         audit_log_(data->audit_log),
 #endif
         endpoint_(endpoint) {
+    EventGauge::IncrementGauge(EventGauge::ActiveBoltSessions);
   }
 
+  BoltSession(const BoltSession &) = delete;
+  BoltSession &operator=(const BoltSession &) = delete;
+  BoltSession(BoltSession &&) = delete;
+  BoltSession &operator=(BoltSession &&) = delete;
+
+  ~BoltSession() override { EventGauge::DecrementGauge(EventGauge::ActiveBoltSessions); }
+
   using memgraph::communication::bolt::Session<memgraph::communication::v2::InputStream,
                                                memgraph::communication::v2::OutputStream>::TEncoder;
 
-  void BeginTransaction() override { interpreter_.BeginTransaction(); }
+  void BeginTransaction(const bool read_only) override { interpreter_.BeginTransaction(read_only); }
 
   void CommitTransaction() override { interpreter_.CommitTransaction(); }
 
@@ -889,7 +1046,7 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
 #endif
     try {
       auto result = interpreter_.Prepare(query, params_pv, username);
-      if (user_ && !AuthChecker::IsUserAuthorized(*user_, result.privileges)) {
+      if (user_ && !IsAuthorized(result.privileges)) {
         interpreter_.Abort();
         throw memgraph::communication::bolt::ClientError(
             "You are not authorized to execute this query! Please contact "
@@ -924,6 +1081,7 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
       return true;
     }
     user_ = locked_auth->Authenticate(username, password);
+    permissions_.reset();
     return user_.has_value();
   }
 
@@ -933,6 +1091,16 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
   }
 
  private:
+  /// Checks the privileges against the permissions of the session's user. The
+  /// permissions are compiled when the session first needs them and again only
+  /// after the auth data changes, so the common path is a single atomic load.
+  bool IsAuthorized(const std::vector<memgraph::query::AuthQuery::Privilege> &privileges) {
+    if (!permissions_ || permissions_->version != auth_version_->load(std::memory_order_acquire)) {
+      permissions_ = auth_->ReadLock()->CompilePermissions(user_->username());
+    }
+    return AuthChecker::IsUserAuthorized(*permissions_, privileges);
+  }
+
   template <typename TStream>
   std::map<std::string, memgraph::communication::bolt::Value> PullResults(TStream &stream, std::optional<int> n,
                                                                           std::optional<int> qid) {
@@ -946,6 +1114,7 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
             case memgraph::storage::Error::DELETED_OBJECT:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               throw memgraph::communication::bolt::ClientError("Unexpected storage error when streaming summary.");
@@ -980,6 +1149,7 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
               throw memgraph::communication::bolt::ClientError("Returning a nonexistent object as a result.");
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
               throw memgraph::communication::bolt::ClientError("Unexpected storage error when streaming results.");
           }
@@ -1000,6 +1170,8 @@ class BoltSession final : public memgraph::communication::bolt::Session<memgraph
   memgraph::query::Interpreter interpreter_;
   memgraph::utils::Synchronized<memgraph::auth::Auth, memgraph::utils::WritePrioritizedRWLock> *auth_;
   std::optional<memgraph::auth::User> user_;
+  const std::atomic<uint64_t> *auth_version_;
+  std::optional<memgraph::auth::CompiledPermissions> permissions_;
 #ifdef MG_ENTERPRISE
   memgraph::audit::Log *audit_log_;
 #endif
@@ -1170,8 +1342,10 @@ int main(int argc, char **argv) {
 
 #ifdef MG_ENTERPRISE
   // Audit log
-  memgraph::audit::Log audit_log{data_directory / "audit", FLAGS_audit_buffer_size,
-                                 FLAGS_audit_buffer_flush_interval_ms};
+  memgraph::audit::Log audit_log{
+      data_directory / "audit", FLAGS_audit_buffer_size, FLAGS_audit_buffer_flush_interval_ms,
+      FLAGS_audit_binary_format ? memgraph::audit::Log::Format::BINARY : memgraph::audit::Log::Format::TEXT,
+      FLAGS_audit_drop_on_full};
   // Start the log if enabled.
   if (FLAGS_audit_enabled) {
     audit_log.Start();
@@ -1193,8 +1367,12 @@ int main(int argc, char **argv) {
       .durability = {.storage_directory = FLAGS_data_directory,
                      .recover_on_startup = FLAGS_storage_recover_on_startup,
                      .snapshot_retention_count = FLAGS_storage_snapshot_retention_count,
+                     .snapshot_differential_count = FLAGS_storage_snapshot_differential_count,
+                     .recovery_thread_count = FLAGS_storage_recovery_thread_count,
                      .wal_file_size_kibibytes = FLAGS_storage_wal_file_size_kib,
                      .wal_file_flush_every_n_tx = FLAGS_storage_wal_file_flush_every_n_tx,
+                     .wal_compression = FLAGS_storage_wal_compression,
+                     .io_uring = FLAGS_storage_io_uring,
                      .snapshot_on_exit = FLAGS_storage_snapshot_on_exit},
       .transaction = {.isolation_level = ParseIsolationLevel()}};
   if (FLAGS_storage_snapshot_interval_sec == 0) {
@@ -1225,7 +1403,17 @@ int main(int argc, char **argv) {
        .default_kafka_bootstrap_servers = FLAGS_kafka_bootstrap_servers,
        .default_pulsar_service_url = FLAGS_pulsar_service_url,
        .stream_transaction_conflict_retries = FLAGS_stream_transaction_conflict_retries,
-       .stream_transaction_retry_interval = std::chrono::milliseconds(FLAGS_stream_transaction_retry_interval)},
+       .stream_transaction_retry_interval = std::chrono::milliseconds(FLAGS_stream_transaction_retry_interval),
+       .stream_query_batching = FLAGS_stream_query_batching,
+       .stream_partition_threads = static_cast<uint32_t>(FLAGS_stream_partition_threads),
+       .admission_control = {.max_running_queries = FLAGS_query_max_running_per_user,
+                             .max_reserved_memory = FLAGS_query_max_memory_per_user_mb * 1024 * 1024,
+                             .max_cpu_time = std::chrono::milliseconds(FLAGS_query_max_cpu_time_per_user_ms),
+                             .cpu_time_window = std::chrono::seconds(FLAGS_query_cpu_time_window_sec),
+                             .default_memory_reservation = FLAGS_query_default_memory_reservation_mb * 1024 * 1024,
+                             .max_queue_wait = std::chrono::milliseconds(FLAGS_query_max_queue_wait_ms),
+                             .max_queued_queries = FLAGS_query_max_queued_per_user,
+                             .limit_total_reserved_memory = FLAGS_query_limit_total_reserved_memory}},
       FLAGS_data_directory};
 #ifdef MG_ENTERPRISE
   SessionData session_data{&db, &interpreter_context, &auth, &audit_log};
@@ -1267,8 +1455,14 @@ int main(int argc, char **argv) {
 
   auto server_endpoint = memgraph::communication::v2::ServerEndpoint{
       boost::asio::ip::address::from_string(FLAGS_bolt_address), static_cast<uint16_t>(FLAGS_bolt_port)};
+  std::optional<memgraph::utils::WorkStealingScheduler> query_executor;
+  if (FLAGS_bolt_query_executor) {
+    query_executor.emplace(FLAGS_bolt_num_workers, FLAGS_bolt_max_long_queries,
+                           std::chrono::milliseconds(FLAGS_bolt_long_query_threshold_ms), "BoltExecutor");
+  }
   ServerT server(server_endpoint, &session_data, &context, FLAGS_bolt_session_inactivity_timeout, service_name,
-                 FLAGS_bolt_num_workers);
+                 query_executor ? FLAGS_bolt_num_io_workers : FLAGS_bolt_num_workers,
+                 query_executor ? &*query_executor : nullptr);
 
   // Setup telemetry
   std::optional<memgraph::telemetry::Telemetry> telemetry;
@@ -1296,8 +1490,49 @@ int main(int argc, char **argv) {
       {FLAGS_monitoring_address, static_cast<uint16_t>(FLAGS_monitoring_port)}, &context, websocket_auth};
   AddLoggerSink(websocket_server.GetLoggingSink());
 
+  memgraph::communication::metrics::Server metrics_server{
+      {FLAGS_metrics_address, static_cast<uint16_t>(FLAGS_metrics_port)},
+      [&db, data_directory = db_config.durability.storage_directory, disk_usage = uint64_t{0},
+       disk_usage_time = std::optional<std::chrono::steady_clock::time_point>{}]() mutable {
+        using memgraph::communication::metrics::Sample;
+        // Walking the data directory is expensive, so the disk usage is
+        // refreshed at most once per minute instead of on every scrape.
+        static constexpr auto kDiskUsageRefreshInterval = std::chrono::minutes(1);
+        auto info = db.GetBaseInfo();
+        const auto now = std::chrono::steady_clock::now();
+        if (!disk_usage_time || now - *disk_usage_time >= kDiskUsageRefreshInterval) {
+          disk_usage = memgraph::utils::GetDirDiskUsage(data_directory);
+          disk_usage_time = now;
+        }
+        std::vector<Sample> samples{
+            {"Vertices", "Number of vertices in the storage.", {}, static_cast<double>(info.vertex_count)},
+            {"Edges", "Number of edges in the storage.", {}, static_cast<double>(info.edge_count)},
+            {"MemoryResidentBytes", "Resident memory of the process in bytes.", {},
+             static_cast<double>(info.memory_usage)},
+            {"MemoryTrackedBytes", "Memory allocated through the memory tracker in bytes.", {},
+             static_cast<double>(memgraph::utils::total_memory_tracker.Amount())},
+            {"MemoryPeakBytes", "Peak memory allocated through the memory tracker in bytes.", {},
+             static_cast<double>(memgraph::utils::total_memory_tracker.Peak())},
+            {"DiskUsageBytes", "Disk space used by the data directory in bytes.", {}, static_cast<double>(disk_usage)}};
+        // A replica that isn't ready is lagging behind the main instance.
+        static constexpr std::array kReplicaStates{
+            std::pair{memgraph::storage::replication::ReplicaState::READY, "ready"},
+            std::pair{memgraph::storage::replication::ReplicaState::REPLICATING, "replicating"},
+            std::pair{memgraph::storage::replication::ReplicaState::RECOVERY, "recovery"},
+            std::pair{memgraph::storage::replication::ReplicaState::INVALID, "invalid"}};
+        for (const auto &replica : db.ReplicasInfo()) {
+          for (const auto &[state, state_name] : kReplicaStates) {
+            samples.push_back({"ReplicaState",
+                               "Current state of the replica, 1 for the state the replica is in.",
+                               {{"replica", replica.name}, {"state", state_name}},
+                               replica.state == state ? 1.0 : 0.0});
+          }
+        }
+        return samples;
+      }};
+
   // Handler for regular termination signals
-  auto shutdown = [&websocket_server, &server, &interpreter_context] {
+  auto shutdown = [&websocket_server, &metrics_server, &server, &interpreter_context] {
     // Server needs to be shutdown first and then the database. This prevents
     // a race condition when a transaction is accepted during server shutdown.
     server.Shutdown();
@@ -1306,15 +1541,21 @@ int main(int argc, char **argv) {
     // queries.
     memgraph::query::Shutdown(&interpreter_context);
     websocket_server.Shutdown();
+    metrics_server.Shutdown();
   };
 
   InitSignalHandlers(shutdown);
 
   MG_ASSERT(server.Start(), "Couldn't start the Bolt server!");
   websocket_server.Start();
+  metrics_server.Start();
 
   server.AwaitShutdown();
   websocket_server.AwaitShutdown();
+  metrics_server.AwaitShutdown();
+  // The queries are aborted by now, so the executor only waits for them to
+  // return before the sessions are destroyed.
+  if (query_executor) query_executor->Shutdown();
 
   memgraph::query::procedure::gModuleRegistry.UnloadAllModules();
 
@@ -12,18 +12,26 @@
 #include <gflags/gflags.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <mutex>
 #include <optional>
 #include <regex>
+#include <span>
+#include <thread>
 #include <unordered_map>
 
 #include "helpers.hpp"
 #include "storage/v2/storage.hpp"
+#include "utils/csv_tokenizer.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/logging.hpp"
 #include "utils/message.hpp"
+#include "utils/spin_lock.hpp"
 #include "utils/string.hpp"
 #include "utils/timer.hpp"
 #include "version.hpp"
@@ -40,6 +48,14 @@ bool ValidateControlCharacter(const char *flagname, const std::string &value) {
   return true;
 }
 
+bool ValidatePositive(const char *flagname, uint64_t value) {
+  if (value == 0) {
+    printf("The argument '%s' must be greater than 0\n", flagname);
+    return false;
+  }
+  return true;
+}
+
 bool ValidateIdTypeOptions(const char *flagname, const std::string &value) {
   std::string upper = memgraph::utils::ToUpperCase(memgraph::utils::Trim(value));
   if (upper != "STRING" && upper != "INTEGER") {
@@ -77,6 +93,13 @@ DEFINE_string(id_type, "STRING",
               "Which data type should be used to store the supplied node IDs. "
               "Possible options are: STRING/INTEGER");
 DEFINE_validator(id_type, &ValidateIdTypeOptions);
+DEFINE_uint64(num_threads, std::max(1U, std::thread::hardware_concurrency()),
+              "Number of threads used to parse the CSV files, to insert the data and to "
+              "create the snapshot.");
+DEFINE_validator(num_threads, &ValidatePositive);
+DEFINE_uint64(chunk_size, 16UL * 1024 * 1024,
+              "Approximate size in bytes of the part of a CSV file that is parsed by a single thread.");
+DEFINE_validator(chunk_size, &ValidatePositive);
 // Arguments `--nodes` and `--relationships` can be input multiple times and are
 // handled with custom parsing.
 DEFINE_string(nodes, "",
@@ -118,6 +141,13 @@ std::vector<std::string> ParseRepeatedFlag(const std::string &flagname, int argc
   return values;
 }
 
+// Number of nodes/relationships that are created in a single transaction.
+constexpr size_t kBatchSize = 10000;
+// Bounds of the delay between retries of a relationship that conflicted with
+// another thread.
+constexpr std::chrono::microseconds kMinRetryBackoff{1};
+constexpr std::chrono::microseconds kMaxRetryBackoff{10000};
+
 // A field describing the CSV column.
 struct Field {
   // Name of the field.
@@ -156,185 +186,91 @@ struct hash<NodeId> {
 
 }  // namespace std
 
+// A concurrent map from CSV node IDs to storage GIDs. The map is split into
+// shards that are locked separately so that many threads can insert nodes at
+// the same time without contending on a single lock. A node ID is first
+// claimed and the GID is assigned once the node is created, so that the
+// duplicates can be resolved before any node is created.
+class NodeIdMap {
+ public:
+  static constexpr size_t kShardCount = 1024;
+
+  static size_t ShardOf(const NodeId &node_id) { return std::hash<NodeId>{}(node_id) % kShardCount; }
+
+  /// Returns `false` if the node ID was already claimed.
+  bool Claim(const NodeId &node_id) {
+    auto &shard = shards_[ShardOf(node_id)];
+    std::lock_guard<memgraph::utils::SpinLock> guard(shard.lock);
+    return shard.map.emplace(node_id, std::nullopt).second;
+  }
+
+  /// The node ID must have been claimed before.
+  void Assign(const NodeId &node_id, memgraph::storage::Gid gid) {
+    auto &shard = shards_[ShardOf(node_id)];
+    std::lock_guard<memgraph::utils::SpinLock> guard(shard.lock);
+    shard.map.at(node_id) = gid;
+  }
+
+  /// This function doesn't take any locks so it must be called only after all
+  /// insertions have finished.
+  std::optional<memgraph::storage::Gid> Find(const NodeId &node_id) const {
+    const auto &shard = shards_[ShardOf(node_id)];
+    auto it = shard.map.find(node_id);
+    if (it == shard.map.end()) return std::nullopt;
+    return it->second;
+  }
+
+ private:
+  struct Shard {
+    memgraph::utils::SpinLock lock;
+    std::unordered_map<NodeId, std::optional<memgraph::storage::Gid>> map;
+  };
+
+  std::array<Shard, kShardCount> shards_;
+};
+
 // Exception used to indicate that something went wrong during data loading.
 class LoadException : public memgraph::utils::BasicException {
  public:
   using memgraph::utils::BasicException::BasicException;
 };
 
-enum class CsvParserState {
-  INITIAL_FIELD,
-  NEXT_FIELD,
-  QUOTING,
-  NOT_QUOTING,
-  EXPECT_DELIMITER,
-};
-
-bool SubstringStartsWith(const std::string_view &str, size_t pos, const std::string_view &what) {
-  return memgraph::utils::StartsWith(memgraph::utils::Substr(str, pos), what);
-}
-
-/// This function reads a row from a CSV stream.
-///
-/// Each CSV field must be divided using the `delimiter` and each CSV field can
-/// either be quoted or unquoted. When the field is quoted, the first and last
-/// character in the field *must* be the quote character. If the field isn't
-/// quoted, and a quote character appears in it, it is treated as a regular
-/// character. If a quote character appears inside a quoted string then the
-/// quote character must be doubled in order to escape it. Line feeds and
-/// carriage returns are ignored in the CSV file, also, the file can't contain a
-/// NULL character.
-///
-/// The function uses the same logic as the standard Python CSV parser. The data
-/// is parsed in the same way as the following snippet:
+/// Reads the next row using the tokenizer. Returns `std::nullopt` if the whole
+/// file was processed. The CSV format that is accepted is described in
+/// `memgraph::csv::Tokenizer`; it matches the standard Python CSV parser with
+/// `strict=True` and the 'excel' dialect:
 /// ```
 /// import csv
 /// for row in csv.reader(stream, strict=True):
 ///     # process `row`
 /// ```
 ///
-/// Python uses 'excel' as the default dialect when parsing CSV files and the
-/// default settings for the CSV parser are:
-///  - delimiter: ','
-///  - doublequote: True
-///  - escapechar: None
-///  - lineterminator: '\r\n'
-///  - quotechar: '"'
-///  - skipinitialspace: False
-///
-/// The above snippet can be expanded to:
-/// ```
-/// import csv
-/// for row in csv.reader(stream, delimiter=',', doublequote=True,
-///                       escapechar=None, lineterminator='\r\n',
-///                       quotechar='"', skipinitialspace=False,
-///                       strict=True):
-///     # process `row`
-/// ```
-///
-/// For more information about the meaning of the above values, see:
-/// https://docs.python.org/3/library/csv.html#csv.Dialect
-///
 /// @throw LoadException
-std::pair<std::vector<std::string>, uint64_t> ReadRow(std::istream &stream) {
-  std::vector<std::string> row;
-  std::string column;
-  uint64_t lines_count = 0;
+std::optional<std::vector<std::string>> ReadRow(memgraph::csv::Tokenizer *tokenizer) {
+  std::vector<std::string_view> fields;
+  auto result = tokenizer->ReadRow(&fields);
+  if (result.HasError()) throw LoadException(result.GetError().message);
+  if (!*result) return std::nullopt;
 
-  auto state = CsvParserState::INITIAL_FIELD;
-
-  do {
-    std::string line;
-    if (!std::getline(stream, line)) {
-      // The whole file was processed.
-      break;
-    }
-    ++lines_count;
-
-    for (size_t i = 0; i < line.size(); ++i) {
-      auto c = line[i];
-
-      // Line feeds and carriage returns are ignored in CSVs.
-      if (c == '\n' || c == '\r') continue;
-      // Null bytes aren't allowed in CSVs.
-      if (c == '\0') throw LoadException("Line contains NULL byte");
-
-      switch (state) {
-        case CsvParserState::INITIAL_FIELD:
-        case CsvParserState::NEXT_FIELD: {
-          if (SubstringStartsWith(line, i, FLAGS_quote)) {
-            // The current field is a quoted field.
-            state = CsvParserState::QUOTING;
-            i += FLAGS_quote.size() - 1;
-          } else if (SubstringStartsWith(line, i, FLAGS_delimiter)) {
-            // The current field has an empty value.
-            row.emplace_back("");
-            state = CsvParserState::NEXT_FIELD;
-            i += FLAGS_delimiter.size() - 1;
-          } else {
-            // The current field is a regular field.
-            column.push_back(c);
-            state = CsvParserState::NOT_QUOTING;
-          }
-          break;
-        }
-        case CsvParserState::QUOTING: {
-          auto quote_now = SubstringStartsWith(line, i, FLAGS_quote);
-          auto quote_next = SubstringStartsWith(line, i + FLAGS_quote.size(), FLAGS_quote);
-          if (quote_now && quote_next) {
-            // This is an escaped quote character.
-            column += FLAGS_quote;
-            i += FLAGS_quote.size() * 2 - 1;
-          } else if (quote_now && !quote_next) {
-            // This is the end of the quoted field.
-            row.emplace_back(std::move(column));
-            state = CsvParserState::EXPECT_DELIMITER;
-            i += FLAGS_quote.size() - 1;
-          } else {
-            column.push_back(c);
-          }
-          break;
-        }
-        case CsvParserState::NOT_QUOTING: {
-          if (SubstringStartsWith(line, i, FLAGS_delimiter)) {
-            row.emplace_back(std::move(column));
-            state = CsvParserState::NEXT_FIELD;
-            i += FLAGS_delimiter.size() - 1;
-          } else {
-            column.push_back(c);
-          }
-          break;
-        }
-        case CsvParserState::EXPECT_DELIMITER: {
-          if (SubstringStartsWith(line, i, FLAGS_delimiter)) {
-            state = CsvParserState::NEXT_FIELD;
-            i += FLAGS_delimiter.size() - 1;
-          } else {
-            throw LoadException("Expected '{}' after '{}', but got '{}'", FLAGS_delimiter, FLAGS_quote, c);
-          }
-          break;
-        }
-      }
-    }
-  } while (state == CsvParserState::QUOTING);
-
-  switch (state) {
-    case CsvParserState::INITIAL_FIELD: {
-      break;
-    }
-    case CsvParserState::NEXT_FIELD: {
-      row.emplace_back(std::move(column));
-      break;
-    }
-    case CsvParserState::QUOTING: {
-      throw LoadException(
-          "There is no more data left to load while inside a quoted string. "
-          "Did you forget to close the quote?");
-      break;
-    }
-    case CsvParserState::NOT_QUOTING: {
-      row.emplace_back(std::move(column));
-      break;
-    }
-    case CsvParserState::EXPECT_DELIMITER: {
-      break;
+  std::vector<std::string> row;
+  row.reserve(fields.size());
+  for (const auto field : fields) {
+    if (FLAGS_trim_strings) {
+      row.emplace_back(memgraph::utils::Trim(field));
+    } else {
+      row.emplace_back(field);
     }
   }
-
-  if (FLAGS_trim_strings) {
-    std::transform(std::begin(row), std::end(row), std::begin(row),
-                   [](const auto &item) { return memgraph::utils::Trim(item); });
-  }
-
-  return {std::move(row), lines_count};
+  return std::move(row);
 }
 
 /// @throw LoadException
-std::pair<std::vector<Field>, uint64_t> ReadHeader(std::istream &stream) {
-  auto [row, lines_count] = ReadRow(stream);
+std::vector<Field> ReadHeader(memgraph::csv::Tokenizer *tokenizer) {
+  auto row = ReadRow(tokenizer);
   std::vector<Field> fields;
-  fields.reserve(row.size());
-  for (const auto &value : row) {
+  if (!row) return fields;
+  fields.reserve(row->size());
+  for (const auto &value : *row) {
     auto name_and_type = memgraph::utils::Split(value, ":");
     if (name_and_type.size() != 1U && name_and_type.size() != 2U)
       throw LoadException(
@@ -347,7 +283,7 @@ std::pair<std::vector<Field>, uint64_t> ReadHeader(std::istream &stream) {
     if (name_and_type.size() == 2U) type = memgraph::utils::Trim(name_and_type[1]);
     fields.push_back(Field{name, type});
   }
-  return {std::move(fields), lines_count};
+  return fields;
 }
 
 /// @throw LoadException
@@ -416,102 +352,331 @@ std::string GetIdSpace(const std::string &type) {
 }
 
 /// @throw LoadException
-void ProcessNodeRow(memgraph::storage::Storage *store, const std::vector<std::string> &row,
-                    const std::vector<Field> &fields, const std::vector<std::string> &additional_labels,
-                    std::unordered_map<NodeId, memgraph::storage::Gid> *node_id_map) {
+void CheckRowSize(std::vector<std::string> *row, size_t header_size) {
+  if ((!FLAGS_ignore_extra_columns && row->size() != header_size) ||
+      (FLAGS_ignore_extra_columns && row->size() < header_size))
+    throw LoadException(
+        "Expected as many values as there are header fields (found {}, "
+        "expected {})",
+        row->size(), header_size);
+  if (row->size() > header_size) {
+    row->resize(header_size);
+  }
+}
+
+// A CSV row together with the (1-based) line in the file at which it starts.
+struct Row {
+  std::vector<std::string> values;
+  uint64_t line;
+};
+
+// A part of a CSV file that is parsed by a single thread. Chunks are split at
+// line boundaries, but because quoted values may contain newlines a chunk can
+// start in the middle of a row. That is detected when the parsed chunks are
+// joined in order, and such a chunk is then parsed again from the position
+// where the previous chunk really ended.
+struct Chunk {
+  // Offset at which parsing started.
+  uint64_t begin{0};
+  // Offset at which the chunk nominally ends. The last row in the chunk can
+  // extend past this offset.
+  uint64_t end{0};
+  // Offset right after the last parsed row.
+  uint64_t parsed_end{0};
+  // Number of lines up to `parsed_end`. Until the chunks are joined the line
+  // numbers in the chunk are relative to `begin`.
+  uint64_t parsed_lines{0};
+  std::vector<Row> rows;
+  // Line of the row that couldn't be parsed together with the error.
+  std::optional<std::pair<uint64_t, std::string>> error;
+};
+
+uint64_t GetFileSize(std::ifstream *file) {
+  file->clear();
+  file->seekg(0, std::ios::end);
+  return file->tellg();
+}
+
+/// Returns the offset after the row that was last read from the stream.
+uint64_t GetStreamPosition(std::ifstream *file, uint64_t file_size) {
+  // `tellg` fails once the end of the file was reached.
+  if (file->eof()) return file_size;
+  return file->tellg();
+}
+
+/// Splits the file into chunks of roughly `FLAGS_chunk_size` bytes, starting at
+/// `begin`. Each chunk, except the first one, starts right after a newline.
+std::vector<std::pair<uint64_t, uint64_t>> SplitIntoChunks(std::ifstream *file, uint64_t begin, uint64_t file_size) {
+  std::vector<std::pair<uint64_t, uint64_t>> chunks;
+  while (begin < file_size) {
+    uint64_t end = begin + FLAGS_chunk_size;
+    if (end < file_size) {
+      file->clear();
+      file->seekg(end);
+      file->ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      end = GetStreamPosition(file, file_size);
+    } else {
+      end = file_size;
+    }
+    chunks.emplace_back(begin, end);
+    begin = end;
+  }
+  return chunks;
+}
+
+/// Parses all rows that start in the range [begin, end) of the file.
+Chunk ParseChunk(const std::string &path, size_t header_size, uint64_t begin, uint64_t end) {
+  Chunk chunk{.begin = begin, .end = end, .parsed_end = begin};
+  if (begin >= end) return chunk;
+  memgraph::csv::Tokenizer tokenizer(path, FLAGS_delimiter, FLAGS_quote, begin);
+  uint64_t offset = begin;
+  uint64_t lines = 0;
+  try {
+    while (offset < end) {
+      auto row = ReadRow(&tokenizer);
+      if (!row) break;
+      CheckRowSize(&*row, header_size);
+      chunk.rows.push_back(Row{std::move(*row), lines + 1});
+      offset = tokenizer.Position();
+      lines = tokenizer.LineCount();
+    }
+  } catch (const LoadException &e) {
+    chunk.error.emplace(lines + 1, e.what());
+  }
+  chunk.parsed_end = offset;
+  chunk.parsed_lines = lines;
+  return chunk;
+}
+
+/// Runs `func(i)` for all `i` in [0, count), each on its own thread.
+template <typename TFunc>
+void RunInParallel(size_t count, const TFunc &func) {
+  std::vector<std::thread> threads;
+  threads.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    threads.emplace_back([&func, i] { func(i); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/// Parses the file in parallel using `FLAGS_num_threads` threads. The file is
+/// processed in rounds; in each round the parsed chunks (one per thread) are
+/// passed to `process_round`. Returns the number of parsed rows.
+template <typename TFunc>
+uint64_t ProcessFile(const std::string &path, std::optional<std::vector<Field>> *header,
+                     const TFunc &process_round) {
+  std::ifstream file(path);
+  MG_ASSERT(file, "Unable to open '{}'", path);
+  uint64_t data_begin = 0;
+  uint64_t lines = 0;
+  if (!*header) {
+    try {
+      memgraph::csv::Tokenizer tokenizer(path, FLAGS_delimiter, FLAGS_quote);
+      header->emplace(ReadHeader(&tokenizer));
+      data_begin = tokenizer.Position();
+      lines = tokenizer.LineCount();
+    } catch (const memgraph::csv::CsvReadException &e) {
+      LOG_FATAL("Unable to open '{}': {}", path, e.what());
+    } catch (const LoadException &e) {
+      LOG_FATAL("Couldn't process row 1 of '{}' because of: {}", path, e.what());
+    }
+  }
+  auto file_size = GetFileSize(&file);
+  data_begin = std::min(data_begin, file_size);
+  auto header_size = (*header)->size();
+
+  auto ranges = SplitIntoChunks(&file, data_begin, file_size);
+  uint64_t rows_count = 0;
+  uint64_t expected_begin = data_begin;
+  for (size_t round = 0; round < ranges.size(); round += FLAGS_num_threads) {
+    auto round_size = std::min<size_t>(FLAGS_num_threads, ranges.size() - round);
+    std::vector<Chunk> chunks(round_size);
+    RunInParallel(round_size, [&](size_t i) {
+      const auto &[begin, end] = ranges[round + i];
+      chunks[i] = ParseChunk(path, header_size, begin, end);
+    });
+    for (auto &chunk : chunks) {
+      if (chunk.begin != expected_begin) {
+        // The previous chunk ended somewhere else than where this chunk
+        // started, so this chunk started in the middle of a multiline row.
+        chunk = ParseChunk(path, header_size, expected_begin, chunk.end);
+      }
+      if (chunk.error) {
+        const auto &[line, message] = *chunk.error;
+        LOG_FATAL("Couldn't process row {} of '{}' because of: {}", lines + line, path, message);
+      }
+      for (auto &row : chunk.rows) {
+        row.line += lines;
+      }
+      expected_begin = chunk.parsed_end;
+      lines += chunk.parsed_lines;
+      rows_count += chunk.rows.size();
+    }
+    process_round(chunks);
+  }
+  return rows_count;
+}
+
+/// Returns the ID of the node described by the row, if the row has one.
+/// @throw LoadException
+std::optional<NodeId> GetNodeId(const std::vector<std::string> &row, const std::vector<Field> &fields) {
   std::optional<NodeId> id;
-  auto acc = store->Access();
-  auto node = acc.CreateVertex();
+  for (size_t i = 0; i < row.size(); ++i) {
+    const auto &field = fields[i];
+    if (!memgraph::utils::StartsWith(field.type, "ID")) continue;
+    if (id) throw LoadException("Only one node ID must be specified");
+    if (FLAGS_id_type == "INTEGER") {
+      // Call `StringToInt` to verify that the ID is a valid integer.
+      StringToInt(row[i]);
+    }
+    id.emplace(NodeId{row[i], GetIdSpace(field.type)});
+  }
+  return id;
+}
+
+/// @throw LoadException
+void ProcessNodeRow(memgraph::storage::Storage::Accessor *acc, const std::vector<std::string> &row,
+                    const std::optional<NodeId> &node_id, const std::vector<Field> &fields,
+                    const std::vector<std::string> &additional_labels, NodeIdMap *node_id_map) {
+  auto maybe_node = acc->CreateVertex();
+  if (!maybe_node.HasValue()) throw LoadException("Couldn't create the node");
+  auto &node = *maybe_node;
+  if (node_id) node_id_map->Assign(*node_id, node.Gid());
   for (size_t i = 0; i < row.size(); ++i) {
     const auto &field = fields[i];
     const auto &value = row[i];
     if (memgraph::utils::StartsWith(field.type, "ID")) {
-      if (id) throw LoadException("Only one node ID must be specified");
-      if (FLAGS_id_type == "INTEGER") {
-        // Call `StringToInt` to verify that the ID is a valid integer.
-        StringToInt(value);
-      }
-      NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map->find(node_id);
-      if (it != node_id_map->end()) {
-        if (FLAGS_skip_duplicate_nodes) {
-          spdlog::warn(memgraph::utils::MessageWithLink("Skipping duplicate node with ID '{}'.", node_id,
-                                                        "https://memgr.ph/csv"));
-          return;
-        } else {
-          throw LoadException("Node with ID '{}' already exists", node_id);
-        }
-      }
-      node_id_map->emplace(node_id, node.Gid());
       if (!field.name.empty()) {
         memgraph::storage::PropertyValue pv_id;
         if (FLAGS_id_type == "INTEGER") {
-          pv_id = memgraph::storage::PropertyValue(StringToInt(node_id.id));
+          pv_id = memgraph::storage::PropertyValue(StringToInt(value));
         } else {
-          pv_id = memgraph::storage::PropertyValue(node_id.id);
+          pv_id = memgraph::storage::PropertyValue(value);
         }
-        auto old_node_property = node.SetProperty(acc.NameToProperty(field.name), pv_id);
+        auto old_node_property = node.SetProperty(acc->NameToProperty(field.name), pv_id);
         if (!old_node_property.HasValue()) throw LoadException("Couldn't add property '{}' to the node", field.name);
         if (!old_node_property->IsNull()) throw LoadException("The property '{}' already exists", field.name);
       }
-      id = node_id;
     } else if (field.type == "LABEL") {
       for (const auto &label : memgraph::utils::Split(value, FLAGS_array_delimiter)) {
-        auto node_label = node.AddLabel(acc.NameToLabel(label));
+        auto node_label = node.AddLabel(acc->NameToLabel(label));
         if (!node_label.HasValue()) throw LoadException("Couldn't add label '{}' to the node", label);
         if (!*node_label) throw LoadException("The label '{}' already exists", label);
       }
     } else if (field.type != "IGNORE") {
-      auto old_node_property = node.SetProperty(acc.NameToProperty(field.name), StringToValue(value, field.type));
+      auto old_node_property = node.SetProperty(acc->NameToProperty(field.name), StringToValue(value, field.type));
       if (!old_node_property.HasValue()) throw LoadException("Couldn't add property '{}' to the node", field.name);
       if (!old_node_property->IsNull()) throw LoadException("The property '{}' already exists", field.name);
     }
   }
   for (const auto &label : additional_labels) {
-    auto node_label = node.AddLabel(acc.NameToLabel(label));
+    auto node_label = node.AddLabel(acc->NameToLabel(label));
     if (!node_label.HasValue()) throw LoadException("Couldn't add label '{}' to the node", label);
     if (!*node_label) throw LoadException("The label '{}' already exists", label);
   }
-  if (acc.Commit().HasError()) throw LoadException("Couldn't store the node");
 }
 
-void ProcessNodes(memgraph::storage::Storage *store, const std::string &nodes_path,
-                  std::optional<std::vector<Field>> *header,
-                  std::unordered_map<NodeId, memgraph::storage::Gid> *node_id_map,
-                  const std::vector<std::string> &additional_labels) {
-  std::ifstream nodes_file(nodes_path);
-  MG_ASSERT(nodes_file, "Unable to open '{}'", nodes_path);
-  uint64_t row_number = 1;
-  try {
-    if (!*header) {
-      auto [fields, header_lines] = ReadHeader(nodes_file);
-      row_number += header_lines;
-      header->emplace(std::move(fields));
+// The node IDs of the rows in a chunk. `skip` marks the rows that are
+// duplicates of an earlier row.
+struct ChunkNodeIds {
+  std::vector<std::optional<NodeId>> ids;
+  std::vector<uint8_t> skip;
+  // Indices of the rows with an ID, split by the thread that claims them.
+  std::vector<std::vector<size_t>> rows_by_owner;
+};
+
+/// Claims the node IDs of all rows in the round. The shards of `node_id_map`
+/// are split among the threads and each thread goes through the chunks in
+/// file order, so the first row with a given ID always wins regardless of how
+/// the chunks were scheduled.
+void ClaimNodeIds(const std::string &nodes_path, const std::vector<Chunk> &chunks, std::vector<ChunkNodeIds> *chunk_ids,
+                  NodeIdMap *node_id_map) {
+  RunInParallel(chunks.size(), [&](size_t owner) {
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      auto &ids = (*chunk_ids)[i];
+      for (auto row : ids.rows_by_owner[owner]) {
+        const auto &node_id = *ids.ids[row];
+        if (node_id_map->Claim(node_id)) continue;
+        if (!FLAGS_skip_duplicate_nodes) {
+          LOG_FATAL("Couldn't process row {} of '{}' because of: Node with ID '{}' already exists",
+                    chunks[i].rows[row].line, nodes_path, node_id);
+        }
+        spdlog::warn(memgraph::utils::MessageWithLink("Skipping duplicate node with ID '{}'.", node_id,
+                                                      "https://memgr.ph/csv"));
+        ids.skip[row] = 1;
+      }
     }
-    while (true) {
-      auto [row, lines_count] = ReadRow(nodes_file);
-      if (lines_count == 0) break;
-      if ((!FLAGS_ignore_extra_columns && row.size() != (*header)->size()) ||
-          (FLAGS_ignore_extra_columns && row.size() < (*header)->size()))
-        throw LoadException(
-            "Expected as many values as there are header fields (found {}, "
-            "expected {})",
-            row.size(), (*header)->size());
-      if (row.size() > (*header)->size()) {
-        row.resize((*header)->size());
+  });
+}
+
+/// Creates the nodes from the given rows, committing every `kBatchSize` nodes.
+void ProcessNodeRows(memgraph::storage::Storage *store, const std::string &nodes_path, const std::vector<Row> &rows,
+                     const ChunkNodeIds &ids, const std::vector<Field> &fields,
+                     const std::vector<std::string> &additional_labels, NodeIdMap *node_id_map) {
+  for (size_t begin = 0; begin < rows.size(); begin += kBatchSize) {
+    auto end = std::min(begin + kBatchSize, rows.size());
+    auto acc = store->Access();
+    for (size_t i = begin; i < end; ++i) {
+      if (ids.skip[i]) continue;
+      try {
+        ProcessNodeRow(&acc, rows[i].values, ids.ids[i], fields, additional_labels, node_id_map);
+      } catch (const LoadException &e) {
+        LOG_FATAL("Couldn't process row {} of '{}' because of: {}", rows[i].line, nodes_path, e.what());
       }
-      ProcessNodeRow(store, row, **header, additional_labels, node_id_map);
-      row_number += lines_count;
     }
-  } catch (const LoadException &e) {
-    LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row_number, nodes_path, e.what());
+    if (acc.Commit().HasError()) {
+      LOG_FATAL("Couldn't process row {} of '{}' because of: Couldn't store the node", rows[begin].line, nodes_path);
+    }
   }
 }
 
+uint64_t ProcessNodes(memgraph::storage::Storage *store, const std::string &nodes_path,
+                      std::optional<std::vector<Field>> *header, NodeIdMap *node_id_map,
+                      const std::vector<std::string> &additional_labels) {
+  return ProcessFile(nodes_path, header, [&](const std::vector<Chunk> &chunks) {
+    std::vector<ChunkNodeIds> chunk_ids(chunks.size());
+    RunInParallel(chunks.size(), [&](size_t i) {
+      const auto &rows = chunks[i].rows;
+      auto &ids = chunk_ids[i];
+      ids.ids.reserve(rows.size());
+      ids.skip.resize(rows.size(), 0);
+      ids.rows_by_owner.resize(chunks.size());
+      for (size_t row = 0; row < rows.size(); ++row) {
+        try {
+          ids.ids.push_back(GetNodeId(rows[row].values, **header));
+        } catch (const LoadException &e) {
+          LOG_FATAL("Couldn't process row {} of '{}' because of: {}", rows[row].line, nodes_path, e.what());
+        }
+        if (!ids.ids.back()) continue;
+        ids.rows_by_owner[NodeIdMap::ShardOf(*ids.ids.back()) % chunks.size()].push_back(row);
+      }
+    });
+    ClaimNodeIds(nodes_path, chunks, &chunk_ids, node_id_map);
+    RunInParallel(chunks.size(), [&](size_t i) {
+      ProcessNodeRows(store, nodes_path, chunks[i].rows, chunk_ids[i], **header, additional_labels, node_id_map);
+    });
+  });
+}
+
+// A relationship parsed from a CSV row that is ready to be created.
+struct PreparedRelationship {
+  memgraph::storage::Gid from;
+  memgraph::storage::Gid to;
+  memgraph::storage::EdgeTypeId type;
+  std::vector<std::pair<memgraph::storage::PropertyId, memgraph::storage::PropertyValue>> properties;
+  // Line of the CSV row, used for error reporting.
+  uint64_t line;
+};
+
+/// Returns `std::nullopt` if the relationship should be skipped.
 /// @throw LoadException
-void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vector<Field> &fields,
-                             const std::vector<std::string> &row, std::optional<std::string> relationship_type,
-                             const std::unordered_map<NodeId, memgraph::storage::Gid> &node_id_map) {
+std::optional<PreparedRelationship> PrepareRelationshipsRow(memgraph::storage::Storage *store,
+                                                            const std::vector<Field> &fields,
+                                                            const std::vector<std::string> &row,
+                                                            std::optional<std::string> relationship_type,
+                                                            const NodeIdMap &node_id_map) {
   std::optional<memgraph::storage::Gid> start_id;
   std::optional<memgraph::storage::Gid> end_id;
   std::map<std::string, memgraph::storage::PropertyValue> properties;
@@ -525,17 +690,17 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
         StringToInt(value);
       }
       NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map.find(node_id);
-      if (it == node_id_map.end()) {
+      auto gid = node_id_map.Find(node_id);
+      if (!gid) {
         if (FLAGS_skip_bad_relationships) {
           spdlog::warn(memgraph::utils::MessageWithLink("Skipping bad relationship with START_ID '{}'.", node_id,
                                                         "https://memgr.ph/csv"));
-          return;
+          return std::nullopt;
         } else {
           throw LoadException("Node with ID '{}' does not exist", node_id);
         }
       }
-      start_id = it->second;
+      start_id = *gid;
     } else if (memgraph::utils::StartsWith(field.type, "END_ID")) {
       if (end_id) throw LoadException("Only one node ID must be specified");
       if (FLAGS_id_type == "INTEGER") {
@@ -543,17 +708,17 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
         StringToInt(value);
       }
       NodeId node_id{value, GetIdSpace(field.type)};
-      auto it = node_id_map.find(node_id);
-      if (it == node_id_map.end()) {
+      auto gid = node_id_map.Find(node_id);
+      if (!gid) {
         if (FLAGS_skip_bad_relationships) {
           spdlog::warn(memgraph::utils::MessageWithLink("Skipping bad relationship with END_ID '{}'.", node_id,
                                                         "https://memgr.ph/csv"));
-          return;
+          return std::nullopt;
         } else {
           throw LoadException("Node with ID '{}' does not exist", node_id);
         }
       }
-      end_id = it->second;
+      end_id = *gid;
     } else if (field.type == "TYPE") {
       if (relationship_type) throw LoadException("Only one relationship TYPE must be specified");
       relationship_type = value;
@@ -566,65 +731,120 @@ void ProcessRelationshipsRow(memgraph::storage::Storage *store, const std::vecto
   if (!end_id) throw LoadException("END_ID must be set");
   if (!relationship_type) throw LoadException("Relationship TYPE must be set");
 
+  PreparedRelationship relationship{.from = *start_id,
+                                    .to = *end_id,
+                                    .type = store->NameToEdgeType(*relationship_type),
+                                    .properties = {},
+                                    .line = 0};
+  relationship.properties.reserve(properties.size());
+  for (auto &[name, value] : properties) {
+    relationship.properties.emplace_back(store->NameToProperty(name), std::move(value));
+  }
+  return relationship;
+}
+
+/// Creates all given relationships in a single transaction. Returns `false` if
+/// the transaction conflicted with another thread that is modifying one of the
+/// same nodes.
+/// @throw LoadException
+bool TryCreateRelationships(memgraph::storage::Storage *store, const std::string &relationships_path,
+                            std::span<const PreparedRelationship> relationships) {
   auto acc = store->Access();
-  auto from_node = acc.FindVertex(*start_id, memgraph::storage::View::NEW);
-  if (!from_node) throw LoadException("From node must be in the storage");
-  auto to_node = acc.FindVertex(*end_id, memgraph::storage::View::NEW);
-  if (!to_node) throw LoadException("To node must be in the storage");
-
-  auto relationship = acc.CreateEdge(&*from_node, &*to_node, acc.NameToEdgeType(*relationship_type));
-  if (!relationship.HasValue()) throw LoadException("Couldn't create the relationship");
-
-  for (const auto &property : properties) {
-    auto ret = relationship->SetProperty(acc.NameToProperty(property.first), property.second);
-    if (!ret.HasValue()) {
-      if (ret.GetError() != memgraph::storage::Error::PROPERTIES_DISABLED) {
-        throw LoadException("Couldn't add property '{}' to the relationship", property.first);
-      } else {
-        throw LoadException(
-            "Couldn't add property '{}' to the relationship because properties "
-            "on edges are disabled",
-            property.first);
+  for (const auto &relationship : relationships) {
+    try {
+      auto from_node = acc.FindVertex(relationship.from, memgraph::storage::View::NEW);
+      if (!from_node) throw LoadException("From node must be in the storage");
+      auto to_node = acc.FindVertex(relationship.to, memgraph::storage::View::NEW);
+      if (!to_node) throw LoadException("To node must be in the storage");
+
+      auto edge = acc.CreateEdge(&*from_node, &*to_node, relationship.type);
+      if (!edge.HasValue()) {
+        if (edge.GetError() == memgraph::storage::Error::SERIALIZATION_ERROR) return false;
+        throw LoadException("Couldn't create the relationship");
+      }
+
+      for (const auto &[property, value] : relationship.properties) {
+        auto ret = edge->SetProperty(property, value);
+        if (!ret.HasValue()) {
+          if (ret.GetError() != memgraph::storage::Error::PROPERTIES_DISABLED) {
+            throw LoadException("Couldn't add property '{}' to the relationship", acc.PropertyToName(property));
+          } else {
+            throw LoadException(
+                "Couldn't add property '{}' to the relationship because properties "
+                "on edges are disabled",
+                acc.PropertyToName(property));
+          }
+        }
       }
+    } catch (const LoadException &e) {
+      LOG_FATAL("Couldn't process row {} of '{}' because of: {}", relationship.line, relationships_path, e.what());
     }
   }
-
-  if (acc.Commit().HasError()) throw LoadException("Couldn't store the relationship");
+  if (acc.Commit().HasError()) {
+    LOG_FATAL("Couldn't process row {} of '{}' because of: Couldn't store the relationship",
+              relationships.front().line, relationships_path);
+  }
+  return true;
 }
 
-void ProcessRelationships(memgraph::storage::Storage *store, const std::string &relationships_path,
-                          const std::optional<std::string> &relationship_type,
-                          std::optional<std::vector<Field>> *header,
-                          const std::unordered_map<NodeId, memgraph::storage::Gid> &node_id_map) {
-  std::ifstream relationships_file(relationships_path);
-  MG_ASSERT(relationships_file, "Unable to open '{}'", relationships_path);
-  uint64_t row_number = 1;
-  try {
-    if (!*header) {
-      auto [fields, header_lines] = ReadHeader(relationships_file);
-      row_number += header_lines;
-      header->emplace(std::move(fields));
-    }
-    while (true) {
-      auto [row, lines_count] = ReadRow(relationships_file);
-      if (lines_count == 0) break;
-      if ((!FLAGS_ignore_extra_columns && row.size() != (*header)->size()) ||
-          (FLAGS_ignore_extra_columns && row.size() < (*header)->size()))
-        throw LoadException(
-            "Expected as many values as there are header fields (found {}, "
-            "expected {})",
-            row.size(), (*header)->size());
-      if (row.size() > (*header)->size()) {
-        row.resize((*header)->size());
+/// Creates the relationships, committing every `kBatchSize` relationships. The
+/// relationships are sorted by their start node so that consecutive edges are
+/// added to the same node.
+void CreateRelationships(memgraph::storage::Storage *store, const std::string &relationships_path,
+                         std::vector<PreparedRelationship> *relationships) {
+  std::sort(relationships->begin(), relationships->end(),
+            [](const auto &a, const auto &b) { return std::tie(a.from, a.line) < std::tie(b.from, b.line); });
+  std::span<const PreparedRelationship> all{*relationships};
+  for (size_t begin = 0; begin < all.size(); begin += kBatchSize) {
+    auto batch = all.subspan(begin, std::min(kBatchSize, all.size() - begin));
+    if (TryCreateRelationships(store, relationships_path, batch)) continue;
+    // Another thread is creating a relationship that ends in one of the nodes
+    // used here. Retry the relationships one by one so that each transaction
+    // is short and the conflicts are quickly resolved, backing off so that the
+    // thread that holds the node can finish its batch.
+    for (size_t i = 0; i < batch.size(); ++i) {
+      auto backoff = kMinRetryBackoff;
+      while (!TryCreateRelationships(store, relationships_path, batch.subspan(i, 1))) {
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min(backoff * 2, kMaxRetryBackoff);
       }
-      ProcessRelationshipsRow(store, **header, row, relationship_type, node_id_map);
-      row_number += lines_count;
     }
-  } catch (const LoadException &e) {
-    LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row_number, relationships_path, e.what());
   }
 }
 
+uint64_t ProcessRelationships(memgraph::storage::Storage *store, const std::string &relationships_path,
+                              const std::optional<std::string> &relationship_type,
+                              std::optional<std::vector<Field>> *header, const NodeIdMap &node_id_map) {
+  return ProcessFile(relationships_path, header, [&](const std::vector<Chunk> &chunks) {
+    // Each thread prepares the relationships from its chunk and partitions
+    // them by their start node. Each partition is then created by a single
+    // thread so that the threads don't contend for the same start nodes.
+    auto partition_count = chunks.size();
+    std::vector<std::vector<std::vector<PreparedRelationship>>> prepared(
+        chunks.size(), std::vector<std::vector<PreparedRelationship>>(partition_count));
+    RunInParallel(chunks.size(), [&](size_t i) {
+      for (const auto &row : chunks[i].rows) {
+        try {
+          auto relationship = PrepareRelationshipsRow(store, **header, row.values, relationship_type, node_id_map);
+          if (!relationship) continue;
+          relationship->line = row.line;
+          prepared[i][relationship->from.AsUint() % partition_count].push_back(std::move(*relationship));
+        } catch (const LoadException &e) {
+          LOG_FATAL("Couldn't process row {} of '{}' because of: {}", row.line, relationships_path, e.what());
+        }
+      }
+    });
+    RunInParallel(partition_count, [&](size_t partition) {
+      std::vector<PreparedRelationship> relationships;
+      for (auto &chunk_partitions : prepared) {
+        auto &part = chunk_partitions[partition];
+        std::move(part.begin(), part.end(), std::back_inserter(relationships));
+      }
+      CreateRelationships(store, relationships_path, &relationships);
+    });
+  });
+}
+
 struct NodesArgument {
   // List of all files that have should be processed for nodes.
   std::vector<std::string> nodes;
@@ -698,41 +918,62 @@ int main(int argc, char *argv[]) {
     FLAGS_id_type = upper;
   }
 
-  std::unordered_map<NodeId, memgraph::storage::Gid> node_id_map;
-  memgraph::storage::Storage store{{
+  NodeIdMap node_id_map;
+  std::optional<memgraph::storage::Storage> store;
+  store.emplace(memgraph::storage::Config{
       .items = {.properties_on_edges = FLAGS_storage_properties_on_edges},
       .durability = {.storage_directory = FLAGS_data_directory,
                      .recover_on_startup = false,
                      .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::DISABLED,
+                     .snapshot_thread_count = FLAGS_num_threads,
                      .snapshot_on_exit = true},
-  }};
+  });
 
   memgraph::utils::Timer load_timer;
+  spdlog::info("Importing using {} threads", FLAGS_num_threads);
 
   // Process all nodes files.
-  for (const auto &value : nodes) {
-    auto [files, additional_labels] = ParseNodesArgument(value);
-    std::optional<std::vector<Field>> header;
-    for (const auto &nodes_file : files) {
-      spdlog::info("Loading {}", nodes_file);
-      ProcessNodes(&store, nodes_file, &header, &node_id_map, additional_labels);
+  {
+    memgraph::utils::Timer timer;
+    uint64_t nodes_count = 0;
+    for (const auto &value : nodes) {
+      auto [files, additional_labels] = ParseNodesArgument(value);
+      std::optional<std::vector<Field>> header;
+      for (const auto &nodes_file : files) {
+        spdlog::info("Loading {}", nodes_file);
+        nodes_count += ProcessNodes(&*store, nodes_file, &header, &node_id_map, additional_labels);
+      }
     }
+    double sec = timer.Elapsed().count();
+    spdlog::info("Loaded {} nodes in {:.3f}s ({:.0f} nodes/s)", nodes_count, sec, nodes_count / sec);
   }
 
   // Process all relationships files.
-  for (const auto &value : relationships) {
-    auto [files, type] = ParseRelationshipsArgument(value);
-    std::optional<std::vector<Field>> header;
-    for (const auto &relationships_file : files) {
-      spdlog::info("Loading {}", relationships_file);
-      ProcessRelationships(&store, relationships_file, type, &header, node_id_map);
+  {
+    memgraph::utils::Timer timer;
+    uint64_t relationships_count = 0;
+    for (const auto &value : relationships) {
+      auto [files, type] = ParseRelationshipsArgument(value);
+      std::optional<std::vector<Field>> header;
+      for (const auto &relationships_file : files) {
+        spdlog::info("Loading {}", relationships_file);
+        relationships_count += ProcessRelationships(&*store, relationships_file, type, &header, node_id_map);
+      }
     }
+    double sec = timer.Elapsed().count();
+    spdlog::info("Loaded {} relationships in {:.3f}s ({:.0f} relationships/s)", relationships_count, sec,
+                 relationships_count / sec);
   }
 
   double load_sec = load_timer.Elapsed().count();
   spdlog::info("Loaded all data in {:.3f}s", load_sec);
 
-  // The snapshot will be created in the storage destructor.
+  // The snapshot is created in the storage destructor.
+  {
+    memgraph::utils::Timer timer;
+    store.reset();
+    spdlog::info("Created the snapshot in {:.3f}s", timer.Elapsed().count());
+  }
 
   return 0;
 }
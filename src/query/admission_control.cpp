@@ -0,0 +1,228 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "query/admission_control.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "query/exceptions.hpp"
+#include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
+#include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/on_scope_exit.hpp"
+#include "utils/readable_size.hpp"
+#include "utils/work_stealing_scheduler.hpp"
+
+namespace EventCounter {
+extern const Event QueriesQueued;
+extern const Event QueriesRejected;
+}  // namespace EventCounter
+
+namespace EventHistogram {
+extern const Event QueryQueueWaitLatency;
+}  // namespace EventHistogram
+
+namespace memgraph::query {
+
+AdmissionController::Ticket::Ticket(AdmissionController *controller, std::string user, uint64_t memory)
+    : controller_(controller), user_(std::move(user)), memory_(memory) {}
+
+AdmissionController::Ticket::Ticket(Ticket &&other) noexcept
+    : controller_(std::exchange(other.controller_, nullptr)), user_(std::move(other.user_)), memory_(other.memory_) {}
+
+AdmissionController::Ticket &AdmissionController::Ticket::operator=(Ticket &&other) noexcept {
+  if (this == &other) return *this;
+  Release();
+  controller_ = std::exchange(other.controller_, nullptr);
+  user_ = std::move(other.user_);
+  memory_ = other.memory_;
+  return *this;
+}
+
+void AdmissionController::Ticket::Release() {
+  if (controller_ == nullptr) return;
+  controller_->Release(user_, memory_);
+  controller_ = nullptr;
+}
+
+AdmissionController::Ticket::CpuTimeMeasure::CpuTimeMeasure(Ticket *ticket)
+    : ticket_(ticket->controller_ != nullptr && ticket->controller_->config_.max_cpu_time.count() > 0 ? ticket
+                                                                                                      : nullptr) {
+  if (ticket_ != nullptr) start_ = ThreadCpuTime();
+}
+
+AdmissionController::Ticket::CpuTimeMeasure::~CpuTimeMeasure() {
+  // The ticket could have been released in the meantime.
+  if (ticket_ == nullptr || ticket_->controller_ == nullptr) return;
+  ticket_->controller_->AddCpuTime(ticket_->user_, ThreadCpuTime() - start_);
+}
+
+AdmissionController::AdmissionController(InterpreterConfig::AdmissionControl config)
+    : config_(config),
+      enabled_(config.max_running_queries > 0 || config.max_reserved_memory > 0 || config.max_cpu_time.count() > 0 ||
+               config.default_memory_reservation > 0 || config.limit_total_reserved_memory) {}
+
+AdmissionController::Ticket AdmissionController::Admit(const std::string &user,
+                                                       const std::optional<uint64_t> memory_limit) {
+  if (!enabled_) return {};
+  const auto memory = memory_limit.value_or(config_.default_memory_reservation);
+
+  // A queued query that parked its task takes a worker slot back once it
+  // stops waiting. It is declared before the guard so that it waits for the
+  // slot without holding the lock.
+  bool parked = false;
+  utils::OnScopeExit unpark{[&parked] {
+    if (parked) utils::WorkStealingScheduler::Unpark();
+  }};
+
+  std::unique_lock guard(mutex_);
+  auto now = std::chrono::steady_clock::now();
+  auto it = users_.try_emplace(user, UserState{.usage = {}, .window_start = now}).first;
+  auto *state = &it->second;
+
+  auto reason = CheckQuotas(state, memory, now);
+  if (reason) {
+    const auto reject = [&] {
+      EventCounter::IncrementCounter(EventCounter::QueriesRejected);
+      // Other users could have been added while the query was waiting, so the
+      // iterator could be invalidated. The state of the user can't be removed
+      // while the query is queued.
+      MaybeForget(users_.find(user), now);
+      throw QueryAdmissionException("Query of user '{}' was rejected because {}.", user, *reason);
+    };
+    if (config_.max_queue_wait.count() == 0 ||
+        (config_.max_queued_queries > 0 && state->usage.queued_queries >= config_.max_queued_queries)) {
+      reject();
+    }
+
+    // The queued query parks its task, so it doesn't hold a worker slot while
+    // it waits. Parking could spawn a thread, so it is done without holding
+    // the lock.
+    ++state->usage.queued_queries;
+    guard.unlock();
+    parked = utils::WorkStealingScheduler::Park();
+    guard.lock();
+    if (!parked) {
+      --state->usage.queued_queries;
+      reason = "too many concurrent transactions are queued on the server";
+      reject();
+    }
+    EventCounter::IncrementCounter(EventCounter::QueriesQueued);
+    const auto queued_at = now;
+    const auto deadline = queued_at + config_.max_queue_wait;
+    now = std::chrono::steady_clock::now();
+    reason = CheckQuotas(state, memory, now);
+    while (reason) {
+      if (now >= deadline) {
+        --state->usage.queued_queries;
+        EventHistogram::Measure(EventHistogram::QueryQueueWaitLatency,
+                                std::chrono::duration_cast<std::chrono::microseconds>(now - queued_at).count());
+        reject();
+      }
+      // The CPU time quota is renewed at the end of the window without any
+      // notification.
+      auto wake_up = deadline;
+      if (config_.max_cpu_time.count() > 0) {
+        wake_up = std::min(wake_up, state->window_start + config_.cpu_time_window);
+      }
+      cv_.wait_until(guard, wake_up);
+      now = std::chrono::steady_clock::now();
+      reason = CheckQuotas(state, memory, now);
+    }
+    --state->usage.queued_queries;
+    EventHistogram::Measure(EventHistogram::QueryQueueWaitLatency,
+                            std::chrono::duration_cast<std::chrono::microseconds>(now - queued_at).count());
+  }
+
+  ++state->usage.running_queries;
+  state->usage.reserved_memory += memory;
+  total_reserved_memory_ += memory;
+  return Ticket{this, user, memory};
+}
+
+std::optional<AdmissionController::UserUsage> AdmissionController::GetUsage(const std::string &user) const {
+  std::unique_lock guard(mutex_);
+  auto it = users_.find(user);
+  if (it == users_.end()) return std::nullopt;
+  return it->second.usage;
+}
+
+std::chrono::nanoseconds AdmissionController::ThreadCpuTime() {
+  timespec time{};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) return std::chrono::nanoseconds{0};
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+std::optional<std::string> AdmissionController::CheckQuotas(UserState *state, const uint64_t memory,
+                                                            const std::chrono::steady_clock::time_point now) {
+  auto &usage = state->usage;
+  if (config_.max_running_queries > 0 && usage.running_queries >= config_.max_running_queries) {
+    return fmt::format("the user already runs {} queries", usage.running_queries);
+  }
+  if (config_.max_reserved_memory > 0 && usage.reserved_memory + memory > config_.max_reserved_memory) {
+    return fmt::format("the memory limits of the queries of the user would exceed {}",
+                       utils::GetReadableSize(static_cast<double>(config_.max_reserved_memory)));
+  }
+  if (const auto hard_limit = utils::total_memory_tracker.HardLimit();
+      config_.limit_total_reserved_memory && memory > 0 && hard_limit > 0 &&
+      total_reserved_memory_ + memory > static_cast<uint64_t>(hard_limit)) {
+    return fmt::format("the memory limits of all running queries would exceed the memory limit of {}",
+                       utils::GetReadableSize(static_cast<double>(hard_limit)));
+  }
+  if (config_.max_cpu_time.count() > 0) {
+    if (now - state->window_start >= config_.cpu_time_window) {
+      state->window_start = now;
+      usage.cpu_time = std::chrono::nanoseconds{0};
+    }
+    if (usage.cpu_time >= config_.max_cpu_time) {
+      return "the user used up its CPU time";
+    }
+  }
+  return std::nullopt;
+}
+
+void AdmissionController::Release(const std::string &user, const uint64_t memory) {
+  {
+    std::unique_lock guard(mutex_);
+    auto it = users_.find(user);
+    MG_ASSERT(it != users_.end(), "Released a query of an unknown user!");
+    --it->second.usage.running_queries;
+    it->second.usage.reserved_memory -= memory;
+    total_reserved_memory_ -= memory;
+    MaybeForget(it, std::chrono::steady_clock::now());
+  }
+  // The queued queries of every user could be waiting for the memory.
+  cv_.notify_all();
+}
+
+void AdmissionController::AddCpuTime(const std::string &user, const std::chrono::nanoseconds cpu_time) {
+  std::unique_lock guard(mutex_);
+  auto it = users_.find(user);
+  if (it == users_.end()) return;
+  it->second.usage.cpu_time += cpu_time;
+}
+
+void AdmissionController::MaybeForget(std::unordered_map<std::string, UserState>::iterator it,
+                                      const std::chrono::steady_clock::time_point now) {
+  const auto &[usage, window_start] = it->second;
+  if (usage.running_queries > 0 || usage.queued_queries > 0) return;
+  // The used CPU time has to be remembered until the end of the window.
+  if (usage.cpu_time.count() > 0 && now - window_start < config_.cpu_time_window) return;
+  users_.erase(it);
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,140 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "query/config.hpp"
+
+namespace memgraph::query {
+
+/// Admission control for the Cypher queries.
+///
+/// The controller tracks the running queries, their memory reservations and
+/// the CPU time they use for every user. A new query is admitted only while
+/// the quotas of its user aren't exceeded. Otherwise the query waits in the
+/// queue of its user until the quotas allow it to run, or it is rejected if
+/// the queue is full or the wait is too long.
+///
+/// The memory reservation of a query is its QUERY MEMORY LIMIT. With
+/// `limit_total_reserved_memory` a query is also admitted only while the
+/// reservations of all running queries fit under the hard memory limit of the
+/// server, so the queries that would make the server run out of memory are
+/// held back instead of aborting the unrelated queries once the hard limit is
+/// reached.
+class AdmissionController final {
+ public:
+  /// Admission of a single query. The resources of the query are released
+  /// when the ticket is destroyed.
+  class Ticket final {
+   public:
+    Ticket() = default;
+    ~Ticket() { Release(); }
+
+    Ticket(const Ticket &) = delete;
+    Ticket &operator=(const Ticket &) = delete;
+    Ticket(Ticket &&other) noexcept;
+    Ticket &operator=(Ticket &&other) noexcept;
+
+    /// Measures the CPU time the calling thread spends in the scope of the
+    /// returned object and charges it to the user of the query.
+    class CpuTimeMeasure final {
+     public:
+      explicit CpuTimeMeasure(Ticket *ticket);
+      ~CpuTimeMeasure();
+
+      CpuTimeMeasure(const CpuTimeMeasure &) = delete;
+      CpuTimeMeasure &operator=(const CpuTimeMeasure &) = delete;
+      CpuTimeMeasure(CpuTimeMeasure &&) = delete;
+      CpuTimeMeasure &operator=(CpuTimeMeasure &&) = delete;
+
+     private:
+      Ticket *ticket_;
+      std::chrono::nanoseconds start_{0};
+    };
+
+    CpuTimeMeasure MeasureCpuTime() { return CpuTimeMeasure{this}; }
+
+   private:
+    friend class AdmissionController;
+
+    Ticket(AdmissionController *controller, std::string user, uint64_t memory);
+
+    void Release();
+
+    AdmissionController *controller_{nullptr};
+    std::string user_;
+    uint64_t memory_{0};
+  };
+
+  /// Resources used by the queries of a single user.
+  struct UserUsage {
+    uint64_t running_queries{0};
+    uint64_t queued_queries{0};
+    uint64_t reserved_memory{0};
+    // CPU time used in the current window.
+    std::chrono::nanoseconds cpu_time{0};
+  };
+
+  explicit AdmissionController(InterpreterConfig::AdmissionControl config);
+
+  /// Admits a query of `user` with the given memory limit. The call blocks
+  /// while the query is waiting in the queue. A query that runs on a
+  /// `utils::WorkStealingScheduler` parks its task before it starts waiting,
+  /// so it doesn't hold back the queries of the other users, and takes a
+  /// worker slot back once it stops waiting. The query is rejected if its task
+  /// can't be parked.
+  ///
+  /// @throw QueryAdmissionException if the query can't be admitted.
+  Ticket Admit(const std::string &user, std::optional<uint64_t> memory_limit);
+
+  std::optional<UserUsage> GetUsage(const std::string &user) const;
+
+  /// Returns the CPU time used by the calling thread.
+  static std::chrono::nanoseconds ThreadCpuTime();
+
+ private:
+  struct UserState {
+    UserUsage usage;
+    std::chrono::steady_clock::time_point window_start;
+  };
+
+  /// Returns the reason why the query can't be admitted at the moment, or
+  /// `std::nullopt` if it can run. Must be called while holding `mutex_`.
+  std::optional<std::string> CheckQuotas(UserState *state, uint64_t memory, std::chrono::steady_clock::time_point now);
+
+  void Release(const std::string &user, uint64_t memory);
+
+  void AddCpuTime(const std::string &user, std::chrono::nanoseconds cpu_time);
+
+  /// Removes the state of an idle user. Must be called while holding `mutex_`.
+  void MaybeForget(std::unordered_map<std::string, UserState>::iterator it, std::chrono::steady_clock::time_point now);
+
+  const InterpreterConfig::AdmissionControl config_;
+  // Without any quota and without the limit of the reserved memory, the
+  // controller doesn't need to track the users at all.
+  const bool enabled_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unordered_map<std::string, UserState> users_;
+  uint64_t total_reserved_memory_{0};
+};
+
+}  // namespace memgraph::query
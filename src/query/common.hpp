@@ -90,6 +90,8 @@ storage::PropertyValue PropsSetChecked(T *record, const storage::PropertyId &key
     auto maybe_old_value = record->SetProperty(key, storage::PropertyValue(value));
     if (maybe_old_value.HasError()) {
       switch (maybe_old_value.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::SERIALIZATION_ERROR:
           throw TransactionSerializationException();
         case storage::Error::DELETED_OBJECT:
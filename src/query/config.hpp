@@ -11,6 +11,7 @@
 
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace memgraph::query {
@@ -28,5 +29,31 @@ struct InterpreterConfig {
   std::string default_pulsar_service_url;
   uint32_t stream_transaction_conflict_retries;
   std::chrono::milliseconds stream_transaction_retry_interval;
+  // Transformation results with the same query text are executed as a single
+  // UNWIND query when the query allows it.
+  bool stream_query_batching{true};
+  // Number of threads which consume the partitions of a Kafka stream in
+  // parallel, each partition in its own transaction.
+  uint32_t stream_partition_threads{1};
+
+  // Quotas that the admission controller enforces on the Cypher queries of
+  // every user. A quota of 0 is unlimited.
+  struct AdmissionControl {
+    uint64_t max_running_queries{0};
+    // Sum of the memory limits of the running queries in bytes.
+    uint64_t max_reserved_memory{0};
+    // CPU time that the queries can use in every window.
+    std::chrono::milliseconds max_cpu_time{0};
+    std::chrono::milliseconds cpu_time_window{std::chrono::minutes(1)};
+    // Memory limit assumed for the queries without QUERY MEMORY LIMIT.
+    uint64_t default_memory_reservation{0};
+    // Queries that exceed the quotas wait in the queue for at most this long
+    // and are rejected afterwards. They are rejected right away if it is 0.
+    std::chrono::milliseconds max_queue_wait{0};
+    uint64_t max_queued_queries{0};
+    // Whether the queries are held back while the memory limits of all
+    // running queries would exceed the hard memory limit of the server.
+    bool limit_total_reserved_memory{false};
+  } admission_control;
 };
 }  // namespace memgraph::query
@@ -20,6 +20,7 @@
 #include "query/plan/profile.hpp"
 #include "query/trigger.hpp"
 #include "utils/async_timer.hpp"
+#include "utils/work_stealing_scheduler.hpp"
 
 namespace memgraph::query {
 
@@ -78,6 +79,9 @@ static_assert(std::is_move_assignable_v<ExecutionContext>, "ExecutionContext mus
 static_assert(std::is_move_constructible_v<ExecutionContext>, "ExecutionContext must be move constructible!");
 
 inline bool MustAbort(const ExecutionContext &context) noexcept {
+  // Operators check for abortion while producing rows, which makes it the
+  // point at which a long running query gives up its worker slot.
+  utils::WorkStealingScheduler::Checkpoint();
   return (context.is_shutting_down != nullptr && context.is_shutting_down->load(std::memory_order_acquire)) ||
          context.timer.IsExpired();
 }
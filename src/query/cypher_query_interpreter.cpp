@@ -11,18 +11,97 @@
 
 #include "query/cypher_query_interpreter.hpp"
 
+#include "utils/event_counter.hpp"
+
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_HIDDEN_bool(query_cost_planner, true, "Use the cost-estimating query planner.");
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_int32(query_plan_cache_ttl, 60, "Time to live for cached query plans, in seconds.",
                        FLAG_IN_RANGE(0, std::numeric_limits<int32_t>::max()));
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_plan_cache_max_entries, 1000, "Maximum number of cached query plans.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_ast_cache_max_entries, 1000, "Maximum number of cached parsed queries.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_cache_max_memory_mb, 256,
+              "Maximum estimated memory used by the cached parsed queries and, separately, by the cached query plans, "
+              "in MiB.");
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_double(query_plan_cache_max_cardinality_drift, 10.0,
+                        "A cached query plan is replanned once the number of vertices grows or shrinks by more than "
+                        "this factor since it was planned. Set to 0 to disable.",
+                        FLAG_IN_RANGE(0.0, std::numeric_limits<double>::max()));
+
+namespace EventCounter {
+extern const Event AstCacheHit;
+extern const Event AstCacheMiss;
+extern const Event AstCacheEviction;
+extern const Event PlanCacheHit;
+extern const Event PlanCacheMiss;
+extern const Event PlanCacheEviction;
+extern const Event PlanCacheInvalidation;
+}  // namespace EventCounter
 
 namespace memgraph::query {
-CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan) : plan_(std::move(plan)) {}
+
+namespace {
+// Rough estimates of the memory used by an AST node and a symbol, including
+// the bookkeeping around them.
+constexpr uint64_t kAstNodeSizeEstimate = 128;
+constexpr uint64_t kSymbolSizeEstimate = 96;
+// Vertex counts below this are treated as equal to it when checking the
+// cardinality drift, so that plans for small graphs aren't needlessly redone.
+constexpr int64_t kMinDriftVertexCount = 1000;
+
+uint64_t EstimateAstStorageSize(const AstStorage &ast_storage) {
+  uint64_t size = ast_storage.storage_.size() * kAstNodeSizeEstimate;
+  for (const auto *names : {&ast_storage.labels_, &ast_storage.edge_types_, &ast_storage.properties_}) {
+    for (const auto &name : *names) size += sizeof(name) + name.size();
+  }
+  return size;
+}
+}  // namespace
+
+CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan, int64_t vertex_count)
+    : plan_(std::move(plan)), vertex_count_(vertex_count) {}
+
+bool CachedPlan::IsStale(int64_t vertex_count) const {
+  if (FLAGS_query_plan_cache_max_cardinality_drift <= 0.0) return false;
+  const auto planned = static_cast<double>(std::max(vertex_count_, kMinDriftVertexCount));
+  const auto current = static_cast<double>(std::max(vertex_count, kMinDriftVertexCount));
+  return std::max(planned, current) > FLAGS_query_plan_cache_max_cardinality_drift * std::min(planned, current);
+}
+
+QueryCacheLimits QueryCacheEntry::Limits() {
+  return {FLAGS_query_ast_cache_max_entries, FLAGS_query_cache_max_memory_mb * 1024 * 1024};
+}
+
+uint64_t QueryCacheEntry::EstimateSize(const CachedQuery &query) {
+  return sizeof(QueryCacheEntry) + EstimateAstStorageSize(query.ast_storage) +
+         query.required_privileges.size() * sizeof(AuthQuery::Privilege);
+}
+
+const EventCounter::Event QueryCacheEntry::kHitCounter = EventCounter::AstCacheHit;
+const EventCounter::Event QueryCacheEntry::kMissCounter = EventCounter::AstCacheMiss;
+const EventCounter::Event QueryCacheEntry::kEvictionCounter = EventCounter::AstCacheEviction;
+
+QueryCacheLimits PlanCacheEntry::Limits() {
+  return {FLAGS_query_plan_cache_max_entries, FLAGS_query_cache_max_memory_mb * 1024 * 1024};
+}
+
+uint64_t PlanCacheEntry::EstimateSize(const std::shared_ptr<CachedPlan> &plan) {
+  // The logical operators aren't tracked anywhere, so they are assumed to take
+  // as much memory as the AST they were made from.
+  return sizeof(PlanCacheEntry) + sizeof(CachedPlan) + 2 * EstimateAstStorageSize(plan->ast_storage()) +
+         plan->symbol_table().max_position() * kSymbolSizeEstimate;
+}
+
+const EventCounter::Event PlanCacheEntry::kHitCounter = EventCounter::PlanCacheHit;
+const EventCounter::Event PlanCacheEntry::kMissCounter = EventCounter::PlanCacheMiss;
+const EventCounter::Event PlanCacheEntry::kEvictionCounter = EventCounter::PlanCacheEviction;
 
 ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
-                       utils::SkipList<QueryCacheEntry> *cache, utils::SpinLock *antlr_lock,
-                       const InterpreterConfig::Query &query_config) {
+                       AstCache *cache, utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config) {
   // Strip the query for caching purposes. The process of stripping a query
   // "normalizes" it by replacing any literals with new parameters. This
   // results in just the *structure* of the query being taken into account for
@@ -46,7 +125,7 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
   // Cache the query's AST if it isn't already.
   auto hash = stripped_query.hash();
   auto accessor = cache->access();
-  auto it = accessor.find(hash);
+  auto it = cache->Find(&accessor, hash);
   std::unique_ptr<frontend::opencypher::Parser> parser;
 
   // Return a copy of both the AST storage and the query.
@@ -92,7 +171,7 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
 
     if (visitor.GetQueryInfo().is_cacheable) {
       CachedQuery cached_query{std::move(ast_storage), visitor.query(), query::GetRequiredPrivileges(visitor.query())};
-      it = accessor.insert({hash, std::move(cached_query)}).first;
+      it = cache->Insert(&accessor, hash, std::move(cached_query));
 
       get_information_from_cache(it->second);
     } else {
@@ -131,16 +210,19 @@ std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery
 }
 
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
-                                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                                              const Parameters &parameters, PlanCache *plan_cache,
                                               DbAccessor *db_accessor,
                                               const std::vector<Identifier *> &predefined_identifiers) {
-  std::optional<utils::SkipList<PlanCacheEntry>::Accessor> plan_cache_access;
+  const auto vertex_count = db_accessor->VerticesCount();
+  std::optional<PlanCache::Accessor> plan_cache_access;
   if (plan_cache) {
     plan_cache_access.emplace(plan_cache->access());
-    auto it = plan_cache_access->find(hash);
+    auto it = plan_cache->Find(&*plan_cache_access, hash);
     if (it != plan_cache_access->end()) {
-      if (it->second->IsExpired()) {
-        plan_cache_access->remove(hash);
+      if (it->second->IsExpired() || it->second->IsStale(vertex_count)) {
+        if (plan_cache->Remove(&*plan_cache_access, hash)) {
+          EventCounter::IncrementCounter(EventCounter::PlanCacheInvalidation);
+        }
       } else {
         return it->second;
       }
@@ -148,9 +230,9 @@ std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_stor
   }
 
   auto plan = std::make_shared<CachedPlan>(
-      MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers));
+      MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers), vertex_count);
   if (plan_cache_access) {
-    plan_cache_access->insert({hash, plan});
+    plan_cache->Insert(&*plan_cache_access, hash, plan);
   }
   return plan;
 }
@@ -11,6 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "query/config.hpp"
 #include "query/frontend/ast/cypher_main_visitor.hpp"
 #include "query/frontend/opencypher/parser.hpp"
@@ -18,13 +23,24 @@
 #include "query/frontend/semantic/symbol_generator.hpp"
 #include "query/frontend/stripped.hpp"
 #include "query/plan/planner.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/flag_validation.hpp"
+#include "utils/skip_list.hpp"
+#include "utils/spin_lock.hpp"
 #include "utils/timer.hpp"
 
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DECLARE_bool(query_cost_planner);
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DECLARE_int32(query_plan_cache_ttl);
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DECLARE_uint64(query_plan_cache_max_entries);
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DECLARE_uint64(query_ast_cache_max_entries);
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DECLARE_uint64(query_cache_max_memory_mb);
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DECLARE_double(query_plan_cache_max_cardinality_drift);
 
 namespace memgraph::query {
 
@@ -49,7 +65,9 @@ class LogicalPlan {
 
 class CachedPlan {
  public:
-  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan);
+  /// @param vertex_count number of vertices in the database when the plan was
+  /// made.
+  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan, int64_t vertex_count = 0);
 
   const auto &plan() const { return plan_->GetRoot(); }
   double cost() const { return plan_->GetCost(); }
@@ -61,9 +79,14 @@ class CachedPlan {
     return cache_timer_.Elapsed() > std::chrono::seconds(FLAGS_query_plan_cache_ttl);
   };
 
+  /// Returns true if the number of vertices changed so much since the plan was
+  /// made that the planner could choose a different plan.
+  bool IsStale(int64_t vertex_count) const;
+
  private:
   std::unique_ptr<LogicalPlan> plan_;
   utils::Timer cache_timer_;
+  int64_t vertex_count_;
 };
 
 struct CachedQuery {
@@ -72,16 +95,50 @@ struct CachedQuery {
   std::vector<AuthQuery::Privilege> required_privileges;
 };
 
+/// Bookkeeping of a cache entry which is used to find the entries to evict.
+struct QueryCacheEntryUsage {
+  QueryCacheEntryUsage() = default;
+  QueryCacheEntryUsage(QueryCacheEntryUsage &&other) noexcept
+      : size_bytes(other.size_bytes), last_used(other.last_used.load(std::memory_order_relaxed)) {}
+  QueryCacheEntryUsage &operator=(QueryCacheEntryUsage &&other) noexcept {
+    size_bytes = other.size_bytes;
+    last_used.store(other.last_used.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+  ~QueryCacheEntryUsage() = default;
+
+  QueryCacheEntryUsage(const QueryCacheEntryUsage &) = delete;
+  QueryCacheEntryUsage &operator=(const QueryCacheEntryUsage &) = delete;
+
+  // Estimated memory used by the entry.
+  uint64_t size_bytes{0};
+  // Value of the cache clock when the entry was last used.
+  mutable std::atomic<uint64_t> last_used{0};
+};
+
+struct QueryCacheLimits {
+  uint64_t max_entries;
+  uint64_t max_bytes;
+};
+
 struct QueryCacheEntry {
   bool operator==(const QueryCacheEntry &other) const { return first == other.first; }
   bool operator<(const QueryCacheEntry &other) const { return first < other.first; }
   bool operator==(const uint64_t &other) const { return first == other; }
   bool operator<(const uint64_t &other) const { return first < other; }
 
+  static QueryCacheLimits Limits();
+  static uint64_t EstimateSize(const CachedQuery &query);
+
+  static const EventCounter::Event kHitCounter;
+  static const EventCounter::Event kMissCounter;
+  static const EventCounter::Event kEvictionCounter;
+
   uint64_t first;
   // TODO: Maybe store the query string here and use it as a key with the hash
   // so that we eliminate the risk of hash collisions.
   CachedQuery second;
+  QueryCacheEntryUsage usage{};
 };
 
 struct PlanCacheEntry {
@@ -90,12 +147,136 @@ struct PlanCacheEntry {
   bool operator==(const uint64_t &other) const { return first == other; }
   bool operator<(const uint64_t &other) const { return first < other; }
 
+  static QueryCacheLimits Limits();
+  static uint64_t EstimateSize(const std::shared_ptr<CachedPlan> &plan);
+
+  static const EventCounter::Event kHitCounter;
+  static const EventCounter::Event kMissCounter;
+  static const EventCounter::Event kEvictionCounter;
+
   uint64_t first;
   // TODO: Maybe store the query string here and use it as a key with the hash
   // so that we eliminate the risk of hash collisions.
   std::shared_ptr<CachedPlan> second;
+  QueryCacheEntryUsage usage{};
 };
 
+/// Cache of parsed queries or query plans keyed by the hash of the stripped
+/// query. The cache is bounded both by the number of entries and by the
+/// estimated memory used by the entries, as given by `TEntry::Limits()`. When
+/// an insertion takes the cache over either of the limits, the least recently
+/// used entries are evicted until the cache is 10% under the limits, so that
+/// the cost of an eviction pass is amortized over many insertions.
+///
+/// The cache is thread-safe. Lookups only bump the logical clock of the entry,
+/// eviction passes are serialized between themselves.
+template <class TEntry>
+class QueryCache {
+ public:
+  using Accessor = typename utils::SkipList<TEntry>::Accessor;
+  using Value = decltype(std::declval<TEntry>().second);
+
+  QueryCache() = default;
+
+  QueryCache(const QueryCache &) = delete;
+  QueryCache &operator=(const QueryCache &) = delete;
+  QueryCache(QueryCache &&) = delete;
+  QueryCache &operator=(QueryCache &&) = delete;
+  ~QueryCache() = default;
+
+  Accessor access() { return entries_.access(); }
+
+  /// Returns the cached entry with the given hash or `end()` of the accessor.
+  auto Find(Accessor *accessor, uint64_t hash) {
+    auto it = accessor->find(hash);
+    if (it == accessor->end()) {
+      EventCounter::IncrementCounter(TEntry::kMissCounter);
+      return it;
+    }
+    EventCounter::IncrementCounter(TEntry::kHitCounter);
+    it->usage.last_used.store(clock_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    return it;
+  }
+
+  /// Inserts the value unless there already is an entry with the given hash
+  /// and returns the entry with the hash. Evicts the least recently used
+  /// entries if the cache is over its limits.
+  auto Insert(Accessor *accessor, uint64_t hash, Value value) {
+    TEntry entry{hash, std::move(value)};
+    const auto size_bytes = TEntry::EstimateSize(entry.second);
+    entry.usage.size_bytes = size_bytes;
+    entry.usage.last_used.store(clock_.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    auto [it, inserted] = accessor->insert(std::move(entry));
+    if (inserted) {
+      size_bytes_.fetch_add(size_bytes, std::memory_order_acq_rel);
+      EvictIfNeeded(accessor);
+    }
+    return it;
+  }
+
+  /// Removes the entry with the given hash. Returns false if there was none.
+  bool Remove(Accessor *accessor, uint64_t hash) {
+    auto it = accessor->find(hash);
+    if (it == accessor->end()) return false;
+    const auto size_bytes = it->usage.size_bytes;
+    if (!accessor->remove(hash)) return false;
+    size_bytes_.fetch_sub(size_bytes, std::memory_order_acq_rel);
+    return true;
+  }
+
+  /// Removes all of the entries, e.g. because the plans are no longer optimal.
+  void Clear() {
+    auto accessor = entries_.access();
+    for (const auto &entry : accessor) {
+      Remove(&accessor, entry.first);
+    }
+  }
+
+  uint64_t size() const { return entries_.size(); }
+
+  uint64_t SizeBytes() const { return size_bytes_.load(std::memory_order_acquire); }
+
+ private:
+  void EvictIfNeeded(Accessor *accessor) {
+    const auto limits = TEntry::Limits();
+    if (entries_.size() <= limits.max_entries && SizeBytes() <= limits.max_bytes) return;
+
+    std::unique_lock<utils::SpinLock> guard(eviction_lock_, std::try_to_lock);
+    // Another thread is already shrinking the cache.
+    if (!guard.owns_lock()) return;
+
+    struct Candidate {
+      uint64_t last_used;
+      uint64_t hash;
+      uint64_t size_bytes;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(entries_.size());
+    for (const auto &entry : *accessor) {
+      candidates.push_back(
+          {entry.usage.last_used.load(std::memory_order_relaxed), entry.first, entry.usage.size_bytes});
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.last_used < rhs.last_used; });
+
+    const auto target_entries = limits.max_entries - limits.max_entries / 10;
+    const auto target_bytes = limits.max_bytes - limits.max_bytes / 10;
+    for (const auto &candidate : candidates) {
+      if (entries_.size() <= target_entries && SizeBytes() <= target_bytes) break;
+      if (Remove(accessor, candidate.hash)) EventCounter::IncrementCounter(TEntry::kEvictionCounter);
+    }
+  }
+
+  utils::SkipList<TEntry> entries_;
+  std::atomic<uint64_t> size_bytes_{0};
+  // Logical clock used to order the entries by their last use.
+  std::atomic<uint64_t> clock_{0};
+  utils::SpinLock eviction_lock_;
+};
+
+using AstCache = QueryCache<QueryCacheEntry>;
+using PlanCache = QueryCache<PlanCacheEntry>;
+
 /**
  * A container for data related to the parsing of a query.
  */
@@ -111,8 +292,7 @@ struct ParsedQuery {
 };
 
 ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
-                       utils::SkipList<QueryCacheEntry> *cache, utils::SpinLock *antlr_lock,
-                       const InterpreterConfig::Query &query_config);
+                       AstCache *cache, utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config);
 
 class SingleNodeLogicalPlan final : public LogicalPlan {
  public:
@@ -145,7 +325,7 @@ std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery
  * because a predefined identifier can be used only in one scope.
  */
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
-                                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                                              const Parameters &parameters, PlanCache *plan_cache,
                                               DbAccessor *db_accessor,
                                               const std::vector<Identifier *> &predefined_identifiers = {});
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include <cppitertools/filter.hpp>
 #include <cppitertools/imap.hpp>
@@ -64,6 +65,11 @@ class EdgeAccessor final {
     return impl_.GetProperty(key, view);
   }
 
+  storage::Result<storage::PropertyComparison> CompareProperty(storage::View view, storage::PropertyId key,
+                                                               const storage::PropertyValue &value) const {
+    return impl_.CompareProperty(key, value, view);
+  }
+
   storage::Result<storage::PropertyValue> SetProperty(storage::PropertyId key, const storage::PropertyValue &value) {
     return impl_.SetProperty(key, value);
   }
@@ -118,6 +124,11 @@ class VertexAccessor final {
     return impl_.GetProperty(key, view);
   }
 
+  storage::Result<storage::PropertyComparison> CompareProperty(storage::View view, storage::PropertyId key,
+                                                               const storage::PropertyValue &value) const {
+    return impl_.CompareProperty(key, value, view);
+  }
+
   storage::Result<storage::PropertyValue> SetProperty(storage::PropertyId key, const storage::PropertyValue &value) {
     return impl_.SetProperty(key, value);
   }
@@ -217,6 +228,35 @@ class DbAccessor final {
     Iterator end() { return Iterator(iterable_.end()); }
   };
 
+  class EdgesIterable final {
+    storage::EdgeTypeIndex::Iterable iterable_;
+
+   public:
+    class Iterator final {
+      storage::EdgeTypeIndex::Iterable::Iterator it_;
+
+     public:
+      explicit Iterator(storage::EdgeTypeIndex::Iterable::Iterator it) : it_(it) {}
+
+      EdgeAccessor operator*() const { return EdgeAccessor(*it_); }
+
+      Iterator &operator++() {
+        ++it_;
+        return *this;
+      }
+
+      bool operator==(const Iterator &other) const { return it_ == other.it_; }
+
+      bool operator!=(const Iterator &other) const { return !(other == *this); }
+    };
+
+    explicit EdgesIterable(storage::EdgeTypeIndex::Iterable iterable) : iterable_(std::move(iterable)) {}
+
+    Iterator begin() { return Iterator(iterable_.begin()); }
+
+    Iterator end() { return Iterator(iterable_.end()); }
+  };
+
  public:
   explicit DbAccessor(storage::Storage::Accessor *accessor) : accessor_(accessor) {}
 
@@ -249,7 +289,29 @@ class DbAccessor final {
     return VerticesIterable(accessor_->Vertices(label, property, lower, upper, view));
   }
 
-  VertexAccessor InsertVertex() { return VertexAccessor(accessor_->CreateVertex()); }
+  VerticesIterable Vertices(storage::View view, storage::LabelId label,
+                            const std::vector<storage::PropertyId> &properties,
+                            std::vector<storage::PropertyValue> prefix) {
+    return VerticesIterable(accessor_->Vertices(label, properties, std::move(prefix), view));
+  }
+
+  /// Returns the candidates from the text index whose property may contain
+  /// `text`. The property value still has to be checked.
+  VerticesIterable TextVertices(storage::View view, storage::LabelId label, storage::PropertyId property,
+                                std::string_view text) {
+    return VerticesIterable(accessor_->TextVertices(label, property, text, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type) {
+    return EdgesIterable(accessor_->Edges(edge_type, view));
+  }
+
+  /// @throw WriteQueryInReadOnlyTxException if the transaction is read-only.
+  VertexAccessor InsertVertex() {
+    auto maybe_vertex = accessor_->CreateVertex();
+    if (maybe_vertex.HasError()) throw WriteQueryInReadOnlyTxException();
+    return VertexAccessor(*maybe_vertex);
+  }
 
   storage::Result<EdgeAccessor> InsertEdge(VertexAccessor *from, VertexAccessor *to,
                                            const storage::EdgeTypeId &edge_type) {
@@ -326,6 +388,8 @@ class DbAccessor final {
 
   utils::BasicResult<storage::ConstraintViolation, void> Commit() { return accessor_->Commit(); }
 
+  utils::BasicResult<storage::ConstraintViolation, void> CommitAndRestart() { return accessor_->CommitAndRestart(); }
+
   void Abort() { accessor_->Abort(); }
 
   bool LabelIndexExists(storage::LabelId label) const { return accessor_->LabelIndexExists(label); }
@@ -334,6 +398,20 @@ class DbAccessor final {
     return accessor_->LabelPropertyIndexExists(label, prop);
   }
 
+  bool LabelPropertiesIndexExists(storage::LabelId label, const std::vector<storage::PropertyId> &properties) const {
+    return accessor_->LabelPropertiesIndexExists(label, properties);
+  }
+
+  std::vector<std::vector<storage::PropertyId>> LabelPropertiesIndices(storage::LabelId label) const {
+    return accessor_->LabelPropertiesIndices(label);
+  }
+
+  bool TextIndexExists(storage::LabelId label, storage::PropertyId property) const {
+    return accessor_->TextIndexExists(label, property);
+  }
+
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) const { return accessor_->EdgeTypeIndexExists(edge_type); }
+
   int64_t VerticesCount() const { return accessor_->ApproximateVertexCount(); }
 
   int64_t VerticesCount(storage::LabelId label) const { return accessor_->ApproximateVertexCount(label); }
@@ -353,6 +431,27 @@ class DbAccessor final {
     return accessor_->ApproximateVertexCount(label, property, lower, upper);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties) const {
+    return accessor_->ApproximateVertexCount(label, properties);
+  }
+
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix) const {
+    return accessor_->ApproximateVertexCount(label, properties, prefix);
+  }
+
+  int64_t TextVerticesCount(storage::LabelId label, storage::PropertyId property) const {
+    return accessor_->ApproximateTextVertexCount(label, property);
+  }
+
+  int64_t TextVerticesCount(storage::LabelId label, storage::PropertyId property, std::string_view text) const {
+    return accessor_->ApproximateTextVertexCount(label, property, text);
+  }
+
+  int64_t EdgesCount() const { return accessor_->ApproximateEdgeCount(); }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) const { return accessor_->ApproximateEdgeCount(edge_type); }
+
   storage::IndicesInfo ListAllIndices() const { return accessor_->ListAllIndices(); }
 
   storage::ConstraintsInfo ListAllConstraints() const { return accessor_->ListAllConstraints(); }
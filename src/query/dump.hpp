@@ -55,6 +55,9 @@ struct PullPlanDump {
 
   PullChunk CreateLabelIndicesPullChunk();
   PullChunk CreateLabelPropertyIndicesPullChunk();
+  PullChunk CreateLabelPropertiesIndicesPullChunk();
+  PullChunk CreateTextIndicesPullChunk();
+  PullChunk CreateEdgeTypeIndicesPullChunk();
   PullChunk CreateExistenceConstraintsPullChunk();
   PullChunk CreateUniqueConstraintsPullChunk();
   PullChunk CreateInternalIndexPullChunk();
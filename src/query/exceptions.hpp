@@ -103,6 +103,29 @@ class InfoInMulticommandTxException : public QueryException {
   InfoInMulticommandTxException() : QueryException("Info reporting not allowed in multicommand transactions.") {}
 };
 
+class PeriodicCommitInMulticommandTxException : public QueryException {
+ public:
+  using QueryException::QueryException;
+  PeriodicCommitInMulticommandTxException()
+      : QueryException("USING PERIODIC COMMIT not allowed in multicommand transactions.") {}
+};
+
+class PeriodicCommitWithTriggersException : public QueryException {
+ public:
+  using QueryException::QueryException;
+  PeriodicCommitWithTriggersException()
+      : QueryException(
+            "USING PERIODIC COMMIT not allowed while triggers are defined, because the triggers wouldn't see the "
+            "periodically committed changes.") {}
+};
+
+class WriteQueryInReadOnlyTxException : public QueryException {
+ public:
+  using QueryException::QueryException;
+  WriteQueryInReadOnlyTxException()
+      : QueryException("Queries that modify the database can't be run in a read-only transaction.") {}
+};
+
 /**
  * An exception for an illegal operation that can not be detected
  * before the query starts executing over data.
@@ -224,4 +247,9 @@ class VersionInfoInMulticommandTxException : public QueryException {
       : QueryException("Version info query not allowed in multicommand transactions.") {}
 };
 
+class QueryAdmissionException final : public QueryException {
+ public:
+  using QueryException::QueryException;
+};
+
 }  // namespace memgraph::query
@@ -45,6 +45,7 @@ memgraphCypherKeyword : cypherKeyword
                       | DENY
                       | DROP
                       | DUMP
+                      | EDGE
                       | EXECUTE
                       | FOR
                       | FOREACH
@@ -64,6 +65,7 @@ memgraphCypherKeyword : cypherKeyword
                       | NEXT
                       | NO
                       | PASSWORD
+                      | PERIODIC
                       | PULSAR
                       | PORT
                       | PRIVILEGES
@@ -85,6 +87,7 @@ memgraphCypherKeyword : cypherKeyword
                       | STREAM
                       | STREAMS
                       | SYNC
+                      | TEXT
                       | TIMEOUT
                       | TO
                       | TOPICS
@@ -97,6 +100,7 @@ memgraphCypherKeyword : cypherKeyword
                       | UPDATE
                       | USER
                       | USERS
+                      | USING
                       | VERSION
                       ;
 
@@ -107,6 +111,8 @@ symbolicName : UnescapedSymbolicName
 
 query : cypherQuery
       | indexQuery
+      | edgeIndexQuery
+      | textIndexQuery
       | explainQuery
       | profileQuery
       | infoQuery
@@ -153,6 +159,10 @@ triggerQuery : createTrigger
              | showTriggers
              ;
 
+cypherQuery : ( usingPeriodicCommit )? singleQuery ( cypherUnion )* ( queryMemoryLimit )? ;
+
+usingPeriodicCommit : USING PERIODIC COMMIT literal ;
+
 clause : cypherMatch
        | unwind
        | merge
@@ -310,6 +320,18 @@ isolationLevelQuery : SET isolationLevelScope TRANSACTION ISOLATION LEVEL isolat
 
 createSnapshotQuery : CREATE SNAPSHOT ;
 
+edgeIndexQuery : createEdgeIndex | dropEdgeIndex ;
+
+createEdgeIndex : CREATE EDGE INDEX ON ':' relTypeName ;
+
+dropEdgeIndex : DROP EDGE INDEX ON ':' relTypeName ;
+
+textIndexQuery : createTextIndex | dropTextIndex ;
+
+createTextIndex : CREATE TEXT INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
+dropTextIndex : DROP TEXT INDEX ON ':' labelName '(' propertyKeyName ')' ;
+
 streamName : symbolicName ;
 
 symbolicNameWithMinus : symbolicName ( MINUS symbolicName )* ;
@@ -52,6 +52,7 @@ DIRECTORY           : D I R E C T O R Y ;
 DROP                : D R O P ;
 DUMP                : D U M P ;
 DURABILITY          : D U R A B I L I T Y ;
+EDGE                : E D G E ;
 EXECUTE             : E X E C U T E ;
 FOR                 : F O R ;
 FOREACH             : F O R E A C H;
@@ -76,6 +77,7 @@ MODULE_WRITE        : M O D U L E UNDERSCORE W R I T E ;
 NEXT                : N E X T ;
 NO                  : N O ;
 PASSWORD            : P A S S W O R D ;
+PERIODIC            : P E R I O D I C ;
 PORT                : P O R T ;
 PRIVILEGES          : P R I V I L E G E S ;
 PULSAR              : P U L S A R ;
@@ -100,6 +102,7 @@ STOP                : S T O P ;
 STREAM              : S T R E A M ;
 STREAMS             : S T R E A M S ;
 SYNC                : S Y N C ;
+TEXT                : T E X T ;
 TIMEOUT             : T I M E O U T ;
 TO                  : T O ;
 TOPICS              : T O P I C S;
@@ -112,5 +115,6 @@ UNLOCK              : U N L O C K ;
 UPDATE              : U P D A T E ;
 USER                : U S E R ;
 USERS               : U S E R S ;
+USING               : U S I N G ;
 VERSION             : V E R S I O N ;
 WEBSOCKET           : W E B S O C K E T ;
@@ -27,6 +27,10 @@ class PrivilegeExtractor : public QueryVisitor<void>, public HierarchicalTreeVis
 
   void Visit(IndexQuery &) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
 
+  void Visit(EdgeIndexQuery &) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+
+  void Visit(TextIndexQuery &) override { AddPrivilege(AuthQuery::Privilege::INDEX); }
+
   void Visit(AuthQuery &) override { AddPrivilege(AuthQuery::Privilege::AUTH); }
 
   void Visit(ExplainQuery &query) override { query.cypher_query_->Accept(*this); }
@@ -204,6 +204,8 @@ const trie::Trie kKeywords = {"union",
                               "pulsar",
                               "service_url",
                               "version",
+                              "edge",
+                              "text",
                               "websocket"
                               "foreach"};
 
@@ -400,6 +400,7 @@ TypedValue Properties(const TypedValue *args, int64_t nargs, const FunctionConte
           throw query::QueryRuntimeException("Trying to get properties from an object that doesn't exist.");
         case storage::Error::SERIALIZATION_ERROR:
         case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
         case storage::Error::PROPERTIES_DISABLED:
           throw QueryRuntimeException("Unexpected error when getting properties.");
       }
@@ -454,6 +455,7 @@ size_t UnwrapDegreeResult(storage::Result<size_t> maybe_degree) {
         throw query::QueryRuntimeException("Trying to get degree of a node that doesn't exist.");
       case storage::Error::SERIALIZATION_ERROR:
       case storage::Error::VERTEX_HAS_EDGES:
+      case storage::Error::READ_ONLY_TRANSACTION:
       case storage::Error::PROPERTIES_DISABLED:
         throw QueryRuntimeException("Unexpected error when getting node degree.");
     }
@@ -605,6 +607,7 @@ TypedValue Keys(const TypedValue *args, int64_t nargs, const FunctionContext &ct
           throw query::QueryRuntimeException("Trying to get keys from an object that doesn't exist.");
         case storage::Error::SERIALIZATION_ERROR:
         case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
         case storage::Error::PROPERTIES_DISABLED:
           throw QueryRuntimeException("Unexpected error when getting keys.");
       }
@@ -638,6 +641,7 @@ TypedValue Labels(const TypedValue *args, int64_t nargs, const FunctionContext &
         throw query::QueryRuntimeException("Trying to get labels from a node that doesn't exist.");
       case storage::Error::SERIALIZATION_ERROR:
       case storage::Error::VERTEX_HAS_EDGES:
+      case storage::Error::READ_ONLY_TRANSACTION:
       case storage::Error::PROPERTIES_DISABLED:
         throw QueryRuntimeException("Unexpected error when getting labels.");
     }
@@ -28,9 +28,14 @@
 #include "query/interpret/frame.hpp"
 #include "query/typed_value.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/typeinfo.hpp"
 
 namespace memgraph::query {
 
+/// Evaluates expressions by walking the AST of the cached plan. Expressions
+/// aren't compiled into a separate representation; instead the common cases,
+/// such as a property compared with a literal or arithmetic on two ints, are
+/// recognized from the AST shape of the visited node and take a fast path.
 class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
  public:
   ExpressionEvaluator(Frame *frame, const SymbolTable &symbol_table, const EvaluationContext &ctx, DbAccessor *dba,
@@ -63,6 +68,26 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
     }                                                                                                          \
   }
 
+  // Comparisons of two ints or two doubles are the most common filters, so
+  // they are evaluated directly instead of going through the generic
+  // TypedValue operators.
+#define COMPARISON_OPERATOR_VISITOR(OP_NODE, CPP_OP, CYPHER_OP)                                                \
+  TypedValue Visit(OP_NODE &op) override {                                                                     \
+    auto val1 = op.expression1_->Accept(*this);                                                                \
+    auto val2 = op.expression2_->Accept(*this);                                                                \
+    if (val1.IsInt() && val2.IsInt()) {                                                                        \
+      return TypedValue(val1.ValueInt() CPP_OP val2.ValueInt(), ctx_->memory);                                 \
+    }                                                                                                          \
+    if (val1.IsDouble() && val2.IsDouble()) {                                                                  \
+      return TypedValue(val1.ValueDouble() CPP_OP val2.ValueDouble(), ctx_->memory);                           \
+    }                                                                                                          \
+    try {                                                                                                      \
+      return val1 CPP_OP val2;                                                                                 \
+    } catch (const TypedValueException &) {                                                                    \
+      throw QueryRuntimeException("Invalid types: {} and {} for '{}'.", val1.type(), val2.type(), #CYPHER_OP); \
+    }                                                                                                          \
+  }
+
 #define UNARY_OPERATOR_VISITOR(OP_NODE, CPP_OP, CYPHER_OP)                              \
   TypedValue Visit(OP_NODE &op) override {                                              \
     auto val = op.expression_->Accept(*this);                                           \
@@ -80,20 +105,27 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
   BINARY_OPERATOR_VISITOR(MultiplicationOperator, *, *);
   BINARY_OPERATOR_VISITOR(DivisionOperator, /, /);
   BINARY_OPERATOR_VISITOR(ModOperator, %, %);
-  BINARY_OPERATOR_VISITOR(NotEqualOperator, !=, <>);
-  BINARY_OPERATOR_VISITOR(EqualOperator, ==, =);
-  BINARY_OPERATOR_VISITOR(LessOperator, <, <);
-  BINARY_OPERATOR_VISITOR(GreaterOperator, >, >);
-  BINARY_OPERATOR_VISITOR(LessEqualOperator, <=, <=);
-  BINARY_OPERATOR_VISITOR(GreaterEqualOperator, >=, >=);
+  COMPARISON_OPERATOR_VISITOR(LessOperator, <, <);
+  COMPARISON_OPERATOR_VISITOR(GreaterOperator, >, >);
+  COMPARISON_OPERATOR_VISITOR(LessEqualOperator, <=, <=);
+  COMPARISON_OPERATOR_VISITOR(GreaterEqualOperator, >=, >=);
 
   UNARY_OPERATOR_VISITOR(NotOperator, !, NOT);
   UNARY_OPERATOR_VISITOR(UnaryPlusOperator, +, +);
   UNARY_OPERATOR_VISITOR(UnaryMinusOperator, -, -);
 
 #undef BINARY_OPERATOR_VISITOR
+#undef COMPARISON_OPERATOR_VISITOR
 #undef UNARY_OPERATOR_VISITOR
 
+  TypedValue Visit(EqualOperator &op) override { return EvaluateEquality(op.expression1_, op.expression2_, "="); }
+
+  TypedValue Visit(NotEqualOperator &op) override {
+    auto value = EvaluateEquality(op.expression1_, op.expression2_, "<>");
+    if (value.IsNull()) return value;
+    return TypedValue(!value.ValueBool(), ctx_->memory);
+  }
+
   TypedValue Visit(AndOperator &op) override {
     auto value1 = op.expression1_->Accept(*this);
     if (value1.IsBool() && !value1.ValueBool()) {
@@ -258,116 +290,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
   }
 
   TypedValue Visit(PropertyLookup &property_lookup) override {
-    auto expression_result = property_lookup.expression_->Accept(*this);
-    auto maybe_date = [this](const auto &date, const auto &prop_name) -> std::optional<TypedValue> {
-      if (prop_name == "year") {
-        return TypedValue(date.year, ctx_->memory);
-      }
-      if (prop_name == "month") {
-        return TypedValue(date.month, ctx_->memory);
-      }
-      if (prop_name == "day") {
-        return TypedValue(date.day, ctx_->memory);
-      }
-      return std::nullopt;
-    };
-    auto maybe_local_time = [this](const auto &lt, const auto &prop_name) -> std::optional<TypedValue> {
-      if (prop_name == "hour") {
-        return TypedValue(lt.hour, ctx_->memory);
-      }
-      if (prop_name == "minute") {
-        return TypedValue(lt.minute, ctx_->memory);
-      }
-      if (prop_name == "second") {
-        return TypedValue(lt.second, ctx_->memory);
-      }
-      if (prop_name == "millisecond") {
-        return TypedValue(lt.millisecond, ctx_->memory);
-      }
-      if (prop_name == "microsecond") {
-        return TypedValue(lt.microsecond, ctx_->memory);
-      }
-      return std::nullopt;
-    };
-    auto maybe_duration = [this](const auto &dur, const auto &prop_name) -> std::optional<TypedValue> {
-      if (prop_name == "day") {
-        return TypedValue(dur.Days(), ctx_->memory);
-      }
-      if (prop_name == "hour") {
-        return TypedValue(dur.SubDaysAsHours(), ctx_->memory);
-      }
-      if (prop_name == "minute") {
-        return TypedValue(dur.SubDaysAsMinutes(), ctx_->memory);
-      }
-      if (prop_name == "second") {
-        return TypedValue(dur.SubDaysAsSeconds(), ctx_->memory);
-      }
-      if (prop_name == "millisecond") {
-        return TypedValue(dur.SubDaysAsMilliseconds(), ctx_->memory);
-      }
-      if (prop_name == "microsecond") {
-        return TypedValue(dur.SubDaysAsMicroseconds(), ctx_->memory);
-      }
-      if (prop_name == "nanosecond") {
-        return TypedValue(dur.SubDaysAsNanoseconds(), ctx_->memory);
-      }
-      return std::nullopt;
-    };
-    switch (expression_result.type()) {
-      case TypedValue::Type::Null:
-        return TypedValue(ctx_->memory);
-      case TypedValue::Type::Vertex:
-        return TypedValue(GetProperty(expression_result.ValueVertex(), property_lookup.property_), ctx_->memory);
-      case TypedValue::Type::Edge:
-        return TypedValue(GetProperty(expression_result.ValueEdge(), property_lookup.property_), ctx_->memory);
-      case TypedValue::Type::Map: {
-        // NOTE: Take non-const reference to map, so that we can move out the
-        // looked-up element as the result.
-        auto &map = expression_result.ValueMap();
-        auto found = map.find(property_lookup.property_.name.c_str());
-        if (found == map.end()) return TypedValue(ctx_->memory);
-        // NOTE: Explicit move is needed, so that we return the move constructed
-        // value and preserve the correct MemoryResource.
-        return std::move(found->second);
-      }
-      case TypedValue::Type::Duration: {
-        const auto &prop_name = property_lookup.property_.name;
-        const auto &dur = expression_result.ValueDuration();
-        if (auto dur_field = maybe_duration(dur, prop_name); dur_field) {
-          return std::move(*dur_field);
-        }
-        throw QueryRuntimeException("Invalid property name {} for Duration", prop_name);
-      }
-      case TypedValue::Type::Date: {
-        const auto &prop_name = property_lookup.property_.name;
-        const auto &date = expression_result.ValueDate();
-        if (auto date_field = maybe_date(date, prop_name); date_field) {
-          return std::move(*date_field);
-        }
-        throw QueryRuntimeException("Invalid property name {} for Date", prop_name);
-      }
-      case TypedValue::Type::LocalTime: {
-        const auto &prop_name = property_lookup.property_.name;
-        const auto &lt = expression_result.ValueLocalTime();
-        if (auto lt_field = maybe_local_time(lt, prop_name); lt_field) {
-          return std::move(*lt_field);
-        }
-        throw QueryRuntimeException("Invalid property name {} for LocalTime", prop_name);
-      }
-      case TypedValue::Type::LocalDateTime: {
-        const auto &prop_name = property_lookup.property_.name;
-        const auto &ldt = expression_result.ValueLocalDateTime();
-        if (auto date_field = maybe_date(ldt.date, prop_name); date_field) {
-          return std::move(*date_field);
-        }
-        if (auto lt_field = maybe_local_time(ldt.local_time, prop_name); lt_field) {
-          return std::move(*lt_field);
-        }
-        throw QueryRuntimeException("Invalid property name {} for LocalDateTime", prop_name);
-      }
-      default:
-        throw QueryRuntimeException("Only nodes, edges, maps and temporal types have properties to be looked-up.");
-    }
+    return LookupProperty(property_lookup.expression_->Accept(*this), property_lookup);
   }
 
   TypedValue Visit(LabelsTest &labels_test) override {
@@ -397,6 +320,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
                 throw query::QueryRuntimeException("Trying to access labels from a node that doesn't exist.");
               case storage::Error::SERIALIZATION_ERROR:
               case storage::Error::VERTEX_HAS_EDGES:
+              case storage::Error::READ_ONLY_TRANSACTION:
               case storage::Error::PROPERTIES_DISABLED:
                 throw QueryRuntimeException("Unexpected error when accessing labels.");
             }
@@ -688,6 +612,195 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
   }
 
  private:
+  TypedValue LookupProperty(TypedValue expression_result, const PropertyLookup &property_lookup) {
+    auto maybe_date = [this](const auto &date, const auto &prop_name) -> std::optional<TypedValue> {
+      if (prop_name == "year") {
+        return TypedValue(date.year, ctx_->memory);
+      }
+      if (prop_name == "month") {
+        return TypedValue(date.month, ctx_->memory);
+      }
+      if (prop_name == "day") {
+        return TypedValue(date.day, ctx_->memory);
+      }
+      return std::nullopt;
+    };
+    auto maybe_local_time = [this](const auto &lt, const auto &prop_name) -> std::optional<TypedValue> {
+      if (prop_name == "hour") {
+        return TypedValue(lt.hour, ctx_->memory);
+      }
+      if (prop_name == "minute") {
+        return TypedValue(lt.minute, ctx_->memory);
+      }
+      if (prop_name == "second") {
+        return TypedValue(lt.second, ctx_->memory);
+      }
+      if (prop_name == "millisecond") {
+        return TypedValue(lt.millisecond, ctx_->memory);
+      }
+      if (prop_name == "microsecond") {
+        return TypedValue(lt.microsecond, ctx_->memory);
+      }
+      return std::nullopt;
+    };
+    auto maybe_duration = [this](const auto &dur, const auto &prop_name) -> std::optional<TypedValue> {
+      if (prop_name == "day") {
+        return TypedValue(dur.Days(), ctx_->memory);
+      }
+      if (prop_name == "hour") {
+        return TypedValue(dur.SubDaysAsHours(), ctx_->memory);
+      }
+      if (prop_name == "minute") {
+        return TypedValue(dur.SubDaysAsMinutes(), ctx_->memory);
+      }
+      if (prop_name == "second") {
+        return TypedValue(dur.SubDaysAsSeconds(), ctx_->memory);
+      }
+      if (prop_name == "millisecond") {
+        return TypedValue(dur.SubDaysAsMilliseconds(), ctx_->memory);
+      }
+      if (prop_name == "microsecond") {
+        return TypedValue(dur.SubDaysAsMicroseconds(), ctx_->memory);
+      }
+      if (prop_name == "nanosecond") {
+        return TypedValue(dur.SubDaysAsNanoseconds(), ctx_->memory);
+      }
+      return std::nullopt;
+    };
+    switch (expression_result.type()) {
+      case TypedValue::Type::Null:
+        return TypedValue(ctx_->memory);
+      case TypedValue::Type::Vertex:
+        return TypedValue(GetProperty(expression_result.ValueVertex(), property_lookup.property_), ctx_->memory);
+      case TypedValue::Type::Edge:
+        return TypedValue(GetProperty(expression_result.ValueEdge(), property_lookup.property_), ctx_->memory);
+      case TypedValue::Type::Map: {
+        // NOTE: Take non-const reference to map, so that we can move out the
+        // looked-up element as the result.
+        auto &map = expression_result.ValueMap();
+        auto found = map.find(property_lookup.property_.name.c_str());
+        if (found == map.end()) return TypedValue(ctx_->memory);
+        // NOTE: Explicit move is needed, so that we return the move constructed
+        // value and preserve the correct MemoryResource.
+        return std::move(found->second);
+      }
+      case TypedValue::Type::Duration: {
+        const auto &prop_name = property_lookup.property_.name;
+        const auto &dur = expression_result.ValueDuration();
+        if (auto dur_field = maybe_duration(dur, prop_name); dur_field) {
+          return std::move(*dur_field);
+        }
+        throw QueryRuntimeException("Invalid property name {} for Duration", prop_name);
+      }
+      case TypedValue::Type::Date: {
+        const auto &prop_name = property_lookup.property_.name;
+        const auto &date = expression_result.ValueDate();
+        if (auto date_field = maybe_date(date, prop_name); date_field) {
+          return std::move(*date_field);
+        }
+        throw QueryRuntimeException("Invalid property name {} for Date", prop_name);
+      }
+      case TypedValue::Type::LocalTime: {
+        const auto &prop_name = property_lookup.property_.name;
+        const auto &lt = expression_result.ValueLocalTime();
+        if (auto lt_field = maybe_local_time(lt, prop_name); lt_field) {
+          return std::move(*lt_field);
+        }
+        throw QueryRuntimeException("Invalid property name {} for LocalTime", prop_name);
+      }
+      case TypedValue::Type::LocalDateTime: {
+        const auto &prop_name = property_lookup.property_.name;
+        const auto &ldt = expression_result.ValueLocalDateTime();
+        if (auto date_field = maybe_date(ldt.date, prop_name); date_field) {
+          return std::move(*date_field);
+        }
+        if (auto lt_field = maybe_local_time(ldt.local_time, prop_name); lt_field) {
+          return std::move(*lt_field);
+        }
+        throw QueryRuntimeException("Invalid property name {} for LocalDateTime", prop_name);
+      }
+      default:
+        throw QueryRuntimeException("Only nodes, edges, maps and temporal types have properties to be looked-up.");
+    }
+  }
+
+  /// Returns the literal value of `expression` if it's a primitive literal or a
+  /// parameter whose value can be compared directly with a stored property.
+  const storage::PropertyValue *GetComparableLiteral(Expression *expression) const {
+    const storage::PropertyValue *value = nullptr;
+    if (const auto *literal = utils::Downcast<PrimitiveLiteral>(expression)) {
+      value = &literal->value_;
+    } else if (const auto *parameter = utils::Downcast<ParameterLookup>(expression)) {
+      value = &ctx_->parameters.AtTokenPosition(parameter->token_position_);
+    }
+    // Lists, maps and temporal values have different equality rules in
+    // TypedValue and PropertyValue.
+    if (value == nullptr || !(value->IsBool() || value->IsInt() || value->IsDouble() || value->IsString())) {
+      return nullptr;
+    }
+    return value;
+  }
+
+  TypedValue EvaluateEquality(Expression *expression1, Expression *expression2, const char *cypher_op) {
+    // A vertex or edge property compared with a literal is compared inside
+    // the property store, so the stored value is never copied out.
+    auto *lookup = utils::Downcast<PropertyLookup>(expression1);
+    const auto *literal = lookup ? GetComparableLiteral(expression2) : nullptr;
+    if (!literal) {
+      lookup = utils::Downcast<PropertyLookup>(expression2);
+      literal = lookup ? GetComparableLiteral(expression1) : nullptr;
+    }
+    if (literal) {
+      auto record = lookup->expression_->Accept(*this);
+      switch (record.type()) {
+        case TypedValue::Type::Null:
+          return TypedValue(ctx_->memory);
+        case TypedValue::Type::Vertex:
+          return ComparePropertyWithLiteral(record.ValueVertex(), lookup->property_, *literal);
+        case TypedValue::Type::Edge:
+          return ComparePropertyWithLiteral(record.ValueEdge(), lookup->property_, *literal);
+        default:
+          return LookupProperty(std::move(record), *lookup) == TypedValue(*literal, ctx_->memory);
+      }
+    }
+    auto val1 = expression1->Accept(*this);
+    auto val2 = expression2->Accept(*this);
+    if (val1.IsInt() && val2.IsInt()) {
+      return TypedValue(val1.ValueInt() == val2.ValueInt(), ctx_->memory);
+    }
+    try {
+      return val1 == val2;
+    } catch (const TypedValueException &) {
+      throw QueryRuntimeException("Invalid types: {} and {} for '{}'.", val1.type(), val2.type(), cypher_op);
+    }
+  }
+
+  template <class TRecordAccessor>
+  TypedValue ComparePropertyWithLiteral(const TRecordAccessor &record_accessor, PropertyIx prop,
+                                        const storage::PropertyValue &literal) {
+    auto maybe_comparison = record_accessor.CompareProperty(view_, ctx_->properties[prop.ix], literal);
+    if (maybe_comparison.HasError() && maybe_comparison.GetError() == storage::Error::NONEXISTENT_OBJECT) {
+      // Same MERGE hack as in `GetProperty`.
+      maybe_comparison = record_accessor.CompareProperty(storage::View::NEW, ctx_->properties[prop.ix], literal);
+    }
+    if (maybe_comparison.HasError()) {
+      switch (maybe_comparison.GetError()) {
+        case storage::Error::DELETED_OBJECT:
+          throw QueryRuntimeException("Trying to get a property from a deleted object.");
+        case storage::Error::NONEXISTENT_OBJECT:
+          throw query::QueryRuntimeException("Trying to get a property from an object that doesn't exist.");
+        case storage::Error::SERIALIZATION_ERROR:
+        case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
+        case storage::Error::PROPERTIES_DISABLED:
+          throw QueryRuntimeException("Unexpected error when getting a property.");
+      }
+    }
+    // A missing property is Null and comparing with Null gives Null.
+    if (*maybe_comparison == storage::PropertyComparison::ABSENT) return TypedValue(ctx_->memory);
+    return TypedValue(*maybe_comparison == storage::PropertyComparison::EQUAL, ctx_->memory);
+  }
+
   template <class TRecordAccessor>
   storage::PropertyValue GetProperty(const TRecordAccessor &record_accessor, PropertyIx prop) {
     auto maybe_prop = record_accessor.GetProperty(view_, ctx_->properties[prop.ix]);
@@ -708,6 +821,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
           throw query::QueryRuntimeException("Trying to get a property from an object that doesn't exist.");
         case storage::Error::SERIALIZATION_ERROR:
         case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
         case storage::Error::PROPERTIES_DISABLED:
           throw QueryRuntimeException("Unexpected error when getting a property.");
       }
@@ -735,6 +849,7 @@ class ExpressionEvaluator : public ExpressionVisitor<TypedValue> {
           throw query::QueryRuntimeException("Trying to get a property from an object that doesn't exist.");
         case storage::Error::SERIALIZATION_ERROR:
         case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
         case storage::Error::PROPERTIES_DISABLED:
           throw QueryRuntimeException("Unexpected error when getting a property.");
       }
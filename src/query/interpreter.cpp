@@ -47,6 +47,7 @@
 #include "utils/algorithm.hpp"
 #include "utils/csv_parsing.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/flag_validation.hpp"
 #include "utils/license.hpp"
@@ -67,11 +68,21 @@ extern Event ReadWriteQuery;
 
 extern const Event LabelIndexCreated;
 extern const Event LabelPropertyIndexCreated;
+extern const Event LabelPropertiesIndexCreated;
+extern const Event EdgeTypeIndexCreated;
+extern const Event TextIndexCreated;
 
 extern const Event StreamsCreated;
 extern const Event TriggersCreated;
+
+extern const Event PlanCacheInvalidation;
 }  // namespace EventCounter
 
+namespace EventHistogram {
+extern const Event QueryParseLatency;
+extern const Event QueryPlanLatency;
+}  // namespace EventHistogram
+
 namespace memgraph::query {
 
 namespace {
@@ -996,19 +1007,27 @@ Interpreter::Interpreter(InterpreterContext *interpreter_context) : interpreter_
   MG_ASSERT(interpreter_context_, "Interpreter context must not be NULL");
 }
 
-PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper) {
+PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper, const bool read_only,
+                                                   std::optional<std::string> admitted_user) {
   std::function<void()> handler;
 
   if (query_upper == "BEGIN") {
-    handler = [this] {
+    handler = [this, read_only, admitted_user = std::move(admitted_user)] {
       if (in_explicit_transaction_) {
         throw ExplicitTransactionUsageException("Nested transactions are not supported.");
       }
+      // The whole transaction is admitted at once, before it starts, so the
+      // queries inside it don't wait for the quotas held by the transaction
+      // itself.
+      if (admitted_user) {
+        transaction_admission_ = interpreter_context_->admission_controller.Admit(*admitted_user, std::nullopt);
+      }
       in_explicit_transaction_ = true;
       expect_rollback_ = false;
 
-      db_accessor_ =
-          std::make_unique<storage::Storage::Accessor>(interpreter_context_->db->Access(GetIsolationLevelOverride()));
+      db_accessor_ = std::make_unique<storage::Storage::Accessor>(
+          read_only ? interpreter_context_->db->ReadOnlyAccess(GetIsolationLevelOverride())
+                    : interpreter_context_->db->Access(GetIsolationLevelOverride()));
       execution_db_accessor_.emplace(db_accessor_.get());
 
       if (interpreter_context_->trigger_store.HasTriggers()) {
@@ -1035,6 +1054,7 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper)
 
       expect_rollback_ = false;
       in_explicit_transaction_ = false;
+      transaction_admission_ = {};
     };
   } else if (query_upper == "ROLLBACK") {
     handler = [this] {
@@ -1058,12 +1078,20 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper)
           RWType::NONE};
 }
 
-PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string, TypedValue> *summary,
-                                 InterpreterContext *interpreter_context, DbAccessor *dba,
-                                 utils::MemoryResource *execution_memory, std::vector<Notification> *notifications,
+PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                 std::map<std::string, TypedValue> *summary, InterpreterContext *interpreter_context,
+                                 DbAccessor *dba, utils::MemoryResource *execution_memory,
+                                 std::vector<Notification> *notifications,
                                  TriggerContextCollector *trigger_context_collector = nullptr) {
   auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
 
+  if (in_explicit_transaction && cypher_query->periodic_commit_frequency_) {
+    throw PeriodicCommitInMulticommandTxException();
+  }
+  if (cypher_query->periodic_commit_frequency_ && interpreter_context->trigger_store.HasTriggers()) {
+    throw PeriodicCommitWithTriggersException();
+  }
+
   Frame frame(0);
   SymbolTable symbol_table;
   EvaluationContext evaluation_context;
@@ -1271,10 +1299,8 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
 
   // Creating an index influences computed plan costs.
   auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
-    auto access = plan_cache->access();
-    for (auto &kv : access) {
-      access.remove(kv.first);
-    }
+    EventCounter::IncrementCounter(EventCounter::PlanCacheInvalidation, plan_cache->size());
+    plan_cache->Clear();
   };
 
   auto label = interpreter_context->db->NameToLabel(index_query->label_.name);
@@ -1289,8 +1315,8 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
   }
   auto properties_stringified = utils::Join(properties_string, ", ");
 
-  if (properties.size() > 1) {
-    throw utils::NotYetImplemented("index on multiple properties");
+  if (std::set<storage::PropertyId>(properties.begin(), properties.end()).size() != properties.size()) {
+    throw SyntaxException("The given set of properties contains duplicates.");
   }
 
   Notification index_notification(SeverityLevel::INFO);
@@ -1310,14 +1336,20 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
                 fmt::format("Index on label {} on properties {} already exists.", label_name, properties_stringified);
           }
           EventCounter::IncrementCounter(EventCounter::LabelIndexCreated);
-        } else {
-          MG_ASSERT(properties.size() == 1U);
+        } else if (properties.size() == 1U) {
           if (!interpreter_context->db->CreateIndex(label, properties[0])) {
             index_notification.code = NotificationCode::EXISTANT_INDEX;
             index_notification.title =
                 fmt::format("Index on label {} on properties {} already exists.", label_name, properties_stringified);
           }
           EventCounter::IncrementCounter(EventCounter::LabelPropertyIndexCreated);
+        } else {
+          if (!interpreter_context->db->CreateIndex(label, properties)) {
+            index_notification.code = NotificationCode::EXISTANT_INDEX;
+            index_notification.title =
+                fmt::format("Index on label {} on properties {} already exists.", label_name, properties_stringified);
+          }
+          EventCounter::IncrementCounter(EventCounter::LabelPropertiesIndexCreated);
         }
         invalidate_plan_cache();
       };
@@ -1336,13 +1368,142 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
             index_notification.title =
                 fmt::format("Index on label {} on properties {} doesn't exist.", label_name, properties_stringified);
           }
-        } else {
-          MG_ASSERT(properties.size() == 1U);
+        } else if (properties.size() == 1U) {
           if (!interpreter_context->db->DropIndex(label, properties[0])) {
             index_notification.code = NotificationCode::NONEXISTANT_INDEX;
             index_notification.title =
                 fmt::format("Index on label {} on properties {} doesn't exist.", label_name, properties_stringified);
           }
+        } else {
+          if (!interpreter_context->db->DropIndex(label, properties)) {
+            index_notification.code = NotificationCode::NONEXISTANT_INDEX;
+            index_notification.title =
+                fmt::format("Index on label {} on properties {} doesn't exist.", label_name, properties_stringified);
+          }
+        }
+        invalidate_plan_cache();
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareEdgeIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                    std::vector<Notification> *notifications, InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *index_query = utils::Downcast<EdgeIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  // Creating an index influences computed plan costs.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
+    EventCounter::IncrementCounter(EventCounter::PlanCacheInvalidation, plan_cache->size());
+    plan_cache->Clear();
+  };
+
+  auto edge_type = interpreter_context->db->NameToEdgeType(index_query->edge_type_.name);
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (index_query->action_) {
+    case EdgeIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created index on edge type {}.", index_query->edge_type_.name);
+
+      handler = [interpreter_context, edge_type, edge_type_name = index_query->edge_type_.name,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        if (!interpreter_context->db->CreateIndex(edge_type)) {
+          index_notification.code = NotificationCode::EXISTANT_INDEX;
+          index_notification.title = fmt::format("Index on edge type {} already exists.", edge_type_name);
+        }
+        EventCounter::IncrementCounter(EventCounter::EdgeTypeIndexCreated);
+        invalidate_plan_cache();
+      };
+      break;
+    }
+    case EdgeIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped index on edge type {}.", index_query->edge_type_.name);
+      handler = [interpreter_context, edge_type, edge_type_name = index_query->edge_type_.name,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        if (!interpreter_context->db->DropIndex(edge_type)) {
+          index_notification.code = NotificationCode::NONEXISTANT_INDEX;
+          index_notification.title = fmt::format("Index on edge type {} doesn't exist.", edge_type_name);
+        }
+        invalidate_plan_cache();
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareTextIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                    std::vector<Notification> *notifications, InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *index_query = utils::Downcast<TextIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  // Creating an index influences computed plan costs.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
+    EventCounter::IncrementCounter(EventCounter::PlanCacheInvalidation, plan_cache->size());
+    plan_cache->Clear();
+  };
+
+  auto label = interpreter_context->db->NameToLabel(index_query->label_.name);
+  auto property = interpreter_context->db->NameToProperty(index_query->property_.name);
+  auto index_name = fmt::format("{}({})", index_query->label_.name, index_query->property_.name);
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (index_query->action_) {
+    case TextIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created text index on {}.", index_name);
+
+      handler = [interpreter_context, label, property, index_name = std::move(index_name),
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        if (!interpreter_context->db->CreateTextIndex(label, property)) {
+          index_notification.code = NotificationCode::EXISTANT_INDEX;
+          index_notification.title = fmt::format("Text index on {} already exists.", index_name);
+        }
+        EventCounter::IncrementCounter(EventCounter::TextIndexCreated);
+        invalidate_plan_cache();
+      };
+      break;
+    }
+    case TextIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped text index on {}.", index_name);
+      handler = [interpreter_context, label, property, index_name = std::move(index_name),
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        if (!interpreter_context->db->DropTextIndex(label, property)) {
+          index_notification.code = NotificationCode::NONEXISTANT_INDEX;
+          index_notification.title = fmt::format("Text index on {} doesn't exist.", index_name);
         }
         invalidate_plan_cache();
       };
@@ -1695,6 +1856,8 @@ PreparedQuery PrepareCreateSnapshotQuery(ParsedQuery parsed_query, bool in_expli
             case storage::Storage::CreateSnapshotError::DisabledForReplica:
               throw utils::BasicException(
                   "Failed to create a snapshot. Replica instances are not allowed to create them.");
+            case storage::Storage::CreateSnapshotError::Failed:
+              throw utils::BasicException("Failed to create a snapshot. The previous snapshot is kept.");
           }
         }
         return QueryHandlerResult::COMMIT;
@@ -1780,7 +1943,8 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
         auto *db = interpreter_context->db;
         auto info = db->ListAllIndices();
         std::vector<std::vector<TypedValue>> results;
-        results.reserve(info.label.size() + info.label_property.size());
+        results.reserve(info.label.size() + info.label_property.size() + info.label_properties.size() +
+                        info.text.size() + info.edge_type.size());
         for (const auto &item : info.label) {
           results.push_back({TypedValue("label"), TypedValue(db->LabelToName(item)), TypedValue()});
         }
@@ -1788,6 +1952,22 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
           results.push_back({TypedValue("label+property"), TypedValue(db->LabelToName(item.first)),
                              TypedValue(db->PropertyToName(item.second))});
         }
+        for (const auto &item : info.label_properties) {
+          std::vector<TypedValue> properties;
+          properties.reserve(item.second.size());
+          for (const auto &property : item.second) {
+            properties.emplace_back(db->PropertyToName(property));
+          }
+          results.push_back({TypedValue("label+properties"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(std::move(properties))});
+        }
+        for (const auto &item : info.text) {
+          results.push_back({TypedValue("text"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(db->PropertyToName(item.second))});
+        }
+        for (const auto &item : info.edge_type) {
+          results.push_back({TypedValue("edge-type"), TypedValue(db->EdgeTypeToName(item)), TypedValue()});
+        }
         return std::pair{results, QueryHandlerResult::NOTHING};
       };
       break;
@@ -2018,8 +2198,8 @@ PreparedQuery PrepareConstraintQuery(ParsedQuery parsed_query, bool in_explicit_
                        RWType::NONE};
 }
 
-void Interpreter::BeginTransaction() {
-  const auto prepared_query = PrepareTransactionQuery("BEGIN");
+void Interpreter::BeginTransaction(const bool read_only) {
+  const auto prepared_query = PrepareTransactionQuery("BEGIN", read_only);
   prepared_query.query_handler(nullptr, {});
 }
 
@@ -2035,6 +2215,24 @@ void Interpreter::RollbackTransaction() {
   query_executions_.clear();
 }
 
+/// Returns the memory limit of the query that is subject to the admission
+/// control, or `std::nullopt` if the query isn't a Cypher query.
+std::optional<std::optional<uint64_t>> GetAdmittedMemoryLimit(const ParsedQuery &parsed_query) {
+  auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
+  if (auto *profile_query = utils::Downcast<ProfileQuery>(parsed_query.query)) {
+    cypher_query = profile_query->cypher_query_;
+  }
+  if (!cypher_query) return std::nullopt;
+  // The memory limit is a literal or a parameter, so it is evaluated without
+  // the transaction which isn't started yet.
+  Frame frame(0);
+  SymbolTable symbol_table;
+  EvaluationContext evaluation_context;
+  evaluation_context.parameters = parsed_query.parameters;
+  ExpressionEvaluator evaluator(&frame, symbol_table, evaluation_context, nullptr, storage::View::OLD);
+  return EvaluateMemoryLimit(&evaluator, cypher_query->memory_limit_, cypher_query->memory_scale_);
+}
+
 Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
                                                 const std::map<std::string, storage::PropertyValue> &params,
                                                 const std::string *username) {
@@ -2053,7 +2251,8 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
   const auto trimmed_query = utils::Trim(upper_case_query);
 
   if (trimmed_query == "BEGIN" || trimmed_query == "COMMIT" || trimmed_query == "ROLLBACK") {
-    query_execution->prepared_query.emplace(PrepareTransactionQuery(trimmed_query));
+    query_execution->prepared_query.emplace(
+        PrepareTransactionQuery(trimmed_query, false, std::string{username ? *username : ""}));
     return {query_execution->prepared_query->header, query_execution->prepared_query->privileges, qid};
   }
 
@@ -2076,15 +2275,34 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     utils::Timer parsing_timer;
     ParsedQuery parsed_query = ParseQuery(query_string, params, &interpreter_context_->ast_cache,
                                           &interpreter_context_->antlr_lock, interpreter_context_->config.query);
-    query_execution->summary["parsing_time"] = parsing_timer.Elapsed().count();
+    const auto parsing_time = parsing_timer.Elapsed();
+    query_execution->summary["parsing_time"] = parsing_time.count();
+    EventHistogram::Measure(EventHistogram::QueryParseLatency,
+                            std::chrono::duration_cast<std::chrono::microseconds>(parsing_time).count());
+
+    // Only the Cypher queries are subject to the admission control, so the
+    // administrative queries can't be held back by the quotas. The query is
+    // admitted before its transaction starts, so a queued query doesn't hold
+    // an old snapshot. The queries in an explicit transaction run under the
+    // admission of the transaction.
+    const auto memory_limit = in_explicit_transaction_ ? std::nullopt : GetAdmittedMemoryLimit(parsed_query);
+    if (memory_limit) {
+      query_execution->admission =
+          interpreter_context_->admission_controller.Admit(username ? *username : "", *memory_limit);
+    }
 
     // Some queries require an active transaction in order to be prepared.
     if (!in_explicit_transaction_ &&
         (utils::Downcast<CypherQuery>(parsed_query.query) || utils::Downcast<ExplainQuery>(parsed_query.query) ||
          utils::Downcast<ProfileQuery>(parsed_query.query) || utils::Downcast<DumpQuery>(parsed_query.query) ||
          utils::Downcast<TriggerQuery>(parsed_query.query))) {
-      db_accessor_ =
-          std::make_unique<storage::Storage::Accessor>(interpreter_context_->db->Access(GetIsolationLevelOverride()));
+      // Cypher queries start as read-only transactions, which are cheaper to
+      // begin and finish. The transaction is upgraded after planning if the
+      // query turns out to modify the database.
+      db_accessor_ = std::make_unique<storage::Storage::Accessor>(
+          utils::Downcast<CypherQuery>(parsed_query.query)
+              ? interpreter_context_->db->ReadOnlyAccess(GetIsolationLevelOverride())
+              : interpreter_context_->db->Access(GetIsolationLevelOverride()));
       execution_db_accessor_.emplace(db_accessor_.get());
 
       if (utils::Downcast<CypherQuery>(parsed_query.query) && interpreter_context_->trigger_store.HasTriggers()) {
@@ -2096,9 +2314,9 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     PreparedQuery prepared_query;
 
     if (utils::Downcast<CypherQuery>(parsed_query.query)) {
-      prepared_query = PrepareCypherQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
-                                          &*execution_db_accessor_, &query_execution->execution_memory,
-                                          &query_execution->notifications,
+      prepared_query = PrepareCypherQuery(std::move(parsed_query), in_explicit_transaction_, &query_execution->summary,
+                                          interpreter_context_, &*execution_db_accessor_,
+                                          &query_execution->execution_memory, &query_execution->notifications,
                                           trigger_context_collector_ ? &*trigger_context_collector_ : nullptr);
     } else if (utils::Downcast<ExplainQuery>(parsed_query.query)) {
       prepared_query = PrepareExplainQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
@@ -2113,6 +2331,12 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     } else if (utils::Downcast<IndexQuery>(parsed_query.query)) {
       prepared_query = PrepareIndexQuery(std::move(parsed_query), in_explicit_transaction_,
                                          &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<EdgeIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareEdgeIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                             &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<TextIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareTextIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                             &query_execution->notifications, interpreter_context_);
     } else if (utils::Downcast<AuthQuery>(parsed_query.query)) {
       prepared_query = PrepareAuthQuery(std::move(parsed_query), in_explicit_transaction_, &query_execution->summary,
                                         interpreter_context_, &*execution_db_accessor_,
@@ -2155,7 +2379,10 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
       LOG_FATAL("Should not get here -- unknown query type!");
     }
 
-    query_execution->summary["planning_time"] = planning_timer.Elapsed().count();
+    const auto planning_time = planning_timer.Elapsed();
+    query_execution->summary["planning_time"] = planning_time.count();
+    EventHistogram::Measure(EventHistogram::QueryPlanLatency,
+                            std::chrono::duration_cast<std::chrono::microseconds>(planning_time).count());
     query_execution->prepared_query.emplace(std::move(prepared_query));
 
     const auto rw_type = query_execution->prepared_query->rw_type;
@@ -2170,6 +2397,15 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
       throw QueryException("Write query forbidden on the replica!");
     }
 
+    if (db_accessor_ && db_accessor_->IsReadOnly() && (rw_type == RWType::W || rw_type == RWType::RW)) {
+      if (in_explicit_transaction_) {
+        throw WriteQueryInReadOnlyTxException();
+      }
+      // Nothing was read through the accessor yet, so the snapshot can still
+      // be replaced.
+      db_accessor_->UpgradeToReadWrite();
+    }
+
     return {query_execution->prepared_query->header, query_execution->prepared_query->privileges, qid};
   } catch (const utils::BasicException &) {
     EventCounter::IncrementCounter(EventCounter::FailedQuery);
@@ -2181,6 +2417,7 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
 void Interpreter::Abort() {
   expect_rollback_ = false;
   in_explicit_transaction_ = false;
+  transaction_admission_ = {};
   if (!db_accessor_) return;
   db_accessor_->Abort();
   execution_db_accessor_.reset();
@@ -13,6 +13,7 @@
 
 #include <gflags/gflags.h>
 
+#include "query/admission_control.hpp"
 #include "query/auth_checker.hpp"
 #include "query/config.hpp"
 #include "query/context.hpp"
@@ -32,6 +33,7 @@
 #include "query/typed_value.hpp"
 #include "storage/v2/isolation_level.hpp"
 #include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory.hpp"
 #include "utils/settings.hpp"
@@ -45,6 +47,10 @@ namespace EventCounter {
 extern const Event FailedQuery;
 }  // namespace EventCounter
 
+namespace EventHistogram {
+extern const Event QueryPullLatency;
+}  // namespace EventHistogram
+
 namespace memgraph::query {
 
 inline constexpr size_t kExecutionMemoryBlockSize = 1UL * 1024UL * 1024UL;
@@ -183,14 +189,16 @@ struct InterpreterContext {
   AuthQueryHandler *auth{nullptr};
   AuthChecker *auth_checker{nullptr};
 
-  utils::SkipList<QueryCacheEntry> ast_cache;
-  utils::SkipList<PlanCacheEntry> plan_cache;
+  AstCache ast_cache;
+  PlanCache plan_cache;
 
   TriggerStore trigger_store;
   utils::ThreadPool after_commit_trigger_pool{1};
 
   const InterpreterConfig config;
 
+  AdmissionController admission_controller{config.admission_control};
+
   query::stream::Streams streams;
 };
 
@@ -266,7 +274,11 @@ class Interpreter final {
   std::map<std::string, TypedValue> Pull(TStream *result_stream, std::optional<int> n = {},
                                          std::optional<int> qid = {});
 
-  void BeginTransaction();
+  /**
+   * Begin an explicit transaction. If `read_only` is set, the transaction
+   * can't run queries that modify the database.
+   */
+  void BeginTransaction(bool read_only = false);
 
   void CommitTransaction();
 
@@ -289,6 +301,10 @@ class Interpreter final {
     std::map<std::string, TypedValue> summary;
     std::vector<Notification> notifications;
 
+    // Releases the resources reserved by the admission control when the
+    // query is finished.
+    AdmissionController::Ticket admission;
+
     explicit QueryExecution() = default;
     QueryExecution(const QueryExecution &) = delete;
     QueryExecution(QueryExecution &&) = default;
@@ -327,11 +343,16 @@ class Interpreter final {
   std::optional<TriggerContextCollector> trigger_context_collector_;
   bool in_explicit_transaction_{false};
   bool expect_rollback_{false};
+  // Admission of the explicit transaction, held from BEGIN until the
+  // transaction finishes.
+  AdmissionController::Ticket transaction_admission_;
 
   std::optional<storage::IsolationLevel> interpreter_isolation_level;
   std::optional<storage::IsolationLevel> next_transaction_isolation_level;
 
-  PreparedQuery PrepareTransactionQuery(std::string_view query_upper);
+  /// BEGIN admits the transaction for `admitted_user` if it is set.
+  PreparedQuery PrepareTransactionQuery(std::string_view query_upper, bool read_only = false,
+                                        std::optional<std::string> admitted_user = std::nullopt);
   void Commit();
   void AdvanceCommand();
   void AbortCommand(std::unique_ptr<QueryExecution> *query_execution);
@@ -369,7 +390,12 @@ std::map<std::string, TypedValue> Interpreter::Pull(TStream *result_stream, std:
     // Wrap the (statically polymorphic) stream type into a common type which
     // the handler knows.
     AnyStream stream{result_stream, &query_execution->execution_memory};
-    const auto maybe_res = query_execution->prepared_query->query_handler(&stream, n);
+    const auto maybe_res = [&] {
+      EventHistogram::ScopedMeasure measure{EventHistogram::QueryPullLatency};
+      auto &admission = in_explicit_transaction_ ? transaction_admission_ : query_execution->admission;
+      auto cpu_time_measure = admission.MeasureCpuTime();
+      return query_execution->prepared_query->query_handler(&stream, n);
+    }();
     // Stream is using execution memory of the query_execution which
     // can be deleted after its execution so the stream should be cleared
     // first.
@@ -56,6 +56,9 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     static constexpr double MakeScanAllByLabelPropertyValue{1.1};
     static constexpr double MakeScanAllByLabelPropertyRange{1.1};
     static constexpr double MakeScanAllByLabelProperty{1.1};
+    static constexpr double kScanAllByLabelProperties{1.1};
+    static constexpr double kScanAllByText{1.1};
+    static constexpr double kScanAllByEdgeType{1.1};
     static constexpr double kExpand{2.0};
     static constexpr double kExpandVariable{3.0};
     static constexpr double kFilter{1.5};
@@ -148,6 +151,54 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PostVisit(ScanAllByLabelProperties &logical_op) override {
+    // If all of the prefix values are constants, the index can tell exactly
+    // how many vertices match. Otherwise, estimate the influence as
+    // ScanAll(label, properties) * filtering.
+    std::vector<storage::PropertyValue> prefix;
+    prefix.reserve(logical_op.expressions_.size());
+    for (const auto *expression : logical_op.expressions_) {
+      auto property_value = ConstPropertyValue(expression);
+      if (!property_value) break;
+      prefix.emplace_back(std::move(*property_value));
+    }
+    double factor = 1.0;
+    if (prefix.size() == logical_op.expressions_.size()) {
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_, prefix);
+    } else {
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_) * CardParam::kFilter;
+    }
+
+    cardinality_ *= factor;
+
+    IncrementCost(CostParam::kScanAllByLabelProperties);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByText &logical_op) override {
+    // A constant needle lets the text index estimate the number of candidates
+    // from its rarest trigram. Otherwise, estimate the influence as
+    // ScanAll(label, property) * filtering.
+    double factor = 1.0;
+    auto property_value = ConstPropertyValue(logical_op.expression_);
+    if (property_value && property_value->IsString()) {
+      factor = db_accessor_->TextVerticesCount(logical_op.label_, logical_op.property_, property_value->ValueString());
+    } else {
+      factor = db_accessor_->TextVerticesCount(logical_op.label_, logical_op.property_) * CardParam::kFilter;
+    }
+
+    cardinality_ *= factor;
+
+    IncrementCost(CostParam::kScanAllByText);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeType &logical_op) override {
+    cardinality_ *= db_accessor_->EdgesCount(logical_op.edge_type_);
+    IncrementCost(CostParam::kScanAllByEdgeType);
+    return true;
+  }
+
   // TODO: Cost estimate ScanAllById?
 
 // For the given op first increments the cardinality and then cost.
@@ -12,11 +12,19 @@
 #include "query/plan/operator.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -52,6 +60,7 @@
 #include "utils/readable_size.hpp"
 #include "utils/string.hpp"
 #include "utils/temporal.hpp"
+#include "utils/thread_pool.hpp"
 
 // macro for the default implementation of LogicalOperator::Accept
 // that accepts the visitor and visits it's input_ operator
@@ -81,7 +90,10 @@ extern const Event ScanAllByLabelOperator;
 extern const Event ScanAllByLabelPropertyRangeOperator;
 extern const Event ScanAllByLabelPropertyValueOperator;
 extern const Event ScanAllByLabelPropertyOperator;
+extern const Event ScanAllByLabelPropertiesOperator;
+extern const Event ScanAllByTextOperator;
 extern const Event ScanAllByIdOperator;
+extern const Event ScanAllByEdgeTypeOperator;
 extern const Event ExpandOperator;
 extern const Event ExpandVariableOperator;
 extern const Event ConstructNamedPathOperator;
@@ -182,6 +194,8 @@ VertexAccessor &CreateLocalVertex(const NodeCreationInfo &node_info, Frame *fram
     auto maybe_error = new_node.AddLabel(label);
     if (maybe_error.HasError()) {
       switch (maybe_error.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::SERIALIZATION_ERROR:
           throw TransactionSerializationException();
         case storage::Error::DELETED_OBJECT:
@@ -299,6 +313,8 @@ EdgeAccessor CreateEdge(const EdgeCreationInfo &edge_info, DbAccessor *dba, Vert
     (*frame)[edge_info.symbol] = edge;
   } else {
     switch (maybe_edge.GetError()) {
+      case storage::Error::READ_ONLY_TRANSACTION:
+        throw WriteQueryInReadOnlyTxException();
       case storage::Error::SERIALIZATION_ERROR:
         throw TransactionSerializationException();
       case storage::Error::DELETED_OBJECT:
@@ -469,18 +485,37 @@ UniqueCursorPtr ScanAllByLabel::MakeCursor(utils::MemoryResource *mem) const {
 // TODO(buda): Implement ScanAllByLabelProperty operator to iterate over
 // vertices that have the label and some value for the given property.
 
+namespace {
+
+// Returns the smallest string that is greater than all of the strings that
+// start with `prefix`, which is the prefix without its trailing 0xFF bytes and
+// with the last remaining byte incremented. There is no such string if the
+// prefix is empty or made only of 0xFF bytes.
+std::optional<std::string> PrefixUpperBound(std::string prefix) {
+  while (!prefix.empty() && static_cast<unsigned char>(prefix.back()) == 0xFF) prefix.pop_back();
+  if (prefix.empty()) return std::nullopt;
+  prefix.back() = static_cast<char>(static_cast<unsigned char>(prefix.back()) + 1);
+  return prefix;
+}
+
+}  // namespace
+
 ScanAllByLabelPropertyRange::ScanAllByLabelPropertyRange(const std::shared_ptr<LogicalOperator> &input,
                                                          Symbol output_symbol, storage::LabelId label,
                                                          storage::PropertyId property, const std::string &property_name,
                                                          std::optional<Bound> lower_bound,
-                                                         std::optional<Bound> upper_bound, storage::View view)
+                                                         std::optional<Bound> upper_bound, storage::View view,
+                                                         bool prefix_scan)
     : ScanAll(input, output_symbol, view),
       label_(label),
       property_(property),
       property_name_(property_name),
       lower_bound_(lower_bound),
-      upper_bound_(upper_bound) {
+      upper_bound_(upper_bound),
+      prefix_scan_(prefix_scan) {
   MG_ASSERT(lower_bound_ || upper_bound_, "Only one bound can be left out");
+  MG_ASSERT(!prefix_scan_ || (lower_bound_ && lower_bound_->IsInclusive() && !upper_bound_),
+            "Prefix scan needs only an inclusive lower bound");
 }
 
 ACCEPT_WITH_INPUT(ScanAllByLabelPropertyRange)
@@ -519,6 +554,19 @@ UniqueCursorPtr ScanAllByLabelPropertyRange::MakeCursor(utils::MemoryResource *m
         throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
       }
     };
+    if (prefix_scan_) {
+      // STARTS WITH is null for a null prefix and fails for anything that
+      // isn't a string, so the scan does the same.
+      const auto &prefix = lower_bound_->value()->Accept(evaluator);
+      if (prefix.IsNull()) return std::nullopt;
+      if (!prefix.IsString()) throw QueryRuntimeException("Invalid type {} for 'STARTS WITH'.", prefix.type());
+      std::string lower(prefix.ValueString());
+      auto upper = PrefixUpperBound(lower);
+      return std::make_optional(db->Vertices(
+          view_, label_, property_, utils::MakeBoundInclusive(storage::PropertyValue(std::move(lower))),
+          upper ? std::make_optional(utils::MakeBoundExclusive(storage::PropertyValue(std::move(*upper))))
+                : std::nullopt));
+    }
     auto maybe_lower = convert(lower_bound_);
     auto maybe_upper = convert(upper_bound_);
     // If any bound is null, then the comparison would result in nulls. This
@@ -581,6 +629,78 @@ UniqueCursorPtr ScanAllByLabelProperty::MakeCursor(utils::MemoryResource *mem) c
                                                                 std::move(vertices), "ScanAllByLabelProperty");
 }
 
+ScanAllByLabelProperties::ScanAllByLabelProperties(const std::shared_ptr<LogicalOperator> &input,
+                                                   Symbol output_symbol, storage::LabelId label,
+                                                   std::vector<storage::PropertyId> properties,
+                                                   std::vector<std::string> property_names,
+                                                   std::vector<Expression *> expressions, storage::View view)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      properties_(std::move(properties)),
+      property_names_(std::move(property_names)),
+      expressions_(std::move(expressions)) {
+  DMG_ASSERT(expressions_.size() <= properties_.size(), "There are more expressions than properties.");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByLabelProperties)
+
+UniqueCursorPtr ScanAllByLabelProperties::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByLabelPropertiesOperator);
+
+  using Prefix = std::vector<storage::PropertyValue>;
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, properties_, Prefix()))> {
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    Prefix prefix;
+    prefix.reserve(expressions_.size());
+    for (auto *expression : expressions_) {
+      auto value = expression->Accept(evaluator);
+      // Comparing with null never succeeds, so no vertex can match.
+      if (value.IsNull()) return std::nullopt;
+      if (!value.IsPropertyValue()) {
+        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+      }
+      prefix.emplace_back(value);
+    }
+    return std::make_optional(db->Vertices(view_, label_, properties_, std::move(prefix)));
+  };
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+                                                                std::move(vertices), "ScanAllByLabelProperties");
+}
+
+ScanAllByText::ScanAllByText(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol,
+                             storage::LabelId label, storage::PropertyId property, const std::string &property_name,
+                             Expression *expression, storage::View view)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      property_(property),
+      property_name_(property_name),
+      expression_(expression) {
+  DMG_ASSERT(expression, "Expression is not optional.");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByText)
+
+UniqueCursorPtr ScanAllByText::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByTextOperator);
+
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->TextVertices(view_, label_, property_, std::string_view()))> {
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    auto value = expression_->Accept(evaluator);
+    // String matching with null is null, so no vertex can match.
+    if (value.IsNull()) return std::nullopt;
+    if (!value.IsString()) {
+      throw QueryRuntimeException("'{}' cannot be used for string matching.", value.type());
+    }
+    return std::make_optional(db->TextVertices(view_, label_, property_, value.ValueString()));
+  };
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+                                                                std::move(vertices), "ScanAllByText");
+}
+
 ScanAllById::ScanAllById(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, Expression *expression,
                          storage::View view)
     : ScanAll(input, output_symbol, view), expression_(expression) {
@@ -607,6 +727,73 @@ UniqueCursorPtr ScanAllById::MakeCursor(utils::MemoryResource *mem) const {
                                                                 std::move(vertices), "ScanAllById");
 }
 
+ScanAllByEdgeType::ScanAllByEdgeType(const std::shared_ptr<LogicalOperator> &input, Symbol from_symbol,
+                                     Symbol edge_symbol, Symbol to_symbol, storage::EdgeTypeId edge_type,
+                                     storage::View view)
+    : input_(input ? input : std::make_shared<Once>()),
+      from_symbol_(from_symbol),
+      edge_symbol_(edge_symbol),
+      to_symbol_(to_symbol),
+      edge_type_(edge_type),
+      view_(view) {}
+
+ACCEPT_WITH_INPUT(ScanAllByEdgeType)
+
+std::vector<Symbol> ScanAllByEdgeType::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.emplace_back(from_symbol_);
+  symbols.emplace_back(edge_symbol_);
+  symbols.emplace_back(to_symbol_);
+  return symbols;
+}
+
+class ScanAllByEdgeTypeCursor : public Cursor {
+ public:
+  ScanAllByEdgeTypeCursor(const ScanAllByEdgeType &self, utils::MemoryResource *mem)
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("ScanAllByEdgeType");
+
+    if (MustAbort(context)) throw HintedAbortError();
+
+    while (!edges_ || edges_it_.value() == edges_.value().end()) {
+      if (!input_cursor_->Pull(frame, context)) return false;
+      // Since the edges iterator isn't nothrow_move_assignable, we have to use
+      // the roundabout assignment + emplace.
+      edges_.emplace(context.db_accessor->Edges(self_.view_, self_.edge_type_));
+      edges_it_.emplace(edges_.value().begin());
+    }
+
+    auto edge = *edges_it_.value();
+    frame[self_.from_symbol_] = edge.From();
+    frame[self_.to_symbol_] = edge.To();
+    frame[self_.edge_symbol_] = std::move(edge);
+    ++edges_it_.value();
+    return true;
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    edges_it_ = std::nullopt;
+    edges_ = std::nullopt;
+  }
+
+ private:
+  const ScanAllByEdgeType &self_;
+  const UniqueCursorPtr input_cursor_;
+  std::optional<DbAccessor::EdgesIterable> edges_;
+  std::optional<DbAccessor::EdgesIterable::Iterator> edges_it_;
+};
+
+UniqueCursorPtr ScanAllByEdgeType::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByEdgeTypeOperator);
+
+  return MakeUniqueCursorPtr<ScanAllByEdgeTypeCursor>(mem, *this, mem);
+}
+
 namespace {
 bool CheckExistingNode(const VertexAccessor &new_node, const Symbol &existing_node_sym, Frame &frame) {
   const TypedValue &existing_node = frame[existing_node_sym];
@@ -625,6 +812,7 @@ auto UnwrapEdgesResult(storage::Result<TEdges> &&result) {
         throw query::QueryRuntimeException("Trying to get relationships from a node that doesn't exist.");
       case storage::Error::VERTEX_HAS_EDGES:
       case storage::Error::SERIALIZATION_ERROR:
+      case storage::Error::READ_ONLY_TRANSACTION:
       case storage::Error::PROPERTIES_DISABLED:
         throw QueryRuntimeException("Unexpected error when accessing relationships.");
     }
@@ -1055,10 +1243,300 @@ class ExpandVariableCursor : public Cursor {
   }
 };
 
+namespace {
+
+// Frontiers with at least this many vertices have their edges fetched by
+// several worker threads. Smaller frontiers are expanded on the pulling
+// thread.
+constexpr size_t kParallelFrontierSize = 4096;
+// Number of consecutive frontier vertices a worker expands at once.
+constexpr size_t kFrontierChunkSize = 512;
+
+/// Threads that help expanding large frontiers. The pool is shared by all
+/// queries, so the number of threads doesn't grow with the number of running
+/// searches. The pulling thread always expands chunks too, so the pool has one
+/// thread less than there are cores.
+utils::ThreadPool &FrontierExpansionPool() {
+  static utils::ThreadPool pool(std::max(2U, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+/// Set of vertices visited by a breadth-first search. The set is a bitmap
+/// split into small pages indexed by the vertex gid. Only the pages that
+/// contain a visited vertex are allocated, so the memory is proportional to
+/// the part of the graph the search touched rather than to the largest gid,
+/// while vertices with nearby gids still share a page. Pages are reused after
+/// the set is cleared.
+class VisitedVertices {
+ public:
+  explicit VisitedVertices(utils::MemoryResource *memory) : page_index_(memory), pages_(memory) {}
+
+  bool Contains(const VertexAccessor &vertex) const {
+    const auto gid = vertex.Gid().AsUint();
+    auto it = page_index_.find(gid / kPageBits);
+    if (it == page_index_.end()) return false;
+    return (pages_[it->second][gid % kPageBits / 64] & (uint64_t{1} << (gid % 64))) != 0;
+  }
+
+  /// Returns `false` if the vertex was already in the set.
+  bool Insert(const VertexAccessor &vertex) {
+    const auto gid = vertex.Gid().AsUint();
+    auto [it, inserted] = page_index_.try_emplace(gid / kPageBits, used_pages_);
+    if (inserted) {
+      if (used_pages_ == pages_.size()) {
+        pages_.emplace_back();
+      }
+      pages_[used_pages_].fill(0);
+      ++used_pages_;
+    }
+    auto &word = pages_[it->second][gid % kPageBits / 64];
+    const auto bit = uint64_t{1} << (gid % 64);
+    if (word & bit) return false;
+    word |= bit;
+    return true;
+  }
+
+  void Clear() {
+    page_index_.clear();
+    used_pages_ = 0;
+  }
+
+ private:
+  // A page covers one cache line.
+  static constexpr uint64_t kPageBits = 512;
+  using Page = std::array<uint64_t, kPageBits / 64>;
+
+  // Maps the page number (gid / kPageBits) to the position in `pages_`.
+  utils::pmr::unordered_map<uint64_t, size_t> page_index_;
+  utils::pmr::vector<Page> pages_;
+  size_t used_pages_{0};
+};
+
+EdgeAtom::Direction ReverseDirection(EdgeAtom::Direction direction) {
+  if (direction == EdgeAtom::Direction::BOTH) return direction;
+  return direction == EdgeAtom::Direction::IN ? EdgeAtom::Direction::OUT : EdgeAtom::Direction::IN;
+}
+
+const VertexAccessor &FrontierVertex(const VertexAccessor &vertex) { return vertex; }
+const VertexAccessor &FrontierVertex(const std::pair<EdgeAccessor, VertexAccessor> &expansion) {
+  return expansion.second;
+}
+
+/// Calls `expand(edge, next)` for each edge of `vertex` in the given direction
+/// which leads to a vertex that isn't in `visited`. Stops as soon as `expand`
+/// returns `false` and returns whether the vertex was fully expanded.
+template <class TFunc>
+bool ExpandVertex(const VertexAccessor &vertex, EdgeAtom::Direction direction,
+                  const std::vector<storage::EdgeTypeId> &edge_types, const VisitedVertices &visited,
+                  const TFunc &expand) {
+  if (direction != EdgeAtom::Direction::IN) {
+    auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, edge_types));
+    for (const auto &edge : out_edges) {
+      auto next = edge.To();
+      if (!visited.Contains(next) && !expand(edge, next)) return false;
+    }
+  }
+  if (direction != EdgeAtom::Direction::OUT) {
+    auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, edge_types));
+    for (const auto &edge : in_edges) {
+      auto next = edge.From();
+      if (!visited.Contains(next) && !expand(edge, next)) return false;
+    }
+  }
+  return true;
+}
+
+/// Finds the calls of the functions that may keep state between calls, i.e.
+/// `counter` and the user-defined functions. The result of an expression that
+/// calls them depends on the order in which it is evaluated.
+class StatefulFunctionFinder : public HierarchicalTreeVisitor {
+ public:
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  bool PostVisit(Function &function) override {
+    // The names of user-defined functions always contain a dot.
+    if (function.function_name_ == "COUNTER" || function.function_name_.find('.') != std::string::npos) found_ = true;
+    return true;
+  }
+
+  bool Visit(Identifier &) override { return true; }
+  bool Visit(PrimitiveLiteral &) override { return true; }
+  bool Visit(ParameterLookup &) override { return true; }
+
+  bool found_{false};
+};
+
+bool UsesStatefulFunctions(Expression *expression) {
+  if (!expression) return false;
+  StatefulFunctionFinder finder;
+  expression->Accept(finder);
+  return finder.found_;
+}
+
+/// Expands all of the vertices in `frontier` and calls
+/// `on_expansion(vertex, edge, next)` in frontier order for each edge that
+/// leads to a vertex which isn't in `visited` and passes
+/// `should_expand(vertex, edge, next, frame, evaluator)`. The expansion stops
+/// as soon as `on_expansion` returns `false`. A vertex can be passed to
+/// `on_expansion` more than once, so it has to check `visited` again.
+///
+/// Fetching the edges dominates the cost of a breadth-first search, so the
+/// edges of large frontiers are fetched by the calling thread together with
+/// the threads of `FrontierExpansionPool`, each handling chunks of consecutive
+/// frontier vertices. The workers check `visited` and `should_expand` as they
+/// go and keep only the first expansion to each vertex in a chunk, so a level
+/// keeps about as many expansions as there are new vertices instead of one
+/// per edge. `should_expand` gets a copy of `frame` and an evaluator of its
+/// own on the workers, so it must not depend on changes it makes to the frame
+/// outside of a single call. If `stateful_filter` is set, e.g. because the
+/// filter calls `counter`, the whole frontier is expanded on the calling thread
+/// so the filter is evaluated in frontier order with the shared state. The
+/// memory of the workers comes from the query's memory resource, so it counts
+/// towards the memory limit of the query. The workers check whether the query
+/// was aborted before each chunk. `on_expansion` is always called on the
+/// calling thread, after all of the workers are done, so it may use the frame
+/// and the evaluator, modify `visited` and the result doesn't depend on the
+/// number of workers.
+///
+/// @throw HintedAbortError if the query was aborted during the expansion.
+template <class TFrontier, class TFilter, class TFunc>
+void ExpandFrontier(const TFrontier &frontier, EdgeAtom::Direction direction,
+                    const std::vector<storage::EdgeTypeId> &edge_types, const VisitedVertices &visited, Frame *frame,
+                    ExpressionEvaluator *evaluator, const ExecutionContext &context, const bool stateful_filter,
+                    const TFilter &should_expand, const TFunc &on_expansion) {
+  if (frontier.size() < kParallelFrontierSize || stateful_filter) {
+    for (const auto &element : frontier) {
+      const auto &vertex = FrontierVertex(element);
+      auto expand = [&](const EdgeAccessor &edge, const VertexAccessor &next) {
+        if (!should_expand(vertex, edge, next, frame, evaluator)) return true;
+        return on_expansion(vertex, edge, next);
+      };
+      if (!ExpandVertex(vertex, direction, edge_types, visited, expand)) return;
+    }
+    return;
+  }
+
+  struct Expansion {
+    size_t index;
+    EdgeAccessor edge;
+    VertexAccessor next;
+  };
+  // The query's memory resource isn't thread-safe, so the workers allocate
+  // through a synchronized pool on top of it.
+  utils::SynchronizedPoolResource expansion_memory(128, 1024, context.evaluation_context.memory);
+  const size_t num_chunks = (frontier.size() + kFrontierChunkSize - 1) / kFrontierChunkSize;
+  utils::pmr::vector<utils::pmr::vector<Expansion>> chunks(num_chunks, &expansion_memory);
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> aborted{false};
+  std::mutex exception_lock;
+  std::exception_ptr exception;
+
+  auto work = [&] {
+    try {
+      // The filter is evaluated on a copy of the frame with memory that is
+      // reused for every evaluation.
+      Frame worker_frame(static_cast<int64_t>(frame->elems().size()), &expansion_memory);
+      for (size_t i = 0; i < frame->elems().size(); ++i) {
+        worker_frame.elems()[i] = frame->elems()[i];
+      }
+      static constexpr size_t kEvaluationMemorySize = 4096;
+      std::array<uint8_t, kEvaluationMemorySize> evaluation_buffer;
+      utils::MonotonicBufferResource evaluation_memory(evaluation_buffer.data(), evaluation_buffer.size(),
+                                                       &expansion_memory);
+      EvaluationContext evaluation_context = context.evaluation_context;
+      evaluation_context.memory = &evaluation_memory;
+      ExpressionEvaluator worker_evaluator(&worker_frame, context.symbol_table, evaluation_context,
+                                           context.db_accessor, storage::View::OLD);
+      // Vertices that the current chunk already expanded to.
+      VisitedVertices kept(&expansion_memory);
+
+      for (auto chunk = next_chunk.fetch_add(1); chunk < num_chunks; chunk = next_chunk.fetch_add(1)) {
+        if (MustAbort(context)) {
+          aborted.store(true);
+          next_chunk.store(num_chunks);
+          return;
+        }
+        kept.Clear();
+        auto &expansions = chunks[chunk];
+        const auto end = std::min(frontier.size(), (chunk + 1) * kFrontierChunkSize);
+        for (auto i = chunk * kFrontierChunkSize; i < end; ++i) {
+          const auto &vertex = FrontierVertex(frontier[i]);
+          ExpandVertex(vertex, direction, edge_types, visited, [&](const EdgeAccessor &edge, const VertexAccessor &next) {
+            if (kept.Contains(next)) return true;
+            const bool expand = should_expand(vertex, edge, next, &worker_frame, &worker_evaluator);
+            evaluation_memory.Release();
+            if (expand) {
+              kept.Insert(next);
+              expansions.push_back(Expansion{i, edge, next});
+            }
+            return true;
+          });
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(exception_lock);
+      if (!exception) exception = std::current_exception();
+      next_chunk.store(num_chunks);
+    }
+  };
+
+  {
+    // The pool can be busy with other searches, so the calling thread expands
+    // the chunks too and doesn't wait for the helpers that didn't start by
+    // the time all chunks were taken.
+    struct Helpers {
+      std::mutex lock;
+      std::condition_variable cv;
+      size_t running{0};
+      bool finished{false};
+    };
+    auto helpers = std::make_shared<Helpers>();
+    auto &pool = FrontierExpansionPool();
+    const size_t num_helpers = std::min(num_chunks - 1, std::max(1U, std::thread::hardware_concurrency()) - 1);
+    for (size_t i = 0; i < num_helpers; ++i) {
+      pool.AddTask([helpers, &work] {
+        {
+          std::lock_guard<std::mutex> guard(helpers->lock);
+          if (helpers->finished) return;
+          ++helpers->running;
+        }
+        work();
+        {
+          std::lock_guard<std::mutex> guard(helpers->lock);
+          --helpers->running;
+        }
+        helpers->cv.notify_all();
+      });
+    }
+    work();
+    std::unique_lock<std::mutex> guard(helpers->lock);
+    helpers->finished = true;
+    helpers->cv.wait(guard, [&] { return helpers->running == 0; });
+  }
+  if (exception) std::rethrow_exception(exception);
+  if (aborted) throw HintedAbortError();
+
+  for (auto &expansions : chunks) {
+    for (const auto &expansion : expansions) {
+      if (!on_expansion(FrontierVertex(frontier[expansion.index]), expansion.edge, expansion.next)) return;
+    }
+    // The expansions that were handed over aren't needed anymore.
+    utils::pmr::vector<Expansion>(&expansion_memory).swap(expansions);
+  }
+}
+
+}  // namespace
+
 class STShortestPathCursor : public query::plan::Cursor {
  public:
   STShortestPathCursor(const ExpandVariable &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input()->MakeCursor(mem)) {
+      : self_(self),
+        input_cursor_(self_.input()->MakeCursor(mem)),
+        source_visited_(mem),
+        sink_visited_(mem),
+        stateful_filter_(UsesStatefulFunctions(self_.filter_lambda_.expression)) {
     MG_ASSERT(self_.common_.existing_node,
               "s-t shortest path algorithm should only "
               "be used when `existing_node` flag is "
@@ -1098,31 +1576,43 @@ class STShortestPathCursor : public query::plan::Cursor {
 
   void Shutdown() override { input_cursor_->Shutdown(); }
 
-  void Reset() override { input_cursor_->Reset(); }
+  void Reset() override {
+    input_cursor_->Reset();
+    source_visited_.Clear();
+    sink_visited_.Clear();
+  }
 
  private:
   const ExpandVariable &self_;
   UniqueCursorPtr input_cursor_;
 
-  using VertexEdgeMapT = utils::pmr::unordered_map<VertexAccessor, std::optional<EdgeAccessor>>;
+  // Vertices visited expanding from the source (sink). They are kept between
+  // searches so that the bitmaps are allocated only once.
+  VisitedVertices source_visited_;
+  VisitedVertices sink_visited_;
+  // True if the filter lambda calls functions that keep state between calls,
+  // which forces the frontier to be expanded serially.
+  bool stateful_filter_;
+
+  using VertexEdgeMapT = utils::pmr::unordered_map<storage::Gid, EdgeAccessor>;
 
   void ReconstructPath(const VertexAccessor &midpoint, const VertexEdgeMapT &in_edge, const VertexEdgeMapT &out_edge,
                        Frame *frame, utils::MemoryResource *pull_memory) {
     utils::pmr::vector<TypedValue> result(pull_memory);
     auto last_vertex = midpoint;
     while (true) {
-      const auto &last_edge = in_edge.at(last_vertex);
-      if (!last_edge) break;
-      last_vertex = last_edge->From() == last_vertex ? last_edge->To() : last_edge->From();
-      result.emplace_back(*last_edge);
+      auto last_edge = in_edge.find(last_vertex.Gid());
+      if (last_edge == in_edge.end()) break;
+      last_vertex = last_edge->second.From() == last_vertex ? last_edge->second.To() : last_edge->second.From();
+      result.emplace_back(last_edge->second);
     }
     std::reverse(result.begin(), result.end());
     last_vertex = midpoint;
     while (true) {
-      const auto &last_edge = out_edge.at(last_vertex);
-      if (!last_edge) break;
-      last_vertex = last_edge->From() == last_vertex ? last_edge->To() : last_edge->From();
-      result.emplace_back(*last_edge);
+      auto last_edge = out_edge.find(last_vertex.Gid());
+      if (last_edge == out_edge.end()) break;
+      last_vertex = last_edge->second.From() == last_vertex ? last_edge->second.To() : last_edge->second.From();
+      result.emplace_back(last_edge->second);
     }
     frame->at(self_.common_.edge_symbol) = std::move(result);
   }
@@ -1143,8 +1633,6 @@ class STShortestPathCursor : public query::plan::Cursor {
 
   bool FindPath(const DbAccessor &dba, const VertexAccessor &source, const VertexAccessor &sink, int64_t lower_bound,
                 int64_t upper_bound, Frame *frame, ExpressionEvaluator *evaluator, const ExecutionContext &context) {
-    using utils::Contains;
-
     if (source == sink) return false;
 
     // We expand from both directions, both from the source and the sink.
@@ -1163,112 +1651,89 @@ class STShortestPathCursor : public query::plan::Cursor {
     utils::pmr::vector<VertexAccessor> source_next(pull_memory);
     utils::pmr::vector<VertexAccessor> sink_next(pull_memory);
 
-    // Maps each vertex we visited expanding from the source (sink) to the
-    // edge used. Necessary for path reconstruction.
+    // Maps each vertex we visited expanding from the source (sink), except
+    // the source (sink) itself, to the edge used. Necessary for path
+    // reconstruction.
     VertexEdgeMapT in_edge(pull_memory);
     VertexEdgeMapT out_edge(pull_memory);
 
+    source_visited_.Clear();
+    sink_visited_.Clear();
+
     size_t current_length = 0;
 
     source_frontier.emplace_back(source);
-    in_edge[source] = std::nullopt;
+    source_visited_.Insert(source);
     sink_frontier.emplace_back(sink);
-    out_edge[sink] = std::nullopt;
+    sink_visited_.Insert(sink);
 
-    while (true) {
-      if (MustAbort(context)) throw HintedAbortError();
-      // Top-down step (expansion from the source).
-      ++current_length;
-      if (current_length > upper_bound) return false;
+    // Vertex in which the expansions from the source and the sink met.
+    std::optional<VertexAccessor> midpoint;
 
-      for (const auto &vertex : source_frontier) {
-        if (self_.common_.direction != EdgeAtom::Direction::IN) {
-          auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : out_edges) {
-            if (ShouldExpand(edge.To(), edge, frame, evaluator) && !Contains(in_edge, edge.To())) {
-              in_edge.emplace(edge.To(), edge);
-              if (Contains(out_edge, edge.To())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.To(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              source_next.push_back(edge.To());
-            }
-          }
-        }
-        if (self_.common_.direction != EdgeAtom::Direction::OUT) {
-          auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : in_edges) {
-            if (ShouldExpand(edge.From(), edge, frame, evaluator) && !Contains(in_edge, edge.From())) {
-              in_edge.emplace(edge.From(), edge);
-              if (Contains(out_edge, edge.From())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.From(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              source_next.push_back(edge.From());
-            }
-          }
-        }
+    // Expansion from the source.
+    auto should_expand_source = [this](const VertexAccessor &, const EdgeAccessor &edge, const VertexAccessor &next,
+                                       Frame *filter_frame, ExpressionEvaluator *filter_evaluator) {
+      return ShouldExpand(next, edge, filter_frame, filter_evaluator);
+    };
+    auto expand_source = [&](const VertexAccessor &, const EdgeAccessor &edge, const VertexAccessor &next) {
+      if (source_visited_.Contains(next)) return true;
+      source_visited_.Insert(next);
+      in_edge.emplace(next.Gid(), edge);
+      if (sink_visited_.Contains(next)) {
+        midpoint.emplace(next);
+        return false;
       }
+      source_next.push_back(next);
+      return true;
+    };
 
-      if (source_next.empty()) return false;
-      source_frontier.clear();
-      std::swap(source_frontier, source_next);
+    // Expansion from the sink. We have to be careful which edge endpoint we
+    // pass to `ShouldExpand`, because everything is reversed.
+    auto should_expand_sink = [this](const VertexAccessor &vertex, const EdgeAccessor &edge, const VertexAccessor &,
+                                     Frame *filter_frame, ExpressionEvaluator *filter_evaluator) {
+      return ShouldExpand(vertex, edge, filter_frame, filter_evaluator);
+    };
+    auto expand_sink = [&](const VertexAccessor &, const EdgeAccessor &edge, const VertexAccessor &next) {
+      if (sink_visited_.Contains(next)) return true;
+      sink_visited_.Insert(next);
+      out_edge.emplace(next.Gid(), edge);
+      if (source_visited_.Contains(next)) {
+        midpoint.emplace(next);
+        return false;
+      }
+      sink_next.push_back(next);
+      return true;
+    };
 
-      // Bottom-up step (expansion from the sink).
+    while (true) {
+      if (MustAbort(context)) throw HintedAbortError();
       ++current_length;
       if (current_length > upper_bound) return false;
 
-      // When expanding from the sink we have to be careful which edge
-      // endpoint we pass to `should_expand`, because everything is
-      // reversed.
-      for (const auto &vertex : sink_frontier) {
-        if (self_.common_.direction != EdgeAtom::Direction::OUT) {
-          auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : out_edges) {
-            if (ShouldExpand(vertex, edge, frame, evaluator) && !Contains(out_edge, edge.To())) {
-              out_edge.emplace(edge.To(), edge);
-              if (Contains(in_edge, edge.To())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.To(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              sink_next.push_back(edge.To());
-            }
-          }
-        }
-        if (self_.common_.direction != EdgeAtom::Direction::IN) {
-          auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
-          for (const auto &edge : in_edges) {
-            if (ShouldExpand(vertex, edge, frame, evaluator) && !Contains(out_edge, edge.From())) {
-              out_edge.emplace(edge.From(), edge);
-              if (Contains(in_edge, edge.From())) {
-                if (current_length >= lower_bound) {
-                  ReconstructPath(edge.From(), in_edge, out_edge, frame, pull_memory);
-                  return true;
-                } else {
-                  return false;
-                }
-              }
-              sink_next.push_back(edge.From());
-            }
-          }
-        }
+      // The search is direction-optimizing: the smaller of the two frontiers
+      // is expanded in each step, which keeps the number of examined edges
+      // low when the graph is much denser around one of the endpoints.
+      if (source_frontier.size() <= sink_frontier.size()) {
+        // Top-down step (expansion from the source).
+        ExpandFrontier(source_frontier, self_.common_.direction, self_.common_.edge_types, source_visited_, frame,
+                       evaluator, context, stateful_filter_, should_expand_source, expand_source);
+        if (!midpoint && source_next.empty()) return false;
+        source_frontier.clear();
+        std::swap(source_frontier, source_next);
+      } else {
+        // Bottom-up step (expansion from the sink).
+        ExpandFrontier(sink_frontier, ReverseDirection(self_.common_.direction), self_.common_.edge_types,
+                       sink_visited_, frame, evaluator, context, stateful_filter_, should_expand_sink, expand_sink);
+        if (!midpoint && sink_next.empty()) return false;
+        sink_frontier.clear();
+        std::swap(sink_frontier, sink_next);
       }
 
-      if (sink_next.empty()) return false;
-      sink_frontier.clear();
-      std::swap(sink_frontier, sink_next);
+      if (midpoint) {
+        if (current_length < lower_bound) return false;
+        ReconstructPath(*midpoint, in_edge, out_edge, frame, pull_memory);
+        return true;
+      }
     }
   }
 };
@@ -1278,9 +1743,11 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
   SingleSourceShortestPathCursor(const ExpandVariable &self, utils::MemoryResource *mem)
       : self_(self),
         input_cursor_(self_.input()->MakeCursor(mem)),
+        visited_(mem),
         processed_(mem),
         to_visit_current_(mem),
-        to_visit_next_(mem) {
+        to_visit_next_(mem),
+        stateful_filter_(UsesStatefulFunctions(self_.filter_lambda_.expression)) {
     MG_ASSERT(!self_.common_.existing_node,
               "Single source shortest path algorithm "
               "should not be used when `existing_node` "
@@ -1295,49 +1762,55 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
                                   storage::View::OLD);
 
     // for the given (edge, vertex) pair checks if they satisfy the
-    // "where" condition. if so, places them in the to_visit_ structure.
-    auto expand_pair = [this, &evaluator, &frame](EdgeAccessor edge, VertexAccessor vertex) {
-      // if we already processed the given vertex it doesn't get expanded
-      if (processed_.find(vertex) != processed_.end()) return;
+    // "where" condition.
+    auto should_expand = [this](const VertexAccessor &, const EdgeAccessor &edge, const VertexAccessor &vertex,
+                                Frame *filter_frame, ExpressionEvaluator *filter_evaluator) {
+      if (!self_.filter_lambda_.expression) return true;
 
-      frame[self_.filter_lambda_.inner_edge_symbol] = edge;
-      frame[self_.filter_lambda_.inner_node_symbol] = vertex;
+      (*filter_frame)[self_.filter_lambda_.inner_edge_symbol] = edge;
+      (*filter_frame)[self_.filter_lambda_.inner_node_symbol] = vertex;
 
-      if (self_.filter_lambda_.expression) {
-        TypedValue result = self_.filter_lambda_.expression->Accept(evaluator);
-        switch (result.type()) {
-          case TypedValue::Type::Null:
-            return;
-          case TypedValue::Type::Bool:
-            if (!result.ValueBool()) return;
-            break;
-          default:
-            throw QueryRuntimeException("Expansion condition must evaluate to boolean or null.");
-        }
+      TypedValue result = self_.filter_lambda_.expression->Accept(*filter_evaluator);
+      switch (result.type()) {
+        case TypedValue::Type::Null:
+          return false;
+        case TypedValue::Type::Bool:
+          return result.ValueBool();
+        default:
+          throw QueryRuntimeException("Expansion condition must evaluate to boolean or null.");
       }
+    };
+
+    // places the (edge, vertex) pairs that satisfy the "where" condition in
+    // the to_visit_ structure.
+    auto expand_pair = [this](const VertexAccessor &, const EdgeAccessor &edge, const VertexAccessor &vertex) {
+      // if we already processed the given vertex it doesn't get expanded
+      if (visited_.Contains(vertex)) return true;
+
       to_visit_next_.emplace_back(edge, vertex);
-      processed_.emplace(vertex, edge);
+      visited_.Insert(vertex);
+      processed_.emplace(vertex.Gid(), edge);
+      return true;
     };
 
-    // populates the to_visit_next_ structure with expansions
-    // from the given vertex. skips expansions that don't satisfy
+    // populates the to_visit_next_ structure with expansions from all of the
+    // vertices in the given frontier. skips expansions that don't satisfy
     // the "where" condition.
-    auto expand_from_vertex = [this, &expand_pair](const auto &vertex) {
-      if (self_.common_.direction != EdgeAtom::Direction::IN) {
-        auto out_edges = UnwrapEdgesResult(vertex.OutEdges(storage::View::OLD, self_.common_.edge_types));
-        for (const auto &edge : out_edges) expand_pair(edge, edge.To());
-      }
-      if (self_.common_.direction != EdgeAtom::Direction::OUT) {
-        auto in_edges = UnwrapEdgesResult(vertex.InEdges(storage::View::OLD, self_.common_.edge_types));
-        for (const auto &edge : in_edges) expand_pair(edge, edge.From());
-      }
+    auto expand_frontier = [this, &frame, &evaluator, &context, &should_expand, &expand_pair](const auto &frontier) {
+      ExpandFrontier(frontier, self_.common_.direction, self_.common_.edge_types, visited_, &frame, &evaluator, context,
+                     stateful_filter_, should_expand, expand_pair);
     };
 
     // do it all in a loop because we skip some elements
     while (true) {
       if (MustAbort(context)) throw HintedAbortError();
-      // if we have nothing to visit on the current depth, switch to next
-      if (to_visit_current_.empty()) to_visit_current_.swap(to_visit_next_);
+      // if we have nothing to visit on the current depth, switch to next and
+      // expand the whole new depth at once if it's still less than max depth
+      if (to_visit_current_.empty() && !to_visit_next_.empty()) {
+        to_visit_current_.swap(to_visit_next_);
+        ++current_depth_;
+        if (current_depth_ < upper_bound_) expand_frontier(to_visit_current_);
+      }
 
       // if current is still empty, it means both are empty, so pull from
       // input
@@ -1347,6 +1820,7 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
         to_visit_current_.clear();
         to_visit_next_.clear();
         processed_.clear();
+        visited_.Clear();
 
         const auto &vertex_value = frame[self_.input_symbol_];
         // it is possible that the vertex is Null due to optional matching
@@ -1361,8 +1835,9 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
         if (upper_bound_ < 1 || lower_bound_ > upper_bound_) continue;
 
         const auto &vertex = vertex_value.ValueVertex();
-        processed_.emplace(vertex, std::nullopt);
-        expand_from_vertex(vertex);
+        visited_.Insert(vertex);
+        current_depth_ = 0;
+        expand_frontier(std::array<VertexAccessor, 1>{vertex});
 
         // go back to loop start and see if we expanded anything
         continue;
@@ -1372,6 +1847,8 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
       auto expansion = to_visit_current_.back();
       to_visit_current_.pop_back();
 
+      if (current_depth_ < lower_bound_) continue;
+
       // create the frame value for the edges
       auto *pull_memory = context.evaluation_context.memory;
       utils::pmr::vector<TypedValue> edge_list(pull_memory);
@@ -1380,18 +1857,13 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
       while (true) {
         const EdgeAccessor &last_edge = edge_list.back().ValueEdge();
         last_vertex = last_edge.From() == last_vertex ? last_edge.To() : last_edge.From();
-        // origin_vertex must be in processed
-        const auto &previous_edge = processed_.find(last_vertex)->second;
-        if (!previous_edge) break;
+        // every vertex except the origin is in processed
+        auto previous_edge = processed_.find(last_vertex.Gid());
+        if (previous_edge == processed_.end()) break;
 
-        edge_list.emplace_back(previous_edge.value());
+        edge_list.emplace_back(previous_edge->second);
       }
 
-      // expand only if what we've just expanded is less then max depth
-      if (static_cast<int64_t>(edge_list.size()) < upper_bound_) expand_from_vertex(expansion.second);
-
-      if (static_cast<int64_t>(edge_list.size()) < lower_bound_) continue;
-
       frame[self_.common_.node_symbol] = expansion.second;
 
       // place edges on the frame in the correct order
@@ -1406,6 +1878,7 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
 
   void Reset() override {
     input_cursor_->Reset();
+    visited_.Clear();
     processed_.clear();
     to_visit_next_.clear();
     to_visit_current_.clear();
@@ -1419,14 +1892,20 @@ class SingleSourceShortestPathCursor : public query::plan::Cursor {
   // is irrelevant.
   int64_t lower_bound_{-1};
   int64_t upper_bound_{-1};
+  // depth of the vertices in to_visit_current_
+  int64_t current_depth_{0};
 
-  // maps vertices to the edge they got expanded from. it is an optional
-  // edge because the root does not get expanded from anything.
   // contains visited vertices as well as those scheduled to be visited.
-  utils::pmr::unordered_map<VertexAccessor, std::optional<EdgeAccessor>> processed_;
+  VisitedVertices visited_;
+  // maps visited vertices, except the origin, to the edge they got expanded
+  // from.
+  utils::pmr::unordered_map<storage::Gid, EdgeAccessor> processed_;
   // edge/vertex pairs we have yet to visit, for current and next depth
   utils::pmr::vector<std::pair<EdgeAccessor, VertexAccessor>> to_visit_current_;
   utils::pmr::vector<std::pair<EdgeAccessor, VertexAccessor>> to_visit_next_;
+  // True if the filter lambda calls functions that keep state between calls,
+  // which forces the frontier to be expanded serially.
+  bool stateful_filter_;
 };
 
 class ExpandWeightedShortestPathCursor : public query::plan::Cursor {
@@ -1922,6 +2401,8 @@ bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
       auto maybe_value = dba.RemoveEdge(&expression_result.ValueEdge());
       if (maybe_value.HasError()) {
         switch (maybe_value.GetError()) {
+          case storage::Error::READ_ONLY_TRANSACTION:
+            throw WriteQueryInReadOnlyTxException();
           case storage::Error::SERIALIZATION_ERROR:
             throw TransactionSerializationException();
           case storage::Error::DELETED_OBJECT:
@@ -1948,6 +2429,8 @@ bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
           auto res = dba.DetachRemoveVertex(&va);
           if (res.HasError()) {
             switch (res.GetError()) {
+              case storage::Error::READ_ONLY_TRANSACTION:
+                throw WriteQueryInReadOnlyTxException();
               case storage::Error::SERIALIZATION_ERROR:
                 throw TransactionSerializationException();
               case storage::Error::DELETED_OBJECT:
@@ -1979,6 +2462,8 @@ bool Delete::DeleteCursor::Pull(Frame &frame, ExecutionContext &context) {
           auto res = dba.RemoveVertex(&va);
           if (res.HasError()) {
             switch (res.GetError()) {
+              case storage::Error::READ_ONLY_TRANSACTION:
+                throw WriteQueryInReadOnlyTxException();
               case storage::Error::SERIALIZATION_ERROR:
                 throw TransactionSerializationException();
               case storage::Error::VERTEX_HAS_EDGES:
@@ -2127,6 +2612,8 @@ void SetPropertiesOnRecord(TRecordAccessor *record, const TypedValue &rhs, SetPr
     auto maybe_value = record->ClearProperties();
     if (maybe_value.HasError()) {
       switch (maybe_value.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::DELETED_OBJECT:
           throw QueryRuntimeException("Trying to set properties on a deleted graph element.");
         case storage::Error::SERIALIZATION_ERROR:
@@ -2154,6 +2641,7 @@ void SetPropertiesOnRecord(TRecordAccessor *record, const TypedValue &rhs, SetPr
           throw query::QueryRuntimeException("Trying to get properties from an object that doesn't exist.");
         case storage::Error::SERIALIZATION_ERROR:
         case storage::Error::VERTEX_HAS_EDGES:
+        case storage::Error::READ_ONLY_TRANSACTION:
         case storage::Error::PROPERTIES_DISABLED:
           throw QueryRuntimeException("Unexpected error when getting properties.");
       }
@@ -2183,6 +2671,8 @@ void SetPropertiesOnRecord(TRecordAccessor *record, const TypedValue &rhs, SetPr
       auto maybe_error = record->SetProperty(kv.first, kv.second);
       if (maybe_error.HasError()) {
         switch (maybe_error.GetError()) {
+          case storage::Error::READ_ONLY_TRANSACTION:
+            throw WriteQueryInReadOnlyTxException();
           case storage::Error::DELETED_OBJECT:
             throw QueryRuntimeException("Trying to set properties on a deleted graph element.");
           case storage::Error::SERIALIZATION_ERROR:
@@ -2300,6 +2790,8 @@ bool SetLabels::SetLabelsCursor::Pull(Frame &frame, ExecutionContext &context) {
     auto maybe_value = vertex.AddLabel(label);
     if (maybe_value.HasError()) {
       switch (maybe_value.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::SERIALIZATION_ERROR:
           throw TransactionSerializationException();
         case storage::Error::DELETED_OBJECT:
@@ -2356,6 +2848,8 @@ bool RemoveProperty::RemovePropertyCursor::Pull(Frame &frame, ExecutionContext &
     auto maybe_old_value = record->RemoveProperty(property);
     if (maybe_old_value.HasError()) {
       switch (maybe_old_value.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::DELETED_OBJECT:
           throw QueryRuntimeException("Trying to remove a property on a deleted graph element.");
         case storage::Error::SERIALIZATION_ERROR:
@@ -2429,6 +2923,8 @@ bool RemoveLabels::RemoveLabelsCursor::Pull(Frame &frame, ExecutionContext &cont
     auto maybe_value = vertex.RemoveLabel(label);
     if (maybe_value.HasError()) {
       switch (maybe_value.GetError()) {
+        case storage::Error::READ_ONLY_TRANSACTION:
+          throw WriteQueryInReadOnlyTxException();
         case storage::Error::SERIALIZATION_ERROR:
           throw TransactionSerializationException();
         case storage::Error::DELETED_OBJECT:
@@ -3912,13 +4408,123 @@ TypedValue CsvRowToTypedMap(csv::Reader::Row row, csv::Reader::Header header) {
   return TypedValue(m, mem);
 }
 
+// Number of rows that are handed over from the CSV producer thread at once.
+constexpr size_t kCsvBatchSize = 1000;
+// Maximum number of batches that can wait to be pulled, so that a slow query
+// pipeline doesn't cause the whole file to be buffered in memory.
+constexpr size_t kCsvMaxQueuedBatches = 16;
+
+/// Parses the CSV file and converts its rows to TypedValues on a separate
+/// thread. The converted rows are passed to the LoadCsvCursor in batches
+/// through a bounded queue, so parsing overlaps with the execution of the rest
+/// of the query. The rows are allocated with the new/delete resource, because
+/// the execution memory resource isn't thread safe, and are copied to the
+/// execution memory once they are pulled.
+class CsvRowProducer {
+ public:
+  explicit CsvRowProducer(csv::Reader reader) : reader_(std::move(reader)), thread_([this] { Produce(); }) {}
+
+  CsvRowProducer(const CsvRowProducer &) = delete;
+  CsvRowProducer &operator=(const CsvRowProducer &) = delete;
+  CsvRowProducer(CsvRowProducer &&) = delete;
+  CsvRowProducer &operator=(CsvRowProducer &&) = delete;
+
+  ~CsvRowProducer() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+  }
+
+  /// Returns the next row or `std::nullopt` if all rows were read.
+  /// @throw CsvReadException if the file couldn't be read.
+  std::optional<TypedValue> Next() {
+    if (batch_pos_ == batch_.size()) {
+      std::unique_lock<std::mutex> guard(lock_);
+      cond_.wait(guard, [this] { return !queue_.empty() || done_; });
+      if (queue_.empty()) {
+        // All rows that were read before the error were already returned.
+        if (error_) std::rethrow_exception(error_);
+        return std::nullopt;
+      }
+      batch_ = std::move(queue_.front());
+      queue_.pop_front();
+      batch_pos_ = 0;
+      guard.unlock();
+      cond_.notify_all();
+    }
+    return std::move(batch_[batch_pos_++]);
+  }
+
+ private:
+  void Produce() {
+    auto *memory = utils::NewDeleteResource();
+    std::vector<TypedValue> batch;
+    std::exception_ptr error;
+    try {
+      while (auto row = reader_.GetNextRow(memory)) {
+        if (!reader_.HasHeader()) {
+          batch.emplace_back(CsvRowToTypedList(std::move(*row)));
+        } else {
+          batch.emplace_back(CsvRowToTypedMap(std::move(*row), csv::Reader::Header(reader_.GetHeader(), memory)));
+        }
+        if (batch.size() == kCsvBatchSize) {
+          if (!Push(std::move(batch))) return;
+          batch.clear();
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (!batch.empty() && !Push(std::move(batch))) return;
+
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      done_ = true;
+      error_ = error;
+    }
+    cond_.notify_all();
+  }
+
+  /// Waits until there is space in the queue and pushes the batch. Returns
+  /// `false` if the producer should stop.
+  bool Push(std::vector<TypedValue> batch) {
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      cond_.wait(guard, [this] { return queue_.size() < kCsvMaxQueuedBatches || stop_; });
+      if (stop_) return false;
+      queue_.emplace_back(std::move(batch));
+    }
+    cond_.notify_all();
+    return true;
+  }
+
+  csv::Reader reader_;
+
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::deque<std::vector<TypedValue>> queue_;
+  bool done_{false};
+  bool stop_{false};
+  std::exception_ptr error_;
+
+  // Batch that is currently being pulled, accessed only by the consumer.
+  std::vector<TypedValue> batch_;
+  size_t batch_pos_{0};
+
+  // The thread has to be initialized last because it uses all of the above.
+  std::thread thread_;
+};
+
 }  // namespace
 
 class LoadCsvCursor : public Cursor {
   const LoadCsv *self_;
   const UniqueCursorPtr input_cursor_;
   bool input_is_once_;
-  std::optional<csv::Reader> reader_{};
+  std::optional<CsvRowProducer> producer_{};
 
  public:
   LoadCsvCursor(const LoadCsv *self, utils::MemoryResource *mem)
@@ -3936,8 +4542,8 @@ class LoadCsvCursor : public Cursor {
     //  doesn't allow evaluating the expressions contained in self_->file_,
     //  self_->delimiter_, and self_->quote_ earlier (say, in the interpreter.cpp)
     //  without massacring the code even worse than I did here
-    if (UNLIKELY(!reader_)) {
-      reader_ = MakeReader(&context.evaluation_context);
+    if (UNLIKELY(!producer_)) {
+      producer_.emplace(MakeReader(&context.evaluation_context));
     }
 
     bool input_pulled = input_cursor_->Pull(frame, context);
@@ -3949,13 +4555,10 @@ class LoadCsvCursor : public Cursor {
     // pulling MATCH).
     if (!input_is_once_ && !input_pulled) return false;
 
-    if (auto row = reader_->GetNextRow(context.evaluation_context.memory)) {
-      if (!reader_->HasHeader()) {
-        frame[self_->row_var_] = CsvRowToTypedList(std::move(*row));
-      } else {
-        frame[self_->row_var_] = CsvRowToTypedMap(
-            std::move(*row), csv::Reader::Header(reader_->GetHeader(), context.evaluation_context.memory));
-      }
+    if (auto row = producer_->Next()) {
+      // Copying the row to the evaluation memory makes it count towards the
+      // query memory limit, just like the rows read on the query thread did.
+      frame[self_->row_var_] = TypedValue(std::move(*row), context.evaluation_context.memory);
       return true;
     }
 
@@ -3963,7 +4566,10 @@ class LoadCsvCursor : public Cursor {
   }
 
   void Reset() override { input_cursor_->Reset(); }
-  void Shutdown() override { input_cursor_->Shutdown(); }
+  void Shutdown() override {
+    input_cursor_->Shutdown();
+    producer_.reset();
+  }
 
  private:
   csv::Reader MakeReader(EvaluationContext *eval_context) {
@@ -4073,4 +4679,93 @@ bool Foreach::Accept(HierarchicalLogicalOperatorVisitor &visitor) {
   return visitor.PostVisit(*this);
 }
 
+PeriodicCommit::PeriodicCommit(std::shared_ptr<LogicalOperator> input, Expression *commit_frequency)
+    : input_(std::move(input)), commit_frequency_(commit_frequency) {
+  MG_ASSERT(input_, "PeriodicCommit requires an input operator");
+  MG_ASSERT(commit_frequency_, "PeriodicCommit requires a commit frequency");
+}
+
+ACCEPT_WITH_INPUT(PeriodicCommit)
+
+std::vector<Symbol> PeriodicCommit::OutputSymbols(const SymbolTable &table) const {
+  return input_->OutputSymbols(table);
+}
+
+std::vector<Symbol> PeriodicCommit::ModifiedSymbols(const SymbolTable &table) const {
+  return input_->ModifiedSymbols(table);
+}
+
+class PeriodicCommitCursor : public Cursor {
+ public:
+  PeriodicCommitCursor(const PeriodicCommit &self, utils::MemoryResource *mem)
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("PeriodicCommit");
+
+    if (!commit_frequency_) {
+      ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                    storage::View::OLD);
+      const auto commit_frequency = self_.commit_frequency_->Accept(evaluator);
+      if (!commit_frequency.IsInt() || commit_frequency.ValueInt() <= 0) {
+        throw QueryRuntimeException("Periodic commit frequency must be a positive integer.");
+      }
+      commit_frequency_ = commit_frequency.ValueInt();
+    }
+
+    // All of the changes made for the previously pulled rows are done once
+    // the next row is requested.
+    if (pulled_rows_ == *commit_frequency_) {
+      Commit(context.db_accessor);
+      pulled_rows_ = 0;
+    }
+
+    if (!input_cursor_->Pull(frame, context)) return false;
+    ++pulled_rows_;
+    return true;
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    pulled_rows_ = 0;
+  }
+
+ private:
+  static void Commit(DbAccessor *dba) {
+    EventCounter::IncrementCounter(EventCounter::PeriodicCommits);
+    auto maybe_constraint_violation = dba->CommitAndRestart();
+    if (!maybe_constraint_violation.HasError()) return;
+
+    const auto &constraint_violation = maybe_constraint_violation.GetError();
+    switch (constraint_violation.type) {
+      case storage::ConstraintViolation::Type::EXISTENCE: {
+        MG_ASSERT(constraint_violation.properties.size() == 1U);
+        throw QueryRuntimeException("Unable to commit due to existence constraint violation on :{}({})",
+                                    dba->LabelToName(constraint_violation.label),
+                                    dba->PropertyToName(*constraint_violation.properties.begin()));
+      }
+      case storage::ConstraintViolation::Type::UNIQUE: {
+        std::stringstream property_names_stream;
+        utils::PrintIterable(property_names_stream, constraint_violation.properties, ", ",
+                             [dba](auto &stream, const auto &prop) { stream << dba->PropertyToName(prop); });
+        throw QueryRuntimeException("Unable to commit due to unique constraint violation on :{}({})",
+                                    dba->LabelToName(constraint_violation.label), property_names_stream.str());
+      }
+    }
+  }
+
+  const PeriodicCommit &self_;
+  const UniqueCursorPtr input_cursor_;
+  std::optional<int64_t> commit_frequency_;
+  int64_t pulled_rows_{0};
+};
+
+UniqueCursorPtr PeriodicCommit::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::PeriodicCommitOperator);
+
+  return MakeUniqueCursorPtr<PeriodicCommitCursor>(mem, *this, mem);
+}
+
 }  // namespace memgraph::query::plan
@@ -393,6 +393,28 @@ void Filters::AnalyzeAndStoreFilter(Expression *expr, const SymbolTable &symbol_
     }
     return is_prop_filter;
   };
+  // Checks if function is a STARTS WITH, ENDS WITH or CONTAINS string match
+  // on a property lookup, stores it as a PropertyFilter and returns true. If
+  // it isn't, returns false.
+  auto add_prop_string_match = [&](auto *function) -> bool {
+    std::optional<PropertyFilter::Type> type;
+    if (function->function_name_ == kStartsWith) {
+      type = PropertyFilter::Type::STARTS_WITH;
+    } else if (function->function_name_ == kEndsWith) {
+      type = PropertyFilter::Type::ENDS_WITH;
+    } else if (function->function_name_ == kContains) {
+      type = PropertyFilter::Type::CONTAINS;
+    }
+    if (!type || function->arguments_.size() != 2U) return false;
+    PropertyLookup *prop_lookup = nullptr;
+    Identifier *ident = nullptr;
+    if (!get_property_lookup(function->arguments_[0], prop_lookup, ident)) return false;
+    auto filter = make_filter(FilterInfo::Type::Property);
+    filter.property_filter = PropertyFilter(symbol_table, symbol_table.at(*ident), prop_lookup->property_,
+                                            function->arguments_[1], *type);
+    all_filters_.emplace_back(filter);
+    return true;
+  };
   // Check if maybe_id_fun is ID invocation on an indentifier and add it as
   // IdFilter.
   auto add_id_equal = [&](auto *maybe_id_fun, auto *val_expr) -> bool {
@@ -519,6 +541,10 @@ void Filters::AnalyzeAndStoreFilter(Expression *expr, const SymbolTable &symbol_
     if (!add_prop_is_not_null_check(is_not_null)) {
       all_filters_.emplace_back(make_filter(FilterInfo::Type::Generic));
     }
+  } else if (auto *function = utils::Downcast<Function>(expr)) {
+    if (!add_prop_string_match(function)) {
+      all_filters_.emplace_back(make_filter(FilterInfo::Type::Generic));
+    }
   } else {
     all_filters_.emplace_back(make_filter(FilterInfo::Type::Generic));
   }
@@ -105,10 +105,11 @@ class PropertyFilter {
   using Bound = ScanAllByLabelPropertyRange::Bound;
 
   /// Depending on type, this PropertyFilter may be a value equality, regex
-  /// matched value or a range with lower and (or) upper bounds, IN list filter.
-  enum class Type { EQUAL, REGEX_MATCH, RANGE, IN, IS_NOT_NULL };
+  /// matched value or a range with lower and (or) upper bounds, IN list filter,
+  /// or a STARTS WITH, ENDS WITH or CONTAINS string match.
+  enum class Type { EQUAL, REGEX_MATCH, RANGE, IN, IS_NOT_NULL, STARTS_WITH, ENDS_WITH, CONTAINS };
 
-  /// Construct with Expression being the equality or regex match check.
+  /// Construct with Expression being the equality, regex or string match check.
   PropertyFilter(const SymbolTable &, const Symbol &, PropertyIx, Expression *, Type);
   /// Construct the range based filter.
   PropertyFilter(const SymbolTable &, const Symbol &, PropertyIx, const std::optional<Bound> &,
@@ -126,7 +127,7 @@ class PropertyFilter {
   /// True if the same symbol is used in expressions for value or bounds.
   bool is_symbol_in_value_ = false;
   /// Expression which when evaluated produces the value a property must
-  /// equal or regex match depending on type_.
+  /// equal, regex match or string match depending on type_.
   Expression *value_ = nullptr;
   /// Expressions which produce lower and upper bounds for a property.
   std::optional<Bound> lower_bound_{};
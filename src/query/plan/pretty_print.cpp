@@ -84,6 +84,26 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelProperty &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelProperties &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByLabelProperties"
+        << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {";
+    utils::PrintIterable(out, op.properties_, ", ",
+                         [this](auto &stream, const auto &property) { stream << dba_->PropertyToName(property); });
+    out << "})";
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(query::plan::ScanAllByText &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByText"
+        << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
+        << dba_->PropertyToName(op.property_) << "})";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(ScanAllById &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAllById"
@@ -92,6 +112,15 @@ bool PlanPrinter::PreVisit(ScanAllById &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(ScanAllByEdgeType &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByEdgeType"
+        << " (" << op.from_symbol_.name() << ")-[" << op.edge_symbol_.name() << ":"
+        << dba_->EdgeTypeToName(op.edge_type_) << "]->(" << op.to_symbol_.name() << ")";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(query::plan::Expand &op) {
   WithPrintLn([&](auto &out) {
     *out_ << "* Expand (" << op.input_symbol_.name() << ")"
@@ -247,6 +276,11 @@ bool PlanPrinter::PreVisit(query::plan::Foreach &op) {
   op.input_->Accept(*this);
   return false;
 }
+
+bool PlanPrinter::PreVisit(query::plan::PeriodicCommit &op) {
+  WithPrintLn([](auto &out) { out << "* PeriodicCommit"; });
+  return true;
+}
 #undef PRE_VISIT
 
 bool PlanPrinter::DefaultPreVisit() {
@@ -440,6 +474,7 @@ bool PlanToJsonVisitor::PreVisit(ScanAllByLabelPropertyRange &op) {
   self["property"] = ToJson(op.property_, *dba_);
   self["lower_bound"] = op.lower_bound_ ? ToJson(*op.lower_bound_) : json();
   self["upper_bound"] = op.upper_bound_ ? ToJson(*op.upper_bound_) : json();
+  self["prefix_scan"] = op.prefix_scan_;
   self["output_symbol"] = ToJson(op.output_symbol_);
 
   op.input_->Accept(*this);
@@ -478,6 +513,36 @@ bool PlanToJsonVisitor::PreVisit(ScanAllByLabelProperty &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByLabelProperties &op) {
+  json self;
+  self["name"] = "ScanAllByLabelProperties";
+  self["label"] = ToJson(op.label_, *dba_);
+  self["properties"] = ToJson(op.properties_, *dba_);
+  self["expressions"] = ToJson(op.expressions_);
+  self["output_symbol"] = ToJson(op.output_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
+bool PlanToJsonVisitor::PreVisit(ScanAllByText &op) {
+  json self;
+  self["name"] = "ScanAllByText";
+  self["label"] = ToJson(op.label_, *dba_);
+  self["property"] = ToJson(op.property_, *dba_);
+  self["expression"] = ToJson(op.expression_);
+  self["output_symbol"] = ToJson(op.output_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   json self;
   self["name"] = "ScanAllById";
@@ -488,6 +553,19 @@ bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByEdgeType &op) {
+  json self;
+  self["name"] = "ScanAllByEdgeType";
+  self["edge_type"] = ToJson(op.edge_type_, *dba_);
+  self["from_symbol"] = ToJson(op.from_symbol_);
+  self["edge_symbol"] = ToJson(op.edge_symbol_);
+  self["to_symbol"] = ToJson(op.to_symbol_);
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(CreateNode &op) {
   json self;
   self["name"] = "CreateNode";
@@ -845,6 +923,18 @@ bool PlanToJsonVisitor::PreVisit(query::plan::LoadCsv &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(query::plan::PeriodicCommit &op) {
+  json self;
+  self["name"] = "PeriodicCommit";
+  self["commit_frequency"] = ToJson(op.commit_frequency_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Distinct &op) {
   json self;
   self["name"] = "Distinct";
@@ -11,14 +11,17 @@
 
 /// @file
 /// This file provides a plan rewriter which replaces `Filter` and `ScanAll`
-/// operations with `ScanAllBy<Index>` if possible. The public entrypoint is
-/// `RewriteWithIndexLookup`.
+/// operations with `ScanAllBy<Index>` if possible. A `ScanAll` followed by an
+/// `Expand` over a single indexed edge type is replaced with
+/// `ScanAllByEdgeType`. The public entrypoint is `RewriteWithIndexLookup`.
 
 #pragma once
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -90,13 +93,19 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
-  // See if it might be better to do ScanAllBy<Index> of the destination and
-  // then do Expand to existing.
+  // See if the source scan and the expansion can be replaced with an edge type
+  // index scan. Otherwise see if it might be better to do ScanAllBy<Index> of
+  // the destination and then do Expand to existing.
   bool PostVisit(Expand &expand) override {
     prev_ops_.pop_back();
     if (expand.common_.existing_node) {
       return true;
     }
+    auto edge_type_scan = GenScanByEdgeType(expand);
+    if (edge_type_scan) {
+      SetOnParent(std::move(edge_type_scan));
+      return true;
+    }
     ScanAll dst_scan(expand.input(), expand.common_.node_symbol, expand.view_);
     auto indexed_scan = GenScanByIndex(dst_scan, FLAGS_query_vertex_count_to_expand_existing);
     if (indexed_scan) {
@@ -271,6 +280,24 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByLabelProperties &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByLabelProperties &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(ScanAllByText &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByText &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ScanAllById &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -280,6 +307,15 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByEdgeType &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ScanAllByEdgeType &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ConstructNamedPath &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -443,6 +479,15 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(PeriodicCommit &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(PeriodicCommit &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   std::shared_ptr<LogicalOperator> new_root_;
 
  private:
@@ -463,6 +508,22 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     int64_t vertex_count;
   };
 
+  struct LabelPropertiesIndex {
+    LabelIx label;
+    std::vector<storage::PropertyId> properties;
+    // FilterInfo with an equality PropertyFilter for each of the leading
+    // properties of the index.
+    std::vector<FilterInfo> filters;
+    int64_t vertex_count;
+  };
+
+  struct TextIndex {
+    LabelIx label;
+    // FilterInfo with a STARTS WITH, ENDS WITH or CONTAINS PropertyFilter.
+    FilterInfo filter;
+    int64_t vertex_count;
+  };
+
   bool DefaultPreVisit() override { throw utils::NotYetImplemented("optimizing index lookup"); }
 
   void SetOnParent(const std::shared_ptr<LogicalOperator> &input) {
@@ -487,6 +548,28 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
 
   storage::PropertyId GetProperty(PropertyIx prop) { return db_->NameToProperty(prop.name); }
 
+  // Creates a ScanAllByEdgeType if the `expand` directly follows an unindexed
+  // ScanAll of its source node and goes over a single edge type that has an
+  // index. Scanning the index touches only the edges of that type, while
+  // ScanAll + Expand touches every vertex and every adjacency list. Returns
+  // `nullptr` if the rewrite isn't possible.
+  std::unique_ptr<ScanAllByEdgeType> GenScanByEdgeType(const Expand &expand) {
+    const auto &common = expand.common_;
+    if (common.edge_types.size() != 1U || common.direction == EdgeAtom::Direction::BOTH) return nullptr;
+    const auto &input = expand.input();
+    // Indexed scans are subtypes of ScanAll, but they should be kept.
+    if (!input || input->GetTypeInfo() != ScanAll::kType) return nullptr;
+    const auto &scan = *static_cast<const ScanAll *>(input.get());
+    if (scan.output_symbol_ != expand.input_symbol_ || scan.view_ != expand.view_) return nullptr;
+    if (!db_->EdgeTypeIndexExists(common.edge_types[0])) return nullptr;
+    if (common.direction == EdgeAtom::Direction::OUT) {
+      return std::make_unique<ScanAllByEdgeType>(scan.input(), scan.output_symbol_, common.edge_symbol,
+                                                 common.node_symbol, common.edge_types[0], expand.view_);
+    }
+    return std::make_unique<ScanAllByEdgeType>(scan.input(), common.node_symbol, common.edge_symbol,
+                                               scan.output_symbol_, common.edge_types[0], expand.view_);
+  }
+
   std::optional<LabelIx> FindBestLabelIndex(const std::unordered_set<LabelIx> &labels) {
     MG_ASSERT(!labels.empty(), "Trying to find the best label without any labels.");
     std::optional<LabelIx> best_label;
@@ -523,6 +606,11 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
           // cannot scan `n` by property index.
           continue;
         }
+        if (filter.property_filter->type_ == PropertyFilter::Type::ENDS_WITH ||
+            filter.property_filter->type_ == PropertyFilter::Type::CONTAINS) {
+          // The value index is ordered, so only a prefix can be looked up.
+          continue;
+        }
         const auto &property = filter.property_filter->property_;
         if (!db_->LabelPropertyIndexExists(GetLabel(label), GetProperty(property))) {
           continue;
@@ -531,9 +619,11 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
         auto is_better_type = [&found](PropertyFilter::Type type) {
           // Order the types by the most preferred index lookup type.
           static const PropertyFilter::Type kFilterTypeOrder[] = {
-              PropertyFilter::Type::EQUAL, PropertyFilter::Type::RANGE, PropertyFilter::Type::REGEX_MATCH};
-          auto *found_sort_ix = std::find(kFilterTypeOrder, kFilterTypeOrder + 3, found->filter.property_filter->type_);
-          auto *type_sort_ix = std::find(kFilterTypeOrder, kFilterTypeOrder + 3, type);
+              PropertyFilter::Type::EQUAL, PropertyFilter::Type::RANGE, PropertyFilter::Type::STARTS_WITH,
+              PropertyFilter::Type::REGEX_MATCH};
+          const auto *order_end = kFilterTypeOrder + std::size(kFilterTypeOrder);
+          auto *found_sort_ix = std::find(kFilterTypeOrder, order_end, found->filter.property_filter->type_);
+          auto *type_sort_ix = std::find(kFilterTypeOrder, order_end, type);
           return type_sort_ix < found_sort_ix;
         };
         if (!found || vertex_count < found->vertex_count ||
@@ -545,6 +635,78 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return found;
   }
 
+  // Finds the label+properties index whose longest prefix of properties can
+  // be looked up by equality filters. Among the indices with the same prefix
+  // length, the one which has indexed the lowest amount of vertices is chosen.
+  // If no such index can be found, nullopt is returned.
+  std::optional<LabelPropertiesIndex> FindBestLabelPropertiesIndex(const Symbol &symbol,
+                                                                   const std::unordered_set<Symbol> &bound_symbols) {
+    auto are_bound = [&bound_symbols](const auto &used_symbols) {
+      for (const auto &used_symbol : used_symbols) {
+        if (!utils::Contains(bound_symbols, used_symbol)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    const auto property_filters = filters_.PropertyFilters(symbol);
+    std::optional<LabelPropertiesIndex> found;
+    for (const auto &label : filters_.FilteredLabels(symbol)) {
+      for (auto &properties : db_->LabelPropertiesIndices(GetLabel(label))) {
+        std::vector<FilterInfo> prefix_filters;
+        for (const auto &property : properties) {
+          auto filter = std::find_if(property_filters.begin(), property_filters.end(), [&](const auto &info) {
+            const auto &property_filter = *info.property_filter;
+            return property_filter.type_ == PropertyFilter::Type::EQUAL && !property_filter.is_symbol_in_value_ &&
+                   are_bound(info.used_symbols) && GetProperty(property_filter.property_) == property;
+          });
+          if (filter == property_filters.end()) break;
+          prefix_filters.push_back(*filter);
+        }
+        if (prefix_filters.empty()) continue;
+        int64_t vertex_count = db_->VerticesCount(GetLabel(label), properties);
+        if (!found || prefix_filters.size() > found->filters.size() ||
+            (prefix_filters.size() == found->filters.size() && vertex_count < found->vertex_count)) {
+          found = LabelPropertiesIndex{label, std::move(properties), std::move(prefix_filters), vertex_count};
+        }
+      }
+    }
+    return found;
+  }
+
+  // Finds the text index with the lowest amount of indexed vertices which can
+  // look up one of the string match filters on `symbol`. If no such index can
+  // be found, nullopt is returned.
+  std::optional<TextIndex> FindBestTextIndex(const Symbol &symbol, const std::unordered_set<Symbol> &bound_symbols) {
+    auto are_bound = [&bound_symbols](const auto &used_symbols) {
+      for (const auto &used_symbol : used_symbols) {
+        if (!utils::Contains(bound_symbols, used_symbol)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    std::optional<TextIndex> found;
+    for (const auto &label : filters_.FilteredLabels(symbol)) {
+      for (const auto &filter : filters_.PropertyFilters(symbol)) {
+        const auto &property_filter = *filter.property_filter;
+        if (property_filter.type_ != PropertyFilter::Type::STARTS_WITH &&
+            property_filter.type_ != PropertyFilter::Type::ENDS_WITH &&
+            property_filter.type_ != PropertyFilter::Type::CONTAINS) {
+          continue;
+        }
+        if (property_filter.is_symbol_in_value_ || !are_bound(filter.used_symbols)) continue;
+        const auto property = GetProperty(property_filter.property_);
+        if (!db_->TextIndexExists(GetLabel(label), property)) continue;
+        int64_t vertex_count = db_->TextVerticesCount(GetLabel(label), property);
+        if (!found || vertex_count < found->vertex_count) {
+          found = TextIndex{label, filter, vertex_count};
+        }
+      }
+    }
+    return found;
+  }
+
   // Creates a ScanAll by the best possible index for the `node_symbol`. Best
   // index is defined as the index with least number of vertices. If the node
   // does not have at least a label, no indexed lookup can be created and
@@ -585,15 +747,40 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
       return nullptr;
     }
     auto found_index = FindBestLabelPropertyIndex(node_symbol, bound_symbols);
+    auto found_composite_index = FindBestLabelPropertiesIndex(node_symbol, bound_symbols);
+    // The label+properties index is used if it can match more than one
+    // property at once, or if there is no label+property index to use.
+    if (found_composite_index && (found_composite_index->filters.size() > 1U || !found_index) &&
+        (!max_vertex_count || *max_vertex_count >= found_composite_index->vertex_count)) {
+      std::vector<Expression *> expressions;
+      expressions.reserve(found_composite_index->filters.size());
+      for (const auto &filter : found_composite_index->filters) {
+        expressions.push_back(filter.property_filter->value_);
+        filter_exprs_for_removal_.insert(filter.expression);
+        filters_.EraseFilter(filter);
+      }
+      std::vector<Expression *> removed_expressions;
+      filters_.EraseLabelFilter(node_symbol, found_composite_index->label, &removed_expressions);
+      filter_exprs_for_removal_.insert(removed_expressions.begin(), removed_expressions.end());
+      std::vector<std::string> property_names;
+      property_names.reserve(found_composite_index->properties.size());
+      for (const auto &property : found_composite_index->properties) {
+        property_names.push_back(db_->PropertyToName(property));
+      }
+      return std::make_unique<ScanAllByLabelProperties>(input, node_symbol, GetLabel(found_composite_index->label),
+                                                        std::move(found_composite_index->properties),
+                                                        std::move(property_names), std::move(expressions), view);
+    }
     if (found_index &&
         // Use label+property index if we satisfy max_vertex_count.
         (!max_vertex_count || *max_vertex_count >= found_index->vertex_count)) {
       // Copy the property filter and then erase it from filters.
       const auto prop_filter = *found_index->filter.property_filter;
-      if (prop_filter.type_ != PropertyFilter::Type::REGEX_MATCH) {
+      if (prop_filter.type_ != PropertyFilter::Type::REGEX_MATCH &&
+          prop_filter.type_ != PropertyFilter::Type::STARTS_WITH) {
         // Remove the original expression from Filter operation only if it's not
-        // a regex match. In such a case we need to perform the matching even
-        // after we've scanned the index.
+        // a regex or prefix match. In such a case we need to perform the
+        // matching even after we've scanned the index.
         filter_exprs_for_removal_.insert(found_index->filter.expression);
       }
       filters_.EraseFilter(found_index->filter);
@@ -611,6 +798,13 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
         return std::make_unique<ScanAllByLabelPropertyRange>(
             input, node_symbol, GetLabel(found_index->label), GetProperty(prop_filter.property_),
             prop_filter.property_.name, std::make_optional(lower_bound), std::nullopt, view);
+      } else if (prop_filter.type_ == PropertyFilter::Type::STARTS_WITH) {
+        // The scan checks the type of the prefix and computes the upper bound
+        // of the strings starting with it once the prefix is evaluated.
+        return std::make_unique<ScanAllByLabelPropertyRange>(
+            input, node_symbol, GetLabel(found_index->label), GetProperty(prop_filter.property_),
+            prop_filter.property_.name, std::make_optional(utils::MakeBoundInclusive(prop_filter.value_)),
+            std::nullopt, view, true);
       } else if (prop_filter.type_ == PropertyFilter::Type::IN) {
         // TODO(buda): ScanAllByLabelProperty + Filter should be considered
         // here once the operator and the right cardinality estimation exist.
@@ -632,6 +826,21 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
                                                              prop_filter.property_.name, prop_filter.value_, view);
       }
     }
+    auto found_text_index = FindBestTextIndex(node_symbol, bound_symbols);
+    if (found_text_index &&
+        // Use the text index if we satisfy max_vertex_count.
+        (!max_vertex_count || *max_vertex_count >= found_text_index->vertex_count)) {
+      // The text index only returns candidates, so the original expression is
+      // kept in the Filter operation to check the actual match.
+      const auto prop_filter = *found_text_index->filter.property_filter;
+      filters_.EraseFilter(found_text_index->filter);
+      std::vector<Expression *> removed_expressions;
+      filters_.EraseLabelFilter(node_symbol, found_text_index->label, &removed_expressions);
+      filter_exprs_for_removal_.insert(removed_expressions.begin(), removed_expressions.end());
+      return std::make_unique<ScanAllByText>(input, node_symbol, GetLabel(found_text_index->label),
+                                             GetProperty(prop_filter.property_), prop_filter.property_.name,
+                                             prop_filter.value_, view);
+    }
     auto maybe_label = FindBestLabelIndex(labels);
     if (!maybe_label) return nullptr;
     const auto &label = *maybe_label;
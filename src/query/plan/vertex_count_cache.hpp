@@ -12,7 +12,11 @@
 /// @file
 #pragma once
 
+#include <map>
 #include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "query/typed_value.hpp"
 #include "storage/v2/id_types.hpp"
@@ -32,6 +36,7 @@ class VertexCountCache {
   auto NameToLabel(const std::string &name) { return db_->NameToLabel(name); }
   auto NameToProperty(const std::string &name) { return db_->NameToProperty(name); }
   auto NameToEdgeType(const std::string &name) { return db_->NameToEdgeType(name); }
+  auto PropertyToName(storage::PropertyId property) { return db_->PropertyToName(property); }
 
   int64_t VerticesCount() {
     if (!vertices_count_) vertices_count_ = db_->VerticesCount();
@@ -72,12 +77,60 @@ class VertexCountCache {
     return bounds_vertex_count.at(bounds);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties) {
+    auto key = std::make_pair(label, properties);
+    auto found = label_properties_vertex_count_.find(key);
+    if (found == label_properties_vertex_count_.end())
+      found = label_properties_vertex_count_.emplace(key, db_->VerticesCount(label, properties)).first;
+    return found->second;
+  }
+
+  // The counts of prefix lookups aren't memoized, since they are only used
+  // when all of the prefix values are constants.
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix) {
+    return db_->VerticesCount(label, properties, prefix);
+  }
+
+  int64_t TextVerticesCount(storage::LabelId label, storage::PropertyId property) {
+    auto key = std::make_pair(label, property);
+    if (text_vertex_count_.find(key) == text_vertex_count_.end())
+      text_vertex_count_[key] = db_->TextVerticesCount(label, property);
+    return text_vertex_count_.at(key);
+  }
+
+  // Like the prefix counts, the counts of text lookups are only used for
+  // constant needles and aren't memoized.
+  int64_t TextVerticesCount(storage::LabelId label, storage::PropertyId property, std::string_view text) {
+    return db_->TextVerticesCount(label, property, text);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) {
+    if (edge_type_edge_count_.find(edge_type) == edge_type_edge_count_.end())
+      edge_type_edge_count_[edge_type] = db_->EdgesCount(edge_type);
+    return edge_type_edge_count_.at(edge_type);
+  }
+
   bool LabelIndexExists(storage::LabelId label) { return db_->LabelIndexExists(label); }
 
   bool LabelPropertyIndexExists(storage::LabelId label, storage::PropertyId property) {
     return db_->LabelPropertyIndexExists(label, property);
   }
 
+  bool LabelPropertiesIndexExists(storage::LabelId label, const std::vector<storage::PropertyId> &properties) {
+    return db_->LabelPropertiesIndexExists(label, properties);
+  }
+
+  std::vector<std::vector<storage::PropertyId>> LabelPropertiesIndices(storage::LabelId label) {
+    return db_->LabelPropertiesIndices(label);
+  }
+
+  bool TextIndexExists(storage::LabelId label, storage::PropertyId property) {
+    return db_->TextIndexExists(label, property);
+  }
+
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) { return db_->EdgeTypeIndexExists(edge_type); }
+
  private:
   typedef std::pair<storage::LabelId, storage::PropertyId> LabelPropertyKey;
 
@@ -130,6 +183,9 @@ class VertexCountCache {
   std::unordered_map<LabelPropertyKey, std::unordered_map<BoundsKey, int64_t, BoundsHash, BoundsEqual>,
                      LabelPropertyHash>
       property_bounds_vertex_count_;
+  std::map<std::pair<storage::LabelId, std::vector<storage::PropertyId>>, int64_t> label_properties_vertex_count_;
+  std::unordered_map<LabelPropertyKey, int64_t, LabelPropertyHash> text_vertex_count_;
+  std::unordered_map<storage::EdgeTypeId, int64_t> edge_type_edge_count_;
 };
 
 template <class TDbAccessor>
@@ -1585,6 +1585,8 @@ mgp_error mgp_vertex_set_property(struct mgp_vertex *v, const char *property_nam
     const auto result = v->impl.SetProperty(prop_key, ToPropertyValue(*property_value));
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::DELETED_OBJECT:
           throw DeletedObjectException{"Cannot set the properties of a deleted vertex!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
@@ -1626,6 +1628,8 @@ mgp_error mgp_vertex_add_label(struct mgp_vertex *v, mgp_label label) {
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::DELETED_OBJECT:
           throw DeletedObjectException{"Cannot add a label to a deleted vertex!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
@@ -1658,6 +1662,8 @@ mgp_error mgp_vertex_remove_label(struct mgp_vertex *v, mgp_label label) {
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::DELETED_OBJECT:
           throw DeletedObjectException{"Cannot remove a label from a deleted vertex!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
@@ -1703,6 +1709,7 @@ mgp_error mgp_vertex_labels_count(mgp_vertex *v, size_t *result) {
               throw DeletedObjectException{"Cannot get the labels of a deleted vertex!"};
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               LOG_FATAL("Query modules shouldn't have access to nonexistent objects when getting vertex labels!");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1725,6 +1732,7 @@ mgp_error mgp_vertex_label_at(mgp_vertex *v, size_t i, mgp_label *result) {
               throw DeletedObjectException{"Cannot get a label of a deleted vertex!"};
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               LOG_FATAL("Query modules shouldn't have access to nonexistent objects when getting a label of a vertex!");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1760,6 +1768,7 @@ mgp_error mgp_vertex_has_label_named(mgp_vertex *v, const char *name, int *resul
                   "Query modules shouldn't have access to nonexistent objects when checking the existence of a label "
                   "on "
                   "a vertex!");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1787,6 +1796,7 @@ mgp_error mgp_vertex_get_property(mgp_vertex *v, const char *name, mgp_memory *m
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting a property of a vertex.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1814,6 +1824,7 @@ mgp_error mgp_vertex_iter_properties(mgp_vertex *v, mgp_memory *memory, mgp_prop
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting the properties of a "
                   "vertex.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1842,6 +1853,7 @@ mgp_error mgp_vertex_iter_in_edges(mgp_vertex *v, mgp_memory *memory, mgp_edges_
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting the inbound edges of a "
                   "vertex.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1874,6 +1886,7 @@ mgp_error mgp_vertex_iter_out_edges(mgp_vertex *v, mgp_memory *memory, mgp_edges
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting the outbound edges of a "
                   "vertex.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -1988,6 +2001,7 @@ mgp_error mgp_edge_get_property(mgp_edge *e, const char *name, mgp_memory *memor
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting a property of an edge.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -2009,6 +2023,8 @@ mgp_error mgp_edge_set_property(struct mgp_edge *e, const char *property_name, m
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::DELETED_OBJECT:
           throw DeletedObjectException{"Cannot set the properties of a deleted edge!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
@@ -2057,6 +2073,7 @@ mgp_error mgp_edge_iter_properties(mgp_edge *e, mgp_memory *memory, mgp_properti
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
               LOG_FATAL(
                   "Query modules shouldn't have access to nonexistent objects when getting the properties of an edge.");
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
             case memgraph::storage::Error::PROPERTIES_DISABLED:
             case memgraph::storage::Error::VERTEX_HAS_EDGES:
             case memgraph::storage::Error::SERIALIZATION_ERROR:
@@ -2113,6 +2130,8 @@ mgp_error mgp_graph_delete_vertex(struct mgp_graph *graph, mgp_vertex *vertex) {
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
           LOG_FATAL("Query modules shouldn't have access to nonexistent objects when removing a vertex!");
         case memgraph::storage::Error::DELETED_OBJECT:
@@ -2148,6 +2167,8 @@ mgp_error mgp_graph_detach_delete_vertex(struct mgp_graph *graph, mgp_vertex *ve
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
           LOG_FATAL("Query modules shouldn't have access to nonexistent objects when removing a vertex!");
         case memgraph::storage::Error::DELETED_OBJECT:
@@ -2195,6 +2216,8 @@ mgp_error mgp_graph_create_edge(mgp_graph *graph, mgp_vertex *from, mgp_vertex *
         auto edge = graph->impl->InsertEdge(&from->impl, &to->impl, from->graph->impl->NameToEdgeType(type.name));
         if (edge.HasError()) {
           switch (edge.GetError()) {
+            case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+              throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
             case memgraph::storage::Error::DELETED_OBJECT:
               throw DeletedObjectException{"Cannot add an edge to a deleted vertex!"};
             case memgraph::storage::Error::NONEXISTENT_OBJECT:
@@ -2227,6 +2250,8 @@ mgp_error mgp_graph_delete_edge(struct mgp_graph *graph, mgp_edge *edge) {
 
     if (result.HasError()) {
       switch (result.GetError()) {
+        case memgraph::storage::Error::READ_ONLY_TRANSACTION:
+          throw ImmutableObjectException{"Cannot modify the graph in a read-only transaction!"};
         case memgraph::storage::Error::NONEXISTENT_OBJECT:
           LOG_FATAL("Query modules shouldn't have access to nonexistent objects when removing an edge!");
         case memgraph::storage::Error::DELETED_OBJECT:
@@ -0,0 +1,156 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/stream/batched_query.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include "query/exceptions.hpp"
+#include "query/frontend/ast/ast.hpp"
+#include "query/frontend/ast/ast_visitor.hpp"
+#include "query/frontend/ast/cypher_main_visitor.hpp"
+#include "query/frontend/opencypher/parser.hpp"
+#include "query/frontend/stripped.hpp"
+
+namespace memgraph::query::stream {
+namespace {
+constexpr std::string_view kBatchRowName{"__mg_stream_row"};
+
+bool IsParameterName(std::string_view name) {
+  if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) return false;
+  return std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+}
+
+// Clauses which behave the same inside an UNWIND as when the rows are executed
+// one after the other.
+bool IsBatchableClause(const Clause &clause) {
+  const auto &type = clause.GetTypeInfo();
+  return type == Create::kType || type == Merge::kType || type == SetProperty::kType ||
+         type == SetProperties::kType || type == SetLabels::kType || type == RemoveProperty::kType ||
+         type == RemoveLabels::kType;
+}
+
+// Collects the parameters which are used as expressions and finds the ones
+// which are used as the properties of a pattern, e.g. `(n $props)`.
+class ParameterUsageCollector : public HierarchicalTreeVisitor {
+ public:
+  using HierarchicalTreeVisitor::PostVisit;
+  using HierarchicalTreeVisitor::PreVisit;
+  using HierarchicalTreeVisitor::Visit;
+
+  bool PreVisit(NodeAtom &node_atom) override {
+    if (std::holds_alternative<ParameterLookup *>(node_atom.properties_)) has_pattern_parameters_ = true;
+    return !has_pattern_parameters_;
+  }
+
+  bool PreVisit(EdgeAtom &edge_atom) override {
+    if (std::holds_alternative<ParameterLookup *>(edge_atom.properties_)) has_pattern_parameters_ = true;
+    return !has_pattern_parameters_;
+  }
+
+  bool Visit(Identifier & /*unused*/) override { return true; }
+  bool Visit(PrimitiveLiteral & /*unused*/) override { return true; }
+  bool Visit(ParameterLookup &parameter) override {
+    expression_parameters_.insert(parameter.token_position_);
+    return true;
+  }
+
+  bool HasPatternParameters() const { return has_pattern_parameters_; }
+  bool IsExpressionParameter(int token_position) const { return expression_parameters_.contains(token_position); }
+
+ private:
+  bool has_pattern_parameters_{false};
+  std::unordered_set<int> expression_parameters_;
+};
+
+// Parses the stripped query and checks the clauses and the parameters of the
+// resulting AST.
+bool IsBatchable(const frontend::StrippedQuery &stripped, utils::SpinLock *antlr_lock) {
+  std::unique_ptr<frontend::opencypher::Parser> parser;
+  {
+    std::lock_guard<utils::SpinLock> guard(*antlr_lock);
+    parser = std::make_unique<frontend::opencypher::Parser>(stripped.query());
+  }
+  AstStorage ast_storage;
+  frontend::ParsingContext context{.is_query_cached = true};
+  frontend::CypherMainVisitor visitor(context, &ast_storage);
+  visitor.visit(parser->tree());
+
+  auto *cypher_query = utils::Downcast<CypherQuery>(visitor.query());
+  // `USING PERIODIC COMMIT` has to stay at the beginning of the query, and
+  // EXPLAIN, PROFILE and the other query types aren't Cypher queries.
+  if (!cypher_query || !cypher_query->cypher_unions_.empty() || cypher_query->periodic_commit_frequency_) {
+    return false;
+  }
+  const auto &clauses = cypher_query->single_query_->clauses_;
+  if (clauses.empty() ||
+      (clauses.front()->GetTypeInfo() != Create::kType && clauses.front()->GetTypeInfo() != Merge::kType)) {
+    return false;
+  }
+  ParameterUsageCollector collector;
+  for (auto *clause : clauses) {
+    if (!IsBatchableClause(*clause)) return false;
+    clause->Accept(collector);
+  }
+  if (collector.HasPatternParameters()) return false;
+  return std::all_of(stripped.parameters().begin(), stripped.parameters().end(), [&](const auto &parameter) {
+    return IsParameterName(parameter.second) && collector.IsExpressionParameter(parameter.first);
+  });
+}
+}  // namespace
+
+std::optional<BatchedQuery> MakeBatchedQuery(const std::string &query, utils::SpinLock *antlr_lock) {
+  if (query.find(kBatchRowName) != std::string::npos || query.find(kBatchParameterName) != std::string::npos) {
+    return std::nullopt;
+  }
+  try {
+    frontend::StrippedQuery stripped(query);
+    // The parameters are replaced in the original text, so every `$` has to
+    // start a parameter. Otherwise it's inside a string literal or a comment.
+    const auto num_parameters = stripped.parameters().size();
+    if (static_cast<size_t>(std::count(query.begin(), query.end(), '$')) != num_parameters ||
+        !IsBatchable(stripped, antlr_lock)) {
+      return std::nullopt;
+    }
+  } catch (const QueryException &) {
+    // The query will fail with the same error when it's executed on its own.
+    return std::nullopt;
+  }
+
+  BatchedQuery batched;
+  batched.query = fmt::format("UNWIND ${} AS {} ", kBatchParameterName, kBatchRowName);
+  batched.query.reserve(query.size() + batched.query.size());
+  for (size_t i = 0; i < query.size();) {
+    if (query[i] != '$') {
+      batched.query.push_back(query[i++]);
+      continue;
+    }
+    auto end = i + 1;
+    while (end < query.size() && (std::isalnum(static_cast<unsigned char>(query[end])) || query[end] == '_')) ++end;
+    auto name = query.substr(i + 1, end - i - 1);
+    // Escaped parameter names, e.g. $`name`, aren't rewritten.
+    if (name.empty()) return std::nullopt;
+    batched.query.append(kBatchRowName).append(".").append(name);
+    if (std::find(batched.parameters.begin(), batched.parameters.end(), name) == batched.parameters.end()) {
+      batched.parameters.push_back(std::move(name));
+    }
+    i = end;
+  }
+  return batched;
+}
+
+}  // namespace memgraph::query::stream
@@ -0,0 +1,52 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/spin_lock.hpp"
+
+namespace memgraph::query::stream {
+
+/// Name of the list parameter which holds the parameter maps of the batched
+/// rows.
+inline constexpr std::string_view kBatchParameterName{"__mg_stream_batch"};
+
+struct BatchedQuery {
+  /// The query that is executed once for all the rows.
+  std::string query;
+  /// Names of the parameters used by the original query. Every row of the
+  /// batch has to provide all of them.
+  std::vector<std::string> parameters;
+};
+
+/// Rewrites `query` into `UNWIND $__mg_stream_batch AS row <query>` where
+/// every `$param` is replaced with `row.param`, so the transformation results
+/// that share the same query text can be executed with a single query.
+///
+/// The query is parsed and only rewritten if its effect is the same when the
+/// rows are executed one after the other and when they are executed inside an
+/// UNWIND. Every clause of the query has to be a CREATE, MERGE, SET or REMOVE
+/// and the first one a CREATE or a MERGE, so the query neither reads the graph
+/// with the OLD view (MATCH) nor projects, reorders or deletes rows. The
+/// parameters can only be used as expressions, e.g. `(n $props)` can't be
+/// rewritten.
+///
+/// @param antlr_lock The lock which guards the ANTLR parser, see
+///                   `InterpreterContext::antlr_lock`.
+/// @return std::nullopt if the query can't be batched.
+std::optional<BatchedQuery> MakeBatchedQuery(const std::string &query, utils::SpinLock *antlr_lock);
+
+}  // namespace memgraph::query::stream
@@ -11,14 +11,25 @@
 
 #include "query/stream/streams.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include <spdlog/spdlog.h>
 #include <json/json.hpp>
 
 #include "integrations/constants.hpp"
+#include "integrations/kafka/exceptions.hpp"
 #include "mg_procedure.h"
 #include "query/db_accessor.hpp"
 #include "query/discard_value_stream.hpp"
@@ -27,6 +38,7 @@
 #include "query/procedure/mg_procedure_helpers.hpp"
 #include "query/procedure/mg_procedure_impl.hpp"
 #include "query/procedure/module.hpp"
+#include "query/stream/batched_query.hpp"
 #include "query/stream/sources.hpp"
 #include "query/typed_value.hpp"
 #include "utils/event_counter.hpp"
@@ -34,16 +46,22 @@
 #include "utils/memory.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/pmr/string.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/variant_helpers.hpp"
 
 namespace EventCounter {
 extern const Event MessagesConsumed;
+extern const Event StreamQueriesExecuted;
+extern const Event StreamRowsBatched;
 }  // namespace EventCounter
 
 namespace memgraph::query::stream {
 namespace {
 inline constexpr auto kExpectedTransformationResultSize = 2;
 inline constexpr auto kCheckStreamResultSize = 2;
+// Number of distinct query texts for which a worker remembers whether they can
+// be batched.
+inline constexpr size_t kMaxCachedBatchedQueries = 256;
 const utils::pmr::string query_param_name{"query", utils::NewDeleteResource()};
 const utils::pmr::string params_param_name{"parameters", utils::NewDeleteResource()};
 
@@ -82,7 +100,16 @@ std::pair<TypedValue /*query*/, TypedValue /*parameters*/> ExtractTransformation
 }
 
 template <typename TMessage>
-void CallCustomTransformation(const std::string &transformation_name, const std::vector<TMessage> &messages,
+std::vector<const TMessage *> MessagePointers(const std::vector<TMessage> &messages) {
+  std::vector<const TMessage *> pointers;
+  pointers.reserve(messages.size());
+  std::transform(messages.begin(), messages.end(), std::back_inserter(pointers),
+                 [](const TMessage &message) { return &message; });
+  return pointers;
+}
+
+template <typename TMessage>
+void CallCustomTransformation(const std::string &transformation_name, const std::vector<const TMessage *> &messages,
                               mgp_result &result, storage::Storage::Accessor &storage_accessor,
                               utils::MemoryResource &memory_resource, const std::string &stream_name) {
   DbAccessor db_accessor{&storage_accessor};
@@ -96,7 +123,7 @@ void CallCustomTransformation(const std::string &transformation_name, const std:
     const auto &trans = *maybe_transformation->second;
     mgp_messages mgp_messages{mgp_messages::storage_type{&memory_resource}};
     std::transform(messages.begin(), messages.end(), std::back_inserter(mgp_messages.messages),
-                   [](const TMessage &message) { return mgp_message{message}; });
+                   [](const TMessage *message) { return mgp_message{*message}; });
     mgp_graph graph{&db_accessor, storage::View::OLD, nullptr};
     mgp_memory memory{&memory_resource};
     result.rows.clear();
@@ -115,6 +142,242 @@ void CallCustomTransformation(const std::string &transformation_name, const std:
   }
 }
 
+struct ConsumerContext {
+  InterpreterContext *interpreter_context;
+  std::string stream_name;
+  std::string transformation_name;
+  std::optional<std::string> owner;
+  uint32_t total_retries;
+  std::chrono::milliseconds retry_interval;
+  bool batch_queries;
+};
+
+/// Interpreter and transformation result used by one thread of a stream
+/// consumer.
+struct ConsumerWorker {
+  explicit ConsumerWorker(InterpreterContext *interpreter_context) : interpreter{interpreter_context} {}
+
+  Interpreter interpreter;
+  mgp_result result{nullptr, utils::NewDeleteResource()};
+  // Result of `MakeBatchedQuery` for the query texts the transformation
+  // returned, so each query is parsed only once.
+  std::unordered_map<std::string, std::optional<BatchedQuery>> batched_queries;
+};
+
+/// Workers of a stream consumer. When the partitions of a batch are processed
+/// in parallel, the first worker runs on the consumer thread and the others on
+/// `pool`, which is created with the first such batch and kept for the
+/// following ones.
+struct ConsumerWorkers {
+  std::vector<std::unique_ptr<ConsumerWorker>> workers;
+  std::unique_ptr<utils::ThreadPool> pool;
+};
+
+/// Consecutive transformation results with the same query text.
+struct QueryGroup {
+  std::string query;
+  std::vector<storage::PropertyValue> parameters;
+};
+
+std::vector<QueryGroup> GroupTransformationResults(const mgp_result &result, const ConsumerContext &context) {
+  std::vector<QueryGroup> groups;
+  for (const auto &row : result.rows) {
+    auto [query_value, params_value] =
+        ExtractTransformationResult(row.values, context.transformation_name, context.stream_name);
+    const std::string_view query{query_value.ValueString()};
+    if (groups.empty() || groups.back().query != query) {
+      groups.push_back(QueryGroup{.query = std::string{query}, .parameters = {}});
+    }
+    groups.back().parameters.emplace_back(params_value);
+  }
+  return groups;
+}
+
+void ExecuteQuery(Interpreter &interpreter, const ConsumerContext &context, const std::string &query,
+                  const std::map<std::string, storage::PropertyValue> &params, const std::string &original_query) {
+  spdlog::trace("Executing query '{}' in stream '{}'", query, context.stream_name);
+  auto prepare_result = interpreter.Prepare(query, params, nullptr);
+  if (!context.interpreter_context->auth_checker->IsUserAuthorized(context.owner, prepare_result.privileges)) {
+    throw StreamsException{
+        "Couldn't execute query '{}' for stream '{}' because the owner is not authorized to execute the "
+        "query!",
+        original_query, context.stream_name};
+  }
+  DiscardValueResultStream stream;
+  interpreter.PullAll(&stream);
+  EventCounter::IncrementCounter(EventCounter::StreamQueriesExecuted);
+}
+
+const std::optional<BatchedQuery> &FindBatchedQuery(ConsumerWorker &worker, const ConsumerContext &context,
+                                                    const std::string &query) {
+  if (auto it = worker.batched_queries.find(query); it != worker.batched_queries.end()) {
+    return it->second;
+  }
+  if (worker.batched_queries.size() == kMaxCachedBatchedQueries) {
+    worker.batched_queries.clear();
+  }
+  return worker.batched_queries.emplace(query, MakeBatchedQuery(query, &context.interpreter_context->antlr_lock))
+      .first->second;
+}
+
+/// Executes the queries of a group and returns the number of executed queries.
+/// When the query allows it, all the rows of the group are executed with a
+/// single UNWIND query instead of one query per row.
+uint64_t ExecuteQueryGroup(ConsumerWorker &worker, const ConsumerContext &context, const QueryGroup &group) {
+  auto &interpreter = worker.interpreter;
+  const auto parameters_map = [](const storage::PropertyValue &params) -> const auto & {
+    return params.IsNull() ? empty_parameters : params.ValueMap();
+  };
+  if (context.batch_queries && group.parameters.size() > 1) {
+    const auto &batched = FindBatchedQuery(worker, context, group.query);
+    // A missing parameter is an error when the query is executed on its own,
+    // so such groups are executed row by row to report it.
+    const auto provides_all = [&](const auto &params) {
+      return std::all_of(batched->parameters.begin(), batched->parameters.end(),
+                         [&](const auto &name) { return parameters_map(params).contains(name); });
+    };
+    if (batched && std::all_of(group.parameters.begin(), group.parameters.end(), provides_all)) {
+      std::vector<storage::PropertyValue> batch;
+      batch.reserve(group.parameters.size());
+      for (const auto &params : group.parameters) {
+        batch.emplace_back(parameters_map(params));
+      }
+      ExecuteQuery(interpreter, context, batched->query,
+                   {{std::string{kBatchParameterName}, storage::PropertyValue(std::move(batch))}}, group.query);
+      EventCounter::IncrementCounter(EventCounter::StreamRowsBatched, group.parameters.size());
+      return 1;
+    }
+  }
+  for (const auto &params : group.parameters) {
+    ExecuteQuery(interpreter, context, group.query, parameters_map(params), group.query);
+  }
+  return group.parameters.size();
+}
+
+/// Transforms the messages and executes the resulting queries in a single
+/// transaction, retrying on serialization errors. Returns the number of
+/// executed queries.
+template <typename TMessage>
+uint64_t TransformAndExecute(const std::vector<const TMessage *> &messages, ConsumerWorker &worker,
+                             const ConsumerContext &context) {
+  auto *memory_resource = utils::NewDeleteResource();
+  auto accessor = context.interpreter_context->db->Access();
+  CallCustomTransformation(context.transformation_name, messages, worker.result, accessor, *memory_resource,
+                           context.stream_name);
+
+  spdlog::trace("Start transaction in stream '{}'", context.stream_name);
+  utils::OnScopeExit cleanup{[&worker]() {
+    worker.result.rows.clear();
+    worker.interpreter.Abort();
+  }};
+
+  auto groups = GroupTransformationResults(worker.result, context);
+  uint32_t i = 0;
+  while (true) {
+    try {
+      uint64_t executed_queries = 0;
+      worker.interpreter.BeginTransaction();
+      for (const auto &group : groups) {
+        executed_queries += ExecuteQueryGroup(worker, context, group);
+      }
+
+      spdlog::trace("Commit transaction in stream '{}'", context.stream_name);
+      worker.interpreter.CommitTransaction();
+      return executed_queries;
+    } catch (const query::TransactionSerializationException &e) {
+      worker.interpreter.Abort();
+      if (i == context.total_retries) {
+        throw;
+      }
+      ++i;
+      std::this_thread::sleep_for(context.retry_interval);
+    }
+  }
+}
+
+/// Splits the messages by the topic and the partition they were consumed from,
+/// keeping the order of the messages inside each partition.
+std::vector<std::vector<const integrations::kafka::Message *>> SplitByPartition(
+    const std::vector<integrations::kafka::Message> &messages) {
+  std::map<std::pair<std::string_view, int32_t>, std::vector<const integrations::kafka::Message *>> partitions;
+  for (const auto &message : messages) {
+    partitions[{message.TopicName(), message.Partition()}].push_back(&message);
+  }
+  std::vector<std::vector<const integrations::kafka::Message *>> result;
+  result.reserve(partitions.size());
+  for (auto &[partition, partition_messages] : partitions) {
+    result.push_back(std::move(partition_messages));
+  }
+  return result;
+}
+
+/// Processes each partition in its own transaction on one of the first
+/// `num_workers` workers. The workers pick partitions until all of them are
+/// processed. Returns the number of executed queries.
+///
+/// @throw integrations::kafka::BatchPartiallyProcessedException if processing
+///        a partition failed after other partitions were already committed.
+uint64_t TransformAndExecuteInParallel(const std::vector<std::vector<const integrations::kafka::Message *>> &partitions,
+                                       ConsumerWorkers &workers, size_t num_workers, const ConsumerContext &context) {
+  MG_ASSERT(num_workers > 1 && num_workers <= workers.workers.size() && workers.pool);
+  std::atomic<size_t> next_partition{0};
+  std::atomic<uint64_t> executed_queries{0};
+  std::vector<std::exception_ptr> errors(num_workers);
+  // Not std::vector<bool>, because the partitions are marked from different
+  // threads.
+  std::vector<uint8_t> committed(partitions.size(), 0);
+  auto work = [&](size_t worker_id) {
+    try {
+      for (auto i = next_partition.fetch_add(1); i < partitions.size(); i = next_partition.fetch_add(1)) {
+        executed_queries += TransformAndExecute(partitions[i], *workers.workers[worker_id], context);
+        committed[i] = 1;
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+      // Stop the other workers from starting new partitions.
+      next_partition = partitions.size();
+    }
+  };
+
+  std::mutex lock;
+  std::condition_variable cv;
+  size_t running = num_workers - 1;
+  for (size_t worker_id = 1; worker_id < num_workers; ++worker_id) {
+    workers.pool->AddTask([&, worker_id] {
+      work(worker_id);
+      std::lock_guard<std::mutex> guard(lock);
+      --running;
+      cv.notify_one();
+    });
+  }
+  work(0);
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [&] { return running == 0; });
+  }
+
+  auto error = std::find_if(errors.begin(), errors.end(), [](const auto &error) { return error != nullptr; });
+  if (error == errors.end()) return executed_queries;
+  if (std::none_of(committed.begin(), committed.end(), [](auto is_committed) { return is_committed; })) {
+    std::rethrow_exception(*error);
+  }
+  // The offsets of the whole batch aren't committed, so the committed
+  // partitions are reported to the consumer to avoid executing them again.
+  std::vector<integrations::kafka::BatchPartiallyProcessedException::PartitionOffset> processed;
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    if (!committed[i]) continue;
+    const auto &last_message = *partitions[i].back();
+    processed.push_back({.topic = std::string{last_message.TopicName()},
+                         .partition = last_message.Partition(),
+                         .offset = last_message.Offset() + 1});
+  }
+  try {
+    std::rethrow_exception(*error);
+  } catch (const std::exception &e) {
+    throw integrations::kafka::BatchPartiallyProcessedException(e.what(), std::move(processed));
+  }
+}
+
 template <Stream TStream>
 StreamStatus<TStream> CreateStatus(std::string stream_name, std::string transformation_name,
                                    std::optional<std::string> owner, const TStream &stream) {
@@ -169,6 +432,58 @@ Streams::Streams(InterpreterContext *interpreter_context, std::filesystem::path
 void Streams::RegisterProcedures() {
   RegisterKafkaProcedures();
   RegisterPulsarProcedures();
+  RegisterStatsProcedure();
+}
+
+void Streams::RegisterStatsProcedure() {
+  static constexpr std::string_view proc_name = "stream_stats";
+
+  static constexpr std::string_view messages_result_name = "messages";
+  static constexpr std::string_view batches_result_name = "batches";
+  static constexpr std::string_view queries_result_name = "queries";
+  static constexpr std::string_view last_batch_duration_result_name = "last_batch_duration_ms";
+  static constexpr std::string_view lag_result_name = "lag_ms";
+  static constexpr std::array result_names{messages_result_name, batches_result_name, queries_result_name,
+                                           last_batch_duration_result_name, lag_result_name};
+
+  auto get_stream_stats = [this](mgp_list *args, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory) {
+    auto *arg_stream_name = procedure::Call<mgp_value *>(mgp_list_at, args, 0);
+    const auto *stream_name = procedure::Call<const char *>(mgp_value_get_string, arg_stream_name);
+    std::shared_ptr<StreamStats> stats;
+    {
+      auto lock_ptr = streams_.ReadLock();
+      auto it = GetStream(*lock_ptr, std::string(stream_name));
+      stats = std::visit([](const auto &stream_data) { return stream_data.stats; }, it->second);
+    }
+
+    mgp_result_record *record{nullptr};
+    if (!procedure::TryOrSetError([&] { return mgp_result_new_record(result, &record); }, result)) {
+      return;
+    }
+    const std::array<int64_t, result_names.size()> values{
+        static_cast<int64_t>(stats->messages.load()), static_cast<int64_t>(stats->batches.load()),
+        static_cast<int64_t>(stats->queries.load()), stats->last_batch_duration_ms.load(), stats->lag_ms.load()};
+    for (size_t i = 0; i < result_names.size(); ++i) {
+      procedure::MgpUniquePtr<mgp_value> value{nullptr, mgp_value_destroy};
+      if (!procedure::TryOrSetError(
+              [&] { return procedure::CreateMgpObject(value, mgp_value_make_int, values[i], memory); }, result)) {
+        return;
+      }
+      if (!procedure::InsertResultOrSetError(result, record, result_names[i].data(), value.get())) {
+        return;
+      }
+    }
+  };
+
+  mgp_proc proc(proc_name, get_stream_stats, utils::NewDeleteResource());
+  MG_ASSERT(mgp_proc_add_arg(&proc, "stream_name", procedure::Call<mgp_type *>(mgp_type_string)) ==
+            mgp_error::MGP_ERROR_NO_ERROR);
+  for (const auto result_name : result_names) {
+    MG_ASSERT(mgp_proc_add_result(&proc, result_name.data(), procedure::Call<mgp_type *>(mgp_type_int)) ==
+              mgp_error::MGP_ERROR_NO_ERROR);
+  }
+
+  procedure::gModuleRegistry.RegisterMgProcedure(proc_name, std::move(proc));
 }
 
 void Streams::RegisterKafkaProcedures() {
@@ -480,69 +795,63 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
     throw StreamsException{"Stream already exists with name '{}'", stream_name};
   }
 
-  auto *memory_resource = utils::NewDeleteResource();
-
-  auto consumer_function = [interpreter_context = interpreter_context_, memory_resource, stream_name,
-                            transformation_name = stream_info.common_info.transformation_name, owner = owner,
-                            interpreter = std::make_shared<Interpreter>(interpreter_context_),
-                            result = mgp_result{nullptr, memory_resource},
-                            total_retries = interpreter_context_->config.stream_transaction_conflict_retries,
-                            retry_interval = interpreter_context_->config.stream_transaction_retry_interval](
-                               const std::vector<typename TStream::Message> &messages) mutable {
-    auto accessor = interpreter_context->db->Access();
+  auto stats = std::make_shared<StreamStats>();
+  ConsumerContext context{.interpreter_context = interpreter_context_,
+                          .stream_name = stream_name,
+                          .transformation_name = stream_info.common_info.transformation_name,
+                          .owner = owner,
+                          .total_retries = interpreter_context_->config.stream_transaction_conflict_retries,
+                          .retry_interval = interpreter_context_->config.stream_transaction_retry_interval,
+                          .batch_queries = interpreter_context_->config.stream_query_batching};
+  auto workers = std::make_shared<ConsumerWorkers>();
+  workers->workers.push_back(std::make_unique<ConsumerWorker>(interpreter_context_));
+
+  auto consumer_function = [context = std::move(context), workers, stats,
+                            partition_threads = interpreter_context_->config.stream_partition_threads](
+                               const std::vector<typename TStream::Message> &messages) {
+    const auto start = std::chrono::steady_clock::now();
     EventCounter::IncrementCounter(EventCounter::MessagesConsumed, messages.size());
-    CallCustomTransformation(transformation_name, messages, result, accessor, *memory_resource, stream_name);
-
-    DiscardValueResultStream stream;
 
-    spdlog::trace("Start transaction in stream '{}'", stream_name);
-    utils::OnScopeExit cleanup{[&interpreter, &result]() {
-      result.rows.clear();
-      interpreter->Abort();
-    }};
-
-    const static std::map<std::string, storage::PropertyValue> empty_parameters{};
-    uint32_t i = 0;
-    while (true) {
-      try {
-        interpreter->BeginTransaction();
-        for (auto &row : result.rows) {
-          spdlog::trace("Processing row in stream '{}'", stream_name);
-          auto [query_value, params_value] = ExtractTransformationResult(row.values, transformation_name, stream_name);
-          storage::PropertyValue params_prop{params_value};
-
-          std::string query{query_value.ValueString()};
-          spdlog::trace("Executing query '{}' in stream '{}'", query, stream_name);
-          auto prepare_result =
-              interpreter->Prepare(query, params_prop.IsNull() ? empty_parameters : params_prop.ValueMap(), nullptr);
-          if (!interpreter_context->auth_checker->IsUserAuthorized(owner, prepare_result.privileges)) {
-            throw StreamsException{
-                "Couldn't execute query '{}' for stream '{}' because the owner is not authorized to execute the "
-                "query!",
-                query, stream_name};
+    std::optional<uint64_t> executed_queries;
+    if constexpr (requires(const typename TStream::Message &message) { message.Partition(); }) {
+      if (partition_threads > 1) {
+        if (auto partitions = SplitByPartition(messages); partitions.size() > 1) {
+          const auto num_workers = std::min<size_t>(partition_threads, partitions.size());
+          while (workers->workers.size() < num_workers) {
+            workers->workers.push_back(std::make_unique<ConsumerWorker>(context.interpreter_context));
           }
-          interpreter->PullAll(&stream);
-        }
-
-        spdlog::trace("Commit transaction in stream '{}'", stream_name);
-        interpreter->CommitTransaction();
-        result.rows.clear();
-        break;
-      } catch (const query::TransactionSerializationException &e) {
-        interpreter->Abort();
-        if (i == total_retries) {
-          throw;
+          if (!workers->pool) {
+            workers->pool = std::make_unique<utils::ThreadPool>(partition_threads - 1);
+          }
+          executed_queries = TransformAndExecuteInParallel(partitions, *workers, num_workers, context);
         }
-        ++i;
-        std::this_thread::sleep_for(retry_interval);
       }
     }
+    if (!executed_queries) {
+      executed_queries = TransformAndExecute(MessagePointers(messages), *workers->workers.front(), context);
+    }
+
+    stats->messages += messages.size();
+    ++stats->batches;
+    stats->queries += *executed_queries;
+    const auto batch_end = std::chrono::steady_clock::now();
+    stats->last_batch_duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(batch_end - start).count();
+    int64_t last_timestamp = 0;
+    for (const auto &message : messages) {
+      last_timestamp = std::max(last_timestamp, message.Timestamp());
+    }
+    if (last_timestamp > 0) {
+      const auto now =
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+      stats->lag_ms = std::max<int64_t>(now.count() - last_timestamp, 0);
+    }
   };
 
   auto insert_result = map.try_emplace(
       stream_name, StreamData<TStream>{std::move(stream_info.common_info.transformation_name), std::move(owner),
                                        std::make_unique<SynchronizedStreamSource<TStream>>(
-                                           stream_name, std::move(stream_info), std::move(consumer_function))});
+                                           stream_name, std::move(stream_info), std::move(consumer_function)),
+                                       std::move(stats)});
   MG_ASSERT(insert_result.second, "Unexpected error during storing consumer '{}'", stream_name);
   return insert_result.first;
 }
@@ -723,7 +1032,8 @@ TransformationResult Streams::Check(const std::string &stream_name, std::optiona
                                   &transformation_name = transformation_name, &result,
                                   &test_result]<typename T>(const std::vector<T> &messages) mutable {
           auto accessor = interpreter_context->db->Access();
-          CallCustomTransformation(transformation_name, messages, result, accessor, *memory_resource, stream_name);
+          CallCustomTransformation(transformation_name, MessagePointers(messages), result, accessor, *memory_resource,
+                                   stream_name);
 
           auto result_row = std::vector<TypedValue>();
           result_row.reserve(kCheckStreamResultSize);
@@ -11,9 +11,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <concepts>
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <type_traits>
 #include <unordered_map>
@@ -70,6 +72,17 @@ struct StreamStatus {
 
 using TransformationResult = std::vector<std::vector<TypedValue>>;
 
+/// Counters which describe the throughput and the lag of a running stream.
+struct StreamStats {
+  std::atomic<uint64_t> messages{0};
+  std::atomic<uint64_t> batches{0};
+  std::atomic<uint64_t> queries{0};
+  std::atomic<int64_t> last_batch_duration_ms{0};
+  // Milliseconds between the timestamp of the last consumed message and the
+  // moment its batch was committed.
+  std::atomic<int64_t> lag_ms{0};
+};
+
 /// Manages Kafka consumers.
 ///
 /// This class is responsible for all query supported actions to happen.
@@ -162,6 +175,7 @@ class Streams final {
     std::string transformation_name;
     std::optional<std::string> owner;
     std::unique_ptr<SynchronizedStreamSource<TStream>> stream_source;
+    std::shared_ptr<StreamStats> stats;
   };
 
   using StreamDataVariant = std::variant<StreamData<KafkaStream>, StreamData<PulsarStream>>;
@@ -183,6 +197,7 @@ class Streams final {
   void RegisterProcedures();
   void RegisterKafkaProcedures();
   void RegisterPulsarProcedures();
+  void RegisterStatsProcedure();
 
   InterpreterContext *interpreter_context_;
   kvstore::KVStore storage_;
@@ -152,8 +152,8 @@ std::vector<std::pair<Identifier, TriggerIdentifierTag>> GetPredefinedIdentifier
 
 Trigger::Trigger(std::string name, const std::string &query,
                  const std::map<std::string, storage::PropertyValue> &user_parameters,
-                 const TriggerEventType event_type, utils::SkipList<QueryCacheEntry> *query_cache,
-                 DbAccessor *db_accessor, utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
+                 const TriggerEventType event_type, AstCache *query_cache, DbAccessor *db_accessor,
+                 utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
                  std::optional<std::string> owner, const query::AuthChecker *auth_checker)
     : name_{std::move(name)},
       parsed_statements_{ParseQuery(query, user_parameters, query_cache, antlr_lock, query_config)},
@@ -163,13 +163,16 @@ Trigger::Trigger(std::string name, const std::string &query,
   GetPlan(db_accessor, auth_checker);
 }
 
-Trigger::TriggerPlan::TriggerPlan(std::unique_ptr<LogicalPlan> logical_plan, std::vector<IdentifierInfo> identifiers)
-    : cached_plan(std::move(logical_plan)), identifiers(std::move(identifiers)) {}
+Trigger::TriggerPlan::TriggerPlan(std::unique_ptr<LogicalPlan> logical_plan, std::vector<IdentifierInfo> identifiers,
+                                  const int64_t vertex_count)
+    : cached_plan(std::move(logical_plan), vertex_count), identifiers(std::move(identifiers)) {}
 
 std::shared_ptr<Trigger::TriggerPlan> Trigger::GetPlan(DbAccessor *db_accessor,
                                                        const query::AuthChecker *auth_checker) const {
   std::lock_guard plan_guard{plan_lock_};
-  if (!parsed_statements_.is_cacheable || !trigger_plan_ || trigger_plan_->cached_plan.IsExpired()) {
+  const auto vertex_count = db_accessor->VerticesCount();
+  if (!parsed_statements_.is_cacheable || !trigger_plan_ || trigger_plan_->cached_plan.IsExpired() ||
+      trigger_plan_->cached_plan.IsStale(vertex_count)) {
     auto identifiers = GetPredefinedIdentifiers(event_type_);
 
     AstStorage ast_storage;
@@ -185,7 +188,7 @@ std::shared_ptr<Trigger::TriggerPlan> Trigger::GetPlan(DbAccessor *db_accessor,
     auto logical_plan = MakeLogicalPlan(std::move(ast_storage), utils::Downcast<CypherQuery>(parsed_statements_.query),
                                         parsed_statements_.parameters, db_accessor, predefined_identifiers);
 
-    trigger_plan_ = std::make_shared<TriggerPlan>(std::move(logical_plan), std::move(identifiers));
+    trigger_plan_ = std::make_shared<TriggerPlan>(std::move(logical_plan), std::move(identifiers), vertex_count);
   }
   if (!auth_checker->IsUserAuthorized(owner_, parsed_statements_.required_privileges)) {
     throw utils::BasicException("The owner of trigger '{}' is not authorized to execute the query!", name_);
@@ -256,8 +259,8 @@ inline constexpr uint64_t kVersion{2};
 
 TriggerStore::TriggerStore(std::filesystem::path directory) : storage_{std::move(directory)} {}
 
-void TriggerStore::RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                                   utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
+void TriggerStore::RestoreTriggers(AstCache *query_cache, DbAccessor *db_accessor, utils::SpinLock *antlr_lock,
+                                   const InterpreterConfig::Query &query_config,
                                    const query::AuthChecker *auth_checker) {
   MG_ASSERT(before_commit_triggers_.size() == 0 && after_commit_triggers_.size() == 0,
             "Cannot restore trigger when some triggers already exist!");
@@ -334,10 +337,10 @@ void TriggerStore::RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache
 
 void TriggerStore::AddTrigger(std::string name, const std::string &query,
                               const std::map<std::string, storage::PropertyValue> &user_parameters,
-                              TriggerEventType event_type, TriggerPhase phase,
-                              utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                              utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
-                              std::optional<std::string> owner, const query::AuthChecker *auth_checker) {
+                              TriggerEventType event_type, TriggerPhase phase, AstCache *query_cache,
+                              DbAccessor *db_accessor, utils::SpinLock *antlr_lock,
+                              const InterpreterConfig::Query &query_config, std::optional<std::string> owner,
+                              const query::AuthChecker *auth_checker) {
   std::unique_lock store_guard{store_lock_};
   if (storage_.Get(name)) {
     throw utils::BasicException("Trigger with the same name already exists.");
@@ -19,9 +19,148 @@ Client::Client(const io::network::Endpoint &endpoint, communication::ClientConte
 void Client::Abort() {
   if (!client_) return;
   // We need to call Shutdown on the client to abort any pending read or
-  // write operations.
+  // write operations. The connection is reestablished by the next call.
+  broken_ = true;
   client_->Shutdown();
-  client_ = std::nullopt;
+}
+
+void Client::Connect() {
+  std::lock_guard<std::mutex> read_guard(read_mutex_);
+  std::lock_guard<std::mutex> write_guard(write_mutex_);
+  std::lock_guard<std::mutex> stash_guard(stash_mutex_);
+
+  // Another thread could have already reconnected.
+  if (client_ && !broken_ && !client_->ErrorStatus()) return;
+
+  // All requests in flight on the old connection are lost.
+  responses_.clear();
+  abandoned_.clear();
+  in_flight_ = 0;
+  ++connection_id_;
+  broken_ = false;
+
+  // Connect to the remote server.
+  client_.emplace(context_);
+  if (!client_->Connect(endpoint_)) {
+    SPDLOG_ERROR("Couldn't connect to remote address {}", endpoint_);
+    client_ = std::nullopt;
+    throw RpcFailedException(endpoint_);
+  }
+}
+
+void Client::ReceiveResponse(uint64_t request_id, uint64_t connection_id,
+                             const std::function<void(slk::Reader *)> &load) {
+  std::unique_lock<std::mutex> read_guard(read_mutex_);
+  std::unique_lock<std::mutex> write_guard(write_mutex_, std::defer_lock);
+  if (context_->use_ssl()) write_guard.lock();
+
+  auto load_response = [&load](const uint8_t *data, size_t size) {
+    slk::Reader res_reader(data, size);
+    uint64_t res_request_id = 0;
+    slk::Load(&res_request_id, &res_reader);
+    load(&res_reader);
+  };
+
+  while (true) {
+    // Check whether another thread already received the response.
+    std::optional<std::vector<uint8_t>> stashed;
+    {
+      std::lock_guard<std::mutex> stash_guard(stash_mutex_);
+      if (connection_id != connection_id_) {
+        // The connection was reestablished so the response will never arrive.
+        throw RpcFailedException(endpoint_);
+      }
+      if (auto it = responses_.find(request_id); it != responses_.end()) {
+        stashed.emplace(std::move(it->second));
+        responses_.erase(it);
+      }
+    }
+    if (stashed) {
+      load_response(stashed->data(), stashed->size());
+      return;
+    }
+
+    // Receive the next response.
+    const auto response_data_size = ReadResponse();
+    utils::OnScopeExit res_cleanup([&, response_data_size] { client_->ShiftData(response_data_size); });
+
+    const auto *data = client_->GetData();
+    uint64_t res_request_id = 0;
+    {
+      slk::Reader res_reader(data, response_data_size);
+      slk::Load(&res_request_id, &res_reader);
+    }
+    if (res_request_id == request_id) {
+      load_response(data, response_data_size);
+      return;
+    }
+
+    StashResponse(res_request_id, data, response_data_size);
+  }
+}
+
+void Client::DrainResponses() {
+  std::unique_lock<std::mutex> read_guard(read_mutex_);
+  std::unique_lock<std::mutex> write_guard(write_mutex_, std::defer_lock);
+  if (context_->use_ssl()) write_guard.lock();
+
+  while (in_flight_.load(std::memory_order_acquire) >= kMaxInFlightRequests) {
+    // The requests on a broken connection are lost anyway and the next call
+    // reconnects.
+    if (broken_ || !client_ || client_->ErrorStatus()) return;
+    const auto response_data_size = ReadResponse();
+    utils::OnScopeExit res_cleanup([&, response_data_size] { client_->ShiftData(response_data_size); });
+    const auto *data = client_->GetData();
+    uint64_t res_request_id = 0;
+    {
+      slk::Reader res_reader(data, response_data_size);
+      slk::Load(&res_request_id, &res_reader);
+    }
+    StashResponse(res_request_id, data, response_data_size);
+  }
+}
+
+size_t Client::ReadResponse() {
+  if (broken_ || !client_) {
+    throw RpcFailedException(endpoint_);
+  }
+  while (true) {
+    auto ret = slk::CheckStreamComplete(client_->GetData(), client_->GetDataSize());
+    if (ret.status == slk::StreamStatus::INVALID) {
+      Break();
+      throw RpcFailedException(endpoint_);
+    } else if (ret.status == slk::StreamStatus::PARTIAL) {
+      if (!client_->Read(ret.stream_size - client_->GetDataSize(),
+                         /* exactly_len = */ false)) {
+        Break();
+        throw RpcFailedException(endpoint_);
+      }
+    } else {
+      in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+      return ret.stream_size;
+    }
+  }
+}
+
+void Client::StashResponse(uint64_t request_id, const uint8_t *data, size_t size) {
+  // The response belongs to another request, keep it for its owner unless the
+  // owner isn't interested in it.
+  std::lock_guard<std::mutex> stash_guard(stash_mutex_);
+  if (abandoned_.erase(request_id) == 0) {
+    responses_.emplace(request_id, std::vector<uint8_t>(data, data + size));
+  }
+}
+
+void Client::AbandonResponse(uint64_t request_id, uint64_t connection_id) {
+  std::lock_guard<std::mutex> guard(stash_mutex_);
+  if (connection_id != connection_id_) return;
+  if (responses_.erase(request_id) > 0) return;
+  abandoned_.insert(request_id);
+}
+
+void Client::Break() {
+  broken_ = true;
+  if (client_) client_->Shutdown();
 }
 
 }  // namespace memgraph::rpc
@@ -11,9 +11,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "communication/client.hpp"
 #include "io/network/endpoint.hpp"
@@ -27,8 +33,26 @@
 namespace memgraph::rpc {
 
 /// Client is thread safe, but it is recommended to use thread_local clients.
+///
+/// Requests are tagged with request IDs and the server echoes the ID in the
+/// response, so several requests can be outstanding on the connection at the
+/// same time. A request is written under the write lock and its response is
+/// read under the read lock, so a thread can send a request while another one
+/// is waiting for a response. Responses to other requests that are received
+/// by a waiting thread are kept until their owners collect them.
+///
+/// At most `kMaxInFlightRequests` requests are left unanswered on the
+/// connection. A thread that would exceed the limit first reads the pending
+/// responses and keeps them for their owners. The server stops reading
+/// requests while it can't write its responses, so without the limit a client
+/// that only sends requests would block the server and itself once the unread
+/// responses fill the socket buffers. The limit prevents that as long as the
+/// in-flight responses fit into the buffers, i.e. unless they are megabytes in
+/// size.
 class Client {
  public:
+  static constexpr uint64_t kMaxInFlightRequests = 16;
+
   Client(const io::network::Endpoint &endpoint, communication::ClientContext *context);
 
   /// Object used to handle streaming of request data to the RPC server.
@@ -37,80 +61,100 @@ class Client {
    private:
     friend class Client;
 
-    StreamHandler(Client *self, std::unique_lock<std::mutex> &&guard,
+    StreamHandler(Client *self, std::unique_lock<std::mutex> &&guard, uint64_t request_id, uint64_t connection_id,
                   std::function<typename TRequestResponse::Response(slk::Reader *)> res_load)
         : self_(self),
           guard_(std::move(guard)),
+          request_id_(request_id),
+          connection_id_(connection_id),
           req_builder_([self](const uint8_t *data, size_t size, bool have_more) {
-            if (!self->client_->Write(data, size, have_more)) throw RpcFailedException(self->endpoint_);
+            if (!self->client_->Write(data, size, have_more)) {
+              self->Break();
+              throw RpcFailedException(self->endpoint_);
+            }
           }),
           res_load_(res_load) {}
 
    public:
-    StreamHandler(StreamHandler &&) noexcept = default;
-    StreamHandler &operator=(StreamHandler &&) noexcept = default;
+    StreamHandler(StreamHandler &&other) noexcept
+        : self_(std::exchange(other.self_, nullptr)),
+          guard_(std::move(other.guard_)),
+          request_id_(other.request_id_),
+          connection_id_(other.connection_id_),
+          sent_(other.sent_),
+          req_builder_(std::move(other.req_builder_)),
+          res_load_(std::move(other.res_load_)) {}
+    StreamHandler &operator=(StreamHandler &&) = delete;
 
     StreamHandler(const StreamHandler &) = delete;
     StreamHandler &operator=(const StreamHandler &) = delete;
 
-    ~StreamHandler() {}
+    ~StreamHandler() {
+      if (self_ == nullptr) return;
+      if (!sent_) {
+        // The request was only partially written, so the connection can't be
+        // used for other requests.
+        self_->Break();
+      } else {
+        self_->AbandonResponse(request_id_, connection_id_);
+      }
+    }
 
     slk::Builder *GetBuilder() { return &req_builder_; }
 
+    /// Finishes sending the request without waiting for the response. Other
+    /// requests can be sent on the connection after this call. The response
+    /// must be collected with `AwaitResponse`.
+    void Send() {
+      if (sent_) return;
+      req_builder_.Finalize();
+      sent_ = true;
+      guard_.unlock();
+    }
+
     typename TRequestResponse::Response AwaitResponse() {
       auto res_type = TRequestResponse::Response::kType;
 
       // Finalize the request.
-      req_builder_.Finalize();
-
-      // Receive the response.
-      uint64_t response_data_size = 0;
-      while (true) {
-        auto ret = slk::CheckStreamComplete(self_->client_->GetData(), self_->client_->GetDataSize());
-        if (ret.status == slk::StreamStatus::INVALID) {
+      Send();
+
+      // Receive and load the response. The handler is done with the client
+      // after this, even if the response couldn't be received.
+      utils::OnScopeExit release_client([this] { self_ = nullptr; });
+      std::optional<typename TRequestResponse::Response> response;
+      self_->ReceiveResponse(request_id_, connection_id_, [&](slk::Reader *res_reader) {
+        uint64_t res_id = 0;
+        slk::Load(&res_id, res_reader);
+
+        // Check the response ID.
+        if (res_id != res_type.id) {
+          spdlog::error("Message response was of unexpected type");
+          self_->Break();
           throw RpcFailedException(self_->endpoint_);
-        } else if (ret.status == slk::StreamStatus::PARTIAL) {
-          if (!self_->client_->Read(ret.stream_size - self_->client_->GetDataSize(),
-                                    /* exactly_len = */ false)) {
-            throw RpcFailedException(self_->endpoint_);
-          }
-        } else {
-          response_data_size = ret.stream_size;
-          break;
         }
-      }
-
-      // Load the response.
-      slk::Reader res_reader(self_->client_->GetData(), response_data_size);
-      utils::OnScopeExit res_cleanup([&, response_data_size] { self_->client_->ShiftData(response_data_size); });
-
-      uint64_t res_id = 0;
-      slk::Load(&res_id, &res_reader);
-
-      // Check the response ID.
-      if (res_id != res_type.id) {
-        spdlog::error("Message response was of unexpected type");
-        self_->client_ = std::nullopt;
-        throw RpcFailedException(self_->endpoint_);
-      }
 
-      SPDLOG_TRACE("[RpcClient] received {}", res_type.name);
+        SPDLOG_TRACE("[RpcClient] received {}", res_type.name);
 
-      return res_load_(&res_reader);
+        response.emplace(res_load_(res_reader));
+      });
+      return std::move(*response);
     }
 
    private:
     Client *self_;
     std::unique_lock<std::mutex> guard_;
+    uint64_t request_id_;
+    uint64_t connection_id_;
+    bool sent_{false};
     slk::Builder req_builder_;
     std::function<typename TRequestResponse::Response(slk::Reader *)> res_load_;
   };
 
-  /// Stream a previously defined and registered RPC call. This function can
-  /// initiate only one request at a time. The call returns a `StreamHandler`
-  /// object that can be used to send additional data to the request (with the
-  /// automatically sent `TRequestResponse::Request` object) and await until the
-  /// response is received from the server.
+  /// Stream a previously defined and registered RPC call. The call returns a
+  /// `StreamHandler` object that can be used to send additional data to the
+  /// request (with the automatically sent `TRequestResponse::Request` object)
+  /// and await until the response is received from the server. Other requests
+  /// on this client wait until the request is sent.
   ///
   /// @returns StreamHandler<TRequestResponse> object that is used to handle
   ///                                          streaming of additional data to
@@ -121,13 +165,7 @@ class Client {
   ///                            died, etc.)
   template <class TRequestResponse, class... Args>
   StreamHandler<TRequestResponse> Stream(Args &&...args) {
-    return StreamWithLoad<TRequestResponse>(
-        [](auto *reader) {
-          typename TRequestResponse::Response response;
-          TRequestResponse::Response::Load(&response, reader);
-          return response;
-        },
-        std::forward<Args>(args)...);
+    return StreamWithLoad<TRequestResponse>(LoadResponse<TRequestResponse>, std::forward<Args>(args)...);
   }
 
   /// Same as `Stream` but the first argument is a response loading function.
@@ -135,41 +173,35 @@ class Client {
   StreamHandler<TRequestResponse> StreamWithLoad(std::function<typename TRequestResponse::Response(slk::Reader *)> load,
                                                  Args &&...args) {
     typename TRequestResponse::Request request(std::forward<Args>(args)...);
-    auto req_type = TRequestResponse::Request::kType;
-    SPDLOG_TRACE("[RpcClient] sent {}", req_type.name);
-
-    std::unique_lock<std::mutex> guard(mutex_);
 
-    // Check if the connection is broken (if we haven't used the client for a
-    // long time the server could have died).
-    if (client_ && client_->ErrorStatus()) {
-      client_ = std::nullopt;
-    }
-
-    // Connect to the remote server.
-    if (!client_) {
-      client_.emplace(context_);
-      if (!client_->Connect(endpoint_)) {
-        SPDLOG_ERROR("Couldn't connect to remote address {}", endpoint_);
-        client_ = std::nullopt;
-        throw RpcFailedException(endpoint_);
-      }
+    if (in_flight_.load(std::memory_order_acquire) >= kMaxInFlightRequests) {
+      DrainResponses();
     }
 
-    // Create the stream handler.
-    StreamHandler<TRequestResponse> handler(this, std::move(guard), load);
+    std::unique_lock<std::mutex> guard(write_mutex_);
+    return StartRequest<TRequestResponse>(std::move(guard), std::move(load), request);
+  }
 
-    // Build and send the request.
-    slk::Save(req_type.id, handler.GetBuilder());
-    TRequestResponse::Request::Save(request, handler.GetBuilder());
+  /// Same as `Stream` but it never waits for the responses to the requests
+  /// that are in flight. If `kMaxInFlightRequests` requests are unanswered,
+  /// nothing is sent and `std::nullopt` is returned.
+  ///
+  /// @throws RpcFailedException if the connection can't be established
+  template <class TRequestResponse, class... Args>
+  std::optional<StreamHandler<TRequestResponse>> TryStream(Args &&...args) {
+    typename TRequestResponse::Request request(std::forward<Args>(args)...);
 
-    // Return the handler to the user.
-    return std::move(handler);
+    // The number of requests in flight is increased only while holding the
+    // write lock, so it can't reach the limit after this check.
+    std::unique_lock<std::mutex> guard(write_mutex_);
+    if (in_flight_.load(std::memory_order_acquire) >= kMaxInFlightRequests) {
+      return std::nullopt;
+    }
+    return StartRequest<TRequestResponse>(std::move(guard), LoadResponse<TRequestResponse>, request);
   }
 
-  /// Call a previously defined and registered RPC call. This function can
-  /// initiate only one request at a time. The call blocks until a response is
-  /// received.
+  /// Call a previously defined and registered RPC call. The call blocks until
+  /// a response is received.
   ///
   /// @returns TRequestResponse::Response object that was specified to be
   ///                                     returned by the RPC call
@@ -190,17 +222,123 @@ class Client {
     return stream.AwaitResponse();
   }
 
+  /// Send a previously defined and registered RPC call without waiting for the
+  /// response. Several calls can be in flight on the same connection. The
+  /// response is collected with `AwaitResponse` on the returned handler, in
+  /// any order.
+  ///
+  /// @throws RpcFailedException if an error was occurred while sending the
+  ///                            request
+  template <class TRequestResponse, class... Args>
+  StreamHandler<TRequestResponse> AsyncCall(Args &&...args) {
+    auto stream = Stream<TRequestResponse>(std::forward<Args>(args)...);
+    stream.Send();
+    return stream;
+  }
+
   /// Call this function from another thread to abort a pending RPC call.
   void Abort();
 
   const auto &Endpoint() const { return endpoint_; }
 
  private:
+  template <class TRequestResponse>
+  static typename TRequestResponse::Response LoadResponse(slk::Reader *reader) {
+    typename TRequestResponse::Response response;
+    TRequestResponse::Response::Load(&response, reader);
+    return response;
+  }
+
+  /// Writes the header of the request. `guard` has to hold `write_mutex_`, it
+  /// is released when the request is sent.
+  template <class TRequestResponse>
+  StreamHandler<TRequestResponse> StartRequest(std::unique_lock<std::mutex> &&guard,
+                                               std::function<typename TRequestResponse::Response(slk::Reader *)> load,
+                                               const typename TRequestResponse::Request &request) {
+    auto req_type = TRequestResponse::Request::kType;
+    SPDLOG_TRACE("[RpcClient] sent {}", req_type.name);
+
+    // Check if the connection is broken (if we haven't used the client for a
+    // long time the server could have died) and connect to the remote server.
+    if (!client_ || broken_ || client_->ErrorStatus()) {
+      guard.unlock();
+      Connect();
+      guard.lock();
+    }
+
+    // Create the stream handler.
+    const auto request_id = next_request_id_++;
+    in_flight_.fetch_add(1, std::memory_order_acq_rel);
+    StreamHandler<TRequestResponse> handler(this, std::move(guard), request_id, connection_id_, std::move(load));
+
+    // Build and send the request.
+    slk::Save(kProtocolVersion, handler.GetBuilder());
+    slk::Save(request_id, handler.GetBuilder());
+    slk::Save(req_type.id, handler.GetBuilder());
+    TRequestResponse::Request::Save(request, handler.GetBuilder());
+
+    // Return the handler to the user.
+    return handler;
+  }
+
+  /// (Re)connects to the remote server if the connection is broken. All
+  /// requests that are in flight on the broken connection fail.
+  /// @throws RpcFailedException if the connection can't be established
+  void Connect();
+
+  /// Calls `load` with the reader positioned after the request ID of the
+  /// response to the given request.
+  /// @throws RpcFailedException if the connection broke
+  void ReceiveResponse(uint64_t request_id, uint64_t connection_id, const std::function<void(slk::Reader *)> &load);
+
+  /// Drops the response to the given request when it is received.
+  void AbandonResponse(uint64_t request_id, uint64_t connection_id);
+
+  /// Reads responses from the connection and keeps them for their owners
+  /// until fewer than `kMaxInFlightRequests` requests are unanswered.
+  /// @throws RpcFailedException if the connection broke
+  void DrainResponses();
+
+  /// Reads the next response into the buffer of the connection and returns
+  /// its size. Must be called while holding `read_mutex_` (and `write_mutex_`
+  /// with SSL).
+  /// @throws RpcFailedException if the connection broke
+  size_t ReadResponse();
+
+  /// Keeps the response for the owner of the request unless it was abandoned.
+  /// Must be called while holding `read_mutex_`.
+  void StashResponse(uint64_t request_id, const uint8_t *data, size_t size);
+
+  /// Marks the connection as broken and shuts it down so that all threads that
+  /// are waiting for responses on it fail. Must be called while holding one of
+  /// the locks.
+  void Break();
+
   io::network::Endpoint endpoint_;
   communication::ClientContext *context_;
   std::optional<communication::Client> client_;
-
-  std::mutex mutex_;
+  std::atomic<bool> broken_{false};
+
+  // Locks are always taken in the order `read_mutex_`, `write_mutex_`,
+  // `stash_mutex_`. OpenSSL doesn't allow concurrent reads and writes on a
+  // connection, so with SSL the responses are read while also holding the
+  // write lock.
+  std::mutex read_mutex_;
+  std::mutex write_mutex_;
+  std::mutex stash_mutex_;
+
+  // Protected by `write_mutex_`.
+  uint64_t next_request_id_{0};
+  // Number of requests whose responses weren't read from the connection yet.
+  std::atomic<uint64_t> in_flight_{0};
+  // Incremented on every (re)connect, while holding all locks.
+  uint64_t connection_id_{0};
+
+  // Responses that were received by a thread that was waiting for another
+  // response, and requests whose responses nobody waits for. Protected by
+  // `stash_mutex_`.
+  std::map<uint64_t, std::vector<uint8_t>> responses_;
+  std::set<uint64_t> abandoned_;
 };
 
 }  // namespace memgraph::rpc
@@ -20,6 +20,13 @@ namespace memgraph::rpc {
 
 using MessageSize = uint32_t;
 
+/// Version of the RPC message header that is sent at the start of every
+/// request. The server closes connections of clients that use a different
+/// header layout instead of misinterpreting their requests. The high bytes
+/// spell "MGRPC", so the value can't be mistaken for a request type ID, which
+/// was the first value of a request before the header was versioned.
+inline constexpr uint64_t kProtocolVersion = 0x4D47525043000002;
+
 /// Each RPC is defined via this struct.
 ///
 /// `TRequest` and `TResponse` are required to be classes which have a static
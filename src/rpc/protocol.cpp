@@ -24,23 +24,40 @@ Session::Session(Server *server, const io::network::Endpoint &endpoint, communic
     : server_(server), endpoint_(endpoint), input_stream_(input_stream), output_stream_(output_stream) {}
 
 void Session::Execute() {
-  auto ret = slk::CheckStreamComplete(input_stream_->data(), input_stream_->size());
-  if (ret.status == slk::StreamStatus::INVALID) {
-    throw SessionException("Received an invalid SLK stream!");
-  } else if (ret.status == slk::StreamStatus::PARTIAL) {
-    input_stream_->Resize(ret.stream_size);
-    return;
-  }
+  // The client can have several requests in flight, so all complete requests
+  // that were received are executed.
+  while (true) {
+    auto ret = slk::CheckStreamComplete(input_stream_->data(), input_stream_->size());
+    if (ret.status == slk::StreamStatus::INVALID) {
+      throw SessionException("Received an invalid SLK stream!");
+    } else if (ret.status == slk::StreamStatus::PARTIAL) {
+      input_stream_->Resize(ret.stream_size);
+      return;
+    }
+
+    // Remove the data from the stream on scope exit.
+    utils::OnScopeExit shift_data([&, ret] { input_stream_->Shift(ret.stream_size); });
 
-  // Remove the data from the stream on scope exit.
-  utils::OnScopeExit shift_data([&, ret] { input_stream_->Shift(ret.stream_size); });
+    ExecuteRequest(ret.stream_size);
+  }
+}
 
+void Session::ExecuteRequest(size_t stream_size) {
   // Prepare SLK reader and builder.
-  slk::Reader req_reader(input_stream_->data(), input_stream_->size());
+  slk::Reader req_reader(input_stream_->data(), stream_size);
   slk::Builder res_builder(
       [&](const uint8_t *data, size_t size, bool have_more) { output_stream_->Write(data, size, have_more); });
 
-  // Load the request ID.
+  // Load the protocol version, the request ID and the request type ID.
+  uint64_t version = 0;
+  slk::Load(&version, &req_reader);
+  if (version != kProtocolVersion) {
+    spdlog::error("RPC client {} uses an unsupported protocol version, closing the connection.", endpoint_);
+    // Throw exception to close the socket and cleanup the session.
+    throw SessionException("Session received a request with an unsupported protocol version!");
+  }
+  uint64_t request_id = 0;
+  slk::Load(&request_id, &req_reader);
   uint64_t req_id = 0;
   slk::Load(&req_id, &req_reader);
 
@@ -60,10 +77,12 @@ void Session::Execute() {
       throw SessionException("Session trying to execute an unregistered RPC call!");
     }
     SPDLOG_TRACE("[RpcServer] received {}", extended_it->second.req_type.name);
+    slk::Save(request_id, &res_builder);
     slk::Save(extended_it->second.res_type.id, &res_builder);
     extended_it->second.callback(endpoint_, &req_reader, &res_builder);
   } else {
     SPDLOG_TRACE("[RpcServer] received {}", it->second.req_type.name);
+    slk::Save(request_id, &res_builder);
     slk::Save(it->second.res_type.id, &res_builder);
     it->second.callback(&req_reader, &res_builder);
   }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -26,6 +27,12 @@
  *
  * Message layout: MessageSize message_size,
  *                 message_size bytes serialized_message
+ *
+ * Each request starts with the protocol version (`kProtocolVersion`) and a
+ * request ID chosen by the client, followed by the request type ID. The
+ * response starts with the same request ID, followed by the response type ID,
+ * so the client can match the responses to requests that are in flight at the
+ * same time.
  */
 namespace memgraph::rpc {
 
@@ -58,6 +65,12 @@ class Session {
   void Execute();
 
  private:
+  /**
+   * Executes a single complete request of `stream_size` bytes from the beginning of
+   * the input stream.
+   */
+  void ExecuteRequest(size_t stream_size);
+
   Server *server_;
   io::network::Endpoint endpoint_;
   communication::InputStream *input_stream_;
@@ -11,9 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <thread>
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/transaction.hpp"
 
@@ -44,9 +46,23 @@ struct Config {
 
     std::chrono::milliseconds snapshot_interval{std::chrono::minutes(2)};
     uint64_t snapshot_retention_count{3};
+    uint64_t snapshot_thread_count{1};
+    // Number of differential snapshots, which contain only the objects that
+    // were modified since the previous snapshot, created after each full
+    // snapshot. Set to 0 to always create full snapshots.
+    uint64_t snapshot_differential_count{0};
+    // Number of threads that decode the blocks of a snapshot and apply the
+    // deltas of the WAL files during recovery.
+    uint64_t recovery_thread_count{std::max(1U, std::thread::hardware_concurrency())};
 
     uint64_t wal_file_size_kibibytes{20 * 1024};
     uint64_t wal_file_flush_every_n_tx{100000};
+    // Whether the deltas of the finalized WAL files are compressed. The files
+    // are compressed by a background thread.
+    bool wal_compression{false};
+    // Experimental. Whether the WAL and snapshot files are written through
+    // io_uring. Regular system calls are used if io_uring isn't available.
+    bool io_uring{false};
 
     bool snapshot_on_exit{false};
 
@@ -15,6 +15,7 @@
 #include <set>
 #include <vector>
 
+#include "storage/v2/containers.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
@@ -108,7 +109,7 @@ class UniqueConstraints {
   /// @throw std::bad_alloc
   utils::BasicResult<ConstraintViolation, CreationStatus> CreateConstraint(LabelId label,
                                                                            const std::set<PropertyId> &properties,
-                                                                           utils::SkipList<Vertex>::Accessor vertices);
+                                                                           VerticesContainer::Accessor vertices);
 
   /// Deletes the specified constraint. Returns `DeletionStatus::NOT_FOUND` if
   /// there is not such constraint in the storage,
@@ -153,7 +154,7 @@ struct Constraints {
 /// @throw std::bad_alloc
 /// @throw std::length_error
 inline utils::BasicResult<ConstraintViolation, bool> CreateExistenceConstraint(
-    Constraints *constraints, LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+    Constraints *constraints, LabelId label, PropertyId property, VerticesContainer::Accessor vertices) {
   if (utils::Contains(constraints->existence_constraints, std::make_pair(label, property))) {
     return false;
   }
@@ -0,0 +1,38 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#pragma once
+
+#include "storage/v2/edge.hpp"
+#include "storage/v2/vertex.hpp"
+
+#ifdef MG_STORAGE_BTREE
+#include "utils/btree.hpp"
+#else
+#include "utils/skip_list.hpp"
+#endif
+
+namespace memgraph::storage {
+
+// The containers that hold all vertices and edges of the storage, ordered by
+// their `Gid`. The skip list is used by default, the B+-tree can be selected
+// at build time with the `MG_STORAGE_BTREE` CMake option. Both expose the same
+// accessor interface.
+#ifdef MG_STORAGE_BTREE
+using VerticesContainer = utils::BTree<Vertex, &Vertex::gid>;
+using EdgesContainer = utils::BTree<Edge, &Edge::gid>;
+#else
+using VerticesContainer = utils::SkipList<Vertex>;
+using EdgesContainer = utils::SkipList<Edge>;
+#endif
+
+}  // namespace memgraph::storage
@@ -0,0 +1,44 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/durability/compression.hpp"
+
+#include <zlib.h>
+
+#include "storage/v2/durability/exceptions.hpp"
+
+namespace memgraph::storage::durability {
+
+namespace {
+
+// Maximum compression ratio that zlib can achieve, used to reject corrupt
+// block sizes before allocating the buffer.
+constexpr uint64_t kMaxCompressionRatio = 1032;
+
+}  // namespace
+
+void CompressBlock(const uint8_t *data, size_t size, std::vector<uint8_t> *compressed) {
+  auto compressed_size = compressBound(size);
+  compressed->resize(compressed_size);
+  auto ret = compress2(compressed->data(), &compressed_size, data, size, Z_BEST_SPEED);
+  if (ret != Z_OK) throw DurabilityFailure("Couldn't compress durability block, zlib error {}!", ret);
+  compressed->resize(compressed_size);
+}
+
+bool DecompressBlock(const uint8_t *data, size_t size, uint64_t uncompressed_size, std::vector<uint8_t> *buffer) {
+  if (uncompressed_size > size * kMaxCompressionRatio) return false;
+  buffer->resize(uncompressed_size);
+  uLongf buffer_size = uncompressed_size;
+  auto ret = uncompress(buffer->data(), &buffer_size, data, size);
+  return ret == Z_OK && buffer_size == uncompressed_size;
+}
+
+}  // namespace memgraph::storage::durability
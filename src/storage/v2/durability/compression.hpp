@@ -0,0 +1,31 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace memgraph::storage::durability {
+
+/// Compresses `size` bytes from `data` into `compressed`. The blocks are
+/// compressed with zlib using the fastest compression level.
+///
+/// @throw DurabilityFailure if zlib fails to compress the block.
+void CompressBlock(const uint8_t *data, size_t size, std::vector<uint8_t> *compressed);
+
+/// Decompresses `size` bytes from `data` into `buffer`, which is resized to
+/// `uncompressed_size`. Returns `false` if the data is corrupt or doesn't
+/// decompress into exactly `uncompressed_size` bytes.
+bool DecompressBlock(const uint8_t *data, size_t size, uint64_t uncompressed_size, std::vector<uint8_t> *buffer);
+
+}  // namespace memgraph::storage::durability
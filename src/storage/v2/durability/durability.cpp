@@ -71,7 +71,8 @@ std::vector<SnapshotDurabilityInfo> GetSnapshotFiles(const std::filesystem::path
       try {
         auto info = ReadSnapshotInfo(item.path());
         if (uuid.empty() || info.uuid == uuid) {
-          snapshot_files.emplace_back(item.path(), std::move(info.uuid), info.start_timestamp);
+          snapshot_files.emplace_back(item.path(), std::move(info.uuid), info.start_timestamp,
+                                      info.base_start_timestamp);
         }
       } catch (const RecoveryFailure &) {
         continue;
@@ -92,6 +93,9 @@ std::optional<std::vector<WalDurabilityInfo>> GetWalFiles(const std::filesystem:
   std::error_code error_code;
   for (const auto &item : std::filesystem::directory_iterator(wal_directory, error_code)) {
     if (!item.is_regular_file()) continue;
+    // A WAL file that was being compressed is still complete in its original
+    // file, the partial compressed copy is ignored.
+    if (item.path().extension() == kCompressingWalExtension) continue;
     try {
       auto info = ReadWalInfo(item.path());
       if ((uuid.empty() || info.uuid == uuid) && (!current_seq_num || info.seq_num < *current_seq_num))
@@ -113,7 +117,7 @@ std::optional<std::vector<WalDurabilityInfo>> GetWalFiles(const std::filesystem:
 // to ensure that the indices and constraints are consistent at the end of the
 // recovery process.
 void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_constraints, Indices *indices,
-                                  Constraints *constraints, utils::SkipList<Vertex> *vertices) {
+                                  Constraints *constraints, VerticesContainer *vertices) {
   spdlog::info("Recreating indices from metadata.");
   // Recover label indices.
   spdlog::info("Recreating {} label indices from metadata.", indices_constraints.indices.label.size());
@@ -133,6 +137,34 @@ void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_
     spdlog::info("A label+property index is recreated from metadata.");
   }
   spdlog::info("Label+property indices are recreated.");
+
+  // Recover edge type indices.
+  spdlog::info("Recreating {} edge type indices from metadata.", indices_constraints.indices.edge_type.size());
+  for (const auto &item : indices_constraints.indices.edge_type) {
+    if (!indices->edge_type_index.CreateIndex(item, vertices->access()))
+      throw RecoveryFailure("The edge type index must be created here!");
+    spdlog::info("An edge type index is recreated from metadata.");
+  }
+  spdlog::info("Edge type indices are recreated.");
+
+  // Recover label+properties indices.
+  spdlog::info("Recreating {} label+properties indices from metadata.",
+               indices_constraints.indices.label_properties.size());
+  for (const auto &item : indices_constraints.indices.label_properties) {
+    if (!indices->label_properties_index.CreateIndex(item.first, item.second, vertices->access()))
+      throw RecoveryFailure("The label+properties index must be created here!");
+    spdlog::info("A label+properties index is recreated from metadata.");
+  }
+  spdlog::info("Label+properties indices are recreated.");
+
+  // Recover text indices.
+  spdlog::info("Recreating {} text indices from metadata.", indices_constraints.indices.text.size());
+  for (const auto &item : indices_constraints.indices.text) {
+    if (!indices->text_index.CreateIndex(item.first, item.second, vertices->access()))
+      throw RecoveryFailure("The text index must be created here!");
+    spdlog::info("A text index is recreated from metadata.");
+  }
+  spdlog::info("Text indices are recreated.");
   spdlog::info("Indices are recreated.");
 
   spdlog::info("Recreating constraints from metadata.");
@@ -161,10 +193,11 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
                                         const std::filesystem::path &wal_directory, std::string *uuid,
                                         std::string *epoch_id,
                                         std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                                        utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
-                                        std::atomic<uint64_t> *edge_count, NameIdMapper *name_id_mapper,
+                                        VerticesContainer *vertices, VertexDirectory *vertex_directory,
+                                        EdgesContainer *edges, std::atomic<uint64_t> *edge_count,
+                                        NameIdMapper *name_id_mapper,
                                         Indices *indices, Constraints *constraints, Config::Items items,
-                                        uint64_t *wal_seq_num) {
+                                        uint64_t recovery_thread_count, uint64_t *wal_seq_num) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   spdlog::info("Recovering persisted data using snapshot ({}) and WAL directory ({}).", snapshot_directory,
                wal_directory);
@@ -187,15 +220,20 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     // UUID used for durability is the UUID of the last snapshot file.
     *uuid = snapshot_files.back().uuid;
     std::optional<RecoveredSnapshot> recovered_snapshot;
-    for (auto it = snapshot_files.rbegin(); it != snapshot_files.rend(); ++it) {
-      const auto &[path, file_uuid, _] = *it;
-      if (file_uuid != *uuid) {
+    auto base_it = snapshot_files.rbegin();
+    for (; base_it != snapshot_files.rend(); ++base_it) {
+      const auto &path = base_it->path;
+      if (base_it->uuid != *uuid) {
         spdlog::warn("The snapshot file {} isn't related to the latest snapshot file!", path);
         continue;
       }
+      // Differential snapshots are applied on top of the recovered full
+      // snapshot.
+      if (base_it->base_start_timestamp) continue;
       spdlog::info("Starting snapshot recovery from {}.", path);
       try {
-        recovered_snapshot = LoadSnapshot(path, vertices, edges, epoch_history, name_id_mapper, edge_count, items);
+        recovered_snapshot = LoadSnapshot(path, vertices, edges, epoch_history, name_id_mapper, edge_count, items,
+                                          recovery_thread_count);
         spdlog::info("Snapshot recovery successful!");
         break;
       } catch (const RecoveryFailure &e) {
@@ -207,6 +245,30 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
               "The database is configured to recover on startup, but couldn't "
               "recover using any of the specified snapshots! Please inspect them "
               "and restart the database.");
+
+    // Apply the chain of differential snapshots that follow the recovered
+    // snapshot. Each of them is based on the previous one.
+    for (auto it = base_it.base(); it != snapshot_files.end(); ++it) {
+      if (it->uuid != *uuid || it->base_start_timestamp != recovered_snapshot->snapshot_info.start_timestamp) {
+        continue;
+      }
+      spdlog::info("Applying differential snapshot {}.", it->path);
+      try {
+        auto differential = LoadSnapshot(it->path, vertices, edges, epoch_history, name_id_mapper, edge_count, items,
+                                         recovery_thread_count);
+        differential.recovery_info.next_vertex_id =
+            std::max(differential.recovery_info.next_vertex_id, recovered_snapshot->recovery_info.next_vertex_id);
+        differential.recovery_info.next_edge_id =
+            std::max(differential.recovery_info.next_edge_id, recovered_snapshot->recovery_info.next_edge_id);
+        recovered_snapshot = std::move(differential);
+      } catch (const RecoveryFailure &e) {
+        LOG_FATAL("Couldn't apply the differential snapshot {} because of: {}", it->path, e.what());
+      }
+    }
+    // The snapshots are loaded directly into the vertex store, so the directory
+    // is filled afterwards.
+    vertex_directory->Rebuild(vertices);
+
     recovery_info = recovered_snapshot->recovery_info;
     indices_constraints = std::move(recovered_snapshot->indices_constraints);
     snapshot_timestamp = recovered_snapshot->snapshot_info.start_timestamp;
@@ -318,8 +380,8 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
         *epoch_id = std::move(wal_file.epoch_id);
       }
       try {
-        auto info = LoadWal(wal_file.path, &indices_constraints, last_loaded_timestamp, vertices, edges, name_id_mapper,
-                            edge_count, items);
+        auto info = LoadWal(wal_file.path, &indices_constraints, last_loaded_timestamp, vertices, vertex_directory,
+                            edges, name_id_mapper, edge_count, items, recovery_thread_count);
         recovery_info.next_vertex_id = std::max(recovery_info.next_vertex_id, info.next_vertex_id);
         recovery_info.next_edge_id = std::max(recovery_info.next_edge_id, info.next_edge_id);
         recovery_info.next_timestamp = std::max(recovery_info.next_timestamp, info.next_timestamp);
@@ -20,13 +20,14 @@
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints.hpp"
+#include "storage/v2/containers.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/edge.hpp"
 #include "storage/v2/indices.hpp"
 #include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/vertex.hpp"
-#include "utils/skip_list.hpp"
+#include "storage/v2/vertex_directory.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -37,12 +38,18 @@ void VerifyStorageDirectoryOwnerAndProcessUserOrDie(const std::filesystem::path
 
 // Used to capture the snapshot's data related to durability
 struct SnapshotDurabilityInfo {
-  explicit SnapshotDurabilityInfo(std::filesystem::path path, std::string uuid, const uint64_t start_timestamp)
-      : path(std::move(path)), uuid(std::move(uuid)), start_timestamp(start_timestamp) {}
+  explicit SnapshotDurabilityInfo(std::filesystem::path path, std::string uuid, const uint64_t start_timestamp,
+                                  const std::optional<uint64_t> base_start_timestamp = std::nullopt)
+      : path(std::move(path)),
+        uuid(std::move(uuid)),
+        start_timestamp(start_timestamp),
+        base_start_timestamp(base_start_timestamp) {}
 
   std::filesystem::path path;
   std::string uuid;
   uint64_t start_timestamp;
+  // Start timestamp of the base snapshot of a differential snapshot.
+  std::optional<uint64_t> base_start_timestamp;
 
   auto operator<=>(const SnapshotDurabilityInfo &) const = default;
 };
@@ -97,7 +104,7 @@ std::optional<std::vector<WalDurabilityInfo>> GetWalFiles(const std::filesystem:
 // recovery process.
 /// @throw RecoveryFailure
 void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_constraints, Indices *indices,
-                                  Constraints *constraints, utils::SkipList<Vertex> *vertices);
+                                  Constraints *constraints, VerticesContainer *vertices);
 
 /// Recovers data either from a snapshot and/or WAL files.
 /// @throw RecoveryFailure
@@ -106,9 +113,10 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
                                         const std::filesystem::path &wal_directory, std::string *uuid,
                                         std::string *epoch_id,
                                         std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                                        utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
-                                        std::atomic<uint64_t> *edge_count, NameIdMapper *name_id_mapper,
+                                        VerticesContainer *vertices, VertexDirectory *vertex_directory,
+                                        EdgesContainer *edges, std::atomic<uint64_t> *edge_count,
+                                        NameIdMapper *name_id_mapper,
                                         Indices *indices, Constraints *constraints, Config::Items items,
-                                        uint64_t *wal_seq_num);
+                                        uint64_t recovery_thread_count, uint64_t *wal_seq_num);
 
 }  // namespace memgraph::storage::durability
@@ -20,4 +20,9 @@ class RecoveryFailure : public utils::BasicException {
   using utils::BasicException::BasicException;
 };
 
+/// Exception used to handle errors while writing durability files.
+class DurabilityFailure : public utils::BasicException {
+  using utils::BasicException::BasicException;
+};
+
 }  // namespace memgraph::storage::durability
@@ -37,6 +37,9 @@ enum class Marker : uint8_t {
   SECTION_CONSTRAINTS = 0x25,
   SECTION_DELTA = 0x26,
   SECTION_EPOCH_HISTORY = 0x27,
+  SECTION_BLOCK = 0x28,
+  SECTION_BLOCK_INDEX = 0x29,
+  SECTION_DELETED = 0x2a,
   SECTION_OFFSETS = 0x42,
 
   DELTA_VERTEX_CREATE = 0x50,
@@ -56,6 +59,12 @@ enum class Marker : uint8_t {
   DELTA_EXISTENCE_CONSTRAINT_DROP = 0x5e,
   DELTA_UNIQUE_CONSTRAINT_CREATE = 0x5f,
   DELTA_UNIQUE_CONSTRAINT_DROP = 0x60,
+  DELTA_EDGE_TYPE_INDEX_CREATE = 0x61,
+  DELTA_EDGE_TYPE_INDEX_DROP = 0x62,
+  DELTA_LABEL_PROPERTIES_INDEX_CREATE = 0x63,
+  DELTA_LABEL_PROPERTIES_INDEX_DROP = 0x64,
+  DELTA_TEXT_INDEX_CREATE = 0x65,
+  DELTA_TEXT_INDEX_DROP = 0x66,
 
   VALUE_FALSE = 0x00,
   VALUE_TRUE = 0xff,
@@ -81,6 +90,9 @@ static const Marker kMarkersAll[] = {
     Marker::SECTION_CONSTRAINTS,
     Marker::SECTION_DELTA,
     Marker::SECTION_EPOCH_HISTORY,
+    Marker::SECTION_BLOCK,
+    Marker::SECTION_BLOCK_INDEX,
+    Marker::SECTION_DELETED,
     Marker::SECTION_OFFSETS,
     Marker::DELTA_VERTEX_CREATE,
     Marker::DELTA_VERTEX_DELETE,
@@ -99,6 +111,12 @@ static const Marker kMarkersAll[] = {
     Marker::DELTA_EXISTENCE_CONSTRAINT_DROP,
     Marker::DELTA_UNIQUE_CONSTRAINT_CREATE,
     Marker::DELTA_UNIQUE_CONSTRAINT_DROP,
+    Marker::DELTA_EDGE_TYPE_INDEX_CREATE,
+    Marker::DELTA_EDGE_TYPE_INDEX_DROP,
+    Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE,
+    Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP,
+    Marker::DELTA_TEXT_INDEX_CREATE,
+    Marker::DELTA_TEXT_INDEX_DROP,
     Marker::VALUE_FALSE,
     Marker::VALUE_TRUE,
 };
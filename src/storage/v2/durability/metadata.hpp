@@ -36,6 +36,9 @@ struct RecoveredIndicesAndConstraints {
   struct {
     std::vector<LabelId> label;
     std::vector<std::pair<LabelId, PropertyId>> label_property;
+    std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_properties;
+    std::vector<std::pair<LabelId, PropertyId>> text;
+    std::vector<EdgeTypeId> edge_type;
   } indices;
 
   struct {
@@ -22,6 +22,9 @@ static const std::string kSnapshotDirectory{"snapshots"};
 static const std::string kWalDirectory{"wal"};
 static const std::string kBackupDirectory{".backup"};
 static const std::string kLockFile{".lock"};
+// Extension of the file a finalized WAL file is compressed into before it
+// replaces the WAL file.
+static const std::string kCompressingWalExtension{".compressing"};
 
 // This is the prefix used for Snapshot and WAL filenames. It is a timestamp
 // format that equals to: YYYYmmddHHMMSSffffff
@@ -11,6 +11,8 @@
 
 #include "storage/v2/durability/serialization.hpp"
 
+#include <cstring>
+
 #include "storage/v2/temporal.hpp"
 #include "utils/endian.hpp"
 
@@ -21,115 +23,135 @@ namespace memgraph::storage::durability {
 //////////////////////////
 
 namespace {
-void WriteSize(Encoder *encoder, uint64_t size) {
+template <typename TEncoder>
+void WriteSize(TEncoder *encoder, uint64_t size) {
   size = utils::HostToLittleEndian(size);
   encoder->Write(reinterpret_cast<const uint8_t *>(&size), sizeof(size));
 }
-}  // namespace
-
-void Encoder::Initialize(const std::filesystem::path &path, const std::string_view &magic, uint64_t version) {
-  file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
-  Write(reinterpret_cast<const uint8_t *>(magic.data()), magic.size());
-  auto version_encoded = utils::HostToLittleEndian(version);
-  Write(reinterpret_cast<const uint8_t *>(&version_encoded), sizeof(version_encoded));
-}
 
-void Encoder::OpenExisting(const std::filesystem::path &path) {
-  file_.Open(path, utils::OutputFile::Mode::APPEND_TO_EXISTING);
-}
-
-void Encoder::Close() {
-  if (file_.IsOpen()) {
-    file_.Close();
-  }
-}
-
-void Encoder::Write(const uint8_t *data, uint64_t size) { file_.Write(data, size); }
-
-void Encoder::WriteMarker(Marker marker) {
+template <typename TEncoder>
+void WriteMarkerImpl(TEncoder *encoder, Marker marker) {
   auto value = static_cast<uint8_t>(marker);
-  Write(&value, sizeof(value));
+  encoder->Write(&value, sizeof(value));
 }
 
-void Encoder::WriteBool(bool value) {
-  WriteMarker(Marker::TYPE_BOOL);
+template <typename TEncoder>
+void WriteBoolImpl(TEncoder *encoder, bool value) {
+  encoder->WriteMarker(Marker::TYPE_BOOL);
   if (value) {
-    WriteMarker(Marker::VALUE_TRUE);
+    encoder->WriteMarker(Marker::VALUE_TRUE);
   } else {
-    WriteMarker(Marker::VALUE_FALSE);
+    encoder->WriteMarker(Marker::VALUE_FALSE);
   }
 }
 
-void Encoder::WriteUint(uint64_t value) {
+template <typename TEncoder>
+void WriteUintImpl(TEncoder *encoder, uint64_t value) {
   value = utils::HostToLittleEndian(value);
-  WriteMarker(Marker::TYPE_INT);
-  Write(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+  encoder->WriteMarker(Marker::TYPE_INT);
+  encoder->Write(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
 }
 
-void Encoder::WriteDouble(double value) {
+template <typename TEncoder>
+void WriteDoubleImpl(TEncoder *encoder, double value) {
   auto value_uint = utils::MemcpyCast<uint64_t>(value);
   value_uint = utils::HostToLittleEndian(value_uint);
-  WriteMarker(Marker::TYPE_DOUBLE);
-  Write(reinterpret_cast<const uint8_t *>(&value_uint), sizeof(value_uint));
+  encoder->WriteMarker(Marker::TYPE_DOUBLE);
+  encoder->Write(reinterpret_cast<const uint8_t *>(&value_uint), sizeof(value_uint));
 }
 
-void Encoder::WriteString(const std::string_view &value) {
-  WriteMarker(Marker::TYPE_STRING);
-  WriteSize(this, value.size());
-  Write(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+template <typename TEncoder>
+void WriteStringImpl(TEncoder *encoder, const std::string_view &value) {
+  encoder->WriteMarker(Marker::TYPE_STRING);
+  WriteSize(encoder, value.size());
+  encoder->Write(reinterpret_cast<const uint8_t *>(value.data()), value.size());
 }
 
-void Encoder::WritePropertyValue(const PropertyValue &value) {
-  WriteMarker(Marker::TYPE_PROPERTY_VALUE);
+template <typename TEncoder>
+void WritePropertyValueImpl(TEncoder *encoder, const PropertyValue &value) {
+  encoder->WriteMarker(Marker::TYPE_PROPERTY_VALUE);
   switch (value.type()) {
     case PropertyValue::Type::Null: {
-      WriteMarker(Marker::TYPE_NULL);
+      encoder->WriteMarker(Marker::TYPE_NULL);
       break;
     }
     case PropertyValue::Type::Bool: {
-      WriteBool(value.ValueBool());
+      encoder->WriteBool(value.ValueBool());
       break;
     }
     case PropertyValue::Type::Int: {
-      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueInt()));
+      encoder->WriteUint(utils::MemcpyCast<uint64_t>(value.ValueInt()));
       break;
     }
     case PropertyValue::Type::Double: {
-      WriteDouble(value.ValueDouble());
+      encoder->WriteDouble(value.ValueDouble());
       break;
     }
     case PropertyValue::Type::String: {
-      WriteString(value.ValueString());
+      encoder->WriteString(value.ValueString());
       break;
     }
     case PropertyValue::Type::List: {
       const auto &list = value.ValueList();
-      WriteMarker(Marker::TYPE_LIST);
-      WriteSize(this, list.size());
+      encoder->WriteMarker(Marker::TYPE_LIST);
+      WriteSize(encoder, list.size());
       for (const auto &item : list) {
-        WritePropertyValue(item);
+        encoder->WritePropertyValue(item);
       }
       break;
     }
     case PropertyValue::Type::Map: {
       const auto &map = value.ValueMap();
-      WriteMarker(Marker::TYPE_MAP);
-      WriteSize(this, map.size());
+      encoder->WriteMarker(Marker::TYPE_MAP);
+      WriteSize(encoder, map.size());
       for (const auto &item : map) {
-        WriteString(item.first);
-        WritePropertyValue(item.second);
+        encoder->WriteString(item.first);
+        encoder->WritePropertyValue(item.second);
       }
       break;
     }
     case PropertyValue::Type::TemporalData: {
       const auto temporal_data = value.ValueTemporalData();
-      WriteMarker(Marker::TYPE_TEMPORAL_DATA);
-      WriteUint(static_cast<uint64_t>(temporal_data.type));
-      WriteUint(utils::MemcpyCast<uint64_t>(temporal_data.microseconds));
+      encoder->WriteMarker(Marker::TYPE_TEMPORAL_DATA);
+      encoder->WriteUint(static_cast<uint64_t>(temporal_data.type));
+      encoder->WriteUint(utils::MemcpyCast<uint64_t>(temporal_data.microseconds));
       break;
     }
   }
 }
+}  // namespace
+
+void Encoder::Initialize(const std::filesystem::path &path, const std::string_view &magic, uint64_t version,
+                         utils::OutputFile::IoBackend io_backend) {
+  file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING, io_backend);
+  Write(reinterpret_cast<const uint8_t *>(magic.data()), magic.size());
+  auto version_encoded = utils::HostToLittleEndian(version);
+  Write(reinterpret_cast<const uint8_t *>(&version_encoded), sizeof(version_encoded));
+}
+
+void Encoder::OpenExisting(const std::filesystem::path &path, utils::OutputFile::IoBackend io_backend) {
+  file_.Open(path, utils::OutputFile::Mode::APPEND_TO_EXISTING, io_backend);
+}
+
+void Encoder::Close() {
+  if (file_.IsOpen()) {
+    file_.Close();
+  }
+}
+
+void Encoder::Write(const uint8_t *data, uint64_t size) { file_.Write(data, size); }
+
+void Encoder::WriteMarker(Marker marker) { WriteMarkerImpl(this, marker); }
+
+void Encoder::WriteBool(bool value) { WriteBoolImpl(this, value); }
+
+void Encoder::WriteUint(uint64_t value) { WriteUintImpl(this, value); }
+
+void Encoder::WriteDouble(double value) { WriteDoubleImpl(this, value); }
+
+void Encoder::WriteString(const std::string_view &value) { WriteStringImpl(this, value); }
+
+void Encoder::WritePropertyValue(const PropertyValue &value) { WritePropertyValueImpl(this, value); }
 
 uint64_t Encoder::GetPosition() { return file_.GetPosition(); }
 
@@ -152,6 +174,24 @@ std::pair<const uint8_t *, size_t> Encoder::CurrentFileBuffer() const { return f
 
 size_t Encoder::GetSize() { return file_.GetSize(); }
 
+////////////////////////////////
+// BufferEncoder implementation.
+////////////////////////////////
+
+void BufferEncoder::Write(const uint8_t *data, uint64_t size) { buffer_.insert(buffer_.end(), data, data + size); }
+
+void BufferEncoder::WriteMarker(Marker marker) { WriteMarkerImpl(this, marker); }
+
+void BufferEncoder::WriteBool(bool value) { WriteBoolImpl(this, value); }
+
+void BufferEncoder::WriteUint(uint64_t value) { WriteUintImpl(this, value); }
+
+void BufferEncoder::WriteDouble(double value) { WriteDoubleImpl(this, value); }
+
+void BufferEncoder::WriteString(const std::string_view &value) { WriteStringImpl(this, value); }
+
+void BufferEncoder::WritePropertyValue(const PropertyValue &value) { WritePropertyValueImpl(this, value); }
+
 //////////////////////////
 // Decoder implementation.
 //////////////////////////
@@ -166,159 +206,151 @@ std::optional<Marker> CastToMarker(uint8_t value) {
   return std::nullopt;
 }
 
-std::optional<uint64_t> ReadSize(Decoder *decoder) {
+template <typename TDecoder>
+std::optional<uint64_t> ReadSize(TDecoder *decoder) {
   uint64_t size;
   if (!decoder->Read(reinterpret_cast<uint8_t *>(&size), sizeof(size))) return std::nullopt;
   size = utils::LittleEndianToHost(size);
   return size;
 }
-}  // namespace
 
-std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, const std::string &magic) {
-  if (!file_.Open(path)) return std::nullopt;
-  std::string file_magic(magic.size(), '\0');
-  if (!Read(reinterpret_cast<uint8_t *>(file_magic.data()), file_magic.size())) return std::nullopt;
-  if (file_magic != magic) return std::nullopt;
-  uint64_t version_encoded;
-  if (!Read(reinterpret_cast<uint8_t *>(&version_encoded), sizeof(version_encoded))) return std::nullopt;
-  return utils::LittleEndianToHost(version_encoded);
-}
-
-bool Decoder::Read(uint8_t *data, size_t size) { return file_.Read(data, size); }
-
-bool Decoder::Peek(uint8_t *data, size_t size) { return file_.Peek(data, size); }
-
-std::optional<Marker> Decoder::PeekMarker() {
+template <typename TDecoder>
+std::optional<Marker> PeekMarkerImpl(TDecoder *decoder) {
   uint8_t value;
-  if (!Peek(&value, sizeof(value))) return std::nullopt;
+  if (!decoder->Peek(&value, sizeof(value))) return std::nullopt;
   auto marker = CastToMarker(value);
   if (!marker) return std::nullopt;
   return *marker;
 }
 
-std::optional<Marker> Decoder::ReadMarker() {
+template <typename TDecoder>
+std::optional<Marker> ReadMarkerImpl(TDecoder *decoder) {
   uint8_t value;
-  if (!Read(&value, sizeof(value))) return std::nullopt;
+  if (!decoder->Read(&value, sizeof(value))) return std::nullopt;
   auto marker = CastToMarker(value);
   if (!marker) return std::nullopt;
   return *marker;
 }
 
-std::optional<bool> Decoder::ReadBool() {
-  auto marker = ReadMarker();
+template <typename TDecoder>
+std::optional<bool> ReadBoolImpl(TDecoder *decoder) {
+  auto marker = decoder->ReadMarker();
   if (!marker || *marker != Marker::TYPE_BOOL) return std::nullopt;
-  auto value = ReadMarker();
+  auto value = decoder->ReadMarker();
   if (!value || (*value != Marker::VALUE_FALSE && *value != Marker::VALUE_TRUE)) return std::nullopt;
   return *value == Marker::VALUE_TRUE;
 }
 
-std::optional<uint64_t> Decoder::ReadUint() {
-  auto marker = ReadMarker();
+template <typename TDecoder>
+std::optional<uint64_t> ReadUintImpl(TDecoder *decoder) {
+  auto marker = decoder->ReadMarker();
   if (!marker || *marker != Marker::TYPE_INT) return std::nullopt;
   uint64_t value;
-  if (!Read(reinterpret_cast<uint8_t *>(&value), sizeof(value))) return std::nullopt;
+  if (!decoder->Read(reinterpret_cast<uint8_t *>(&value), sizeof(value))) return std::nullopt;
   value = utils::LittleEndianToHost(value);
   return value;
 }
 
-std::optional<double> Decoder::ReadDouble() {
-  auto marker = ReadMarker();
+template <typename TDecoder>
+std::optional<double> ReadDoubleImpl(TDecoder *decoder) {
+  auto marker = decoder->ReadMarker();
   if (!marker || *marker != Marker::TYPE_DOUBLE) return std::nullopt;
   uint64_t value_int;
-  if (!Read(reinterpret_cast<uint8_t *>(&value_int), sizeof(value_int))) return std::nullopt;
+  if (!decoder->Read(reinterpret_cast<uint8_t *>(&value_int), sizeof(value_int))) return std::nullopt;
   value_int = utils::LittleEndianToHost(value_int);
   auto value = utils::MemcpyCast<double>(value_int);
   return value;
 }
 
-std::optional<std::string> Decoder::ReadString() {
-  auto marker = ReadMarker();
+template <typename TDecoder>
+std::optional<std::string> ReadStringImpl(TDecoder *decoder) {
+  auto marker = decoder->ReadMarker();
   if (!marker || *marker != Marker::TYPE_STRING) return std::nullopt;
-  auto size = ReadSize(this);
+  auto size = ReadSize(decoder);
   if (!size) return std::nullopt;
   std::string value(*size, '\0');
-  if (!Read(reinterpret_cast<uint8_t *>(value.data()), *size)) return std::nullopt;
+  if (!decoder->Read(reinterpret_cast<uint8_t *>(value.data()), *size)) return std::nullopt;
   return value;
 }
 
-namespace {
-std::optional<TemporalData> ReadTemporalData(Decoder &decoder) {
-  const auto inner_marker = decoder.ReadMarker();
+template <typename TDecoder>
+std::optional<TemporalData> ReadTemporalData(TDecoder *decoder) {
+  const auto inner_marker = decoder->ReadMarker();
   if (!inner_marker || *inner_marker != Marker::TYPE_TEMPORAL_DATA) return std::nullopt;
 
-  const auto type = decoder.ReadUint();
+  const auto type = decoder->ReadUint();
   if (!type) return std::nullopt;
 
-  const auto microseconds = decoder.ReadUint();
+  const auto microseconds = decoder->ReadUint();
   if (!microseconds) return std::nullopt;
 
   return TemporalData{static_cast<TemporalType>(*type), utils::MemcpyCast<int64_t>(*microseconds)};
 }
-}  // namespace
 
-std::optional<PropertyValue> Decoder::ReadPropertyValue() {
-  auto pv_marker = ReadMarker();
+template <typename TDecoder>
+std::optional<PropertyValue> ReadPropertyValueImpl(TDecoder *decoder) {
+  auto pv_marker = decoder->ReadMarker();
   if (!pv_marker || *pv_marker != Marker::TYPE_PROPERTY_VALUE) return std::nullopt;
 
-  auto marker = PeekMarker();
+  auto marker = decoder->PeekMarker();
   if (!marker) return std::nullopt;
   switch (*marker) {
     case Marker::TYPE_NULL: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       if (!inner_marker || *inner_marker != Marker::TYPE_NULL) return std::nullopt;
       return PropertyValue();
     }
     case Marker::TYPE_BOOL: {
-      auto value = ReadBool();
+      auto value = decoder->ReadBool();
       if (!value) return std::nullopt;
       return PropertyValue(*value);
     }
     case Marker::TYPE_INT: {
-      auto value = ReadUint();
+      auto value = decoder->ReadUint();
       if (!value) return std::nullopt;
       return PropertyValue(utils::MemcpyCast<int64_t>(*value));
     }
     case Marker::TYPE_DOUBLE: {
-      auto value = ReadDouble();
+      auto value = decoder->ReadDouble();
       if (!value) return std::nullopt;
       return PropertyValue(*value);
     }
     case Marker::TYPE_STRING: {
-      auto value = ReadString();
+      auto value = decoder->ReadString();
       if (!value) return std::nullopt;
       return PropertyValue(std::move(*value));
     }
     case Marker::TYPE_LIST: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       if (!inner_marker || *inner_marker != Marker::TYPE_LIST) return std::nullopt;
-      auto size = ReadSize(this);
+      auto size = ReadSize(decoder);
       if (!size) return std::nullopt;
       std::vector<PropertyValue> value;
       value.reserve(*size);
       for (uint64_t i = 0; i < *size; ++i) {
-        auto item = ReadPropertyValue();
+        auto item = decoder->ReadPropertyValue();
         if (!item) return std::nullopt;
         value.emplace_back(std::move(*item));
       }
       return PropertyValue(std::move(value));
     }
     case Marker::TYPE_MAP: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       if (!inner_marker || *inner_marker != Marker::TYPE_MAP) return std::nullopt;
-      auto size = ReadSize(this);
+      auto size = ReadSize(decoder);
       if (!size) return std::nullopt;
       std::map<std::string, PropertyValue> value;
       for (uint64_t i = 0; i < *size; ++i) {
-        auto key = ReadString();
+        auto key = decoder->ReadString();
         if (!key) return std::nullopt;
-        auto item = ReadPropertyValue();
+        auto item = decoder->ReadPropertyValue();
         if (!item) return std::nullopt;
         value.emplace(std::move(*key), std::move(*item));
       }
       return PropertyValue(std::move(value));
     }
     case Marker::TYPE_TEMPORAL_DATA: {
-      const auto maybe_temporal_data = ReadTemporalData(*this);
+      const auto maybe_temporal_data = ReadTemporalData(decoder);
       if (!maybe_temporal_data) return std::nullopt;
       return PropertyValue(*maybe_temporal_data);
     }
@@ -332,6 +364,9 @@ std::optional<PropertyValue> Decoder::ReadPropertyValue() {
     case Marker::SECTION_CONSTRAINTS:
     case Marker::SECTION_DELTA:
     case Marker::SECTION_EPOCH_HISTORY:
+    case Marker::SECTION_BLOCK:
+    case Marker::SECTION_BLOCK_INDEX:
+    case Marker::SECTION_DELETED:
     case Marker::SECTION_OFFSETS:
     case Marker::DELTA_VERTEX_CREATE:
     case Marker::DELTA_VERTEX_DELETE:
@@ -350,76 +385,65 @@ std::optional<PropertyValue> Decoder::ReadPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP:
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+    case Marker::DELTA_TEXT_INDEX_DROP:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return std::nullopt;
   }
 }
 
-bool Decoder::SkipString() {
-  auto marker = ReadMarker();
-  if (!marker || *marker != Marker::TYPE_STRING) return false;
-  auto maybe_size = ReadSize(this);
-  if (!maybe_size) return false;
-
-  const uint64_t kBufferSize = 262144;
-  uint8_t buffer[kBufferSize];
-  uint64_t size = *maybe_size;
-  while (size > 0) {
-    uint64_t to_read = size < kBufferSize ? size : kBufferSize;
-    if (!Read(reinterpret_cast<uint8_t *>(&buffer), to_read)) return false;
-    size -= to_read;
-  }
-
-  return true;
-}
-
-bool Decoder::SkipPropertyValue() {
-  auto pv_marker = ReadMarker();
+template <typename TDecoder>
+bool SkipPropertyValueImpl(TDecoder *decoder) {
+  auto pv_marker = decoder->ReadMarker();
   if (!pv_marker || *pv_marker != Marker::TYPE_PROPERTY_VALUE) return false;
 
-  auto marker = PeekMarker();
+  auto marker = decoder->PeekMarker();
   if (!marker) return false;
   switch (*marker) {
     case Marker::TYPE_NULL: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       return inner_marker && *inner_marker == Marker::TYPE_NULL;
     }
     case Marker::TYPE_BOOL: {
-      return !!ReadBool();
+      return !!decoder->ReadBool();
     }
     case Marker::TYPE_INT: {
-      return !!ReadUint();
+      return !!decoder->ReadUint();
     }
     case Marker::TYPE_DOUBLE: {
-      return !!ReadDouble();
+      return !!decoder->ReadDouble();
     }
     case Marker::TYPE_STRING: {
-      return SkipString();
+      return decoder->SkipString();
     }
     case Marker::TYPE_LIST: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       if (!inner_marker || *inner_marker != Marker::TYPE_LIST) return false;
-      auto size = ReadSize(this);
+      auto size = ReadSize(decoder);
       if (!size) return false;
       for (uint64_t i = 0; i < *size; ++i) {
-        if (!SkipPropertyValue()) return false;
+        if (!decoder->SkipPropertyValue()) return false;
       }
       return true;
     }
     case Marker::TYPE_MAP: {
-      auto inner_marker = ReadMarker();
+      auto inner_marker = decoder->ReadMarker();
       if (!inner_marker || *inner_marker != Marker::TYPE_MAP) return false;
-      auto size = ReadSize(this);
+      auto size = ReadSize(decoder);
       if (!size) return false;
       for (uint64_t i = 0; i < *size; ++i) {
-        if (!SkipString()) return false;
-        if (!SkipPropertyValue()) return false;
+        if (!decoder->SkipString()) return false;
+        if (!decoder->SkipPropertyValue()) return false;
       }
       return true;
     }
     case Marker::TYPE_TEMPORAL_DATA: {
-      return !!ReadTemporalData(*this);
+      return !!ReadTemporalData(decoder);
     }
 
     case Marker::TYPE_PROPERTY_VALUE:
@@ -431,6 +455,9 @@ bool Decoder::SkipPropertyValue() {
     case Marker::SECTION_CONSTRAINTS:
     case Marker::SECTION_DELTA:
     case Marker::SECTION_EPOCH_HISTORY:
+    case Marker::SECTION_BLOCK:
+    case Marker::SECTION_BLOCK_INDEX:
+    case Marker::SECTION_DELETED:
     case Marker::SECTION_OFFSETS:
     case Marker::DELTA_VERTEX_CREATE:
     case Marker::DELTA_VERTEX_DELETE:
@@ -449,11 +476,66 @@ bool Decoder::SkipPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP:
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+    case Marker::DELTA_TEXT_INDEX_DROP:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return false;
   }
 }
+}  // namespace
+
+std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, const std::string &magic) {
+  if (!file_.Open(path)) return std::nullopt;
+  std::string file_magic(magic.size(), '\0');
+  if (!Read(reinterpret_cast<uint8_t *>(file_magic.data()), file_magic.size())) return std::nullopt;
+  if (file_magic != magic) return std::nullopt;
+  uint64_t version_encoded;
+  if (!Read(reinterpret_cast<uint8_t *>(&version_encoded), sizeof(version_encoded))) return std::nullopt;
+  return utils::LittleEndianToHost(version_encoded);
+}
+
+bool Decoder::Read(uint8_t *data, size_t size) { return file_.Read(data, size); }
+
+bool Decoder::Peek(uint8_t *data, size_t size) { return file_.Peek(data, size); }
+
+std::optional<Marker> Decoder::PeekMarker() { return PeekMarkerImpl(this); }
+
+std::optional<Marker> Decoder::ReadMarker() { return ReadMarkerImpl(this); }
+
+std::optional<bool> Decoder::ReadBool() { return ReadBoolImpl(this); }
+
+std::optional<uint64_t> Decoder::ReadUint() { return ReadUintImpl(this); }
+
+std::optional<double> Decoder::ReadDouble() { return ReadDoubleImpl(this); }
+
+std::optional<std::string> Decoder::ReadString() { return ReadStringImpl(this); }
+
+std::optional<PropertyValue> Decoder::ReadPropertyValue() { return ReadPropertyValueImpl(this); }
+
+bool Decoder::SkipString() {
+  auto marker = ReadMarker();
+  if (!marker || *marker != Marker::TYPE_STRING) return false;
+  auto maybe_size = ReadSize(this);
+  if (!maybe_size) return false;
+
+  const uint64_t kBufferSize = 262144;
+  uint8_t buffer[kBufferSize];
+  uint64_t size = *maybe_size;
+  while (size > 0) {
+    uint64_t to_read = size < kBufferSize ? size : kBufferSize;
+    if (!Read(reinterpret_cast<uint8_t *>(&buffer), to_read)) return false;
+    size -= to_read;
+  }
+
+  return true;
+}
+
+bool Decoder::SkipPropertyValue() { return SkipPropertyValueImpl(this); }
 
 std::optional<uint64_t> Decoder::GetSize() { return file_.GetSize(); }
 
@@ -461,4 +543,45 @@ std::optional<uint64_t> Decoder::GetPosition() { return file_.GetPosition(); }
 
 bool Decoder::SetPosition(uint64_t position) { return !!file_.SetPosition(utils::InputFile::Position::SET, position); }
 
+////////////////////////////////
+// BufferDecoder implementation.
+////////////////////////////////
+
+bool BufferDecoder::Read(uint8_t *data, size_t size) {
+  if (!Peek(data, size)) return false;
+  position_ += size;
+  return true;
+}
+
+bool BufferDecoder::Peek(uint8_t *data, size_t size) {
+  if (size > size_ - position_) return false;
+  memcpy(data, data_ + position_, size);
+  return true;
+}
+
+std::optional<Marker> BufferDecoder::PeekMarker() { return PeekMarkerImpl(this); }
+
+std::optional<Marker> BufferDecoder::ReadMarker() { return ReadMarkerImpl(this); }
+
+std::optional<bool> BufferDecoder::ReadBool() { return ReadBoolImpl(this); }
+
+std::optional<uint64_t> BufferDecoder::ReadUint() { return ReadUintImpl(this); }
+
+std::optional<double> BufferDecoder::ReadDouble() { return ReadDoubleImpl(this); }
+
+std::optional<std::string> BufferDecoder::ReadString() { return ReadStringImpl(this); }
+
+std::optional<PropertyValue> BufferDecoder::ReadPropertyValue() { return ReadPropertyValueImpl(this); }
+
+bool BufferDecoder::SkipString() {
+  auto marker = ReadMarker();
+  if (!marker || *marker != Marker::TYPE_STRING) return false;
+  auto size = ReadSize(this);
+  if (!size || *size > size_ - position_) return false;
+  position_ += *size;
+  return true;
+}
+
+bool BufferDecoder::SkipPropertyValue() { return SkipPropertyValueImpl(this); }
+
 }  // namespace memgraph::storage::durability
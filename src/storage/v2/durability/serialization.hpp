@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <string_view>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/durability/marker.hpp"
@@ -41,9 +42,11 @@ class BaseEncoder {
 /// Encoder that is used to generate a snapshot/WAL.
 class Encoder final : public BaseEncoder {
  public:
-  void Initialize(const std::filesystem::path &path, const std::string_view &magic, uint64_t version);
+  void Initialize(const std::filesystem::path &path, const std::string_view &magic, uint64_t version,
+                  utils::OutputFile::IoBackend io_backend = utils::OutputFile::IoBackend::SYSCALL);
 
-  void OpenExisting(const std::filesystem::path &path);
+  void OpenExisting(const std::filesystem::path &path,
+                    utils::OutputFile::IoBackend io_backend = utils::OutputFile::IoBackend::SYSCALL);
 
   void Close();
   // Main write function, the only one that is allowed to write to the `file_`
@@ -80,6 +83,27 @@ class Encoder final : public BaseEncoder {
   utils::OutputFile file_;
 };
 
+/// Encoder that writes into an in-memory buffer. Used to encode parts of a
+/// snapshot in parallel; the buffers are then appended to the file in order.
+class BufferEncoder final : public BaseEncoder {
+ public:
+  void Write(const uint8_t *data, uint64_t size);
+
+  void WriteMarker(Marker marker) override;
+  void WriteBool(bool value) override;
+  void WriteUint(uint64_t value) override;
+  void WriteDouble(double value) override;
+  void WriteString(const std::string_view &value) override;
+  void WritePropertyValue(const PropertyValue &value) override;
+
+  const uint8_t *data() const { return buffer_.data(); }
+  size_t size() const { return buffer_.size(); }
+  void Clear() { buffer_.clear(); }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
 /// Decoder interface class. Used to implement streams from different sources
 /// (e.g. file and network).
 class BaseDecoder {
@@ -128,4 +152,35 @@ class Decoder final : public BaseDecoder {
   utils::InputFile file_;
 };
 
+/// Decoder that reads from an in-memory buffer. Used to decode the
+/// decompressed blocks of a snapshot. The buffer isn't owned by the decoder
+/// and must outlive it.
+class BufferDecoder final : public BaseDecoder {
+ public:
+  BufferDecoder(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+  bool Read(uint8_t *data, size_t size);
+  bool Peek(uint8_t *data, size_t size);
+
+  std::optional<Marker> PeekMarker();
+
+  std::optional<Marker> ReadMarker() override;
+  std::optional<bool> ReadBool() override;
+  std::optional<uint64_t> ReadUint() override;
+  std::optional<double> ReadDouble() override;
+  std::optional<std::string> ReadString() override;
+  std::optional<PropertyValue> ReadPropertyValue() override;
+
+  bool SkipString() override;
+  bool SkipPropertyValue() override;
+
+  size_t GetPosition() const { return position_; }
+  size_t GetSize() const { return size_; }
+
+ private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t position_{0};
+};
+
 }  // namespace memgraph::storage::durability
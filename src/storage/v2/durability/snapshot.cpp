@@ -11,6 +11,15 @@
 
 #include "storage/v2/durability/snapshot.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "storage/v2/durability/compression.hpp"
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/serialization.hpp"
@@ -23,6 +32,7 @@
 #include "utils/file_locker.hpp"
 #include "utils/logging.hpp"
 #include "utils/message.hpp"
+#include "utils/parallel_for.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -40,6 +50,15 @@ namespace memgraph::storage::durability {
 //     * offset to the constraints section
 //     * offset to the mapper section
 //     * offset to the metadata section
+//     * offset to the block index section (from version 18)
+//     * offset to the deleted objects section (from version 20, `0` for full
+//       snapshots)
+//
+// From version 18 the edges and vertices are grouped into blocks that are
+// compressed with zlib. Each block is written in the following format:
+//     * uncompressed size
+//     * compressed size
+//     * compressed data (non-encoded), which contains the encoded objects
 //
 // 4) Encoded edges (if properties on edges are enabled); each edge is written
 //    in the following format:
@@ -65,6 +84,11 @@ namespace memgraph::storage::durability {
 //     * label+property indices
 //         * label
 //         * property
+//     * edge type indices (from version 15)
+//         * edge type
+//     * label+properties indices (from version 16)
+//         * label
+//         * properties in the order of the index key
 //
 // 7) Constraints
 //     * existence constraints
@@ -86,10 +110,111 @@ namespace memgraph::storage::durability {
 //       applied)
 //     * number of edges
 //     * number of vertices
+//     * whether the snapshot is differential (from version 20)
+//     * base snapshot transaction start timestamp (only for differential
+//       snapshots)
+//
+// From version 20 a snapshot can be differential. A differential snapshot
+// contains only the edges and vertices that were modified after its base
+// snapshot was created and it is applied on top of the base snapshot during
+// recovery. The objects that were deleted are stored in a separate section:
+//     * deleted edge gids
+//     * deleted vertex gids
 //
 // IMPORTANT: When changing snapshot encoding/decoding bump the snapshot/WAL
 // version in `version.hpp`.
 
+namespace {
+
+// Number of objects that are stored in a single snapshot block.
+constexpr uint64_t kSnapshotBlockSize = 10000;
+
+struct SnapshotBlock {
+  uint64_t offset;
+  uint64_t count;
+};
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::filesystem::path &path) {
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ == -1) throw RecoveryFailure(fmt::format("Couldn't open snapshot {}: {}", path, strerror(errno)));
+    struct stat info {};
+    if (fstat(fd_, &info) == -1) {
+      close(fd_);
+      throw RecoveryFailure(fmt::format("Couldn't stat snapshot {}: {}", path, strerror(errno)));
+    }
+    size_ = info.st_size;
+    if (size_ == 0) return;
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (data_ == MAP_FAILED) {
+      close(fd_);
+      throw RecoveryFailure(fmt::format("Couldn't map snapshot {}: {}", path, strerror(errno)));
+    }
+    // The whole file is going to be read, so let the kernel read ahead.
+    madvise(data_, size_, MADV_WILLNEED);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&) = delete;
+  MappedFile &operator=(MappedFile &&) = delete;
+
+  ~MappedFile() {
+    if (data_ != nullptr) munmap(data_, size_);
+    close(fd_);
+  }
+
+  const uint8_t *data() const { return static_cast<const uint8_t *>(data_); }
+  size_t size() const { return size_; }
+
+ private:
+  int fd_{-1};
+  void *data_{nullptr};
+  size_t size_{0};
+};
+
+// Reads and decompresses the block at `offset` into `buffer`.
+void ReadBlock(const MappedFile &file, uint64_t offset, std::vector<uint8_t> *buffer) {
+  if (offset >= file.size()) throw RecoveryFailure("Invalid snapshot data!");
+  BufferDecoder decoder(file.data() + offset, file.size() - offset);
+  auto marker = decoder.ReadMarker();
+  if (!marker || *marker != Marker::SECTION_BLOCK) throw RecoveryFailure("Invalid snapshot data!");
+  auto uncompressed_size = decoder.ReadUint();
+  if (!uncompressed_size) throw RecoveryFailure("Invalid snapshot data!");
+  auto compressed_size = decoder.ReadUint();
+  if (!compressed_size) throw RecoveryFailure("Invalid snapshot data!");
+  if (*compressed_size > decoder.GetSize() - decoder.GetPosition()) throw RecoveryFailure("Invalid snapshot data!");
+  if (!DecompressBlock(file.data() + offset + decoder.GetPosition(), *compressed_size, *uncompressed_size, buffer))
+    throw RecoveryFailure("Couldn't decompress snapshot block!");
+}
+
+// Reads the block index of the snapshot.
+void ReadBlockIndex(Decoder *snapshot, const SnapshotInfo &info, std::vector<SnapshotBlock> *edge_blocks,
+                    std::vector<SnapshotBlock> *vertex_blocks) {
+  if (!snapshot->SetPosition(info.offset_block_index)) throw RecoveryFailure("Couldn't read data from snapshot!");
+
+  auto marker = snapshot->ReadMarker();
+  if (!marker || *marker != Marker::SECTION_BLOCK_INDEX) throw RecoveryFailure("Invalid snapshot data!");
+
+  auto read_blocks = [snapshot](std::vector<SnapshotBlock> *blocks) {
+    auto size = snapshot->ReadUint();
+    if (!size) throw RecoveryFailure("Invalid snapshot data!");
+    for (uint64_t i = 0; i < *size; ++i) {
+      auto offset = snapshot->ReadUint();
+      if (!offset) throw RecoveryFailure("Invalid snapshot data!");
+      auto count = snapshot->ReadUint();
+      if (!count || *count == 0) throw RecoveryFailure("Invalid snapshot data!");
+      blocks->push_back({*offset, *count});
+    }
+  };
+  read_blocks(edge_blocks);
+  read_blocks(vertex_blocks);
+}
+
+}  // namespace
+
 // Function used to read information about the snapshot file.
 SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
   // Check magic and version.
@@ -124,6 +249,12 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
     info.offset_mapper = read_offset();
     info.offset_epoch_history = read_offset();
     info.offset_metadata = read_offset();
+    if (*version >= kCompressedSnapshotVersion) {
+      info.offset_block_index = read_offset();
+    }
+    if (*version >= kDifferentialSnapshotVersion) {
+      info.offset_deleted = read_offset();
+    }
   }
 
   // Read metadata.
@@ -152,15 +283,25 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
     auto maybe_vertices = snapshot.ReadUint();
     if (!maybe_vertices) throw RecoveryFailure("Invalid snapshot data!");
     info.vertices_count = *maybe_vertices;
+
+    if (*version >= kDifferentialSnapshotVersion) {
+      auto maybe_differential = snapshot.ReadBool();
+      if (!maybe_differential) throw RecoveryFailure("Invalid snapshot data!");
+      if (*maybe_differential) {
+        auto maybe_base_timestamp = snapshot.ReadUint();
+        if (!maybe_base_timestamp) throw RecoveryFailure("Invalid snapshot data!");
+        info.base_start_timestamp = *maybe_base_timestamp;
+      }
+    }
   }
 
   return info;
 }
 
-RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
-                               utils::SkipList<Edge> *edges,
+RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, VerticesContainer *vertices, EdgesContainer *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items) {
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                               uint64_t thread_count) {
   RecoveryInfo ret;
   RecoveredIndicesAndConstraints indices_constraints;
 
@@ -181,7 +322,15 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
 
   // Read snapshot info.
   const auto info = ReadSnapshotInfo(path);
-  spdlog::info("Recovering {} vertices and {} edges.", info.vertices_count, info.edges_count);
+  // The objects of a differential snapshot replace the objects that were
+  // recovered from its base snapshot.
+  const bool differential = info.base_start_timestamp.has_value();
+  if (differential) {
+    spdlog::info("Applying {} modified vertices and {} modified edges on top of the snapshot with timestamp {}.",
+                 info.vertices_count, info.edges_count, *info.base_start_timestamp);
+  } else {
+    spdlog::info("Recovering {} vertices and {} edges.", info.vertices_count, info.edges_count);
+  }
   // Check for edges.
   bool snapshot_has_edges = info.offset_edges != 0;
 
@@ -224,270 +373,428 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   };
 
   // Reset current edge count.
-  edge_count->store(0, std::memory_order_release);
-
-  {
-    // Recover edges.
-    auto edge_acc = edges->access();
-    uint64_t last_edge_gid = 0;
-    if (snapshot_has_edges) {
-      spdlog::info("Recovering {} edges.", info.edges_count);
-      if (!snapshot.SetPosition(info.offset_edges)) throw RecoveryFailure("Couldn't read data from snapshot!");
-      for (uint64_t i = 0; i < info.edges_count; ++i) {
-        {
-          const auto marker = snapshot.ReadMarker();
-          if (!marker || *marker != Marker::SECTION_EDGE) throw RecoveryFailure("Invalid snapshot data!");
-        }
+  if (!differential) edge_count->store(0, std::memory_order_release);
 
-        if (items.properties_on_edges) {
-          // Insert edge.
-          auto gid = snapshot.ReadUint();
-          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-          if (i > 0 && *gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = *gid;
-          spdlog::debug("Recovering edge {} with properties.", *gid);
-          auto [it, inserted] = edge_acc.insert(Edge{Gid::FromUint(*gid), nullptr});
-          if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
-
-          // Recover properties.
-          {
-            auto props_size = snapshot.ReadUint();
-            if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-            auto &props = it->properties;
-            for (uint64_t j = 0; j < *props_size; ++j) {
-              auto key = snapshot.ReadUint();
-              if (!key) throw RecoveryFailure("Invalid snapshot data!");
-              auto value = snapshot.ReadPropertyValue();
-              if (!value) throw RecoveryFailure("Invalid snapshot data!");
-              SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for edge {}.",
-                           name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
-              props.SetProperty(get_property_from_id(*key), *value);
-            }
-          }
-        } else {
-          // Read edge GID.
-          auto gid = snapshot.ReadUint();
-          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-          if (i > 0 && *gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = *gid;
-
-          spdlog::debug("Ensuring edge {} doesn't have any properties.", *gid);
-          // Read properties.
-          {
-            auto props_size = snapshot.ReadUint();
-            if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-            if (*props_size != 0)
-              throw RecoveryFailure(
-                  "The snapshot has properties on edges, but the storage is "
-                  "configured without properties on edges!");
-          }
-        }
-      }
-      spdlog::info("Edges are recovered.");
+  // Recovers the next edge and returns its GID.
+  auto recover_edge = [&](BaseDecoder *decoder, EdgesContainer::Accessor *edge_acc) {
+    {
+      const auto marker = decoder->ReadMarker();
+      if (!marker || *marker != Marker::SECTION_EDGE) throw RecoveryFailure("Invalid snapshot data!");
     }
 
-    // Recover vertices (labels and properties).
-    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
-    auto vertex_acc = vertices->access();
-    uint64_t last_vertex_gid = 0;
-    spdlog::info("Recovering {} vertices.", info.vertices_count);
-    for (uint64_t i = 0; i < info.vertices_count; ++i) {
-      {
-        auto marker = snapshot.ReadMarker();
-        if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
-      }
-
-      // Insert vertex.
-      auto gid = snapshot.ReadUint();
-      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-      if (i > 0 && *gid <= last_vertex_gid) {
-        throw RecoveryFailure("Invalid snapshot data!");
-      }
-      last_vertex_gid = *gid;
-      spdlog::debug("Recovering vertex {}.", *gid);
-      auto [it, inserted] = vertex_acc.insert(Vertex{Gid::FromUint(*gid), nullptr});
-      if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
-
-      // Recover labels.
-      spdlog::trace("Recovering labels for vertex {}.", *gid);
-      {
-        auto labels_size = snapshot.ReadUint();
-        if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
-        auto &labels = it->labels;
-        labels.reserve(*labels_size);
-        for (uint64_t j = 0; j < *labels_size; ++j) {
-          auto label = snapshot.ReadUint();
-          if (!label) throw RecoveryFailure("Invalid snapshot data!");
-          SPDLOG_TRACE("Recovered label \"{}\" for vertex {}.", name_id_mapper->IdToName(snapshot_id_map.at(*label)),
-                       *gid);
-          labels.emplace_back(get_label_from_id(*label));
-        }
+    auto gid = decoder->ReadUint();
+    if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+    if (items.properties_on_edges) {
+      // Insert edge.
+      spdlog::debug("Recovering edge {} with properties.", *gid);
+      auto [it, inserted] = edge_acc->insert(Edge{Gid::FromUint(*gid), nullptr});
+      if (!inserted) {
+        if (!differential) throw RecoveryFailure("The edge must be inserted here!");
+        it->properties.ClearProperties();
       }
 
       // Recover properties.
-      spdlog::trace("Recovering properties for vertex {}.", *gid);
       {
-        auto props_size = snapshot.ReadUint();
+        auto props_size = decoder->ReadUint();
         if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
         auto &props = it->properties;
         for (uint64_t j = 0; j < *props_size; ++j) {
-          auto key = snapshot.ReadUint();
+          auto key = decoder->ReadUint();
           if (!key) throw RecoveryFailure("Invalid snapshot data!");
-          auto value = snapshot.ReadPropertyValue();
+          auto value = decoder->ReadPropertyValue();
           if (!value) throw RecoveryFailure("Invalid snapshot data!");
-          SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for vertex {}.",
+          SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for edge {}.",
                        name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
           props.SetProperty(get_property_from_id(*key), *value);
         }
       }
-
-      // Skip in edges.
+    } else {
+      spdlog::debug("Ensuring edge {} doesn't have any properties.", *gid);
+      // Read properties.
       {
-        auto in_size = snapshot.ReadUint();
-        if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *in_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto from_gid = snapshot.ReadUint();
-          if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+        auto props_size = decoder->ReadUint();
+        if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+        if (*props_size != 0)
+          throw RecoveryFailure(
+              "The snapshot has properties on edges, but the storage is "
+              "configured without properties on edges!");
+      }
+    }
+    return *gid;
+  };
+
+  // Recovers the next vertex with its labels and properties and returns its
+  // GID. The edges of the vertex are skipped.
+  auto recover_vertex = [&](BaseDecoder *decoder, VerticesContainer::Accessor *vertex_acc) {
+    {
+      auto marker = decoder->ReadMarker();
+      if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
+    }
+
+    // Insert vertex.
+    auto gid = decoder->ReadUint();
+    if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+    spdlog::debug("Recovering vertex {}.", *gid);
+    auto [it, inserted] = vertex_acc->insert(Vertex{Gid::FromUint(*gid), nullptr});
+    if (!inserted) {
+      if (!differential) throw RecoveryFailure("The vertex must be inserted here!");
+      it->labels.clear();
+      it->properties.ClearProperties();
+    }
+
+    // Recover labels.
+    spdlog::trace("Recovering labels for vertex {}.", *gid);
+    {
+      auto labels_size = decoder->ReadUint();
+      if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
+      auto &labels = it->labels;
+      labels.reserve(*labels_size);
+      for (uint64_t j = 0; j < *labels_size; ++j) {
+        auto label = decoder->ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        SPDLOG_TRACE("Recovered label \"{}\" for vertex {}.", name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     *gid);
+        labels.emplace_back(get_label_from_id(*label));
+      }
+    }
+
+    // Recover properties.
+    spdlog::trace("Recovering properties for vertex {}.", *gid);
+    {
+      auto props_size = decoder->ReadUint();
+      if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+      auto &props = it->properties;
+      for (uint64_t j = 0; j < *props_size; ++j) {
+        auto key = decoder->ReadUint();
+        if (!key) throw RecoveryFailure("Invalid snapshot data!");
+        auto value = decoder->ReadPropertyValue();
+        if (!value) throw RecoveryFailure("Invalid snapshot data!");
+        SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for vertex {}.",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
+        props.SetProperty(get_property_from_id(*key), *value);
+      }
+    }
+
+    // Skip in edges.
+    {
+      auto in_size = decoder->ReadUint();
+      if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
+      for (uint64_t j = 0; j < *in_size; ++j) {
+        auto edge_gid = decoder->ReadUint();
+        if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+        auto from_gid = decoder->ReadUint();
+        if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
+        auto edge_type = decoder->ReadUint();
+        if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+      }
+    }
+
+    // Skip out edges.
+    auto out_size = decoder->ReadUint();
+    if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
+    for (uint64_t j = 0; j < *out_size; ++j) {
+      auto edge_gid = decoder->ReadUint();
+      if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+      auto to_gid = decoder->ReadUint();
+      if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
+      auto edge_type = decoder->ReadUint();
+      if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+    }
+    return *gid;
+  };
+
+  // Recovers the in/out edges of the next vertex, which is returned by
+  // `get_vertex` for the GID of the vertex, and returns its GID. The largest
+  // recovered edge GID is stored into `last_edge_gid`.
+  auto recover_connectivity = [&](BaseDecoder *decoder, const auto &get_vertex,
+                                  VerticesContainer::Accessor *vertex_acc,
+                                  EdgesContainer::Accessor *edge_acc, uint64_t *last_edge_gid) {
+    {
+      auto marker = decoder->ReadMarker();
+      if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
+    }
+
+    // Check vertex.
+    auto gid = decoder->ReadUint();
+    if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+    Vertex &vertex = get_vertex(*gid);
+    spdlog::trace("Recovering connectivity for vertex {}.", vertex.gid.AsUint());
+
+    // Skip labels.
+    {
+      auto labels_size = decoder->ReadUint();
+      if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
+      for (uint64_t j = 0; j < *labels_size; ++j) {
+        auto label = decoder->ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+      }
+    }
+
+    // Skip properties.
+    {
+      auto props_size = decoder->ReadUint();
+      if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+      for (uint64_t j = 0; j < *props_size; ++j) {
+        auto key = decoder->ReadUint();
+        if (!key) throw RecoveryFailure("Invalid snapshot data!");
+        auto value = decoder->SkipPropertyValue();
+        if (!value) throw RecoveryFailure("Invalid snapshot data!");
+      }
+    }
+
+    // Returns the reference to the edge with the given GID.
+    auto get_edge_ref = [&](uint64_t edge_gid) {
+      EdgeRef edge_ref(Gid::FromUint(edge_gid));
+      if (items.properties_on_edges) {
+        if (snapshot_has_edges) {
+          auto edge = edge_acc->find(Gid::FromUint(edge_gid));
+          if (edge == edge_acc->end()) throw RecoveryFailure("Invalid edge!");
+          edge_ref = EdgeRef(&*edge);
+        } else {
+          auto [edge, inserted] = edge_acc->insert(Edge{Gid::FromUint(edge_gid), nullptr});
+          edge_ref = EdgeRef(&*edge);
         }
       }
+      return edge_ref;
+    };
+
+    // The connectivity of a vertex from a differential snapshot replaces its
+    // connectivity from the base snapshot.
+    if (!vertex.out_edges.empty()) edge_count->fetch_sub(vertex.out_edges.size(), std::memory_order_acq_rel);
+    vertex.in_edges.clear();
+    vertex.out_edges.clear();
+
+    // Recover in edges.
+    {
+      spdlog::trace("Recovering inbound edges for vertex {}.", vertex.gid.AsUint());
+      auto in_size = decoder->ReadUint();
+      if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
+      vertex.in_edges.reserve(*in_size);
+      for (uint64_t j = 0; j < *in_size; ++j) {
+        auto edge_gid = decoder->ReadUint();
+        if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+        *last_edge_gid = std::max(*last_edge_gid, *edge_gid);
+
+        auto from_gid = decoder->ReadUint();
+        if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
+        auto edge_type = decoder->ReadUint();
+        if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+
+        auto from_vertex = vertex_acc->find(Gid::FromUint(*from_gid));
+        if (from_vertex == vertex_acc->end()) throw RecoveryFailure("Invalid from vertex!");
+
+        auto edge_ref = get_edge_ref(*edge_gid);
+        SPDLOG_TRACE("Recovered inbound edge {} with label \"{}\" from vertex {}.", *edge_gid,
+                     name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), from_vertex->gid.AsUint());
+        vertex.in_edges.emplace_back(get_edge_type_from_id(*edge_type), &*from_vertex, edge_ref);
+      }
+    }
 
-      // Skip out edges.
-      auto out_size = snapshot.ReadUint();
+    // Recover out edges.
+    {
+      spdlog::trace("Recovering outbound edges for vertex {}.", vertex.gid.AsUint());
+      auto out_size = decoder->ReadUint();
       if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
+      vertex.out_edges.reserve(*out_size);
       for (uint64_t j = 0; j < *out_size; ++j) {
-        auto edge_gid = snapshot.ReadUint();
+        auto edge_gid = decoder->ReadUint();
         if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-        auto to_gid = snapshot.ReadUint();
+        *last_edge_gid = std::max(*last_edge_gid, *edge_gid);
+
+        auto to_gid = decoder->ReadUint();
         if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
-        auto edge_type = snapshot.ReadUint();
+        auto edge_type = decoder->ReadUint();
         if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+
+        auto to_vertex = vertex_acc->find(Gid::FromUint(*to_gid));
+        if (to_vertex == vertex_acc->end()) throw RecoveryFailure("Invalid to vertex!");
+
+        auto edge_ref = get_edge_ref(*edge_gid);
+        SPDLOG_TRACE("Recovered outbound edge {} with label \"{}\" to vertex {}.", *edge_gid,
+                     name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), to_vertex->gid.AsUint());
+        vertex.out_edges.emplace_back(get_edge_type_from_id(*edge_type), &*to_vertex, edge_ref);
       }
+      // Increment edge count. We only increment the count here because the
+      // information is duplicated in in_edges.
+      edge_count->fetch_add(*out_size, std::memory_order_acq_rel);
     }
-    spdlog::info("Vertices are recovered.");
+    return *gid;
+  };
 
-    // Recover vertices (in/out edges).
-    spdlog::info("Recovering connectivity.");
-    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
-    for (auto &vertex : vertex_acc) {
-      {
-        auto marker = snapshot.ReadMarker();
-        if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
+  uint64_t last_edge_gid = 0;
+  uint64_t last_vertex_gid = 0;
+  if (*version >= kCompressedSnapshotVersion) {
+    // The edges and vertices are stored in compressed blocks. The file is
+    // mapped into memory and the blocks are decompressed and decoded by
+    // `thread_count` threads. All vertices are inserted before the
+    // connectivity is recovered because the edges reference vertices from
+    // other blocks.
+    MappedFile file(path);
+    std::vector<SnapshotBlock> edge_blocks;
+    std::vector<SnapshotBlock> vertex_blocks;
+    ReadBlockIndex(&snapshot, info, &edge_blocks, &vertex_blocks);
+
+    // Checks that the blocks contain the expected number of objects and that
+    // their GIDs are strictly increasing. Returns the last GID.
+    auto check_blocks = [](const std::vector<SnapshotBlock> &blocks,
+                           const std::vector<std::pair<uint64_t, uint64_t>> &gid_ranges, uint64_t expected_count) {
+      uint64_t count = 0;
+      for (uint64_t i = 0; i < blocks.size(); ++i) {
+        count += blocks[i].count;
+        if (i > 0 && gid_ranges[i].first <= gid_ranges[i - 1].second) throw RecoveryFailure("Invalid snapshot data!");
       }
+      if (count != expected_count) throw RecoveryFailure("Invalid snapshot data!");
+      return gid_ranges.empty() ? 0 : gid_ranges.back().second;
+    };
 
-      spdlog::trace("Recovering connectivity for vertex {}.", vertex.gid.AsUint());
-      // Check vertex.
-      auto gid = snapshot.ReadUint();
-      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-      if (gid != vertex.gid.AsUint()) throw RecoveryFailure("Invalid snapshot data!");
-
-      // Skip labels.
-      {
-        auto labels_size = snapshot.ReadUint();
-        if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *labels_size; ++j) {
-          auto label = snapshot.ReadUint();
-          if (!label) throw RecoveryFailure("Invalid snapshot data!");
-        }
+    // Recovers the objects of a block and returns the first and last GID.
+    auto recover_block = [&file](const SnapshotBlock &block, const auto &recover_object) {
+      std::vector<uint8_t> buffer;
+      ReadBlock(file, block.offset, &buffer);
+      BufferDecoder decoder(buffer.data(), buffer.size());
+      std::pair<uint64_t, uint64_t> gid_range{0, 0};
+      for (uint64_t i = 0; i < block.count; ++i) {
+        auto gid = recover_object(&decoder);
+        if (i > 0 && gid <= gid_range.second) throw RecoveryFailure("Invalid snapshot data!");
+        if (i == 0) gid_range.first = gid;
+        gid_range.second = gid;
       }
+      if (decoder.GetPosition() != decoder.GetSize()) throw RecoveryFailure("Invalid snapshot data!");
+      return gid_range;
+    };
 
-      // Skip properties.
-      {
-        auto props_size = snapshot.ReadUint();
-        if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *props_size; ++j) {
-          auto key = snapshot.ReadUint();
-          if (!key) throw RecoveryFailure("Invalid snapshot data!");
-          auto value = snapshot.SkipPropertyValue();
-          if (!value) throw RecoveryFailure("Invalid snapshot data!");
-        }
-      }
+    // Recover edges.
+    if (snapshot_has_edges) {
+      spdlog::info("Recovering {} edges.", info.edges_count);
+      std::vector<std::pair<uint64_t, uint64_t>> gid_ranges(edge_blocks.size());
+      utils::ParallelFor(edge_blocks.size(), thread_count, [&](uint64_t i) {
+        auto edge_acc = edges->access();
+        gid_ranges[i] = recover_block(edge_blocks[i], [&](BaseDecoder *decoder) {
+          return recover_edge(decoder, &edge_acc);
+        });
+      });
+      check_blocks(edge_blocks, gid_ranges, info.edges_count);
+      spdlog::info("Edges are recovered.");
+    } else if (!edge_blocks.empty()) {
+      throw RecoveryFailure("Invalid snapshot data!");
+    }
 
-      // Recover in edges.
-      {
-        spdlog::trace("Recovering inbound edges for vertex {}.", vertex.gid.AsUint());
-        auto in_size = snapshot.ReadUint();
-        if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
-        vertex.in_edges.reserve(*in_size);
-        for (uint64_t j = 0; j < *in_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = std::max(last_edge_gid, *edge_gid);
-
-          auto from_gid = snapshot.ReadUint();
-          if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
-
-          auto from_vertex = vertex_acc.find(Gid::FromUint(*from_gid));
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid from vertex!");
-
-          EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
-            if (snapshot_has_edges) {
-              auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
-              if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
-              edge_ref = EdgeRef(&*edge);
-            } else {
-              auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
-              edge_ref = EdgeRef(&*edge);
-            }
-          }
-          SPDLOG_TRACE("Recovered inbound edge {} with label \"{}\" from vertex {}.", *edge_gid,
-                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), from_vertex->gid.AsUint());
-          vertex.in_edges.emplace_back(get_edge_type_from_id(*edge_type), &*from_vertex, edge_ref);
-        }
+    // Recover vertices (labels and properties).
+    spdlog::info("Recovering {} vertices.", info.vertices_count);
+    std::vector<std::pair<uint64_t, uint64_t>> vertex_gid_ranges(vertex_blocks.size());
+    utils::ParallelFor(vertex_blocks.size(), thread_count, [&](uint64_t i) {
+      auto vertex_acc = vertices->access();
+      vertex_gid_ranges[i] = recover_block(vertex_blocks[i], [&](BaseDecoder *decoder) {
+        return recover_vertex(decoder, &vertex_acc);
+      });
+    });
+    last_vertex_gid = check_blocks(vertex_blocks, vertex_gid_ranges, info.vertices_count);
+    spdlog::info("Vertices are recovered.");
+
+    // Recover vertices (in/out edges).
+    spdlog::info("Recovering connectivity.");
+    std::vector<uint64_t> last_edge_gids(vertex_blocks.size(), 0);
+    utils::ParallelFor(vertex_blocks.size(), thread_count, [&](uint64_t i) {
+      auto vertex_acc = vertices->access();
+      auto edge_acc = edges->access();
+      // The vertices of a block are consecutive in the skip list because all
+      // of them were recovered from the snapshot. The vertices of a
+      // differential snapshot are interleaved with the vertices of the base
+      // snapshot, so each of them is looked up.
+      auto it = vertex_acc.find(Gid::FromUint(vertex_gid_ranges[i].first));
+      auto get_vertex = [&](uint64_t gid) -> Vertex & {
+        if (differential) it = vertex_acc.find(Gid::FromUint(gid));
+        if (it == vertex_acc.end() || it->gid.AsUint() != gid) throw RecoveryFailure("Invalid snapshot data!");
+        return *it++;
+      };
+      recover_block(vertex_blocks[i], [&](BaseDecoder *decoder) {
+        return recover_connectivity(decoder, get_vertex, &vertex_acc, &edge_acc, &last_edge_gids[i]);
+      });
+    });
+    for (const auto gid : last_edge_gids) {
+      last_edge_gid = std::max(last_edge_gid, gid);
+    }
+    spdlog::info("Connectivity is recovered.");
+  } else {
+    // Recover edges.
+    auto edge_acc = edges->access();
+    if (snapshot_has_edges) {
+      spdlog::info("Recovering {} edges.", info.edges_count);
+      if (!snapshot.SetPosition(info.offset_edges)) throw RecoveryFailure("Couldn't read data from snapshot!");
+      for (uint64_t i = 0; i < info.edges_count; ++i) {
+        auto gid = recover_edge(&snapshot, &edge_acc);
+        if (i > 0 && gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+        last_edge_gid = gid;
       }
+      spdlog::info("Edges are recovered.");
+    }
 
-      // Recover out edges.
-      {
-        spdlog::trace("Recovering outbound edges for vertex {}.", vertex.gid.AsUint());
-        auto out_size = snapshot.ReadUint();
-        if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
-        vertex.out_edges.reserve(*out_size);
-        for (uint64_t j = 0; j < *out_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = std::max(last_edge_gid, *edge_gid);
-
-          auto to_gid = snapshot.ReadUint();
-          if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
-
-          auto to_vertex = vertex_acc.find(Gid::FromUint(*to_gid));
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid to vertex!");
-
-          EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
-            if (snapshot_has_edges) {
-              auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
-              if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
-              edge_ref = EdgeRef(&*edge);
-            } else {
-              auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
-              edge_ref = EdgeRef(&*edge);
-            }
-          }
-          SPDLOG_TRACE("Recovered outbound edge {} with label \"{}\" to vertex {}.", *edge_gid,
-                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), to_vertex->gid.AsUint());
-          vertex.out_edges.emplace_back(get_edge_type_from_id(*edge_type), &*to_vertex, edge_ref);
-        }
-        // Increment edge count. We only increment the count here because the
-        // information is duplicated in in_edges.
-        edge_count->fetch_add(*out_size, std::memory_order_acq_rel);
+    // Recover vertices (labels and properties).
+    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
+    auto vertex_acc = vertices->access();
+    spdlog::info("Recovering {} vertices.", info.vertices_count);
+    for (uint64_t i = 0; i < info.vertices_count; ++i) {
+      auto gid = recover_vertex(&snapshot, &vertex_acc);
+      if (i > 0 && gid <= last_vertex_gid) {
+        throw RecoveryFailure("Invalid snapshot data!");
       }
+      last_vertex_gid = gid;
+    }
+    spdlog::info("Vertices are recovered.");
+
+    // Recover vertices (in/out edges).
+    spdlog::info("Recovering connectivity.");
+    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
+    auto it = vertex_acc.begin();
+    auto get_vertex = [&](uint64_t gid) -> Vertex & {
+      if (it == vertex_acc.end() || it->gid.AsUint() != gid) throw RecoveryFailure("Invalid snapshot data!");
+      return *it++;
+    };
+    for (uint64_t i = 0; i < info.vertices_count; ++i) {
+      recover_connectivity(&snapshot, get_vertex, &vertex_acc, &edge_acc, &last_edge_gid);
     }
     spdlog::info("Connectivity is recovered.");
+  }
+
+  // Remove the objects that were deleted after the base snapshot was created.
+  // Their neighbours were modified as well, so none of the recovered vertices
+  // references them anymore.
+  if (differential) {
+    spdlog::info("Removing deleted objects.");
+    if (!snapshot.SetPosition(info.offset_deleted)) throw RecoveryFailure("Couldn't read data from snapshot!");
+
+    auto marker = snapshot.ReadMarker();
+    if (!marker || *marker != Marker::SECTION_DELETED) throw RecoveryFailure("Invalid snapshot data!");
+
+    auto edge_acc = edges->access();
+    auto edges_size = snapshot.ReadUint();
+    if (!edges_size) throw RecoveryFailure("Invalid snapshot data!");
+    for (uint64_t i = 0; i < *edges_size; ++i) {
+      auto gid = snapshot.ReadUint();
+      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+      last_edge_gid = std::max(last_edge_gid, *gid);
+      edge_acc.remove(Gid::FromUint(*gid));
+    }
 
-    // Set initial values for edge/vertex ID generators.
-    ret.next_edge_id = last_edge_gid + 1;
-    ret.next_vertex_id = last_vertex_gid + 1;
+    auto vertex_acc = vertices->access();
+    auto vertices_size = snapshot.ReadUint();
+    if (!vertices_size) throw RecoveryFailure("Invalid snapshot data!");
+    for (uint64_t i = 0; i < *vertices_size; ++i) {
+      auto gid = snapshot.ReadUint();
+      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+      last_vertex_gid = std::max(last_vertex_gid, *gid);
+      auto vertex = vertex_acc.find(Gid::FromUint(*gid));
+      if (vertex == vertex_acc.end()) continue;
+      edge_count->fetch_sub(vertex->out_edges.size(), std::memory_order_acq_rel);
+      vertex_acc.remove(Gid::FromUint(*gid));
+    }
+    spdlog::info("Deleted objects are removed.");
   }
 
+  // Set initial values for edge/vertex ID generators.
+  ret.next_edge_id = last_edge_gid + 1;
+  ret.next_vertex_id = last_vertex_gid + 1;
+
   // Recover indices.
   {
     spdlog::info("Recovering metadata of indices.");
@@ -530,6 +837,70 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
       }
       spdlog::info("Metadata of label+property indices are recovered.");
     }
+
+    // Recover edge type indices.
+    // Snapshot version should be checked since edge type indices were
+    // implemented in later versions of snapshot.
+    if (*version >= kEdgeTypeIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} edge type indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto edge_type = snapshot.ReadUint();
+        if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.edge_type, get_edge_type_from_id(*edge_type),
+                                    "The edge type index already exists!");
+        SPDLOG_TRACE("Recovered metadata of edge type index for :{}",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)));
+      }
+      spdlog::info("Metadata of edge type indices are recovered.");
+    }
+
+    // Recover label+properties indices.
+    if (*version >= kCompositeIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} label+properties indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto properties_count = snapshot.ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<PropertyId> properties;
+        properties.reserve(*properties_count);
+        for (uint64_t j = 0; j < *properties_count; ++j) {
+          auto property = snapshot.ReadUint();
+          if (!property) throw RecoveryFailure("Invalid snapshot data!");
+          properties.push_back(get_property_from_id(*property));
+        }
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label_properties,
+                                    {get_label_from_id(*label), std::move(properties)},
+                                    "The label+properties index already exists!");
+        SPDLOG_TRACE("Recovered metadata of label+properties index for :{}",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)));
+      }
+      spdlog::info("Metadata of label+properties indices are recovered.");
+    }
+
+    // Recover text indices.
+    if (*version >= kTextIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} text indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto property = snapshot.ReadUint();
+        if (!property) throw RecoveryFailure("Invalid snapshot data!");
+        AddRecoveredIndexConstraint(&indices_constraints.indices.text,
+                                    {get_label_from_id(*label), get_property_from_id(*property)},
+                                    "The text index already exists!");
+        SPDLOG_TRACE("Recovered metadata of text index for :{}({})",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)),
+                     name_id_mapper->IdToName(snapshot_id_map.at(*property)));
+      }
+      spdlog::info("Metadata of text indices are recovered.");
+    }
     spdlog::info("Metadata of indices are recovered.");
   }
 
@@ -602,6 +973,9 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
       throw RecoveryFailure("Invalid snapshot data!");
     }
 
+    // The differential snapshot contains the whole epoch history.
+    if (differential) epoch_history->clear();
+
     for (int i = 0; i < *history_size; ++i) {
       auto maybe_epoch_id = snapshot.ReadString();
       if (!maybe_epoch_id) {
@@ -625,20 +999,132 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   return {info, ret, std::move(indices_constraints)};
 }
 
+namespace {
+
+// Returns a function that returns the objects of the container one by one and
+// `nullptr` after the last one.
+template <typename TObject, typename TAccessor>
+auto AllObjects(TAccessor *acc) {
+  return [it = acc->begin(), end = acc->end()]() mutable -> TObject * {
+    if (it == end) return nullptr;
+    auto *object = &*it;
+    ++it;
+    return object;
+  };
+}
+
+// Returns a function that returns the objects with the given GIDs one by one
+// and `nullptr` after the last one. The GIDs of the objects that aren't in the
+// container anymore are stored into `missing`.
+template <typename TObject, typename TAccessor>
+auto ModifiedObjects(TAccessor *acc, const std::vector<Gid> &gids, std::vector<Gid> *missing) {
+  return [acc, &gids, missing, i = uint64_t{0}]() mutable -> TObject * {
+    while (i < gids.size()) {
+      const auto gid = gids[i++];
+      auto it = acc->find(gid);
+      if (it != acc->end()) return &*it;
+      missing->push_back(gid);
+    }
+    return nullptr;
+  };
+}
+
+// Writes all objects returned by `next_object` using `write_object`, which
+// must return `true` if the object was written. The GIDs of the objects that
+// weren't written are stored into `skipped` (if it isn't `nullptr`). The
+// objects are split into blocks of `kSnapshotBlockSize` objects that are
+// encoded and compressed by up to `thread_count` threads concurrently. The
+// blocks are then appended to the snapshot in order and their offsets are
+// stored into `blocks`.
+template <typename TNext, typename TFunc>
+uint64_t WriteObjects(Encoder *snapshot, TNext next_object, uint64_t thread_count,
+                      std::unordered_set<uint64_t> *used_ids, std::vector<SnapshotBlock> *blocks,
+                      std::vector<Gid> *skipped, const TFunc &write_object) {
+  using TObject = std::remove_pointer_t<std::invoke_result_t<TNext &>>;
+  thread_count = std::max<uint64_t>(thread_count, 1);
+  uint64_t count = 0;
+
+  std::vector<std::vector<TObject *>> batches(thread_count);
+  std::vector<BufferEncoder> buffers(thread_count);
+  std::vector<std::vector<uint8_t>> compressed(thread_count);
+  std::vector<std::unordered_set<uint64_t>> batch_used_ids(thread_count);
+  std::vector<std::vector<Gid>> batch_skipped(thread_count);
+  std::vector<uint64_t> batch_counts(thread_count, 0);
+  auto *object = next_object();
+  while (object != nullptr) {
+    uint64_t batches_used = 0;
+    for (; batches_used < thread_count && object != nullptr; ++batches_used) {
+      auto &batch = batches[batches_used];
+      batch.clear();
+      for (uint64_t i = 0; i < kSnapshotBlockSize && object != nullptr; ++i, object = next_object()) {
+        batch.push_back(object);
+      }
+    }
+
+    utils::ParallelFor(batches_used, thread_count, [&](uint64_t i) {
+      for (auto *batch_object : batches[i]) {
+        if (write_object(&buffers[i], *batch_object, &batch_used_ids[i])) {
+          ++batch_counts[i];
+        } else if (skipped != nullptr) {
+          batch_skipped[i].push_back(batch_object->gid);
+        }
+      }
+      if (batch_counts[i] != 0) CompressBlock(buffers[i].data(), buffers[i].size(), &compressed[i]);
+    });
+
+    for (uint64_t i = 0; i < batches_used; ++i) {
+      if (batch_counts[i] != 0) {
+        blocks->push_back({snapshot->GetPosition(), batch_counts[i]});
+        snapshot->WriteMarker(Marker::SECTION_BLOCK);
+        snapshot->WriteUint(buffers[i].size());
+        snapshot->WriteUint(compressed[i].size());
+        snapshot->Write(compressed[i].data(), compressed[i].size());
+      }
+      buffers[i].Clear();
+      count += batch_counts[i];
+      batch_counts[i] = 0;
+      if (skipped != nullptr) {
+        skipped->insert(skipped->end(), batch_skipped[i].begin(), batch_skipped[i].end());
+        batch_skipped[i].clear();
+      }
+    }
+  }
+
+  for (const auto &ids : batch_used_ids) {
+    used_ids->insert(ids.begin(), ids.end());
+  }
+  return count;
+}
+
+}  // namespace
+
 void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
                     const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
-                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
-                    Indices *indices, Constraints *constraints, Config::Items items, const std::string &uuid,
-                    const std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer) {
+                    uint64_t snapshot_thread_count, VerticesContainer *vertices, EdgesContainer *edges,
+                    NameIdMapper *name_id_mapper, Indices *indices, Constraints *constraints, Config::Items items,
+                    const std::string &uuid, const std::string_view epoch_id,
+                    const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                    const DifferentialSnapshot *differential, utils::FileRetainer *file_retainer,
+                    utils::OutputFile::IoBackend io_backend) {
   // Ensure that the storage directory exists.
   utils::EnsureDirOrDie(snapshot_directory);
 
   // Create snapshot file.
   auto path = snapshot_directory / MakeSnapshotName(transaction->start_timestamp);
-  spdlog::info("Starting snapshot creation to {}", path);
+  if (differential) {
+    spdlog::info("Starting differential snapshot creation to {} with {} modified vertices and {} modified edges", path,
+                 differential->vertices.size(), differential->edges.size());
+  } else {
+    spdlog::info("Starting snapshot creation to {}", path);
+  }
   Encoder snapshot;
-  snapshot.Initialize(path, kSnapshotMagic, kVersion);
+  snapshot.Initialize(path, kSnapshotMagic, kVersion, io_backend);
+  // A snapshot that wasn't finished is deleted, so the recovery and the next
+  // differential snapshot still use the previous one.
+  utils::OnScopeExit delete_unfinished([&path] {
+    spdlog::warn("Snapshot creation failed, deleting the unfinished snapshot {}.", path);
+    utils::DeleteFile(path);
+  });
 
   // Write placeholder offsets.
   uint64_t offset_offsets = 0;
@@ -649,6 +1135,8 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
   uint64_t offset_mapper = 0;
   uint64_t offset_metadata = 0;
   uint64_t offset_epoch_history = 0;
+  uint64_t offset_block_index = 0;
+  uint64_t offset_deleted = 0;
   {
     snapshot.WriteMarker(Marker::SECTION_OFFSETS);
     offset_offsets = snapshot.GetPosition();
@@ -659,12 +1147,22 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(offset_mapper);
     snapshot.WriteUint(offset_epoch_history);
     snapshot.WriteUint(offset_metadata);
+    snapshot.WriteUint(offset_block_index);
+    snapshot.WriteUint(offset_deleted);
   }
 
   // Object counters.
   uint64_t edges_count = 0;
   uint64_t vertices_count = 0;
 
+  // Blocks of compressed objects.
+  std::vector<SnapshotBlock> edge_blocks;
+  std::vector<SnapshotBlock> vertex_blocks;
+
+  // Objects of a differential snapshot that were deleted.
+  std::vector<Gid> deleted_edges;
+  std::vector<Gid> deleted_vertices;
+
   // Mapper data.
   std::unordered_set<uint64_t> used_ids;
   auto write_mapping = [&snapshot, &used_ids](auto mapping) {
@@ -675,8 +1173,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
   // Store all edges.
   if (items.properties_on_edges) {
     offset_edges = snapshot.GetPosition();
-    auto acc = edges->access();
-    for (auto &edge : acc) {
+    auto write_edge = [&](BaseEncoder *encoder, Edge &edge, std::unordered_set<uint64_t> *edge_used_ids) {
       // The edge visibility check must be done here manually because we don't
       // allow direct access to the edges through the public API.
       bool is_visible = true;
@@ -706,7 +1203,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
           }
         }
       });
-      if (!is_visible) continue;
+      if (!is_visible) return false;
       EdgeRef edge_ref(&edge);
       // Here we create an edge accessor that we will use to get the
       // properties of the edge. The accessor is created with an invalid
@@ -722,28 +1219,41 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
 
       // Store the edge.
       {
-        snapshot.WriteMarker(Marker::SECTION_EDGE);
-        snapshot.WriteUint(edge.gid.AsUint());
+        encoder->WriteMarker(Marker::SECTION_EDGE);
+        encoder->WriteUint(edge.gid.AsUint());
         const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
+        encoder->WriteUint(props.size());
         for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
+          edge_used_ids->insert(item.first.AsUint());
+          encoder->WriteUint(item.first.AsUint());
+          encoder->WritePropertyValue(item.second);
         }
       }
 
-      ++edges_count;
+      return true;
+    };
+    auto edge_acc = edges->access();
+    if (differential) {
+      edges_count = WriteObjects(&snapshot, ModifiedObjects<Edge>(&edge_acc, differential->edges, &deleted_edges),
+                                 snapshot_thread_count, &used_ids, &edge_blocks, &deleted_edges, write_edge);
+    } else {
+      edges_count = WriteObjects(&snapshot, AllObjects<Edge>(&edge_acc), snapshot_thread_count, &used_ids,
+                                 &edge_blocks, nullptr, write_edge);
     }
   }
 
   // Store all vertices.
   {
     offset_vertices = snapshot.GetPosition();
-    auto acc = vertices->access();
-    for (auto &vertex : acc) {
+    auto write_vertex = [&](BaseEncoder *encoder, Vertex &vertex, std::unordered_set<uint64_t> *vertex_used_ids) {
+      auto write_vertex_mapping = [encoder, vertex_used_ids](auto mapping) {
+        vertex_used_ids->insert(mapping.AsUint());
+        encoder->WriteUint(mapping.AsUint());
+      };
+
       // The visibility check is implemented for vertices so we use it here.
       auto va = VertexAccessor::Create(&vertex, transaction, indices, constraints, items, View::OLD);
-      if (!va) continue;
+      if (!va) return false;
 
       // Get vertex data.
       // TODO (mferencevic): All of these functions could be written into a
@@ -759,36 +1269,71 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
 
       // Store the vertex.
       {
-        snapshot.WriteMarker(Marker::SECTION_VERTEX);
-        snapshot.WriteUint(vertex.gid.AsUint());
+        encoder->WriteMarker(Marker::SECTION_VERTEX);
+        encoder->WriteUint(vertex.gid.AsUint());
         const auto &labels = maybe_labels.GetValue();
-        snapshot.WriteUint(labels.size());
+        encoder->WriteUint(labels.size());
         for (const auto &item : labels) {
-          write_mapping(item);
+          write_vertex_mapping(item);
         }
         const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
+        encoder->WriteUint(props.size());
         for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
+          write_vertex_mapping(item.first);
+          encoder->WritePropertyValue(item.second);
         }
         const auto &in_edges = maybe_in_edges.GetValue();
-        snapshot.WriteUint(in_edges.size());
+        encoder->WriteUint(in_edges.size());
         for (const auto &item : in_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.FromVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
+          encoder->WriteUint(item.Gid().AsUint());
+          encoder->WriteUint(item.FromVertex().Gid().AsUint());
+          write_vertex_mapping(item.EdgeType());
         }
         const auto &out_edges = maybe_out_edges.GetValue();
-        snapshot.WriteUint(out_edges.size());
+        encoder->WriteUint(out_edges.size());
         for (const auto &item : out_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.ToVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
+          encoder->WriteUint(item.Gid().AsUint());
+          encoder->WriteUint(item.ToVertex().Gid().AsUint());
+          write_vertex_mapping(item.EdgeType());
         }
       }
 
-      ++vertices_count;
+      return true;
+    };
+    auto vertex_acc = vertices->access();
+    if (differential) {
+      vertices_count =
+          WriteObjects(&snapshot, ModifiedObjects<Vertex>(&vertex_acc, differential->vertices, &deleted_vertices),
+                       snapshot_thread_count, &used_ids, &vertex_blocks, &deleted_vertices, write_vertex);
+    } else {
+      vertices_count = WriteObjects(&snapshot, AllObjects<Vertex>(&vertex_acc), snapshot_thread_count, &used_ids,
+                                    &vertex_blocks, nullptr, write_vertex);
+    }
+  }
+
+  // Write block index.
+  {
+    offset_block_index = snapshot.GetPosition();
+    snapshot.WriteMarker(Marker::SECTION_BLOCK_INDEX);
+    for (const auto *blocks : {&edge_blocks, &vertex_blocks}) {
+      snapshot.WriteUint(blocks->size());
+      for (const auto &block : *blocks) {
+        snapshot.WriteUint(block.offset);
+        snapshot.WriteUint(block.count);
+      }
+    }
+  }
+
+  // Write deleted objects.
+  if (differential) {
+    offset_deleted = snapshot.GetPosition();
+    snapshot.WriteMarker(Marker::SECTION_DELETED);
+    for (auto *deleted : {&deleted_edges, &deleted_vertices}) {
+      std::sort(deleted->begin(), deleted->end());
+      snapshot.WriteUint(deleted->size());
+      for (const auto gid : *deleted) {
+        snapshot.WriteUint(gid.AsUint());
+      }
     }
   }
 
@@ -815,6 +1360,38 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
         write_mapping(item.second);
       }
     }
+
+    // Write edge type indices.
+    {
+      auto edge_type = indices->edge_type_index.ListIndices();
+      snapshot.WriteUint(edge_type.size());
+      for (const auto &item : edge_type) {
+        write_mapping(item);
+      }
+    }
+
+    // Write label+properties indices.
+    {
+      auto label_properties = indices->label_properties_index.ListIndices();
+      snapshot.WriteUint(label_properties.size());
+      for (const auto &[label, properties] : label_properties) {
+        write_mapping(label);
+        snapshot.WriteUint(properties.size());
+        for (const auto &property : properties) {
+          write_mapping(property);
+        }
+      }
+    }
+
+    // Write text indices.
+    {
+      auto text = indices->text_index.ListIndices();
+      snapshot.WriteUint(text.size());
+      for (const auto &item : text) {
+        write_mapping(item.first);
+        write_mapping(item.second);
+      }
+    }
   }
 
   // Write constraints.
@@ -877,6 +1454,8 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(transaction->start_timestamp);
     snapshot.WriteUint(edges_count);
     snapshot.WriteUint(vertices_count);
+    snapshot.WriteBool(differential != nullptr);
+    if (differential) snapshot.WriteUint(differential->base_start_timestamp);
   }
 
   // Write true offsets.
@@ -889,15 +1468,22 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(offset_mapper);
     snapshot.WriteUint(offset_epoch_history);
     snapshot.WriteUint(offset_metadata);
+    snapshot.WriteUint(offset_block_index);
+    snapshot.WriteUint(offset_deleted);
   }
 
   // Finalize snapshot file.
   snapshot.Finalize();
+  delete_unfinished.Disable();
   spdlog::info("Snapshot creation successful!");
 
-  // Ensure exactly `snapshot_retention_count` snapshots exist.
-  std::vector<std::pair<uint64_t, std::filesystem::path>> old_snapshot_files;
+  // Ensure exactly `snapshot_retention_count` full snapshots exist. The
+  // differential snapshots are deleted together with the full snapshot they
+  // are based on.
+  std::vector<std::tuple<uint64_t, std::filesystem::path, bool>> snapshot_files;
+  uint64_t full_snapshots_count = 0;
   {
+    snapshot_files.emplace_back(transaction->start_timestamp, path, differential == nullptr);
     std::error_code error_code;
     for (const auto &item : std::filesystem::directory_iterator(snapshot_directory, error_code)) {
       if (!item.is_regular_file()) continue;
@@ -905,7 +1491,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
       try {
         auto info = ReadSnapshotInfo(item.path());
         if (info.uuid != uuid) continue;
-        old_snapshot_files.emplace_back(info.start_timestamp, item.path());
+        snapshot_files.emplace_back(info.start_timestamp, item.path(), !info.base_start_timestamp);
       } catch (const RecoveryFailure &e) {
         spdlog::warn("Found a corrupt snapshot file {} becuase of: {}", item.path(), e.what());
         continue;
@@ -917,19 +1503,23 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
           utils::MessageWithLink("Couldn't ensure that exactly {} snapshots exist because an error occurred: {}.",
                                  snapshot_retention_count, error_code.message(), "https://memgr.ph/snapshots"));
     }
-    std::sort(old_snapshot_files.begin(), old_snapshot_files.end());
-    if (old_snapshot_files.size() > snapshot_retention_count - 1) {
-      auto num_to_erase = old_snapshot_files.size() - (snapshot_retention_count - 1);
+    std::sort(snapshot_files.begin(), snapshot_files.end());
+    std::vector<size_t> full_snapshot_positions;
+    for (size_t i = 0; i < snapshot_files.size(); ++i) {
+      if (std::get<2>(snapshot_files[i])) full_snapshot_positions.push_back(i);
+    }
+    if (full_snapshot_positions.size() > snapshot_retention_count) {
+      auto num_to_erase = full_snapshot_positions[full_snapshot_positions.size() - snapshot_retention_count];
       for (size_t i = 0; i < num_to_erase; ++i) {
-        const auto &[start_timestamp, snapshot_path] = old_snapshot_files[i];
-        file_retainer->DeleteFile(snapshot_path);
+        file_retainer->DeleteFile(std::get<1>(snapshot_files[i]));
       }
-      old_snapshot_files.erase(old_snapshot_files.begin(), old_snapshot_files.begin() + num_to_erase);
+      snapshot_files.erase(snapshot_files.begin(), snapshot_files.begin() + num_to_erase);
     }
+    full_snapshots_count = std::min<uint64_t>(full_snapshot_positions.size(), snapshot_retention_count);
   }
 
   // Ensure that only the absolutely necessary WAL files exist.
-  if (old_snapshot_files.size() == snapshot_retention_count - 1 && utils::DirExists(wal_directory)) {
+  if (full_snapshots_count == snapshot_retention_count && utils::DirExists(wal_directory)) {
     std::vector<std::tuple<uint64_t, uint64_t, uint64_t, std::filesystem::path>> wal_files;
     std::error_code error_code;
     for (const auto &item : std::filesystem::directory_iterator(wal_directory, error_code)) {
@@ -950,10 +1540,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
                                  error_code.message(), "https://memgr.ph/snapshots"));
     }
     std::sort(wal_files.begin(), wal_files.end());
-    uint64_t snapshot_start_timestamp = transaction->start_timestamp;
-    if (!old_snapshot_files.empty()) {
-      snapshot_start_timestamp = old_snapshot_files.front().first;
-    }
+    uint64_t snapshot_start_timestamp = std::get<0>(snapshot_files.front());
     std::optional<uint64_t> pos = 0;
     for (uint64_t i = 0; i < wal_files.size(); ++i) {
       const auto &[seq_num, from_timestamp, to_timestamp, wal_path] = wal_files[i];
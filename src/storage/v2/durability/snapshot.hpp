@@ -13,18 +13,21 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints.hpp"
+#include "storage/v2/containers.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/edge.hpp"
+#include "storage/v2/id_types.hpp"
 #include "storage/v2/indices.hpp"
 #include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
 #include "utils/file_locker.hpp"
-#include "utils/skip_list.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -37,12 +40,30 @@ struct SnapshotInfo {
   uint64_t offset_mapper;
   uint64_t offset_epoch_history;
   uint64_t offset_metadata;
+  // Offset of the block index (`0` for snapshots older than version 18).
+  uint64_t offset_block_index{0};
+  // Offset of the deleted objects (`0` for full snapshots).
+  uint64_t offset_deleted{0};
 
   std::string uuid;
   std::string epoch_id;
   uint64_t start_timestamp;
   uint64_t edges_count;
   uint64_t vertices_count;
+  // Start timestamp of the snapshot on top of which this differential
+  // snapshot is applied (`std::nullopt` for full snapshots).
+  std::optional<uint64_t> base_start_timestamp;
+};
+
+/// Structure used to hold the objects that are stored into a differential
+/// snapshot. Only the objects that were modified after the base snapshot was
+/// created are stored.
+struct DifferentialSnapshot {
+  uint64_t base_start_timestamp;
+  // Sorted GIDs of the modified vertices.
+  std::vector<Gid> vertices;
+  // Sorted GIDs of the modified edges.
+  std::vector<Gid> edges;
 };
 
 /// Structure used to hold information about the snapshot that has been
@@ -57,19 +78,29 @@ struct RecoveredSnapshot {
 /// @throw RecoveryFailure
 SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path);
 
-/// Function used to load the snapshot data into the storage.
+/// Function used to load the snapshot data into the storage. The compressed
+/// blocks of the snapshot are decoded using `thread_count` threads. A
+/// differential snapshot is applied on top of the data that is already in the
+/// storage, which must be the data of its base snapshot.
 /// @throw RecoveryFailure
-RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
-                               utils::SkipList<Edge> *edges,
+RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, VerticesContainer *vertices, EdgesContainer *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items);
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                               uint64_t thread_count);
 
-/// Function used to create a snapshot using the given transaction.
+/// Function used to create a snapshot using the given transaction. The
+/// vertices and edges are encoded using `snapshot_thread_count` threads. If
+/// `differential` isn't `nullptr`, only the objects it contains are stored.
+/// `snapshot_retention_count` full snapshots are kept together with the
+/// differential snapshots that are based on them. The snapshot file is written
+/// using `io_backend`.
 void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
                     const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
-                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
-                    Indices *indices, Constraints *constraints, Config::Items items, const std::string &uuid,
-                    std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer);
+                    uint64_t snapshot_thread_count, VerticesContainer *vertices, EdgesContainer *edges,
+                    NameIdMapper *name_id_mapper, Indices *indices, Constraints *constraints, Config::Items items,
+                    const std::string &uuid, std::string_view epoch_id,
+                    const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                    const DifferentialSnapshot *differential, utils::FileRetainer *file_retainer,
+                    utils::OutputFile::IoBackend io_backend = utils::OutputFile::IoBackend::SYSCALL);
 
 }  // namespace memgraph::storage::durability
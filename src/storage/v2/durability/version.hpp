@@ -20,10 +20,16 @@ namespace memgraph::storage::durability {
 // The current version of snapshot and WAL encoding / decoding.
 // IMPORTANT: Please bump this version for every snapshot and/or WAL format
 // change!!!
-const uint64_t kVersion{14};
+const uint64_t kVersion{20};
 
 const uint64_t kOldestSupportedVersion{14};
 const uint64_t kUniqueConstraintVersion{13};
+const uint64_t kEdgeTypeIndexVersion{15};
+const uint64_t kCompositeIndexVersion{16};
+const uint64_t kTextIndexVersion{17};
+const uint64_t kCompressedSnapshotVersion{18};
+const uint64_t kCompressedWalVersion{19};
+const uint64_t kDifferentialSnapshotVersion{20};
 
 // Magic values written to the start of a snapshot/WAL file to identify it.
 const std::string kSnapshotMagic{"MGsn"};
@@ -11,14 +11,31 @@
 
 #include "storage/v2/durability/wal.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 #include "storage/v2/delta.hpp"
+#include "storage/v2/durability/compression.hpp"
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/version.hpp"
 #include "storage/v2/edge.hpp"
 #include "storage/v2/vertex.hpp"
 #include "utils/file_locker.hpp"
+#include "utils/event_counter.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/logging.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace EventCounter {
+extern const Event WalBytesWritten;
+extern const Event WalCompressionInputBytes;
+extern const Event WalCompressionOutputBytes;
+}  // namespace EventCounter
+
+namespace EventHistogram {
+extern const Event WalFsyncLatency;
+}  // namespace EventHistogram
 
 namespace memgraph::storage::durability {
 
@@ -36,6 +53,7 @@ namespace memgraph::storage::durability {
 //     * storage UUID
 //     * sequence number (number indicating the sequence position of this WAL
 //       file)
+//     * whether the deltas are compressed (from version 19)
 //
 // 5) Encoded deltas; each delta is written in the following format:
 //     * commit timestamp
@@ -63,12 +81,25 @@ namespace memgraph::storage::durability {
 //         * label index create, label index drop
 //              * label name
 //         * label property index create, label property index drop,
+//           text index create, text index drop,
 //           existence constraint create, existence constraint drop
 //              * label name
 //              * property name
 //         * unique constraint create, unique constraint drop
 //              * label name
 //              * property names
+//         * edge type index create, edge type index drop
+//              * edge type name
+//         * label properties index create, label properties index drop
+//              * label name
+//              * property names in the order of the index key
+//
+//    When the deltas are compressed, the encoded deltas are split into
+//    blocks that are compressed with zlib. Each block is written in the
+//    following format:
+//     * uncompressed size
+//     * compressed size
+//     * compressed data (non-encoded)
 //
 // IMPORTANT: When changing WAL encoding/decoding bump the snapshot/WAL version
 // in `version.hpp`.
@@ -93,6 +124,18 @@ Marker OperationToMarker(StorageGlobalOperation operation) {
       return Marker::DELTA_UNIQUE_CONSTRAINT_CREATE;
     case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return Marker::DELTA_UNIQUE_CONSTRAINT_DROP;
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+      return Marker::DELTA_EDGE_TYPE_INDEX_CREATE;
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+      return Marker::DELTA_EDGE_TYPE_INDEX_DROP;
+    case StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE:
+      return Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE;
+    case StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP:
+      return Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP;
+    case StorageGlobalOperation::TEXT_INDEX_CREATE:
+      return Marker::DELTA_TEXT_INDEX_CREATE;
+    case StorageGlobalOperation::TEXT_INDEX_DROP:
+      return Marker::DELTA_TEXT_INDEX_DROP;
   }
 }
 
@@ -161,6 +204,18 @@ WalDeltaData::Type MarkerToWalDeltaDataType(Marker marker) {
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+      return WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE;
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+      return WalDeltaData::Type::EDGE_TYPE_INDEX_DROP;
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE:
+      return WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE;
+    case Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP:
+      return WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP;
+    case Marker::DELTA_TEXT_INDEX_CREATE:
+      return WalDeltaData::Type::TEXT_INDEX_CREATE;
+    case Marker::DELTA_TEXT_INDEX_DROP:
+      return WalDeltaData::Type::TEXT_INDEX_DROP;
 
     case Marker::TYPE_NULL:
     case Marker::TYPE_BOOL:
@@ -179,6 +234,9 @@ WalDeltaData::Type MarkerToWalDeltaDataType(Marker marker) {
     case Marker::SECTION_CONSTRAINTS:
     case Marker::SECTION_DELTA:
     case Marker::SECTION_EPOCH_HISTORY:
+    case Marker::SECTION_BLOCK:
+    case Marker::SECTION_BLOCK_INDEX:
+    case Marker::SECTION_DELETED:
     case Marker::SECTION_OFFSETS:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
@@ -272,8 +330,21 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
       }
       break;
     }
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto edge_type = decoder->ReadString();
+        if (!edge_type) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_edge_type.edge_type = std::move(*edge_type);
+      } else {
+        if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+      }
+      break;
+    }
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE:
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
       if constexpr (read_data) {
@@ -288,6 +359,29 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
       }
       break;
     }
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto label = decoder->ReadString();
+        if (!label) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_label_property_list.label = std::move(*label);
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          auto property = decoder->ReadString();
+          if (!property) throw RecoveryFailure("Invalid WAL data!");
+          delta.operation_label_property_list.properties.push_back(std::move(*property));
+        }
+      } else {
+        if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        }
+      }
+      break;
+    }
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP: {
       if constexpr (read_data) {
@@ -315,6 +409,77 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
   return delta;
 }
 
+// Reads and decompresses the blocks of a compressed WAL file, starting at the
+// current position, into `buffer`. Reading stops at the first block that
+// can't be read, so that the valid beginning of a damaged file is recovered.
+void ReadCompressedDeltas(Decoder *wal, std::vector<uint8_t> *buffer) {
+  auto size = wal->GetSize();
+  if (!size) throw RecoveryFailure("Invalid WAL data!");
+  std::vector<uint8_t> compressed;
+  std::vector<uint8_t> block;
+  while (true) {
+    auto position = wal->GetPosition();
+    if (!position || *position == *size) break;
+    auto marker = wal->ReadMarker();
+    if (!marker || *marker != Marker::SECTION_BLOCK) break;
+    auto uncompressed_size = wal->ReadUint();
+    if (!uncompressed_size) break;
+    auto compressed_size = wal->ReadUint();
+    if (!compressed_size) break;
+    position = wal->GetPosition();
+    if (!position || *compressed_size > *size - *position) break;
+    compressed.resize(*compressed_size);
+    if (!wal->Read(compressed.data(), compressed.size())) break;
+    if (!DecompressBlock(compressed.data(), compressed.size(), *uncompressed_size, &block)) break;
+    buffer->insert(buffer->end(), block.begin(), block.end());
+  }
+}
+
+// Reads the deltas that follow and determines the number of valid deltas and
+// their timestamps.
+template <typename TDecoder>
+void ReadWalDeltasInfo(TDecoder *wal, WalInfo *info) {
+  info->num_deltas = 0;
+  auto validate_delta = [wal]() -> std::optional<std::pair<uint64_t, bool>> {
+    try {
+      auto timestamp = ReadWalDeltaHeader(wal);
+      auto type = SkipWalDeltaData(wal);
+      return {{timestamp, IsWalDeltaDataTypeTransactionEnd(type)}};
+    } catch (const RecoveryFailure &) {
+      return std::nullopt;
+    }
+  };
+  auto size = wal->GetSize();
+  // Here we read the whole file and determine the number of valid deltas. A
+  // delta is valid only if all of its data can be successfully read. This
+  // allows us to recover data from WAL files that are corrupt at the end (eg.
+  // because of power loss) but are still valid at the beginning. While reading
+  // the deltas we only count deltas which are a part of a fully valid
+  // transaction (indicated by a TRANSACTION_END delta or any other
+  // non-transactional operation).
+  std::optional<uint64_t> current_timestamp;
+  uint64_t num_deltas = 0;
+  while (wal->GetPosition() != size) {
+    auto ret = validate_delta();
+    if (!ret) break;
+    auto [timestamp, is_end_of_transaction] = *ret;
+    if (!current_timestamp) current_timestamp = timestamp;
+    if (*current_timestamp != timestamp) break;
+    ++num_deltas;
+    if (is_end_of_transaction) {
+      if (info->num_deltas == 0) {
+        info->from_timestamp = timestamp;
+        info->to_timestamp = timestamp;
+      }
+      if (timestamp < info->from_timestamp || timestamp < info->to_timestamp) break;
+      info->to_timestamp = timestamp;
+      info->num_deltas += num_deltas;
+      current_timestamp = std::nullopt;
+      num_deltas = 0;
+    }
+  }
+}
+
 }  // namespace
 
 // Function used to read information about the WAL file.
@@ -366,47 +531,23 @@ WalInfo ReadWalInfo(const std::filesystem::path &path) {
     auto maybe_seq_num = wal.ReadUint();
     if (!maybe_seq_num) throw RecoveryFailure("Invalid WAL data!");
     info.seq_num = *maybe_seq_num;
+
+    if (*version >= kCompressedWalVersion) {
+      auto maybe_compressed = wal.ReadBool();
+      if (!maybe_compressed) throw RecoveryFailure("Invalid WAL data!");
+      info.compressed = *maybe_compressed;
+    }
   }
 
   // Read deltas.
-  info.num_deltas = 0;
-  auto validate_delta = [&wal]() -> std::optional<std::pair<uint64_t, bool>> {
-    try {
-      auto timestamp = ReadWalDeltaHeader(&wal);
-      auto type = SkipWalDeltaData(&wal);
-      return {{timestamp, IsWalDeltaDataTypeTransactionEnd(type)}};
-    } catch (const RecoveryFailure &) {
-      return std::nullopt;
-    }
-  };
-  auto size = wal.GetSize();
-  // Here we read the whole file and determine the number of valid deltas. A
-  // delta is valid only if all of its data can be successfully read. This
-  // allows us to recover data from WAL files that are corrupt at the end (eg.
-  // because of power loss) but are still valid at the beginning. While reading
-  // the deltas we only count deltas which are a part of a fully valid
-  // transaction (indicated by a TRANSACTION_END delta or any other
-  // non-transactional operation).
-  std::optional<uint64_t> current_timestamp;
-  uint64_t num_deltas = 0;
-  while (wal.GetPosition() != size) {
-    auto ret = validate_delta();
-    if (!ret) break;
-    auto [timestamp, is_end_of_transaction] = *ret;
-    if (!current_timestamp) current_timestamp = timestamp;
-    if (*current_timestamp != timestamp) break;
-    ++num_deltas;
-    if (is_end_of_transaction) {
-      if (info.num_deltas == 0) {
-        info.from_timestamp = timestamp;
-        info.to_timestamp = timestamp;
-      }
-      if (timestamp < info.from_timestamp || timestamp < info.to_timestamp) break;
-      info.to_timestamp = timestamp;
-      info.num_deltas += num_deltas;
-      current_timestamp = std::nullopt;
-      num_deltas = 0;
-    }
+  if (info.compressed) {
+    if (!wal.SetPosition(info.offset_deltas)) throw RecoveryFailure("Invalid WAL data!");
+    std::vector<uint8_t> buffer;
+    ReadCompressedDeltas(&wal, &buffer);
+    BufferDecoder deltas(buffer.data(), buffer.size());
+    ReadWalDeltasInfo(&deltas, &info);
+  } else {
+    ReadWalDeltasInfo(&wal, &info);
   }
 
   if (info.num_deltas == 0) throw RecoveryFailure("Invalid WAL data!");
@@ -414,6 +555,20 @@ WalInfo ReadWalInfo(const std::filesystem::path &path) {
   return info;
 }
 
+WalDeltaDecoder::WalDeltaDecoder(const std::filesystem::path &path, const WalInfo &info) {
+  auto version = wal_.Initialize(path, kWalMagic);
+  if (!version) throw RecoveryFailure("Couldn't read WAL magic and/or version!");
+  if (!IsVersionSupported(*version)) throw RecoveryFailure("Invalid WAL version!");
+  if (!wal_.SetPosition(info.offset_deltas)) throw RecoveryFailure("Invalid WAL data!");
+  if (info.compressed) {
+    ReadCompressedDeltas(&wal_, &buffer_);
+    buffer_decoder_.emplace(buffer_.data(), buffer_.size());
+    decoder_ = &*buffer_decoder_;
+  } else {
+    decoder_ = &wal_;
+  }
+}
+
 bool operator==(const WalDeltaData &a, const WalDeltaData &b) {
   if (a.type != b.type) return false;
   switch (a.type) {
@@ -446,8 +601,19 @@ bool operator==(const WalDeltaData &a, const WalDeltaData &b) {
     case WalDeltaData::Type::LABEL_INDEX_DROP:
       return a.operation_label.label == b.operation_label.label;
 
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP:
+      return a.operation_edge_type.edge_type == b.operation_edge_type.edge_type;
+
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP:
+      return a.operation_label_property_list.label == b.operation_label_property_list.label &&
+             a.operation_label_property_list.properties == b.operation_label_property_list.properties;
+
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE:
     case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
       return a.operation_label_property.label == b.operation_label_property.label &&
@@ -596,6 +762,8 @@ void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Storage
     }
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE:
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP:
+    case StorageGlobalOperation::TEXT_INDEX_CREATE:
+    case StorageGlobalOperation::TEXT_INDEX_DROP:
     case StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE:
     case StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP: {
       MG_ASSERT(properties.size() == 1, "Invalid function call!");
@@ -615,68 +783,169 @@ void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, Storage
       }
       break;
     }
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+    case StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE:
+    case StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP:
+      LOG_FATAL("Invalid function call!");
   }
 }
 
-RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConstraints *indices_constraints,
-                     const std::optional<uint64_t> last_loaded_timestamp, utils::SkipList<Vertex> *vertices,
-                     utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count,
-                     Config::Items items) {
-  spdlog::info("Trying to load WAL file {}.", path);
-  RecoveryInfo ret;
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     EdgeTypeId edge_type, uint64_t timestamp) {
+  MG_ASSERT(operation == StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE ||
+                operation == StorageGlobalOperation::EDGE_TYPE_INDEX_DROP,
+            "Invalid function call!");
+  encoder->WriteMarker(Marker::SECTION_DELTA);
+  encoder->WriteUint(timestamp);
+  encoder->WriteMarker(OperationToMarker(operation));
+  encoder->WriteString(name_id_mapper->IdToName(edge_type.AsUint()));
+}
 
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  MG_ASSERT(operation == StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE ||
+                operation == StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP,
+            "Invalid function call!");
+  MG_ASSERT(!properties.empty(), "Invalid function call!");
+  encoder->WriteMarker(Marker::SECTION_DELTA);
+  encoder->WriteUint(timestamp);
+  encoder->WriteMarker(OperationToMarker(operation));
+  encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
+  encoder->WriteUint(properties.size());
+  for (const auto &property : properties) {
+    encoder->WriteString(name_id_mapper->IdToName(property.AsUint()));
+  }
+}
+
+namespace {
+
+// Number of bytes of encoded deltas that are compressed into a single block.
+constexpr uint64_t kWalBlockSize = 1024 * 1024;
+
+// Number of deltas that are decoded before they are applied to the storage.
+constexpr uint64_t kWalReplayBatchSize = 100000;
+
+// Writes a copy of the finalized WAL file at `path` to `new_path` with the
+// deltas compressed in blocks of `kWalBlockSize` bytes. Returns false if the
+// WAL file couldn't be read.
+bool CompressWal(const std::filesystem::path &path, const std::filesystem::path &new_path) {
+  WalInfo info;
+  try {
+    info = ReadWalInfo(path);
+  } catch (const RecoveryFailure &e) {
+    spdlog::error("Couldn't read the info of WAL file {}: {}", path, e.what());
+    return false;
+  }
   Decoder wal;
-  auto version = wal.Initialize(path, kWalMagic);
-  if (!version) throw RecoveryFailure("Couldn't read WAL magic and/or version!");
-  if (!IsVersionSupported(*version)) throw RecoveryFailure("Invalid WAL version!");
+  if (!wal.Initialize(path, kWalMagic) || !wal.SetPosition(info.offset_deltas)) {
+    spdlog::error("Couldn't read WAL file {}!", path);
+    return false;
+  }
+  auto size = wal.GetSize();
+  if (!size) {
+    spdlog::error("Couldn't read the size of WAL file {}!", path);
+    return false;
+  }
 
-  // Read wal info.
-  auto info = ReadWalInfo(path);
-  ret.last_commit_timestamp = info.to_timestamp;
+  Encoder compressed;
+  compressed.Initialize(new_path, kWalMagic, kVersion);
 
-  // Check timestamp.
-  if (last_loaded_timestamp && info.to_timestamp <= *last_loaded_timestamp) {
-    spdlog::info("Skip loading WAL file because it is too old.");
-    return ret;
+  // Write placeholder offsets.
+  uint64_t offset_offsets = 0;
+  uint64_t offset_metadata = 0;
+  uint64_t offset_deltas = 0;
+  compressed.WriteMarker(Marker::SECTION_OFFSETS);
+  offset_offsets = compressed.GetPosition();
+  compressed.WriteUint(offset_metadata);
+  compressed.WriteUint(offset_deltas);
+
+  // Write metadata.
+  offset_metadata = compressed.GetPosition();
+  compressed.WriteMarker(Marker::SECTION_METADATA);
+  compressed.WriteString(info.uuid);
+  compressed.WriteString(info.epoch_id);
+  compressed.WriteUint(info.seq_num);
+  compressed.WriteBool(true);
+
+  // Write final offsets.
+  offset_deltas = compressed.GetPosition();
+  compressed.SetPosition(offset_offsets);
+  compressed.WriteUint(offset_metadata);
+  compressed.WriteUint(offset_deltas);
+  compressed.SetPosition(offset_deltas);
+
+  // Write the compressed blocks.
+  std::vector<uint8_t> block(kWalBlockSize);
+  std::vector<uint8_t> compressed_block;
+  uint64_t remaining = *size - info.offset_deltas;
+  uint64_t input_bytes = 0;
+  uint64_t output_bytes = 0;
+  while (remaining != 0) {
+    auto block_size = std::min(remaining, kWalBlockSize);
+    if (!wal.Read(block.data(), block_size)) {
+      spdlog::error("Couldn't read the deltas of WAL file {}!", path);
+      compressed.Close();
+      return false;
+    }
+    try {
+      CompressBlock(block.data(), block_size, &compressed_block);
+    } catch (const DurabilityFailure &e) {
+      spdlog::error("Couldn't compress the deltas of WAL file {}: {}", path, e.what());
+      compressed.Close();
+      return false;
+    }
+    compressed.WriteMarker(Marker::SECTION_BLOCK);
+    compressed.WriteUint(block_size);
+    compressed.WriteUint(compressed_block.size());
+    compressed.Write(compressed_block.data(), compressed_block.size());
+    input_bytes += block_size;
+    output_bytes += compressed_block.size();
+    remaining -= block_size;
   }
 
-  // Recover deltas.
-  wal.SetPosition(info.offset_deltas);
-  uint64_t deltas_applied = 0;
-  auto edge_acc = edges->access();
-  auto vertex_acc = vertices->access();
-  spdlog::info("WAL file contains {} deltas.", info.num_deltas);
-  for (uint64_t i = 0; i < info.num_deltas; ++i) {
-    // Read WAL delta header to find out the delta timestamp.
-    auto timestamp = ReadWalDeltaHeader(&wal);
+  compressed.Finalize();
+  EventCounter::IncrementCounter(EventCounter::WalCompressionInputBytes, input_bytes);
+  EventCounter::IncrementCounter(EventCounter::WalCompressionOutputBytes, output_bytes);
+  return true;
+}
 
-    if (!last_loaded_timestamp || timestamp > *last_loaded_timestamp) {
-      // This delta should be loaded.
-      auto delta = ReadWalDeltaData(&wal);
+// Applies a batch of deltas to the storage. The deltas are applied in three
+// passes that are each run by `thread_count` threads:
+//   1) vertex creations, labels and properties, partitioned by the vertex GID
+//   2) edge creations, deletions and properties, partitioned by the edge GID;
+//      the adjacency lists of the vertices are shared between the partitions
+//      so they are modified under the vertex lock
+//   3) vertex deletions, partitioned by the vertex GID
+// Deltas of the same object are applied in their original order. An edge
+// can only reference vertices that were created before it and a vertex can
+// only be deleted after all of its edges were deleted, so the passes yield the
+// same state as applying the deltas in order. Index and constraint operations
+// are applied afterwards in their original order.
+void ApplyWalDeltas(const std::vector<WalDeltaData> &deltas, RecoveredIndicesAndConstraints *indices_constraints,
+                    VerticesContainer *vertices, VertexDirectory *vertex_directory, EdgesContainer *edges,
+                    NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items,
+                    uint64_t thread_count) {
+  thread_count = std::max<uint64_t>(thread_count, 1);
+  auto in_partition = [thread_count](Gid gid, uint64_t partition) { return gid.AsUint() % thread_count == partition; };
+
+  // Recover vertices (creation, labels and properties).
+  utils::ParallelFor(thread_count, thread_count, [&](uint64_t partition) {
+    auto vertex_acc = vertices->access();
+    for (const auto &delta : deltas) {
       switch (delta.type) {
         case WalDeltaData::Type::VERTEX_CREATE: {
+          if (!in_partition(delta.vertex_create_delete.gid, partition)) break;
           auto [vertex, inserted] = vertex_acc.insert(Vertex{delta.vertex_create_delete.gid, nullptr});
           if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
-
-          ret.next_vertex_id = std::max(ret.next_vertex_id, delta.vertex_create_delete.gid.AsUint() + 1);
-
-          break;
-        }
-        case WalDeltaData::Type::VERTEX_DELETE: {
-          auto vertex = vertex_acc.find(delta.vertex_create_delete.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
-          if (!vertex->in_edges.empty() || !vertex->out_edges.empty())
-            throw RecoveryFailure("The vertex can't be deleted because it still has edges!");
-
-          if (!vertex_acc.remove(delta.vertex_create_delete.gid))
-            throw RecoveryFailure("The vertex must be removed here!");
-
+          vertex_directory->Insert(vertex->gid, &*vertex);
           break;
         }
         case WalDeltaData::Type::VERTEX_ADD_LABEL:
         case WalDeltaData::Type::VERTEX_REMOVE_LABEL: {
-          auto vertex = vertex_acc.find(delta.vertex_add_remove_label.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+          if (!in_partition(delta.vertex_add_remove_label.gid, partition)) break;
+          auto *vertex = vertex_directory->Find(delta.vertex_add_remove_label.gid);
+          if (vertex == nullptr) throw RecoveryFailure("The vertex doesn't exist!");
 
           auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.vertex_add_remove_label.label));
           auto it = std::find(vertex->labels.begin(), vertex->labels.end(), label_id);
@@ -689,25 +958,37 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             std::swap(*it, vertex->labels.back());
             vertex->labels.pop_back();
           }
-
           break;
         }
         case WalDeltaData::Type::VERTEX_SET_PROPERTY: {
-          auto vertex = vertex_acc.find(delta.vertex_edge_set_property.gid);
-          if (vertex == vertex_acc.end()) throw RecoveryFailure("The vertex doesn't exist!");
+          if (!in_partition(delta.vertex_edge_set_property.gid, partition)) break;
+          auto *vertex = vertex_directory->Find(delta.vertex_edge_set_property.gid);
+          if (vertex == nullptr) throw RecoveryFailure("The vertex doesn't exist!");
 
           auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
           auto &property_value = delta.vertex_edge_set_property.value;
 
           vertex->properties.SetProperty(property_id, property_value);
-
           break;
         }
+        default:
+          break;
+      }
+    }
+  });
+
+  // Recover edges.
+  utils::ParallelFor(thread_count, thread_count, [&](uint64_t partition) {
+    auto edge_acc = edges->access();
+    auto vertex_acc = vertices->access();
+    for (const auto &delta : deltas) {
+      switch (delta.type) {
         case WalDeltaData::Type::EDGE_CREATE: {
-          auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
-          auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
+          if (!in_partition(delta.edge_create_delete.gid, partition)) break;
+          auto *from_vertex = vertex_directory->Find(delta.edge_create_delete.from_vertex);
+          if (from_vertex == nullptr) throw RecoveryFailure("The from vertex doesn't exist!");
+          auto *to_vertex = vertex_directory->Find(delta.edge_create_delete.to_vertex);
+          if (to_vertex == nullptr) throw RecoveryFailure("The to vertex doesn't exist!");
 
           auto edge_gid = delta.edge_create_delete.gid;
           auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
@@ -718,30 +999,30 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             edge_ref = EdgeRef(&*edge);
           }
           {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
+            std::lock_guard<utils::SpinLock> guard(from_vertex->lock);
+            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, to_vertex, edge_ref};
             auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
             if (it != from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex already has this edge!");
             from_vertex->out_edges.push_back(link);
           }
           {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
+            std::lock_guard<utils::SpinLock> guard(to_vertex->lock);
+            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, from_vertex, edge_ref};
             auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
             if (it != to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex already has this edge!");
             to_vertex->in_edges.push_back(link);
           }
 
-          ret.next_edge_id = std::max(ret.next_edge_id, edge_gid.AsUint() + 1);
-
           // Increment edge count.
           edge_count->fetch_add(1, std::memory_order_acq_rel);
-
           break;
         }
         case WalDeltaData::Type::EDGE_DELETE: {
-          auto from_vertex = vertex_acc.find(delta.edge_create_delete.from_vertex);
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("The from vertex doesn't exist!");
-          auto to_vertex = vertex_acc.find(delta.edge_create_delete.to_vertex);
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("The to vertex doesn't exist!");
+          if (!in_partition(delta.edge_create_delete.gid, partition)) break;
+          auto *from_vertex = vertex_directory->Find(delta.edge_create_delete.from_vertex);
+          if (from_vertex == nullptr) throw RecoveryFailure("The from vertex doesn't exist!");
+          auto *to_vertex = vertex_directory->Find(delta.edge_create_delete.to_vertex);
+          if (to_vertex == nullptr) throw RecoveryFailure("The to vertex doesn't exist!");
 
           auto edge_gid = delta.edge_create_delete.gid;
           auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.edge_create_delete.edge_type));
@@ -752,14 +1033,16 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             edge_ref = EdgeRef(&*edge);
           }
           {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
+            std::lock_guard<utils::SpinLock> guard(from_vertex->lock);
+            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, to_vertex, edge_ref};
             auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
             if (it == from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex doesn't have this edge!");
             std::swap(*it, from_vertex->out_edges.back());
             from_vertex->out_edges.pop_back();
           }
           {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
+            std::lock_guard<utils::SpinLock> guard(to_vertex->lock);
+            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, from_vertex, edge_ref};
             auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
             if (it == to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex doesn't have this edge!");
             std::swap(*it, to_vertex->in_edges.back());
@@ -771,7 +1054,6 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
 
           // Decrement edge count.
           edge_count->fetch_add(-1, std::memory_order_acq_rel);
-
           break;
         }
         case WalDeltaData::Type::EDGE_SET_PROPERTY: {
@@ -779,6 +1061,7 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             throw RecoveryFailure(
                 "The WAL has properties on edges, but the storage is "
                 "configured without properties on edges!");
+          if (!in_partition(delta.vertex_edge_set_property.gid, partition)) break;
           auto edge = edge_acc.find(delta.vertex_edge_set_property.gid);
           if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
           auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.vertex_edge_set_property.property));
@@ -786,75 +1069,229 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
           edge->properties.SetProperty(property_id, property_value);
           break;
         }
-        case WalDeltaData::Type::TRANSACTION_END:
-          break;
-        case WalDeltaData::Type::LABEL_INDEX_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
-          AddRecoveredIndexConstraint(&indices_constraints->indices.label, label_id, "The label index already exists!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_INDEX_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
-          RemoveRecoveredIndexConstraint(&indices_constraints->indices.label, label_id,
-                                         "The label index doesn't exist!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          AddRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
-                                      "The label property index already exists!");
-          break;
-        }
-        case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
-                                         "The label property index doesn't exist!");
-          break;
-        }
-        case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          AddRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
-                                      "The existence constraint already exists!");
+        default:
           break;
+      }
+    }
+  });
+
+  // Recover vertex deletions.
+  utils::ParallelFor(thread_count, thread_count, [&](uint64_t partition) {
+    auto vertex_acc = vertices->access();
+    for (const auto &delta : deltas) {
+      if (delta.type != WalDeltaData::Type::VERTEX_DELETE) continue;
+      if (!in_partition(delta.vertex_create_delete.gid, partition)) continue;
+      auto *vertex = vertex_directory->Find(delta.vertex_create_delete.gid);
+      if (vertex == nullptr) throw RecoveryFailure("The vertex doesn't exist!");
+      if (!vertex->in_edges.empty() || !vertex->out_edges.empty())
+        throw RecoveryFailure("The vertex can't be deleted because it still has edges!");
+
+      vertex_directory->Remove(delta.vertex_create_delete.gid);
+      if (!vertex_acc.remove(delta.vertex_create_delete.gid)) throw RecoveryFailure("The vertex must be removed here!");
+    }
+  });
+
+  // Recover indices and constraints.
+  for (const auto &delta : deltas) {
+    switch (delta.type) {
+      case WalDeltaData::Type::VERTEX_CREATE:
+      case WalDeltaData::Type::VERTEX_DELETE:
+      case WalDeltaData::Type::VERTEX_ADD_LABEL:
+      case WalDeltaData::Type::VERTEX_REMOVE_LABEL:
+      case WalDeltaData::Type::VERTEX_SET_PROPERTY:
+      case WalDeltaData::Type::EDGE_CREATE:
+      case WalDeltaData::Type::EDGE_DELETE:
+      case WalDeltaData::Type::EDGE_SET_PROPERTY:
+      case WalDeltaData::Type::TRANSACTION_END:
+        break;
+      case WalDeltaData::Type::LABEL_INDEX_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
+        AddRecoveredIndexConstraint(&indices_constraints->indices.label, label_id, "The label index already exists!");
+        break;
+      }
+      case WalDeltaData::Type::LABEL_INDEX_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label.label));
+        RemoveRecoveredIndexConstraint(&indices_constraints->indices.label, label_id,
+                                       "The label index doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE: {
+        auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type.edge_type));
+        AddRecoveredIndexConstraint(&indices_constraints->indices.edge_type, edge_type_id,
+                                    "The edge type index already exists!");
+        break;
+      }
+      case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+        auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type.edge_type));
+        RemoveRecoveredIndexConstraint(&indices_constraints->indices.edge_type, edge_type_id,
+                                       "The edge type index doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        AddRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
+                                    "The label property index already exists!");
+        break;
+      }
+      case WalDeltaData::Type::LABEL_PROPERTY_INDEX_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property, {label_id, property_id},
+                                       "The label property index doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::TEXT_INDEX_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        AddRecoveredIndexConstraint(&indices_constraints->indices.text, {label_id, property_id},
+                                    "The text index already exists!");
+        break;
+      }
+      case WalDeltaData::Type::TEXT_INDEX_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        RemoveRecoveredIndexConstraint(&indices_constraints->indices.text, {label_id, property_id},
+                                       "The text index doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+        std::vector<PropertyId> property_ids;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
         }
-        case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
-          auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
-          RemoveRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
-                                         "The existence constraint doesn't exist!");
-          break;
+        AddRecoveredIndexConstraint(&indices_constraints->indices.label_properties, {label_id, property_ids},
+                                    "The label properties index already exists!");
+        break;
+      }
+      case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+        std::vector<PropertyId> property_ids;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
         }
-        case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
-          std::set<PropertyId> property_ids;
-          for (const auto &prop : delta.operation_label_properties.properties) {
-            property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
-          }
-          AddRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
-                                      "The unique constraint already exists!");
-          break;
+        RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_properties, {label_id, property_ids},
+                                       "The label properties index doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        AddRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
+                                    "The existence constraint already exists!");
+        break;
+      }
+      case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.label));
+        auto property_id = PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_label_property.property));
+        RemoveRecoveredIndexConstraint(&indices_constraints->constraints.existence, {label_id, property_id},
+                                       "The existence constraint doesn't exist!");
+        break;
+      }
+      case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
+        std::set<PropertyId> property_ids;
+        for (const auto &prop : delta.operation_label_properties.properties) {
+          property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
         }
-        case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP: {
-          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
-          std::set<PropertyId> property_ids;
-          for (const auto &prop : delta.operation_label_properties.properties) {
-            property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
-          }
-          RemoveRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
-                                         "The unique constraint doesn't exist!");
-          break;
+        AddRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
+                                    "The unique constraint already exists!");
+        break;
+      }
+      case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP: {
+        auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_properties.label));
+        std::set<PropertyId> property_ids;
+        for (const auto &prop : delta.operation_label_properties.properties) {
+          property_ids.insert(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
         }
+        RemoveRecoveredIndexConstraint(&indices_constraints->constraints.unique, {label_id, property_ids},
+                                       "The unique constraint doesn't exist!");
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool CompressWalFile(const std::filesystem::path &path, utils::FileRetainer *file_retainer) {
+  // The locker defers deletions of the file (e.g. when a snapshot makes it
+  // obsolete) until the compressed file replaced it.
+  auto locker = file_retainer->AddLocker();
+  {
+    auto locker_acc = locker.Access();
+    locker_acc.AddPath(path);
+  }
+  if (std::error_code error_code; !std::filesystem::exists(path, error_code)) {
+    // The file was deleted before it was locked.
+    return false;
+  }
+
+  auto compressing_path = path;
+  compressing_path += kCompressingWalExtension;
+  if (!CompressWal(path, compressing_path)) {
+    utils::DeleteFile(compressing_path);
+    spdlog::warn("WAL file {} is kept uncompressed.", path);
+    return false;
+  }
+  if (!utils::RenamePath(compressing_path, path)) {
+    utils::DeleteFile(compressing_path);
+    spdlog::error("Couldn't replace WAL file {} with its compressed copy, the file is kept uncompressed.", path);
+    return false;
+  }
+  return true;
+}
+
+RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConstraints *indices_constraints,
+                     const std::optional<uint64_t> last_loaded_timestamp, VerticesContainer *vertices,
+                     VertexDirectory *vertex_directory, EdgesContainer *edges, NameIdMapper *name_id_mapper,
+                     std::atomic<uint64_t> *edge_count, Config::Items items, uint64_t thread_count) {
+  spdlog::info("Trying to load WAL file {}.", path);
+  RecoveryInfo ret;
+
+  // Read wal info.
+  auto info = ReadWalInfo(path);
+  ret.last_commit_timestamp = info.to_timestamp;
+
+  // Check timestamp.
+  if (last_loaded_timestamp && info.to_timestamp <= *last_loaded_timestamp) {
+    spdlog::info("Skip loading WAL file because it is too old.");
+    return ret;
+  }
+
+  // Recover deltas.
+  WalDeltaDecoder wal(path, info);
+  uint64_t deltas_applied = 0;
+  std::vector<WalDeltaData> batch;
+  batch.reserve(std::min(info.num_deltas, kWalReplayBatchSize));
+  spdlog::info("WAL file contains {} deltas.", info.num_deltas);
+  for (uint64_t i = 0; i < info.num_deltas; ++i) {
+    // Read WAL delta header to find out the delta timestamp.
+    auto timestamp = ReadWalDeltaHeader(&wal);
+
+    if (!last_loaded_timestamp || timestamp > *last_loaded_timestamp) {
+      // This delta should be loaded.
+      auto &delta = batch.emplace_back(ReadWalDeltaData(&wal));
+      if (delta.type == WalDeltaData::Type::VERTEX_CREATE) {
+        ret.next_vertex_id = std::max(ret.next_vertex_id, delta.vertex_create_delete.gid.AsUint() + 1);
+      } else if (delta.type == WalDeltaData::Type::EDGE_CREATE) {
+        ret.next_edge_id = std::max(ret.next_edge_id, delta.edge_create_delete.gid.AsUint() + 1);
       }
       ret.next_timestamp = std::max(ret.next_timestamp, timestamp + 1);
       ++deltas_applied;
+      if (batch.size() == kWalReplayBatchSize) {
+        ApplyWalDeltas(batch, indices_constraints, vertices, vertex_directory, edges, name_id_mapper, edge_count, items,
+                       thread_count);
+        batch.clear();
+      }
     } else {
       // This delta should be skipped.
       SkipWalDeltaData(&wal);
     }
   }
+  ApplyWalDeltas(batch, indices_constraints, vertices, vertex_directory, edges, name_id_mapper, edge_count, items,
+                 thread_count);
 
   spdlog::info("Applied {} deltas from WAL. Skipped {} deltas, because they were too old.", deltas_applied,
                info.num_deltas - deltas_applied);
@@ -864,7 +1301,7 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
 
 WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_view uuid,
                  const std::string_view epoch_id, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
-                 utils::FileRetainer *file_retainer)
+                 utils::FileRetainer *file_retainer, utils::OutputFile::IoBackend io_backend)
     : items_(items),
       name_id_mapper_(name_id_mapper),
       path_(wal_directory / MakeWalName()),
@@ -877,7 +1314,7 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
   utils::EnsureDirOrDie(wal_directory);
 
   // Initialize the WAL file.
-  wal_.Initialize(path_, kWalMagic, kVersion);
+  wal_.Initialize(path_, kWalMagic, kVersion, io_backend);
 
   // Write placeholder offsets.
   uint64_t offset_offsets = 0;
@@ -894,6 +1331,8 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
   wal_.WriteString(uuid);
   wal_.WriteString(epoch_id);
   wal_.WriteUint(seq_num);
+  // The deltas are compressed only when the WAL file is finalized.
+  wal_.WriteBool(false);
 
   // Write final offsets.
   offset_deltas = wal_.GetPosition();
@@ -908,7 +1347,7 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
 
 WalFile::WalFile(std::filesystem::path current_wal_path, Config::Items items, NameIdMapper *name_id_mapper,
                  uint64_t seq_num, uint64_t from_timestamp, uint64_t to_timestamp, uint64_t count,
-                 utils::FileRetainer *file_retainer)
+                 utils::FileRetainer *file_retainer, utils::OutputFile::IoBackend io_backend)
     : items_(items),
       name_id_mapper_(name_id_mapper),
       path_(std::move(current_wal_path)),
@@ -917,7 +1356,8 @@ WalFile::WalFile(std::filesystem::path current_wal_path, Config::Items items, Na
       count_(count),
       seq_num_(seq_num),
       file_retainer_(file_retainer) {
-  wal_.OpenExisting(path_);
+  wal_.OpenExisting(path_, io_backend);
+  accounted_size_ = wal_.GetSize();
 }
 
 void WalFile::FinalizeWal() {
@@ -967,9 +1407,32 @@ void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label, c
   UpdateStats(timestamp);
 }
 
-void WalFile::Sync() { wal_.Sync(); }
+void WalFile::AppendOperation(StorageGlobalOperation operation, EdgeTypeId edge_type, uint64_t timestamp) {
+  EncodeOperation(&wal_, name_id_mapper_, operation, edge_type, timestamp);
+  UpdateStats(timestamp);
+}
 
-uint64_t WalFile::GetSize() { return wal_.GetSize(); }
+void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label,
+                              const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  EncodeOperation(&wal_, name_id_mapper_, operation, label, properties, timestamp);
+  UpdateStats(timestamp);
+}
+
+void WalFile::Sync() {
+  EventHistogram::ScopedMeasure measure{EventHistogram::WalFsyncLatency};
+  wal_.Sync();
+}
+
+uint64_t WalFile::GetSize() {
+  auto size = wal_.GetSize();
+  // The size is checked after every commit, so the newly written bytes are
+  // accounted here.
+  if (size > accounted_size_) {
+    EventCounter::IncrementCounter(EventCounter::WalBytesWritten, size - accounted_size_);
+    accounted_size_ = size;
+  }
+  return size;
+}
 
 uint64_t WalFile::SequenceNumber() const { return seq_num_; }
 
@@ -13,10 +13,13 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "storage/v2/config.hpp"
+#include "storage/v2/containers.hpp"
 #include "storage/v2/delta.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/durability/serialization.hpp"
@@ -25,8 +28,8 @@
 #include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/vertex.hpp"
+#include "storage/v2/vertex_directory.hpp"
 #include "utils/file_locker.hpp"
-#include "utils/skip_list.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -41,6 +44,8 @@ struct WalInfo {
   uint64_t from_timestamp;
   uint64_t to_timestamp;
   uint64_t num_deltas;
+  // Whether the deltas are stored in compressed blocks (from version 19).
+  bool compressed{false};
 };
 
 /// Structure used to return loaded WAL delta data.
@@ -63,6 +68,12 @@ struct WalDeltaData {
     EXISTENCE_CONSTRAINT_DROP,
     UNIQUE_CONSTRAINT_CREATE,
     UNIQUE_CONSTRAINT_DROP,
+    EDGE_TYPE_INDEX_CREATE,
+    EDGE_TYPE_INDEX_DROP,
+    LABEL_PROPERTIES_INDEX_CREATE,
+    LABEL_PROPERTIES_INDEX_DROP,
+    TEXT_INDEX_CREATE,
+    TEXT_INDEX_DROP,
   };
 
   Type type{Type::TRANSACTION_END};
@@ -93,6 +104,10 @@ struct WalDeltaData {
     std::string label;
   } operation_label;
 
+  struct {
+    std::string edge_type;
+  } operation_edge_type;
+
   struct {
     std::string label;
     std::string property;
@@ -102,6 +117,12 @@ struct WalDeltaData {
     std::string label;
     std::set<std::string> properties;
   } operation_label_properties;
+
+  // The order of the properties is a part of the composite index key.
+  struct {
+    std::string label;
+    std::vector<std::string> properties;
+  } operation_label_property_list;
 };
 
 bool operator==(const WalDeltaData &a, const WalDeltaData &b);
@@ -117,6 +138,12 @@ enum class StorageGlobalOperation {
   EXISTENCE_CONSTRAINT_DROP,
   UNIQUE_CONSTRAINT_CREATE,
   UNIQUE_CONSTRAINT_DROP,
+  EDGE_TYPE_INDEX_CREATE,
+  EDGE_TYPE_INDEX_DROP,
+  LABEL_PROPERTIES_INDEX_CREATE,
+  LABEL_PROPERTIES_INDEX_DROP,
+  TEXT_INDEX_CREATE,
+  TEXT_INDEX_DROP,
 };
 
 constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
@@ -148,6 +175,12 @@ constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP:
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP:
+    case WalDeltaData::Type::TEXT_INDEX_CREATE:
+    case WalDeltaData::Type::TEXT_INDEX_DROP:
       return true;
   }
 }
@@ -156,6 +189,37 @@ constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
 /// @throw RecoveryFailure
 WalInfo ReadWalInfo(const std::filesystem::path &path);
 
+/// Decoder used to read the deltas of a WAL file, positioned at the first
+/// delta. The deltas of a compressed WAL file are decompressed into memory
+/// when the decoder is created.
+class WalDeltaDecoder final : public BaseDecoder {
+ public:
+  /// @throw RecoveryFailure
+  WalDeltaDecoder(const std::filesystem::path &path, const WalInfo &info);
+
+  WalDeltaDecoder(const WalDeltaDecoder &) = delete;
+  WalDeltaDecoder(WalDeltaDecoder &&) = delete;
+  WalDeltaDecoder &operator=(const WalDeltaDecoder &) = delete;
+  WalDeltaDecoder &operator=(WalDeltaDecoder &&) = delete;
+  ~WalDeltaDecoder() = default;
+
+  std::optional<Marker> ReadMarker() override { return decoder_->ReadMarker(); }
+  std::optional<bool> ReadBool() override { return decoder_->ReadBool(); }
+  std::optional<uint64_t> ReadUint() override { return decoder_->ReadUint(); }
+  std::optional<double> ReadDouble() override { return decoder_->ReadDouble(); }
+  std::optional<std::string> ReadString() override { return decoder_->ReadString(); }
+  std::optional<PropertyValue> ReadPropertyValue() override { return decoder_->ReadPropertyValue(); }
+
+  bool SkipString() override { return decoder_->SkipString(); }
+  bool SkipPropertyValue() override { return decoder_->SkipPropertyValue(); }
+
+ private:
+  Decoder wal_;
+  std::vector<uint8_t> buffer_;
+  std::optional<BufferDecoder> buffer_decoder_;
+  BaseDecoder *decoder_{nullptr};
+};
+
 /// Function used to read the WAL delta header. The function returns the delta
 /// timestamp.
 /// @throw RecoveryFailure
@@ -188,20 +252,39 @@ void EncodeTransactionEnd(BaseEncoder *encoder, uint64_t timestamp);
 void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
                      LabelId label, const std::set<PropertyId> &properties, uint64_t timestamp);
 
-/// Function used to load the WAL data into the storage.
+/// Function used to encode non-transactional operation on an edge type.
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     EdgeTypeId edge_type, uint64_t timestamp);
+
+/// Function used to encode non-transactional operation on a label and an
+/// ordered list of properties.
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+/// Function used to compress the deltas of the finalized WAL file at `path`.
+/// The compressed copy is written next to the WAL file and replaces it only
+/// after it was written completely, so the WAL file stays valid if the
+/// compression fails. Returns false if the file wasn't compressed.
+bool CompressWalFile(const std::filesystem::path &path, utils::FileRetainer *file_retainer);
+
+/// Function used to load the WAL data into the storage. The deltas are
+/// applied using `thread_count` threads; vertex deltas are partitioned by the
+/// vertex GID and edge deltas by the edge GID.
 /// @throw RecoveryFailure
 RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConstraints *indices_constraints,
-                     std::optional<uint64_t> last_loaded_timestamp, utils::SkipList<Vertex> *vertices,
-                     utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count,
-                     Config::Items items);
+                     std::optional<uint64_t> last_loaded_timestamp, VerticesContainer *vertices,
+                     VertexDirectory *vertex_directory, EdgesContainer *edges, NameIdMapper *name_id_mapper,
+                     std::atomic<uint64_t> *edge_count, Config::Items items, uint64_t thread_count);
 
 /// WalFile class used to append deltas and operations to the WAL file.
 class WalFile {
  public:
   WalFile(const std::filesystem::path &wal_directory, std::string_view uuid, std::string_view epoch_id,
-          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer);
+          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer,
+          utils::OutputFile::IoBackend io_backend = utils::OutputFile::IoBackend::SYSCALL);
   WalFile(std::filesystem::path current_wal_path, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
-          uint64_t from_timestamp, uint64_t to_timestamp, uint64_t count, utils::FileRetainer *file_retainer);
+          uint64_t from_timestamp, uint64_t to_timestamp, uint64_t count, utils::FileRetainer *file_retainer,
+          utils::OutputFile::IoBackend io_backend = utils::OutputFile::IoBackend::SYSCALL);
 
   WalFile(const WalFile &) = delete;
   WalFile(WalFile &&) = delete;
@@ -218,6 +301,11 @@ class WalFile {
   void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
                        uint64_t timestamp);
 
+  void AppendOperation(StorageGlobalOperation operation, EdgeTypeId edge_type, uint64_t timestamp);
+
+  void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::vector<PropertyId> &properties,
+                       uint64_t timestamp);
+
   void Sync();
 
   uint64_t GetSize();
@@ -242,6 +330,8 @@ class WalFile {
   // Get the path of the current WAL file.
   const auto &Path() const { return path_; }
 
+  // Finalizes the WAL file. The finalized file is uncompressed, it can be
+  // compressed afterwards with `CompressWalFile`.
   void FinalizeWal();
   void DeleteWal();
 
@@ -256,6 +346,8 @@ class WalFile {
   uint64_t to_timestamp_;
   uint64_t count_;
   uint64_t seq_num_;
+  // Size of the file that was already accounted in the WAL metrics.
+  uint64_t accounted_size_{0};
 
   utils::FileRetainer *file_retainer_;
 };
@@ -62,6 +62,7 @@ VertexAccessor EdgeAccessor::ToVertex() const {
 }
 
 Result<storage::PropertyValue> EdgeAccessor::SetProperty(PropertyId property, const PropertyValue &value) {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
@@ -85,6 +86,7 @@ Result<storage::PropertyValue> EdgeAccessor::SetProperty(PropertyId property, co
 }
 
 Result<std::map<PropertyId, PropertyValue>> EdgeAccessor::ClearProperties() {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   if (!config_.properties_on_edges) return Error::PROPERTIES_DISABLED;
 
   std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
@@ -145,6 +147,12 @@ Result<PropertyValue> EdgeAccessor::GetProperty(PropertyId property, View view)
   return std::move(value);
 }
 
+Result<PropertyComparison> EdgeAccessor::CompareProperty(PropertyId property, const PropertyValue &value,
+                                                         View view) const {
+  if (!config_.properties_on_edges) return PropertyComparison::ABSENT;
+  return ComparePropertyForRead(transaction_, edge_.ptr, property, value, view, for_deleted_);
+}
+
 Result<std::map<PropertyId, PropertyValue>> EdgeAccessor::Properties(View view) const {
   if (!config_.properties_on_edges) return std::map<PropertyId, PropertyValue>{};
   bool exists = true;
@@ -10,6 +10,7 @@
 // licenses/APL.txt.
 
 #include "indices.hpp"
+#include <algorithm>
 #include <limits>
 
 #include "storage/v2/mvcc.hpp"
@@ -261,18 +262,876 @@ bool CurrentVersionHasLabelProperty(const Vertex &vertex, LabelId label, Propert
   return !deleted && has_label && current_value_equal_to_value;
 }
 
+/// Helper function for label-properties index garbage collection. Returns true
+/// if there's a reachable version of the vertex that has the given label and
+/// property values.
+bool AnyVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                  const std::vector<PropertyValue> &values, uint64_t timestamp) {
+  bool has_label;
+  std::vector<bool> current_values_equal(keys.size());
+  bool deleted;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+
+  auto all_values_equal = [&current_values_equal] {
+    return std::all_of(current_values_equal.begin(), current_values_equal.end(), [](bool equal) { return equal; });
+  };
+  if (!deleted && has_label && all_values_equal()) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        for (size_t i = 0; i < keys.size(); ++i) {
+          if (delta.property.key == keys[i]) {
+            current_values_equal[i] = delta.property.value == values[i];
+          }
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && all_values_equal();
+  });
+}
+
+// Helper function for iterating through label-properties index. Returns true
+// if this transaction can see the given vertex, and the visible version has
+// the given label and property values.
+bool CurrentVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                      const std::vector<PropertyValue> &values, Transaction *transaction, View view) {
+  bool deleted;
+  bool has_label;
+  std::vector<bool> current_values_equal(keys.size());
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    deleted = vertex.deleted;
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    delta = vertex.delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        for (size_t i = 0; i < keys.size(); ++i) {
+          if (delta.property.key == keys[i]) {
+            current_values_equal[i] = delta.property.value == values[i];
+          }
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  return !deleted && has_label &&
+         std::all_of(current_values_equal.begin(), current_values_equal.end(), [](bool equal) { return equal; });
+}
+
+// Returns the values of the given properties of the vertex, or `std::nullopt`
+// if any of them isn't set. The caller must hold the vertex lock or otherwise
+// guarantee that the vertex isn't modified concurrently.
+std::optional<std::vector<PropertyValue>> GetIndexedValues(const Vertex &vertex,
+                                                           const std::vector<PropertyId> &properties) {
+  std::vector<PropertyValue> values;
+  values.reserve(properties.size());
+  for (const auto property : properties) {
+    auto value = vertex.properties.GetProperty(property);
+    if (value.IsNull()) return std::nullopt;
+    values.push_back(std::move(value));
+  }
+  return std::move(values);
+}
+
+// Encodes the three bytes starting at `bytes` as a text index gram. The gram
+// is offset by one so that it never equals `TextIndex::kAllGram`.
+uint32_t EncodeGram(const char *bytes) {
+  return ((static_cast<uint32_t>(static_cast<uint8_t>(bytes[0])) << 16U) |
+          (static_cast<uint32_t>(static_cast<uint8_t>(bytes[1])) << 8U) |
+          static_cast<uint32_t>(static_cast<uint8_t>(bytes[2]))) +
+         1;
+}
+
+// Returns true if the value is a string which contains the gram. Every string
+// contains `TextIndex::kAllGram`.
+bool StringHasGram(const PropertyValue &value, uint32_t gram) {
+  if (!value.IsString()) return false;
+  if (gram == TextIndex::kAllGram) return true;
+  const auto encoded = gram - 1;
+  const char bytes[] = {static_cast<char>((encoded >> 16U) & 0xFFU), static_cast<char>((encoded >> 8U) & 0xFFU),
+                        static_cast<char>(encoded & 0xFFU)};
+  return value.ValueString().find(std::string_view(bytes, sizeof(bytes))) != std::string::npos;
+}
+
+/// Helper function for text index garbage collection. Returns true if there's
+/// a reachable version of the vertex that has the given label and a string
+/// property which contains the gram.
+bool AnyVersionHasLabelTextGram(const Vertex &vertex, LabelId label, PropertyId key, uint32_t gram,
+                                uint64_t timestamp) {
+  bool has_label;
+  bool current_value_has_gram;
+  bool deleted;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    current_value_has_gram = StringHasGram(vertex.properties.GetProperty(key), gram);
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+
+  if (!deleted && has_label && current_value_has_gram) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        if (delta.property.key == key) {
+          current_value_has_gram = StringHasGram(delta.property.value, gram);
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && current_value_has_gram;
+  });
+}
+
+// Helper function for iterating through text index. Returns true if this
+// transaction can see the given vertex, and the visible version has the given
+// label and a string property which contains the gram.
+bool CurrentVersionHasLabelTextGram(const Vertex &vertex, LabelId label, PropertyId key, uint32_t gram,
+                                    Transaction *transaction, View view) {
+  bool deleted;
+  bool has_label;
+  bool current_value_has_gram;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    deleted = vertex.deleted;
+    has_label = utils::Contains(vertex.labels, label);
+    current_value_has_gram = StringHasGram(vertex.properties.GetProperty(key), gram);
+    delta = vertex.delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        if (delta.property.key == key) {
+          current_value_has_gram = StringHasGram(delta.property.value, gram);
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  return !deleted && has_label && current_value_has_gram;
+}
+
+/// Helper function for edge type index garbage collection. Returns true if
+/// there's a reachable version of the `from` vertex that has the given edge.
+bool AnyVersionHasOutEdge(const Vertex &from_vertex, EdgeTypeId edge_type, Vertex *to_vertex, EdgeRef edge,
+                          uint64_t timestamp) {
+  const auto edge_tuple = std::make_tuple(edge_type, to_vertex, edge);
+  bool has_edge;
+  bool deleted;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(from_vertex.lock);
+    has_edge = utils::Contains(from_vertex.out_edges, edge_tuple);
+    deleted = from_vertex.deleted;
+    delta = from_vertex.delta;
+  }
+  if (!deleted && has_edge) {
+    return true;
+  }
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&has_edge, &deleted, edge](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          has_edge = true;
+        }
+        break;
+      case Delta::Action::REMOVE_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          has_edge = false;
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::SET_PROPERTY:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+        break;
+    }
+    return !deleted && has_edge;
+  });
+}
+
+// Helper function for iterating through edge type index. Returns true if this
+// transaction can see the given edge in the outgoing edges of its `from`
+// vertex. The edge object itself is never touched before this returns true,
+// because it may already be freed for entries that are waiting for cleanup.
+bool CurrentVersionHasOutEdge(const Vertex &from_vertex, EdgeTypeId edge_type, Vertex *to_vertex, EdgeRef edge,
+                              Transaction *transaction, View view) {
+  const auto edge_tuple = std::make_tuple(edge_type, to_vertex, edge);
+  bool deleted;
+  bool has_edge;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(from_vertex.lock);
+    deleted = from_vertex.deleted;
+    has_edge = utils::Contains(from_vertex.out_edges, edge_tuple);
+    delta = from_vertex.delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&deleted, &has_edge, edge](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_OUT_EDGE: {
+        if (delta.vertex_edge.edge == edge) {
+          has_edge = true;
+        }
+        break;
+      }
+      case Delta::Action::REMOVE_OUT_EDGE: {
+        if (delta.vertex_edge.edge == edge) {
+          has_edge = false;
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::SET_PROPERTY:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+        break;
+    }
+  });
+  return !deleted && has_edge;
+}
+
 }  // namespace
 
-void LabelIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
-  auto it = index_.find(label);
-  if (it == index_.end()) return;
+void LabelIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  auto it = index_.find(label);
+  if (it == index_.end()) return;
+  auto acc = it->second.access();
+  acc.insert(Entry{vertex, tx.start_timestamp});
+}
+
+bool LabelIndex::CreateIndex(LabelId label, VerticesContainer::Accessor vertices) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+  try {
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+        continue;
+      }
+      acc.insert(Entry{&vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+std::vector<LabelId> LabelIndex::ListIndices() const {
+  std::vector<LabelId> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void LabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &label_storage : index_) {
+    auto vertices_acc = label_storage.second.access();
+    for (auto it = vertices_acc.begin(); it != vertices_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != vertices_acc.end() && it->vertex == next_it->vertex) ||
+          !AnyVersionHasLabel(*it->vertex, label_storage.first, oldest_active_start_timestamp)) {
+        vertices_acc.remove(*it);
+      }
+
+      it = next_it;
+    }
+  }
+}
+
+LabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+LabelIndex::Iterable::Iterator &LabelIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void LabelIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+    if (CurrentVersionHasLabel(*index_iterator_->vertex, self_->label_, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ =
+          VertexAccessor{current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_};
+      break;
+    }
+  }
+}
+
+LabelIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view,
+                               Transaction *transaction, Indices *indices, Constraints *constraints,
+                               Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {}
+
+void LabelIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+bool LabelPropertyIndex::Entry::operator<(const Entry &rhs) {
+  if (value < rhs.value) {
+    return true;
+  }
+  if (rhs.value < value) {
+    return false;
+  }
+  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+}
+
+bool LabelPropertyIndex::Entry::operator==(const Entry &rhs) {
+  return value == rhs.value && vertex == rhs.vertex && timestamp == rhs.timestamp;
+}
+
+bool LabelPropertyIndex::Entry::operator<(const PropertyValue &rhs) { return value < rhs; }
+
+bool LabelPropertyIndex::Entry::operator==(const PropertyValue &rhs) { return value == rhs; }
+
+void LabelPropertyIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  for (auto &[label_prop, storage] : index_) {
+    if (label_prop.first != label) {
+      continue;
+    }
+    auto prop_value = vertex->properties.GetProperty(label_prop.second);
+    if (!prop_value.IsNull()) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(prop_value), vertex, tx.start_timestamp});
+    }
+  }
+}
+
+void LabelPropertyIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                             const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+  for (auto &[label_prop, storage] : index_) {
+    if (label_prop.second != property) {
+      continue;
+    }
+    if (utils::Contains(vertex->labels, label_prop.first)) {
+      auto acc = storage.access();
+      acc.insert(Entry{value, vertex, tx.start_timestamp});
+    }
+  }
+}
+
+bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, VerticesContainer::Accessor vertices) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+  try {
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+        continue;
+      }
+      auto value = vertex.properties.GetProperty(property);
+      if (value.IsNull()) {
+        continue;
+      }
+      acc.insert(Entry{std::move(value), &vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, PropertyId>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void LabelPropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[label_property, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
+      auto next_it = it;
+      ++next_it;
+
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->value == next_it->value) ||
+          !AnyVersionHasLabelProperty(*it->vertex, label_property.first, label_property.second, it->value,
+                                      oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
+      }
+      it = next_it;
+    }
+  }
+}
+
+LabelPropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+LabelPropertyIndex::Iterable::Iterator &LabelPropertyIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void LabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+
+    if (self_->lower_bound_) {
+      if (index_iterator_->value < self_->lower_bound_->value()) {
+        continue;
+      }
+      if (!self_->lower_bound_->IsInclusive() && index_iterator_->value == self_->lower_bound_->value()) {
+        continue;
+      }
+    }
+    if (self_->upper_bound_) {
+      if (self_->upper_bound_->value() < index_iterator_->value) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+      if (!self_->upper_bound_->IsInclusive() && index_iterator_->value == self_->upper_bound_->value()) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+    }
+
+    if (CurrentVersionHasLabelProperty(*index_iterator_->vertex, self_->label_, self_->property_,
+                                       index_iterator_->value, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ =
+          VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
+      break;
+    }
+  }
+}
+
+// These constants represent the smallest possible value of each type that is
+// contained in a `PropertyValue`. Note that numbers (integers and doubles) are
+// treated as the same "type" in `PropertyValue`.
+const PropertyValue kSmallestBool = PropertyValue(false);
+static_assert(-std::numeric_limits<double>::infinity() < std::numeric_limits<int64_t>::min());
+const PropertyValue kSmallestNumber = PropertyValue(-std::numeric_limits<double>::infinity());
+const PropertyValue kSmallestString = PropertyValue("");
+const PropertyValue kSmallestList = PropertyValue(std::vector<PropertyValue>());
+const PropertyValue kSmallestMap = PropertyValue(std::map<std::string, PropertyValue>());
+const PropertyValue kSmallestTemporalData =
+    PropertyValue(TemporalData{static_cast<TemporalType>(0), std::numeric_limits<int64_t>::min()});
+
+LabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                       PropertyId property,
+                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
+                                       Transaction *transaction, Indices *indices, Constraints *constraints,
+                                       Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      property_(property),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  // We have to fix the bounds that the user provided to us. If the user
+  // provided only one bound we should make sure that only values of that type
+  // are returned by the iterator. We ensure this by supplying either an
+  // inclusive lower bound of the same type, or an exclusive upper bound of the
+  // following type. If neither bound is set we yield all items in the index.
+
+  // First we statically verify that our assumptions about the `PropertyValue`
+  // type ordering holds.
+  static_assert(PropertyValue::Type::Bool < PropertyValue::Type::Int);
+  static_assert(PropertyValue::Type::Int < PropertyValue::Type::Double);
+  static_assert(PropertyValue::Type::Double < PropertyValue::Type::String);
+  static_assert(PropertyValue::Type::String < PropertyValue::Type::List);
+  static_assert(PropertyValue::Type::List < PropertyValue::Type::Map);
+
+  // Remove any bounds that are set to `Null` because that isn't a valid value.
+  if (lower_bound_ && lower_bound_->value().IsNull()) {
+    lower_bound_ = std::nullopt;
+  }
+  if (upper_bound_ && upper_bound_->value().IsNull()) {
+    upper_bound_ = std::nullopt;
+  }
+
+  // Check whether the bounds are of comparable types if both are supplied.
+  if (lower_bound_ && upper_bound_ &&
+      !PropertyValue::AreComparableTypes(lower_bound_->value().type(), upper_bound_->value().type())) {
+    bounds_valid_ = false;
+    return;
+  }
+
+  // Set missing bounds.
+  if (lower_bound_ && !upper_bound_) {
+    // Here we need to supply an upper bound. The upper bound is set to an
+    // exclusive lower bound of the following type.
+    switch (lower_bound_->value().type()) {
+      case PropertyValue::Type::Null:
+        // This shouldn't happen because of the nullopt-ing above.
+        LOG_FATAL("Invalid database state!");
+        break;
+      case PropertyValue::Type::Bool:
+        upper_bound_ = utils::MakeBoundExclusive(kSmallestNumber);
+        break;
+      case PropertyValue::Type::Int:
+      case PropertyValue::Type::Double:
+        // Both integers and doubles are treated as the same type in
+        // `PropertyValue` and they are interleaved when sorted.
+        upper_bound_ = utils::MakeBoundExclusive(kSmallestString);
+        break;
+      case PropertyValue::Type::String:
+        upper_bound_ = utils::MakeBoundExclusive(kSmallestList);
+        break;
+      case PropertyValue::Type::List:
+        upper_bound_ = utils::MakeBoundExclusive(kSmallestMap);
+        break;
+      case PropertyValue::Type::Map:
+        upper_bound_ = utils::MakeBoundExclusive(kSmallestTemporalData);
+        break;
+      case PropertyValue::Type::TemporalData:
+        // This is the last type in the order so we leave the upper bound empty.
+        break;
+    }
+  }
+  if (upper_bound_ && !lower_bound_) {
+    // Here we need to supply a lower bound. The lower bound is set to an
+    // inclusive lower bound of the current type.
+    switch (upper_bound_->value().type()) {
+      case PropertyValue::Type::Null:
+        // This shouldn't happen because of the nullopt-ing above.
+        LOG_FATAL("Invalid database state!");
+        break;
+      case PropertyValue::Type::Bool:
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestBool);
+        break;
+      case PropertyValue::Type::Int:
+      case PropertyValue::Type::Double:
+        // Both integers and doubles are treated as the same type in
+        // `PropertyValue` and they are interleaved when sorted.
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestNumber);
+        break;
+      case PropertyValue::Type::String:
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestString);
+        break;
+      case PropertyValue::Type::List:
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestList);
+        break;
+      case PropertyValue::Type::Map:
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestMap);
+        break;
+      case PropertyValue::Type::TemporalData:
+        lower_bound_ = utils::MakeBoundInclusive(kSmallestTemporalData);
+        break;
+    }
+  }
+}
+
+LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::begin() {
+  // If the bounds are set and don't have comparable types we don't yield any
+  // items from the index.
+  if (!bounds_valid_) return Iterator(this, index_accessor_.end());
+  auto index_iterator = index_accessor_.begin();
+  if (lower_bound_) {
+    index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
+  }
+  return Iterator(this, index_iterator);
+}
+
+LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::end() {
+  return Iterator(this, index_accessor_.end());
+}
+
+int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
+                                                   const PropertyValue &value) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
   auto acc = it->second.access();
-  acc.insert(Entry{vertex, tx.start_timestamp});
+  if (!value.IsNull()) {
+    return acc.estimate_count(value, utils::SkipListLayerForCountEstimation(acc.size()));
+  } else {
+    // The value `Null` won't ever appear in the index because it indicates that
+    // the property shouldn't exist. Instead, this value is used as an indicator
+    // to estimate the average number of equal elements in the list (for any
+    // given value).
+    return acc.estimate_average_number_of_equals(
+        [](const auto &first, const auto &second) { return first.value == second.value; },
+        utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
+  }
+}
+
+int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
+                                                   const std::optional<utils::Bound<PropertyValue>> &lower,
+                                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
+  auto acc = it->second.access();
+  return acc.estimate_range_count(lower, upper, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void LabelPropertyIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+bool LabelPropertiesIndex::Entry::operator<(const Entry &rhs) {
+  if (values < rhs.values) {
+    return true;
+  }
+  if (rhs.values < values) {
+    return false;
+  }
+  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+}
+
+bool LabelPropertiesIndex::Entry::operator==(const Entry &rhs) {
+  return values == rhs.values && vertex == rhs.vertex && timestamp == rhs.timestamp;
+}
+
+bool LabelPropertiesIndex::Entry::operator<(const std::vector<PropertyValue> &prefix) {
+  return std::lexicographical_compare(values.begin(), values.begin() + prefix.size(), prefix.begin(), prefix.end());
+}
+
+bool LabelPropertiesIndex::Entry::operator==(const std::vector<PropertyValue> &prefix) {
+  return std::equal(prefix.begin(), prefix.end(), values.begin());
+}
+
+void LabelPropertiesIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  for (auto &[label_props, storage] : index_) {
+    if (label_props.first != label) {
+      continue;
+    }
+    auto values = GetIndexedValues(*vertex, label_props.second);
+    if (values) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+    }
+  }
+}
+
+void LabelPropertiesIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                               const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+  for (auto &[label_props, storage] : index_) {
+    if (!utils::Contains(label_props.second, property) || !utils::Contains(vertex->labels, label_props.first)) {
+      continue;
+    }
+    auto values = GetIndexedValues(*vertex, label_props.second);
+    if (values) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+    }
+  }
 }
 
-bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices) {
+bool LabelPropertiesIndex::CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                                       VerticesContainer::Accessor vertices) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, properties), std::forward_as_tuple());
   if (!emplaced) {
     // Index already exists.
     return false;
@@ -283,7 +1142,11 @@ bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor ve
       if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
         continue;
       }
-      acc.insert(Entry{&vertex, 0});
+      auto values = GetIndexedValues(vertex, properties);
+      if (!values) {
+        continue;
+      }
+      acc.insert(Entry{std::move(*values), &vertex, 0});
     }
   } catch (const utils::OutOfMemoryException &) {
     utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
@@ -293,8 +1156,8 @@ bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor ve
   return true;
 }
 
-std::vector<LabelId> LabelIndex::ListIndices() const {
-  std::vector<LabelId> ret;
+std::vector<std::pair<LabelId, std::vector<PropertyId>>> LabelPropertiesIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
     ret.push_back(item.first);
@@ -302,10 +1165,20 @@ std::vector<LabelId> LabelIndex::ListIndices() const {
   return ret;
 }
 
-void LabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
-  for (auto &label_storage : index_) {
-    auto vertices_acc = label_storage.second.access();
-    for (auto it = vertices_acc.begin(); it != vertices_acc.end();) {
+std::vector<std::vector<PropertyId>> LabelPropertiesIndex::ListIndices(LabelId label) const {
+  std::vector<std::vector<PropertyId>> ret;
+  for (const auto &[label_props, _] : index_) {
+    if (label_props.first == label) {
+      ret.push_back(label_props.second);
+    }
+  }
+  return ret;
+}
+
+void LabelPropertiesIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[label_props, index] : index_) {
+    auto index_acc = index.access();
+    for (auto it = index_acc.begin(); it != index_acc.end();) {
       auto next_it = it;
       ++next_it;
 
@@ -314,17 +1187,17 @@ void LabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
         continue;
       }
 
-      if ((next_it != vertices_acc.end() && it->vertex == next_it->vertex) ||
-          !AnyVersionHasLabel(*it->vertex, label_storage.first, oldest_active_start_timestamp)) {
-        vertices_acc.remove(*it);
+      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
+          !AnyVersionHasLabelProperties(*it->vertex, label_props.first, label_props.second, it->values,
+                                        oldest_active_start_timestamp)) {
+        index_acc.remove(*it);
       }
-
       it = next_it;
     }
   }
 }
 
-LabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+LabelPropertiesIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
     : self_(self),
       index_iterator_(index_iterator),
       current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
@@ -332,77 +1205,116 @@ LabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>:
   AdvanceUntilValid();
 }
 
-LabelIndex::Iterable::Iterator &LabelIndex::Iterable::Iterator::operator++() {
+LabelPropertiesIndex::Iterable::Iterator &LabelPropertiesIndex::Iterable::Iterator::operator++() {
   ++index_iterator_;
   AdvanceUntilValid();
   return *this;
 }
 
-void LabelIndex::Iterable::Iterator::AdvanceUntilValid() {
+void LabelPropertiesIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
     if (index_iterator_->vertex == current_vertex_) {
       continue;
     }
-    if (CurrentVersionHasLabel(*index_iterator_->vertex, self_->label_, self_->transaction_, self_->view_)) {
+
+    // The entries with the same prefix are contiguous, so the first entry with
+    // a different prefix ends the iteration.
+    if (!(*index_iterator_ == self_->prefix_)) {
+      index_iterator_ = self_->index_accessor_.end();
+      break;
+    }
+
+    if (CurrentVersionHasLabelProperties(*index_iterator_->vertex, self_->label_, *self_->properties_,
+                                         index_iterator_->values, self_->transaction_, self_->view_)) {
       current_vertex_ = index_iterator_->vertex;
       current_vertex_accessor_ =
-          VertexAccessor{current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_};
+          VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
       break;
     }
   }
 }
 
-LabelIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view,
-                               Transaction *transaction, Indices *indices, Constraints *constraints,
-                               Config::Items config)
+LabelPropertiesIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                         const std::vector<PropertyId> &properties, std::vector<PropertyValue> prefix,
+                                         View view, Transaction *transaction, Indices *indices,
+                                         Constraints *constraints, Config::Items config)
     : index_accessor_(std::move(index_accessor)),
       label_(label),
+      properties_(&properties),
+      prefix_(std::move(prefix)),
       view_(view),
       transaction_(transaction),
       indices_(indices),
       constraints_(constraints),
       config_(config) {}
 
-void LabelIndex::RunGC() {
+LabelPropertiesIndex::Iterable::Iterator LabelPropertiesIndex::Iterable::begin() {
+  if (prefix_.empty()) return Iterator(this, index_accessor_.begin());
+  return Iterator(this, index_accessor_.find_equal_or_greater(prefix_));
+}
+
+int64_t LabelPropertiesIndex::ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                                     const std::vector<PropertyValue> &prefix) const {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Index for label {} and {} properties doesn't exist", label.AsUint(),
+            properties.size());
+  auto acc = it->second.access();
+  if (prefix.empty()) {
+    return acc.size();
+  }
+  return acc.estimate_count(prefix, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void LabelPropertiesIndex::RunGC() {
   for (auto &index_entry : index_) {
     index_entry.second.run_gc();
   }
 }
 
-bool LabelPropertyIndex::Entry::operator<(const Entry &rhs) {
-  if (value < rhs.value) {
-    return true;
-  }
-  if (rhs.value < value) {
-    return false;
-  }
-  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+bool TextIndex::Entry::operator<(const Entry &rhs) {
+  return std::make_tuple(gram, vertex, timestamp) < std::make_tuple(rhs.gram, rhs.vertex, rhs.timestamp);
 }
 
-bool LabelPropertyIndex::Entry::operator==(const Entry &rhs) {
-  return value == rhs.value && vertex == rhs.vertex && timestamp == rhs.timestamp;
+bool TextIndex::Entry::operator==(const Entry &rhs) {
+  return gram == rhs.gram && vertex == rhs.vertex && timestamp == rhs.timestamp;
 }
 
-bool LabelPropertyIndex::Entry::operator<(const PropertyValue &rhs) { return value < rhs; }
+std::vector<uint32_t> TextIndex::Grams(std::string_view text) {
+  std::vector<uint32_t> grams;
+  if (text.size() < 3) return grams;
+  grams.reserve(text.size() - 2);
+  for (size_t i = 0; i + 3 <= text.size(); ++i) {
+    grams.push_back(EncodeGram(text.data() + i));
+  }
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  return grams;
+}
 
-bool LabelPropertyIndex::Entry::operator==(const PropertyValue &rhs) { return value == rhs; }
+void TextIndex::InsertGrams(utils::SkipList<Entry>::Accessor *acc, std::string_view text, Vertex *vertex,
+                            uint64_t timestamp) {
+  acc->insert(Entry{kAllGram, vertex, timestamp});
+  for (const auto gram : Grams(text)) {
+    acc->insert(Entry{gram, vertex, timestamp});
+  }
+}
 
-void LabelPropertyIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+void TextIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
   for (auto &[label_prop, storage] : index_) {
     if (label_prop.first != label) {
       continue;
     }
     auto prop_value = vertex->properties.GetProperty(label_prop.second);
-    if (!prop_value.IsNull()) {
+    if (prop_value.IsString()) {
       auto acc = storage.access();
-      acc.insert(Entry{std::move(prop_value), vertex, tx.start_timestamp});
+      InsertGrams(&acc, prop_value.ValueString(), vertex, tx.start_timestamp);
     }
   }
 }
 
-void LabelPropertyIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
-                                             const Transaction &tx) {
-  if (value.IsNull()) {
+void TextIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                    const Transaction &tx) {
+  if (!value.IsString()) {
     return;
   }
   for (auto &[label_prop, storage] : index_) {
@@ -411,12 +1323,12 @@ void LabelPropertyIndex::UpdateOnSetProperty(PropertyId property, const Property
     }
     if (utils::Contains(vertex->labels, label_prop.first)) {
       auto acc = storage.access();
-      acc.insert(Entry{value, vertex, tx.start_timestamp});
+      InsertGrams(&acc, value.ValueString(), vertex, tx.start_timestamp);
     }
   }
 }
 
-bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+bool TextIndex::CreateIndex(LabelId label, PropertyId property, VerticesContainer::Accessor vertices) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   auto [it, emplaced] =
       index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
@@ -431,10 +1343,10 @@ bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::
         continue;
       }
       auto value = vertex.properties.GetProperty(property);
-      if (value.IsNull()) {
+      if (!value.IsString()) {
         continue;
       }
-      acc.insert(Entry{std::move(value), &vertex, 0});
+      InsertGrams(&acc, value.ValueString(), &vertex, 0);
     }
   } catch (const utils::OutOfMemoryException &) {
     utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
@@ -444,7 +1356,7 @@ bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::
   return true;
 }
 
-std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() const {
+std::vector<std::pair<LabelId, PropertyId>> TextIndex::ListIndices() const {
   std::vector<std::pair<LabelId, PropertyId>> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
@@ -453,7 +1365,7 @@ std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() co
   return ret;
 }
 
-void LabelPropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+void TextIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
   for (auto &[label_property, index] : index_) {
     auto index_acc = index.access();
     for (auto it = index_acc.begin(); it != index_acc.end();) {
@@ -465,8 +1377,8 @@ void LabelPropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_time
         continue;
       }
 
-      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->value == next_it->value) ||
-          !AnyVersionHasLabelProperty(*it->vertex, label_property.first, label_property.second, it->value,
+      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->gram == next_it->gram) ||
+          !AnyVersionHasLabelTextGram(*it->vertex, label_property.first, label_property.second, it->gram,
                                       oldest_active_start_timestamp)) {
         index_acc.remove(*it);
       }
@@ -475,7 +1387,7 @@ void LabelPropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_time
   }
 }
 
-LabelPropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+TextIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
     : self_(self),
       index_iterator_(index_iterator),
       current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
@@ -483,39 +1395,23 @@ LabelPropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList
   AdvanceUntilValid();
 }
 
-LabelPropertyIndex::Iterable::Iterator &LabelPropertyIndex::Iterable::Iterator::operator++() {
+TextIndex::Iterable::Iterator &TextIndex::Iterable::Iterator::operator++() {
   ++index_iterator_;
   AdvanceUntilValid();
   return *this;
 }
 
-void LabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
+void TextIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->gram != self_->gram_) {
+      index_iterator_ = self_->index_accessor_.end();
+      break;
+    }
     if (index_iterator_->vertex == current_vertex_) {
       continue;
     }
-
-    if (self_->lower_bound_) {
-      if (index_iterator_->value < self_->lower_bound_->value()) {
-        continue;
-      }
-      if (!self_->lower_bound_->IsInclusive() && index_iterator_->value == self_->lower_bound_->value()) {
-        continue;
-      }
-    }
-    if (self_->upper_bound_) {
-      if (self_->upper_bound_->value() < index_iterator_->value) {
-        index_iterator_ = self_->index_accessor_.end();
-        break;
-      }
-      if (!self_->upper_bound_->IsInclusive() && index_iterator_->value == self_->upper_bound_->value()) {
-        index_iterator_ = self_->index_accessor_.end();
-        break;
-      }
-    }
-
-    if (CurrentVersionHasLabelProperty(*index_iterator_->vertex, self_->label_, self_->property_,
-                                       index_iterator_->value, self_->transaction_, self_->view_)) {
+    if (CurrentVersionHasLabelTextGram(*index_iterator_->vertex, self_->label_, self_->property_, self_->gram_,
+                                       self_->transaction_, self_->view_)) {
       current_vertex_ = index_iterator_->vertex;
       current_vertex_accessor_ =
           VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
@@ -524,171 +1420,181 @@ void LabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
   }
 }
 
-// These constants represent the smallest possible value of each type that is
-// contained in a `PropertyValue`. Note that numbers (integers and doubles) are
-// treated as the same "type" in `PropertyValue`.
-const PropertyValue kSmallestBool = PropertyValue(false);
-static_assert(-std::numeric_limits<double>::infinity() < std::numeric_limits<int64_t>::min());
-const PropertyValue kSmallestNumber = PropertyValue(-std::numeric_limits<double>::infinity());
-const PropertyValue kSmallestString = PropertyValue("");
-const PropertyValue kSmallestList = PropertyValue(std::vector<PropertyValue>());
-const PropertyValue kSmallestMap = PropertyValue(std::map<std::string, PropertyValue>());
-const PropertyValue kSmallestTemporalData =
-    PropertyValue(TemporalData{static_cast<TemporalType>(0), std::numeric_limits<int64_t>::min()});
-
-LabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
-                                       PropertyId property,
-                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
-                                       Transaction *transaction, Indices *indices, Constraints *constraints,
-                                       Config::Items config)
+TextIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, PropertyId property,
+                              uint32_t gram, View view, Transaction *transaction, Indices *indices,
+                              Constraints *constraints, Config::Items config)
     : index_accessor_(std::move(index_accessor)),
       label_(label),
       property_(property),
-      lower_bound_(lower_bound),
-      upper_bound_(upper_bound),
+      gram_(gram),
       view_(view),
       transaction_(transaction),
       indices_(indices),
       constraints_(constraints),
-      config_(config) {
-  // We have to fix the bounds that the user provided to us. If the user
-  // provided only one bound we should make sure that only values of that type
-  // are returned by the iterator. We ensure this by supplying either an
-  // inclusive lower bound of the same type, or an exclusive upper bound of the
-  // following type. If neither bound is set we yield all items in the index.
-
-  // First we statically verify that our assumptions about the `PropertyValue`
-  // type ordering holds.
-  static_assert(PropertyValue::Type::Bool < PropertyValue::Type::Int);
-  static_assert(PropertyValue::Type::Int < PropertyValue::Type::Double);
-  static_assert(PropertyValue::Type::Double < PropertyValue::Type::String);
-  static_assert(PropertyValue::Type::String < PropertyValue::Type::List);
-  static_assert(PropertyValue::Type::List < PropertyValue::Type::Map);
+      config_(config) {}
 
-  // Remove any bounds that are set to `Null` because that isn't a valid value.
-  if (lower_bound_ && lower_bound_->value().IsNull()) {
-    lower_bound_ = std::nullopt;
-  }
-  if (upper_bound_ && upper_bound_->value().IsNull()) {
-    upper_bound_ = std::nullopt;
+uint32_t TextIndex::RarestGram(const utils::SkipList<Entry> &index, std::string_view text) {
+  // Strings shorter than a trigram can only be looked up among all of the
+  // indexed vertices.
+  uint32_t rarest = kAllGram;
+  uint64_t rarest_count = std::numeric_limits<uint64_t>::max();
+  auto acc = index.access();
+  const auto layer = utils::SkipListLayerForCountEstimation(acc.size());
+  for (const auto gram : Grams(text)) {
+    const auto count = acc.estimate_count(gram, layer);
+    if (count < rarest_count) {
+      rarest = gram;
+      rarest_count = count;
+    }
   }
+  return rarest;
+}
 
-  // Check whether the bounds are of comparable types if both are supplied.
-  if (lower_bound_ && upper_bound_ &&
-      !PropertyValue::AreComparableTypes(lower_bound_->value().type(), upper_bound_->value().type())) {
-    bounds_valid_ = false;
-    return;
+TextIndex::Iterable TextIndex::Vertices(LabelId label, PropertyId property, std::string_view text, View view,
+                                        Transaction *transaction) {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Text index for label {} and property {} doesn't exist", label.AsUint(),
+            property.AsUint());
+  const auto gram = RarestGram(it->second, text);
+  return Iterable(it->second.access(), label, property, gram, view, transaction, indices_, constraints_, config_);
+}
+
+int64_t TextIndex::ApproximateVertexCount(LabelId label, PropertyId property) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Text index for label {} and property {} doesn't exist", label.AsUint(),
+            property.AsUint());
+  auto acc = it->second.access();
+  return acc.estimate_count(kAllGram, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+int64_t TextIndex::ApproximateVertexCount(LabelId label, PropertyId property, std::string_view text) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Text index for label {} and property {} doesn't exist", label.AsUint(),
+            property.AsUint());
+  const auto gram = RarestGram(it->second, text);
+  auto acc = it->second.access();
+  return acc.estimate_count(gram, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void TextIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
   }
+}
 
-  // Set missing bounds.
-  if (lower_bound_ && !upper_bound_) {
-    // Here we need to supply an upper bound. The upper bound is set to an
-    // exclusive lower bound of the following type.
-    switch (lower_bound_->value().type()) {
-      case PropertyValue::Type::Null:
-        // This shouldn't happen because of the nullopt-ing above.
-        LOG_FATAL("Invalid database state!");
-        break;
-      case PropertyValue::Type::Bool:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestNumber);
-        break;
-      case PropertyValue::Type::Int:
-      case PropertyValue::Type::Double:
-        // Both integers and doubles are treated as the same type in
-        // `PropertyValue` and they are interleaved when sorted.
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestString);
-        break;
-      case PropertyValue::Type::String:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestList);
-        break;
-      case PropertyValue::Type::List:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestMap);
-        break;
-      case PropertyValue::Type::Map:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestTemporalData);
-        break;
-      case PropertyValue::Type::TemporalData:
-        // This is the last type in the order so we leave the upper bound empty.
-        break;
-    }
+void EdgeTypeIndex::UpdateOnCreateEdge(EdgeTypeId edge_type, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                                       const Transaction &tx) {
+  auto it = index_.find(edge_type);
+  if (it == index_.end()) return;
+  auto acc = it->second.access();
+  acc.insert(Entry{from_vertex, to_vertex, edge, tx.start_timestamp});
+}
+
+bool EdgeTypeIndex::CreateIndex(EdgeTypeId edge_type, VerticesContainer::Accessor vertices) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(edge_type), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
   }
-  if (upper_bound_ && !lower_bound_) {
-    // Here we need to supply a lower bound. The lower bound is set to an
-    // inclusive lower bound of the current type.
-    switch (upper_bound_->value().type()) {
-      case PropertyValue::Type::Null:
-        // This shouldn't happen because of the nullopt-ing above.
-        LOG_FATAL("Invalid database state!");
-        break;
-      case PropertyValue::Type::Bool:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestBool);
-        break;
-      case PropertyValue::Type::Int:
-      case PropertyValue::Type::Double:
-        // Both integers and doubles are treated as the same type in
-        // `PropertyValue` and they are interleaved when sorted.
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestNumber);
-        break;
-      case PropertyValue::Type::String:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestString);
-        break;
-      case PropertyValue::Type::List:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestList);
-        break;
-      case PropertyValue::Type::Map:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestMap);
-        break;
-      case PropertyValue::Type::TemporalData:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestTemporalData);
-        break;
+  try {
+    auto acc = it->second.access();
+    for (Vertex &from_vertex : vertices) {
+      if (from_vertex.deleted) {
+        continue;
+      }
+      for (const auto &[type, to_vertex, edge] : from_vertex.out_edges) {
+        if (type != edge_type) {
+          continue;
+        }
+        acc.insert(Entry{&from_vertex, to_vertex, edge, 0});
+      }
     }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
   }
+  return true;
 }
 
-LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::begin() {
-  // If the bounds are set and don't have comparable types we don't yield any
-  // items from the index.
-  if (!bounds_valid_) return Iterator(this, index_accessor_.end());
-  auto index_iterator = index_accessor_.begin();
-  if (lower_bound_) {
-    index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
+std::vector<EdgeTypeId> EdgeTypeIndex::ListIndices() const {
+  std::vector<EdgeTypeId> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
   }
-  return Iterator(this, index_iterator);
+  return ret;
 }
 
-LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::end() {
-  return Iterator(this, index_accessor_.end());
-}
+void EdgeTypeIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+  for (auto &[edge_type, edges] : index_) {
+    auto edges_acc = edges.access();
+    for (auto it = edges_acc.begin(); it != edges_acc.end();) {
+      auto next_it = it;
+      ++next_it;
 
-int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
-                                                   const PropertyValue &value) const {
-  auto it = index_.find({label, property});
-  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
-  auto acc = it->second.access();
-  if (!value.IsNull()) {
-    return acc.estimate_count(value, utils::SkipListLayerForCountEstimation(acc.size()));
-  } else {
-    // The value `Null` won't ever appear in the index because it indicates that
-    // the property shouldn't exist. Instead, this value is used as an indicator
-    // to estimate the average number of equal elements in the list (for any
-    // given value).
-    return acc.estimate_average_number_of_equals(
-        [](const auto &first, const auto &second) { return first.value == second.value; },
-        utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
+      if (it->timestamp >= oldest_active_start_timestamp) {
+        it = next_it;
+        continue;
+      }
+
+      if ((next_it != edges_acc.end() && it->from_vertex == next_it->from_vertex && it->edge == next_it->edge) ||
+          !AnyVersionHasOutEdge(*it->from_vertex, edge_type, it->to_vertex, it->edge,
+                                oldest_active_start_timestamp)) {
+        edges_acc.remove(*it);
+      }
+
+      it = next_it;
+    }
   }
 }
 
-int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
-                                                   const std::optional<utils::Bound<PropertyValue>> &lower,
-                                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
-  auto it = index_.find({label, property});
-  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
-  auto acc = it->second.access();
-  return acc.estimate_range_count(lower, upper, utils::SkipListLayerForCountEstimation(acc.size()));
+EdgeTypeIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_edge_accessor_(EdgeRef(nullptr), EdgeTypeId(), nullptr, nullptr, nullptr, nullptr, nullptr,
+                             self_->config_) {
+  AdvanceUntilValid();
 }
 
-void LabelPropertyIndex::RunGC() {
+EdgeTypeIndex::Iterable::Iterator &EdgeTypeIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void EdgeTypeIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    // An edge object can be reused for a new edge after the old one was freed,
+    // so the entries of both are next to each other.
+    if (current_edge_ && index_iterator_->edge == *current_edge_) {
+      continue;
+    }
+    if (CurrentVersionHasOutEdge(*index_iterator_->from_vertex, self_->edge_type_, index_iterator_->to_vertex,
+                                 index_iterator_->edge, self_->transaction_, self_->view_)) {
+      current_edge_ = index_iterator_->edge;
+      current_edge_accessor_ = EdgeAccessor(index_iterator_->edge, self_->edge_type_, index_iterator_->from_vertex,
+                                            index_iterator_->to_vertex, self_->transaction_, self_->indices_,
+                                            self_->constraints_, self_->config_);
+      break;
+    }
+  }
+}
+
+EdgeTypeIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type, View view,
+                                  Transaction *transaction, Indices *indices, Constraints *constraints,
+                                  Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      edge_type_(edge_type),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {}
+
+void EdgeTypeIndex::RunGC() {
   for (auto &index_entry : index_) {
     index_entry.second.run_gc();
   }
@@ -697,16 +1603,28 @@ void LabelPropertyIndex::RunGC() {
 void RemoveObsoleteEntries(Indices *indices, uint64_t oldest_active_start_timestamp) {
   indices->label_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
   indices->label_property_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
+  indices->label_properties_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
+  indices->text_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
+  indices->edge_type_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
 }
 
 void UpdateOnAddLabel(Indices *indices, LabelId label, Vertex *vertex, const Transaction &tx) {
   indices->label_index.UpdateOnAddLabel(label, vertex, tx);
   indices->label_property_index.UpdateOnAddLabel(label, vertex, tx);
+  indices->label_properties_index.UpdateOnAddLabel(label, vertex, tx);
+  indices->text_index.UpdateOnAddLabel(label, vertex, tx);
 }
 
 void UpdateOnSetProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *vertex,
                          const Transaction &tx) {
   indices->label_property_index.UpdateOnSetProperty(property, value, vertex, tx);
+  indices->label_properties_index.UpdateOnSetProperty(property, value, vertex, tx);
+  indices->text_index.UpdateOnSetProperty(property, value, vertex, tx);
+}
+
+void UpdateOnCreateEdge(Indices *indices, EdgeTypeId edge_type, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                        const Transaction &tx) {
+  indices->edge_type_index.UpdateOnCreateEdge(edge_type, from_vertex, to_vertex, edge, tx);
 }
 
 }  // namespace memgraph::storage
@@ -11,11 +11,18 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <optional>
+#include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "storage/v2/config.hpp"
+#include "storage/v2/containers.hpp"
+#include "storage/v2/edge_accessor.hpp"
+#include "storage/v2/edge_ref.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex_accessor.hpp"
@@ -58,7 +65,7 @@ class LabelIndex {
   void UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx);
 
   /// @throw std::bad_alloc
-  bool CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices);
+  bool CreateIndex(LabelId label, VerticesContainer::Accessor vertices);
 
   /// Returns false if there was no index to drop
   bool DropIndex(LabelId label) { return index_.erase(label) > 0; }
@@ -156,7 +163,7 @@ class LabelPropertyIndex {
   void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex, const Transaction &tx);
 
   /// @throw std::bad_alloc
-  bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+  bool CreateIndex(LabelId label, PropertyId property, VerticesContainer::Accessor vertices);
 
   bool DropIndex(LabelId label, PropertyId property) { return index_.erase({label, property}) > 0; }
 
@@ -248,9 +255,360 @@ class LabelPropertyIndex {
   Config::Items config_;
 };
 
+/// Composite index of vertices by a label and an ordered list of properties.
+/// A vertex is indexed only when it has the label and all of the properties
+/// set. The entries are ordered lexicographically by the property values, so
+/// fixing the values of the first few properties selects a contiguous range of
+/// the index.
+class LabelPropertiesIndex {
+ private:
+  struct Entry {
+    std::vector<PropertyValue> values;
+    Vertex *vertex;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs);
+    bool operator==(const Entry &rhs);
+
+    // Compare only the first `prefix.size()` values so that a prefix can be
+    // used as a key.
+    bool operator<(const std::vector<PropertyValue> &prefix);
+    bool operator==(const std::vector<PropertyValue> &prefix);
+  };
+
+ public:
+  LabelPropertiesIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex, const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                   VerticesContainer::Accessor vertices);
+
+  bool DropIndex(LabelId label, const std::vector<PropertyId> &properties) {
+    return index_.erase({label, properties}) > 0;
+  }
+
+  bool IndexExists(LabelId label, const std::vector<PropertyId> &properties) const {
+    return index_.find({label, properties}) != index_.end();
+  }
+
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ListIndices() const;
+
+  /// Returns the property lists of all indices on the given label.
+  std::vector<std::vector<PropertyId>> ListIndices(LabelId label) const;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, const std::vector<PropertyId> &properties,
+             std::vector<PropertyValue> prefix, View view, Transaction *transaction, Indices *indices,
+             Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      VertexAccessor operator*() const { return current_vertex_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      VertexAccessor current_vertex_accessor_;
+      Vertex *current_vertex_;
+    };
+
+    Iterator begin();
+    Iterator end() { return Iterator(this, index_accessor_.end()); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    LabelId label_;
+    const std::vector<PropertyId> *properties_;
+    std::vector<PropertyValue> prefix_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns the vertices whose first `prefix.size()` property values are
+  /// equal to `prefix`. An empty prefix returns all indexed vertices.
+  Iterable Vertices(LabelId label, const std::vector<PropertyId> &properties, std::vector<PropertyValue> prefix,
+                    View view, Transaction *transaction) {
+    auto it = index_.find({label, properties});
+    MG_ASSERT(it != index_.end(), "Index for label {} and {} properties doesn't exist", label.AsUint(),
+              properties.size());
+    MG_ASSERT(prefix.size() <= properties.size(), "The prefix is longer than the index key");
+    return Iterable(it->second.access(), label, it->first.second, std::move(prefix), view, transaction, indices_,
+                    constraints_, config_);
+  }
+
+  int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const {
+    auto it = index_.find({label, properties});
+    MG_ASSERT(it != index_.end(), "Index for label {} and {} properties doesn't exist", label.AsUint(),
+              properties.size());
+    return it->second.size();
+  }
+
+  /// Returns an estimated count of vertices whose leading property values are
+  /// equal to `prefix`.
+  int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                 const std::vector<PropertyValue> &prefix) const;
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  std::map<std::pair<LabelId, std::vector<PropertyId>>, utils::SkipList<Entry>> index_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+/// Text index of vertices by a label and a string property. Each string is
+/// split into its byte trigrams, and the index maps every trigram to the
+/// vertices whose string contains it. A vertex is also indexed under the empty
+/// gram, so all of the indexed vertices can be iterated. A lookup returns the
+/// candidates that contain the rarest trigram of the searched string, so the
+/// caller has to verify the candidates against the actual predicate.
+class TextIndex {
+ private:
+  struct Entry {
+    uint32_t gram;
+    Vertex *vertex;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs);
+    bool operator==(const Entry &rhs);
+
+    bool operator<(uint32_t rhs) const { return gram < rhs; }
+    bool operator==(uint32_t rhs) const { return gram == rhs; }
+  };
+
+ public:
+  /// The gram under which every indexed vertex is stored.
+  static constexpr uint32_t kAllGram = 0;
+
+  /// Returns the sorted and unique grams of the string. The grams of strings
+  /// shorter than three bytes are empty.
+  static std::vector<uint32_t> Grams(std::string_view text);
+
+  TextIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex, const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, PropertyId property, VerticesContainer::Accessor vertices);
+
+  bool DropIndex(LabelId label, PropertyId property) { return index_.erase({label, property}) > 0; }
+
+  bool IndexExists(LabelId label, PropertyId property) const { return index_.find({label, property}) != index_.end(); }
+
+  std::vector<std::pair<LabelId, PropertyId>> ListIndices() const;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, PropertyId property, uint32_t gram,
+             View view, Transaction *transaction, Indices *indices, Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      VertexAccessor operator*() const { return current_vertex_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      VertexAccessor current_vertex_accessor_;
+      Vertex *current_vertex_;
+    };
+
+    Iterator begin() { return Iterator(this, index_accessor_.find_equal_or_greater(gram_)); }
+    Iterator end() { return Iterator(this, index_accessor_.end()); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    LabelId label_;
+    PropertyId property_;
+    uint32_t gram_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns the vertices whose string property may contain `text`. Every
+  /// vertex whose string contains `text` is returned, but so may be other
+  /// vertices.
+  Iterable Vertices(LabelId label, PropertyId property, std::string_view text, View view, Transaction *transaction);
+
+  /// Returns the number of indexed vertices.
+  int64_t ApproximateVertexCount(LabelId label, PropertyId property) const;
+
+  /// Returns an estimated count of the candidates that a lookup of `text`
+  /// would return.
+  int64_t ApproximateVertexCount(LabelId label, PropertyId property, std::string_view text) const;
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  /// Returns the gram of `text` with the fewest entries.
+  static uint32_t RarestGram(const utils::SkipList<Entry> &index, std::string_view text);
+
+  /// @throw std::bad_alloc
+  static void InsertGrams(utils::SkipList<Entry>::Accessor *acc, std::string_view text, Vertex *vertex,
+                          uint64_t timestamp);
+
+  std::map<std::pair<LabelId, PropertyId>, utils::SkipList<Entry>> index_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+/// Index of edges by their type. The edges are kept together with their
+/// endpoints because the edges themselves don't know them, and the entries are
+/// checked against the outgoing edges of the `from` vertex, so the index works
+/// even when properties on edges are disabled.
+class EdgeTypeIndex {
+ private:
+  struct Entry {
+    Vertex *from_vertex;
+    Vertex *to_vertex;
+    EdgeRef edge;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs) {
+      return std::make_tuple(from_vertex, edge.gid, timestamp) <
+             std::make_tuple(rhs.from_vertex, rhs.edge.gid, rhs.timestamp);
+    }
+    bool operator==(const Entry &rhs) {
+      return from_vertex == rhs.from_vertex && edge == rhs.edge && timestamp == rhs.timestamp;
+    }
+  };
+
+ public:
+  EdgeTypeIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnCreateEdge(EdgeTypeId edge_type, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                          const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  bool CreateIndex(EdgeTypeId edge_type, VerticesContainer::Accessor vertices);
+
+  /// Returns false if there was no index to drop
+  bool DropIndex(EdgeTypeId edge_type) { return index_.erase(edge_type) > 0; }
+
+  bool IndexExists(EdgeTypeId edge_type) const { return index_.find(edge_type) != index_.end(); }
+
+  std::vector<EdgeTypeId> ListIndices() const;
+
+  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type, View view,
+             Transaction *transaction, Indices *indices, Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      EdgeAccessor operator*() const { return current_edge_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      EdgeAccessor current_edge_accessor_;
+      std::optional<EdgeRef> current_edge_;
+    };
+
+    Iterator begin() { return Iterator(this, index_accessor_.begin()); }
+    Iterator end() { return Iterator(this, index_accessor_.end()); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    EdgeTypeId edge_type_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns an iterable with edges visible from the given transaction.
+  Iterable Edges(EdgeTypeId edge_type, View view, Transaction *transaction) {
+    auto it = index_.find(edge_type);
+    MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+    return Iterable(it->second.access(), edge_type, view, transaction, indices_, constraints_, config_);
+  }
+
+  int64_t ApproximateEdgeCount(EdgeTypeId edge_type) const {
+    auto it = index_.find(edge_type);
+    MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+    return it->second.size();
+  }
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  std::map<EdgeTypeId, utils::SkipList<Entry>> index_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
 struct Indices {
   Indices(Constraints *constraints, Config::Items config)
-      : label_index(this, constraints, config), label_property_index(this, constraints, config) {}
+      : label_index(this, constraints, config),
+        label_property_index(this, constraints, config),
+        label_properties_index(this, constraints, config),
+        text_index(this, constraints, config),
+        edge_type_index(this, constraints, config) {}
 
   // Disable copy and move because members hold pointer to `this`.
   Indices(const Indices &) = delete;
@@ -261,6 +619,9 @@ struct Indices {
 
   LabelIndex label_index;
   LabelPropertyIndex label_property_index;
+  LabelPropertiesIndex label_properties_index;
+  TextIndex text_index;
+  EdgeTypeIndex edge_type_index;
 };
 
 /// This function should be called from garbage collection to clean-up the
@@ -279,4 +640,9 @@ void UpdateOnAddLabel(Indices *indices, LabelId label, Vertex *vertex, const Tra
 /// @throw std::bad_alloc
 void UpdateOnSetProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *vertex,
                          const Transaction &tx);
+
+/// This function should be called whenever an edge is created.
+/// @throw std::bad_alloc
+void UpdateOnCreateEdge(Indices *indices, EdgeTypeId edge_type, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                        const Transaction &tx);
 }  // namespace memgraph::storage
@@ -11,9 +11,14 @@
 
 #pragma once
 
+#include <mutex>
+
+#include "storage/v2/property_store.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/result.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/view.hpp"
+#include "utils/spin_lock.hpp"
 
 namespace memgraph::storage {
 
@@ -131,4 +136,55 @@ inline void CreateAndLinkDelta(Transaction *transaction, TObj *object, Args &&..
   object->delta = delta;
 }
 
+/// This function compares the property `property` of the object (a vertex or
+/// an edge) with the non-Null value `value` as the object is seen by the
+/// transaction. The stored value is compared inside the property store and the
+/// deltas only replace the result, so the value is never copied out.
+template <typename TObj>
+inline Result<PropertyComparison> ComparePropertyForRead(Transaction *transaction, TObj *object, PropertyId property,
+                                                         const PropertyValue &value, View view, bool for_deleted) {
+  bool exists = true;
+  bool deleted = false;
+  auto comparison = PropertyComparison::ABSENT;
+  Delta *delta = nullptr;
+  {
+    std::lock_guard<utils::SpinLock> guard(object->lock);
+    deleted = object->deleted;
+    comparison = object->properties.CompareProperty(property, value);
+    delta = object->delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&exists, &deleted, &comparison, &value, property](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        if (delta.property.key == property) {
+          if (delta.property.value.IsNull()) {
+            comparison = PropertyComparison::ABSENT;
+          } else {
+            comparison = delta.property.value == value ? PropertyComparison::EQUAL : PropertyComparison::UNEQUAL;
+          }
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        exists = false;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  if (!exists) return Error::NONEXISTENT_OBJECT;
+  if (!for_deleted && deleted) return Error::DELETED_OBJECT;
+  return comparison;
+}
+
 }  // namespace memgraph::storage
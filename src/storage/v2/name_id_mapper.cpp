@@ -0,0 +1,73 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/name_id_mapper.hpp"
+
+namespace memgraph::storage {
+
+std::atomic<uint64_t> NameIdMapper::next_mapper_id_{1};
+thread_local std::array<NameIdMapper::CachedEntry, NameIdMapper::kLocalCacheSize> NameIdMapper::local_cache_{};
+
+NameIdMapper::NameIdMapper() {
+  tables_.push_back(std::make_unique<Table>(kInitialTableCapacity));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+NameIdMapper::~NameIdMapper() {
+  for (auto &segment : segments_) {
+    delete[] segment.load(std::memory_order_relaxed);
+  }
+}
+
+const NameIdMapper::Entry *NameIdMapper::Insert(std::string_view name, size_t hash) {
+  std::lock_guard guard(lock_);
+  // The name might have been inserted by another thread since the lock-free
+  // lookup, so it is looked up again while holding the lock.
+  if (const auto *entry = Find(name, hash)) {
+    return entry;
+  }
+
+  auto *table = table_.load(std::memory_order_relaxed);
+  if (2 * (entries_.size() + 1) > table->slots.size()) {
+    auto new_table = std::make_unique<Table>(2 * table->slots.size());
+    const auto mask = new_table->slots.size() - 1;
+    for (const auto &entry : entries_) {
+      auto i = entry.hash & mask;
+      while (new_table->slots[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & mask;
+      new_table->slots[i].store(&entry, std::memory_order_relaxed);
+    }
+    table = new_table.get();
+    tables_.push_back(std::move(new_table));
+    table_.store(table, std::memory_order_release);
+  }
+
+  const auto id = static_cast<uint64_t>(entries_.size());
+  const auto &entry = entries_.emplace_back(Entry{std::string(name), hash, id});
+
+  // The ID to name mapping is published before the name to ID mapping, so the
+  // name of every ID returned by `NameToId` can be looked up.
+  const auto index = id + kFirstSegmentSize;
+  const auto segment = std::bit_width(index) - 1 - kFirstSegmentBits;
+  auto *entries = segments_[segment].load(std::memory_order_relaxed);
+  if (entries == nullptr) {
+    entries = new std::atomic<const Entry *>[kFirstSegmentSize << segment]();
+    segments_[segment].store(entries, std::memory_order_release);
+  }
+  entries[index - (kFirstSegmentSize << segment)].store(&entry, std::memory_order_release);
+
+  const auto mask = table->slots.size() - 1;
+  auto i = hash & mask;
+  while (table->slots[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & mask;
+  table->slots[i].store(&entry, std::memory_order_release);
+  return &entry;
+}
+
+}  // namespace memgraph::storage
@@ -11,88 +11,128 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "utils/logging.hpp"
-#include "utils/skip_list.hpp"
 
 namespace memgraph::storage {
 
+/// Concurrent mapping between names (of labels, properties and edge types) and
+/// dense IDs. The names are interned in an open-addressing hash table whose
+/// lookups are lock-free, and the ID to name lookups go through an array that
+/// is indexed by the ID. Every thread additionally caches the names it looked
+/// up, so repeated lookups of the same names (e.g. for every imported row or
+/// every procedure call) usually don't touch the shared table at all.
+///
+/// New names are inserted under a lock. That is rare because the number of
+/// distinct names in a database is small. Mappings are never removed.
 class NameIdMapper final {
+ public:
+  NameIdMapper();
+
+  NameIdMapper(const NameIdMapper &) = delete;
+  NameIdMapper &operator=(const NameIdMapper &) = delete;
+  NameIdMapper(NameIdMapper &&) = delete;
+  NameIdMapper &operator=(NameIdMapper &&) = delete;
+
+  ~NameIdMapper();
+
+  /// @throw std::bad_alloc if unable to insert a new mapping
+  uint64_t NameToId(const std::string_view &name) {
+    const auto hash = std::hash<std::string_view>{}(name);
+    auto &cached = local_cache_[hash & (kLocalCacheSize - 1)];
+    if (cached.mapper_id == mapper_id_ && cached.entry->hash == hash && cached.entry->name == name) {
+      return cached.entry->id;
+    }
+    const auto *entry = Find(name, hash);
+    if (entry == nullptr) {
+      entry = Insert(name, hash);
+    }
+    cached = {mapper_id_, entry};
+    return entry->id;
+  }
+
+  // NOTE: The returned reference is valid for the whole lifetime of the
+  // mapper because mappings are never removed. If you change this class to
+  // remove unused names, be sure to change the signature of this function.
+  const std::string &IdToName(uint64_t id) const {
+    const auto index = id + kFirstSegmentSize;
+    const auto segment = std::bit_width(index) - 1 - kFirstSegmentBits;
+    const auto *entries = segments_[segment].load(std::memory_order_acquire);
+    MG_ASSERT(entries != nullptr, "Trying to get a name for an invalid ID!");
+    const auto *entry = entries[index - (kFirstSegmentSize << segment)].load(std::memory_order_acquire);
+    MG_ASSERT(entry != nullptr, "Trying to get a name for an invalid ID!");
+    return entry->name;
+  }
+
  private:
-  struct MapNameToId {
+  struct Entry {
     std::string name;
+    size_t hash;
     uint64_t id;
+  };
 
-    bool operator<(const MapNameToId &other) { return name < other.name; }
-    bool operator==(const MapNameToId &other) { return name == other.name; }
+  struct Table {
+    explicit Table(size_t capacity) : slots(capacity) {}
 
-    bool operator<(const std::string_view &other) { return name < other; }
-    bool operator==(const std::string_view &other) { return name == other; }
+    std::vector<std::atomic<const Entry *>> slots;
   };
 
-  struct MapIdToName {
-    uint64_t id;
-    std::string name;
+  struct CachedEntry {
+    uint64_t mapper_id{0};
+    const Entry *entry{nullptr};
+  };
 
-    bool operator<(const MapIdToName &other) { return id < other.id; }
-    bool operator==(const MapIdToName &other) { return id == other.id; }
+  // The table is grown when it becomes half full, so the probe sequences stay
+  // short and there is always an empty slot that terminates them.
+  static constexpr size_t kInitialTableCapacity = 64;
 
-    bool operator<(uint64_t other) { return id < other; }
-    bool operator==(uint64_t other) { return id == other; }
-  };
+  // The ID to name array is split into segments that double in size, so it can
+  // grow without moving the entries that concurrent readers might access.
+  static constexpr uint64_t kFirstSegmentBits = 8;
+  static constexpr uint64_t kFirstSegmentSize = uint64_t{1} << kFirstSegmentBits;
+  static constexpr size_t kNumSegments = 64 - kFirstSegmentBits;
 
- public:
-  /// @throw std::bad_alloc if unable to insert a new mapping
-  uint64_t NameToId(const std::string_view &name) {
-    auto name_to_id_acc = name_to_id_.access();
-    auto found = name_to_id_acc.find(name);
-    uint64_t id;
-    if (found == name_to_id_acc.end()) {
-      uint64_t new_id = counter_.fetch_add(1, std::memory_order_acq_rel);
-      // Try to insert the mapping with the `new_id`, but use the id that is in
-      // the object itself. The object that cointains the mapping is designed to
-      // be a map, so that if the inserted name already exists `insert` will
-      // return an iterator to the existing item. This prevents assignment of
-      // two IDs to the same name when the mapping is being inserted
-      // concurrently from two threads. One ID is wasted in that case, though.
-      id = name_to_id_acc.insert({std::string(name), new_id}).first->id;
-    } else {
-      id = found->id;
-    }
-    auto id_to_name_acc = id_to_name_.access();
-    // We have to try to insert the ID to name mapping even if we are not the
-    // one who assigned the ID because we have to make sure that after this
-    // method returns that both mappings exist.
-    if (id_to_name_acc.find(id) == id_to_name_acc.end()) {
-      // We first try to find the `id` in the map to avoid making an unnecessary
-      // temporary memory allocation when the object already exists.
-      id_to_name_acc.insert({id, std::string(name)});
+  static constexpr size_t kLocalCacheSize = 64;
+
+  const Entry *Find(std::string_view name, size_t hash) const {
+    const auto &slots = table_.load(std::memory_order_acquire)->slots;
+    const auto mask = slots.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+      const auto *entry = slots[i].load(std::memory_order_acquire);
+      if (entry == nullptr) return nullptr;
+      if (entry->hash == hash && entry->name == name) return entry;
     }
-    return id;
   }
 
-  // NOTE: Currently this function returns a `const std::string &` instead of a
-  // `std::string` to avoid making unnecessary copies of the string.
-  // Usually, this wouldn't be correct because the accessor to the
-  // `utils::SkipList` is destroyed in this function and that removes the
-  // guarantee that the reference to the value contained in the list will be
-  // valid.
-  // Currently, we never delete anything from the `utils::SkipList` so the
-  // references will always be valid. If you change this class to remove unused
-  // names, be sure to change the signature of this function.
-  const std::string &IdToName(uint64_t id) const {
-    auto id_to_name_acc = id_to_name_.access();
-    auto result = id_to_name_acc.find(id);
-    MG_ASSERT(result != id_to_name_acc.end(), "Trying to get a name for an invalid ID!");
-    return result->name;
-  }
+  const Entry *Insert(std::string_view name, size_t hash);
 
- private:
-  std::atomic<uint64_t> counter_{0};
-  utils::SkipList<MapNameToId> name_to_id_;
-  utils::SkipList<MapIdToName> id_to_name_;
+  // Cached entries are tagged with the ID of the mapper so that entries of a
+  // destroyed mapper are never used.
+  static std::atomic<uint64_t> next_mapper_id_;
+  static thread_local std::array<CachedEntry, kLocalCacheSize> local_cache_;
+  const uint64_t mapper_id_{next_mapper_id_.fetch_add(1, std::memory_order_relaxed)};
+
+  std::atomic<Table *> table_;
+  std::array<std::atomic<std::atomic<const Entry *> *>, kNumSegments> segments_{};
+
+  // Everything below is protected by the lock.
+  std::mutex lock_;
+  // Entries are never moved once inserted, so lock-free readers can keep
+  // pointers to them.
+  std::deque<Entry> entries_;
+  // Tables that were replaced by bigger ones are kept alive until the mapper
+  // is destroyed because concurrent readers might still be using them.
+  std::vector<std::unique_ptr<Table>> tables_;
 };
 }  // namespace memgraph::storage
@@ -1001,6 +1001,25 @@ bool PropertyStore::IsPropertyEqual(PropertyId property, const PropertyValue &va
   return prop_reader.GetPosition() == info.property_size;
 }
 
+PropertyComparison PropertyStore::CompareProperty(PropertyId property, const PropertyValue &value) const {
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  Reader reader(data, size);
+  auto info = FindSpecificPropertyAndBufferInfo(&reader, property);
+  if (info.property_size == 0) return PropertyComparison::ABSENT;
+  Reader prop_reader(data + info.property_begin, info.property_size);
+  if (!CompareExpectedProperty(&prop_reader, property, value) || prop_reader.GetPosition() != info.property_size) {
+    return PropertyComparison::UNEQUAL;
+  }
+  return PropertyComparison::EQUAL;
+}
+
 std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
   uint64_t size;
   const uint8_t *data;
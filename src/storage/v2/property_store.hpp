@@ -18,6 +18,10 @@
 
 namespace memgraph::storage {
 
+/// Result of comparing a stored property with a value. A property that isn't
+/// stored is `ABSENT` regardless of the value it's compared with.
+enum class PropertyComparison : uint8_t { EQUAL, UNEQUAL, ABSENT };
+
 class PropertyStore {
   static_assert(std::endian::native == std::endian::little,
                 "PropertyStore supports only architectures using little-endian.");
@@ -48,6 +52,12 @@ class PropertyStore {
   /// O(n).
   bool IsPropertyEqual(PropertyId property, const PropertyValue &value) const;
 
+  /// Compares the property `property` with the non-Null value `value` and
+  /// tells whether the property is missing in the same pass. This function
+  /// doesn't perform any memory allocations. The time complexity of this
+  /// function is O(n).
+  PropertyComparison CompareProperty(PropertyId property, const PropertyValue &value) const;
+
   /// Returns all properties currently stored in the store. The time complexity
   /// of this function is O(n).
   /// @throw std::bad_alloc
@@ -0,0 +1,74 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "storage/v2/read_only_transactions.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace memgraph::storage {
+
+namespace {
+uint64_t FirstSlotForThisThread() {
+  // Threads start searching at different slots so they don't all contend on
+  // the first few ones.
+  thread_local const uint64_t first_slot =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) % ReadOnlyTransactions::kNumSlots;
+  return first_slot;
+}
+}  // namespace
+
+std::optional<ReadOnlyTransactions::Registration> ReadOnlyTransactions::Register(
+    const std::atomic<uint64_t> &last_commit_timestamp) {
+  const auto first_slot = FirstSlotForThisThread();
+  for (uint64_t i = 0; i < kNumSlots; ++i) {
+    const auto slot = (first_slot + i) % kNumSlots;
+    auto &timestamp = slots_[slot].timestamp;
+    auto expected = kFree;
+    if (timestamp.load(std::memory_order_relaxed) != kFree ||
+        !timestamp.compare_exchange_strong(expected, kPending, std::memory_order_seq_cst)) {
+      continue;
+    }
+    // The slot is marked as pending before the last commit timestamp is read.
+    // A garbage collector that didn't see the pending slot has computed its
+    // oldest active timestamp before we read the last commit timestamp, so it
+    // can't free anything our snapshot needs. A garbage collector that saw it
+    // waits until the timestamp is published.
+    const auto last_commit = last_commit_timestamp.load(std::memory_order_seq_cst);
+    timestamp.store(last_commit, std::memory_order_seq_cst);
+    return Registration{slot, last_commit + 1};
+  }
+  return std::nullopt;
+}
+
+void ReadOnlyTransactions::Unregister(const uint64_t slot) {
+  slots_[slot].timestamp.store(kFree, std::memory_order_release);
+}
+
+uint64_t ReadOnlyTransactions::OldestActive(uint64_t oldest_active) const {
+  for (const auto &slot : slots_) {
+    auto timestamp = slot.timestamp.load(std::memory_order_seq_cst);
+    while (timestamp == kPending) {
+      std::this_thread::yield();
+      timestamp = slot.timestamp.load(std::memory_order_seq_cst);
+    }
+    // The published value is the last commit timestamp the transaction has
+    // seen, which is lower than its start timestamp. This keeps the undo
+    // buffers that were unlinked while the transaction was running, since they
+    // are marked with a timestamp that is at least its start timestamp.
+    oldest_active = std::min(oldest_active, timestamp);
+  }
+  return oldest_active;
+}
+
+}  // namespace memgraph::storage
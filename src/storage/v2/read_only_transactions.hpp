@@ -0,0 +1,78 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+/// @file read_only_transactions.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace memgraph::storage {
+
+/// This class keeps track of the active read-only transactions.
+///
+/// A read-only transaction doesn't take a timestamp from the transaction
+/// engine. Instead, its snapshot contains everything that was committed up to
+/// the last commit timestamp, so it can be started without taking the engine
+/// lock and finished without touching the commit log. The garbage collector
+/// still has to know about such transactions so it doesn't free deltas they
+/// may need. Each read-only transaction therefore occupies a slot in which it
+/// publishes the last commit timestamp it has seen, and \ref OldestActive
+/// combines those with the oldest active regular transaction.
+///
+/// This class is thread-safe and lock-free.
+class ReadOnlyTransactions final {
+ public:
+  static constexpr uint64_t kNumSlots = 128;
+
+  ReadOnlyTransactions() = default;
+
+  ReadOnlyTransactions(const ReadOnlyTransactions &) = delete;
+  ReadOnlyTransactions &operator=(const ReadOnlyTransactions &) = delete;
+  ReadOnlyTransactions(ReadOnlyTransactions &&) = delete;
+  ReadOnlyTransactions &operator=(ReadOnlyTransactions &&) = delete;
+
+  ~ReadOnlyTransactions() = default;
+
+  struct Registration {
+    uint64_t slot;
+    uint64_t start_timestamp;
+  };
+
+  /// Registers a new read-only transaction that sees everything committed up
+  /// to the current value of `last_commit_timestamp`. Returns std::nullopt if
+  /// all slots are taken, in which case a regular transaction should be used.
+  std::optional<Registration> Register(const std::atomic<uint64_t> &last_commit_timestamp);
+
+  /// Marks the read-only transaction in the given slot as finished.
+  void Unregister(uint64_t slot);
+
+  /// Returns the lower of `oldest_active` and the timestamps published by the
+  /// active read-only transactions. The `oldest_active` value must be
+  /// retrieved from the commit log before calling this function.
+  uint64_t OldestActive(uint64_t oldest_active) const;
+
+ private:
+  static constexpr uint64_t kFree = std::numeric_limits<uint64_t>::max();
+  static constexpr uint64_t kPending = kFree - 1;
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> timestamp{kFree};
+  };
+
+  std::array<Slot, kNumSlots> slots_;
+};
+
+}  // namespace memgraph::storage
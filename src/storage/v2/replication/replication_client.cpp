@@ -126,11 +126,13 @@ void Storage::ReplicationClient::InitializeClient() {
   if (current_commit_timestamp == storage_->last_commit_timestamp_.load()) {
     spdlog::debug("Replica '{}' up to date", name_);
     std::unique_lock client_guard{client_lock_};
+    recover_after_pipeline_ = false;
     replica_state_.store(replication::ReplicaState::READY);
   } else {
     spdlog::debug("Replica '{}' is behind", name_);
     {
       std::unique_lock client_guard{client_lock_};
+      recover_after_pipeline_ = false;
       replica_state_.store(replication::ReplicaState::RECOVERY);
     }
     thread_pool_.AddTask([=, this] { this->RecoverReplica(current_commit_timestamp); });
@@ -181,6 +183,12 @@ void Storage::ReplicationClient::StartTransactionReplication(const uint64_t curr
       spdlog::debug("Replica {} is behind MAIN instance", name_);
       return;
     case replication::ReplicaState::REPLICATING:
+      if (mode_ == replication::ReplicationMode::ASYNC && pipelined_transactions_ > 0) {
+        // The replica only has to acknowledge the earlier transactions, so
+        // this one is sent right after them.
+        StartPipelinedTransaction(current_wal_seq_num);
+        return;
+      }
       spdlog::debug("Replica {} missed a transaction", name_);
       // We missed a transaction because we're still replicating
       // the previous transaction so we need to go to RECOVERY
@@ -195,6 +203,10 @@ void Storage::ReplicationClient::StartTransactionReplication(const uint64_t curr
       HandleRpcFailure();
       return;
     case replication::ReplicaState::READY:
+      if (mode_ == replication::ReplicationMode::ASYNC) {
+        StartPipelinedTransaction(current_wal_seq_num);
+        return;
+      }
       MG_ASSERT(!replica_stream_);
       try {
         replica_stream_.emplace(ReplicaStream{this, storage_->last_commit_timestamp_.load(), current_wal_seq_num});
@@ -207,7 +219,47 @@ void Storage::ReplicationClient::StartTransactionReplication(const uint64_t curr
   }
 }
 
+void Storage::ReplicationClient::StartPipelinedTransaction(const uint64_t current_wal_seq_num) {
+  MG_ASSERT(!pipelined_stream_);
+  try {
+    auto stream = rpc_client_->TryStream<replication::AppendDeltasRpc>(storage_->last_commit_timestamp_.load(),
+                                                                       current_wal_seq_num);
+    if (!stream) {
+      // Waiting for the acknowledgements would stall the commit, so the
+      // transaction is skipped and the replica catches up in the recovery.
+      spdlog::debug("Replica {} missed a transaction because too many transactions are in flight", name_);
+      replica_state_.store(replication::ReplicaState::RECOVERY);
+      if (pipelined_transactions_ > 0) {
+        recover_after_pipeline_ = true;
+      } else {
+        // The requests in flight aren't transactions, so the heartbeat
+        // determines where the recovery starts.
+        thread_pool_.AddTask([this] { this->TryInitializeClientSync(); });
+      }
+      return;
+    }
+    pipelined_stream_.emplace(ReplicaStream{this, std::move(*stream)});
+    ++pipelined_transactions_;
+    replica_state_.store(replication::ReplicaState::REPLICATING);
+  } catch (const rpc::RpcFailedException &) {
+    replica_state_.store(replication::ReplicaState::INVALID);
+    HandleRpcFailure();
+  }
+}
+
 void Storage::ReplicationClient::IfStreamingTransaction(const std::function<void(ReplicaStream &handler)> &callback) {
+  // A pipelined transaction is always streamed to the end, even if an earlier
+  // one failed in the meantime, because a partially written request breaks
+  // the connection.
+  if (pipelined_stream_) {
+    try {
+      callback(*pipelined_stream_);
+    } catch (const rpc::RpcFailedException &) {
+      AbortPipelinedTransaction();
+    }
+    return;
+  }
+
   // We can only check the state because it guarantees to be only
   // valid during a single transaction replication (if the assumption
   // that this and other transaction replication functions can only be
@@ -228,6 +280,11 @@ void Storage::ReplicationClient::IfStreamingTransaction(const std::function<void
 }
 
 void Storage::ReplicationClient::FinalizeTransactionReplication() {
+  if (pipelined_stream_) {
+    PipelineTransactionReplication();
+    return;
+  }
+
   // We can only check the state because it guarantees to be only
   // valid during a single transaction replication (if the assumption
   // that this and other transaction replication functions can only be
@@ -236,9 +293,7 @@ void Storage::ReplicationClient::FinalizeTransactionReplication() {
     return;
   }
 
-  if (mode_ == replication::ReplicationMode::ASYNC) {
-    thread_pool_.AddTask([this] { this->FinalizeTransactionReplicationInternal(); });
-  } else if (timeout_) {
+  if (timeout_) {
     MG_ASSERT(mode_ == replication::ReplicationMode::SYNC, "Only SYNC replica can have a timeout.");
     MG_ASSERT(timeout_dispatcher_, "Timeout thread is missing");
     timeout_dispatcher_->WaitForTaskToFinish();
@@ -300,6 +355,73 @@ void Storage::ReplicationClient::FinalizeTransactionReplicationInternal() {
   }
 }
 
+void Storage::ReplicationClient::PipelineTransactionReplication() {
+  try {
+    pipelined_stream_->Send();
+  } catch (const rpc::RpcFailedException &) {
+    AbortPipelinedTransaction();
+    return;
+  }
+  // The thread pool task has to be copyable.
+  auto stream = std::make_shared<ReplicaStream>(std::move(*pipelined_stream_));
+  pipelined_stream_.reset();
+  thread_pool_.AddTask([this, stream] { this->AwaitPipelinedTransaction(stream.get()); });
+}
+
+void Storage::ReplicationClient::AbortPipelinedTransaction() {
+  pipelined_stream_.reset();
+  {
+    std::unique_lock client_guard(client_lock_);
+    --pipelined_transactions_;
+    if (replica_state_ == replication::ReplicaState::INVALID) return;
+    recover_after_pipeline_ = false;
+    replica_state_.store(replication::ReplicaState::INVALID);
+  }
+  HandleRpcFailure();
+}
+
+void Storage::ReplicationClient::AwaitPipelinedTransaction(ReplicaStream *stream) {
+  std::optional<replication::AppendDeltasRes> response;
+  try {
+    response.emplace(stream->Finalize());
+  } catch (const rpc::RpcFailedException &) {
+  }
+
+  std::unique_lock client_guard(client_lock_);
+  --pipelined_transactions_;
+  if (!response) {
+    // The transactions that are still in flight fail on the broken connection
+    // as well, the replica is invalidated only once. A recovery that was
+    // started by someone else fails on its own.
+    if (replica_state_ == replication::ReplicaState::INVALID ||
+        (replica_state_ == replication::ReplicaState::RECOVERY && !recover_after_pipeline_)) {
+      return;
+    }
+    recover_after_pipeline_ = false;
+    replica_state_.store(replication::ReplicaState::INVALID);
+    client_guard.unlock();
+    HandleRpcFailure();
+    return;
+  }
+
+  if (!response->success && replica_state_ == replication::ReplicaState::REPLICATING) {
+    // The transactions that are still in flight were sent after this one, so
+    // the replica rejects them as well.
+    replica_state_.store(replication::ReplicaState::RECOVERY);
+    recover_after_pipeline_ = true;
+  }
+  if (pipelined_transactions_ > 0) return;
+
+  // The replica acknowledged all transactions, so it's in sync unless one of
+  // them was rejected or skipped.
+  if (replica_state_ == replication::ReplicaState::REPLICATING) {
+    replica_state_.store(replication::ReplicaState::READY);
+  } else if (recover_after_pipeline_) {
+    recover_after_pipeline_ = false;
+    thread_pool_.AddTask([this, commit = response->current_commit_timestamp] { this->RecoverReplica(commit); });
+  }
+}
+
 void Storage::ReplicationClient::RecoverReplica(uint64_t replica_commit) {
   while (true) {
     auto file_locker = storage_->file_retainer_.AddLocker();
@@ -416,7 +538,11 @@ std::vector<Storage::ReplicationClient::RecoveryStep> Storage::ReplicationClient
   std::optional<durability::SnapshotDurabilityInfo> latest_snapshot;
   if (!snapshot_files.empty()) {
     std::sort(snapshot_files.begin(), snapshot_files.end());
-    latest_snapshot.emplace(std::move(snapshot_files.back()));
+    // Differential snapshots can't be recovered on their own, so the replica
+    // receives the latest full snapshot.
+    auto full_snapshot = std::find_if(snapshot_files.rbegin(), snapshot_files.rend(),
+                                      [](const auto &snapshot) { return !snapshot.base_start_timestamp; });
+    if (full_snapshot != snapshot_files.rend()) latest_snapshot.emplace(std::move(*full_snapshot));
   }
 
   std::vector<RecoveryStep> recovery_steps;
@@ -571,6 +697,13 @@ Storage::ReplicationClient::ReplicaStream::ReplicaStream(ReplicationClient *self
   encoder.WriteString(self_->storage_->epoch_id_);
 }
 
+Storage::ReplicationClient::ReplicaStream::ReplicaStream(ReplicationClient *self,
+                                                         rpc::Client::StreamHandler<replication::AppendDeltasRpc> stream)
+    : self_(self), stream_(std::move(stream)) {
+  replication::Encoder encoder{stream_.GetBuilder()};
+  encoder.WriteString(self_->storage_->epoch_id_);
+}
+
 void Storage::ReplicationClient::ReplicaStream::AppendDelta(const Delta &delta, const Vertex &vertex,
                                                             uint64_t final_commit_timestamp) {
   replication::Encoder encoder(stream_.GetBuilder());
@@ -596,6 +729,22 @@ void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::Stor
   EncodeOperation(&encoder, &self_->storage_->name_id_mapper_, operation, label, properties, timestamp);
 }
 
+void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation,
+                                                                EdgeTypeId edge_type, uint64_t timestamp) {
+  replication::Encoder encoder(stream_.GetBuilder());
+  EncodeOperation(&encoder, &self_->storage_->name_id_mapper_, operation, edge_type, timestamp);
+}
+
+void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation,
+                                                                LabelId label,
+                                                                const std::vector<PropertyId> &properties,
+                                                                uint64_t timestamp) {
+  replication::Encoder encoder(stream_.GetBuilder());
+  EncodeOperation(&encoder, &self_->storage_->name_id_mapper_, operation, label, properties, timestamp);
+}
+
+void Storage::ReplicationClient::ReplicaStream::Send() { stream_.Send(); }
+
 replication::AppendDeltasRes Storage::ReplicationClient::ReplicaStream::Finalize() { return stream_.AwaitResponse(); }
 
 ////// CurrentWalHandler //////
@@ -47,6 +47,7 @@ class Storage::ReplicationClient {
    private:
     friend class ReplicationClient;
     explicit ReplicaStream(ReplicationClient *self, uint64_t previous_commit_timestamp, uint64_t current_seq_num);
+    ReplicaStream(ReplicationClient *self, rpc::Client::StreamHandler<replication::AppendDeltasRpc> stream);
 
    public:
     /// @throw rpc::RpcFailedException
@@ -62,7 +63,18 @@ class Storage::ReplicationClient {
     void AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
                          const std::set<PropertyId> &properties, uint64_t timestamp);
 
+    /// @throw rpc::RpcFailedException
+    void AppendOperation(durability::StorageGlobalOperation operation, EdgeTypeId edge_type, uint64_t timestamp);
+
+    /// @throw rpc::RpcFailedException
+    void AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
+                         const std::vector<PropertyId> &properties, uint64_t timestamp);
+
    private:
+    /// Sends the rest of the request without waiting for the response.
+    /// @throw rpc::RpcFailedException
+    void Send();
+
     /// @throw rpc::RpcFailedException
     replication::AppendDeltasRes Finalize();
 
@@ -127,6 +139,24 @@ class Storage::ReplicationClient {
  private:
   void FinalizeTransactionReplicationInternal();
 
+  // Starts streaming a transaction to an ASYNC replica. It never waits for
+  // the acknowledgements of the earlier transactions: if too many of them are
+  // in flight, the transaction is skipped and the replica goes to RECOVERY.
+  // Must be called while holding `client_lock_`.
+  void StartPipelinedTransaction(uint64_t current_wal_seq_num);
+
+  // Sends the transaction that is being streamed to an ASYNC replica and
+  // awaits its acknowledgement in the background, so the next transaction can
+  // be replicated while the acknowledgement is in flight.
+  void PipelineTransactionReplication();
+
+  // Drops the pipelined transaction whose request couldn't be written.
+  void AbortPipelinedTransaction();
+
+  // The replica is READY again only once all pipelined transactions are
+  // acknowledged.
+  void AwaitPipelinedTransaction(ReplicaStream *stream);
+
   void RecoverReplica(uint64_t replica_commit);
 
   uint64_t ReplicateCurrentWal();
@@ -154,6 +184,8 @@ class Storage::ReplicationClient {
   std::optional<rpc::Client> rpc_client_;
 
   std::optional<ReplicaStream> replica_stream_;
+  // Transaction that the committing thread streams to an ASYNC replica.
+  std::optional<ReplicaStream> pipelined_stream_;
   replication::ReplicationMode mode_{replication::ReplicationMode::SYNC};
 
   // Dispatcher class for timeout tasks
@@ -181,6 +213,13 @@ class Storage::ReplicationClient {
   std::optional<TimeoutDispatcher> timeout_dispatcher_;
 
   utils::SpinLock client_lock_;
+  // Number of transactions sent to an ASYNC replica that weren't acknowledged
+  // yet. Protected by `client_lock_`.
+  uint64_t pipelined_transactions_{0};
+  // Set if the replica went to RECOVERY while transactions were in flight.
+  // The recovery is started once all of them are acknowledged. Protected by
+  // `client_lock_`.
+  bool recover_after_pipeline_{false};
   // This thread pool is used for background tasks so we don't
   // block the main storage thread
   // We use only 1 thread for 2 reasons:
@@ -194,6 +233,8 @@ class Storage::ReplicationClient {
   //    and be sure of the execution order.
   //    Not having mulitple possible threads in the same client allows us
   //    to ignore concurrency problems inside the client.
+  // Transactions replicated to ASYNC replicas are sent by the committing
+  // thread, only their acknowledgements are awaited here, in the commit order.
   utils::ThreadPool thread_pool_{1};
   std::atomic<replication::ReplicaState> replica_state_{replication::ReplicaState::INVALID};
 
@@ -113,8 +113,7 @@ void Storage::ReplicationServer::AppendDeltasHandler(slk::Reader *req_reader, sl
 
   if (storage_->wal_file_) {
     if (req.seq_num > storage_->wal_file_->SequenceNumber() || *maybe_epoch_id != storage_->epoch_id_) {
-      storage_->wal_file_->FinalizeWal();
-      storage_->wal_file_.reset();
+      storage_->CloseWalFile();
       storage_->wal_seq_num_ = req.seq_num;
     } else {
       MG_ASSERT(storage_->wal_file_->SequenceNumber() == req.seq_num, "Invalid sequence number of current wal file");
@@ -158,6 +157,7 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
 
   std::unique_lock<utils::RWLock> storage_guard(storage_->main_lock_);
   // Clear the database
+  storage_->vertex_directory_.Clear();
   storage_->vertices_.clear();
   storage_->edges_.clear();
 
@@ -169,8 +169,10 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
     spdlog::debug("Loading snapshot");
     auto recovered_snapshot = durability::LoadSnapshot(*maybe_snapshot_path, &storage_->vertices_, &storage_->edges_,
                                                        &storage_->epoch_history_, &storage_->name_id_mapper_,
-                                                       &storage_->edge_count_, storage_->config_.items);
+                                                       &storage_->edge_count_, storage_->config_.items,
+                                                       storage_->config_.durability.recovery_thread_count);
     spdlog::debug("Snapshot loaded successfully");
+    storage_->vertex_directory_.Rebuild(&storage_->vertices_);
     // If this step is present it should always be the first step of
     // the recovery so we use the UUID we read from snasphost
     storage_->uuid_ = std::move(recovered_snapshot.snapshot_info.uuid);
@@ -178,7 +180,7 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
     const auto &recovery_info = recovered_snapshot.recovery_info;
     storage_->vertex_id_ = recovery_info.next_vertex_id;
     storage_->edge_id_ = recovery_info.next_edge_id;
-    storage_->timestamp_ = std::max(storage_->timestamp_, recovery_info.next_timestamp);
+    storage_->timestamp_oracle_.AdvanceTo(recovery_info.next_timestamp);
 
     durability::RecoverIndicesAndConstraints(recovered_snapshot.indices_constraints, &storage_->indices_,
                                              &storage_->constraints_, &storage_->vertices_);
@@ -192,9 +194,9 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
 
   // Delete other durability files
   auto snapshot_files = durability::GetSnapshotFiles(storage_->snapshot_directory_, storage_->uuid_);
-  for (const auto &[path, uuid, _] : snapshot_files) {
-    if (path != *maybe_snapshot_path) {
-      storage_->file_retainer_.DeleteFile(path);
+  for (const auto &snapshot_file : snapshot_files) {
+    if (snapshot_file.path != *maybe_snapshot_path) {
+      storage_->file_retainer_.DeleteFile(snapshot_file.path);
     }
   }
 
@@ -260,19 +262,14 @@ void Storage::ReplicationServer::LoadWal(replication::Decoder *decoder) {
 
     if (storage_->wal_file_) {
       if (storage_->wal_file_->SequenceNumber() != wal_info.seq_num) {
-        storage_->wal_file_->FinalizeWal();
+        storage_->CloseWalFile();
         storage_->wal_seq_num_ = wal_info.seq_num;
-        storage_->wal_file_.reset();
       }
     } else {
       storage_->wal_seq_num_ = wal_info.seq_num;
     }
 
-    durability::Decoder wal;
-    const auto version = wal.Initialize(*maybe_wal_path, durability::kWalMagic);
-    if (!version) throw durability::RecoveryFailure("Couldn't read WAL magic and/or version!");
-    if (!durability::IsVersionSupported(*version)) throw durability::RecoveryFailure("Invalid WAL version!");
-    wal.SetPosition(wal_info.offset_deltas);
+    durability::WalDeltaDecoder wal(*maybe_wal_path, wal_info);
 
     for (size_t i = 0; i < wal_info.num_deltas;) {
       i += ReadAndApplyDelta(&wal);
@@ -315,7 +312,7 @@ uint64_t Storage::ReplicationServer::ReadAndApplyDelta(durability::BaseDecoder *
 
     transaction_complete = durability::IsWalDeltaDataTypeTransactionEnd(delta.type);
 
-    if (timestamp < storage_->timestamp_) {
+    if (timestamp < storage_->timestamp_oracle_.Current()) {
       continue;
     }
 
@@ -324,7 +321,9 @@ uint64_t Storage::ReplicationServer::ReadAndApplyDelta(durability::BaseDecoder *
       case durability::WalDeltaData::Type::VERTEX_CREATE: {
         spdlog::trace("       Create vertex {}", delta.vertex_create_delete.gid.AsUint());
         auto transaction = get_transaction(timestamp);
-        transaction->CreateVertex(delta.vertex_create_delete.gid);
+        if (transaction->CreateVertex(delta.vertex_create_delete.gid).HasError()) {
+          throw utils::BasicException("Invalid transaction!");
+        }
         break;
       }
       case durability::WalDeltaData::Type::VERTEX_DELETE: {
@@ -494,6 +493,20 @@ uint64_t Storage::ReplicationServer::ReadAndApplyDelta(durability::BaseDecoder *
           throw utils::BasicException("Invalid transaction!");
         break;
       }
+      case durability::WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE: {
+        spdlog::trace("       Create edge type index on :{}", delta.operation_edge_type.edge_type);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (!storage_->CreateIndex(storage_->NameToEdgeType(delta.operation_edge_type.edge_type), timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+        spdlog::trace("       Drop edge type index on :{}", delta.operation_edge_type.edge_type);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (!storage_->DropIndex(storage_->NameToEdgeType(delta.operation_edge_type.edge_type), timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
       case durability::WalDeltaData::Type::LABEL_PROPERTY_INDEX_CREATE: {
         spdlog::trace("       Create label+property index on :{} ({})", delta.operation_label_property.label,
                       delta.operation_label_property.property);
@@ -512,6 +525,56 @@ uint64_t Storage::ReplicationServer::ReadAndApplyDelta(durability::BaseDecoder *
           throw utils::BasicException("Invalid transaction!");
         break;
       }
+      case durability::WalDeltaData::Type::TEXT_INDEX_CREATE: {
+        spdlog::trace("       Create text index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (!storage_->CreateTextIndex(storage_->NameToLabel(delta.operation_label_property.label),
+                                       storage_->NameToProperty(delta.operation_label_property.property), timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::TEXT_INDEX_DROP: {
+        spdlog::trace("       Drop text index on :{} ({})", delta.operation_label_property.label,
+                      delta.operation_label_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (!storage_->DropTextIndex(storage_->NameToLabel(delta.operation_label_property.label),
+                                     storage_->NameToProperty(delta.operation_label_property.property), timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Create label+properties index on :{} ({})", delta.operation_label_property_list.label,
+                      ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        properties.reserve(delta.operation_label_property_list.properties.size());
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.emplace_back(storage_->NameToProperty(prop));
+        }
+        if (!storage_->CreateIndex(storage_->NameToLabel(delta.operation_label_property_list.label), properties,
+                                   timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Drop label+properties index on :{} ({})", delta.operation_label_property_list.label,
+                      ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        properties.reserve(delta.operation_label_property_list.properties.size());
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.emplace_back(storage_->NameToProperty(prop));
+        }
+        if (!storage_->DropIndex(storage_->NameToLabel(delta.operation_label_property_list.label), properties,
+                                 timestamp))
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
       case durability::WalDeltaData::Type::EXISTENCE_CONSTRAINT_CREATE: {
         spdlog::trace("       Create existence constraint on :{} ({})", delta.operation_label_property.label,
                       delta.operation_label_property.property);
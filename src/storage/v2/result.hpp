@@ -25,6 +25,7 @@ enum class Error : uint8_t {
   DELETED_OBJECT,
   VERTEX_HAS_EDGES,
   PROPERTIES_DISABLED,
+  READ_ONLY_TRANSACTION,
 };
 
 template <class TValue>
@@ -20,6 +20,7 @@
 
 #include "io/network/endpoint.hpp"
 #include "storage/v2/durability/durability.hpp"
+#include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/snapshot.hpp"
@@ -30,6 +31,8 @@
 #include "storage/v2/replication/config.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex_accessor.hpp"
+#include "utils/event_gauge.hpp"
+#include "utils/event_histogram.hpp"
 #include "utils/file.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory_tracker.hpp"
@@ -44,6 +47,16 @@
 #include "storage/v2/replication/replication_server.hpp"
 #include "storage/v2/replication/rpc.hpp"
 
+namespace EventGauge {
+extern const Event GarbageCollectionBacklog;
+}  // namespace EventGauge
+
+namespace EventHistogram {
+extern const Event CommitLatency;
+extern const Event GarbageCollectionLatency;
+extern const Event WalAppendLatency;
+}  // namespace EventHistogram
+
 namespace memgraph::storage {
 
 using OOMExceptionEnabler = utils::MemoryTracker::OutOfMemoryExceptionEnabler;
@@ -52,7 +65,7 @@ namespace {
 inline constexpr uint16_t kEpochHistoryRetention = 1000;
 }  // namespace
 
-auto AdvanceToVisibleVertex(utils::SkipList<Vertex>::Iterator it, utils::SkipList<Vertex>::Iterator end,
+auto AdvanceToVisibleVertex(VerticesContainer::Iterator it, VerticesContainer::Iterator end,
                             std::optional<VertexAccessor> *vertex, Transaction *tx, View view, Indices *indices,
                             Constraints *constraints, Config::Items config) {
   while (it != end) {
@@ -66,7 +79,7 @@ auto AdvanceToVisibleVertex(utils::SkipList<Vertex>::Iterator it, utils::SkipLis
   return it;
 }
 
-AllVerticesIterable::Iterator::Iterator(AllVerticesIterable *self, utils::SkipList<Vertex>::Iterator it)
+AllVerticesIterable::Iterator::Iterator(AllVerticesIterable *self, VerticesContainer::Iterator it)
     : self_(self),
       it_(AdvanceToVisibleVertex(it, self->vertices_accessor_.end(), &self->vertex_, self->transaction_, self->view_,
                                  self->indices_, self_->constraints_, self->config_)) {}
@@ -92,6 +105,14 @@ VerticesIterable::VerticesIterable(LabelPropertyIndex::Iterable vertices) : type
   new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(vertices));
 }
 
+VerticesIterable::VerticesIterable(LabelPropertiesIndex::Iterable vertices) : type_(Type::BY_LABEL_PROPERTIES) {
+  new (&vertices_by_label_properties_) LabelPropertiesIndex::Iterable(std::move(vertices));
+}
+
+VerticesIterable::VerticesIterable(TextIndex::Iterable vertices) : type_(Type::BY_TEXT) {
+  new (&vertices_by_text_) TextIndex::Iterable(std::move(vertices));
+}
+
 VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -103,6 +124,13 @@ VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(ot
     case Type::BY_LABEL_PROPERTY:
       new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(other.vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&vertices_by_label_properties_)
+          LabelPropertiesIndex::Iterable(std::move(other.vertices_by_label_properties_));
+      break;
+    case Type::BY_TEXT:
+      new (&vertices_by_text_) TextIndex::Iterable(std::move(other.vertices_by_text_));
+      break;
   }
 }
 
@@ -117,6 +145,12 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
     case Type::BY_LABEL_PROPERTY:
       vertices_by_label_property_.LabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      vertices_by_label_properties_.LabelPropertiesIndex::Iterable::~Iterable();
+      break;
+    case Type::BY_TEXT:
+      vertices_by_text_.TextIndex::Iterable::~Iterable();
+      break;
   }
   type_ = other.type_;
   switch (other.type_) {
@@ -129,6 +163,13 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
     case Type::BY_LABEL_PROPERTY:
       new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(other.vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&vertices_by_label_properties_)
+          LabelPropertiesIndex::Iterable(std::move(other.vertices_by_label_properties_));
+      break;
+    case Type::BY_TEXT:
+      new (&vertices_by_text_) TextIndex::Iterable(std::move(other.vertices_by_text_));
+      break;
   }
   return *this;
 }
@@ -144,6 +185,12 @@ VerticesIterable::~VerticesIterable() {
     case Type::BY_LABEL_PROPERTY:
       vertices_by_label_property_.LabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      vertices_by_label_properties_.LabelPropertiesIndex::Iterable::~Iterable();
+      break;
+    case Type::BY_TEXT:
+      vertices_by_text_.TextIndex::Iterable::~Iterable();
+      break;
   }
 }
 
@@ -155,6 +202,10 @@ VerticesIterable::Iterator VerticesIterable::begin() {
       return Iterator(vertices_by_label_.begin());
     case Type::BY_LABEL_PROPERTY:
       return Iterator(vertices_by_label_property_.begin());
+    case Type::BY_LABEL_PROPERTIES:
+      return Iterator(vertices_by_label_properties_.begin());
+    case Type::BY_TEXT:
+      return Iterator(vertices_by_text_.begin());
   }
 }
 
@@ -166,6 +217,10 @@ VerticesIterable::Iterator VerticesIterable::end() {
       return Iterator(vertices_by_label_.end());
     case Type::BY_LABEL_PROPERTY:
       return Iterator(vertices_by_label_property_.end());
+    case Type::BY_LABEL_PROPERTIES:
+      return Iterator(vertices_by_label_properties_.end());
+    case Type::BY_TEXT:
+      return Iterator(vertices_by_text_.end());
   }
 }
 
@@ -181,6 +236,15 @@ VerticesIterable::Iterator::Iterator(LabelPropertyIndex::Iterable::Iterator it)
   new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(it));
 }
 
+VerticesIterable::Iterator::Iterator(LabelPropertiesIndex::Iterable::Iterator it)
+    : type_(Type::BY_LABEL_PROPERTIES) {
+  new (&by_label_properties_it_) LabelPropertiesIndex::Iterable::Iterator(std::move(it));
+}
+
+VerticesIterable::Iterator::Iterator(TextIndex::Iterable::Iterator it) : type_(Type::BY_TEXT) {
+  new (&by_text_it_) TextIndex::Iterable::Iterator(std::move(it));
+}
+
 VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -192,6 +256,12 @@ VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) :
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(other.by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&by_label_properties_it_) LabelPropertiesIndex::Iterable::Iterator(other.by_label_properties_it_);
+      break;
+    case Type::BY_TEXT:
+      new (&by_text_it_) TextIndex::Iterable::Iterator(other.by_text_it_);
+      break;
   }
 }
 
@@ -208,6 +278,12 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(const Vertices
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(other.by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&by_label_properties_it_) LabelPropertiesIndex::Iterable::Iterator(other.by_label_properties_it_);
+      break;
+    case Type::BY_TEXT:
+      new (&by_text_it_) TextIndex::Iterable::Iterator(other.by_text_it_);
+      break;
   }
   return *this;
 }
@@ -223,6 +299,12 @@ VerticesIterable::Iterator::Iterator(VerticesIterable::Iterator &&other) noexcep
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(other.by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&by_label_properties_it_) LabelPropertiesIndex::Iterable::Iterator(std::move(other.by_label_properties_it_));
+      break;
+    case Type::BY_TEXT:
+      new (&by_text_it_) TextIndex::Iterable::Iterator(std::move(other.by_text_it_));
+      break;
   }
 }
 
@@ -239,6 +321,12 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(VerticesIterab
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(other.by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      new (&by_label_properties_it_) LabelPropertiesIndex::Iterable::Iterator(std::move(other.by_label_properties_it_));
+      break;
+    case Type::BY_TEXT:
+      new (&by_text_it_) TextIndex::Iterable::Iterator(std::move(other.by_text_it_));
+      break;
   }
   return *this;
 }
@@ -256,6 +344,12 @@ void VerticesIterable::Iterator::Destroy() noexcept {
     case Type::BY_LABEL_PROPERTY:
       by_label_property_it_.LabelPropertyIndex::Iterable::Iterator::~Iterator();
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      by_label_properties_it_.LabelPropertiesIndex::Iterable::Iterator::~Iterator();
+      break;
+    case Type::BY_TEXT:
+      by_text_it_.TextIndex::Iterable::Iterator::~Iterator();
+      break;
   }
 }
 
@@ -267,6 +361,10 @@ VertexAccessor VerticesIterable::Iterator::operator*() const {
       return *by_label_it_;
     case Type::BY_LABEL_PROPERTY:
       return *by_label_property_it_;
+    case Type::BY_LABEL_PROPERTIES:
+      return *by_label_properties_it_;
+    case Type::BY_TEXT:
+      return *by_text_it_;
   }
 }
 
@@ -281,6 +379,12 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator++() {
     case Type::BY_LABEL_PROPERTY:
       ++by_label_property_it_;
       break;
+    case Type::BY_LABEL_PROPERTIES:
+      ++by_label_properties_it_;
+      break;
+    case Type::BY_TEXT:
+      ++by_text_it_;
+      break;
   }
   return *this;
 }
@@ -293,6 +397,10 @@ bool VerticesIterable::Iterator::operator==(const Iterator &other) const {
       return by_label_it_ == other.by_label_it_;
     case Type::BY_LABEL_PROPERTY:
       return by_label_property_it_ == other.by_label_property_it_;
+    case Type::BY_LABEL_PROPERTIES:
+      return by_label_properties_it_ == other.by_label_properties_it_;
+    case Type::BY_TEXT:
+      return by_text_it_ == other.by_text_it_;
   }
 }
 
@@ -333,12 +441,13 @@ Storage::Storage(Config config)
   }
   if (config_.durability.recover_on_startup) {
     auto info = durability::RecoverData(snapshot_directory_, wal_directory_, &uuid_, &epoch_id_, &epoch_history_,
-                                        &vertices_, &edges_, &edge_count_, &name_id_mapper_, &indices_, &constraints_,
-                                        config_.items, &wal_seq_num_);
+                                        &vertices_, &vertex_directory_, &edges_, &edge_count_, &name_id_mapper_,
+                                        &indices_, &constraints_, config_.items,
+                                        config_.durability.recovery_thread_count, &wal_seq_num_);
     if (info) {
       vertex_id_ = info->next_vertex_id;
       edge_id_ = info->next_edge_id;
-      timestamp_ = std::max(timestamp_, info->next_timestamp);
+      timestamp_oracle_.AdvanceTo(info->next_timestamp);
       if (info->last_commit_timestamp) {
         last_commit_timestamp_ = *info->last_commit_timestamp;
       }
@@ -372,6 +481,10 @@ Storage::Storage(Config config)
           "those files into a .backup directory inside the storage directory.");
     }
   }
+  if (config_.durability.snapshot_wal_mode == Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL &&
+      config_.durability.wal_compression) {
+    wal_compression_pool_.emplace(1);
+  }
   if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED) {
     snapshot_runner_.Run("Snapshot", config_.durability.snapshot_interval, [this] {
       if (auto maybe_error = this->CreateSnapshot(); maybe_error.HasError()) {
@@ -380,6 +493,9 @@ Storage::Storage(Config config)
             spdlog::warn(
                 utils::MessageWithLink("Snapshots are disabled for replicas.", "https://memgr.ph/replication"));
             break;
+          case CreateSnapshotError::Failed:
+            spdlog::warn("The previous snapshot is kept until the next periodic snapshot.");
+            break;
         }
       }
     });
@@ -388,10 +504,10 @@ Storage::Storage(Config config)
     gc_runner_.Run("Storage GC", config_.gc.interval, [this] { this->CollectGarbage<false>(); });
   }
 
-  if (timestamp_ == kTimestampInitialId) {
+  if (const auto timestamp = timestamp_oracle_.Current(); timestamp == kTimestampInitialId) {
     commit_log_.emplace();
   } else {
-    commit_log_.emplace(timestamp_);
+    commit_log_.emplace(timestamp);
   }
 }
 
@@ -405,8 +521,12 @@ Storage::~Storage() {
     replication_clients_.WithLock([&](auto &clients) { clients.clear(); });
   }
   if (wal_file_) {
-    wal_file_->FinalizeWal();
-    wal_file_ = std::nullopt;
+    CloseWalFile();
+  }
+  if (wal_compression_pool_) {
+    // The WAL files that weren't compressed yet are compressed before exiting.
+    wal_compression_pool_->Shutdown();
+    CompressFinalizedWals();
   }
   if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED) {
     snapshot_runner_.Stop();
@@ -417,24 +537,29 @@ Storage::~Storage() {
         case CreateSnapshotError::DisabledForReplica:
           spdlog::warn(utils::MessageWithLink("Snapshots are disabled for replicas.", "https://memgr.ph/replication"));
           break;
+        case CreateSnapshotError::Failed:
+          spdlog::warn("The snapshot on exit wasn't created, the previous snapshot is kept.");
+          break;
       }
     }
   }
 }
 
-Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level)
+Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level, bool read_only)
     : storage_(storage),
       // The lock must be acquired before creating the transaction object to
       // prevent freshly created transactions from dangling in an active state
       // during exclusive operations.
       storage_guard_(storage_->main_lock_),
-      transaction_(storage->CreateTransaction(isolation_level)),
+      transaction_(read_only ? storage->CreateReadOnlyTransaction(isolation_level, &read_only_slot_)
+                             : storage->CreateTransaction(isolation_level)),
       is_transaction_active_(true),
       config_(storage->config_.items) {}
 
 Storage::Accessor::Accessor(Accessor &&other) noexcept
     : storage_(other.storage_),
       storage_guard_(std::move(other.storage_guard_)),
+      read_only_slot_(other.read_only_slot_),
       transaction_(std::move(other.transaction_)),
       commit_timestamp_(other.commit_timestamp_),
       is_transaction_active_(other.is_transaction_active_),
@@ -442,6 +567,7 @@ Storage::Accessor::Accessor(Accessor &&other) noexcept
   // Don't allow the other accessor to abort our transaction in destructor.
   other.is_transaction_active_ = false;
   other.commit_timestamp_.reset();
+  other.read_only_slot_.reset();
 }
 
 Storage::Accessor::~Accessor() {
@@ -452,8 +578,9 @@ Storage::Accessor::~Accessor() {
   FinalizeTransaction();
 }
 
-VertexAccessor Storage::Accessor::CreateVertex() {
+Result<VertexAccessor> Storage::Accessor::CreateVertex() {
   OOMExceptionEnabler oom_exception;
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   auto gid = storage_->vertex_id_.fetch_add(1, std::memory_order_acq_rel);
   auto acc = storage_->vertices_.access();
   auto delta = CreateDeleteObjectDelta(&transaction_);
@@ -461,11 +588,13 @@ VertexAccessor Storage::Accessor::CreateVertex() {
   MG_ASSERT(inserted, "The vertex must be inserted here!");
   MG_ASSERT(it != acc.end(), "Invalid Vertex accessor!");
   delta->prev.Set(&*it);
+  storage_->vertex_directory_.Insert(it->gid, &*it);
   return VertexAccessor(&*it, &transaction_, &storage_->indices_, &storage_->constraints_, config_);
 }
 
-VertexAccessor Storage::Accessor::CreateVertex(storage::Gid gid) {
+Result<VertexAccessor> Storage::Accessor::CreateVertex(storage::Gid gid) {
   OOMExceptionEnabler oom_exception;
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   // NOTE: When we update the next `vertex_id_` here we perform a RMW
   // (read-modify-write) operation that ISN'T atomic! But, that isn't an issue
   // because this function is only called from the replication delta applier
@@ -480,20 +609,28 @@ VertexAccessor Storage::Accessor::CreateVertex(storage::Gid gid) {
   MG_ASSERT(inserted, "The vertex must be inserted here!");
   MG_ASSERT(it != acc.end(), "Invalid Vertex accessor!");
   delta->prev.Set(&*it);
+  storage_->vertex_directory_.Insert(it->gid, &*it);
   return VertexAccessor(&*it, &transaction_, &storage_->indices_, &storage_->constraints_, config_);
 }
 
 std::optional<VertexAccessor> Storage::Accessor::FindVertex(Gid gid, View view) {
+  // The accessor must be taken before the directory lookup so that the garbage
+  // collector doesn't free the vertex while we are using it.
   auto acc = storage_->vertices_.access();
-  auto it = acc.find(gid);
-  if (it == acc.end()) return std::nullopt;
-  return VertexAccessor::Create(&*it, &transaction_, &storage_->indices_, &storage_->constraints_, config_, view);
+  auto *vertex = storage_->vertex_directory_.Find(gid);
+  if (vertex == nullptr) {
+    auto it = acc.find(gid);
+    if (it == acc.end()) return std::nullopt;
+    vertex = &*it;
+  }
+  return VertexAccessor::Create(vertex, &transaction_, &storage_->indices_, &storage_->constraints_, config_, view);
 }
 
 Result<std::optional<VertexAccessor>> Storage::Accessor::DeleteVertex(VertexAccessor *vertex) {
   MG_ASSERT(vertex->transaction_ == &transaction_,
             "VertexAccessor must be from the same transaction as the storage "
             "accessor when deleting a vertex!");
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   auto *vertex_ptr = vertex->vertex_;
 
   std::lock_guard<utils::SpinLock> guard(vertex_ptr->lock);
@@ -520,6 +657,7 @@ Result<std::optional<std::pair<VertexAccessor, std::vector<EdgeAccessor>>>> Stor
   MG_ASSERT(vertex->transaction_ == &transaction_,
             "VertexAccessor must be from the same transaction as the storage "
             "accessor when deleting a vertex!");
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   auto *vertex_ptr = vertex->vertex_;
 
   std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> in_edges;
@@ -586,6 +724,7 @@ Result<std::optional<std::pair<VertexAccessor, std::vector<EdgeAccessor>>>> Stor
 
 Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type) {
   OOMExceptionEnabler oom_exception;
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   MG_ASSERT(from->transaction_ == to->transaction_,
             "VertexAccessors must be from the same transaction when creating "
             "an edge!");
@@ -636,6 +775,8 @@ Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexA
   CreateAndLinkDelta(&transaction_, to_vertex, Delta::RemoveInEdgeTag(), edge_type, from_vertex, edge);
   to_vertex->in_edges.emplace_back(edge_type, from_vertex, edge);
 
+  UpdateOnCreateEdge(&storage_->indices_, edge_type, from_vertex, to_vertex, edge, transaction_);
+
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
 
@@ -646,6 +787,7 @@ Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexA
 Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type,
                                                    storage::Gid gid) {
   OOMExceptionEnabler oom_exception;
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   MG_ASSERT(from->transaction_ == to->transaction_,
             "VertexAccessors must be from the same transaction when creating "
             "an edge!");
@@ -704,6 +846,8 @@ Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexA
   CreateAndLinkDelta(&transaction_, to_vertex, Delta::RemoveInEdgeTag(), edge_type, from_vertex, edge);
   to_vertex->in_edges.emplace_back(edge_type, from_vertex, edge);
 
+  UpdateOnCreateEdge(&storage_->indices_, edge_type, from_vertex, to_vertex, edge, transaction_);
+
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
 
@@ -715,6 +859,7 @@ Result<std::optional<EdgeAccessor>> Storage::Accessor::DeleteEdge(EdgeAccessor *
   MG_ASSERT(edge->transaction_ == &transaction_,
             "EdgeAccessor must be from the same transaction as the storage "
             "accessor when deleting an edge!");
+  if (transaction_.read_only) return Error::READ_ONLY_TRANSACTION;
   auto edge_ref = edge->edge_;
   auto edge_type = edge->edge_type_;
 
@@ -817,8 +962,15 @@ utils::BasicResult<ConstraintViolation, void> Storage::Accessor::Commit(
     const std::optional<uint64_t> desired_commit_timestamp) {
   MG_ASSERT(is_transaction_active_, "The transaction is already terminated!");
   MG_ASSERT(!transaction_.must_abort, "The transaction can't be committed!");
-
-  if (transaction_.deltas.empty()) {
+  MG_ASSERT(!transaction_.read_only || transaction_.deltas.empty(), "Read-only transaction modified the storage!");
+  EventHistogram::ScopedMeasure measure{EventHistogram::CommitLatency};
+
+  if (read_only_slot_) {
+    // Read-only transactions aren't in the commit log, so there is nothing
+    // to mark as finished.
+    storage_->read_only_transactions_.Unregister(*read_only_slot_);
+    read_only_slot_.reset();
+  } else if (transaction_.deltas.empty()) {
     // We don't have to update the commit timestamp here because no one reads
     // it.
     storage_->commit_log_->MarkFinished(transaction_.start_timestamp);
@@ -850,7 +1002,12 @@ utils::BasicResult<ConstraintViolation, void> Storage::Accessor::Commit(
 
     {
       std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
-      commit_timestamp_.emplace(storage_->CommitTimestamp(desired_commit_timestamp));
+      commit_timestamp_.emplace(storage_->timestamp_oracle_.BeginCommit(desired_commit_timestamp));
+      // Transactions that get a higher start timestamp while we are committing
+      // wait until the commit timestamp is stored, so they can't miss our
+      // changes. The commit is finished right after it is published, so they
+      // don't wait for the WAL and the replicas.
+      std::optional<utils::OnScopeExit> finish_commit{[&] { storage_->timestamp_oracle_.FinishCommit(); }};
 
       // Before committing and validating vertices against unique constraints,
       // we have to update unique constraints with the vertices that are going
@@ -883,42 +1040,42 @@ utils::BasicResult<ConstraintViolation, void> Storage::Accessor::Commit(
       }
 
       if (!unique_constraint_violation) {
+        // TODO: update all deltas to have a local copy of the commit timestamp
+        MG_ASSERT(transaction_.commit_timestamp != nullptr, "Invalid database state!");
+        transaction_.commit_timestamp->store(*commit_timestamp_, std::memory_order_release);
+        finish_commit.reset();
+
         // Write transaction to WAL while holding the engine lock to make sure
         // that committed transactions are sorted by the commit timestamp in the
-        // WAL files. We supply the new commit timestamp to the function so that
-        // it knows what will be the final commit timestamp. The WAL must be
-        // written before actually committing the transaction (before setting
-        // the commit timestamp) so that no other transaction can see the
-        // modifications before they are written to disk.
+        // WAL files, and a transaction that saw our changes is written after
+        // us. The changes are visible to the other transactions while they are
+        // being written, but the commit returns only once they are written.
         // Replica can log only the write transaction received from Main
         // so the Wal files are consistent
         if (storage_->replication_role_ == ReplicationRole::MAIN || desired_commit_timestamp.has_value()) {
           storage_->AppendToWal(transaction_, *commit_timestamp_);
         }
 
-        // Take committed_transactions lock while holding the engine lock to
-        // make sure that committed transactions are sorted by the commit
-        // timestamp in the list.
-        storage_->committed_transactions_.WithLock([&](auto &committed_transactions) {
-          // TODO: release lock, and update all deltas to have a local copy
-          // of the commit timestamp
-          MG_ASSERT(transaction_.commit_timestamp != nullptr, "Invalid database state!");
-          transaction_.commit_timestamp->store(*commit_timestamp_, std::memory_order_release);
-          // Replica can only update the last commit timestamp with
-          // the commits received from main.
-          if (storage_->replication_role_ == ReplicationRole::MAIN || desired_commit_timestamp.has_value()) {
-            // Update the last commit timestamp
-            storage_->last_commit_timestamp_.store(*commit_timestamp_);
-          }
-          // Release engine lock because we don't have to hold it anymore
-          // and emplace back could take a long time.
-          engine_guard.unlock();
-        });
+        // The modified objects are tracked while holding the engine lock, which
+        // a snapshot transaction takes before it collects them, so it can't
+        // miss them.
+        if (storage_->replication_role_ == ReplicationRole::MAIN && storage_->DifferentialSnapshotsEnabled()) {
+          storage_->TrackModifiedObjects(transaction_, *commit_timestamp_);
+        }
 
-        storage_->commit_log_->MarkFinished(start_timestamp);
+        // Replica can only update the last commit timestamp with
+        // the commits received from main.
+        if (storage_->replication_role_ == ReplicationRole::MAIN || desired_commit_timestamp.has_value()) {
+          // Update the last commit timestamp
+          storage_->last_commit_timestamp_.store(*commit_timestamp_);
+        }
       }
     }
 
+    if (!unique_constraint_violation) {
+      storage_->commit_log_->MarkFinished(start_timestamp);
+    }
+
     if (unique_constraint_violation) {
       Abort();
       return *unique_constraint_violation;
@@ -932,6 +1089,14 @@ utils::BasicResult<ConstraintViolation, void> Storage::Accessor::Commit(
 void Storage::Accessor::Abort() {
   MG_ASSERT(is_transaction_active_, "The transaction is already terminated!");
 
+  if (read_only_slot_) {
+    MG_ASSERT(transaction_.deltas.empty(), "Read-only transaction modified the storage!");
+    storage_->read_only_transactions_.Unregister(*read_only_slot_);
+    read_only_slot_.reset();
+    is_transaction_active_ = false;
+    return;
+  }
+
   // We collect vertices and edges we've created here and then splice them into
   // `deleted_vertices_` and `deleted_edges_` lists, instead of adding them one
   // by one and acquiring lock every time.
@@ -1075,14 +1240,10 @@ void Storage::Accessor::Abort() {
   }
 
   {
-    std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
-    uint64_t mark_timestamp = storage_->timestamp_;
-    // Take garbage_undo_buffers lock while holding the engine lock to make
-    // sure that entries are sorted by mark timestamp in the list.
+    // Read the mark timestamp while holding the garbage_undo_buffers lock to
+    // make sure that entries are sorted by mark timestamp in the list.
     storage_->garbage_undo_buffers_.WithLock([&](auto &garbage_undo_buffers) {
-      // Release engine lock because we don't have to hold it anymore and
-      // emplace back could take a long time.
-      engine_guard.unlock();
+      const auto mark_timestamp = storage_->timestamp_oracle_.Current();
       garbage_undo_buffers.emplace_back(mark_timestamp, std::move(transaction_.deltas));
     });
     storage_->deleted_vertices_.WithLock(
@@ -1095,6 +1256,39 @@ void Storage::Accessor::Abort() {
   is_transaction_active_ = false;
 }
 
+utils::BasicResult<ConstraintViolation, void> Storage::Accessor::CommitAndRestart() {
+  auto result = Commit();
+  FinalizeTransaction();
+
+  auto transaction = transaction_.read_only
+                         ? storage_->CreateReadOnlyTransaction(transaction_.isolation_level, &read_only_slot_)
+                         : storage_->CreateTransaction(transaction_.isolation_level);
+  // The committed transaction was moved out of by `Commit`, so it is replaced
+  // with the new one in place. The vertex and edge accessors point to
+  // `transaction_`, so it must stay at the same address.
+  std::destroy_at(&transaction_);
+  std::construct_at(&transaction_, std::move(transaction));
+  is_transaction_active_ = true;
+
+  return result;
+}
+
+void Storage::Accessor::UpgradeToReadWrite() {
+  MG_ASSERT(is_transaction_active_, "The transaction is already terminated!");
+  transaction_.read_only = false;
+  if (!read_only_slot_) {
+    // There was no free slot, so the transaction is already a regular one.
+    return;
+  }
+  storage_->read_only_transactions_.Unregister(*read_only_slot_);
+  read_only_slot_.reset();
+
+  auto transaction = storage_->CreateTransaction(transaction_.isolation_level);
+  transaction_.transaction_id = transaction.transaction_id;
+  transaction_.start_timestamp = transaction.start_timestamp;
+  transaction_.command_id = 0;
+}
+
 void Storage::Accessor::FinalizeTransaction() {
   if (commit_timestamp_) {
     storage_->commit_log_->MarkFinished(*commit_timestamp_);
@@ -1128,7 +1322,7 @@ bool Storage::CreateIndex(LabelId label, const std::optional<uint64_t> desired_c
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   if (!indices_.label_index.CreateIndex(label, vertices_.access())) return false;
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::LABEL_INDEX_CREATE, label, {}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_INDEX_CREATE, label, std::set<PropertyId>{}, commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1138,7 +1332,8 @@ bool Storage::CreateIndex(LabelId label, PropertyId property, const std::optiona
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   if (!indices_.label_property_index.CreateIndex(label, property, vertices_.access())) return false;
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE, label, {property}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE, label, std::set<PropertyId>{property},
+              commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1148,7 +1343,7 @@ bool Storage::DropIndex(LabelId label, const std::optional<uint64_t> desired_com
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   if (!indices_.label_index.DropIndex(label)) return false;
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::LABEL_INDEX_DROP, label, {}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_INDEX_DROP, label, std::set<PropertyId>{}, commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1160,7 +1355,74 @@ bool Storage::DropIndex(LabelId label, PropertyId property, const std::optional<
   // For a description why using `timestamp_` is correct, see
   // `CreateIndex(LabelId label)`.
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP, label, {property}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP, label, std::set<PropertyId>{property},
+              commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                          const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.label_properties_index.CreateIndex(label, properties, vertices_.access())) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE, label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::DropIndex(LabelId label, const std::vector<PropertyId> &properties,
+                        const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.label_properties_index.DropIndex(label, properties)) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP, label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::CreateTextIndex(LabelId label, PropertyId property,
+                              const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.text_index.CreateIndex(label, property, vertices_.access())) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::TEXT_INDEX_CREATE, label, std::set<PropertyId>{property},
+              commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::DropTextIndex(LabelId label, PropertyId property,
+                            const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.text_index.DropIndex(label, property)) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::TEXT_INDEX_DROP, label, std::set<PropertyId>{property},
+              commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::CreateIndex(EdgeTypeId edge_type, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_index.CreateIndex(edge_type, vertices_.access())) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE, edge_type, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+  return true;
+}
+
+bool Storage::DropIndex(EdgeTypeId edge_type, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_index.DropIndex(edge_type)) return false;
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP, edge_type, commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1168,7 +1430,9 @@ bool Storage::DropIndex(LabelId label, PropertyId property, const std::optional<
 
 IndicesInfo Storage::ListAllIndices() const {
   std::shared_lock<utils::RWLock> storage_guard_(main_lock_);
-  return {indices_.label_index.ListIndices(), indices_.label_property_index.ListIndices()};
+  return {indices_.label_index.ListIndices(), indices_.label_property_index.ListIndices(),
+          indices_.label_properties_index.ListIndices(), indices_.text_index.ListIndices(),
+          indices_.edge_type_index.ListIndices()};
 }
 
 utils::BasicResult<ConstraintViolation, bool> Storage::CreateExistenceConstraint(
@@ -1177,7 +1441,8 @@ utils::BasicResult<ConstraintViolation, bool> Storage::CreateExistenceConstraint
   auto ret = storage::CreateExistenceConstraint(&constraints_, label, property, vertices_.access());
   if (ret.HasError() || !ret.GetValue()) return ret;
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE, label, {property}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE, label, std::set<PropertyId>{property},
+              commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1188,7 +1453,8 @@ bool Storage::DropExistenceConstraint(LabelId label, PropertyId property,
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
   if (!storage::DropExistenceConstraint(&constraints_, label, property)) return false;
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
-  AppendToWal(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP, label, {property}, commit_timestamp);
+  AppendToWal(durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP, label, std::set<PropertyId>{property},
+              commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
   return true;
@@ -1228,14 +1494,19 @@ ConstraintsInfo Storage::ListAllConstraints() const {
 }
 
 StorageInfo Storage::GetInfo() const {
+  auto info = GetBaseInfo();
+  info.disk_usage = utils::GetDirDiskUsage(config_.durability.storage_directory);
+  return info;
+}
+
+StorageInfo Storage::GetBaseInfo() const {
   auto vertex_count = vertices_.size();
   auto edge_count = edge_count_.load(std::memory_order_acquire);
   double average_degree = 0.0;
   if (vertex_count) {
     average_degree = 2.0 * static_cast<double>(edge_count) / vertex_count;
   }
-  return {vertex_count, edge_count, average_degree, utils::GetMemoryUsage(),
-          utils::GetDirDiskUsage(config_.durability.storage_directory)};
+  return {vertex_count, edge_count, average_degree, utils::GetMemoryUsage(), 0};
 }
 
 VerticesIterable Storage::Accessor::Vertices(LabelId label, View view) {
@@ -1260,30 +1531,51 @@ VerticesIterable Storage::Accessor::Vertices(LabelId label, PropertyId property,
       storage_->indices_.label_property_index.Vertices(label, property, lower_bound, upper_bound, view, &transaction_));
 }
 
+VerticesIterable Storage::Accessor::Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                                             std::vector<PropertyValue> prefix, View view) {
+  return VerticesIterable(storage_->indices_.label_properties_index.Vertices(label, properties, std::move(prefix), view,
+                                                                             &transaction_));
+}
+
+VerticesIterable Storage::Accessor::TextVertices(LabelId label, PropertyId property, std::string_view text,
+                                                 View view) {
+  return VerticesIterable(storage_->indices_.text_index.Vertices(label, property, text, view, &transaction_));
+}
+
 Transaction Storage::CreateTransaction(IsolationLevel isolation_level) {
-  // We acquire the transaction engine lock here because we access (and
-  // modify) the transaction engine variables (`transaction_id` and
-  // `timestamp`) below.
-  uint64_t transaction_id;
-  uint64_t start_timestamp;
-  {
-    std::lock_guard<utils::SpinLock> guard(engine_lock_);
-    transaction_id = transaction_id_++;
-    // Replica should have only read queries and the write queries
-    // can come from main instance with any past timestamp.
-    // To preserve snapshot isolation we set the start timestamp
-    // of any query on replica to the last commited transaction
-    // which is timestamp_ as only commit of transaction with writes
-    // can change the value of it.
-    if (replication_role_ == ReplicationRole::REPLICA) {
-      start_timestamp = timestamp_;
-    } else {
-      start_timestamp = timestamp_++;
-    }
-  }
+  // Both the transaction ID and the start timestamp are taken without a
+  // lock, see `TimestampOracle` for why this preserves snapshot isolation.
+  const auto transaction_id = transaction_id_.fetch_add(1, std::memory_order_acq_rel);
+  // Replica should have only read queries and the write queries
+  // can come from main instance with any past timestamp.
+  // To preserve snapshot isolation we set the start timestamp
+  // of any query on replica to the last commited transaction
+  // which is the current timestamp as only commit of transaction with
+  // writes can change the value of it.
+  const auto start_timestamp = replication_role_ == ReplicationRole::REPLICA ? timestamp_oracle_.SnapshotTimestamp()
+                                                                             : timestamp_oracle_.StartTimestamp();
   return {transaction_id, start_timestamp, isolation_level};
 }
 
+Transaction Storage::CreateReadOnlyTransaction(IsolationLevel isolation_level, std::optional<uint64_t> *slot) {
+  // The snapshot of a read-only transaction contains everything committed up
+  // to the last commit timestamp. Commits store the last commit timestamp
+  // after the commit timestamps of their deltas, so everything older is
+  // already visible and everything newer has a higher timestamp.
+  auto registration = read_only_transactions_.Register(last_commit_timestamp_);
+  if (!registration) {
+    // Without a free slot the transaction gets a regular ID, but it must
+    // still reject writes.
+    auto transaction = CreateTransaction(isolation_level);
+    transaction.read_only = true;
+    return transaction;
+  }
+  *slot = registration->slot;
+  Transaction transaction{kReadOnlyTransactionId, registration->start_timestamp, isolation_level};
+  transaction.read_only = true;
+  return transaction;
+}
+
 template <bool force>
 void Storage::CollectGarbage() {
   if constexpr (force) {
@@ -1319,8 +1611,9 @@ void Storage::CollectGarbage() {
   if (!gc_guard.owns_lock()) {
     return;
   }
+  EventHistogram::ScopedMeasure measure{EventHistogram::GarbageCollectionLatency};
 
-  uint64_t oldest_active_start_timestamp = commit_log_->OldestActive();
+  uint64_t oldest_active_start_timestamp = read_only_transactions_.OldestActive(commit_log_->OldestActive());
   // We don't move undo buffers of unlinked transactions to garbage_undo_buffers
   // list immediately, because we would have to repeatedly take
   // garbage_undo_buffers lock.
@@ -1482,14 +1775,11 @@ void Storage::CollectGarbage() {
   }
 
   {
-    std::unique_lock<utils::SpinLock> guard(engine_lock_);
-    uint64_t mark_timestamp = timestamp_;
-    // Take garbage_undo_buffers lock while holding the engine lock to make
-    // sure that entries are sorted by mark timestamp in the list.
+    // Read the mark timestamp while holding the garbage_undo_buffers lock to
+    // make sure that entries are sorted by mark timestamp in the list.
+    uint64_t mark_timestamp{0};
     garbage_undo_buffers_.WithLock([&](auto &garbage_undo_buffers) {
-      // Release engine lock because we don't have to hold it anymore and
-      // this could take a long time.
-      guard.unlock();
+      mark_timestamp = timestamp_oracle_.Current();
       // TODO(mtomic): holding garbage_undo_buffers_ lock here prevents
       // transactions from aborting until we're done marking, maybe we should
       // add them one-by-one or something
@@ -1513,6 +1803,7 @@ void Storage::CollectGarbage() {
         undo_buffers.pop_front();
       }
     }
+    EventGauge::SetGauge(EventGauge::GarbageCollectionBacklog, static_cast<EventGauge::Value>(undo_buffers.size()));
   });
 
   {
@@ -1521,16 +1812,35 @@ void Storage::CollectGarbage() {
       // if force is set to true, then we have unique_lock and no transactions are active
       // so we can clean all of the deleted vertices
       while (!garbage_vertices_.empty()) {
+        vertex_directory_.Remove(garbage_vertices_.front().second);
         MG_ASSERT(vertex_acc.remove(garbage_vertices_.front().second), "Invalid database state!");
         garbage_vertices_.pop_front();
       }
     } else {
       while (!garbage_vertices_.empty() && garbage_vertices_.front().first < oldest_active_start_timestamp) {
+        vertex_directory_.Remove(garbage_vertices_.front().second);
         MG_ASSERT(vertex_acc.remove(garbage_vertices_.front().second), "Invalid database state!");
         garbage_vertices_.pop_front();
       }
     }
   }
+  {
+    // The pages are unlinked after the vertices were removed from them. The
+    // mark timestamp is read afterwards, so only the transactions that are
+    // older than it could have read the pages.
+    auto pages = vertex_directory_.UnlinkEmptyPages(vertex_id_.load(std::memory_order_acquire));
+    if (!pages.empty()) {
+      garbage_directory_pages_.emplace_back(timestamp_oracle_.Current(), std::move(pages));
+    }
+    if constexpr (force) {
+      garbage_directory_pages_.clear();
+    } else {
+      while (!garbage_directory_pages_.empty() &&
+             garbage_directory_pages_.front().first < oldest_active_start_timestamp) {
+        garbage_directory_pages_.pop_front();
+      }
+    }
+  }
   {
     auto edge_acc = edges_.access();
     for (auto edge : current_deleted_edges) {
@@ -1548,11 +1858,37 @@ bool Storage::InitializeWalFile() {
     return false;
   if (!wal_file_) {
     wal_file_.emplace(wal_directory_, uuid_, epoch_id_, config_.items, &name_id_mapper_, wal_seq_num_++,
-                      &file_retainer_);
+                      &file_retainer_, DurabilityIoBackend());
   }
   return true;
 }
 
+utils::OutputFile::IoBackend Storage::DurabilityIoBackend() const {
+  return config_.durability.io_uring ? utils::OutputFile::IoBackend::IO_URING : utils::OutputFile::IoBackend::SYSCALL;
+}
+
+void Storage::CloseWalFile() {
+  wal_file_->FinalizeWal();
+  if (wal_compression_pool_ && wal_file_->Count() != 0) {
+    wals_to_compress_.WithLock([&](auto &paths) { paths.push_back(wal_file_->Path()); });
+    wal_compression_pool_->AddTask([this] { CompressFinalizedWals(); });
+  }
+  wal_file_.reset();
+}
+
+void Storage::CompressFinalizedWals() {
+  while (true) {
+    auto path = wals_to_compress_.WithLock([](auto &paths) -> std::optional<std::filesystem::path> {
+      if (paths.empty()) return std::nullopt;
+      auto path = std::move(paths.front());
+      paths.pop_front();
+      return path;
+    });
+    if (!path) return;
+    durability::CompressWalFile(*path, &file_retainer_);
+  }
+}
+
 void Storage::FinalizeWalFile() {
   ++wal_unsynced_transactions_;
   if (wal_unsynced_transactions_ >= config_.durability.wal_file_flush_every_n_tx) {
@@ -1560,8 +1896,7 @@ void Storage::FinalizeWalFile() {
     wal_unsynced_transactions_ = 0;
   }
   if (wal_file_->GetSize() / 1024 >= config_.durability.wal_file_size_kibibytes) {
-    wal_file_->FinalizeWal();
-    wal_file_ = std::nullopt;
+    CloseWalFile();
     wal_unsynced_transactions_ = 0;
   } else {
     // Try writing the internal buffer if possible, if not
@@ -1574,6 +1909,7 @@ void Storage::FinalizeWalFile() {
 
 void Storage::AppendToWal(const Transaction &transaction, uint64_t final_commit_timestamp) {
   if (!InitializeWalFile()) return;
+  EventHistogram::ScopedMeasure measure{EventHistogram::WalAppendLatency};
   // Traverse deltas and append them to the WAL file.
   // A single transaction will always be contained in a single WAL file.
   auto current_commit_timestamp = transaction.commit_timestamp->load(std::memory_order_acquire);
@@ -1769,6 +2105,44 @@ void Storage::AppendToWal(durability::StorageGlobalOperation operation, LabelId
   FinalizeWalFile();
 }
 
+void Storage::AppendToWal(durability::StorageGlobalOperation operation, EdgeTypeId edge_type,
+                          uint64_t final_commit_timestamp) {
+  if (!InitializeWalFile()) return;
+  wal_file_->AppendOperation(operation, edge_type, final_commit_timestamp);
+  {
+    if (replication_role_.load() == ReplicationRole::MAIN) {
+      replication_clients_.WithLock([&](auto &clients) {
+        for (auto &client : clients) {
+          client->StartTransactionReplication(wal_file_->SequenceNumber());
+          client->IfStreamingTransaction(
+              [&](auto &stream) { stream.AppendOperation(operation, edge_type, final_commit_timestamp); });
+          client->FinalizeTransactionReplication();
+        }
+      });
+    }
+  }
+  FinalizeWalFile();
+}
+
+void Storage::AppendToWal(durability::StorageGlobalOperation operation, LabelId label,
+                          const std::vector<PropertyId> &properties, uint64_t final_commit_timestamp) {
+  if (!InitializeWalFile()) return;
+  wal_file_->AppendOperation(operation, label, properties, final_commit_timestamp);
+  {
+    if (replication_role_.load() == ReplicationRole::MAIN) {
+      replication_clients_.WithLock([&](auto &clients) {
+        for (auto &client : clients) {
+          client->StartTransactionReplication(wal_file_->SequenceNumber());
+          client->IfStreamingTransaction(
+              [&](auto &stream) { stream.AppendOperation(operation, label, properties, final_commit_timestamp); });
+          client->FinalizeTransactionReplication();
+        }
+      });
+    }
+  }
+  FinalizeWalFile();
+}
+
 utils::BasicResult<Storage::CreateSnapshotError> Storage::CreateSnapshot() {
   if (replication_role_.load() != ReplicationRole::MAIN) {
     return CreateSnapshotError::DisabledForReplica;
@@ -1782,17 +2156,107 @@ utils::BasicResult<Storage::CreateSnapshotError> Storage::CreateSnapshot() {
   // Create the transaction used to create the snapshot.
   auto transaction = CreateTransaction(IsolationLevel::SNAPSHOT_ISOLATION);
 
+  // Decide whether only the objects that were modified since the last
+  // snapshot are stored. Every `snapshot_differential_count + 1`-th snapshot
+  // is a full snapshot so that the chain of snapshots that has to be applied
+  // during recovery stays short. A full snapshot is also created when most of
+  // the objects were modified.
+  std::optional<durability::DifferentialSnapshot> differential;
+  ModifiedObjects modified;
+  // Adds the objects from `from` that were modified by transactions that
+  // committed at or after `min_commit_timestamp` to `to`.
+  auto merge_modified = [](const auto &from, auto *to, uint64_t min_commit_timestamp) {
+    for (const auto &[gid, commit_timestamp] : from) {
+      if (commit_timestamp < min_commit_timestamp) continue;
+      auto &timestamp = (*to)[gid];
+      timestamp = std::max(timestamp, commit_timestamp);
+    }
+  };
+  if (DifferentialSnapshotsEnabled()) {
+    {
+      std::lock_guard<utils::SpinLock> engine_guard(engine_lock_);
+      std::swap(modified, modified_objects_);
+    }
+
+    const auto modified_count = modified.vertices.size() + modified.edges.size();
+    const auto objects_count = vertices_.size() + edges_.size();
+    if (last_snapshot_timestamp_ && differential_snapshots_count_ < config_.durability.snapshot_differential_count &&
+        modified_count <= objects_count / 2) {
+      auto sorted_gids = [](const std::unordered_map<Gid, uint64_t> &objects) {
+        std::vector<Gid> gids;
+        gids.reserve(objects.size());
+        for (const auto &[gid, _] : objects) {
+          gids.push_back(gid);
+        }
+        std::sort(gids.begin(), gids.end());
+        return gids;
+      };
+      differential.emplace(durability::DifferentialSnapshot{.base_start_timestamp = *last_snapshot_timestamp_,
+                                                            .vertices = sorted_gids(modified.vertices),
+                                                            .edges = sorted_gids(modified.edges)});
+    }
+
+    // The objects modified by the transactions that committed after the
+    // snapshot transaction started aren't visible to it, so they have to be
+    // stored into the next snapshot as well.
+    std::lock_guard<utils::SpinLock> engine_guard(engine_lock_);
+    merge_modified(modified.vertices, &modified_objects_.vertices, transaction.start_timestamp);
+    merge_modified(modified.edges, &modified_objects_.edges, transaction.start_timestamp);
+  }
+
+  // The snapshot wasn't written, so the next snapshot is still based on the
+  // previous one and has to contain all of the objects taken for this one.
+  auto abort_snapshot = [&] {
+    {
+      std::lock_guard<utils::SpinLock> engine_guard(engine_lock_);
+      merge_modified(modified.vertices, &modified_objects_.vertices, 0);
+      merge_modified(modified.edges, &modified_objects_.edges, 0);
+    }
+    commit_log_->MarkFinished(transaction.start_timestamp);
+  };
+
   // Create snapshot.
-  durability::CreateSnapshot(&transaction, snapshot_directory_, wal_directory_,
-                             config_.durability.snapshot_retention_count, &vertices_, &edges_, &name_id_mapper_,
-                             &indices_, &constraints_, config_.items, uuid_, epoch_id_, epoch_history_,
-                             &file_retainer_);
+  try {
+    durability::CreateSnapshot(&transaction, snapshot_directory_, wal_directory_,
+                               config_.durability.snapshot_retention_count,
+                               config_.durability.snapshot_thread_count, &vertices_, &edges_, &name_id_mapper_,
+                               &indices_, &constraints_, config_.items, uuid_, epoch_id_, epoch_history_,
+                               differential ? &*differential : nullptr, &file_retainer_, DurabilityIoBackend());
+  } catch (const durability::DurabilityFailure &e) {
+    spdlog::error("Couldn't create a snapshot: {}", e.what());
+    abort_snapshot();
+    return CreateSnapshotError::Failed;
+  } catch (...) {
+    abort_snapshot();
+    throw;
+  }
+  last_snapshot_timestamp_ = transaction.start_timestamp;
+  differential_snapshots_count_ = differential ? differential_snapshots_count_ + 1 : 0;
 
   // Finalize snapshot transaction.
   commit_log_->MarkFinished(transaction.start_timestamp);
   return {};
 }
 
+bool Storage::DifferentialSnapshotsEnabled() const {
+  return config_.durability.snapshot_differential_count > 0 &&
+         config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED;
+}
+
+void Storage::TrackModifiedObjects(const Transaction &transaction, const uint64_t commit_timestamp) {
+  // The newest delta of each modified object points to the object.
+  for (const auto &delta : transaction.deltas) {
+    auto prev = delta.prev.Get();
+    if (prev.type == PreviousPtr::Type::VERTEX) {
+      auto &timestamp = modified_objects_.vertices[prev.vertex->gid];
+      timestamp = std::max(timestamp, commit_timestamp);
+    } else if (prev.type == PreviousPtr::Type::EDGE) {
+      auto &timestamp = modified_objects_.edges[prev.edge->gid];
+      timestamp = std::max(timestamp, commit_timestamp);
+    }
+  }
+}
+
 bool Storage::LockPath() {
   auto locker_accessor = global_locker_.Access();
   return locker_accessor.AddPath(config_.durability.storage_directory);
@@ -1820,15 +2284,13 @@ void Storage::FreeMemory() {
   edges_.run_gc();
   indices_.label_index.RunGC();
   indices_.label_property_index.RunGC();
+  indices_.label_properties_index.RunGC();
+  indices_.text_index.RunGC();
+  indices_.edge_type_index.RunGC();
 }
 
 uint64_t Storage::CommitTimestamp(const std::optional<uint64_t> desired_commit_timestamp) {
-  if (!desired_commit_timestamp) {
-    return timestamp_++;
-  } else {
-    timestamp_ = std::max(timestamp_, *desired_commit_timestamp + 1);
-    return *desired_commit_timestamp;
-  }
+  return timestamp_oracle_.CommitTimestamp(desired_commit_timestamp);
 }
 
 bool Storage::SetReplicaRole(io::network::Endpoint endpoint, const replication::ReplicationServerConfig &config) {
@@ -1857,8 +2319,7 @@ bool Storage::SetMainReplicationRole() {
   {
     std::unique_lock engine_guard{engine_lock_};
     if (wal_file_) {
-      wal_file_->FinalizeWal();
-      wal_file_.reset();
+      CloseWalFile();
     }
 
     // Generate new epoch id and save the last one to the history.
@@ -1869,6 +2330,13 @@ bool Storage::SetMainReplicationRole() {
     epoch_id_ = utils::GenerateUUID();
   }
 
+  {
+    // The objects that were modified while this instance was a replica
+    // weren't tracked, so the next snapshot must be a full snapshot.
+    std::lock_guard snapshot_guard(snapshot_lock_);
+    last_snapshot_timestamp_.reset();
+  }
+
   replication_role_.store(ReplicationRole::MAIN);
   return true;
 }
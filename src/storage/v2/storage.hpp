@@ -12,15 +12,18 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <filesystem>
 #include <optional>
 #include <shared_mutex>
+#include <unordered_map>
 #include <variant>
 
 #include "io/network/endpoint.hpp"
 #include "storage/v2/commit_log.hpp"
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints.hpp"
+#include "storage/v2/containers.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/edge.hpp"
@@ -29,16 +32,20 @@
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/read_only_transactions.hpp"
 #include "storage/v2/result.hpp"
+#include "storage/v2/timestamp_oracle.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_accessor.hpp"
+#include "storage/v2/vertex_directory.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/rw_lock.hpp"
 #include "utils/scheduler.hpp"
 #include "utils/skip_list.hpp"
 #include "utils/synchronized.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/uuid.hpp"
 
 /// REPLICATION ///
@@ -60,7 +67,7 @@ namespace memgraph::storage {
 /// An instance of this will be usually be wrapped inside VerticesIterable for
 /// generic, public use.
 class AllVerticesIterable final {
-  utils::SkipList<Vertex>::Accessor vertices_accessor_;
+  VerticesContainer::Accessor vertices_accessor_;
   Transaction *transaction_;
   View view_;
   Indices *indices_;
@@ -71,10 +78,10 @@ class AllVerticesIterable final {
  public:
   class Iterator final {
     AllVerticesIterable *self_;
-    utils::SkipList<Vertex>::Iterator it_;
+    VerticesContainer::Iterator it_;
 
    public:
-    Iterator(AllVerticesIterable *self, utils::SkipList<Vertex>::Iterator it);
+    Iterator(AllVerticesIterable *self, VerticesContainer::Iterator it);
 
     VertexAccessor operator*() const;
 
@@ -85,7 +92,7 @@ class AllVerticesIterable final {
     bool operator!=(const Iterator &other) const { return !(*this == other); }
   };
 
-  AllVerticesIterable(utils::SkipList<Vertex>::Accessor vertices_accessor, Transaction *transaction, View view,
+  AllVerticesIterable(VerticesContainer::Accessor vertices_accessor, Transaction *transaction, View view,
                       Indices *indices, Constraints *constraints, Config::Items config)
       : vertices_accessor_(std::move(vertices_accessor)),
         transaction_(transaction),
@@ -103,19 +110,23 @@ class AllVerticesIterable final {
 /// This class should be the primary type used by the client code to iterate
 /// over vertices inside a Storage instance.
 class VerticesIterable final {
-  enum class Type { ALL, BY_LABEL, BY_LABEL_PROPERTY };
+  enum class Type { ALL, BY_LABEL, BY_LABEL_PROPERTY, BY_LABEL_PROPERTIES, BY_TEXT };
 
   Type type_;
   union {
     AllVerticesIterable all_vertices_;
     LabelIndex::Iterable vertices_by_label_;
     LabelPropertyIndex::Iterable vertices_by_label_property_;
+    LabelPropertiesIndex::Iterable vertices_by_label_properties_;
+    TextIndex::Iterable vertices_by_text_;
   };
 
  public:
   explicit VerticesIterable(AllVerticesIterable);
   explicit VerticesIterable(LabelIndex::Iterable);
   explicit VerticesIterable(LabelPropertyIndex::Iterable);
+  explicit VerticesIterable(LabelPropertiesIndex::Iterable);
+  explicit VerticesIterable(TextIndex::Iterable);
 
   VerticesIterable(const VerticesIterable &) = delete;
   VerticesIterable &operator=(const VerticesIterable &) = delete;
@@ -131,6 +142,8 @@ class VerticesIterable final {
       AllVerticesIterable::Iterator all_it_;
       LabelIndex::Iterable::Iterator by_label_it_;
       LabelPropertyIndex::Iterable::Iterator by_label_property_it_;
+      LabelPropertiesIndex::Iterable::Iterator by_label_properties_it_;
+      TextIndex::Iterable::Iterator by_text_it_;
     };
 
     void Destroy() noexcept;
@@ -139,6 +152,8 @@ class VerticesIterable final {
     explicit Iterator(AllVerticesIterable::Iterator);
     explicit Iterator(LabelIndex::Iterable::Iterator);
     explicit Iterator(LabelPropertyIndex::Iterable::Iterator);
+    explicit Iterator(LabelPropertiesIndex::Iterable::Iterator);
+    explicit Iterator(TextIndex::Iterable::Iterator);
 
     Iterator(const Iterator &);
     Iterator &operator=(const Iterator &);
@@ -164,6 +179,9 @@ class VerticesIterable final {
 struct IndicesInfo {
   std::vector<LabelId> label;
   std::vector<std::pair<LabelId, PropertyId>> label_property;
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_properties;
+  std::vector<std::pair<LabelId, PropertyId>> text;
+  std::vector<EdgeTypeId> edge_type;
 };
 
 /// Structure used to return information about existing constraints in the
@@ -196,7 +214,7 @@ class Storage final {
    private:
     friend class Storage;
 
-    explicit Accessor(Storage *storage, IsolationLevel isolation_level);
+    Accessor(Storage *storage, IsolationLevel isolation_level, bool read_only);
 
    public:
     Accessor(const Accessor &) = delete;
@@ -210,7 +228,7 @@ class Storage final {
     ~Accessor();
 
     /// @throw std::bad_alloc
-    VertexAccessor CreateVertex();
+    Result<VertexAccessor> CreateVertex();
 
     std::optional<VertexAccessor> FindVertex(Gid gid, View view);
 
@@ -230,6 +248,20 @@ class Storage final {
                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view);
 
+    /// Returns the vertices from the label+properties index whose leading
+    /// property values are equal to `prefix`.
+    VerticesIterable Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                              std::vector<PropertyValue> prefix, View view);
+
+    /// Returns the candidate vertices from the text index whose property may
+    /// contain `text`. The caller has to check the property value.
+    VerticesIterable TextVertices(LabelId label, PropertyId property, std::string_view text, View view);
+
+    /// Returns the edges of the given type. The edge type index must exist.
+    EdgeTypeIndex::Iterable Edges(EdgeTypeId edge_type, View view) {
+      return storage_->indices_.edge_type_index.Edges(edge_type, view, &transaction_);
+    }
+
     /// Return approximate number of all vertices in the database.
     /// Note that this is always an over-estimate and never an under-estimate.
     int64_t ApproximateVertexCount() const { return storage_->vertices_.size(); }
@@ -262,6 +294,39 @@ class Storage final {
       return storage_->indices_.label_property_index.ApproximateVertexCount(label, property, lower, upper);
     }
 
+    /// Return approximate number of all edges in the database.
+    /// Note that this is always an over-estimate and never an under-estimate.
+    int64_t ApproximateEdgeCount() const { return storage_->edge_count_.load(std::memory_order_acquire); }
+
+    /// Return approximate number of vertices in the label+properties index.
+    int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const {
+      return storage_->indices_.label_properties_index.ApproximateVertexCount(label, properties);
+    }
+
+    /// Return approximate number of vertices in the label+properties index
+    /// whose leading property values are equal to `prefix`.
+    int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                   const std::vector<PropertyValue> &prefix) const {
+      return storage_->indices_.label_properties_index.ApproximateVertexCount(label, properties, prefix);
+    }
+
+    /// Return approximate number of vertices in the text index.
+    int64_t ApproximateTextVertexCount(LabelId label, PropertyId property) const {
+      return storage_->indices_.text_index.ApproximateVertexCount(label, property);
+    }
+
+    /// Return approximate number of candidate vertices in the text index whose
+    /// property may contain `text`.
+    int64_t ApproximateTextVertexCount(LabelId label, PropertyId property, std::string_view text) const {
+      return storage_->indices_.text_index.ApproximateVertexCount(label, property, text);
+    }
+
+    /// Return approximate number of edges with the given type.
+    /// Note that this is always an over-estimate and never an under-estimate.
+    int64_t ApproximateEdgeCount(EdgeTypeId edge_type) const {
+      return storage_->indices_.edge_type_index.ApproximateEdgeCount(edge_type);
+    }
+
     /// @return Accessor to the deleted vertex if a deletion took place, std::nullopt otherwise
     /// @throw std::bad_alloc
     Result<std::optional<VertexAccessor>> DeleteVertex(VertexAccessor *vertex);
@@ -297,8 +362,27 @@ class Storage final {
       return storage_->indices_.label_property_index.IndexExists(label, property);
     }
 
+    bool LabelPropertiesIndexExists(LabelId label, const std::vector<PropertyId> &properties) const {
+      return storage_->indices_.label_properties_index.IndexExists(label, properties);
+    }
+
+    /// Returns the property lists of all label+properties indices on `label`.
+    std::vector<std::vector<PropertyId>> LabelPropertiesIndices(LabelId label) const {
+      return storage_->indices_.label_properties_index.ListIndices(label);
+    }
+
+    bool TextIndexExists(LabelId label, PropertyId property) const {
+      return storage_->indices_.text_index.IndexExists(label, property);
+    }
+
+    bool EdgeTypeIndexExists(EdgeTypeId edge_type) const {
+      return storage_->indices_.edge_type_index.IndexExists(edge_type);
+    }
+
     IndicesInfo ListAllIndices() const {
-      return {storage_->indices_.label_index.ListIndices(), storage_->indices_.label_property_index.ListIndices()};
+      return {storage_->indices_.label_index.ListIndices(), storage_->indices_.label_property_index.ListIndices(),
+              storage_->indices_.label_properties_index.ListIndices(),
+              storage_->indices_.text_index.ListIndices(), storage_->indices_.edge_type_index.ListIndices()};
     }
 
     ConstraintsInfo ListAllConstraints() const {
@@ -317,17 +401,38 @@ class Storage final {
     /// @throw std::bad_alloc
     void Abort();
 
+    /// Commits the changes made so far and starts a new transaction in the
+    /// same accessor. The new transaction is constructed in place of the old
+    /// `Transaction` object, so the vertex and edge accessors obtained before
+    /// the commit stay valid.
+    /// If the commit fails due to a constraint violation, the changes are
+    /// aborted, but the new transaction is still started.
+    /// @throw std::bad_alloc
+    utils::BasicResult<ConstraintViolation, void> CommitAndRestart();
+
     void FinalizeTransaction();
 
+    /// Returns true if the accessor runs a read-only transaction.
+    bool IsReadOnly() const { return transaction_.read_only; }
+
+    /// Replaces the read-only transaction with a regular one. Nothing obtained
+    /// through the accessor before the call may be used afterwards, so this
+    /// should only be called before the accessor was used to read anything.
+    void UpgradeToReadWrite();
+
    private:
     /// @throw std::bad_alloc
-    VertexAccessor CreateVertex(storage::Gid gid);
+    Result<VertexAccessor> CreateVertex(storage::Gid gid);
 
     /// @throw std::bad_alloc
     Result<EdgeAccessor> CreateEdge(VertexAccessor *from, VertexAccessor *to, EdgeTypeId edge_type, storage::Gid gid);
 
     Storage *storage_;
     std::shared_lock<utils::RWLock> storage_guard_;
+    // Slot in `read_only_transactions_` that is set while a read-only
+    // transaction is active. It must be declared before `transaction_`
+    // because it is set while the transaction is created.
+    std::optional<uint64_t> read_only_slot_;
     Transaction transaction_;
     std::optional<uint64_t> commit_timestamp_;
     bool is_transaction_active_;
@@ -335,7 +440,16 @@ class Storage final {
   };
 
   Accessor Access(std::optional<IsolationLevel> override_isolation_level = {}) {
-    return Accessor{this, override_isolation_level.value_or(isolation_level_)};
+    return Accessor{this, override_isolation_level.value_or(isolation_level_), false};
+  }
+
+  /// Returns an accessor for a transaction that won't modify the storage. The
+  /// transaction sees everything committed before it started, but it doesn't
+  /// take the transaction engine lock and doesn't use the commit log. If too
+  /// many read-only transactions are active, a regular transaction is started
+  /// instead.
+  Accessor ReadOnlyAccess(std::optional<IsolationLevel> override_isolation_level = {}) {
+    return Accessor{this, override_isolation_level.value_or(isolation_level_), true};
   }
 
   const std::string &LabelToName(LabelId label) const;
@@ -361,6 +475,27 @@ class Storage final {
 
   bool DropIndex(LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
 
+  /// Creates a composite index on the label and the ordered list of
+  /// properties.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                   std::optional<uint64_t> desired_commit_timestamp = {});
+
+  bool DropIndex(LabelId label, const std::vector<PropertyId> &properties,
+                 std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Creates a trigram index on the string values of the property for
+  /// vertices with the label.
+  /// @throw std::bad_alloc
+  bool CreateTextIndex(LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  bool DropTextIndex(LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// @throw std::bad_alloc
+  bool CreateIndex(EdgeTypeId edge_type, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  bool DropIndex(EdgeTypeId edge_type, std::optional<uint64_t> desired_commit_timestamp = {});
+
   IndicesInfo ListAllIndices() const;
 
   /// Creates an existence constraint. Returns true if the constraint was
@@ -404,6 +539,10 @@ class Storage final {
 
   StorageInfo GetInfo() const;
 
+  /// Same as `GetInfo`, but without the disk usage, which requires walking the
+  /// whole storage directory. `disk_usage` is set to 0.
+  StorageInfo GetBaseInfo() const;
+
   bool LockPath();
   bool UnlockPath();
 
@@ -439,13 +578,17 @@ class Storage final {
 
   void SetIsolationLevel(IsolationLevel isolation_level);
 
-  enum class CreateSnapshotError : uint8_t { DisabledForReplica };
+  enum class CreateSnapshotError : uint8_t { DisabledForReplica, Failed };
 
   utils::BasicResult<CreateSnapshotError> CreateSnapshot();
 
  private:
   Transaction CreateTransaction(IsolationLevel isolation_level);
 
+  /// Starts a read-only transaction and stores its slot in `slot`. If there is
+  /// no free slot, a regular transaction is started and `slot` is left empty.
+  Transaction CreateReadOnlyTransaction(IsolationLevel isolation_level, std::optional<uint64_t> *slot);
+
   /// The force parameter determines the behaviour of the garbage collector.
   /// If it's set to true, it will behave as a global operation, i.e. it can't
   /// be part of a transaction, and no other transaction can be active at the same time.
@@ -462,13 +605,31 @@ class Storage final {
 
   bool InitializeWalFile();
   void FinalizeWalFile();
+  // Finalizes and closes the current WAL file. If WAL compression is enabled,
+  // the finalized file is queued for compression.
+  void CloseWalFile();
+  void CompressFinalizedWals();
+
+  utils::OutputFile::IoBackend DurabilityIoBackend() const;
 
   void AppendToWal(const Transaction &transaction, uint64_t final_commit_timestamp);
   void AppendToWal(durability::StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
                    uint64_t final_commit_timestamp);
+  void AppendToWal(durability::StorageGlobalOperation operation, EdgeTypeId edge_type,
+                   uint64_t final_commit_timestamp);
+  void AppendToWal(durability::StorageGlobalOperation operation, LabelId label,
+                   const std::vector<PropertyId> &properties, uint64_t final_commit_timestamp);
 
   uint64_t CommitTimestamp(std::optional<uint64_t> desired_commit_timestamp = {});
 
+  /// Returns whether the objects modified by the committed transactions are
+  /// tracked so that differential snapshots can be created.
+  bool DifferentialSnapshotsEnabled() const;
+
+  /// Remembers the objects modified by the transaction for the next
+  /// differential snapshot. Must be called while holding `engine_lock_`.
+  void TrackModifiedObjects(const Transaction &transaction, uint64_t commit_timestamp);
+
   // Main storage lock.
   //
   // Accessors take a shared lock when starting, so it is possible to block
@@ -478,8 +639,10 @@ class Storage final {
   mutable utils::RWLock main_lock_{utils::RWLock::Priority::WRITE};
 
   // Main object storage
-  utils::SkipList<storage::Vertex> vertices_;
-  utils::SkipList<storage::Edge> edges_;
+  VerticesContainer vertices_;
+  EdgesContainer edges_;
+  // Maps vertex GIDs to the vertices in `vertices_` for O(1) lookups.
+  VertexDirectory vertex_directory_;
   std::atomic<uint64_t> vertex_id_{0};
   std::atomic<uint64_t> edge_id_{0};
   // Even though the edge count is already kept in the `edges_` SkipList, the
@@ -493,14 +656,18 @@ class Storage final {
   Indices indices_;
 
   // Transaction engine
+  // The engine lock serializes commits so that they are written to the WAL
+  // in the commit timestamp order. Starting and aborting transactions doesn't
+  // take it.
   utils::SpinLock engine_lock_;
-  uint64_t timestamp_{kTimestampInitialId};
-  uint64_t transaction_id_{kTransactionInitialId};
+  TimestampOracle timestamp_oracle_;
+  std::atomic<uint64_t> transaction_id_{kTransactionInitialId};
   // TODO: This isn't really a commit log, it doesn't even care if a
   // transaction commited or aborted. We could probably combine this with
-  // `timestamp_` in a sensible unit, something like TransactionClock or
+  // `timestamp_oracle_` in a sensible unit, something like TransactionClock or
   // whatever.
   std::optional<CommitLog> commit_log_;
+  ReadOnlyTransactions read_only_transactions_;
 
   utils::Synchronized<std::list<Transaction>, utils::SpinLock> committed_transactions_;
   IsolationLevel isolation_level_;
@@ -520,6 +687,10 @@ class Storage final {
   // to be removed from the main storage.
   std::list<std::pair<uint64_t, Gid>> garbage_vertices_;
 
+  // Pages that were unlinked from `vertex_directory_` and wait until no
+  // transaction can read them anymore.
+  std::list<std::pair<uint64_t, std::vector<std::unique_ptr<VertexDirectory::Page>>>> garbage_directory_pages_;
+
   // Edges that are logically deleted and wait to be removed from the main
   // storage.
   utils::Synchronized<std::list<Gid>, utils::SpinLock> deleted_edges_;
@@ -533,6 +704,21 @@ class Storage final {
   utils::Scheduler snapshot_runner_;
   utils::SpinLock snapshot_lock_;
 
+  // Objects that were modified since the last snapshot was created. Each GID
+  // is mapped to the largest commit timestamp of the transactions that
+  // modified the object. Protected by `engine_lock_`.
+  struct ModifiedObjects {
+    std::unordered_map<Gid, uint64_t> vertices;
+    std::unordered_map<Gid, uint64_t> edges;
+  };
+  ModifiedObjects modified_objects_;
+  // Start timestamp of the last snapshot, on top of which the next
+  // differential snapshot is created. Protected by `snapshot_lock_`.
+  std::optional<uint64_t> last_snapshot_timestamp_;
+  // Number of differential snapshots created since the last full snapshot.
+  // Protected by `snapshot_lock_`.
+  uint64_t differential_snapshots_count_{0};
+
   // UUID used to distinguish snapshots and to link snapshots to WALs
   std::string uuid_;
   // Sequence number used to keep track of the chain of WALs.
@@ -563,6 +749,12 @@ class Storage final {
 
   utils::FileRetainer file_retainer_;
 
+  // Finalized WAL files that wait to be compressed. They are compressed by
+  // `wal_compression_pool_` so that the commit that finalizes a WAL file
+  // doesn't wait for the compression.
+  utils::Synchronized<std::deque<std::filesystem::path>, utils::SpinLock> wals_to_compress_;
+  std::optional<utils::ThreadPool> wal_compression_pool_;
+
   // Global locker that is used for clients file locking
   utils::FileRetainer::FileLocker global_locker_;
 
@@ -0,0 +1,66 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "storage/v2/timestamp_oracle.hpp"
+
+#include <thread>
+
+namespace memgraph::storage {
+
+void TimestampOracle::AdvanceTo(const uint64_t timestamp) {
+  auto current = timestamp_.load(std::memory_order_acquire);
+  while (current < timestamp && !timestamp_.compare_exchange_weak(current, timestamp, std::memory_order_acq_rel)) {
+  }
+}
+
+uint64_t TimestampOracle::StartTimestamp() {
+  // The increment and the check below must not be reordered with the stores
+  // in `BeginCommit`, so both sides use sequentially consistent operations.
+  // If a commit took its timestamp before us, we either see it in progress or
+  // we see that it has finished.
+  const auto timestamp = timestamp_.fetch_add(1, std::memory_order_seq_cst);
+  WaitForCommitsBefore(timestamp);
+  return timestamp;
+}
+
+uint64_t TimestampOracle::SnapshotTimestamp() {
+  const auto timestamp = timestamp_.load(std::memory_order_seq_cst);
+  WaitForCommitsBefore(timestamp);
+  return timestamp;
+}
+
+uint64_t TimestampOracle::CommitTimestamp(const std::optional<uint64_t> desired_timestamp) {
+  if (!desired_timestamp) {
+    return timestamp_.fetch_add(1, std::memory_order_seq_cst);
+  }
+  AdvanceTo(*desired_timestamp + 1);
+  return *desired_timestamp;
+}
+
+uint64_t TimestampOracle::BeginCommit(const std::optional<uint64_t> desired_timestamp) {
+  commit_in_progress_.store(0, std::memory_order_seq_cst);
+  const auto commit_timestamp = CommitTimestamp(desired_timestamp);
+  // Transactions with a lower start timestamp won't see the commit anyway, so
+  // they don't have to wait for it.
+  commit_in_progress_.store(commit_timestamp, std::memory_order_seq_cst);
+  return commit_timestamp;
+}
+
+void TimestampOracle::FinishCommit() { commit_in_progress_.store(kNoCommit, std::memory_order_release); }
+
+void TimestampOracle::WaitForCommitsBefore(const uint64_t timestamp) const {
+  while (commit_in_progress_.load(std::memory_order_seq_cst) < timestamp) {
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,93 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+/// @file timestamp_oracle.hpp
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "storage/v2/transaction.hpp"
+
+namespace memgraph::storage {
+
+/// This class hands out the start and commit timestamps of transactions.
+///
+/// Timestamps are taken with an atomic increment, so starting a transaction
+/// doesn't take any lock. Commits are still serialized by the caller, because
+/// they have to be written to the WAL in the commit timestamp order, but a
+/// commit doesn't block the transactions that start concurrently unless they
+/// would have to see it. A transaction that gets a start timestamp higher than
+/// the timestamp of a commit that is still in progress waits until the commit
+/// is published, because it would otherwise miss the changes of a transaction
+/// that committed before it started.
+///
+/// This class is thread-safe.
+class TimestampOracle final {
+ public:
+  TimestampOracle() = default;
+
+  TimestampOracle(const TimestampOracle &) = delete;
+  TimestampOracle &operator=(const TimestampOracle &) = delete;
+  TimestampOracle(TimestampOracle &&) = delete;
+  TimestampOracle &operator=(TimestampOracle &&) = delete;
+
+  ~TimestampOracle() = default;
+
+  /// Returns the timestamp that will be handed out next.
+  uint64_t Current() const { return timestamp_.load(std::memory_order_acquire); }
+
+  /// Makes sure that all timestamps handed out from now on are at least
+  /// `timestamp`.
+  void AdvanceTo(uint64_t timestamp);
+
+  /// Returns a new start timestamp. All commits with a lower timestamp are
+  /// published when this function returns.
+  uint64_t StartTimestamp();
+
+  /// Returns the current timestamp without handing it out. All commits with a
+  /// lower timestamp are published when this function returns. This is used
+  /// on replicas, where only the commits received from main advance the
+  /// timestamp.
+  uint64_t SnapshotTimestamp();
+
+  /// Returns a new commit timestamp, or `desired_timestamp` if it's set, in
+  /// which case all timestamps handed out afterwards are higher. This should
+  /// only be used directly when no transaction can run concurrently.
+  uint64_t CommitTimestamp(std::optional<uint64_t> desired_timestamp = {});
+
+  /// Returns the commit timestamp for a commit whose changes will be published
+  /// in \ref FinishCommit. Transactions that start in the meantime with a
+  /// higher timestamp wait for the commit to finish. The caller must make sure
+  /// that commits don't overlap.
+  uint64_t BeginCommit(std::optional<uint64_t> desired_timestamp = {});
+
+  /// Marks the commit started with \ref BeginCommit as published.
+  void FinishCommit();
+
+ private:
+  static constexpr uint64_t kNoCommit = std::numeric_limits<uint64_t>::max();
+
+  /// Waits until no commit with a timestamp lower than `timestamp` is in
+  /// progress.
+  void WaitForCommitsBefore(uint64_t timestamp) const;
+
+  alignas(64) std::atomic<uint64_t> timestamp_{kTimestampInitialId};
+  // Timestamp of the commit that is in progress. While the commit timestamp
+  // is being chosen it is set to 0 so that every transaction that starts
+  // waits for it.
+  alignas(64) std::atomic<uint64_t> commit_in_progress_{kNoCommit};
+};
+
+}  // namespace memgraph::storage
@@ -29,6 +29,9 @@ namespace memgraph::storage {
 
 const uint64_t kTimestampInitialId = 0;
 const uint64_t kTransactionInitialId = 1ULL << 63U;
+// Read-only transactions don't create deltas, so they can all share an ID that
+// is never given to a regular transaction.
+const uint64_t kReadOnlyTransactionId = std::numeric_limits<uint64_t>::max();
 
 struct Transaction {
   Transaction(uint64_t transaction_id, uint64_t start_timestamp, IsolationLevel isolation_level)
@@ -45,7 +48,8 @@ struct Transaction {
         command_id(other.command_id),
         deltas(std::move(other.deltas)),
         must_abort(other.must_abort),
-        isolation_level(other.isolation_level) {}
+        isolation_level(other.isolation_level),
+        read_only(other.read_only) {}
 
   Transaction(const Transaction &) = delete;
   Transaction &operator=(const Transaction &) = delete;
@@ -70,6 +74,9 @@ struct Transaction {
   std::list<Delta> deltas;
   bool must_abort;
   IsolationLevel isolation_level;
+  // Set for transactions started through `Storage::ReadOnlyAccess`. Every
+  // write entry point checks it and returns `Error::READ_ONLY_TRANSACTION`.
+  bool read_only{false};
 };
 
 inline bool operator==(const Transaction &first, const Transaction &second) {
@@ -75,6 +75,7 @@ bool VertexAccessor::IsVisible(View view) const {
 }
 
 Result<bool> VertexAccessor::AddLabel(LabelId label) {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   std::lock_guard<utils::SpinLock> guard(vertex_->lock);
 
@@ -94,6 +95,7 @@ Result<bool> VertexAccessor::AddLabel(LabelId label) {
 }
 
 Result<bool> VertexAccessor::RemoveLabel(LabelId label) {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   std::lock_guard<utils::SpinLock> guard(vertex_->lock);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
@@ -208,6 +210,7 @@ Result<std::vector<LabelId>> VertexAccessor::Labels(View view) const {
 }
 
 Result<PropertyValue> VertexAccessor::SetProperty(PropertyId property, const PropertyValue &value) {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   std::lock_guard<utils::SpinLock> guard(vertex_->lock);
 
@@ -231,6 +234,7 @@ Result<PropertyValue> VertexAccessor::SetProperty(PropertyId property, const Pro
 }
 
 Result<std::map<PropertyId, PropertyValue>> VertexAccessor::ClearProperties() {
+  if (transaction_->read_only) return Error::READ_ONLY_TRANSACTION;
   std::lock_guard<utils::SpinLock> guard(vertex_->lock);
 
   if (!PrepareForWrite(transaction_, vertex_)) return Error::SERIALIZATION_ERROR;
@@ -289,6 +293,11 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
   return std::move(value);
 }
 
+Result<PropertyComparison> VertexAccessor::CompareProperty(PropertyId property, const PropertyValue &value,
+                                                           View view) const {
+  return ComparePropertyForRead(transaction_, vertex_, property, value, view, for_deleted_);
+}
+
 Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view) const {
   bool exists = true;
   bool deleted = false;
@@ -75,6 +75,11 @@ class VertexAccessor final {
   /// @throw std::bad_alloc
   Result<PropertyValue> GetProperty(PropertyId property, View view) const;
 
+  /// Compare the value of a property with the non-Null `value` without copying
+  /// the stored value out of the property store. A missing property is
+  /// reported as `PropertyComparison::ABSENT`.
+  Result<PropertyComparison> CompareProperty(PropertyId property, const PropertyValue &value, View view) const;
+
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
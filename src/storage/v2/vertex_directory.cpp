@@ -0,0 +1,90 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "storage/v2/vertex_directory.hpp"
+
+#include <algorithm>
+
+namespace memgraph::storage {
+
+VertexDirectory::~VertexDirectory() {
+  for (auto &segment : segments_) {
+    delete[] segment.load(std::memory_order_acquire);
+  }
+}
+
+VertexDirectory::Page *VertexDirectory::AllocatePage(uint64_t page_id) {
+  std::lock_guard<std::mutex> guard(lock_);
+  const auto index = page_id + kFirstSegmentSize;
+  const auto segment = std::bit_width(index) - 1 - kFirstSegmentBits;
+  auto *pages = segments_[segment].load(std::memory_order_acquire);
+  if (pages == nullptr) {
+    const auto segment_size = kFirstSegmentSize << segment;
+    pages = new std::atomic<Page *>[segment_size]();
+    segments_[segment].store(pages, std::memory_order_release);
+    memory_usage_.fetch_add(segment_size * sizeof(std::atomic<Page *>), std::memory_order_acq_rel);
+  }
+  auto &slot = pages[index - (kFirstSegmentSize << segment)];
+  auto *page = slot.load(std::memory_order_acquire);
+  if (page == nullptr) {
+    page = (pages_[page_id] = std::make_unique<Page>()).get();
+    slot.store(page, std::memory_order_release);
+    memory_usage_.fetch_add(sizeof(Page), std::memory_order_acq_rel);
+  }
+  return page;
+}
+
+void VertexDirectory::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto &[page_id, page] : pages_) {
+    for (auto &entry : page->entries) {
+      entry.store(nullptr, std::memory_order_release);
+    }
+    page->live.store(0, std::memory_order_release);
+    empty_pages_.push_back(page_id);
+  }
+}
+
+std::vector<std::unique_ptr<VertexDirectory::Page>> VertexDirectory::UnlinkEmptyPages(uint64_t next_gid) {
+  std::vector<std::unique_ptr<Page>> unlinked;
+  std::lock_guard<std::mutex> guard(lock_);
+  // A page is added again each time its last vertex is removed.
+  std::sort(empty_pages_.begin(), empty_pages_.end());
+  empty_pages_.erase(std::unique(empty_pages_.begin(), empty_pages_.end()), empty_pages_.end());
+  std::vector<uint64_t> pending;
+  for (auto page_id : empty_pages_) {
+    auto it = pages_.find(page_id);
+    if (it == pages_.end() || it->second->live.load(std::memory_order_acquire) != 0) continue;
+    if ((page_id + 1) << kPageBits > next_gid) {
+      pending.push_back(page_id);
+      continue;
+    }
+    const auto index = page_id + kFirstSegmentSize;
+    const auto segment = std::bit_width(index) - 1 - kFirstSegmentBits;
+    auto *pages = segments_[segment].load(std::memory_order_acquire);
+    pages[index - (kFirstSegmentSize << segment)].store(nullptr, std::memory_order_release);
+    memory_usage_.fetch_sub(sizeof(Page), std::memory_order_acq_rel);
+    unlinked.push_back(std::move(it->second));
+    pages_.erase(it);
+  }
+  empty_pages_ = std::move(pending);
+  return unlinked;
+}
+
+void VertexDirectory::Rebuild(VerticesContainer *vertices) {
+  Clear();
+  for (auto &vertex : vertices->access()) {
+    Insert(vertex.gid, &vertex);
+  }
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,155 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "storage/v2/containers.hpp"
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/vertex.hpp"
+
+namespace memgraph::storage {
+
+/// Dense mapping from vertex GIDs to vertices. Because GIDs are allocated
+/// monotonically, the mapping is stored as an array that is indexed by the
+/// GID, so a lookup costs one or two cache misses instead of an ordered search
+/// through the vertex store. The array is split into fixed-size pages that are
+/// allocated lazily, and the table of pages is split into segments that double
+/// in size, so the array can grow without moving the entries that concurrent
+/// readers might access.
+///
+/// The directory only holds pointers to vertices that are owned by the vertex
+/// store. Removed vertices are replaced by tombstones (`nullptr`) which must be
+/// written *before* the vertex is removed from the vertex store. Readers must
+/// hold an accessor to the vertex store while they use the returned pointer,
+/// so the garbage collector of the vertex store keeps the vertex alive.
+///
+/// Lookups are lock-free. Pages are allocated under a lock, which is rare
+/// because a page covers many consecutive GIDs. Once all vertices of a page
+/// are removed, the page can be unlinked with `UnlinkEmptyPages`. Concurrent
+/// readers might still use an unlinked page, so the caller frees it only after
+/// all of them are finished. A lookup that misses the directory must fall back
+/// to the vertex store, because an insert that races with the unlinking of its
+/// page is lost.
+class VertexDirectory final {
+ public:
+  struct Page;
+
+  VertexDirectory() = default;
+
+  VertexDirectory(const VertexDirectory &) = delete;
+  VertexDirectory &operator=(const VertexDirectory &) = delete;
+  VertexDirectory(VertexDirectory &&) = delete;
+  VertexDirectory &operator=(VertexDirectory &&) = delete;
+
+  ~VertexDirectory();
+
+  /// Returns the vertex with the given GID or `nullptr` if the directory
+  /// doesn't contain it.
+  Vertex *Find(Gid gid) const {
+    const auto *page = FindPage(gid.AsUint() >> kPageBits);
+    if (page == nullptr) return nullptr;
+    return page->entries[gid.AsUint() & kPageMask].load(std::memory_order_acquire);
+  }
+
+  /// @throw std::bad_alloc if unable to allocate a new page
+  void Insert(Gid gid, Vertex *vertex) {
+    auto *page = FindPage(gid.AsUint() >> kPageBits);
+    if (page == nullptr) {
+      page = AllocatePage(gid.AsUint() >> kPageBits);
+    }
+    if (page->entries[gid.AsUint() & kPageMask].exchange(vertex, std::memory_order_acq_rel) == nullptr) {
+      page->live.fetch_add(1, std::memory_order_acq_rel);
+    }
+  }
+
+  /// Replaces the vertex with the given GID by a tombstone.
+  void Remove(Gid gid) {
+    auto *page = FindPage(gid.AsUint() >> kPageBits);
+    if (page == nullptr) return;
+    if (page->entries[gid.AsUint() & kPageMask].exchange(nullptr, std::memory_order_acq_rel) != nullptr &&
+        page->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> guard(lock_);
+      empty_pages_.push_back(gid.AsUint() >> kPageBits);
+    }
+  }
+
+  /// Replaces all vertices with tombstones. The pages are kept for reuse until
+  /// they are unlinked.
+  void Clear();
+
+  /// Unlinks the pages that contain only tombstones and cover only GIDs below
+  /// `next_gid`, so no vertex will be inserted into them anymore. The unlinked
+  /// pages are returned because concurrent lookups might still read them; the
+  /// caller must keep them until all accessors that were active during the
+  /// call are finished.
+  std::vector<std::unique_ptr<Page>> UnlinkEmptyPages(uint64_t next_gid);
+
+  /// Clears the directory and inserts all vertices from the vertex store.
+  /// Used after the vertex store was filled without going through the
+  /// directory, e.g. when a snapshot was loaded.
+  /// @throw std::bad_alloc if unable to allocate a new page
+  void Rebuild(VerticesContainer *vertices);
+
+  /// Returns the number of bytes allocated by the directory, excluding the
+  /// unlinked pages.
+  uint64_t MemoryUsage() const { return memory_usage_.load(std::memory_order_acquire); }
+
+ private:
+  // A page covers 4096 consecutive GIDs, which is 32KiB of pointers.
+  static constexpr uint64_t kPageBits = 12;
+  static constexpr uint64_t kPageSize = uint64_t{1} << kPageBits;
+  static constexpr uint64_t kPageMask = kPageSize - 1;
+
+  static constexpr uint64_t kFirstSegmentBits = 6;
+  static constexpr uint64_t kFirstSegmentSize = uint64_t{1} << kFirstSegmentBits;
+  static constexpr size_t kNumSegments = 64 - kFirstSegmentBits;
+
+ public:
+  struct Page {
+    std::array<std::atomic<Vertex *>, kPageSize> entries{};
+    // Number of entries that aren't tombstones.
+    std::atomic<uint64_t> live{0};
+  };
+
+ private:
+
+  Page *FindPage(uint64_t page_id) const {
+    const auto index = page_id + kFirstSegmentSize;
+    const auto segment = std::bit_width(index) - 1 - kFirstSegmentBits;
+    const auto *pages = segments_[segment].load(std::memory_order_acquire);
+    if (pages == nullptr) return nullptr;
+    return pages[index - (kFirstSegmentSize << segment)].load(std::memory_order_acquire);
+  }
+
+  Page *AllocatePage(uint64_t page_id);
+
+  std::array<std::atomic<std::atomic<Page *> *>, kNumSegments> segments_{};
+  std::atomic<uint64_t> memory_usage_{0};
+
+  // Everything below is protected by the lock.
+  std::mutex lock_;
+  std::map<uint64_t, std::unique_ptr<Page>> pages_;
+  // IDs of the pages whose last vertex was removed. The pages that got new
+  // vertices in the meantime are skipped when they are unlinked.
+  std::vector<uint64_t> empty_pages_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,840 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils/logging.hpp"
+#include "utils/memory.hpp"
+#include "utils/skip_list.hpp"
+#include "utils/spin_lock.hpp"
+
+namespace memgraph::utils {
+
+/// Number of keys that fit into a single leaf of the `BTree`. A leaf with 64
+/// 8-byte keys and 64 object pointers spans 16 cache lines, so a binary search
+/// inside it touches only a few of them.
+const uint64_t kBTreeLeafCapacity = 64;
+
+/// Number of separator keys that fit into a single inner node of the `BTree`.
+const uint64_t kBTreeInnerCapacity = 64;
+
+/// The garbage collection is triggered on every `kBTreeGcRemoveTrigger`-th
+/// removal from the tree. It must be a power of two.
+const uint64_t kBTreeGcRemoveTrigger = 1024;
+
+/// The objects of the `BTree` are allocated separately from the tree nodes so
+/// that their addresses don't change when the nodes are split. The storage
+/// keeps raw pointers to vertices and edges, so this is a hard requirement.
+template <typename TObj>
+struct BTreeObject {
+  template <typename TObjUniv>
+  explicit BTreeObject(TObjUniv &&object) : obj(std::forward<TObjUniv>(object)) {}
+
+  TObj obj;
+};
+
+/// Get the size in bytes of the given BTreeObject instance. Used by the
+/// `SkipListGc` when the object is freed.
+template <typename TObj>
+size_t SkipListNodeSize(const BTreeObject<TObj> & /*object*/) {
+  return sizeof(BTreeObject<TObj>);
+}
+
+/// Concurrent B+-tree that can be used as a drop-in replacement for the
+/// `SkipList` when the objects are ordered by a single trivially copyable key
+/// (e.g. the `Gid` of a vertex). The keys are stored densely in the nodes so
+/// lookups and ordered scans touch far fewer cache lines than the skip list
+/// which has to chase a pointer for each visited object.
+///
+/// Synchronization is done using optimistic lock coupling as described in the
+/// paper "The ART of Practical Synchronization" by Leis et al.
+/// https://db.in.tum.de/~leis/papers/artsync.pdf
+/// Each node has a version counter whose lowest bit marks that the node is
+/// locked. Readers never write to shared memory; they remember the version of
+/// the node, read it and then check that the version didn't change. Writers
+/// lock only the nodes that they modify. Full nodes are split eagerly while
+/// descending the tree so that a split never has to propagate upwards.
+///
+/// Splits of nodes into which keys are appended in order are right-biased:
+/// the left node keeps all but one of its keys, so sequentially allocated keys
+/// (e.g. `Gid`s) fill the nodes almost completely instead of leaving them half
+/// empty.
+///
+/// Nodes aren't merged, but a leaf that becomes empty is unlinked from its
+/// parent together with the inner nodes that are left without any other child.
+/// The unlinked nodes stay locked, so optimistic readers that still reach them
+/// restart. Removed objects and unlinked nodes are reclaimed using the same GC
+/// that the `SkipList` uses, so anything that was reached through an accessor
+/// stays valid until that accessor is destroyed. Because only empty leaves are
+/// unlinked, the tree holds at most one leaf per stored object plus the nodes
+/// of a single path from the root to an empty leaf.
+///
+/// The iterators are weakly consistent, same as the `SkipList` iterators. The
+/// iterator remembers the leaf and the version of the leaf from which the
+/// current object was read. If the leaf didn't change, the next object is read
+/// directly from the leaf, otherwise the tree is searched again for the first
+/// key larger than the current one.
+///
+/// @tparam TObj object type that is stored in the tree
+/// @tparam kKey pointer to the member of `TObj` that is used as the key
+template <typename TObj, auto kKey>
+class BTree final {
+ public:
+  using TKey = std::remove_cvref_t<decltype(std::declval<TObj &>().*kKey)>;
+
+ private:
+  static_assert(std::is_trivially_copyable_v<TKey>, "The BTree key must be trivially copyable!");
+
+  using TObject = BTreeObject<TObj>;
+
+  /// Returns the position of the first of the `count` keys that isn't less
+  /// than `key`.
+  template <size_t kSize>
+  static uint64_t LowerBound(const std::atomic<TKey> (&keys)[kSize], const TKey &key, uint64_t count) {
+    uint64_t lower = 0;
+    uint64_t upper = count;
+    while (lower < upper) {
+      uint64_t mid = lower + (upper - lower) / 2;
+      if (keys[mid].load(std::memory_order_relaxed) < key) {
+        lower = mid + 1;
+      } else {
+        upper = mid;
+      }
+    }
+    return lower;
+  }
+
+  /// Returns the position of the first of the `count` keys that is larger
+  /// than `key`.
+  template <size_t kSize>
+  static uint64_t UpperBound(const std::atomic<TKey> (&keys)[kSize], const TKey &key, uint64_t count) {
+    uint64_t lower = 0;
+    uint64_t upper = count;
+    while (lower < upper) {
+      uint64_t mid = lower + (upper - lower) / 2;
+      if (key < keys[mid].load(std::memory_order_relaxed)) {
+        upper = mid;
+      } else {
+        lower = mid + 1;
+      }
+    }
+    return lower;
+  }
+
+  struct Node {
+    explicit Node(bool is_leaf) : is_leaf(is_leaf) {}
+
+    /// Reads the version of the node. Returns `false` if the node is locked.
+    bool ReadLock(uint64_t *read_version) const {
+      *read_version = version.load(std::memory_order_acquire);
+      return (*read_version & 1U) == 0;
+    }
+
+    /// Checks that the node wasn't modified since its version was read.
+    bool Validate(uint64_t read_version) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return version.load(std::memory_order_relaxed) == read_version;
+    }
+
+    /// Locks the node if it wasn't modified since its version was read.
+    bool UpgradeToWriteLock(uint64_t read_version) {
+      return version.compare_exchange_strong(read_version, read_version + 1, std::memory_order_acquire);
+    }
+
+    void WriteUnlock() { version.fetch_add(1, std::memory_order_release); }
+
+    const bool is_leaf;
+    // Odd while the node is locked, incremented on each lock and unlock.
+    std::atomic<uint64_t> version{0};
+    std::atomic<uint64_t> count{0};
+  };
+
+  struct Leaf : public Node {
+    Leaf() : Node(true) {}
+
+    /// Returns the number of keys clamped to the capacity so that inconsistent
+    /// optimistic reads never index out of bounds.
+    uint64_t Count() const { return std::min(this->count.load(std::memory_order_relaxed), kBTreeLeafCapacity); }
+
+    uint64_t LowerBound(const TKey &key, uint64_t count) const { return BTree::LowerBound(keys, key, count); }
+
+    uint64_t UpperBound(const TKey &key, uint64_t count) const { return BTree::UpperBound(keys, key, count); }
+
+    void Insert(uint64_t pos, const TKey &key, TObject *object) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      for (uint64_t i = count; i > pos; --i) {
+        keys[i].store(keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        values[i].store(values[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      keys[pos].store(key, std::memory_order_relaxed);
+      values[pos].store(object, std::memory_order_relaxed);
+      this->count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    void Remove(uint64_t pos) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      for (uint64_t i = pos; i + 1 < count; ++i) {
+        keys[i].store(keys[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        values[i].store(values[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      this->count.store(count - 1, std::memory_order_relaxed);
+    }
+
+    /// Moves the upper half of the keys into `right` and returns the largest
+    /// key that is left in this leaf. If `append` is set only the last key is
+    /// moved.
+    TKey Split(Leaf *right, bool append) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      uint64_t left_count = append ? count - 1 : count - count / 2;
+      for (uint64_t i = left_count; i < count; ++i) {
+        right->keys[i - left_count].store(keys[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        right->values[i - left_count].store(values[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      right->count.store(count - left_count, std::memory_order_relaxed);
+      this->count.store(left_count, std::memory_order_relaxed);
+      return keys[left_count - 1].load(std::memory_order_relaxed);
+    }
+
+    std::atomic<TKey> keys[kBTreeLeafCapacity];
+    std::atomic<TObject *> values[kBTreeLeafCapacity];
+  };
+
+  /// The subtree in `children[i]` contains the keys that are larger than
+  /// `keys[i - 1]` and less than or equal to `keys[i]`.
+  struct Inner : public Node {
+    Inner() : Node(false) {}
+
+    uint64_t Count() const { return std::min(this->count.load(std::memory_order_relaxed), kBTreeInnerCapacity); }
+
+    bool IsFull() const { return this->count.load(std::memory_order_relaxed) == kBTreeInnerCapacity; }
+
+    uint64_t LowerBound(const TKey &key, uint64_t count) const { return BTree::LowerBound(keys, key, count); }
+
+    uint64_t UpperBound(const TKey &key, uint64_t count) const { return BTree::UpperBound(keys, key, count); }
+
+    /// Inserts the new `child` to the right of the child that was split using
+    /// `separator`.
+    void Insert(const TKey &separator, Node *child) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      uint64_t pos = LowerBound(separator, count);
+      for (uint64_t i = count; i > pos; --i) {
+        keys[i].store(keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        children[i + 1].store(children[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      keys[pos].store(separator, std::memory_order_relaxed);
+      children[pos + 1].store(child, std::memory_order_relaxed);
+      this->count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    /// Removes the child at `pos` together with one of the separators next to
+    /// it. The range of the removed child is merged into its neighbour.
+    void Remove(uint64_t pos) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      uint64_t key_pos = pos < count ? pos : count - 1;
+      for (uint64_t i = key_pos; i + 1 < count; ++i) {
+        keys[i].store(keys[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      for (uint64_t i = pos; i < count; ++i) {
+        children[i].store(children[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      children[count].store(nullptr, std::memory_order_relaxed);
+      this->count.store(count - 1, std::memory_order_relaxed);
+    }
+
+    /// Moves the upper half of the keys and children into `right` and returns
+    /// the separator that has to be inserted into the parent. If `append` is
+    /// set only the last child is moved.
+    TKey Split(Inner *right, bool append) {
+      uint64_t count = this->count.load(std::memory_order_relaxed);
+      uint64_t left_count = append ? count - 1 : count / 2;
+      TKey separator = keys[left_count].load(std::memory_order_relaxed);
+      for (uint64_t i = left_count + 1; i < count; ++i) {
+        right->keys[i - left_count - 1].store(keys[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      for (uint64_t i = left_count + 1; i <= count; ++i) {
+        right->children[i - left_count - 1].store(children[i].load(std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+      }
+      right->count.store(count - left_count - 1, std::memory_order_relaxed);
+      this->count.store(left_count, std::memory_order_relaxed);
+      return separator;
+    }
+
+    std::atomic<TKey> keys[kBTreeInnerCapacity];
+    std::atomic<Node *> children[kBTreeInnerCapacity + 1]{};
+  };
+
+  template <typename TKeyOrObj>
+  static TKey KeyOf(const TKeyOrObj &key) {
+    if constexpr (std::is_same_v<TKeyOrObj, TObj>) {
+      return key.*kKey;
+    } else {
+      return key;
+    }
+  }
+
+ public:
+  /// Allocator type so that STL containers are aware that we need one.
+  using allocator_type = Allocator<TObject>;
+
+  class Iterator final {
+   private:
+    friend class BTree;
+
+    Iterator(BTree *tree, TObject *object, Leaf *leaf = nullptr, uint64_t pos = 0, uint64_t version = 0,
+             bool has_fence = false, TKey fence = TKey{})
+        : tree_(tree),
+          object_(object),
+          leaf_(leaf),
+          pos_(pos),
+          version_(version),
+          has_fence_(has_fence),
+          fence_(fence) {}
+
+   public:
+    TObj &operator*() const { return object_->obj; }
+
+    TObj *operator->() const { return &object_->obj; }
+
+    bool operator==(const Iterator &other) const { return object_ == other.object_; }
+
+    bool operator!=(const Iterator &other) const { return object_ != other.object_; }
+
+    Iterator &operator++() {
+      if (leaf_ != nullptr) {
+        uint64_t next = pos_ + 1;
+        uint64_t count = leaf_->Count();
+        TObject *object = next < count ? leaf_->values[next].load(std::memory_order_relaxed) : nullptr;
+        if (leaf_->Validate(version_)) {
+          if (object != nullptr) {
+            pos_ = next;
+            object_ = object;
+          } else if (has_fence_) {
+            // All keys up to the fence are in this leaf, so the next object is
+            // the first one after the fence.
+            *this = tree_->Seek(&fence_, false);
+          } else {
+            *this = Iterator{tree_, nullptr};
+          }
+          return *this;
+        }
+      }
+      *this = tree_->Seek(&(object_->obj.*kKey), false);
+      return *this;
+    }
+
+   private:
+    BTree *tree_;
+    TObject *object_;
+    // The leaf from which the current object was read and its version at that
+    // time. When the leaf is `nullptr` the position is unknown and the tree is
+    // searched on the next increment.
+    Leaf *leaf_;
+    uint64_t pos_;
+    uint64_t version_;
+    // The largest key that can be stored in `leaf_`. The rightmost leaf has no
+    // fence.
+    bool has_fence_;
+    TKey fence_;
+  };
+
+  class Accessor final {
+   private:
+    friend class BTree;
+
+    explicit Accessor(BTree *tree) : tree_(tree), id_(tree->gc_.AllocateId()) {}
+
+   public:
+    ~Accessor() {
+      if (tree_ != nullptr) tree_->gc_.ReleaseId(id_);
+    }
+
+    Accessor(const Accessor &) = delete;
+    Accessor &operator=(const Accessor &) = delete;
+
+    Accessor(Accessor &&other) noexcept : tree_(other.tree_), id_(other.id_) { other.tree_ = nullptr; }
+    Accessor &operator=(Accessor &&other) noexcept {
+      if (tree_ != nullptr) tree_->gc_.ReleaseId(id_);
+      tree_ = other.tree_;
+      id_ = other.id_;
+      other.tree_ = nullptr;
+      return *this;
+    }
+
+    Iterator begin() const { return tree_->Seek(nullptr, true); }
+
+    Iterator end() const { return Iterator{tree_, nullptr}; }
+
+    /// Inserts an object into the tree. It returns an iterator to the item
+    /// that is in the tree. If an item with the same key already exists in
+    /// the tree no insertion is done and an iterator to the existing item is
+    /// returned.
+    ///
+    /// @return Iterator to the item that is in the tree
+    ///         bool indicates whether the item was inserted into the tree
+    std::pair<Iterator, bool> insert(const TObj &object) { return tree_->insert(object); }
+    std::pair<Iterator, bool> insert(TObj &&object) { return tree_->insert(std::move(object)); }
+
+    /// Checks whether the key exists in the tree. The key can either be a
+    /// `TKey` or a `TObj`.
+    template <typename TKeyOrObj>
+    bool contains(const TKeyOrObj &key) const {
+      return tree_->Find(KeyOf(key)) != nullptr;
+    }
+
+    /// Finds the key in the tree and returns an iterator to the item.
+    ///
+    /// @return Iterator to the item in the tree, will be equal to `end()` when
+    ///                  the key isn't found
+    template <typename TKeyOrObj>
+    Iterator find(const TKeyOrObj &key) const {
+      auto k = KeyOf(key);
+      auto it = tree_->Seek(&k, true);
+      if (it.object_ != nullptr && !(it.object_->obj.*kKey == k)) return end();
+      return it;
+    }
+
+    /// Finds the key or the first larger key in the tree and returns an
+    /// iterator to the item.
+    ///
+    /// @return Iterator to the item in the tree, will be equal to `end()` when
+    ///                  no items match the search
+    template <typename TKeyOrObj>
+    Iterator find_equal_or_greater(const TKeyOrObj &key) const {
+      auto k = KeyOf(key);
+      return tree_->Seek(&k, true);
+    }
+
+    /// Removes the key from the tree.
+    ///
+    /// @return bool indicating whether the removal was successful
+    template <typename TKeyOrObj>
+    bool remove(const TKeyOrObj &key) {
+      return tree_->remove(KeyOf(key));
+    }
+
+    /// Returns the number of items contained in the tree.
+    uint64_t size() const { return tree_->size(); }
+
+   private:
+    BTree *tree_{nullptr};
+    uint64_t id_{0};
+  };
+
+  explicit BTree(MemoryResource *memory = NewDeleteResource()) : gc_(memory) { root_.store(AllocateNode<Leaf>()); }
+
+  BTree(const BTree &) = delete;
+  BTree &operator=(const BTree &) = delete;
+  BTree(BTree &&) = delete;
+  BTree &operator=(BTree &&) = delete;
+
+  ~BTree() {
+    clear();
+    FreeNode(static_cast<Leaf *>(root_.load(std::memory_order_acquire)));
+  }
+
+  /// All operations on the tree must be done through the Accessor proxy object.
+  Accessor access() { return Accessor{this}; }
+
+  uint64_t size() const { return size_.load(std::memory_order_acquire); }
+
+  /// Returns the number of allocated nodes, including the unlinked nodes that
+  /// weren't freed by the GC yet.
+  uint64_t node_count() const { return node_count_.load(std::memory_order_acquire); }
+
+  MemoryResource *GetMemoryResource() const { return gc_.GetMemoryResource(); }
+
+  /// This function removes all elements from the tree.
+  /// NOTE: The function *isn't* thread-safe. It must be called while there are
+  /// no more active accessors using the tree.
+  void clear() {
+    Node *root = root_.load(std::memory_order_acquire);
+    if (root->is_leaf) {
+      auto *leaf = static_cast<Leaf *>(root);
+      for (uint64_t i = 0; i < leaf->Count(); ++i) {
+        FreeObject(leaf->values[i].load(std::memory_order_relaxed));
+      }
+      leaf->count.store(0, std::memory_order_relaxed);
+    } else {
+      FreeSubtree(root);
+      root_.store(AllocateNode<Leaf>(), std::memory_order_release);
+    }
+    size_ = 0;
+    gc_.Clear();
+    for (auto [id, node] : unlinked_nodes_) {
+      FreeNode(node);
+    }
+    unlinked_nodes_.clear();
+  }
+
+  void run_gc() {
+    auto last_dead = gc_.Run();
+    if (last_dead == 0) return;
+    std::lock_guard<SpinLock> guard(unlinked_nodes_lock_);
+    auto it = std::partition(unlinked_nodes_.begin(), unlinked_nodes_.end(),
+                             [last_dead](const auto &item) { return item.first > last_dead + 1; });
+    for (auto free_it = it; free_it != unlinked_nodes_.end(); ++free_it) {
+      FreeNode(free_it->second);
+    }
+    unlinked_nodes_.erase(it, unlinked_nodes_.end());
+  }
+
+ private:
+  template <typename TNode>
+  TNode *AllocateNode() {
+    void *ptr = GetMemoryResource()->Allocate(sizeof(TNode), alignof(TNode));
+    node_count_.fetch_add(1, std::memory_order_acq_rel);
+    return new (ptr) TNode();
+  }
+
+  template <typename TNode>
+  void FreeNode(TNode *node) {
+    node->~TNode();
+    GetMemoryResource()->Deallocate(node, sizeof(TNode), alignof(TNode));
+    node_count_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void FreeNode(Node *node) {
+    if (node->is_leaf) {
+      FreeNode(static_cast<Leaf *>(node));
+    } else {
+      FreeNode(static_cast<Inner *>(node));
+    }
+  }
+
+  template <typename TObjUniv>
+  TObject *AllocateObject(TObjUniv &&object) {
+    void *ptr = GetMemoryResource()->Allocate(sizeof(TObject));
+    try {
+      return new (ptr) TObject(std::forward<TObjUniv>(object));
+    } catch (...) {
+      GetMemoryResource()->Deallocate(ptr, sizeof(TObject));
+      throw;
+    }
+  }
+
+  void FreeObject(TObject *object) {
+    object->~TObject();
+    GetMemoryResource()->Deallocate(object, sizeof(TObject));
+  }
+
+  void FreeSubtree(Node *node) {
+    if (node->is_leaf) {
+      auto *leaf = static_cast<Leaf *>(node);
+      for (uint64_t i = 0; i < leaf->Count(); ++i) {
+        FreeObject(leaf->values[i].load(std::memory_order_relaxed));
+      }
+      FreeNode(leaf);
+    } else {
+      auto *inner = static_cast<Inner *>(node);
+      for (uint64_t i = 0; i <= inner->Count(); ++i) {
+        FreeSubtree(inner->children[i].load(std::memory_order_relaxed));
+      }
+      FreeNode(inner);
+    }
+  }
+
+  /// Returns an iterator to the first object whose key is larger than (or
+  /// equal to if `inclusive` is set) `key`. If `key` is `nullptr` the iterator
+  /// points to the first object in the tree.
+  Iterator Seek(const TKey *key, bool inclusive) {
+    bool has_key = key != nullptr;
+    TKey current = has_key ? *key : TKey{};
+    while (true) {
+      bool has_fence = false;
+      TKey fence{};
+      Node *node = root_.load(std::memory_order_acquire);
+      uint64_t version = 0;
+      if (!node->ReadLock(&version)) continue;
+      Inner *parent = nullptr;
+      uint64_t parent_version = 0;
+      bool restart = false;
+      while (!node->is_leaf) {
+        if (parent != nullptr && !parent->Validate(parent_version)) {
+          restart = true;
+          break;
+        }
+        auto *inner = static_cast<Inner *>(node);
+        parent = inner;
+        parent_version = version;
+        uint64_t count = inner->Count();
+        uint64_t pos = 0;
+        if (has_key) {
+          pos = inclusive ? inner->LowerBound(current, count) : inner->UpperBound(current, count);
+        }
+        if (pos < count) {
+          has_fence = true;
+          fence = inner->keys[pos].load(std::memory_order_relaxed);
+        }
+        node = inner->children[pos].load(std::memory_order_relaxed);
+        if (node == nullptr || !inner->Validate(version) || !node->ReadLock(&version)) {
+          restart = true;
+          break;
+        }
+      }
+      if (restart) continue;
+      auto *leaf = static_cast<Leaf *>(node);
+      uint64_t count = leaf->Count();
+      uint64_t pos = 0;
+      if (has_key) {
+        pos = inclusive ? leaf->LowerBound(current, count) : leaf->UpperBound(current, count);
+      }
+      TObject *object = pos < count ? leaf->values[pos].load(std::memory_order_relaxed) : nullptr;
+      if ((parent != nullptr && !parent->Validate(parent_version)) || !leaf->Validate(version)) continue;
+      if (object != nullptr) return Iterator{this, object, leaf, pos, version, has_fence, fence};
+      if (!has_fence) return Iterator{this, nullptr};
+      // The leaf doesn't contain a matching key, continue from the first key
+      // after the fence.
+      has_key = true;
+      current = fence;
+      inclusive = false;
+    }
+  }
+
+  /// Returns the object with the given key or `nullptr` if it doesn't exist.
+  TObject *Find(const TKey &key) {
+    auto it = Seek(&key, true);
+    if (it.object_ == nullptr || !(it.object_->obj.*kKey == key)) return nullptr;
+    return it.object_;
+  }
+
+  template <typename TObjUniv>
+  std::pair<Iterator, bool> insert(TObjUniv &&object) {
+    const TKey &key = object.*kKey;
+    if (auto *existing = Find(key)) return {Iterator{this, existing}, false};
+    TObject *new_object = AllocateObject(std::forward<TObjUniv>(object));
+    const TKey &new_key = new_object->obj.*kKey;
+    while (true) {
+      Node *node = root_.load(std::memory_order_acquire);
+      uint64_t version = 0;
+      if (!node->ReadLock(&version)) continue;
+      Inner *parent = nullptr;
+      uint64_t parent_version = 0;
+      bool restart = false;
+      while (!node->is_leaf) {
+        auto *inner = static_cast<Inner *>(node);
+        if (inner->IsFull()) {
+          SplitNode(inner, version, parent, parent_version, new_key);
+          restart = true;
+          break;
+        }
+        if (parent != nullptr && !parent->Validate(parent_version)) {
+          restart = true;
+          break;
+        }
+        parent = inner;
+        parent_version = version;
+        node = inner->children[inner->LowerBound(new_key, inner->Count())].load(std::memory_order_relaxed);
+        if (node == nullptr || !inner->Validate(version) || !node->ReadLock(&version)) {
+          restart = true;
+          break;
+        }
+      }
+      if (restart) continue;
+      auto *leaf = static_cast<Leaf *>(node);
+      if (leaf->count.load(std::memory_order_relaxed) >= kBTreeLeafCapacity) {
+        SplitNode(leaf, version, parent, parent_version, new_key);
+        continue;
+      }
+      if (!leaf->UpgradeToWriteLock(version)) continue;
+      if (parent != nullptr && !parent->Validate(parent_version)) {
+        leaf->WriteUnlock();
+        continue;
+      }
+      uint64_t count = leaf->count.load(std::memory_order_relaxed);
+      uint64_t pos = leaf->LowerBound(new_key, count);
+      if (pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == new_key) {
+        // Another thread inserted the same key in the meantime.
+        TObject *existing = leaf->values[pos].load(std::memory_order_relaxed);
+        leaf->WriteUnlock();
+        FreeObject(new_object);
+        return {Iterator{this, existing}, false};
+      }
+      leaf->Insert(pos, new_key, new_object);
+      leaf->WriteUnlock();
+      size_.fetch_add(1, std::memory_order_acq_rel);
+      return {Iterator{this, new_object}, true};
+    }
+  }
+
+  /// Splits the `node` that was read with `version` and inserts the new node
+  /// into the `parent`. If the `parent` is `nullptr` the `node` must be the
+  /// root and a new root is created. Nothing is done if any of the nodes was
+  /// modified in the meantime; the caller restarts its operation in any case.
+  /// The split is right-biased if `key`, which is being inserted, is larger
+  /// than all keys in the `node`.
+  template <typename TNode>
+  void SplitNode(TNode *node, uint64_t version, Inner *parent, uint64_t parent_version, const TKey &key) {
+    if (parent != nullptr && !parent->UpgradeToWriteLock(parent_version)) return;
+    if (!node->UpgradeToWriteLock(version)) {
+      if (parent != nullptr) parent->WriteUnlock();
+      return;
+    }
+    if (parent == nullptr && node != root_.load(std::memory_order_acquire)) {
+      node->WriteUnlock();
+      return;
+    }
+    auto *right = AllocateNode<TNode>();
+    uint64_t count = node->count.load(std::memory_order_relaxed);
+    bool append = node->keys[count - 1].load(std::memory_order_relaxed) < key;
+    TKey separator = node->Split(right, append);
+    if (parent != nullptr) {
+      parent->Insert(separator, right);
+    } else {
+      auto *root = AllocateNode<Inner>();
+      root->keys[0].store(separator, std::memory_order_relaxed);
+      root->children[0].store(node, std::memory_order_relaxed);
+      root->children[1].store(right, std::memory_order_relaxed);
+      root->count.store(1, std::memory_order_relaxed);
+      root_.store(root, std::memory_order_release);
+    }
+    node->WriteUnlock();
+    if (parent != nullptr) parent->WriteUnlock();
+  }
+
+  bool remove(const TKey &key) {
+    while (true) {
+      Node *node = root_.load(std::memory_order_acquire);
+      uint64_t version = 0;
+      if (!node->ReadLock(&version)) continue;
+      Inner *parent = nullptr;
+      uint64_t parent_version = 0;
+      bool restart = false;
+      while (!node->is_leaf) {
+        if (parent != nullptr && !parent->Validate(parent_version)) {
+          restart = true;
+          break;
+        }
+        auto *inner = static_cast<Inner *>(node);
+        parent = inner;
+        parent_version = version;
+        node = inner->children[inner->LowerBound(key, inner->Count())].load(std::memory_order_relaxed);
+        if (node == nullptr || !inner->Validate(version) || !node->ReadLock(&version)) {
+          restart = true;
+          break;
+        }
+      }
+      if (restart) continue;
+      auto *leaf = static_cast<Leaf *>(node);
+      if (!leaf->UpgradeToWriteLock(version)) continue;
+      if (parent != nullptr && !parent->Validate(parent_version)) {
+        leaf->WriteUnlock();
+        continue;
+      }
+      uint64_t count = leaf->count.load(std::memory_order_relaxed);
+      uint64_t pos = leaf->LowerBound(key, count);
+      if (pos == count || !(leaf->keys[pos].load(std::memory_order_relaxed) == key)) {
+        leaf->WriteUnlock();
+        return false;
+      }
+      TObject *object = leaf->values[pos].load(std::memory_order_relaxed);
+      leaf->Remove(pos);
+      bool empty = leaf->count.load(std::memory_order_relaxed) == 0;
+      leaf->WriteUnlock();
+      gc_.Collect(object);
+      size_.fetch_add(-1, std::memory_order_acq_rel);
+      if (empty && parent != nullptr) UnlinkEmptyLeaf(key);
+      if ((removed_.fetch_add(1, std::memory_order_acq_rel) & (kBTreeGcRemoveTrigger - 1)) == 0) run_gc();
+      return true;
+    }
+  }
+
+  /// Unlinks the leaf that contains the range of `key` if it is empty. The
+  /// inner nodes above it that have no other child are unlinked as well, from
+  /// the lowest ancestor that has more than one child. Nothing is done if the
+  /// path from the root consists only of such nodes. The unlinked nodes stay
+  /// locked and are freed by the GC.
+  void UnlinkEmptyLeaf(const TKey &key) {
+    struct PathEntry {
+      Node *node;
+      uint64_t version;
+      // Position of the followed child in an inner node.
+      uint64_t pos;
+    };
+    std::vector<PathEntry> path;
+    while (true) {
+      path.clear();
+      Node *node = root_.load(std::memory_order_acquire);
+      uint64_t version = 0;
+      if (!node->ReadLock(&version)) continue;
+      bool restart = false;
+      while (!node->is_leaf) {
+        auto *inner = static_cast<Inner *>(node);
+        uint64_t pos = inner->LowerBound(key, inner->Count());
+        Node *child = inner->children[pos].load(std::memory_order_relaxed);
+        uint64_t child_version = 0;
+        if (child == nullptr || !inner->Validate(version) || !child->ReadLock(&child_version)) {
+          restart = true;
+          break;
+        }
+        path.push_back({inner, version, pos});
+        node = child;
+        version = child_version;
+      }
+      if (restart) continue;
+      bool empty = node->count.load(std::memory_order_relaxed) == 0;
+      if (!node->Validate(version)) continue;
+      if (!empty) return;
+      path.push_back({node, version, 0});
+
+      // Find the lowest ancestor that keeps other children.
+      uint64_t ancestor = path.size() - 1;
+      while (ancestor > 0) {
+        --ancestor;
+        if (path[ancestor].node->count.load(std::memory_order_relaxed) != 0) break;
+        if (ancestor == 0) return;
+      }
+
+      // Lock the nodes top-down, the versions guarantee that nothing changed
+      // since the path was read.
+      uint64_t locked = ancestor;
+      while (locked < path.size() && path[locked].node->UpgradeToWriteLock(path[locked].version)) {
+        ++locked;
+      }
+      if (locked < path.size()) {
+        for (uint64_t i = ancestor; i < locked; ++i) {
+          path[i].node->WriteUnlock();
+        }
+        continue;
+      }
+
+      static_cast<Inner *>(path[ancestor].node)->Remove(path[ancestor].pos);
+      path[ancestor].node->WriteUnlock();
+      std::lock_guard<SpinLock> guard(unlinked_nodes_lock_);
+      for (uint64_t i = ancestor + 1; i < path.size(); ++i) {
+        unlinked_nodes_.emplace_back(gc_.NextId(), path[i].node);
+      }
+      return;
+    }
+  }
+
+  std::atomic<Node *> root_{nullptr};
+  SkipListGc<TObj, TObject> gc_;
+  std::atomic<uint64_t> size_{0};
+  std::atomic<uint64_t> removed_{0};
+  std::atomic<uint64_t> node_count_{0};
+  // Nodes that were unlinked from the tree together with the ID of the next
+  // accessor at that time. They are freed when `gc_` reports that all
+  // accessors with smaller IDs were released.
+  SpinLock unlinked_nodes_lock_;
+  std::vector<std::pair<uint64_t, Node *>> unlinked_nodes_;
+};
+
+}  // namespace memgraph::utils
@@ -13,9 +13,6 @@
 
 #include <string_view>
 
-#include "utils/file.hpp"
-#include "utils/string.hpp"
-
 namespace memgraph::csv {
 
 using ParseError = Reader::ParseError;
@@ -24,28 +21,13 @@ void Reader::InitializeStream() {
   if (!std::filesystem::exists(path_)) {
     throw CsvReadException("CSV file not found: {}", path_.string());
   }
-  csv_stream_.open(path_);
-  if (!csv_stream_.good()) {
-    throw CsvReadException("CSV file {} couldn't be opened!", path_.string());
-  }
-}
-
-std::optional<utils::pmr::string> Reader::GetNextLine(utils::MemoryResource *mem) {
-  utils::pmr::string line(mem);
-  if (!std::getline(csv_stream_, line)) {
-    // reached end of file or an I/0 error occurred
-    if (!csv_stream_.good()) {
-      csv_stream_.close();
-    }
-    return std::nullopt;
-  }
-  ++line_count_;
-  return line;
+  tokenizer_.emplace(path_, std::string(*read_config_.delimiter), std::string(*read_config_.quote), 0,
+                     Tokenizer::CarriageReturns::KEEP_IN_UNQUOTED);
 }
 
 Reader::ParsingResult Reader::ParseHeader() {
   // header must be the very first line in the file
-  MG_ASSERT(line_count_ == 1, "Invalid use of {}", __func__);
+  MG_ASSERT(tokenizer_->LineCount() == 0, "Invalid use of {}", __func__);
   return ParseRow(memory_);
 }
 
@@ -71,127 +53,26 @@ void Reader::TryInitializeHeader() {
 
 const Reader::Header &Reader::GetHeader() const { return header_; }
 
-namespace {
-enum class CsvParserState : uint8_t { INITIAL_FIELD, NEXT_FIELD, QUOTING, EXPECT_DELIMITER, DONE };
-
-}  // namespace
-
 Reader::ParsingResult Reader::ParseRow(utils::MemoryResource *mem) {
   utils::pmr::vector<utils::pmr::string> row(mem);
-  if (number_of_columns_ != 0) {
-    row.reserve(number_of_columns_);
-  }
-
-  utils::pmr::string column(memory_);
-
-  auto state = CsvParserState::INITIAL_FIELD;
 
-  do {
-    const auto maybe_line = GetNextLine(mem);
-    if (!maybe_line) {
+  // Empty lines are skipped.
+  while (fields_.empty()) {
+    auto result = tokenizer_->ReadRow(&fields_);
+    if (result.HasError()) {
+      return std::move(result.GetError());
+    }
+    if (!*result) {
       // The whole file was processed.
       break;
     }
+  }
 
-    std::string_view line_string_view = *maybe_line;
-
-    // remove '\r' from the end in case we have dos file format
-    if (line_string_view.back() == '\r') {
-      line_string_view.remove_suffix(1);
-    }
-
-    while (state != CsvParserState::DONE && !line_string_view.empty()) {
-      const auto c = line_string_view[0];
-
-      // Line feeds and carriage returns are ignored in CSVs.
-      if (c == '\n' || c == '\r') {
-        line_string_view.remove_prefix(1);
-        continue;
-      }
-      // Null bytes aren't allowed in CSVs.
-      if (c == '\0') {
-        return ParseError(ParseError::ErrorCode::NULL_BYTE,
-                          fmt::format("CSV: Line {:d} contains NULL byte", line_count_ - 1));
-      }
-
-      switch (state) {
-        case CsvParserState::INITIAL_FIELD:
-        case CsvParserState::NEXT_FIELD: {
-          if (utils::StartsWith(line_string_view, *read_config_.quote)) {
-            // The current field is a quoted field.
-            state = CsvParserState::QUOTING;
-            line_string_view.remove_prefix(read_config_.quote->size());
-          } else if (utils::StartsWith(line_string_view, *read_config_.delimiter)) {
-            // The current field has an empty value.
-            row.emplace_back("");
-            state = CsvParserState::NEXT_FIELD;
-            line_string_view.remove_prefix(read_config_.delimiter->size());
-          } else {
-            // The current field is a regular field.
-            const auto delimiter_idx = line_string_view.find(*read_config_.delimiter);
-            row.emplace_back(line_string_view.substr(0, delimiter_idx));
-            if (delimiter_idx == std::string_view::npos) {
-              state = CsvParserState::DONE;
-            } else {
-              line_string_view.remove_prefix(delimiter_idx + read_config_.delimiter->size());
-              state = CsvParserState::NEXT_FIELD;
-            }
-          }
-          break;
-        }
-        case CsvParserState::QUOTING: {
-          const auto quote_now = utils::StartsWith(line_string_view, *read_config_.quote);
-          const auto quote_next =
-              utils::StartsWith(line_string_view.substr(read_config_.quote->size()), *read_config_.quote);
-          if (quote_now && quote_next) {
-            // This is an escaped quote character.
-            column += *read_config_.quote;
-            line_string_view.remove_prefix(read_config_.quote->size() * 2);
-          } else if (quote_now) {
-            // This is the end of the quoted field.
-            row.emplace_back(std::move(column));
-            column.clear();
-            state = CsvParserState::EXPECT_DELIMITER;
-            line_string_view.remove_prefix(read_config_.quote->size());
-          } else {
-            column.push_back(c);
-            line_string_view.remove_prefix(1);
-          }
-          break;
-        }
-        case CsvParserState::EXPECT_DELIMITER: {
-          if (utils::StartsWith(line_string_view, *read_config_.delimiter)) {
-            state = CsvParserState::NEXT_FIELD;
-            line_string_view.remove_prefix(read_config_.delimiter->size());
-          } else {
-            return ParseError(ParseError::ErrorCode::UNEXPECTED_TOKEN,
-                              fmt::format("CSV Reader: Expected '{}' after '{}', but got '{}' at line {:d}",
-                                          *read_config_.delimiter, *read_config_.quote, c, line_count_ - 1));
-          }
-          break;
-        }
-        case CsvParserState::DONE: {
-          LOG_FATAL("Invalid state of the CSV parser!");
-        }
-      }
-    }
-  } while (state == CsvParserState::QUOTING);
-
-  switch (state) {
-    case CsvParserState::INITIAL_FIELD:
-    case CsvParserState::DONE:
-    case CsvParserState::EXPECT_DELIMITER:
-      break;
-    case CsvParserState::NEXT_FIELD:
-      row.emplace_back("");
-      break;
-    case CsvParserState::QUOTING: {
-      return ParseError(ParseError::ErrorCode::NO_CLOSING_QUOTE,
-                        "There is no more data left to load while inside a quoted string. "
-                        "Did you forget to close the quote?");
-      break;
-    }
+  row.reserve(fields_.size());
+  for (const auto field : fields_) {
+    row.emplace_back(field);
   }
+  fields_.clear();
 
   // reached the end of file - return empty row
   if (row.empty()) {
@@ -210,7 +91,7 @@ Reader::ParsingResult Reader::ParseRow(utils::MemoryResource *mem) {
                       //      row may span several lines) ==> should have a row
                       //      counter
                       fmt::format("Expected {:d} columns in row {:d}, but got {:d}", number_of_columns_,
-                                  line_count_ - 1, row.size()));
+                                  tokenizer_->LineCount(), row.size()));
   }
 
   return std::move(row);
@@ -226,14 +107,11 @@ std::optional<Reader::Row> Reader::GetNextRow(utils::MemoryResource *mem) {
 
   if (row.HasError()) {
     if (!read_config_.ignore_bad) {
-      throw CsvReadException("CSV Reader: Bad row at line {:d}: {}", line_count_ - 1, row.GetError().message);
+      throw CsvReadException("CSV Reader: Bad row at line {:d}: {}", tokenizer_->LineCount(), row.GetError().message);
     }
     // try to parse as many times as necessary to reach a valid row
     do {
-      spdlog::debug("CSV Reader: Bad row at line {:d}: {}", line_count_ - 1, row.GetError().message);
-      if (!csv_stream_.good()) {
-        return std::nullopt;
-      }
+      spdlog::debug("CSV Reader: Bad row at line {:d}: {}", tokenizer_->LineCount(), row.GetError().message);
       row = ParseRow(mem);
     } while (row.HasError());
   }
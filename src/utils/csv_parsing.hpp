@@ -20,11 +20,12 @@
 
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "utils/csv_tokenizer.hpp"
 #include "utils/exceptions.hpp"
 #include "utils/pmr/string.hpp"
 #include "utils/pmr/vector.hpp"
@@ -32,10 +33,6 @@
 
 namespace memgraph::csv {
 
-class CsvReadException : public utils::BasicException {
-  using utils::BasicException::BasicException;
-};
-
 class Reader {
  public:
   struct Config {
@@ -72,13 +69,7 @@ class Reader {
 
   ~Reader() = default;
 
-  struct ParseError {
-    enum class ErrorCode : uint8_t { BAD_HEADER, NO_CLOSING_QUOTE, UNEXPECTED_TOKEN, BAD_NUM_OF_COLUMNS, NULL_BYTE };
-    ParseError(ErrorCode code, std::string message) : code(code), message(std::move(message)) {}
-
-    ErrorCode code;
-    std::string message;
-  };
+  using ParseError = csv::ParseError;
 
   using ParsingResult = utils::BasicResult<ParseError, Row>;
   [[nodiscard]] bool HasHeader() const;
@@ -88,9 +79,9 @@ class Reader {
  private:
   utils::MemoryResource *memory_;
   std::filesystem::path path_;
-  std::ifstream csv_stream_;
+  std::optional<Tokenizer> tokenizer_;
+  std::vector<std::string_view> fields_;
   Config read_config_;
-  uint64_t line_count_{1};
   uint16_t number_of_columns_{0};
   Header header_{memory_};
 
@@ -98,8 +89,6 @@ class Reader {
 
   void TryInitializeHeader();
 
-  std::optional<utils::pmr::string> GetNextLine(utils::MemoryResource *mem);
-
   ParsingResult ParseHeader();
 
   ParsingResult ParseRow(utils::MemoryResource *mem);
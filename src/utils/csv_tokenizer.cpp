@@ -0,0 +1,353 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/csv_tokenizer.hpp"
+
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "utils/exceptions.hpp"
+
+namespace memgraph::csv {
+
+namespace {
+// Size of the blocks in which the file is read. The buffer grows if a single
+// row is larger than this.
+constexpr size_t kReadBlockSize = 1024UL * 1024UL;
+// Number of bytes that are scanned for structural characters at once.
+constexpr size_t kScanBlockSize = 64;
+
+enum class TokenizerState : uint8_t { FIELD_START, UNQUOTED, QUOTED, AFTER_QUOTE };
+}  // namespace
+
+Tokenizer::Tokenizer(const std::filesystem::path &path, std::string delimiter, std::string quote, uint64_t offset,
+                     CarriageReturns carriage_returns)
+    : path_(path), delimiter_(std::move(delimiter)), quote_(std::move(quote)), carriage_returns_(carriage_returns) {
+  if (delimiter_.empty() || quote_.empty()) {
+    throw CsvReadException("The CSV delimiter and quote can't be empty!");
+  }
+  file_.open(path, std::ios::binary);
+  if (!file_.is_open()) {
+    throw CsvReadException("CSV file {} couldn't be opened!", path.string());
+  }
+  if (offset != 0 && !file_.seekg(static_cast<std::streamoff>(offset))) {
+    throw CsvReadException("Couldn't seek to offset {} in CSV file {}!", offset, path.string());
+  }
+  buffer_offset_ = offset;
+  buffer_.resize(kReadBlockSize);
+  for (auto c : {delimiter_[0], quote_[0], '\n', '\r', '\0'}) {
+    is_special_[static_cast<uint8_t>(c)] = true;
+  }
+}
+
+bool Tokenizer::Refill() {
+  if (eof_) return false;
+  // Move the current row to the beginning of the buffer.
+  if (row_start_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + row_start_, end_ - row_start_);
+    for (auto &range : ranges_) {
+      range.begin -= row_start_;
+    }
+    buffer_offset_ += row_start_;
+    pos_ -= row_start_;
+    write_ -= std::min(write_, row_start_);
+    field_begin_ -= std::min(field_begin_, row_start_);
+    end_ -= row_start_;
+    row_start_ = 0;
+  }
+  if (end_ == buffer_.size()) {
+    // A single row fills up the whole buffer.
+    buffer_.resize(buffer_.size() * 2);
+  }
+  mask_valid_ = false;
+
+  // The file is read until the end instead of up to its size, which can change
+  // while it is read and which isn't known for FIFOs.
+  file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+  if (file_.bad()) {
+    throw CsvReadException("Couldn't read from CSV file {}!", path_.string());
+  }
+  const auto read = static_cast<size_t>(file_.gcount());
+  if (read == 0) {
+    eof_ = true;
+    return false;
+  }
+  end_ += read;
+  return true;
+}
+
+bool Tokenizer::Ensure(size_t size) {
+  while (end_ - pos_ < size) {
+    if (!Refill()) return false;
+  }
+  return true;
+}
+
+bool Tokenizer::Matches(size_t at, std::string_view what) {
+  // The position must be relative to `pos_` because `Ensure` can move the
+  // data in the buffer.
+  auto relative = at - pos_;
+  if (!Ensure(relative + what.size())) return false;
+  return std::string_view(buffer_.data() + pos_ + relative, what.size()) == what;
+}
+
+uint64_t Tokenizer::ComputeMask(size_t at) const {
+  const auto *data = reinterpret_cast<const uint8_t *>(buffer_.data() + at);
+  if (end_ - at >= kScanBlockSize) {
+#if defined(__AVX2__)
+    const auto delimiter = _mm256_set1_epi8(delimiter_[0]);
+    const auto quote = _mm256_set1_epi8(quote_[0]);
+    const auto line_feed = _mm256_set1_epi8('\n');
+    const auto carriage_return = _mm256_set1_epi8('\r');
+    const auto null = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    for (size_t i = 0; i < kScanBlockSize / 32; ++i) {
+      const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i * 32));
+      const auto special =
+          _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, delimiter), _mm256_cmpeq_epi8(chunk, quote)),
+                          _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, line_feed),
+                                                          _mm256_cmpeq_epi8(chunk, carriage_return)),
+                                          _mm256_cmpeq_epi8(chunk, null)));
+      mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(special))) << (i * 32);
+    }
+    return mask;
+#elif defined(__SSE2__)
+    const auto delimiter = _mm_set1_epi8(delimiter_[0]);
+    const auto quote = _mm_set1_epi8(quote_[0]);
+    const auto line_feed = _mm_set1_epi8('\n');
+    const auto carriage_return = _mm_set1_epi8('\r');
+    const auto null = _mm_setzero_si128();
+    uint64_t mask = 0;
+    for (size_t i = 0; i < kScanBlockSize / 16; ++i) {
+      const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16));
+      const auto special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiter), _mm_cmpeq_epi8(chunk, quote)),
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, line_feed), _mm_cmpeq_epi8(chunk, carriage_return)),
+                       _mm_cmpeq_epi8(chunk, null)));
+      mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(special))) << (i * 16);
+    }
+    return mask;
+#endif
+  }
+  // Scalar fallback used for the tail of the buffer and on platforms without
+  // SIMD support. Bytes past the end of the buffer are never marked.
+  uint64_t mask = 0;
+  auto size = std::min(kScanBlockSize, end_ - at);
+  for (size_t i = 0; i < size; ++i) {
+    if (is_special_[data[i]]) mask |= 1UL << i;
+  }
+  return mask;
+}
+
+size_t Tokenizer::NextSpecial(size_t from) {
+  while (from < end_) {
+    if (!mask_valid_ || from < mask_base_ || from >= mask_base_ + kScanBlockSize) {
+      mask_base_ = from;
+      mask_ = ComputeMask(from);
+      mask_valid_ = true;
+    }
+    auto mask = mask_ >> (from - mask_base_);
+    if (mask != 0) return from + __builtin_ctzll(mask);
+    from = mask_base_ + kScanBlockSize;
+  }
+  return end_;
+}
+
+void Tokenizer::CopyRegular(size_t until) {
+  if (write_ != pos_) {
+    std::memmove(buffer_.data() + write_, buffer_.data() + pos_, until - pos_);
+  }
+  write_ += until - pos_;
+  pos_ = until;
+}
+
+void Tokenizer::ConsumeNewline() {
+  ++pos_;
+  ++line_count_;
+  at_line_start_ = true;
+}
+
+void Tokenizer::SkipLine() {
+  while (true) {
+    auto newline = static_cast<const char *>(std::memchr(buffer_.data() + pos_, '\n', end_ - pos_));
+    if (newline != nullptr) {
+      pos_ = newline - buffer_.data();
+      ConsumeNewline();
+      return;
+    }
+    pos_ = end_;
+    row_start_ = pos_;
+    if (!Refill()) return;
+  }
+}
+
+ParseError Tokenizer::MakeError(ParseError::ErrorCode code, std::string message) {
+  SkipLine();
+  row_start_ = pos_;
+  return {code, std::move(message)};
+}
+
+ParseError Tokenizer::NullByteError() {
+  return MakeError(ParseError::ErrorCode::NULL_BYTE, "Line contains NULL byte");
+}
+
+utils::BasicResult<ParseError, bool> Tokenizer::ReadRow(std::vector<std::string_view> *fields) {
+  fields->clear();
+  ranges_.clear();
+  row_start_ = pos_;
+  if (pos_ == end_ && !Refill()) return false;
+
+  auto state = TokenizerState::FIELD_START;
+  bool first_field = true;
+  auto finish_field = [&] { ranges_.push_back({field_begin_, write_ - field_begin_}); };
+
+  bool end_of_row = false;
+  while (!end_of_row) {
+    if (pos_ == end_ && !Refill()) break;
+    auto *data = buffer_.data();
+    switch (state) {
+      case TokenizerState::FIELD_START: {
+        const auto c = data[pos_];
+        if (c == '\r') {
+          ++pos_;
+        } else if (c == '\n') {
+          ConsumeNewline();
+          end_of_row = true;
+        } else if (c == '\0') {
+          return NullByteError();
+        } else if (c == quote_[0] && Matches(pos_, quote_)) {
+          // The current field is a quoted field.
+          pos_ += quote_.size();
+          field_begin_ = write_ = pos_;
+          state = TokenizerState::QUOTED;
+        } else if (c == delimiter_[0] && Matches(pos_, delimiter_)) {
+          // The current field has an empty value.
+          ranges_.push_back({pos_, 0});
+          pos_ += delimiter_.size();
+          first_field = false;
+        } else {
+          // The current field is a regular field.
+          field_begin_ = write_ = pos_;
+          state = TokenizerState::UNQUOTED;
+        }
+        at_line_start_ = at_line_start_ && end_of_row;
+        break;
+      }
+      case TokenizerState::UNQUOTED: {
+        CopyRegular(NextSpecial(pos_));
+        if (pos_ == end_) break;
+        const auto c = data[pos_];
+        if (c == '\r') {
+          if (carriage_returns_ == CarriageReturns::KEEP_IN_UNQUOTED && Ensure(2) && buffer_[pos_ + 1] != '\n') {
+            // A carriage return that doesn't end the line is a regular character.
+            buffer_[write_++] = c;
+          }
+          ++pos_;
+        } else if (c == '\n') {
+          finish_field();
+          ConsumeNewline();
+          end_of_row = true;
+        } else if (c == '\0') {
+          return NullByteError();
+        } else if (c == delimiter_[0] && Matches(pos_, delimiter_)) {
+          finish_field();
+          pos_ += delimiter_.size();
+          first_field = false;
+          state = TokenizerState::FIELD_START;
+        } else {
+          // A quote or a partially matched delimiter is a regular character.
+          buffer_[write_++] = c;
+          ++pos_;
+        }
+        break;
+      }
+      case TokenizerState::QUOTED: {
+        CopyRegular(NextSpecial(pos_));
+        if (pos_ == end_) break;
+        const auto c = data[pos_];
+        if (c == '\r') {
+          ++pos_;
+        } else if (c == '\n') {
+          // Line feeds inside quoted fields are ignored.
+          ConsumeNewline();
+          at_line_start_ = false;
+        } else if (c == '\0') {
+          return NullByteError();
+        } else if (c == quote_[0] && Matches(pos_, quote_)) {
+          if (Matches(pos_ + quote_.size(), quote_)) {
+            // This is an escaped quote character.
+            std::memmove(buffer_.data() + write_, buffer_.data() + pos_, quote_.size());
+            write_ += quote_.size();
+            pos_ += quote_.size() * 2;
+          } else {
+            // This is the end of the quoted field.
+            finish_field();
+            pos_ += quote_.size();
+            state = TokenizerState::AFTER_QUOTE;
+          }
+        } else {
+          buffer_[write_++] = c;
+          ++pos_;
+        }
+        break;
+      }
+      case TokenizerState::AFTER_QUOTE: {
+        const auto c = data[pos_];
+        if (c == '\r') {
+          ++pos_;
+        } else if (c == '\n') {
+          ConsumeNewline();
+          end_of_row = true;
+        } else if (c == '\0') {
+          return NullByteError();
+        } else if (c == delimiter_[0] && Matches(pos_, delimiter_)) {
+          pos_ += delimiter_.size();
+          first_field = false;
+          state = TokenizerState::FIELD_START;
+        } else {
+          return MakeError(ParseError::ErrorCode::UNEXPECTED_TOKEN,
+                           fmt::format("Expected '{}' after '{}', but got '{}'", delimiter_, quote_, c));
+        }
+        break;
+      }
+    }
+  }
+
+  switch (state) {
+    case TokenizerState::FIELD_START:
+      // The row ends with a delimiter so the last field is empty.
+      if (!first_field) ranges_.push_back({pos_, 0});
+      break;
+    case TokenizerState::UNQUOTED:
+      // The end of the file was reached inside the field.
+      if (!end_of_row) finish_field();
+      break;
+    case TokenizerState::QUOTED:
+      return MakeError(ParseError::ErrorCode::NO_CLOSING_QUOTE,
+                       "There is no more data left to load while inside a quoted string. "
+                       "Did you forget to close the quote?");
+    case TokenizerState::AFTER_QUOTE:
+      break;
+  }
+
+  fields->reserve(ranges_.size());
+  for (const auto &range : ranges_) {
+    fields->emplace_back(buffer_.data() + range.begin, range.size);
+  }
+  return true;
+}
+
+}  // namespace memgraph::csv
@@ -0,0 +1,168 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/**
+ * @file
+ *
+ * This file contains the block-based tokenizer that is used to split CSV
+ * files into rows and fields.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/exceptions.hpp"
+#include "utils/result.hpp"
+
+namespace memgraph::csv {
+
+class CsvReadException : public utils::BasicException {
+  using utils::BasicException::BasicException;
+};
+
+struct ParseError {
+  enum class ErrorCode : uint8_t { BAD_HEADER, NO_CLOSING_QUOTE, UNEXPECTED_TOKEN, BAD_NUM_OF_COLUMNS, NULL_BYTE };
+  ParseError(ErrorCode code, std::string message) : code(code), message(std::move(message)) {}
+
+  ErrorCode code;
+  std::string message;
+};
+
+/// Tokenizer that splits a CSV file into rows of fields.
+///
+/// Each CSV field must be divided using the `delimiter` and each CSV field can
+/// either be quoted or unquoted. When the field is quoted, the first and last
+/// character in the field *must* be the quote character. If the field isn't
+/// quoted, and a quote character appears in it, it is treated as a regular
+/// character. If a quote character appears inside a quoted string then the
+/// quote character must be doubled in order to escape it. Line feeds inside
+/// quoted fields and carriage returns are ignored, and the file can't contain
+/// a NULL character. With `CarriageReturns::KEEP_IN_UNQUOTED` a carriage
+/// return inside an unquoted field is kept unless it ends the line, which is
+/// how LOAD CSV has always treated them.
+///
+/// The file is read in large blocks until the end of the file, so it doesn't
+/// have to be a regular file, e.g. it can be a FIFO. The file can also change
+/// while it is read, a file that shrinks just ends earlier. Each block is scanned 64 bytes at a time
+/// for the structural characters (the first character of the delimiter and
+/// the quote, line feeds, carriage returns and NULL bytes) using SIMD
+/// instructions, so the parser only has to look at the bytes that can change
+/// its state. The fields are returned as views into the read buffer. Fields
+/// that contain escaped quotes or ignored characters are unescaped in place,
+/// so no field is ever copied.
+class Tokenizer {
+ public:
+  enum class CarriageReturns : uint8_t { DROP, KEEP_IN_UNQUOTED };
+
+  /// @throw CsvReadException if the file can't be opened or the delimiter or
+  /// quote is empty. The file has to be seekable if `offset` isn't 0.
+  Tokenizer(const std::filesystem::path &path, std::string delimiter, std::string quote, uint64_t offset = 0,
+            CarriageReturns carriage_returns = CarriageReturns::DROP);
+
+  Tokenizer(const Tokenizer &) = delete;
+  Tokenizer &operator=(const Tokenizer &) = delete;
+  Tokenizer(Tokenizer &&) = default;
+  Tokenizer &operator=(Tokenizer &&) = default;
+  ~Tokenizer() = default;
+
+  /// Reads the next row into `fields`. Returns `false` if there are no more
+  /// rows in the file. The views are valid until the next call. If the row
+  /// can't be parsed, the rest of the line on which the error occurred is
+  /// skipped so that the next call starts from the following line.
+  ///
+  /// @throw CsvReadException if the file can't be read.
+  utils::BasicResult<ParseError, bool> ReadRow(std::vector<std::string_view> *fields);
+
+  /// Returns the number of lines that were consumed so far.
+  uint64_t LineCount() const { return line_count_ + (at_line_start_ ? 0 : 1); }
+
+  /// Returns the offset in the file right after the last consumed character.
+  uint64_t Position() const { return buffer_offset_ + pos_; }
+
+ private:
+  struct FieldRange {
+    size_t begin;
+    size_t size;
+  };
+
+  /// Moves the current row to the beginning of the buffer and reads more data
+  /// from the file. Returns `false` if the end of the file was reached.
+  bool Refill();
+
+  /// Returns `true` if at least `size` bytes are available from the current
+  /// position, reading more data if necessary.
+  bool Ensure(size_t size);
+
+  bool Matches(size_t at, std::string_view what);
+
+  /// Returns the position of the first structural character at or after
+  /// `from`, or `end_` if there is none in the buffer.
+  size_t NextSpecial(size_t from);
+
+  /// Returns a bitmask of the structural characters in the 64 bytes starting
+  /// at `at`.
+  uint64_t ComputeMask(size_t at) const;
+
+  /// Appends the characters in [pos_, until) to the current field.
+  void CopyRegular(size_t until);
+
+  void ConsumeNewline();
+
+  void SkipLine();
+
+  /// Skips the rest of the current line and returns the error.
+  ParseError MakeError(ParseError::ErrorCode code, std::string message);
+
+  ParseError NullByteError();
+
+  std::ifstream file_;
+  std::filesystem::path path_;
+  std::string delimiter_;
+  std::string quote_;
+  CarriageReturns carriage_returns_;
+  std::array<bool, 256> is_special_{};
+
+  std::vector<char> buffer_;
+  // Offset in the file of the first byte in the buffer.
+  uint64_t buffer_offset_{0};
+  // Start of the row that is currently being parsed.
+  size_t row_start_{0};
+  // Current read position.
+  size_t pos_{0};
+  // Start of the field that is currently being parsed.
+  size_t field_begin_{0};
+  // Position to which the current field is written when unescaping.
+  size_t write_{0};
+  // End of the valid data in the buffer.
+  size_t end_{0};
+  bool eof_{false};
+
+  // Cached mask of the structural characters for the 64 bytes starting at
+  // `mask_base_`.
+  size_t mask_base_{0};
+  uint64_t mask_{0};
+  bool mask_valid_{false};
+
+  uint64_t line_count_{0};
+  bool at_line_start_{true};
+
+  std::vector<FieldRange> ranges_;
+};
+
+}  // namespace memgraph::csv
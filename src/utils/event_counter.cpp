@@ -24,7 +24,10 @@
   M(ScanAllByLabelPropertyRangeOperator, "Number of times ScanAllByLabelPropertyRange operator was used.") \
   M(ScanAllByLabelPropertyValueOperator, "Number of times ScanAllByLabelPropertyValue operator was used.") \
   M(ScanAllByLabelPropertyOperator, "Number of times ScanAllByLabelProperty operator was used.")           \
+  M(ScanAllByLabelPropertiesOperator, "Number of times ScanAllByLabelProperties operator was used.")       \
   M(ScanAllByIdOperator, "Number of times ScanAllById operator was used.")                                 \
+  M(ScanAllByEdgeTypeOperator, "Number of times ScanAllByEdgeType operator was used.")                     \
+  M(ScanAllByTextOperator, "Number of times ScanAllByText operator was used.")                             \
   M(ExpandOperator, "Number of times Expand operator was used.")                                           \
   M(ExpandVariableOperator, "Number of times ExpandVariable operator was used.")                           \
   M(ConstructNamedPathOperator, "Number of times ConstructNamedPath operator was used.")                   \
@@ -50,14 +53,39 @@
   M(CartesianOperator, "Number of times Cartesian operator was used.")                                     \
   M(CallProcedureOperator, "Number of times CallProcedure operator was used.")                             \
   M(ForeachOperator, "Number of times Foreach operator was used.")                                         \
+  M(PeriodicCommitOperator, "Number of times PeriodicCommit operator was used.")                           \
                                                                                                            \
   M(FailedQuery, "Number of times executing a query failed.")                                              \
   M(LabelIndexCreated, "Number of times a label index was created.")                                       \
   M(LabelPropertyIndexCreated, "Number of times a label property index was created.")                      \
+  M(LabelPropertiesIndexCreated, "Number of times a label properties index was created.")                  \
+  M(EdgeTypeIndexCreated, "Number of times an edge type index was created.")                               \
+  M(TextIndexCreated, "Number of times a text index was created.")                                         \
   M(StreamsCreated, "Number of Streams created.")                                                          \
   M(MessagesConsumed, "Number of consumed streamed messages.")                                             \
+  M(StreamQueriesExecuted, "Number of queries executed by streams.")                                       \
+  M(StreamRowsBatched, "Number of transformation results executed as part of a batched query.")            \
   M(TriggersCreated, "Number of Triggers created.")                                                        \
-  M(TriggersExecuted, "Number of Triggers executed.")
+  M(TriggersExecuted, "Number of Triggers executed.")                                                      \
+  M(PeriodicCommits, "Number of transactions committed by USING PERIODIC COMMIT.")                         \
+                                                                                                           \
+  M(AstCacheHit, "Number of times a parsed query was found in the AST cache.")                             \
+  M(AstCacheMiss, "Number of times a query wasn't found in the AST cache.")                                \
+  M(AstCacheEviction, "Number of parsed queries evicted from the AST cache.")                              \
+  M(PlanCacheHit, "Number of times a query plan was found in the plan cache.")                             \
+  M(PlanCacheMiss, "Number of times a query plan wasn't found in the plan cache.")                         \
+  M(PlanCacheEviction, "Number of query plans evicted from the plan cache.")                               \
+  M(PlanCacheInvalidation, "Number of cached query plans dropped because they expired or became stale.")   \
+                                                                                                           \
+  M(WalBytesWritten, "Number of bytes written to the WAL files.")                                          \
+  M(WalCompressionInputBytes, "Number of WAL bytes compressed when finalizing WAL files.")                 \
+  M(WalCompressionOutputBytes, "Number of bytes the finalized WAL files were compressed into.")            \
+                                                                                                           \
+  M(AuditRecordsDropped, "Number of audit log entries dropped because the buffer was full.")               \
+  M(AuditBufferFullWaits, "Number of times a worker waited for space in the audit log buffer.")            \
+                                                                                                           \
+  M(QueriesQueued, "Number of queries that waited in the queue because their user exceeded the quotas.")   \
+  M(QueriesRejected, "Number of queries rejected by the admission control.")
 
 namespace EventCounter {
 
@@ -0,0 +1,66 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/event_gauge.hpp"
+
+#define APPLY_FOR_GAUGES(M)                                                                                    \
+  M(ActiveBoltSessions, "Number of currently open Bolt sessions.")                                             \
+  M(GarbageCollectionBacklog, "Number of undo buffers waiting for active transactions after the last GC run.")
+
+namespace EventGauge {
+
+// define every Event as an index in the array of gauges
+#define M(NAME, DOCUMENTATION) extern const Event NAME = __COUNTER__;
+APPLY_FOR_GAUGES(M)
+#undef M
+
+inline constexpr Event END = __COUNTER__;
+
+// Initialize array for the global gauges with all values set to 0
+Gauge global_gauges_array[END]{};
+// Initialize global gauges
+EventGauges global_gauges(global_gauges_array);
+
+const Event EventGauges::num_gauges = END;
+
+void EventGauges::Add(const Event event, Value amount) { gauges_[event].fetch_add(amount, std::memory_order_relaxed); }
+
+void EventGauges::Set(const Event event, Value value) { gauges_[event].store(value, std::memory_order_relaxed); }
+
+void IncrementGauge(const Event event, Value amount) { global_gauges.Add(event, amount); }
+
+void DecrementGauge(const Event event, Value amount) { global_gauges.Add(event, -amount); }
+
+void SetGauge(const Event event, Value value) { global_gauges.Set(event, value); }
+
+const char *GetName(const Event event) {
+  static const char *strings[] = {
+#define M(NAME, DOCUMENTATION) #NAME,
+      APPLY_FOR_GAUGES(M)
+#undef M
+  };
+
+  return strings[event];
+}
+
+const char *GetDocumentation(const Event event) {
+  static const char *strings[] = {
+#define M(NAME, DOCUMENTATION) DOCUMENTATION,
+      APPLY_FOR_GAUGES(M)
+#undef M
+  };
+
+  return strings[event];
+}
+
+Event End() { return END; }
+
+}  // namespace EventGauge
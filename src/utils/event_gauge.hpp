@@ -0,0 +1,50 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace EventGauge {
+using Event = uint64_t;
+using Value = int64_t;
+using Gauge = std::atomic<Value>;
+
+class EventGauges {
+ public:
+  explicit EventGauges(Gauge *allocated_gauges) noexcept : gauges_(allocated_gauges) {}
+
+  auto &operator[](const Event event) { return gauges_[event]; }
+
+  const auto &operator[](const Event event) const { return gauges_[event]; }
+
+  void Add(Event event, Value amount);
+
+  void Set(Event event, Value value);
+
+  static const Event num_gauges;
+
+ private:
+  Gauge *gauges_;
+};
+
+extern EventGauges global_gauges;
+
+void IncrementGauge(Event event, Value amount = 1);
+void DecrementGauge(Event event, Value amount = 1);
+void SetGauge(Event event, Value value);
+
+const char *GetName(Event event);
+const char *GetDocumentation(Event event);
+
+Event End();
+
+}  // namespace EventGauge
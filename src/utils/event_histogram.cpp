@@ -0,0 +1,75 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/event_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#define APPLY_FOR_HISTOGRAMS(M)                                                               \
+  M(QueryParseLatency, "Time spent parsing queries.")                                         \
+  M(QueryPlanLatency, "Time spent preparing queries after parsing them, including planning.") \
+  M(QueryPullLatency, "Time spent executing queries in a single pull.")                       \
+  M(CommitLatency, "Time spent committing transactions in the storage.")                      \
+  M(GarbageCollectionLatency, "Time spent collecting garbage in the storage.")                \
+  M(WalAppendLatency, "Time spent appending committed transactions to the WAL.")              \
+  M(WalFsyncLatency, "Time spent waiting for the WAL files to be synced to the disk.")        \
+  M(QueryQueueWaitLatency, "Time queries spent waiting in the admission control queue.")
+
+namespace EventHistogram {
+
+// define every Event as an index in the array of histograms
+#define M(NAME, DOCUMENTATION) extern const Event NAME = __COUNTER__;
+APPLY_FOR_HISTOGRAMS(M)
+#undef M
+
+inline constexpr Event END = __COUNTER__;
+
+// Initialize array for the global histograms with all values set to 0
+Histogram global_histograms_array[END]{};
+// Initialize global histograms
+EventHistograms global_histograms(global_histograms_array);
+
+const Event EventHistograms::num_histograms = END;
+
+void Histogram::Measure(const uint64_t microseconds) {
+  // The index of the smallest bound that isn't smaller than the value.
+  const auto bucket = std::min<size_t>(microseconds <= 1 ? 0 : std::bit_width(microseconds - 1), kNumBounds);
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(microseconds, std::memory_order_relaxed);
+}
+
+void Measure(const Event event, const uint64_t microseconds) { global_histograms[event].Measure(microseconds); }
+
+const char *GetName(const Event event) {
+  static const char *strings[] = {
+#define M(NAME, DOCUMENTATION) #NAME,
+      APPLY_FOR_HISTOGRAMS(M)
+#undef M
+  };
+
+  return strings[event];
+}
+
+const char *GetDocumentation(const Event event) {
+  static const char *strings[] = {
+#define M(NAME, DOCUMENTATION) DOCUMENTATION,
+      APPLY_FOR_HISTOGRAMS(M)
+#undef M
+  };
+
+  return strings[event];
+}
+
+Event End() { return END; }
+
+}  // namespace EventHistogram
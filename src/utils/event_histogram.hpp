@@ -0,0 +1,95 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace EventHistogram {
+using Event = uint64_t;
+using Count = uint64_t;
+
+/// Lock-free histogram of latencies measured in microseconds. Bucket `i`
+/// counts the measurements that are greater than 2^(i-1) and at most 2^i
+/// microseconds, the last bucket counts everything above the largest bound.
+/// Measuring a value is a few relaxed atomic increments, so histograms can be
+/// used on hot paths.
+class Histogram {
+ public:
+  // The largest bound is 2^25 microseconds (~33.5 seconds).
+  static constexpr size_t kNumBounds = 26;
+
+  void Measure(uint64_t microseconds);
+
+  /// Returns the upper bound of the bucket in microseconds.
+  static constexpr uint64_t UpperBound(size_t bucket) { return uint64_t{1} << bucket; }
+
+  /// Returns the number of measurements in the bucket. The bucket with index
+  /// `kNumBounds` has no upper bound.
+  Count BucketCount(size_t bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+
+  Count TotalCount() const { return count_.load(std::memory_order_relaxed); }
+
+  /// Returns the sum of all measurements in microseconds.
+  uint64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+
+ private:
+  std::array<std::atomic<Count>, kNumBounds + 1> buckets_{};
+  std::atomic<Count> count_{0};
+  std::atomic<uint64_t> sum_{0};
+};
+
+class EventHistograms {
+ public:
+  explicit EventHistograms(Histogram *allocated_histograms) noexcept : histograms_(allocated_histograms) {}
+
+  auto &operator[](const Event event) { return histograms_[event]; }
+
+  const auto &operator[](const Event event) const { return histograms_[event]; }
+
+  static const Event num_histograms;
+
+ private:
+  Histogram *histograms_;
+};
+
+extern EventHistograms global_histograms;
+
+void Measure(Event event, uint64_t microseconds);
+
+/// Measures the time from construction until destruction.
+class ScopedMeasure {
+ public:
+  explicit ScopedMeasure(Event event) : event_(event), start_(std::chrono::steady_clock::now()) {}
+
+  ScopedMeasure(const ScopedMeasure &) = delete;
+  ScopedMeasure &operator=(const ScopedMeasure &) = delete;
+  ScopedMeasure(ScopedMeasure &&) = delete;
+  ScopedMeasure &operator=(ScopedMeasure &&) = delete;
+
+  ~ScopedMeasure() {
+    Measure(event_, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_)
+                        .count());
+  }
+
+ private:
+  Event event_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+const char *GetName(Event event);
+const char *GetDocumentation(Event event);
+
+Event End();
+
+}  // namespace EventHistogram
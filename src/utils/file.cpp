@@ -292,10 +292,20 @@ OutputFile::~OutputFile() {
   if (IsOpen()) Close();
 }
 
+namespace {
+// The ring holds at most a write and a sync at any time.
+constexpr uint32_t kIoUringEntries = 4;
+constexpr uint64_t kIoUringWrite = 1;
+constexpr uint64_t kIoUringSync = 2;
+}  // namespace
+
 OutputFile::OutputFile(OutputFile &&other) noexcept
     : fd_(other.fd_), written_since_last_sync_(other.written_since_last_sync_), path_(std::move(other.path_)) {
   memcpy(buffer_, other.buffer_, kFileBufferSize);
   buffer_position_.store(other.buffer_position_.load());
+  // The registered buffer belongs to the other object.
+  ring_ = std::move(other.ring_);
+  if (ring_ && !ring_->RegisterBuffer(buffer_, kFileBufferSize)) ring_.reset();
   other.fd_ = -1;
   other.written_since_last_sync_ = 0;
   other.buffer_position_ = 0;
@@ -309,6 +319,8 @@ OutputFile &OutputFile::operator=(OutputFile &&other) noexcept {
   path_ = std::move(other.path_);
   buffer_position_ = other.buffer_position_.load();
   memcpy(buffer_, other.buffer_, kFileBufferSize);
+  ring_ = std::move(other.ring_);
+  if (ring_ && !ring_->RegisterBuffer(buffer_, kFileBufferSize)) ring_.reset();
 
   other.fd_ = -1;
   other.written_since_last_sync_ = 0;
@@ -317,7 +329,7 @@ OutputFile &OutputFile::operator=(OutputFile &&other) noexcept {
   return *this;
 }
 
-void OutputFile::Open(const std::filesystem::path &path, Mode mode) {
+void OutputFile::Open(const std::filesystem::path &path, Mode mode, IoBackend backend) {
   MG_ASSERT(!IsOpen(),
             "While trying to open {} for writing the database"
             " used a handle that already has {} opened in it!",
@@ -342,6 +354,17 @@ void OutputFile::Open(const std::filesystem::path &path, Mode mode) {
   }
 
   MG_ASSERT(fd_ != -1, "While trying to open {} for writing an error occured: {} ({})", path_, strerror(errno), errno);
+
+  if (backend == IoBackend::IO_URING) {
+    ring_ = std::make_unique<IoUring>();
+    if (!ring_->Setup(kIoUringEntries) || !ring_->RegisterBuffer(buffer_, kFileBufferSize)) {
+      ring_.reset();
+      static std::once_flag warn_once;
+      std::call_once(warn_once, [] {
+        spdlog::warn("io_uring isn't available, durability files will be written using regular system calls.");
+      });
+    }
+  }
 }
 
 bool OutputFile::IsOpen() const { return fd_ != -1; }
@@ -426,6 +449,13 @@ bool OutputFile::AcquireLock() {
 }
 
 void OutputFile::Sync() {
+  if (ring_) {
+    MG_ASSERT(IsOpen(), "Syncing an unopened file.");
+    std::unique_lock flush_guard(flush_lock_);
+    FlushBufferWithRing(true);
+    return;
+  }
+
   FlushBuffer(true);
 
   int ret = 0;
@@ -497,6 +527,7 @@ void OutputFile::Close() noexcept {
   fd_ = -1;
   written_since_last_sync_ = 0;
   path_ = "";
+  ring_.reset();
 }
 
 void OutputFile::FlushBuffer(bool force_flush) {
@@ -514,6 +545,11 @@ void OutputFile::FlushBufferInternal() {
             "buffer than the buffer has space!",
             path_);
 
+  if (ring_) {
+    FlushBufferWithRing(false);
+    return;
+  }
+
   auto *buffer = buffer_;
   auto buffer_position = buffer_position_.load();
   while (buffer_position > 0) {
@@ -535,6 +571,57 @@ void OutputFile::FlushBufferInternal() {
   buffer_position_.store(buffer_position);
 }
 
+void OutputFile::FlushBufferWithRing(bool sync) {
+  const auto *buffer = buffer_;
+  auto buffer_position = buffer_position_.load();
+  bool synced = false;
+  while (buffer_position > 0 || (sync && !synced)) {
+    // The sync is linked to the write so it starts only after the whole
+    // buffer was written. If the write is short the sync is canceled and
+    // both are submitted again for the rest of the buffer.
+    uint32_t submitted = 0;
+    if (buffer_position > 0) {
+      MG_ASSERT(ring_->PrepareWrite(fd_, buffer, buffer_position, kIoUringWrite, /* link = */ sync),
+                "The io_uring of {} is full!", path_);
+      ++submitted;
+    }
+    if (sync) {
+      MG_ASSERT(ring_->PrepareDataSync(fd_, kIoUringSync), "The io_uring of {} is full!", path_);
+      ++submitted;
+    }
+    auto ret = ring_->Submit(submitted);
+    MG_ASSERT(ret == 0, "While trying to write to {} an error occurred: {} ({}).", path_, strerror(-ret), -ret);
+
+    io_uring_cqe cqe{};
+    for (uint32_t i = 0; i < submitted; ++i) {
+      MG_ASSERT(ring_->PopCompletion(&cqe), "Missing io_uring completion while writing to {}!", path_);
+      if (cqe.user_data == kIoUringWrite) {
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) continue;
+        MG_ASSERT(cqe.res > 0,
+                  "while trying to write to {} an error occurred: {} ({}). "
+                  "Possibly {} bytes of data were lost from this call and "
+                  "possibly {} bytes were lost from previous calls.",
+                  path_, strerror(-cqe.res), -cqe.res, buffer_position, written_since_last_sync_);
+        buffer_position -= cqe.res;
+        buffer += cqe.res;
+      } else {
+        if (cqe.res == -ECANCELED || cqe.res == -EINTR) continue;
+        // Any other error is fatal for the same reasons that are described in
+        // `Sync`.
+        MG_ASSERT(cqe.res == 0,
+                  "While trying to sync {}, an error occurred: {} ({}). Possibly {} "
+                  "bytes from previous write calls were lost.",
+                  path_, strerror(-cqe.res), -cqe.res, written_since_last_sync_);
+        synced = true;
+        // Reset the counter.
+        written_since_last_sync_ = 0;
+      }
+    }
+  }
+
+  buffer_position_.store(buffer_position);
+}
+
 void OutputFile::DisableFlushing() { flush_lock_.lock_shared(); }
 
 void OutputFile::EnableFlushing() {
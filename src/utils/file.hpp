@@ -19,11 +19,13 @@
 
 #include <atomic>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "utils/io_uring.hpp"
 #include "utils/rw_lock.hpp"
 
 namespace memgraph::utils {
@@ -84,6 +86,15 @@ class InputFile {
     RELATIVE_TO_END,
   };
 
+  /// Controls how the buffered data is written and synced to the file. With
+  /// `IO_URING` the internal buffer is registered with a per-file io_uring and
+  /// `Sync` submits the write of the buffer linked with an `fdatasync` in a
+  /// single system call.
+  enum class IoBackend {
+    SYSCALL,
+    IO_URING,
+  };
+
   InputFile() = default;
   ~InputFile();
 
@@ -182,6 +193,15 @@ class OutputFile {
     RELATIVE_TO_END,
   };
 
+  /// Controls how the buffered data is written and synced to the file. With
+  /// `IO_URING` the internal buffer is registered with a per-file io_uring and
+  /// `Sync` submits the write of the buffer linked with an `fdatasync` in a
+  /// single system call.
+  enum class IoBackend {
+    SYSCALL,
+    IO_URING,
+  };
+
   OutputFile() = default;
   ~OutputFile();
 
@@ -194,9 +214,10 @@ class OutputFile {
   /// This method opens a new file used for writing. If the file doesn't exist
   /// it is created. The `mode` flags controls whether data is appended to the
   /// file or the file is wiped on first write. Files are created with a
-  /// restrictive permission mask (0640). On failure and misuse it crashes the
-  /// program.
-  void Open(const std::filesystem::path &path, Mode mode);
+  /// restrictive permission mask (0640). If `backend` is `IO_URING` but
+  /// io_uring isn't available, the file is written with regular system calls.
+  /// On failure and misuse it crashes the program.
+  void Open(const std::filesystem::path &path, Mode mode, IoBackend backend = IoBackend::SYSCALL);
 
   /// Returns a boolean indicating whether a file is opened.
   bool IsOpen() const;
@@ -256,6 +277,9 @@ class OutputFile {
  private:
   void FlushBuffer(bool force_flush);
   void FlushBufferInternal();
+  /// Writes the internal buffer through the io_uring and, if `sync` is
+  /// `true`, syncs the file in the same submission.
+  void FlushBufferWithRing(bool sync);
 
   size_t SeekFile(Position position, ssize_t offset);
 
@@ -264,6 +288,8 @@ class OutputFile {
   std::filesystem::path path_;
   uint8_t buffer_[kFileBufferSize];
   std::atomic<size_t> buffer_position_{0};
+  // Set only if the file is written through io_uring.
+  std::unique_ptr<IoUring> ring_;
 
   // Flushing buffer should be a higher priority
   utils::RWLock flush_lock_{RWLock::Priority::WRITE};
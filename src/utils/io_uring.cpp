@@ -0,0 +1,168 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "utils/io_uring.hpp"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+namespace memgraph::utils {
+
+namespace {
+
+uint32_t LoadAcquire(uint32_t *value) { return std::atomic_ref<uint32_t>(*value).load(std::memory_order_acquire); }
+
+void StoreRelease(uint32_t *value, uint32_t new_value) {
+  std::atomic_ref<uint32_t>(*value).store(new_value, std::memory_order_release);
+}
+
+}  // namespace
+
+IoUring::~IoUring() {
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  // Closing the ring also unregisters the buffer.
+  if (fd_ != -1) close(fd_);
+}
+
+bool IoUring::Setup(uint32_t entries) {
+  io_uring_params params{};
+  fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+  if (fd_ == -1) return false;
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) return false;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  auto *sq_ring =
+      mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) return false;
+  sq_ring_ = static_cast<uint8_t *>(sq_ring);
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    auto *cq_ring =
+        mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) return false;
+    cq_ring_ = static_cast<uint8_t *>(cq_ring);
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  auto *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) return false;
+  sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+  sq_head_ = reinterpret_cast<uint32_t *>(sq_ring_ + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t *>(sq_ring_ + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t *>(sq_ring_ + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_array_ = reinterpret_cast<uint32_t *>(sq_ring_ + params.sq_off.array);
+  sq_local_tail_ = *sq_tail_;
+
+  cq_head_ = reinterpret_cast<uint32_t *>(cq_ring_ + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t *>(cq_ring_ + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t *>(cq_ring_ + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe *>(cq_ring_ + params.cq_off.cqes);
+
+  return true;
+}
+
+bool IoUring::RegisterBuffer(uint8_t *data, size_t size) {
+  if (buffer_ != nullptr) {
+    syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    buffer_ = nullptr;
+    buffer_size_ = 0;
+  }
+  iovec iov{.iov_base = data, .iov_len = size};
+  if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, &iov, 1) != 0) return false;
+  buffer_ = data;
+  buffer_size_ = size;
+  return true;
+}
+
+io_uring_sqe *IoUring::NextSqe() {
+  if (sq_local_tail_ - LoadAcquire(sq_head_) >= sq_entries_) return nullptr;
+  auto index = sq_local_tail_ & sq_mask_;
+  sq_array_[index] = index;
+  ++sq_local_tail_;
+  auto *sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(io_uring_sqe));
+  return sqe;
+}
+
+bool IoUring::PrepareWrite(int fd, const uint8_t *data, size_t size, uint64_t user_data, bool link) {
+  auto *sqe = NextSqe();
+  if (sqe == nullptr) return false;
+  const bool fixed = buffer_ != nullptr && data >= buffer_ && data + size <= buffer_ + buffer_size_;
+  sqe->opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  sqe->fd = fd;
+  // Offset -1 writes at (and advances) the current file position, the same as
+  // `write` does.
+  sqe->off = static_cast<uint64_t>(-1);
+  sqe->addr = reinterpret_cast<uint64_t>(data);
+  sqe->len = static_cast<uint32_t>(size);
+  sqe->buf_index = 0;
+  sqe->flags = link ? IOSQE_IO_LINK : 0;
+  sqe->user_data = user_data;
+  return true;
+}
+
+bool IoUring::PrepareDataSync(int fd, uint64_t user_data) {
+  auto *sqe = NextSqe();
+  if (sqe == nullptr) return false;
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->fd = fd;
+  sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  sqe->user_data = user_data;
+  return true;
+}
+
+int IoUring::Submit(uint32_t wait_nr) {
+  StoreRelease(sq_tail_, sq_local_tail_);
+  auto to_submit = sq_local_tail_ - LoadAcquire(sq_head_);
+  while (true) {
+    auto ret = syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr, wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0,
+                       nullptr, 0);
+    if (ret == -1) {
+      // The call was interrupted, try again...
+      if (errno == EINTR) continue;
+      return -errno;
+    }
+    if (static_cast<uint32_t>(ret) >= to_submit) return 0;
+    // Some operations weren't consumed, the remaining ones are submitted
+    // again.
+    to_submit -= static_cast<uint32_t>(ret);
+  }
+}
+
+bool IoUring::PopCompletion(io_uring_cqe *cqe) {
+  auto head = *cq_head_;
+  if (head == LoadAcquire(cq_tail_)) return false;
+  *cqe = cqes_[head & cq_mask_];
+  StoreRelease(cq_head_, head + 1);
+  return true;
+}
+
+}  // namespace memgraph::utils
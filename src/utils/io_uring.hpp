@@ -0,0 +1,99 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#pragma once
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace memgraph::utils {
+
+/// Minimal wrapper around a Linux io_uring instance, implemented directly on
+/// top of the `io_uring_setup`, `io_uring_enter` and `io_uring_register`
+/// system calls.
+///
+/// Operations are prepared by filling in the entries returned by
+/// `PrepareWrite` and `PrepareDataSync`, then all prepared entries are handed
+/// to the kernel with a single `Submit` call. The ring isn't thread safe.
+class IoUring {
+ public:
+  IoUring() = default;
+  ~IoUring();
+
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+  IoUring(IoUring &&) = delete;
+  IoUring &operator=(IoUring &&) = delete;
+
+  /// Sets up a ring with at least `entries` submission queue entries. Returns
+  /// `false` if io_uring isn't available (old kernel, disabled by the
+  /// administrator or by a seccomp filter) or if the kernel can't write at the
+  /// current file position, in which case the ring can't be used.
+  bool Setup(uint32_t entries);
+
+  /// Registers `data` as the only fixed buffer of the ring, replacing the
+  /// previously registered one. Writes from the fixed buffer avoid mapping
+  /// the user pages on every operation. Returns `false` if the buffer can't
+  /// be registered (e.g. because of `RLIMIT_MEMLOCK`).
+  bool RegisterBuffer(uint8_t *data, size_t size);
+
+  /// Prepares a write of `size` bytes from `data` to `fd` at the current file
+  /// position. If `data` is inside the registered buffer, the fixed buffer is
+  /// used. If `link` is `true` the next prepared operation starts only after
+  /// this one succeeds completely. Returns `false` if the submission queue is
+  /// full.
+  bool PrepareWrite(int fd, const uint8_t *data, size_t size, uint64_t user_data, bool link = false);
+
+  /// Prepares an `fdatasync` of `fd`. Returns `false` if the submission queue
+  /// is full.
+  bool PrepareDataSync(int fd, uint64_t user_data);
+
+  /// Submits all prepared operations and waits until at least `wait_nr` of
+  /// them complete. Returns 0 on success or a negative errno value.
+  int Submit(uint32_t wait_nr);
+
+  /// Pops the next completion into `cqe`. Returns `false` if there are no
+  /// completions.
+  bool PopCompletion(io_uring_cqe *cqe);
+
+ private:
+  io_uring_sqe *NextSqe();
+
+  int fd_{-1};
+
+  uint8_t *sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  uint8_t *cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  io_uring_sqe *sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  uint32_t *sq_head_{nullptr};
+  uint32_t *sq_tail_{nullptr};
+  uint32_t sq_mask_{0};
+  uint32_t sq_entries_{0};
+  uint32_t *sq_array_{nullptr};
+  // Tail including the prepared entries that weren't submitted yet.
+  uint32_t sq_local_tail_{0};
+
+  uint32_t *cq_head_{nullptr};
+  uint32_t *cq_tail_{nullptr};
+  uint32_t cq_mask_{0};
+  io_uring_cqe *cqes_{nullptr};
+
+  const uint8_t *buffer_{nullptr};
+  size_t buffer_size_{0};
+};
+
+}  // namespace memgraph::utils
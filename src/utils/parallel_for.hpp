@@ -0,0 +1,61 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace memgraph::utils {
+
+/// Calls `func` for every index in [0, count) using up to `thread_count`
+/// threads. The indices are handed out dynamically, so uneven amounts of work
+/// per index are balanced between the threads. The first exception thrown by
+/// `func` stops the remaining work and is rethrown after all threads finish.
+template <typename TFunc>
+void ParallelFor(uint64_t count, uint64_t thread_count, const TFunc &func) {
+  thread_count = std::min(thread_count, count);
+  if (thread_count <= 1) {
+    for (uint64_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<uint64_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr exception;
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (uint64_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&] {
+      while (!failed.load(std::memory_order_acquire)) {
+        auto index = next.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= count) break;
+        try {
+          func(index);
+        } catch (...) {
+          if (!failed.exchange(true, std::memory_order_acq_rel)) exception = std::current_exception();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (exception) std::rethrow_exception(exception);
+}
+
+}  // namespace memgraph::utils
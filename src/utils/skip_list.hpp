@@ -169,10 +169,13 @@ constexpr uint64_t SkipListLayerForAverageEqualsEstimation(const uint64_t N) {
 /// collection is blocking is when the structure of the doubly-linked list has
 /// to be changed (eg. a new Block has to be allocated and linked into the
 /// structure).
-template <typename TObj>
+///
+/// The GC is also used by other containers that need the same reclamation
+/// scheme (e.g. `BTree`). The collected node type is then passed as `TNode` and
+/// a `SkipListNodeSize` overload for it must be visible through ADL.
+template <typename TObj, typename TNode = SkipListNode<TObj>>
 class SkipListGc final {
  private:
-  using TNode = SkipListNode<TObj>;
   using TDeleted = std::pair<uint64_t, TNode *>;
   using TStack = Stack<TDeleted, kSkipListGcStackSize>;
 
@@ -274,12 +277,20 @@ class SkipListGc final {
     deleted_.Push({accessor_id_.load(std::memory_order_acquire), node});
   }
 
-  void Run() {
+  /// Returns the ID that the next accessor will get. Memory that is unlinked
+  /// before the call is unreachable once all accessors with smaller IDs are
+  /// released.
+  uint64_t NextId() const { return accessor_id_.load(std::memory_order_acquire); }
+
+  /// Frees the collected nodes that can't be reached by any accessor anymore.
+  /// Returns the largest ID such that it and all smaller IDs are released, or
+  /// 0 if that isn't known (e.g. the GC is already running in another thread).
+  uint64_t Run() {
     // This method can be called after any skip list method, including the add method
     // which could have OOMException enabled in its thread so to ensure no exception
     // is thrown while cleaning the skip list, we add the blocker.
     utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_blocker;
-    if (!lock_.try_lock()) return;
+    if (!lock_.try_lock()) return 0;
     OnScopeExit cleanup([&] { lock_.unlock(); });
     Block *tail = tail_.load(std::memory_order_acquire);
     uint64_t last_dead = 0;
@@ -340,6 +351,7 @@ class SkipListGc final {
     while ((item = leftover.Pop())) {
       deleted_.Push(*item);
     }
+    return last_dead;
   }
 
   MemoryResource *GetMemoryResource() const { return memory_; }
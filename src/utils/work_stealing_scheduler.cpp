@@ -0,0 +1,338 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include "utils/work_stealing_scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "utils/logging.hpp"
+#include "utils/thread.hpp"
+
+namespace memgraph::utils {
+
+namespace {
+// Reading the clock on every checkpoint would be too expensive for operators
+// that call it for every row, so it is read only on every n-th call.
+constexpr uint32_t kCheckpointClockInterval = 64;
+}  // namespace
+
+thread_local WorkStealingScheduler::TaskState *WorkStealingScheduler::current_task_{nullptr};
+
+WorkStealingScheduler::WorkStealingScheduler(size_t workers_count, size_t max_long_tasks,
+                                             std::chrono::microseconds long_task_threshold, std::string name)
+    : max_long_tasks_(max_long_tasks), long_task_threshold_(long_task_threshold), name_(std::move(name)) {
+  MG_ASSERT(workers_count > 0, "The scheduler needs at least one worker!");
+  MG_ASSERT(max_long_tasks > 0, "The scheduler needs to allow at least one long task!");
+  slots_.reserve(workers_count);
+  std::unique_lock guard(mutex_);
+  for (size_t i = 0; i < workers_count; ++i) {
+    slots_.push_back(std::make_unique<Slot>());
+    free_slots_.push_back(workers_count - i - 1);
+    SpawnThread();
+  }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() { Shutdown(); }
+
+void WorkStealingScheduler::Schedule(std::function<void()> task) {
+  auto slot = next_slot_.fetch_add(1, std::memory_order_relaxed) % slots_.size();
+  unfinished_tasks_.fetch_add(1, std::memory_order_acq_rel);
+  {
+    std::lock_guard slot_guard(slots_[slot]->lock);
+    slots_[slot]->tasks.push_back(std::move(task));
+    queued_tasks_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  // The workers check `queued_tasks_` while holding `mutex_`, so taking it
+  // here guarantees that the notification isn't missed.
+  { std::lock_guard guard(mutex_); }
+  task_cv_.notify_one();
+}
+
+void WorkStealingScheduler::Checkpoint() noexcept {
+  auto *state = current_task_;
+  if (state == nullptr || state->task_class == TaskClass::LONG || state->parked) return;
+  if (++state->checkpoints % kCheckpointClockInterval != 0) return;
+  if (std::chrono::steady_clock::now() - state->start < state->scheduler->long_task_threshold_) return;
+  try {
+    state->scheduler->Demote(state);
+  } catch (const std::exception &e) {
+    // The task keeps its slot and the demotion is retried on the next check.
+    spdlog::warn("Couldn't move a task of the {} scheduler to the long tasks: {}", state->scheduler->name_, e.what());
+  }
+}
+
+bool WorkStealingScheduler::Park() noexcept {
+  auto *state = current_task_;
+  if (state == nullptr || state->task_class == TaskClass::LONG || state->parked) return true;
+  try {
+    state->scheduler->ParkTask(state);
+  } catch (const std::exception &e) {
+    spdlog::warn("Couldn't park a task of the {} scheduler: {}", state->scheduler->name_, e.what());
+  }
+  return state->parked;
+}
+
+void WorkStealingScheduler::Unpark() noexcept {
+  auto *state = current_task_;
+  if (state == nullptr || !state->parked) return;
+  state->scheduler->UnparkTask(state);
+}
+
+TaskClass WorkStealingScheduler::CurrentTaskClass() noexcept {
+  return current_task_ == nullptr ? TaskClass::SHORT : current_task_->task_class;
+}
+
+void WorkStealingScheduler::Shutdown() {
+  std::vector<std::thread> threads;
+  {
+    std::unique_lock guard(mutex_);
+    stop_ = true;
+    threads = std::move(threads_);
+    threads_.clear();
+  }
+  task_cv_.notify_all();
+  slot_cv_.notify_all();
+  long_cv_.notify_all();
+  resume_cv_.notify_all();
+
+  for (auto &thread : threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  {
+    std::unique_lock guard(mutex_);
+    exited_threads_.clear();
+  }
+
+  for (auto &slot : slots_) {
+    std::lock_guard slot_guard(slot->lock);
+    unfinished_tasks_.fetch_sub(slot->tasks.size(), std::memory_order_acq_rel);
+    queued_tasks_.fetch_sub(slot->tasks.size(), std::memory_order_acq_rel);
+    slot->tasks.clear();
+  }
+}
+
+size_t WorkStealingScheduler::ThreadsNum() const {
+  std::unique_lock guard(mutex_);
+  return ThreadsNumLocked();
+}
+
+size_t WorkStealingScheduler::WaitingTasksNum() const {
+  std::unique_lock guard(mutex_);
+  return waiting_tasks_;
+}
+
+size_t WorkStealingScheduler::ParkedTasksNum() const {
+  std::unique_lock guard(mutex_);
+  return parked_tasks_;
+}
+
+size_t WorkStealingScheduler::ThreadsNumLocked() const { return threads_.size() - exited_threads_.size(); }
+
+void WorkStealingScheduler::ThreadLoop() {
+  while (true) {
+    size_t slot = 0;
+    {
+      // The thread was counted as idle either when it was spawned or when it
+      // finished its long task.
+      std::unique_lock guard(mutex_);
+      slot_cv_.wait(guard, [this] { return stop_ || !free_slots_.empty(); });
+      --idle_threads_;
+      if (stop_) return;
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    const auto exit = RunWorker(slot);
+    if (exit == WorkerExit::STOPPED) return;
+
+    std::unique_lock guard(mutex_);
+    if (exit == WorkerExit::LONG_TASK) {
+      long_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+      if (waiting_tasks_ > 0) {
+        long_cv_.notify_one();
+      }
+    }
+    // The slot was handed over when the task was demoted or to the parked
+    // task. The thread stays only if a free slot doesn't have a thread that
+    // will take it over.
+    if (stop_ || free_slots_.size() <= idle_threads_) {
+      exited_threads_.push_back(std::this_thread::get_id());
+      return;
+    }
+    ++idle_threads_;
+  }
+}
+
+WorkStealingScheduler::WorkerExit WorkStealingScheduler::RunWorker(size_t slot) {
+  while (true) {
+    // The parked tasks that resume already started, so they get the slot
+    // before the queued tasks.
+    if (resuming_tasks_.load(std::memory_order_acquire) > 0 && HandOverSlot(slot)) {
+      return WorkerExit::HANDED_OVER;
+    }
+    auto task = PopTask(slot);
+    if (!task) {
+      std::unique_lock guard(mutex_);
+      task_cv_.wait(guard, [this] {
+        return stop_ || queued_tasks_.load(std::memory_order_acquire) > 0 ||
+               resuming_tasks_.load(std::memory_order_acquire) > handed_over_slots_.size();
+      });
+      if (stop_) return WorkerExit::STOPPED;
+      continue;
+    }
+
+    TaskState state{.scheduler = this, .slot = slot, .start = std::chrono::steady_clock::now()};
+    current_task_ = &state;
+    try {
+      task();
+    } catch (const std::exception &e) {
+      spdlog::error("A task of the {} scheduler failed: {}", name_, e.what());
+    }
+    current_task_ = nullptr;
+    unfinished_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+
+    if (state.task_class == TaskClass::LONG) return WorkerExit::LONG_TASK;
+    // The task didn't get a slot back only on shutdown.
+    if (state.parked) return WorkerExit::STOPPED;
+    // The task could have got a different slot back after it was parked.
+    slot = state.slot;
+  }
+}
+
+bool WorkStealingScheduler::HandOverSlot(const size_t slot) {
+  {
+    std::unique_lock guard(mutex_);
+    if (stop_ || resuming_tasks_.load(std::memory_order_acquire) <= handed_over_slots_.size()) return false;
+    handed_over_slots_.push_back(slot);
+  }
+  resume_cv_.notify_one();
+  return true;
+}
+
+std::function<void()> WorkStealingScheduler::PopTask(const size_t slot) {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    auto &candidate = *slots_[(slot + i) % slots_.size()];
+    std::lock_guard slot_guard(candidate.lock);
+    if (candidate.tasks.empty()) continue;
+    auto task = std::move(candidate.tasks.front());
+    candidate.tasks.pop_front();
+    queued_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+    return task;
+  }
+  return nullptr;
+}
+
+void WorkStealingScheduler::Demote(TaskState *state) {
+  {
+    std::unique_lock guard(mutex_);
+    if (stop_) return;
+    const bool limit_reached = long_tasks_.load(std::memory_order_acquire) >= max_long_tasks_;
+    // Every free slot needs a thread that will take it over. The thread is
+    // spawned before anything is changed, so a failure leaves the task as is.
+    // The threads of the waiting and parked tasks don't run, so they aren't
+    // counted against the cap. If all threads are already spawned, the slot is
+    // taken over by the next thread whose long task finishes.
+    const auto max_threads =
+        slots_.size() + max_long_tasks_ + waiting_tasks_ + parked_tasks_ + (limit_reached ? 1 : 0);
+    if (free_slots_.size() + 1 > idle_threads_ && ThreadsNumLocked() < max_threads) {
+      SpawnThread();
+    }
+    free_slots_.push_back(state->slot);
+    if (limit_reached) {
+      // The task doesn't run until a long task finishes, so the short tasks
+      // keep the slot and the long ones can't use more than
+      // `max_long_tasks_` workers.
+      ++waiting_tasks_;
+      slot_cv_.notify_one();
+      long_cv_.wait(guard,
+                    [this] { return stop_ || long_tasks_.load(std::memory_order_acquire) < max_long_tasks_; });
+      --waiting_tasks_;
+    }
+    // The limit is exceeded only on shutdown, so that the thread finishes the
+    // task the same way as the other long tasks.
+    long_tasks_.fetch_add(1, std::memory_order_acq_rel);
+    state->task_class = TaskClass::LONG;
+  }
+  slot_cv_.notify_one();
+  // The slot could have been left without a thread because of the cap, then
+  // a resuming parked task takes it.
+  if (resuming_tasks_.load(std::memory_order_acquire) > 0) {
+    resume_cv_.notify_all();
+  }
+}
+
+void WorkStealingScheduler::ParkTask(TaskState *state) {
+  {
+    std::unique_lock guard(mutex_);
+    if (stop_) return;
+    // The parked task doesn't run, so the thread for its slot is spawned
+    // regardless of the cap.
+    if (free_slots_.size() + 1 > idle_threads_) {
+      SpawnThread();
+    }
+    free_slots_.push_back(state->slot);
+    ++parked_tasks_;
+    state->parked = true;
+  }
+  slot_cv_.notify_one();
+}
+
+void WorkStealingScheduler::UnparkTask(TaskState *state) {
+  std::unique_lock guard(mutex_);
+  resuming_tasks_.fetch_add(1, std::memory_order_acq_rel);
+  // The idle workers don't take new tasks, so they have to be woken up to
+  // hand their slot over.
+  task_cv_.notify_all();
+  // A free slot that no thread will take over is taken right away.
+  resume_cv_.wait(guard,
+                  [this] { return stop_ || !handed_over_slots_.empty() || free_slots_.size() > idle_threads_; });
+  resuming_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!handed_over_slots_.empty()) {
+    state->slot = handed_over_slots_.back();
+    handed_over_slots_.pop_back();
+  } else if (free_slots_.size() > idle_threads_) {
+    state->slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    // On shutdown the task finishes without a slot.
+    return;
+  }
+  --parked_tasks_;
+  state->parked = false;
+  // The time the task was parked doesn't count towards the long task
+  // threshold.
+  state->start = std::chrono::steady_clock::now();
+}
+
+void WorkStealingScheduler::SpawnThread() {
+  // An exited thread doesn't touch the scheduler anymore, so it can be joined
+  // while holding the lock.
+  if (!exited_threads_.empty()) {
+    std::erase_if(threads_, [this](std::thread &thread) {
+      if (std::find(exited_threads_.begin(), exited_threads_.end(), thread.get_id()) == exited_threads_.end()) {
+        return false;
+      }
+      thread.join();
+      return true;
+    });
+    exited_threads_.clear();
+  }
+  threads_.emplace_back([this] {
+    ThreadSetName(name_);
+    ThreadLoop();
+  });
+  ++idle_threads_;
+}
+
+}  // namespace memgraph::utils
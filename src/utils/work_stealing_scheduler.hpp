@@ -0,0 +1,225 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/spin_lock.hpp"
+
+namespace memgraph::utils {
+
+/// Priority class of a task executed by the `WorkStealingScheduler`.
+enum class TaskClass : uint8_t {
+  // Short tasks (e.g. point lookups) run on one of the worker slots.
+  SHORT,
+  // Tasks that ran for longer than the threshold and gave up their worker slot.
+  LONG,
+};
+
+/// Scheduler that executes tasks on a fixed number of worker slots with work
+/// stealing and two priority classes.
+///
+/// Each worker slot has its own queue. Scheduled tasks are distributed over the
+/// queues in a round robin fashion and a worker whose queue is empty steals
+/// tasks from the other queues, so the tasks queued behind a slow task are
+/// picked up by the other workers.
+///
+/// All tasks start in the `SHORT` class. A task that calls `Checkpoint` after
+/// running for longer than `long_task_threshold` is moved to the `LONG` class:
+/// its thread hands the worker slot over to another thread, so the short tasks
+/// keep the workers. At most `max_long_tasks` long tasks run at the same time.
+/// If the limit is reached, the task gives up its worker slot anyway and
+/// waits in `Checkpoint` until one of the long tasks finishes.
+///
+/// A task that blocks for a long time, e.g. in a queue, can `Park` to give up
+/// its worker slot without becoming a long task. When it resumes, it takes a
+/// worker slot back from the next worker that finishes its current task.
+///
+/// There are at most `workers_count + max_long_tasks` threads, plus one for
+/// every task that waits for the limit of long tasks or is parked, so the slots
+/// given up by such tasks always get a thread. If all of them are spawned, a slot
+/// that was given up is taken over by the next thread whose long task
+/// finished. Such a thread takes over a free worker slot if there is one,
+/// otherwise it exits.
+class WorkStealingScheduler final {
+ public:
+  WorkStealingScheduler(size_t workers_count, size_t max_long_tasks, std::chrono::microseconds long_task_threshold,
+                        std::string name = "worker");
+  ~WorkStealingScheduler();
+
+  WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler(WorkStealingScheduler &&) = delete;
+  WorkStealingScheduler &operator=(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler &operator=(WorkStealingScheduler &&) = delete;
+
+  /// Schedules `task` for execution in the `SHORT` class.
+  void Schedule(std::function<void()> task);
+
+  /// Cooperative scheduling point for the task that is running on the calling
+  /// thread. It does nothing if the thread isn't running a task of a scheduler
+  /// and it is cheap enough to be called for every produced row.
+  static void Checkpoint() noexcept;
+
+  /// Gives up the worker slot of the task that is running on the calling
+  /// thread before it blocks for a long time. The task stays in its class and
+  /// isn't counted against `max_long_tasks`. Every call must be followed by
+  /// `Unpark` once the task stops blocking.
+  ///
+  /// Returns `false` if the slot couldn't be given up, the task then keeps it.
+  /// Returns `true` without doing anything if the thread doesn't hold a worker
+  /// slot, e.g. because it isn't running a task of a scheduler.
+  [[nodiscard]] static bool Park() noexcept;
+
+  /// Takes a worker slot back for the task that was parked on the calling
+  /// thread. The call waits until a worker finishes its current task and hands
+  /// its slot over. It does nothing if the task isn't parked.
+  static void Unpark() noexcept;
+
+  /// Returns the class of the task that is running on the calling thread, or
+  /// `SHORT` if the thread isn't running a task of a scheduler.
+  static TaskClass CurrentTaskClass() noexcept;
+
+  /// Stops all workers. Tasks that are running are finished and the tasks
+  /// that are still queued are dropped.
+  void Shutdown();
+
+  /// Number of tasks that were scheduled and haven't finished yet.
+  size_t UnfinishedTasksNum() const { return unfinished_tasks_.load(std::memory_order_acquire); }
+
+  /// Number of tasks that are running in the `LONG` class.
+  size_t LongTasksNum() const { return long_tasks_.load(std::memory_order_acquire); }
+
+  /// Number of tasks that gave up their worker slot and wait until less than
+  /// `max_long_tasks` long tasks run.
+  size_t WaitingTasksNum() const;
+
+  /// Number of tasks that gave up their worker slot in `Park` and haven't
+  /// taken a slot back yet.
+  size_t ParkedTasksNum() const;
+
+  /// Number of threads that haven't exited yet.
+  size_t ThreadsNum() const;
+
+ private:
+  struct Slot {
+    SpinLock lock;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  struct TaskState {
+    WorkStealingScheduler *scheduler;
+    size_t slot;
+    std::chrono::steady_clock::time_point start;
+    TaskClass task_class{TaskClass::SHORT};
+    uint32_t checkpoints{0};
+    // Set while the task doesn't hold `slot` because it is parked.
+    bool parked{false};
+  };
+
+  /// Reason why a thread stopped running the tasks of its worker slot.
+  enum class WorkerExit : uint8_t {
+    // The task the thread ran became a long one and gave up the slot.
+    LONG_TASK,
+    // The thread handed the slot over to a parked task that resumed.
+    HANDED_OVER,
+    // The scheduler is shutting down.
+    STOPPED,
+  };
+
+  /// Main loop of every thread. The thread waits until a worker slot is free
+  /// and runs tasks on it until it loses the slot. A thread that lost its slot
+  /// exits unless there is a free slot left without a thread.
+  void ThreadLoop();
+
+  /// Runs the tasks of `slot` until the thread loses the slot.
+  WorkerExit RunWorker(size_t slot);
+
+  /// Hands `slot` over to a parked task that waits for a slot in `Unpark`.
+  /// Returns `false` if no task waits for a slot.
+  bool HandOverSlot(size_t slot);
+
+  /// Takes the oldest task of `slot`, or steals one from the other slots.
+  std::function<void()> PopTask(size_t slot);
+
+  /// Moves the task to the `LONG` class. If the limit of long tasks is reached,
+  /// the task gives up its slot and waits until a long task finishes.
+  void Demote(TaskState *state);
+
+  /// Gives up the slot of the parked task, see `Park`.
+  void ParkTask(TaskState *state);
+
+  /// Takes a slot back for the parked task, see `Unpark`.
+  void UnparkTask(TaskState *state);
+
+  /// Must be called while holding `mutex_`.
+  size_t ThreadsNumLocked() const;
+
+  /// Must be called while holding `mutex_`. Also joins the threads that
+  /// exited.
+  void SpawnThread();
+
+  // Task that is running on the current thread.
+  static thread_local TaskState *current_task_;
+
+  const size_t max_long_tasks_;
+  const std::chrono::microseconds long_task_threshold_;
+  const std::string name_;
+
+  std::vector<std::unique_ptr<Slot>> slots_;
+  std::atomic<size_t> next_slot_{0};
+  std::atomic<size_t> unfinished_tasks_{0};
+  std::atomic<size_t> queued_tasks_{0};
+  // Modified only while holding `mutex_`, read without it by `Checkpoint`.
+  std::atomic<size_t> long_tasks_{0};
+  // Parked tasks that wait for a slot in `Unpark`. Modified only while holding
+  // `mutex_`, read without it by the workers between the tasks.
+  std::atomic<size_t> resuming_tasks_{0};
+
+  mutable std::mutex mutex_;
+  // Signaled when a task is scheduled.
+  std::condition_variable task_cv_;
+  // Signaled when a worker slot is freed.
+  std::condition_variable slot_cv_;
+  // Signaled when a long task finishes.
+  std::condition_variable long_cv_;
+  // Signaled when a slot is handed over to a parked task.
+  std::condition_variable resume_cv_;
+  // The members below are protected by `mutex_`.
+  std::vector<size_t> free_slots_;
+  // Threads that wait for a free slot. There are never more of them than
+  // there are free slots.
+  size_t idle_threads_{0};
+  // Tasks that wait in `Demote` for the limit of long tasks.
+  size_t waiting_tasks_{0};
+  // Tasks that gave up their slot in `Park` and don't hold a slot yet.
+  size_t parked_tasks_{0};
+  // Slots handed over to the parked tasks that resume. There are never more
+  // of them than there are `resuming_tasks_`.
+  std::vector<size_t> handed_over_slots_;
+  bool stop_{false};
+  std::vector<std::thread> threads_;
+  std::vector<std::thread::id> exited_threads_;
+};
+
+}  // namespace memgraph::utils
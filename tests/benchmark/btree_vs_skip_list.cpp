@@ -0,0 +1,132 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/btree.hpp"
+#include "utils/skip_list.hpp"
+
+// Compares the B+-tree with the skip list for the access patterns of the
+// primary vertex and edge stores: keys are inserted in increasing order (the
+// `Gid`s are allocated sequentially), looked up at random and scanned in
+// order. The objects are 64 bytes which is close to the size of a `Vertex`.
+
+namespace {
+
+const uint64_t kNumObjects = 1000000;
+
+struct Object {
+  uint64_t key;
+  uint64_t payload[7];
+};
+
+bool operator==(const Object &first, const Object &second) { return first.key == second.key; }
+bool operator<(const Object &first, const Object &second) { return first.key < second.key; }
+bool operator==(const Object &first, uint64_t second) { return first.key == second; }
+bool operator<(const Object &first, uint64_t second) { return first.key < second; }
+
+using SkipList = memgraph::utils::SkipList<Object>;
+using BTree = memgraph::utils::BTree<Object, &Object::key>;
+
+template <typename TContainer>
+void Fill(TContainer *container, uint64_t count) {
+  auto acc = container->access();
+  for (uint64_t i = 0; i < count; ++i) {
+    acc.insert(Object{i, {}});
+  }
+}
+
+template <typename TContainer>
+TContainer &FilledContainer() {
+  static TContainer container;
+  if (container.size() == 0) Fill(&container, kNumObjects);
+  return container;
+}
+
+}  // namespace
+
+template <typename TContainer>
+// NOLINTNEXTLINE(google-runtime-references)
+static void Insert(benchmark::State &state) {
+  for (auto _ : state) {
+    TContainer container;
+    Fill(&container, kNumObjects);
+    benchmark::DoNotOptimize(container.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumObjects);
+}
+
+template <typename TContainer>
+// NOLINTNEXTLINE(google-runtime-references)
+static void Find(benchmark::State &state) {
+  auto &container = FilledContainer<TContainer>();
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> dist(0, kNumObjects - 1);
+  uint64_t found = 0;
+  for (auto _ : state) {
+    auto acc = container.access();
+    for (int i = 0; i < 1000; ++i) {
+      auto it = acc.find(dist(gen));
+      if (it != acc.end()) ++found;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+template <typename TContainer>
+// NOLINTNEXTLINE(google-runtime-references)
+static void Scan(benchmark::State &state) {
+  auto &container = FilledContainer<TContainer>();
+  for (auto _ : state) {
+    auto acc = container.access();
+    uint64_t sum = 0;
+    for (const auto &object : acc) {
+      sum += object.key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumObjects);
+}
+
+template <typename TContainer>
+// NOLINTNEXTLINE(google-runtime-references)
+static void RangeScan(benchmark::State &state) {
+  auto &container = FilledContainer<TContainer>();
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> dist(0, kNumObjects - 1);
+  const auto length = static_cast<uint64_t>(state.range(0));
+  for (auto _ : state) {
+    auto acc = container.access();
+    uint64_t sum = 0;
+    uint64_t seen = 0;
+    for (auto it = acc.find_equal_or_greater(dist(gen)); it != acc.end() && seen < length; ++it, ++seen) {
+      sum += it->key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+BENCHMARK_TEMPLATE(Insert, SkipList)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Insert, BTree)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Find, SkipList)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_TEMPLATE(Find, BTree)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_TEMPLATE(Scan, SkipList)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Scan, BTree)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(RangeScan, SkipList)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(RangeScan, BTree)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,188 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/csv_parsing.hpp"
+#include "utils/csv_tokenizer.hpp"
+#include "utils/string.hpp"
+
+namespace {
+
+enum class FileKind : int64_t { WIDE = 0, QUOTED = 1 };
+
+constexpr uint64_t kNumRows = 100000;
+
+const std::filesystem::path kCsvDirectory{std::filesystem::temp_directory_path() / "csv_parsing_benchmark"};
+
+/// Creates a CSV file with either many short unquoted columns or a few long
+/// quoted columns that contain delimiters, escaped quotes and newlines.
+std::filesystem::path CreateFile(FileKind kind) {
+  std::filesystem::create_directories(kCsvDirectory);
+  auto path = kCsvDirectory / (kind == FileKind::WIDE ? "wide.csv" : "quoted.csv");
+  if (std::filesystem::exists(path)) return path;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint64_t> dist(0, 1000000);
+  std::ofstream stream(path);
+  for (uint64_t i = 0; i < kNumRows; ++i) {
+    std::vector<std::string> row;
+    if (kind == FileKind::WIDE) {
+      for (int j = 0; j < 100; ++j) {
+        row.push_back(std::to_string(dist(gen)));
+      }
+    } else {
+      row.push_back(std::to_string(i));
+      for (int j = 0; j < 5; ++j) {
+        row.push_back(fmt::format("\"value {}, with \"\"quotes\"\"\nand a line break {}\"", dist(gen), dist(gen)));
+      }
+    }
+    stream << memgraph::utils::Join(row, ",") << "\n";
+  }
+  return path;
+}
+
+/// The line-based parser that was used before the block-based tokenizer. Each
+/// line is read with `std::getline` and every character is copied into the
+/// current field.
+class LegacyReader {
+ public:
+  explicit LegacyReader(const std::filesystem::path &path) : stream_(path) {}
+
+  bool ReadRow(std::vector<std::string> *row) {
+    enum class State { INITIAL_FIELD, NEXT_FIELD, QUOTING, NOT_QUOTING, EXPECT_DELIMITER };
+    row->clear();
+    std::string column;
+    auto state = State::INITIAL_FIELD;
+    bool read_any = false;
+    do {
+      std::string line;
+      if (!std::getline(stream_, line)) break;
+      read_any = true;
+      for (size_t i = 0; i < line.size(); ++i) {
+        auto c = line[i];
+        if (c == '\r') continue;
+        switch (state) {
+          case State::INITIAL_FIELD:
+          case State::NEXT_FIELD:
+            if (c == '"') {
+              state = State::QUOTING;
+            } else if (c == ',') {
+              row->emplace_back();
+              state = State::NEXT_FIELD;
+            } else {
+              column.push_back(c);
+              state = State::NOT_QUOTING;
+            }
+            break;
+          case State::QUOTING:
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+              column.push_back(c);
+              ++i;
+            } else if (c == '"') {
+              row->emplace_back(std::move(column));
+              column.clear();
+              state = State::EXPECT_DELIMITER;
+            } else {
+              column.push_back(c);
+            }
+            break;
+          case State::NOT_QUOTING:
+            if (c == ',') {
+              row->emplace_back(std::move(column));
+              column.clear();
+              state = State::NEXT_FIELD;
+            } else {
+              column.push_back(c);
+            }
+            break;
+          case State::EXPECT_DELIMITER:
+            state = State::NEXT_FIELD;
+            break;
+        }
+      }
+    } while (state == State::QUOTING);
+    if (state == State::NEXT_FIELD || state == State::NOT_QUOTING) {
+      row->emplace_back(std::move(column));
+    }
+    return read_any;
+  }
+
+ private:
+  std::ifstream stream_;
+};
+
+}  // namespace
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void Legacy(benchmark::State &state) {
+  auto path = CreateFile(static_cast<FileKind>(state.range(0)));
+  uint64_t rows = 0;
+  for (auto _ : state) {
+    LegacyReader reader(path);
+    std::vector<std::string> row;
+    while (reader.ReadRow(&row)) {
+      benchmark::DoNotOptimize(row.data());
+      ++rows;
+    }
+  }
+  state.SetItemsProcessed(rows);
+  state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void Tokenizer(benchmark::State &state) {
+  auto path = CreateFile(static_cast<FileKind>(state.range(0)));
+  uint64_t rows = 0;
+  for (auto _ : state) {
+    memgraph::csv::Tokenizer tokenizer(path, ",", "\"");
+    std::vector<std::string_view> fields;
+    while (true) {
+      auto result = tokenizer.ReadRow(&fields);
+      if (result.HasError() || !*result) break;
+      benchmark::DoNotOptimize(fields.data());
+      ++rows;
+    }
+  }
+  state.SetItemsProcessed(rows);
+  state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void Reader(benchmark::State &state) {
+  auto path = CreateFile(static_cast<FileKind>(state.range(0)));
+  auto *mem = memgraph::utils::NewDeleteResource();
+  uint64_t rows = 0;
+  for (auto _ : state) {
+    memgraph::csv::Reader reader(path, memgraph::csv::Reader::Config{});
+    while (auto row = reader.GetNextRow(mem)) {
+      benchmark::DoNotOptimize(row->data());
+      ++rows;
+    }
+  }
+  state.SetItemsProcessed(rows);
+  state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+}
+
+BENCHMARK(Legacy)->Arg(static_cast<int64_t>(FileKind::WIDE))->Unit(benchmark::kMillisecond);
+BENCHMARK(Legacy)->Arg(static_cast<int64_t>(FileKind::QUOTED))->Unit(benchmark::kMillisecond);
+BENCHMARK(Tokenizer)->Arg(static_cast<int64_t>(FileKind::WIDE))->Unit(benchmark::kMillisecond);
+BENCHMARK(Tokenizer)->Arg(static_cast<int64_t>(FileKind::QUOTED))->Unit(benchmark::kMillisecond);
+BENCHMARK(Reader)->Arg(static_cast<int64_t>(FileKind::WIDE))->Unit(benchmark::kMillisecond);
+BENCHMARK(Reader)->Arg(static_cast<int64_t>(FileKind::QUOTED))->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
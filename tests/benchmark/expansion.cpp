@@ -32,14 +32,14 @@ class ExpansionBenchFixture : public benchmark::Fixture {
 
     {
       auto dba = db->Access();
-      for (int i = 0; i < state.range(0); i++) dba.CreateVertex();
+      for (int i = 0; i < state.range(0); i++) dba.CreateVertex().GetValue();
 
       // the fixed part is one vertex expanding to 1000 others
-      auto start = dba.CreateVertex();
+      auto start = dba.CreateVertex().GetValue();
       MG_ASSERT(start.AddLabel(label).HasValue());
       auto edge_type = dba.NameToEdgeType("edge_type");
       for (int i = 0; i < 1000; i++) {
-        auto dest = dba.CreateVertex();
+        auto dest = dba.CreateVertex().GetValue();
         MG_ASSERT(dba.CreateEdge(&start, &dest, edge_type).HasValue());
       }
       MG_ASSERT(!dba.Commit().HasError());
@@ -62,7 +62,7 @@ class PoolResource final {
 
 static void AddVertices(memgraph::storage::Storage *db, int vertex_count) {
   auto dba = db->Access();
-  for (int i = 0; i < vertex_count; i++) dba.CreateVertex();
+  for (int i = 0; i < vertex_count; i++) dba.CreateVertex().GetValue();
   MG_ASSERT(!dba.Commit().HasError());
 }
 
@@ -71,12 +71,12 @@ static const char *kStartLabel = "start";
 static void AddStarGraph(memgraph::storage::Storage *db, int spoke_count, int depth) {
   {
     auto dba = db->Access();
-    auto center_vertex = dba.CreateVertex();
+    auto center_vertex = dba.CreateVertex().GetValue();
     MG_ASSERT(center_vertex.AddLabel(dba.NameToLabel(kStartLabel)).HasValue());
     for (int i = 0; i < spoke_count; ++i) {
       auto prev_vertex = center_vertex;
       for (int j = 0; j < depth; ++j) {
-        auto dest = dba.CreateVertex();
+        auto dest = dba.CreateVertex().GetValue();
         MG_ASSERT(dba.CreateEdge(&prev_vertex, &dest, dba.NameToEdgeType("Type")).HasValue());
         prev_vertex = dest;
       }
@@ -91,13 +91,13 @@ static void AddTree(memgraph::storage::Storage *db, int vertex_count) {
     auto dba = db->Access();
     std::vector<memgraph::storage::VertexAccessor> vertices;
     vertices.reserve(vertex_count);
-    auto root = dba.CreateVertex();
+    auto root = dba.CreateVertex().GetValue();
     MG_ASSERT(root.AddLabel(dba.NameToLabel(kStartLabel)).HasValue());
     vertices.push_back(root);
     // NOLINTNEXTLINE(cert-msc32-c,cert-msc51-cpp)
     std::mt19937_64 rg(42);
     for (int i = 1; i < vertex_count; ++i) {
-      auto v = dba.CreateVertex();
+      auto v = dba.CreateVertex().GetValue();
       std::uniform_int_distribution<> dis(0U, vertices.size() - 1U);
       auto &parent = vertices.at(dis(rg));
       MG_ASSERT(dba.CreateEdge(&parent, &v, dba.NameToEdgeType("Type")).HasValue());
@@ -99,7 +99,7 @@ static auto CreateIndexedVertices(int index_count, int vertex_count, memgraph::s
   auto dba = db->Access();
   for (int vi = 0; vi < vertex_count; ++vi) {
     for (int index = 0; index < index_count; ++index) {
-      auto vertex = dba.CreateVertex();
+      auto vertex = dba.CreateVertex().GetValue();
       MG_ASSERT(vertex.AddLabel(label).HasValue());
       MG_ASSERT(vertex.SetProperty(prop, memgraph::storage::PropertyValue(index)).HasValue());
     }
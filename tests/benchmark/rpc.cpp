@@ -11,6 +11,7 @@
 
 #include <optional>
 #include <thread>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -77,6 +78,24 @@ static void BenchmarkRpcPool(benchmark::State &state) {
   state.SetItemsProcessed(state.iterations());
 }
 
+// Keeps `state.range(0)` requests in flight on a single connection.
+static void BenchmarkRpcPipelined(benchmark::State &state) {
+  auto depth = state.range(0);
+  std::string data(100, 'a');
+  std::vector<memgraph::rpc::Client::StreamHandler<Echo>> handlers;
+  handlers.reserve(depth);
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < depth; ++i) {
+      handlers.push_back(clients[state.thread_index()]->AsyncCall<Echo>(data));
+    }
+    for (auto &handler : handlers) {
+      handler.AwaitResponse();
+    }
+    handlers.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * depth);
+}
+
 BENCHMARK(BenchmarkRpc)
     ->RangeMultiplier(4)
     ->Range(4, 1 << 13)
@@ -91,6 +110,13 @@ BENCHMARK(BenchmarkRpcPool)
     ->Unit(benchmark::kNanosecond)
     ->UseRealTime();
 
+BENCHMARK(BenchmarkRpcPipelined)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->ThreadRange(1, kThreadsNum)
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
 int main(int argc, char **argv) {
   ::benchmark::Initialize(&argc, argv);
   gflags::AllowCommandLineReparsing();
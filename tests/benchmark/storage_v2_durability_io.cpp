@@ -0,0 +1,81 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "storage/v2/storage.hpp"
+#include "utils/file.hpp"
+
+namespace {
+
+const std::filesystem::path kDirectory{std::filesystem::temp_directory_path() / "storage_v2_durability_io_benchmark"};
+
+auto IoBackend(int64_t arg) {
+  return arg == 0 ? memgraph::utils::OutputFile::IoBackend::SYSCALL : memgraph::utils::OutputFile::IoBackend::IO_URING;
+}
+
+std::optional<memgraph::storage::Storage> storage;
+
+}  // namespace
+
+// Each thread appends a small record to its own file and syncs it, which is
+// what a commit does with `storage_wal_file_flush_every_n_tx` set to 1.
+// NOLINTNEXTLINE(google-runtime-references)
+static void WriteAndSync(benchmark::State &state) {
+  std::filesystem::create_directories(kDirectory);
+  auto path = kDirectory / ("file_" + std::to_string(state.thread_index()));
+  memgraph::utils::OutputFile file;
+  file.Open(path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING, IoBackend(state.range(0)));
+  std::string record(128, 'a');
+  for (auto _ : state) {
+    file.Write(record);
+    file.Sync();
+  }
+  file.Close();
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Commit latency of small write transactions with a synchronous WAL.
+// NOLINTNEXTLINE(google-runtime-references)
+static void Commit(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    std::filesystem::remove_all(kDirectory);
+    storage.emplace(memgraph::storage::Config{
+        .durability = {.storage_directory = kDirectory,
+                       .snapshot_wal_mode =
+                           memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+                       .snapshot_interval = std::chrono::hours(1),
+                       .wal_file_flush_every_n_tx = 1,
+                       .io_uring = state.range(0) != 0}});
+  }
+  for (auto _ : state) {
+    auto acc = storage->Access();
+    acc.CreateVertex().GetValue();
+    MG_ASSERT(!acc.Commit().HasError());
+  }
+  if (state.thread_index() == 0) {
+    storage.reset();
+    std::filesystem::remove_all(kDirectory);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(WriteAndSync)->Arg(0)->Arg(1)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK(Commit)->Arg(0)->Arg(1)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -62,7 +62,7 @@ int main(int argc, char *argv[]) {
     {
       auto acc = storage.Access();
       for (int i = 0; i < FLAGS_num_vertices; ++i) {
-        vertices.push_back(acc.CreateVertex().Gid());
+        vertices.push_back(acc.CreateVertex().GetValue().Gid());
       }
       MG_ASSERT(!acc.Commit().HasError());
     }
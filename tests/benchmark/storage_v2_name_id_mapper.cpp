@@ -0,0 +1,160 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "storage/v2/name_id_mapper.hpp"
+#include "utils/skip_list.hpp"
+
+namespace {
+
+/// The skip list based mapper that was used before the hash based one. Every
+/// lookup compares full strings in the name to ID skip list and probes the ID
+/// to name skip list.
+class LegacyNameIdMapper final {
+ private:
+  struct MapNameToId {
+    std::string name;
+    uint64_t id;
+
+    bool operator<(const MapNameToId &other) { return name < other.name; }
+    bool operator==(const MapNameToId &other) { return name == other.name; }
+
+    bool operator<(const std::string_view &other) { return name < other; }
+    bool operator==(const std::string_view &other) { return name == other; }
+  };
+
+  struct MapIdToName {
+    uint64_t id;
+    std::string name;
+
+    bool operator<(const MapIdToName &other) { return id < other.id; }
+    bool operator==(const MapIdToName &other) { return id == other.id; }
+
+    bool operator<(uint64_t other) { return id < other; }
+    bool operator==(uint64_t other) { return id == other; }
+  };
+
+ public:
+  uint64_t NameToId(const std::string_view &name) {
+    auto name_to_id_acc = name_to_id_.access();
+    auto found = name_to_id_acc.find(name);
+    uint64_t id;
+    if (found == name_to_id_acc.end()) {
+      uint64_t new_id = counter_.fetch_add(1, std::memory_order_acq_rel);
+      id = name_to_id_acc.insert({std::string(name), new_id}).first->id;
+    } else {
+      id = found->id;
+    }
+    auto id_to_name_acc = id_to_name_.access();
+    if (id_to_name_acc.find(id) == id_to_name_acc.end()) {
+      id_to_name_acc.insert({id, std::string(name)});
+    }
+    return id;
+  }
+
+  const std::string &IdToName(uint64_t id) const {
+    auto id_to_name_acc = id_to_name_.access();
+    auto result = id_to_name_acc.find(id);
+    MG_ASSERT(result != id_to_name_acc.end(), "Trying to get a name for an invalid ID!");
+    return result->name;
+  }
+
+ private:
+  std::atomic<uint64_t> counter_{0};
+  memgraph::utils::SkipList<MapNameToId> name_to_id_;
+  memgraph::utils::SkipList<MapIdToName> id_to_name_;
+};
+
+/// Names that look like the labels, properties and edge types used by
+/// procedures and imports.
+std::vector<std::string> MakeNames(int64_t count) {
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    names.push_back("property_name_" + std::to_string(i));
+  }
+  return names;
+}
+
+template <typename TMapper>
+void NameToId(benchmark::State &state, TMapper *mapper) {
+  const auto names = MakeNames(state.range(0));
+  for (const auto &name : names) {
+    mapper->NameToId(name);
+  }
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<size_t> dist(0, names.size() - 1);
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mapper->NameToId(names[dist(gen)]));
+    ++counter;
+  }
+  state.SetItemsProcessed(counter);
+}
+
+template <typename TMapper>
+void IdToName(benchmark::State &state, TMapper *mapper) {
+  std::vector<uint64_t> ids;
+  for (const auto &name : MakeNames(state.range(0))) {
+    ids.push_back(mapper->NameToId(name));
+  }
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<size_t> dist(0, ids.size() - 1);
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mapper->IdToName(ids[dist(gen)]).data());
+    ++counter;
+  }
+  state.SetItemsProcessed(counter);
+}
+
+}  // namespace
+
+// The mappers are shared by all threads of a benchmark, like the storage's
+// mapper is shared by all sessions.
+memgraph::storage::NameIdMapper mapper;
+LegacyNameIdMapper legacy_mapper;
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void NameIdMapperNameToId(benchmark::State &state) { NameToId(state, &mapper); }
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void LegacyNameIdMapperNameToId(benchmark::State &state) { NameToId(state, &legacy_mapper); }
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void NameIdMapperIdToName(benchmark::State &state) { IdToName(state, &mapper); }
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void LegacyNameIdMapperIdToName(benchmark::State &state) { IdToName(state, &legacy_mapper); }
+
+BENCHMARK(NameIdMapperNameToId)->Arg(16)->Arg(1024)->ThreadRange(1, 8)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(LegacyNameIdMapperNameToId)
+    ->Arg(16)
+    ->Arg(1024)
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+BENCHMARK(NameIdMapperIdToName)->Arg(16)->Arg(1024)->ThreadRange(1, 8)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(LegacyNameIdMapperIdToName)
+    ->Arg(16)
+    ->Arg(1024)
+    ->ThreadRange(1, 8)
+    ->Unit(benchmark::kNanosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
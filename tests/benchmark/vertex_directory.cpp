@@ -0,0 +1,114 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "storage/v2/vertex_directory.hpp"
+#include "utils/memory.hpp"
+#include "utils/skip_list.hpp"
+
+// Compares GID lookups through the vertex directory with lookups in the
+// ordered vertex store, and reports the memory used per vertex by each of
+// them. The directory lookup holds an accessor to the vertex store just like
+// `Storage::Accessor::FindVertex` does.
+
+namespace {
+
+const uint64_t kNumVertices = 1000000;
+
+using memgraph::storage::Gid;
+using memgraph::storage::Vertex;
+
+/// Memory resource that counts the bytes that are currently allocated.
+class CountingResource final : public memgraph::utils::MemoryResource {
+ public:
+  uint64_t Allocated() const { return allocated_; }
+
+ private:
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    allocated_ += bytes;
+    return memgraph::utils::NewDeleteResource()->Allocate(bytes, alignment);
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    allocated_ -= bytes;
+    memgraph::utils::NewDeleteResource()->Deallocate(p, bytes, alignment);
+  }
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+
+  std::atomic<uint64_t> allocated_{0};
+};
+
+struct Store {
+  CountingResource memory;
+  memgraph::utils::SkipList<Vertex> vertices{&memory};
+  memgraph::storage::VertexDirectory directory;
+};
+
+Store &FilledStore() {
+  static Store store;
+  if (store.vertices.size() == 0) {
+    auto acc = store.vertices.access();
+    for (uint64_t i = 0; i < kNumVertices; ++i) {
+      auto [it, inserted] = acc.insert(Vertex{Gid::FromUint(i), nullptr});
+      store.directory.Insert(it->gid, &*it);
+    }
+  }
+  return store;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void FindSkipList(benchmark::State &state) {
+  auto &store = FilledStore();
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> dist(0, kNumVertices - 1);
+  uint64_t found = 0;
+  for (auto _ : state) {
+    auto acc = store.vertices.access();
+    for (int i = 0; i < 1000; ++i) {
+      auto it = acc.find(Gid::FromUint(dist(gen)));
+      if (it != acc.end()) ++found;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations() * 1000);
+  state.counters["bytes_per_vertex"] = static_cast<double>(store.memory.Allocated()) / kNumVertices;
+}
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void FindDirectory(benchmark::State &state) {
+  auto &store = FilledStore();
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> dist(0, kNumVertices - 1);
+  uint64_t found = 0;
+  for (auto _ : state) {
+    auto acc = store.vertices.access();
+    for (int i = 0; i < 1000; ++i) {
+      if (store.directory.Find(Gid::FromUint(dist(gen))) != nullptr) ++found;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations() * 1000);
+  state.counters["bytes_per_vertex"] = static_cast<double>(store.directory.MemoryUsage()) / kNumVertices;
+}
+
+BENCHMARK(FindSkipList)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(FindDirectory)->ThreadRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "utils/btree.hpp"
+
+// kNumThreadsRemove should be smaller than kNumThreadsInsert because there
+// should be some leftover items in the tree for the find and scan threads.
+const int kNumThreadsInsert = 5;
+const int kNumThreadsRemove = 2;
+const int kNumThreadsFind = 2;
+const int kNumThreadsScan = 1;
+
+const uint64_t kMaxNum = 2000000;
+
+struct Object {
+  uint64_t key;
+  uint64_t value;
+};
+
+int main() {
+  memgraph::utils::BTree<Object, &Object::key> tree;
+
+  std::atomic<bool> run{true}, modify_done{false};
+
+  std::vector<std::thread> threads_modify, threads_read;
+
+  // The insert threads interleave their keys so that all of them modify the
+  // same leaves.
+  for (int i = 0; i < kNumThreadsInsert; ++i) {
+    threads_modify.push_back(std::thread([&tree, i] {
+      for (uint64_t num = 0; num < kMaxNum; ++num) {
+        auto acc = tree.access();
+        auto key = num * kNumThreadsInsert + i;
+        MG_ASSERT(acc.insert(Object{key, key}).second);
+      }
+    }));
+  }
+  for (int i = 0; i < kNumThreadsRemove; ++i) {
+    threads_modify.push_back(std::thread([&tree, i] {
+      for (uint64_t num = 0; num < kMaxNum; ++num) {
+        auto acc = tree.access();
+        while (!acc.remove(num * kNumThreadsInsert + i))
+          ;
+      }
+    }));
+  }
+
+  for (int i = 0; i < kNumThreadsFind; ++i) {
+    threads_read.push_back(std::thread([&tree, &run, &modify_done, i] {
+      std::mt19937 gen(3137 + i);
+      std::uniform_int_distribution<uint64_t> dist(0, kNumThreadsInsert * kMaxNum - 1);
+      while (run.load(std::memory_order_relaxed)) {
+        auto acc = tree.access();
+        auto num = dist(gen);
+        auto it = acc.find(num);
+        if (it != acc.end()) {
+          MG_ASSERT(it->key == num && it->value == num);
+        }
+        if (modify_done.load(std::memory_order_relaxed) && num % kNumThreadsInsert >= kNumThreadsRemove) {
+          MG_ASSERT(it != acc.end());
+        }
+      }
+    }));
+  }
+
+  // The scans must always see strictly increasing keys, regardless of the
+  // splits and removals that happen concurrently.
+  for (int i = 0; i < kNumThreadsScan; ++i) {
+    threads_read.push_back(std::thread([&tree, &run, &modify_done] {
+      while (run.load(std::memory_order_relaxed)) {
+        bool done = modify_done.load(std::memory_order_relaxed);
+        auto acc = tree.access();
+        uint64_t count = 0;
+        uint64_t prev = 0;
+        for (const auto &item : acc) {
+          MG_ASSERT(count == 0 || item.key > prev);
+          prev = item.key;
+          ++count;
+        }
+        if (done) {
+          MG_ASSERT(count == (kNumThreadsInsert - kNumThreadsRemove) * kMaxNum);
+        }
+      }
+    }));
+  }
+
+  for (int i = 0; i < threads_modify.size(); ++i) {
+    threads_modify[i].join();
+  }
+
+  modify_done.store(true, std::memory_order_relaxed);
+  std::this_thread::sleep_for(std::chrono::seconds(10));
+  run.store(false, std::memory_order_relaxed);
+
+  for (int i = 0; i < threads_read.size(); ++i) {
+    threads_read[i].join();
+  }
+
+  MG_ASSERT(tree.size() == (kNumThreadsInsert - kNumThreadsRemove) * kMaxNum);
+  for (uint64_t i = 0; i < kMaxNum * kNumThreadsInsert; ++i) {
+    auto acc = tree.access();
+    auto it = acc.find(i);
+    if (i % kNumThreadsInsert < kNumThreadsRemove) {
+      MG_ASSERT(it == acc.end());
+    } else {
+      MG_ASSERT(it != acc.end());
+      MG_ASSERT(it->key == i);
+    }
+  }
+
+  return 0;
+}
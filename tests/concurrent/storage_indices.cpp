@@ -41,7 +41,7 @@ TEST(Storage, LabelIndex) {
       for (uint64_t i = 0; i < kNumIterations; ++i) {
         for (uint64_t j = 0; j < kVerifierBatchSize; ++j) {
           auto acc = store.Access();
-          auto vertex = acc.CreateVertex();
+          auto vertex = acc.CreateVertex().GetValue();
           gids.emplace(vertex.Gid(), false);
           auto ret = vertex.AddLabel(label);
           ASSERT_TRUE(ret.HasValue());
@@ -78,7 +78,7 @@ TEST(Storage, LabelIndex) {
       while (mutators_run.load(std::memory_order_acquire)) {
         for (uint64_t i = 0; i < kMutatorBatchSize; ++i) {
           auto acc = store.Access();
-          auto vertex = acc.CreateVertex();
+          auto vertex = acc.CreateVertex().GetValue();
           gids[i] = vertex.Gid();
           auto ret = vertex.AddLabel(label);
           ASSERT_TRUE(ret.HasValue());
@@ -123,7 +123,7 @@ TEST(Storage, LabelPropertyIndex) {
       for (uint64_t i = 0; i < kNumIterations; ++i) {
         for (uint64_t j = 0; j < kVerifierBatchSize; ++j) {
           auto acc = store.Access();
-          auto vertex = acc.CreateVertex();
+          auto vertex = acc.CreateVertex().GetValue();
           gids.emplace(vertex.Gid(), false);
           {
             auto ret = vertex.AddLabel(label);
@@ -167,7 +167,7 @@ TEST(Storage, LabelPropertyIndex) {
       while (mutators_run.load(std::memory_order_acquire)) {
         for (uint64_t i = 0; i < kMutatorBatchSize; ++i) {
           auto acc = store.Access();
-          auto vertex = acc.CreateVertex();
+          auto vertex = acc.CreateVertex().GetValue();
           gids[i] = vertex.Gid();
           {
             auto ret = vertex.AddLabel(label);
@@ -0,0 +1,221 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "storage/v2/storage.hpp"
+#include "storage/v2/timestamp_oracle.hpp"
+#include "utils/thread.hpp"
+
+const uint64_t kNumStarters = 8;
+const uint64_t kNumIterations = 100000;
+const uint64_t kCheckedWindow = 64;
+
+TEST(TimestampOracle, StartWaitsForEarlierCommits) {
+  memgraph::storage::TimestampOracle oracle;
+
+  // Every timestamp is handed out either as a start or as a commit
+  // timestamp, so the arrays can be indexed by timestamp.
+  const uint64_t max_timestamp = kNumIterations * (kNumStarters + 1);
+  std::vector<std::atomic<bool>> is_commit(max_timestamp);
+  std::vector<std::atomic<bool>> is_published(max_timestamp);
+  std::vector<std::atomic<bool>> is_used(max_timestamp);
+
+  std::atomic<bool> committer_run = true;
+  std::thread committer([&] {
+    memgraph::utils::ThreadSetName("committer");
+    for (uint64_t i = 0; i < kNumIterations && committer_run.load(std::memory_order_acquire); ++i) {
+      const auto timestamp = oracle.BeginCommit();
+      ASSERT_LT(timestamp, max_timestamp);
+      ASSERT_FALSE(is_used[timestamp].exchange(true));
+      is_commit[timestamp].store(true);
+      std::this_thread::yield();
+      is_published[timestamp].store(true);
+      oracle.FinishCommit();
+    }
+  });
+
+  std::vector<std::thread> starters;
+  starters.reserve(kNumStarters);
+  for (uint64_t i = 0; i < kNumStarters; ++i) {
+    starters.emplace_back([&, num = i] {
+      memgraph::utils::ThreadSetName(fmt::format("starter{}", num));
+      uint64_t previous = 0;
+      for (uint64_t j = 0; j < kNumIterations; ++j) {
+        const auto timestamp = oracle.StartTimestamp();
+        ASSERT_LT(timestamp, max_timestamp);
+        ASSERT_FALSE(is_used[timestamp].exchange(true));
+        if (j > 0) {
+          ASSERT_GT(timestamp, previous);
+        }
+        previous = timestamp;
+        // All commits with a lower timestamp must be visible.
+        for (uint64_t k = timestamp > kCheckedWindow ? timestamp - kCheckedWindow : 0; k < timestamp; ++k) {
+          if (is_commit[k].load()) {
+            ASSERT_TRUE(is_published[k].load());
+          }
+        }
+      }
+    });
+  }
+
+  for (auto &starter : starters) {
+    starter.join();
+  }
+  committer_run.store(false, std::memory_order_release);
+  committer.join();
+}
+
+const uint64_t kNumAccounts = 16;
+const int64_t kInitialBalance = 1000;
+const uint64_t kNumTransferers = 4;
+const uint64_t kNumAuditors = 4;
+const uint64_t kNumTransfers = 5000;
+
+// Transferers move money between accounts while auditors check that the total
+// never changes. An auditor that misses a commit that finished before it
+// started, or sees only a part of one, finds a wrong total.
+TEST(Storage, SnapshotIsolationUnderConcurrentCommits) {
+  memgraph::storage::Storage store;
+  auto balance = store.NameToProperty("balance");
+
+  std::array<memgraph::storage::Gid, kNumAccounts> accounts;
+  {
+    auto acc = store.Access();
+    for (auto &account : accounts) {
+      auto vertex = acc.CreateVertex().GetValue();
+      account = vertex.Gid();
+      ASSERT_TRUE(vertex.SetProperty(balance, memgraph::storage::PropertyValue(kInitialBalance)).HasValue());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  std::vector<std::thread> transferers;
+  transferers.reserve(kNumTransferers);
+  for (uint64_t i = 0; i < kNumTransferers; ++i) {
+    transferers.emplace_back([&, num = i] {
+      memgraph::utils::ThreadSetName(fmt::format("transferer{}", num));
+      std::mt19937 gen(num);
+      std::uniform_int_distribution<uint64_t> account_dist(0, kNumAccounts - 1);
+      std::uniform_int_distribution<int64_t> amount_dist(1, 10);
+      for (uint64_t j = 0; j < kNumTransfers;) {
+        const auto from = account_dist(gen);
+        const auto to = account_dist(gen);
+        if (from == to) continue;
+        const auto amount = amount_dist(gen);
+
+        auto acc = store.Access();
+        auto transfer = [&](uint64_t account, int64_t delta) {
+          auto vertex = acc.FindVertex(accounts[account], memgraph::storage::View::OLD);
+          MG_ASSERT(vertex, "Account doesn't exist!");
+          auto value = vertex->GetProperty(balance, memgraph::storage::View::OLD);
+          MG_ASSERT(value.HasValue(), "Couldn't read the balance!");
+          return !vertex->SetProperty(balance, memgraph::storage::PropertyValue(value->ValueInt() + delta)).HasError();
+        };
+        // A serialization error aborts the transfer and it is tried again.
+        if (!transfer(from, -amount) || !transfer(to, amount)) {
+          acc.Abort();
+          continue;
+        }
+        ASSERT_FALSE(acc.Commit().HasError());
+        ++j;
+      }
+    });
+  }
+
+  std::atomic<bool> auditors_run = true;
+  std::vector<std::thread> auditors;
+  auditors.reserve(kNumAuditors);
+  for (uint64_t i = 0; i < kNumAuditors; ++i) {
+    auditors.emplace_back([&, num = i] {
+      memgraph::utils::ThreadSetName(fmt::format("auditor{}", num));
+      while (auditors_run.load(std::memory_order_acquire)) {
+        // Half of the auditors use read-only transactions.
+        auto acc = num % 2 == 0 ? store.Access() : store.ReadOnlyAccess();
+        int64_t total = 0;
+        for (const auto &account : accounts) {
+          auto vertex = acc.FindVertex(account, memgraph::storage::View::OLD);
+          ASSERT_TRUE(vertex);
+          auto value = vertex->GetProperty(balance, memgraph::storage::View::OLD);
+          ASSERT_TRUE(value.HasValue());
+          total += value->ValueInt();
+        }
+        ASSERT_EQ(total, kInitialBalance * static_cast<int64_t>(kNumAccounts));
+        ASSERT_FALSE(acc.Commit().HasError());
+      }
+    });
+  }
+
+  for (auto &transferer : transferers) {
+    transferer.join();
+  }
+  auditors_run.store(false, std::memory_order_release);
+  for (auto &auditor : auditors) {
+    auditor.join();
+  }
+}
+
+const uint64_t kNumLargeCommitVertices = 500000;
+
+// The commit of a large transaction spends most of its time writing the WAL.
+// The transactions that start in the meantime only wait for the commit to be
+// published, not for the WAL.
+TEST(Storage, StartDoesntWaitForWalAppend) {
+  const auto storage_directory = std::filesystem::temp_directory_path() / "MG_test_concurrent_storage_transactions";
+  std::filesystem::remove_all(storage_directory);
+  {
+    memgraph::storage::Storage store(
+        {.durability = {.storage_directory = storage_directory,
+                        .snapshot_wal_mode =
+                            memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+                        .snapshot_interval = std::chrono::hours(1)}});
+    auto property = store.NameToProperty("property");
+
+    auto acc = store.Access();
+    for (uint64_t i = 0; i < kNumLargeCommitVertices; ++i) {
+      auto vertex = acc.CreateVertex().GetValue();
+      ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(static_cast<int64_t>(i))).HasValue());
+    }
+
+    std::atomic<bool> committing = false;
+    std::atomic<bool> committed = false;
+    std::chrono::steady_clock::duration max_start_duration{0};
+    std::thread reader([&] {
+      memgraph::utils::ThreadSetName("reader");
+      while (!committing.load(std::memory_order_acquire)) std::this_thread::yield();
+      while (!committed.load(std::memory_order_acquire)) {
+        const auto start = std::chrono::steady_clock::now();
+        auto reader_acc = store.Access();
+        max_start_duration = std::max(max_start_duration, std::chrono::steady_clock::now() - start);
+        ASSERT_FALSE(reader_acc.Commit().HasError());
+      }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    committing.store(true, std::memory_order_release);
+    ASSERT_FALSE(acc.Commit().HasError());
+    const auto commit_duration = std::chrono::steady_clock::now() - start;
+    committed.store(true, std::memory_order_release);
+    reader.join();
+
+    ASSERT_LT(max_start_duration * 4, commit_duration);
+  }
+  std::filesystem::remove_all(storage_directory);
+}
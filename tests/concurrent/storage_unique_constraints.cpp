@@ -37,7 +37,7 @@ class StorageUniqueConstraints : public ::testing::Test {
     auto acc = storage.Access();
     // NOLINTNEXTLINE(modernize-loop-convert)
     for (int i = 0; i < kNumThreads; ++i) {
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       gids[i] = vertex.Gid();
     }
     ASSERT_OK(acc.Commit());
@@ -135,6 +135,27 @@ def check_stream_info(cursor, stream_name, expected_stream_info):
     validate_info(stream_info, expected_stream_info)
 
 
+def get_stream_stats(cursor, stream_name):
+    results = execute_and_fetch_all(
+        cursor,
+        f"CALL mg.stream_stats('{stream_name}') YIELD messages, batches, queries, last_batch_duration_ms, lag_ms "
+        "RETURN messages, batches, queries, last_batch_duration_ms, lag_ms",
+    )
+    assert len(results) == 1
+    messages, batches, queries, last_batch_duration_ms, lag_ms = results[0]
+    return {
+        "messages": messages,
+        "batches": batches,
+        "queries": queries,
+        "last_batch_duration_ms": last_batch_duration_ms,
+        "lag_ms": lag_ms,
+    }
+
+
+def count_vertices(cursor, label):
+    return execute_and_fetch_all(cursor, f"MATCH (n:{label}) RETURN count(n)")[0][0]
+
+
 def kafka_check_vertex_exists_with_topic_and_payload(cursor, topic, payload_bytes):
     decoded_payload = payload_bytes.decode("utf-8")
     check_vertex_exists_with_properties(cursor, {"topic": f'"{topic}"', "payload": f'"{decoded_payload}"'})
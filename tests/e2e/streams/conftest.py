@@ -66,6 +66,21 @@ def kafka_topics():
     admin_client.delete_topics(topics=topics, timeout_ms=5000)
 
 
+@pytest.fixture(scope="function")
+def kafka_partitioned_topic():
+    admin_client = KafkaAdminClient(
+        bootstrap_servers="localhost:9092",
+        client_id="test")
+    topic = "partitioned_topic"
+    if topic in admin_client.list_topics():
+        admin_client.delete_topics(topics=[topic], timeout_ms=5000)
+
+    admin_client.create_topics(
+        new_topics=[NewTopic(name=topic, num_partitions=4, replication_factor=1)], timeout_ms=5000)
+    yield topic
+    admin_client.delete_topics(topics=[topic], timeout_ms=5000)
+
+
 @pytest.fixture(scope="function")
 def kafka_producer():
     yield KafkaProducer(bootstrap_servers="localhost:9092")
@@ -0,0 +1,95 @@
+#!/usr/bin/python3
+
+# Copyright 2022 Memgraph Ltd.
+#
+# Use of this software is governed by the Business Source License
+# included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+# License, and you may not use this file except in compliance with the Business Source License.
+#
+# As of the Change Date specified in that file, in accordance with
+# the Business Source License, use of this software will be governed
+# by the Apache License, Version 2.0, included in the file
+# licenses/APL.txt.
+
+# These tests run against Memgraph started with --stream-partition-threads=4,
+# so the partitions of a batch are processed in parallel.
+
+import sys
+import time
+
+import common
+import pytest
+
+PARTITIONS = 4
+
+
+def send_to_partitions(kafka_producer, topic, messages_per_partition, payload):
+    for partition in range(PARTITIONS):
+        for i in range(messages_per_partition):
+            kafka_producer.send(topic, payload(partition, i).encode("utf-8"), partition=partition).get(timeout=60)
+
+
+def test_partitions_in_parallel(kafka_producer, kafka_partitioned_topic, connection):
+    cursor = connection.cursor()
+    common.execute_and_fetch_all(
+        cursor,
+        f"CREATE KAFKA STREAM test TOPICS {kafka_partitioned_topic} TRANSFORM kafka_transform.with_parameters "
+        "BATCH_INTERVAL 3000 BATCH_SIZE 1000",
+    )
+    common.start_stream(cursor, "test")
+    time.sleep(1)
+
+    MESSAGES_PER_PARTITION = 25
+    send_to_partitions(
+        kafka_producer, kafka_partitioned_topic, MESSAGES_PER_PARTITION, lambda partition, i: f"{partition}-{i}"
+    )
+
+    total = PARTITIONS * MESSAGES_PER_PARTITION
+    assert common.timed_wait(lambda: common.get_stream_stats(cursor, "test")["messages"] == total)
+    assert common.count_vertices(cursor, "MESSAGE") == total
+    for partition in range(PARTITIONS):
+        for i in range(MESSAGES_PER_PARTITION):
+            common.check_vertex_exists_with_properties(cursor, {"payload": f'"{partition}-{i}"'})
+    assert common.get_is_running(cursor, "test")
+
+
+def test_failed_partition_does_not_replay_committed_ones(kafka_producer, kafka_partitioned_topic, connection):
+    # The transformation executes the payload as the query. The last partition
+    # contains an invalid query, so its transaction fails while the other
+    # partitions are committed. After the stream is recreated, the committed
+    # partitions mustn't be executed again.
+    cursor = connection.cursor()
+    MESSAGES_PER_PARTITION = 5
+
+    def payload(partition, i):
+        if partition == PARTITIONS - 1:
+            return "CREATE (:MESSAGE {invalid"
+        return f"CREATE (:MESSAGE {{partition: {partition}, index: {i}}})"
+
+    send_to_partitions(kafka_producer, kafka_partitioned_topic, MESSAGES_PER_PARTITION, payload)
+
+    def create_and_start_stream():
+        common.execute_and_fetch_all(
+            cursor,
+            f"CREATE KAFKA STREAM test TOPICS {kafka_partitioned_topic} TRANSFORM kafka_transform.query "
+            "CONSUMER_GROUP parallel_test BATCH_INTERVAL 3000 BATCH_SIZE 1000",
+        )
+        common.start_stream(cursor, "test")
+
+    create_and_start_stream()
+    assert common.timed_wait(lambda: not common.get_is_running(cursor, "test"))
+    committed = (PARTITIONS - 1) * MESSAGES_PER_PARTITION
+    assert common.count_vertices(cursor, "MESSAGE") == committed
+
+    common.drop_stream(cursor, "test")
+    kafka_producer.send(
+        kafka_partitioned_topic, b"CREATE (:MESSAGE {partition: 0, index: -1})", partition=0
+    ).get(timeout=60)
+    create_and_start_stream()
+    assert common.timed_wait(lambda: common.count_vertices(cursor, "MESSAGE") == committed + 1)
+    assert common.timed_wait(lambda: not common.get_is_running(cursor, "test"))
+    assert common.count_vertices(cursor, "MESSAGE") == committed + 1
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__, "-rA"]))
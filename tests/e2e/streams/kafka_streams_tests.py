@@ -415,5 +415,37 @@ def test_check_stream_different_number_of_queries_than_messages(kafka_producer,
     common.test_check_stream_different_number_of_queries_than_messages(connection, stream_creator, message_sender)
 
 
+
+def test_stream_stats(kafka_producer, kafka_topics, connection):
+    assert len(kafka_topics) > 0
+    cursor = connection.cursor()
+    common.execute_and_fetch_all(
+        cursor,
+        f"CREATE KAFKA STREAM test TOPICS {kafka_topics[0]} TRANSFORM kafka_transform.with_parameters BATCH_SIZE 10",
+    )
+    stats = common.get_stream_stats(cursor, "test")
+    assert stats["messages"] == 0
+    assert stats["batches"] == 0
+    assert stats["queries"] == 0
+
+    common.start_stream(cursor, "test")
+    time.sleep(1)
+
+    MESSAGE_COUNT = 10
+    for i in range(MESSAGE_COUNT):
+        kafka_producer.send(kafka_topics[0], f"message {i}".encode("utf-8")).get(timeout=60)
+
+    assert common.timed_wait(lambda: common.get_stream_stats(cursor, "test")["messages"] == MESSAGE_COUNT)
+    assert common.count_vertices(cursor, "MESSAGE") == MESSAGE_COUNT
+
+    stats = common.get_stream_stats(cursor, "test")
+    assert 1 <= stats["batches"] <= MESSAGE_COUNT
+    # The queries of a batch share the query text, so they are executed as a
+    # single batched query.
+    assert stats["queries"] == stats["batches"]
+    assert stats["last_batch_duration_ms"] >= 0
+    assert stats["lag_ms"] >= 0
+
+
 if __name__ == "__main__":
     sys.exit(pytest.main([__file__, "-rA"]))
@@ -101,6 +101,10 @@ def execute_test(name, test_path, test_config, memgraph_binary,
 
     expected_path = test_config.pop("expected", "")
     import_should_fail = test_config.pop("import_should_fail", False)
+    expected_error = test_config.pop("expected_error", None)
+    if expected_error is not None and not import_should_fail:
+        raise Exception("The test can specify 'expected_error' only together "
+                        "with 'import_should_fail'!")
 
     # Generate common args
     properties_on_edges = bool(test_config.pop("properties_on_edges", False))
@@ -121,12 +125,19 @@ def execute_test(name, test_path, test_config, memgraph_binary,
             mg_import_csv_args.extend([flag, str(value)])
 
     # Execute mg_import_csv
-    ret = subprocess.run(mg_import_csv_args, cwd=test_path)
+    ret = subprocess.run(mg_import_csv_args, cwd=test_path,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = ret.stdout.decode("utf-8")
+    sys.stdout.write(output)
 
     if import_should_fail:
         if ret.returncode == 0:
             raise Exception("The import should have failed, but it "
                             "succeeded instead!")
+        elif expected_error is not None and expected_error not in output:
+            raise Exception("The import should have failed with '{}', but "
+                            "it failed with a different error!".format(
+                                expected_error))
         else:
             print("\033[1;32m~~ Test successful ~~\033[0m\n")
             return
@@ -143,6 +143,7 @@ class InteractiveDbAccessor {
   auto NameToLabel(const std::string &name) { return dba_->NameToLabel(name); }
   auto NameToProperty(const std::string &name) { return dba_->NameToProperty(name); }
   auto NameToEdgeType(const std::string &name) { return dba_->NameToEdgeType(name); }
+  auto PropertyToName(memgraph::storage::PropertyId property) { return dba_->PropertyToName(property); }
 
   int64_t VerticesCount() { return vertices_count_; }
 
@@ -213,6 +214,33 @@ class InteractiveDbAccessor {
     return label_property_index_.at(key);
   }
 
+  // Edge type, label+properties and text indices aren't asked for, so they
+  // are never used when planning interactively.
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId) { return false; }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId) { return 0; }
+
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertiesIndices(memgraph::storage::LabelId) {
+    return {};
+  }
+
+  bool LabelPropertiesIndexExists(memgraph::storage::LabelId, const std::vector<memgraph::storage::PropertyId> &) {
+    return false;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId, const std::vector<memgraph::storage::PropertyId> &) { return 0; }
+
+  int64_t VerticesCount(memgraph::storage::LabelId, const std::vector<memgraph::storage::PropertyId> &,
+                        const std::vector<memgraph::storage::PropertyValue> &) {
+    return 0;
+  }
+
+  bool TextIndexExists(memgraph::storage::LabelId, memgraph::storage::PropertyId) { return false; }
+
+  int64_t TextVerticesCount(memgraph::storage::LabelId, memgraph::storage::PropertyId) { return 0; }
+
+  int64_t TextVerticesCount(memgraph::storage::LabelId, memgraph::storage::PropertyId, std::string_view) { return 0; }
+
   // Save the cached vertex counts to a stream.
   void Save(std::ostream &out) {
     out << "vertex-count " << vertices_count_ << std::endl;
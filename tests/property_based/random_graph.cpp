@@ -40,7 +40,7 @@ RC_GTEST_PROP(RandomGraph, RandomGraph, (std::vector<std::string> vertex_labels,
   auto dba = db.Access();
 
   for (auto label : vertex_labels) {
-    auto vertex_accessor = dba.CreateVertex();
+    auto vertex_accessor = dba.CreateVertex().GetValue();
     RC_ASSERT(vertex_accessor.AddLabel(dba.NameToLabel(label)).HasValue());
     vertex_label_map.insert({vertex_accessor, label});
     vertices.push_back(vertex_accessor);
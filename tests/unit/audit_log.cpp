@@ -0,0 +1,222 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "audit/encoding.hpp"
+#include "audit/log.hpp"
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/temporal.hpp"
+#include "utils/event_counter.hpp"
+#include "utils/file.hpp"
+#include "utils/string.hpp"
+
+namespace EventCounter {
+extern const Event AuditRecordsDropped;
+}  // namespace EventCounter
+
+using memgraph::audit::Log;
+using memgraph::storage::PropertyValue;
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path &path) {
+  std::ifstream stream(path, std::ios::binary);
+  std::stringstream ss;
+  ss << stream.rdbuf();
+  return ss.str();
+}
+
+std::vector<std::string> ReadLines(const std::filesystem::path &path) {
+  auto data = ReadFile(path);
+  auto lines = memgraph::utils::Split(data, "\n");
+  if (!lines.empty() && lines.back().empty()) lines.pop_back();
+  return lines;
+}
+
+// Returns everything in the line after the timestamp.
+std::string WithoutTimestamp(const std::string &line) { return line.substr(line.find(',') + 1); }
+
+PropertyValue MakeParams() {
+  std::map<std::string, PropertyValue> params{
+      {"null", PropertyValue()},
+      {"bool", PropertyValue(true)},
+      {"int", PropertyValue(42)},
+      {"double", PropertyValue(3.5)},
+      {"string", PropertyValue("a \"quoted\"\nstring")},
+      {"list", PropertyValue(std::vector<PropertyValue>{PropertyValue(1), PropertyValue("two")})},
+      {"date", PropertyValue(memgraph::storage::TemporalData(memgraph::storage::TemporalType::Date, 0))},
+  };
+  return PropertyValue(std::move(params));
+}
+
+}  // namespace
+
+class AuditLogTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::filesystem::remove_all(directory_); }
+
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  std::filesystem::path directory_{std::filesystem::temp_directory_path() / "MG_tests_unit_audit_log"};
+};
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(AuditEncoding, RoundTrip) {
+  std::string buffer;
+  memgraph::audit::EncodeRecord(&buffer, 1234567890123456, "127.0.0.1", "user", "RETURN $x", MakeParams());
+  memgraph::audit::EncodeRecord(&buffer, 1, "", "", "", PropertyValue());
+
+  std::string_view data = buffer;
+  auto first = memgraph::audit::DecodeRecord(&data);
+  ASSERT_TRUE(first);
+  ASSERT_EQ(first->timestamp, 1234567890123456);
+  ASSERT_EQ(first->address, "127.0.0.1");
+  ASSERT_EQ(first->username, "user");
+  ASSERT_EQ(first->query, "RETURN $x");
+  ASSERT_EQ(memgraph::audit::FormatRecord(*first),
+            "1234567890.123456,127.0.0.1,user,\"RETURN $x\",\"{\\\"bool\\\":true,\\\"date\\\":\\\"1970-01-01\\\","
+            "\\\"double\\\":3.5,\\\"int\\\":42,\\\"list\\\":[1,\\\"two\\\"],\\\"null\\\":null,"
+            "\\\"string\\\":\\\"a \\\\\\\"quoted\\\\\\\"\\\\nstring\\\"}\"\n");
+
+  auto second = memgraph::audit::DecodeRecord(&data);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(memgraph::audit::FormatRecord(*second), "0.000001,,,\"\",\"null\"\n");
+  ASSERT_TRUE(data.empty());
+  ASSERT_FALSE(memgraph::audit::DecodeRecord(&data));
+
+  // Truncated records aren't decoded and the data isn't consumed.
+  std::string_view truncated(buffer.data(), 10);
+  ASSERT_FALSE(memgraph::audit::DecodeRecord(&truncated));
+  ASSERT_EQ(truncated.size(), 10);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(AuditLogTest, TextAndBinary) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumRecords = 1000;
+  auto record = [](Log *log) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back([log, i] {
+        for (int j = 0; j < kNumRecords; ++j) {
+          log->Record("127.0.0.1", "user" + std::to_string(i), "RETURN " + std::to_string(j), MakeParams());
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  {
+    Log log(directory_ / "text", 100, 10);
+    log.Start();
+    record(&log);
+  }
+  {
+    Log log(directory_ / "binary", 100, 10, Log::Format::BINARY);
+    log.Start();
+    record(&log);
+  }
+
+  auto lines = ReadLines(directory_ / "text" / "audit.log");
+  ASSERT_EQ(lines.size(), kNumThreads * kNumRecords);
+
+  auto data = ReadFile(directory_ / "binary" / "audit.bin");
+  ASSERT_TRUE(data.starts_with(memgraph::audit::kBinaryMagic));
+  std::string_view rest(data);
+  rest.remove_prefix(memgraph::audit::kBinaryMagic.size());
+  std::vector<std::string> converted;
+  while (auto decoded = memgraph::audit::DecodeRecord(&rest)) {
+    converted.push_back(memgraph::audit::FormatRecord(*decoded));
+    converted.back().pop_back();
+  }
+  ASSERT_TRUE(rest.empty());
+  ASSERT_EQ(converted.size(), lines.size());
+
+  // The entries of each thread are written in the order they were recorded.
+  std::vector<std::string> text_entries;
+  std::vector<std::string> binary_entries;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    text_entries.push_back(WithoutTimestamp(lines[i]));
+    binary_entries.push_back(WithoutTimestamp(converted[i]));
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    const auto prefix = "127.0.0.1,user" + std::to_string(i) + ",";
+    int text_next = 0;
+    int binary_next = 0;
+    for (size_t j = 0; j < lines.size(); ++j) {
+      if (text_entries[j].starts_with(prefix)) {
+        ASSERT_TRUE(text_entries[j].starts_with(prefix + "\"RETURN " + std::to_string(text_next++) + "\""));
+      }
+      if (binary_entries[j].starts_with(prefix)) {
+        ASSERT_TRUE(binary_entries[j].starts_with(prefix + "\"RETURN " + std::to_string(binary_next++) + "\""));
+      }
+    }
+    ASSERT_EQ(text_next, kNumRecords);
+    ASSERT_EQ(binary_next, kNumRecords);
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(AuditLogTest, DropOnFull) {
+  const auto dropped_before = EventCounter::global_counters[EventCounter::AuditRecordsDropped].load();
+  {
+    // The buffer is flushed rarely enough that it fills up.
+    Log log(directory_, 10, 100000, Log::Format::TEXT, true);
+    log.Start();
+    for (int i = 0; i < 25; ++i) {
+      log.Record("127.0.0.1", "user", "RETURN 1", PropertyValue());
+    }
+  }
+  ASSERT_EQ(ReadLines(directory_ / "audit.log").size(), 10);
+  ASSERT_EQ(EventCounter::global_counters[EventCounter::AuditRecordsDropped].load() - dropped_before, 15);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(AuditLogTest, BufferSizeIsShared) {
+  constexpr int kNumThreads = 4;
+  const auto dropped_before = EventCounter::global_counters[EventCounter::AuditRecordsDropped].load();
+  {
+    Log log(directory_, 10, 100000, Log::Format::TEXT, true);
+    log.Start();
+    // Each thread exits before the next one starts, so the buffers of the
+    // exited threads still hold their entries when the log is flushed.
+    for (int i = 0; i < kNumThreads; ++i) {
+      std::thread([&log] {
+        for (int j = 0; j < 10; ++j) {
+          log.Record("127.0.0.1", "user", "RETURN 1", PropertyValue());
+        }
+      }).join();
+    }
+  }
+  ASSERT_EQ(ReadLines(directory_ / "audit.log").size(), 10);
+  ASSERT_EQ(EventCounter::global_counters[EventCounter::AuditRecordsDropped].load() - dropped_before,
+            (kNumThreads - 1) * 10);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(AuditLogTest, NotStarted) {
+  {
+    Log log(directory_, 10, 10);
+    log.Record("127.0.0.1", "user", "RETURN 1", PropertyValue());
+  }
+  ASSERT_FALSE(std::filesystem::exists(directory_ / "audit.log"));
+}
@@ -670,6 +670,64 @@ TEST_F(AuthWithStorage, CaseInsensitivity) {
   }
 }
 
+TEST_F(AuthWithStorage, CompilePermissions) {
+  {
+    auto compiled = auth.CompilePermissions("alice");
+    ASSERT_FALSE(compiled.has_users);
+    ASSERT_FALSE(compiled.permissions);
+  }
+
+  auto version = auth.version().load();
+  auto user = auth.AddUser("alice");
+  ASSERT_TRUE(user);
+  ASSERT_GT(auth.version().load(), version);
+  version = auth.version().load();
+
+  auto role = auth.AddRole("moderator");
+  ASSERT_TRUE(role);
+  ASSERT_GT(auth.version().load(), version);
+
+  role->permissions().Grant(Permission::MATCH);
+  auth.SaveRole(*role);
+  user->permissions().Grant(Permission::CREATE);
+  user->SetRole(*role);
+  auth.SaveUser(*user);
+
+  {
+    auto compiled = auth.CompilePermissions("alice");
+    ASSERT_EQ(compiled.version, auth.version().load());
+    ASSERT_TRUE(compiled.has_users);
+    ASSERT_TRUE(compiled.permissions);
+    ASSERT_EQ(compiled.permissions->Has(Permission::MATCH), PermissionLevel::GRANT);
+    ASSERT_EQ(compiled.permissions->Has(Permission::CREATE), PermissionLevel::GRANT);
+    ASSERT_EQ(compiled.permissions->Has(Permission::DELETE), PermissionLevel::NEUTRAL);
+  }
+  {
+    auto compiled = auth.CompilePermissions("bob");
+    ASSERT_TRUE(compiled.has_users);
+    ASSERT_FALSE(compiled.permissions);
+  }
+  {
+    auto compiled = auth.CompilePermissions(std::nullopt);
+    ASSERT_TRUE(compiled.has_users);
+    ASSERT_FALSE(compiled.permissions);
+  }
+
+  version = auth.version().load();
+  ASSERT_TRUE(auth.RemoveRole("moderator"));
+  ASSERT_GT(auth.version().load(), version);
+  {
+    auto compiled = auth.CompilePermissions("alice");
+    ASSERT_TRUE(compiled.permissions);
+    ASSERT_EQ(compiled.permissions->Has(Permission::MATCH), PermissionLevel::NEUTRAL);
+  }
+
+  version = auth.version().load();
+  ASSERT_TRUE(auth.RemoveUser("alice"));
+  ASSERT_GT(auth.version().load(), version);
+  ASSERT_FALSE(auth.CompilePermissions("alice").permissions);
+}
+
 TEST(AuthWithoutStorage, Crypto) {
   auto hash = EncryptPassword("hello");
   ASSERT_TRUE(VerifyPassword("hello", hash));
@@ -9,7 +9,11 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <atomic>
+#include <thread>
+
 #include "bfs_common.hpp"
+#include "query/exceptions.hpp"
 
 using namespace memgraph::query;
 using namespace memgraph::query::plan;
@@ -111,3 +115,246 @@ INSTANTIATE_TEST_CASE_P(FilterLambda, SingleNodeBfsTest,
                                          testing::Values(FilterLambdaType::NONE, FilterLambdaType::USE_FRAME,
                                                          FilterLambdaType::USE_FRAME_NULL, FilterLambdaType::USE_CTX,
                                                          FilterLambdaType::ERROR)));
+
+// The graph has a root connected to many middle vertices which all lead to a
+// few leaves, so the frontiers are large enough to be expanded in parallel.
+TEST(SingleNodeBfsTest, LargeFrontier) {
+  constexpr int kMiddleCount = 20000;
+  constexpr int kLeafCount = 100;
+
+  SingleNodeDb db;
+  auto storage_dba = db.Access();
+  DbAccessor dba(&storage_dba);
+  ExecutionContext context{&dba};
+  auto source_sym = context.symbol_table.CreateSymbol("source", true);
+  auto sink_sym = context.symbol_table.CreateSymbol("sink", true);
+  auto edges_sym = context.symbol_table.CreateSymbol("edges", true);
+  auto inner_node_sym = context.symbol_table.CreateSymbol("inner_node", true);
+  auto inner_edge_sym = context.symbol_table.CreateSymbol("inner_edge", true);
+
+  auto edge_type = dba.NameToEdgeType("edge");
+  auto root = dba.InsertVertex();
+  std::vector<memgraph::query::VertexAccessor> leaves;
+  for (int i = 0; i < kLeafCount; ++i) leaves.push_back(dba.InsertVertex());
+  for (int i = 0; i < kMiddleCount; ++i) {
+    auto middle = dba.InsertVertex();
+    ASSERT_TRUE(dba.InsertEdge(&root, &middle, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&middle, &leaves[i % kLeafCount], edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  {
+    // Single source: every vertex except the root is reached.
+    auto input_op = YieldVertices(&dba, {root}, source_sym, nullptr);
+    auto bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, std::move(input_op),
+                                  false, nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, nullptr});
+    auto results = PullResults(bfs.get(), &context, {sink_sym, edges_sym});
+    ASSERT_EQ(results.size(), kMiddleCount + kLeafCount);
+    int leaf_count = 0;
+    for (const auto &row : results) {
+      const auto &sink = row[0].ValueVertex();
+      const auto &path = row[1].ValueList();
+      if (std::find(leaves.begin(), leaves.end(), sink) != leaves.end()) {
+        ++leaf_count;
+        ASSERT_EQ(path.size(), 2);
+        EXPECT_EQ(path[0].ValueEdge().From(), root);
+        EXPECT_EQ(path[1].ValueEdge().To(), sink);
+      } else {
+        ASSERT_EQ(path.size(), 1);
+        EXPECT_EQ(path[0].ValueEdge().From(), root);
+        EXPECT_EQ(path[0].ValueEdge().To(), sink);
+      }
+    }
+    EXPECT_EQ(leaf_count, kLeafCount);
+  }
+
+  {
+    // Source and sink: the shortest path from the root to each leaf.
+    auto input_op = YieldVertices(&dba, {root}, source_sym, nullptr);
+    input_op = YieldVertices(&dba, leaves, sink_sym, std::move(input_op));
+    auto bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, std::move(input_op),
+                                  true, nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, nullptr});
+    auto results = PullResults(bfs.get(), &context, {sink_sym, edges_sym});
+    ASSERT_EQ(results.size(), kLeafCount);
+    for (const auto &row : results) {
+      const auto &path = row[1].ValueList();
+      ASSERT_EQ(path.size(), 2);
+      EXPECT_EQ(path[0].ValueEdge().From(), root);
+      EXPECT_EQ(path[0].ValueEdge().To(), path[1].ValueEdge().From());
+      EXPECT_EQ(path[1].ValueEdge().To(), row[0].ValueVertex());
+    }
+  }
+
+  dba.Abort();
+}
+
+// The filter lambda is evaluated by the workers on the parallel path, so it
+// has to see the frame and the properties the same way the sequential path
+// does.
+TEST(SingleNodeBfsTest, LargeFrontierFilterLambda) {
+  constexpr int kMiddleCount = 20000;
+  constexpr int kLeafCount = 100;
+
+  SingleNodeDb db;
+  auto storage_dba = db.Access();
+  DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  ExecutionContext context{&dba};
+  auto blocked_sym = context.symbol_table.CreateSymbol("blocked", true);
+  auto source_sym = context.symbol_table.CreateSymbol("source", true);
+  auto sink_sym = context.symbol_table.CreateSymbol("sink", true);
+  auto edges_sym = context.symbol_table.CreateSymbol("edges", true);
+  auto inner_node_sym = context.symbol_table.CreateSymbol("inner_node", true);
+  auto inner_edge_sym = context.symbol_table.CreateSymbol("inner_edge", true);
+  auto *blocked = IDENT("blocked")->MapTo(blocked_sym);
+  auto *inner_node = IDENT("inner_node")->MapTo(inner_node_sym);
+
+  // Every third middle vertex has the parity 1 and is filtered out, the rest
+  // still lead to every leaf.
+  auto edge_type = dba.NameToEdgeType("edge");
+  auto parity = dba.NameToProperty("parity");
+  auto root = dba.InsertVertex();
+  std::vector<memgraph::query::VertexAccessor> leaves;
+  for (int i = 0; i < kLeafCount; ++i) {
+    leaves.push_back(dba.InsertVertex());
+    ASSERT_TRUE(leaves.back().SetProperty(parity, memgraph::storage::PropertyValue(0)).HasValue());
+  }
+  for (int i = 0; i < kMiddleCount; ++i) {
+    auto middle = dba.InsertVertex();
+    ASSERT_TRUE(middle.SetProperty(parity, memgraph::storage::PropertyValue(i % 3)).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&root, &middle, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&middle, &leaves[i % kLeafCount], edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  // The first leaf is blocked through the frame.
+  std::shared_ptr<LogicalOperator> input_op = std::make_shared<Yield>(
+      nullptr, std::vector<Symbol>{blocked_sym}, std::vector<std::vector<TypedValue>>{{TypedValue(leaves[0])}});
+  input_op = YieldVertices(&dba, {root}, source_sym, input_op);
+  auto *filter_expr =
+      AND(NEQ(inner_node, blocked), NEQ(PROPERTY_LOOKUP(inner_node, PROPERTY_PAIR("parity")), LITERAL(1)));
+  auto bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, input_op, false,
+                                nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, filter_expr});
+  context.evaluation_context.properties = NamesToProperties(storage.properties_, &dba);
+  context.evaluation_context.labels = NamesToLabels(storage.labels_, &dba);
+
+  auto results = PullResults(bfs.get(), &context, {sink_sym, edges_sym});
+  ASSERT_EQ(results.size(), kMiddleCount - (kMiddleCount + 1) / 3 + kLeafCount - 1);
+  int leaf_count = 0;
+  for (const auto &row : results) {
+    const auto &sink = row[0].ValueVertex();
+    const auto &path = row[1].ValueList();
+    EXPECT_NE(sink, leaves[0]);
+    const auto &middle = path[0].ValueEdge().To();
+    EXPECT_NE(middle.GetProperty(memgraph::storage::View::OLD, parity)->ValueInt(), 1);
+    if (std::find(leaves.begin(), leaves.end(), sink) != leaves.end()) {
+      ++leaf_count;
+      ASSERT_EQ(path.size(), 2);
+      EXPECT_EQ(path[1].ValueEdge().To(), sink);
+    } else {
+      ASSERT_EQ(path.size(), 1);
+      EXPECT_EQ(middle, sink);
+    }
+  }
+  EXPECT_EQ(leaf_count, kLeafCount - 1);
+
+  dba.Abort();
+}
+
+// A filter that calls `counter` depends on the order of the evaluations, so a
+// large frontier is expanded on the pulling thread and the counter is shared
+// by all of the evaluations.
+TEST(SingleNodeBfsTest, LargeFrontierStatefulFilterLambda) {
+  constexpr int kMiddleCount = 20000;
+  constexpr int kLeafCount = 100;
+
+  SingleNodeDb db;
+  auto storage_dba = db.Access();
+  DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  ExecutionContext context{&dba};
+  auto source_sym = context.symbol_table.CreateSymbol("source", true);
+  auto sink_sym = context.symbol_table.CreateSymbol("sink", true);
+  auto edges_sym = context.symbol_table.CreateSymbol("edges", true);
+  auto inner_node_sym = context.symbol_table.CreateSymbol("inner_node", true);
+  auto inner_edge_sym = context.symbol_table.CreateSymbol("inner_edge", true);
+
+  auto edge_type = dba.NameToEdgeType("edge");
+  auto root = dba.InsertVertex();
+  std::vector<memgraph::query::VertexAccessor> leaves;
+  for (int i = 0; i < kLeafCount; ++i) leaves.push_back(dba.InsertVertex());
+  for (int i = 0; i < kMiddleCount; ++i) {
+    auto middle = dba.InsertVertex();
+    ASSERT_TRUE(dba.InsertEdge(&root, &middle, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&middle, &leaves[i % kLeafCount], edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  // All of the middle vertices pass the filter and then only the first half
+  // of the leaves, in the order in which they are reached.
+  auto input_op = YieldVertices(&dba, {root}, source_sym, nullptr);
+  auto *filter_expr =
+      LESS_EQ(FN("counter", LITERAL("expansions"), LITERAL(1)), LITERAL(kMiddleCount + kLeafCount / 2));
+  auto bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, std::move(input_op),
+                                false, nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, filter_expr});
+
+  auto results = PullResults(bfs.get(), &context, {sink_sym, edges_sym});
+  ASSERT_EQ(results.size(), kMiddleCount + kLeafCount / 2);
+  int leaf_count = 0;
+  for (const auto &row : results) {
+    const auto &sink = row[0].ValueVertex();
+    auto leaf = std::find(leaves.begin(), leaves.end(), sink);
+    if (leaf == leaves.end()) continue;
+    ++leaf_count;
+    EXPECT_LT(leaf - leaves.begin(), kLeafCount / 2);
+  }
+  EXPECT_EQ(leaf_count, kLeafCount / 2);
+
+  dba.Abort();
+}
+
+// The search is aborted while it runs, either between the levels or by the
+// workers in the middle of a large level.
+TEST(SingleNodeBfsTest, LargeFrontierAbort) {
+  constexpr int kMiddleCount = 20000;
+  constexpr int kLeafCount = 100;
+
+  SingleNodeDb db;
+  auto storage_dba = db.Access();
+  DbAccessor dba(&storage_dba);
+  ExecutionContext context{&dba};
+  std::atomic<bool> is_shutting_down{false};
+  context.is_shutting_down = &is_shutting_down;
+  auto source_sym = context.symbol_table.CreateSymbol("source", true);
+  auto sink_sym = context.symbol_table.CreateSymbol("sink", true);
+  auto edges_sym = context.symbol_table.CreateSymbol("edges", true);
+  auto inner_node_sym = context.symbol_table.CreateSymbol("inner_node", true);
+  auto inner_edge_sym = context.symbol_table.CreateSymbol("inner_edge", true);
+
+  auto edge_type = dba.NameToEdgeType("edge");
+  auto root = dba.InsertVertex();
+  std::vector<memgraph::query::VertexAccessor> leaves;
+  for (int i = 0; i < kLeafCount; ++i) leaves.push_back(dba.InsertVertex());
+  for (int i = 0; i < kMiddleCount; ++i) {
+    auto middle = dba.InsertVertex();
+    ASSERT_TRUE(dba.InsertEdge(&root, &middle, edge_type).HasValue());
+    ASSERT_TRUE(dba.InsertEdge(&middle, &leaves[i % kLeafCount], edge_type).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  auto input_op = YieldVertices(&dba, {root}, source_sym, nullptr);
+  auto bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, std::move(input_op),
+                                false, nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, nullptr});
+  std::thread terminator([&is_shutting_down] { is_shutting_down.store(true, std::memory_order_release); });
+  EXPECT_THROW(PullResults(bfs.get(), &context, {sink_sym, edges_sym}), HintedAbortError);
+  terminator.join();
+
+  // Nothing is left running after the abort, so the next search works.
+  is_shutting_down.store(false, std::memory_order_release);
+  input_op = YieldVertices(&dba, {root}, source_sym, nullptr);
+  bfs = db.MakeBfsOperator(source_sym, sink_sym, edges_sym, EdgeAtom::Direction::OUT, {}, std::move(input_op), false,
+                           nullptr, nullptr, ExpansionLambda{inner_edge_sym, inner_node_sym, nullptr});
+  EXPECT_EQ(PullResults(bfs.get(), &context, {sink_sym, edges_sym}).size(), kMiddleCount + kLeafCount);
+
+  dba.Abort();
+}
@@ -180,8 +180,8 @@ TEST_F(BoltEncoder, VertexAndEdge) {
   // create vertex
   memgraph::storage::Storage db;
   auto dba = db.Access();
-  auto va1 = dba.CreateVertex();
-  auto va2 = dba.CreateVertex();
+  auto va1 = dba.CreateVertex().GetValue();
+  auto va2 = dba.CreateVertex().GetValue();
   auto l1 = dba.NameToLabel("label1");
   auto l2 = dba.NameToLabel("label2");
   ASSERT_TRUE(va1.AddLabel(l1).HasValue());
@@ -76,7 +76,7 @@ class TestSession : public Session<TestInputStream, TestOutputStream> {
 
   std::map<std::string, Value> Discard(std::optional<int>, std::optional<int>) override { return {}; }
 
-  void BeginTransaction() override {}
+  void BeginTransaction(bool) override {}
   void CommitTransaction() override {}
   void RollbackTransaction() override {}
 
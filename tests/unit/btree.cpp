@@ -0,0 +1,300 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/btree.hpp"
+
+namespace {
+
+struct Object {
+  uint64_t key;
+  uint64_t value;
+};
+
+using Tree = memgraph::utils::BTree<Object, &Object::key>;
+
+}  // namespace
+
+TEST(BTree, Basic) {
+  Tree tree;
+  {
+    auto acc = tree.access();
+    ASSERT_EQ(acc.begin(), acc.end());
+    for (uint64_t i = 0; i < 10000; ++i) {
+      auto res = acc.insert(Object{i, i * 2});
+      ASSERT_EQ(res.first->key, i);
+      ASSERT_TRUE(res.second);
+    }
+    ASSERT_EQ(acc.size(), 10000);
+  }
+  {
+    auto acc = tree.access();
+    for (uint64_t i = 0; i < 10000; ++i) {
+      auto res = acc.insert(Object{i, 0});
+      ASSERT_EQ(res.first->value, i * 2);
+      ASSERT_FALSE(res.second);
+    }
+    ASSERT_EQ(acc.size(), 10000);
+  }
+  {
+    auto acc = tree.access();
+    uint64_t val = 0;
+    for (auto &item : acc) {
+      ASSERT_EQ(item.key, val);
+      ++val;
+    }
+    ASSERT_EQ(val, 10000);
+  }
+  {
+    auto acc = tree.access();
+    for (uint64_t i = 0; i < 10000; ++i) {
+      auto it = acc.find(i);
+      ASSERT_NE(it, acc.end());
+      ASSERT_EQ(it->value, i * 2);
+      ASSERT_TRUE(acc.contains(i));
+    }
+    ASSERT_EQ(acc.find(10000), acc.end());
+    ASSERT_FALSE(acc.contains(10000));
+  }
+  {
+    auto acc = tree.access();
+    for (uint64_t i = 0; i < 10000; ++i) {
+      ASSERT_TRUE(acc.remove(i));
+    }
+    ASSERT_EQ(acc.size(), 0);
+    ASSERT_EQ(acc.begin(), acc.end());
+    for (uint64_t i = 0; i < 10000; ++i) {
+      ASSERT_FALSE(acc.remove(i));
+    }
+  }
+}
+
+TEST(BTree, RandomOrder) {
+  std::vector<uint64_t> keys(20000);
+  for (uint64_t i = 0; i < keys.size(); ++i) keys[i] = i * 3;
+  std::mt19937 gen(42);
+  std::shuffle(keys.begin(), keys.end(), gen);
+
+  Tree tree;
+  auto acc = tree.access();
+  for (auto key : keys) {
+    ASSERT_TRUE(acc.insert(Object{key, key}).second);
+  }
+  // Remove every other key so that some of the leaves become sparse.
+  for (uint64_t i = 0; i < keys.size(); i += 2) {
+    ASSERT_TRUE(acc.remove(keys[i]));
+  }
+  std::vector<uint64_t> remaining;
+  for (uint64_t i = 1; i < keys.size(); i += 2) remaining.push_back(keys[i]);
+  std::sort(remaining.begin(), remaining.end());
+
+  std::vector<uint64_t> iterated;
+  for (const auto &item : acc) iterated.push_back(item.key);
+  ASSERT_EQ(iterated, remaining);
+  ASSERT_EQ(acc.size(), remaining.size());
+
+  for (uint64_t i = 0; i < 60000; i += 7) {
+    auto it = acc.find_equal_or_greater(i);
+    auto expected_it = std::lower_bound(remaining.begin(), remaining.end(), i);
+    if (expected_it == remaining.end()) {
+      ASSERT_EQ(it, acc.end());
+    } else {
+      ASSERT_NE(it, acc.end());
+      ASSERT_EQ(it->key, *expected_it);
+    }
+  }
+}
+
+TEST(BTree, EmptyLeaves) {
+  Tree tree;
+  auto acc = tree.access();
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(acc.insert(Object{i, i}).second);
+  }
+  // Empty out whole leaves in the middle of the tree; iteration must skip them.
+  for (uint64_t i = 100; i < 900; ++i) {
+    ASSERT_TRUE(acc.remove(i));
+  }
+  uint64_t count = 0;
+  uint64_t prev = 0;
+  for (const auto &item : acc) {
+    if (count > 0) ASSERT_GT(item.key, prev);
+    prev = item.key;
+    ++count;
+  }
+  ASSERT_EQ(count, 200);
+  auto it = acc.find_equal_or_greater(100);
+  ASSERT_NE(it, acc.end());
+  ASSERT_EQ(it->key, 900);
+}
+
+TEST(BTree, SequentialInsertIsDense) {
+  const uint64_t kNumKeys = 64000;
+  Tree tree;
+  auto acc = tree.access();
+  for (uint64_t i = 0; i < kNumKeys; ++i) {
+    ASSERT_TRUE(acc.insert(Object{i, i}).second);
+  }
+  // Appends split the nodes to the right, so all leaves but the last one hold
+  // `kBTreeLeafCapacity - 1` keys.
+  const uint64_t leaves = kNumKeys / (memgraph::utils::kBTreeLeafCapacity - 1) + 1;
+  ASSERT_LE(tree.node_count(), leaves + leaves / (memgraph::utils::kBTreeInnerCapacity - 1) + 4);
+}
+
+TEST(BTree, EmptyLeavesAreFreed) {
+  const uint64_t kNumKeys = 10000;
+  Tree tree;
+  {
+    auto acc = tree.access();
+    for (uint64_t i = 0; i < kNumKeys; ++i) {
+      ASSERT_TRUE(acc.insert(Object{i, i}).second);
+    }
+  }
+  const uint64_t full_count = tree.node_count();
+  {
+    auto reader = tree.access();
+    auto it = reader.find(kNumKeys / 2);
+    ASSERT_NE(it, reader.end());
+    {
+      auto acc = tree.access();
+      for (uint64_t i = 0; i < kNumKeys; ++i) {
+        ASSERT_TRUE(acc.remove(i));
+      }
+    }
+    tree.run_gc();
+    // The unlinked nodes can still be reached by the older accessor.
+    ASSERT_EQ(tree.node_count(), full_count);
+    ASSERT_EQ(it->value, kNumKeys / 2);
+    ++it;
+    ASSERT_EQ(it, reader.end());
+  }
+  tree.run_gc();
+  // Only the nodes on the path from the root to the last leaf are left.
+  ASSERT_LE(tree.node_count(), 4);
+  {
+    auto acc = tree.access();
+    ASSERT_EQ(acc.begin(), acc.end());
+    for (uint64_t i = 0; i < kNumKeys; i += 3) {
+      ASSERT_TRUE(acc.insert(Object{i, i}).second);
+    }
+    uint64_t count = 0;
+    for (const auto &item : acc) {
+      ASSERT_EQ(item.key, count * 3);
+      ++count;
+    }
+    ASSERT_EQ(count, acc.size());
+  }
+}
+
+TEST(BTree, SlidingWindowKeepsNodeCountBounded) {
+  const uint64_t kWindow = 1000;
+  Tree tree;
+  for (uint64_t i = 0; i < 200000; ++i) {
+    auto acc = tree.access();
+    ASSERT_TRUE(acc.insert(Object{i, i}).second);
+    if (i >= kWindow) ASSERT_TRUE(acc.remove(i - kWindow));
+  }
+  tree.run_gc();
+  ASSERT_EQ(tree.size(), kWindow);
+  // Without freeing the emptied leaves the tree would keep a leaf for every 63
+  // keys that were ever inserted.
+  ASSERT_LE(tree.node_count(), 2 * kWindow / (memgraph::utils::kBTreeLeafCapacity / 2) + 8);
+}
+
+TEST(BTree, IterateWhileModifying) {
+  Tree tree;
+  auto acc = tree.access();
+  for (uint64_t i = 0; i < 1000; i += 2) {
+    ASSERT_TRUE(acc.insert(Object{i, i}).second);
+  }
+  // Inserting behind the iterator splits the leaf it is positioned in, the
+  // iterator must continue from the next larger key.
+  uint64_t prev = 0;
+  uint64_t count = 0;
+  for (auto it = acc.begin(); it != acc.end(); ++it) {
+    if (count > 0) ASSERT_GT(it->key, prev);
+    prev = it->key;
+    ++count;
+    if (it->key % 2 == 0 && it->key < 1000) {
+      acc.insert(Object{it->key + 1, 0});
+      acc.remove(it->key);
+    }
+  }
+  ASSERT_EQ(acc.size(), 500);
+}
+
+TEST(BTree, Clear) {
+  Tree tree;
+  {
+    auto acc = tree.access();
+    for (uint64_t i = 0; i < 10000; ++i) {
+      ASSERT_TRUE(acc.insert(Object{i, i}).second);
+    }
+  }
+  tree.clear();
+  ASSERT_EQ(tree.size(), 0);
+  {
+    auto acc = tree.access();
+    ASSERT_EQ(acc.begin(), acc.end());
+    ASSERT_TRUE(acc.insert(Object{5, 5}).second);
+    ASSERT_EQ(acc.size(), 1);
+  }
+}
+
+TEST(BTree, Concurrent) {
+  const uint64_t kNumThreads = 8;
+  const uint64_t kNumKeys = 20000;
+  Tree tree;
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&tree, t] {
+      std::mt19937 gen(t);
+      std::uniform_int_distribution<uint64_t> dist(0, kNumKeys - 1);
+      for (uint64_t i = 0; i < 50000; ++i) {
+        auto acc = tree.access();
+        auto key = dist(gen);
+        switch (i % 4) {
+          case 0:
+          case 1:
+            acc.insert(Object{key, key});
+            break;
+          case 2:
+            acc.remove(key);
+            break;
+          case 3: {
+            auto it = acc.find(key);
+            if (it != acc.end()) ASSERT_EQ(it->value, key);
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  auto acc = tree.access();
+  uint64_t count = 0;
+  uint64_t prev = 0;
+  for (const auto &item : acc) {
+    if (count > 0) ASSERT_GT(item.key, prev);
+    prev = item.key;
+    ++count;
+  }
+  ASSERT_EQ(count, acc.size());
+}
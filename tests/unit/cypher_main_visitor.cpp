@@ -3362,6 +3362,33 @@ TEST_P(CypherMainVisitorTest, TestLoadCsvClause) {
   }
 }
 
+TEST_P(CypherMainVisitorTest, UsingPeriodicCommit) {
+  auto &ast_generator = *GetParam();
+
+  ASSERT_THROW(ast_generator.ParseQuery(R"(USING PERIODIC COMMIT LOAD CSV FROM "file.csv" NO HEADER AS x CREATE ())"),
+               SyntaxException);
+  ASSERT_THROW(ast_generator.ParseQuery(R"(LOAD CSV FROM "file.csv" NO HEADER AS x CREATE () USING PERIODIC COMMIT 1)"),
+               SyntaxException);
+  // USING PERIODIC COMMIT can only be used together with LOAD CSV.
+  ASSERT_THROW(ast_generator.ParseQuery("USING PERIODIC COMMIT 10 UNWIND range(1, 10) AS x CREATE ()"),
+               SemanticException);
+
+  {
+    auto *query =
+        dynamic_cast<CypherQuery *>(ast_generator.ParseQuery(R"(LOAD CSV FROM "file.csv" NO HEADER AS x CREATE ())"));
+    ASSERT_TRUE(query);
+    ASSERT_FALSE(query->periodic_commit_frequency_);
+  }
+
+  {
+    auto *query = dynamic_cast<CypherQuery *>(ast_generator.ParseQuery(
+        R"(USING PERIODIC COMMIT 1000 LOAD CSV FROM "file.csv" NO HEADER AS x CREATE ())"));
+    ASSERT_TRUE(query);
+    ASSERT_TRUE(query->periodic_commit_frequency_);
+    ast_generator.CheckLiteral(query->periodic_commit_frequency_, 1000);
+  }
+}
+
 TEST_P(CypherMainVisitorTest, MemoryLimit) {
   auto &ast_generator = *GetParam();
 
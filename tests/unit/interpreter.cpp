@@ -28,7 +28,14 @@
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/property_value.hpp"
 #include "utils/csv_parsing.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/logging.hpp"
+#include "utils/memory.hpp"
+#include "utils/on_scope_exit.hpp"
+
+namespace EventCounter {
+extern const Event PeriodicCommits;
+}  // namespace EventCounter
 
 namespace {
 
@@ -868,6 +875,27 @@ TEST_F(InterpreterTest, Transactions) {
   }
 }
 
+TEST_F(InterpreterTest, ReadOnlyTransactions) {
+  auto &interpreter = default_interpreter.interpreter;
+  Interpret("CREATE (:Node {id: 1})");
+  {
+    interpreter.BeginTransaction(true);
+    auto [stream, qid] = Prepare("MATCH (n:Node) RETURN n.id");
+    Pull(&stream);
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 1);
+    ASSERT_THROW(Prepare("CREATE (:Node {id: 2})"), memgraph::query::WriteQueryInReadOnlyTxException);
+    interpreter.RollbackTransaction();
+  }
+  {
+    // Implicit transactions start as read-only and are upgraded for writes.
+    Interpret("CREATE (:Node {id: 2})");
+    auto stream = Interpret("MATCH (n:Node) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 2);
+  }
+}
+
 TEST_F(InterpreterTest, Qid) {
   auto &interpreter = default_interpreter.interpreter;
   {
@@ -1053,6 +1081,95 @@ TEST_F(InterpreterTest, LoadCsvClause) {
   }
 }
 
+TEST_F(InterpreterTest, LoadCsvClauseReadError) {
+  auto dir_manager = TmpDirManager("csv_directory");
+  const auto csv_path = dir_manager.Path() / "file.csv";
+  auto writer = FileWriter(csv_path);
+
+  const std::string delimiter{"|"};
+  writer.WriteLine(CreateRow({"A", "B", "C"}, delimiter));
+  writer.WriteLine(CreateRow({"a", "b", "c"}, delimiter));
+  writer.WriteLine(CreateRow({"\"\"1", "2", "3"}, delimiter));
+  writer.WriteLine(CreateRow({"d", "e", "f"}, delimiter));
+  writer.Close();
+
+  // The rows read before the bad row are returned before the error is raised.
+  const std::string query =
+      fmt::format(R"(LOAD CSV FROM "{}" WITH HEADER DELIMITER "{}" AS x RETURN x.A)", csv_path.string(), delimiter);
+  auto [stream, qid] = Prepare(query);
+  Pull(&stream, 1);
+  ASSERT_EQ(stream.GetResults().size(), 1U);
+  ASSERT_EQ(stream.GetResults()[0][0].ValueString(), "a");
+  ASSERT_THROW(Pull(&stream, 1), memgraph::csv::CsvReadException);
+}
+
+TEST_F(InterpreterTest, LoadCsvClauseStopsEarly) {
+  auto dir_manager = TmpDirManager("csv_directory");
+  const auto csv_path = dir_manager.Path() / "file.csv";
+  auto writer = FileWriter(csv_path);
+  // More rows than the producer thread is allowed to queue up.
+  for (int i = 0; i < 100000; ++i) {
+    writer.WriteLine(std::to_string(i));
+  }
+  writer.Close();
+
+  auto stream = Interpret(fmt::format(R"(LOAD CSV FROM "{}" NO HEADER AS x RETURN x LIMIT 2)", csv_path.string()));
+  ASSERT_EQ(stream.GetResults().size(), 2U);
+  ASSERT_EQ(stream.GetResults()[1][0].ValueList()[0].ValueString(), "1");
+}
+
+TEST_F(InterpreterTest, LoadCsvClauseMemoryLimit) {
+  auto dir_manager = TmpDirManager("csv_directory");
+  const auto csv_path = dir_manager.Path() / "file.csv";
+  auto writer = FileWriter(csv_path);
+  writer.WriteLine(std::string(10000, 'a'));
+  writer.Close();
+
+  // The row is parsed on the producer thread, but it still counts towards the
+  // query memory limit.
+  const auto query = fmt::format(R"(LOAD CSV FROM "{}" NO HEADER AS x RETURN count(*))", csv_path.string());
+  ASSERT_NO_THROW(Interpret(query));
+  ASSERT_THROW(Interpret(query + " QUERY MEMORY LIMIT 1 KB"), memgraph::utils::BadAlloc);
+}
+
+TEST_F(InterpreterTest, LoadCsvPeriodicCommit) {
+  auto dir_manager = TmpDirManager("csv_directory");
+  const auto csv_path = dir_manager.Path() / "file.csv";
+  auto writer = FileWriter(csv_path);
+  writer.WriteLine("id");
+  for (int i = 0; i < 25; ++i) {
+    writer.WriteLine(std::to_string(i));
+  }
+  writer.Close();
+
+  const auto query = fmt::format(
+      R"(USING PERIODIC COMMIT 10 LOAD CSV FROM "{}" WITH HEADER AS x CREATE (n:Node {{id: x.id}}) SET n.copy = x.id)",
+      csv_path.string());
+  const auto commits_before = EventCounter::global_counters[EventCounter::PeriodicCommits].load();
+  Interpret(query);
+  // The transaction is committed after the 10th and the 20th row, and the
+  // rest of the rows are committed together with the query.
+  ASSERT_EQ(EventCounter::global_counters[EventCounter::PeriodicCommits].load() - commits_before, 2);
+  {
+    auto stream = Interpret("MATCH (n:Node) WHERE n.id = n.copy RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 25);
+  }
+
+  Interpret("BEGIN");
+  ASSERT_THROW(Interpret(query), memgraph::query::PeriodicCommitInMulticommandTxException);
+  Interpret("ROLLBACK");
+
+  // The triggers wouldn't see the changes that were committed periodically.
+  Interpret("CREATE TRIGGER trigger ON CREATE AFTER COMMIT EXECUTE CREATE ()");
+  ASSERT_THROW(Interpret(query), memgraph::query::PeriodicCommitWithTriggersException);
+  Interpret("DROP TRIGGER trigger");
+  Interpret(query);
+  {
+    auto stream = Interpret("MATCH (n:Node) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 50);
+  }
+}
+
 TEST_F(InterpreterTest, CacheableQueries) {
   const auto &interpreter_context = default_interpreter.interpreter_context;
   // This should be cached
@@ -1073,6 +1190,58 @@ TEST_F(InterpreterTest, CacheableQueries) {
   }
 }
 
+TEST_F(InterpreterTest, CacheEviction) {
+  auto &interpreter_context = default_interpreter.interpreter_context;
+  const auto max_ast_entries = FLAGS_query_ast_cache_max_entries;
+  const auto max_plan_entries = FLAGS_query_plan_cache_max_entries;
+  memgraph::utils::OnScopeExit restore_flags([&] {
+    FLAGS_query_ast_cache_max_entries = max_ast_entries;
+    FLAGS_query_plan_cache_max_entries = max_plan_entries;
+  });
+  FLAGS_query_ast_cache_max_entries = 10;
+  FLAGS_query_plan_cache_max_entries = 10;
+
+  Interpret("RETURN 1 AS first");
+  for (int i = 0; i < 100; ++i) {
+    Interpret(fmt::format("RETURN {} AS x{}", i, i));
+    // Keep using the first query so that it isn't evicted.
+    Interpret("RETURN 2 AS first");
+    EXPECT_LE(interpreter_context.ast_cache.size(), 10U);
+    EXPECT_LE(interpreter_context.plan_cache.size(), 10U);
+  }
+
+  auto accessor = interpreter_context.ast_cache.access();
+  EXPECT_NE(accessor.find(memgraph::query::frontend::StrippedQuery("RETURN 3 AS first").hash()), accessor.end());
+  EXPECT_EQ(accessor.find(memgraph::query::frontend::StrippedQuery("RETURN 3 AS x0").hash()), accessor.end());
+}
+
+TEST_F(InterpreterTest, IndexCreationInvalidatesPlans) {
+  const auto &interpreter_context = default_interpreter.interpreter_context;
+  Interpret("MATCH (n:Label) WHERE n.prop = 1 RETURN n");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 1U);
+  Interpret("CREATE INDEX ON :Label(prop)");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
+}
+
+TEST(CachedPlan, IsStale) {
+  const auto max_drift = FLAGS_query_plan_cache_max_cardinality_drift;
+  memgraph::utils::OnScopeExit restore_flag([&] { FLAGS_query_plan_cache_max_cardinality_drift = max_drift; });
+  FLAGS_query_plan_cache_max_cardinality_drift = 10.0;
+
+  memgraph::query::CachedPlan plan(nullptr, 5000);
+  EXPECT_FALSE(plan.IsStale(0));
+  EXPECT_FALSE(plan.IsStale(5000));
+  EXPECT_FALSE(plan.IsStale(50000));
+  EXPECT_TRUE(plan.IsStale(50001));
+
+  memgraph::query::CachedPlan empty_plan(nullptr, 0);
+  EXPECT_FALSE(empty_plan.IsStale(10000));
+  EXPECT_TRUE(empty_plan.IsStale(10001));
+
+  FLAGS_query_plan_cache_max_cardinality_drift = 0.0;
+  EXPECT_FALSE(plan.IsStale(1000000));
+}
+
 TEST_F(InterpreterTest, AllowLoadCsvConfig) {
   const auto check_load_csv_queries = [&](const bool allow_load_csv) {
     TmpDirManager directory_manager{"allow_load_csv"};
@@ -1465,3 +1634,37 @@ TEST_F(InterpreterTest, LoadCsvClauseNotification) {
             "conversion functions such as ToInteger, ToFloat, ToBoolean etc.");
   ASSERT_EQ(notification["description"].ValueString(), "");
 }
+
+TEST_F(InterpreterTest, AdmissionControlExplicitTransaction) {
+  InterpreterFaker interpreter_faker{&db_, {.admission_control = {.max_running_queries = 1}}, data_directory};
+  const auto running_queries = [&] {
+    const auto usage = interpreter_faker.interpreter_context.admission_controller.GetUsage("");
+    return usage ? usage->running_queries : uint64_t{0};
+  };
+
+  // The transaction takes the only query the user can run, and the queries
+  // inside it don't need another one.
+  interpreter_faker.Interpret("BEGIN");
+  interpreter_faker.Interpret("CREATE ()");
+  {
+    auto stream = interpreter_faker.Interpret("MATCH (n) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 1);
+  }
+  ASSERT_EQ(running_queries(), 1);
+  {
+    memgraph::query::Interpreter other_interpreter{&interpreter_faker.interpreter_context};
+    ASSERT_THROW(other_interpreter.Prepare("RETURN 1", {}, nullptr), memgraph::query::QueryAdmissionException);
+  }
+  interpreter_faker.Interpret("COMMIT");
+  ASSERT_EQ(running_queries(), 0);
+
+  interpreter_faker.Interpret("BEGIN");
+  interpreter_faker.Interpret("CREATE ()");
+  ASSERT_EQ(running_queries(), 1);
+  interpreter_faker.Interpret("ROLLBACK");
+  ASSERT_EQ(running_queries(), 0);
+  {
+    auto stream = interpreter_faker.Interpret("MATCH (n) RETURN count(n)");
+    ASSERT_EQ(stream.GetResults()[0][0].ValueInt(), 1);
+  }
+}
@@ -0,0 +1,235 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "communication/metrics/prometheus.hpp"
+#include "communication/metrics/server.hpp"
+#include "utils/event_histogram.hpp"
+
+namespace EventHistogram {
+extern const Event CommitLatency;
+}  // namespace EventHistogram
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+using memgraph::communication::metrics::MetricName;
+using memgraph::communication::metrics::RenderMetrics;
+using memgraph::communication::metrics::Sample;
+using memgraph::communication::metrics::Server;
+
+namespace {
+// Stand-in for the Prometheus scraper.
+http::response<http::string_body> Scrape(uint16_t port, const std::string &target,
+                                         http::verb method = http::verb::get) {
+  net::io_context ioc;
+  tcp::resolver resolver{ioc};
+  beast::tcp_stream stream{ioc};
+  stream.connect(resolver.resolve("127.0.0.1", std::to_string(port)));
+
+  http::request<http::string_body> request{method, target, 11};
+  request.set(http::field::host, "127.0.0.1");
+  http::write(stream, request);
+
+  beast::flat_buffer buffer;
+  http::response<http::string_body> response;
+  http::read(stream, buffer, response);
+
+  beast::error_code ec;
+  stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+  return response;
+}
+}  // namespace
+
+TEST(MetricsHistogram, Buckets) {
+  EventHistogram::Histogram histogram;
+  histogram.Measure(0);
+  histogram.Measure(1);
+  histogram.Measure(2);
+  histogram.Measure(3);
+  histogram.Measure(4);
+  histogram.Measure(5);
+  histogram.Measure(EventHistogram::Histogram::UpperBound(EventHistogram::Histogram::kNumBounds - 1));
+  histogram.Measure(EventHistogram::Histogram::UpperBound(EventHistogram::Histogram::kNumBounds - 1) + 1);
+
+  EXPECT_EQ(histogram.BucketCount(0), 2);
+  EXPECT_EQ(histogram.BucketCount(1), 1);
+  EXPECT_EQ(histogram.BucketCount(2), 2);
+  EXPECT_EQ(histogram.BucketCount(3), 1);
+  EXPECT_EQ(histogram.BucketCount(EventHistogram::Histogram::kNumBounds - 1), 1);
+  EXPECT_EQ(histogram.BucketCount(EventHistogram::Histogram::kNumBounds), 1);
+  EXPECT_EQ(histogram.TotalCount(), 8);
+  EXPECT_EQ(histogram.Sum(), 15 + 2 * EventHistogram::Histogram::UpperBound(EventHistogram::Histogram::kNumBounds - 1) +
+                                 1);
+}
+
+TEST(MetricsHistogram, ConcurrentMeasure) {
+  constexpr auto kThreads = 8;
+  constexpr auto kMeasurements = 10000;
+  EventHistogram::Histogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&histogram] {
+      for (int j = 0; j < kMeasurements; ++j) {
+        histogram.Measure(j % 100);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  uint64_t total = 0;
+  for (size_t bucket = 0; bucket <= EventHistogram::Histogram::kNumBounds; ++bucket) {
+    total += histogram.BucketCount(bucket);
+  }
+  EXPECT_EQ(total, kThreads * kMeasurements);
+  EXPECT_EQ(histogram.TotalCount(), kThreads * kMeasurements);
+}
+
+TEST(MetricsPrometheus, MetricName) {
+  EXPECT_EQ(MetricName("WalBytesWritten"), "memgraph_wal_bytes_written");
+  EXPECT_EQ(MetricName("CommitLatency"), "memgraph_commit_latency");
+  EXPECT_EQ(MetricName("GCLag"), "memgraph_gc_lag");
+}
+
+TEST(MetricsPrometheus, Render) {
+  const auto before = EventHistogram::global_histograms[EventHistogram::CommitLatency].TotalCount();
+  EventHistogram::Measure(EventHistogram::CommitLatency, 3);
+
+  const auto text = RenderMetrics({{"ReplicaState", "State.", {{"replica", "a\"b"}, {"state", "ready"}}, 1.0},
+                                   {"ReplicaState", "State.", {{"replica", "a\"b"}, {"state", "invalid"}}, 0.0}});
+  EXPECT_NE(text.find("# TYPE memgraph_wal_bytes_written_total counter\n"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE memgraph_active_bolt_sessions gauge\n"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE memgraph_commit_latency_seconds histogram\n"), std::string::npos);
+  EXPECT_NE(text.find("memgraph_commit_latency_seconds_bucket{le=\"+Inf\"} " + std::to_string(before + 1) + "\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("memgraph_commit_latency_seconds_count " + std::to_string(before + 1) + "\n"), std::string::npos);
+
+  // The header is written once for all samples with the same name.
+  const auto header = text.find("# TYPE memgraph_replica_state gauge\n");
+  ASSERT_NE(header, std::string::npos);
+  EXPECT_EQ(text.find("# TYPE memgraph_replica_state gauge\n", header + 1), std::string::npos);
+  EXPECT_NE(text.find("memgraph_replica_state{replica=\"a\\\"b\",state=\"ready\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("memgraph_replica_state{replica=\"a\\\"b\",state=\"invalid\"} 0\n"), std::string::npos);
+}
+
+TEST(MetricsServer, Scrape) {
+  Server server{{"127.0.0.1", 0}, [] { return std::vector<Sample>{{"TestValue", "Test value.", {}, 42.0}}; }};
+  const auto port = server.GetEndpoint().port();
+  ASSERT_NE(port, 0);
+  server.Start();
+  EXPECT_TRUE(server.IsRunning());
+
+  {
+    auto response = Scrape(port, "/metrics");
+    EXPECT_EQ(response.result(), http::status::ok);
+    EXPECT_EQ(response[http::field::content_type], "text/plain; version=0.0.4");
+    EXPECT_NE(response.body().find("memgraph_test_value 42\n"), std::string::npos);
+    EXPECT_NE(response.body().find("# TYPE memgraph_query_parse_latency_seconds histogram\n"), std::string::npos);
+  }
+  {
+    auto response = Scrape(port, "/metrics", http::verb::head);
+    EXPECT_EQ(response.result(), http::status::ok);
+  }
+  EXPECT_EQ(Scrape(port, "/").result(), http::status::not_found);
+  EXPECT_EQ(Scrape(port, "/metrics", http::verb::post).result(), http::status::method_not_allowed);
+
+  server.Shutdown();
+  server.AwaitShutdown();
+  EXPECT_FALSE(server.IsRunning());
+}
+
+TEST(MetricsServer, PortInUse) {
+  Server server{{"127.0.0.1", 0}, {}};
+  const auto port = server.GetEndpoint().port();
+  server.Start();
+
+  // The second server can't listen on the same port, so it isn't started.
+  Server other{{"127.0.0.1", port}, {}};
+  other.Start();
+  EXPECT_FALSE(other.IsRunning());
+  other.AwaitShutdown();
+
+  EXPECT_EQ(Scrape(port, "/metrics").result(), http::status::ok);
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(MetricsServer, AcceptErrorBackoff) {
+  Server server{{"127.0.0.1", 0}, {}};
+  const auto port = server.GetEndpoint().port();
+  server.Start();
+
+  std::ostringstream log;
+  auto previous_logger = spdlog::default_logger();
+  spdlog::set_default_logger(
+      std::make_shared<spdlog::logger>("test", std::make_shared<spdlog::sinks::ostream_sink_mt>(log)));
+
+  net::io_context ioc;
+  tcp::socket client{ioc};
+  client.open(tcp::v4());
+
+  // Without free file descriptors every accept of the pending connection
+  // fails, so the server has to back off instead of retrying right away.
+  rlimit previous_limit{};
+  ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &previous_limit), 0);
+  const auto free_fd = dup(0);
+  ASSERT_NE(free_fd, -1);
+  close(free_fd);
+  rlimit limit = previous_limit;
+  limit.rlim_cur = free_fd;
+  ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limit), 0);
+  client.connect({net::ip::make_address("127.0.0.1"), port});
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &previous_limit), 0);
+
+  // The connection is accepted once the descriptors are available again.
+  beast::tcp_stream stream{std::move(client)};
+  http::request<http::string_body> request{http::verb::get, "/metrics", 11};
+  request.set(http::field::host, "127.0.0.1");
+  http::write(stream, request);
+  beast::flat_buffer buffer;
+  http::response<http::string_body> response;
+  http::read(stream, buffer, response);
+  EXPECT_EQ(response.result(), http::status::ok);
+
+  spdlog::set_default_logger(previous_logger);
+  const auto logged = log.str();
+  size_t accept_errors = 0;
+  for (auto pos = logged.find("accept"); pos != std::string::npos; pos = logged.find("accept", pos + 1)) {
+    ++accept_errors;
+  }
+  EXPECT_GT(accept_errors, 0);
+  EXPECT_LT(accept_errors, 20);
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
@@ -0,0 +1,134 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "communication/buffer.hpp"
+#include "communication/context.hpp"
+#include "communication/v2/server.hpp"
+#include "io/network/socket.hpp"
+#include "utils/timer.hpp"
+#include "utils/work_stealing_scheduler.hpp"
+
+using namespace std::chrono_literals;
+using memgraph::utils::WorkStealingScheduler;
+
+class TestData {};
+
+class TestSession {
+ public:
+  TestSession(TestData *, const memgraph::communication::v2::ServerEndpoint &,
+              memgraph::communication::v2::InputStream *input_stream,
+              memgraph::communication::v2::OutputStream *output_stream)
+      : input_stream_(input_stream), output_stream_(output_stream) {}
+
+  void Execute() {
+    if (input_stream_->data()[0] == 'e') {
+      // An expensive query checks for abortion the way the operators do.
+      memgraph::utils::Timer timer;
+      while (timer.Elapsed() < 1s) {
+        WorkStealingScheduler::Checkpoint();
+        std::this_thread::sleep_for(10us);
+      }
+    }
+    output_stream_->Write(input_stream_->data(), input_stream_->size());
+    input_stream_->Shift(input_stream_->size());
+  }
+
+ private:
+  memgraph::communication::v2::InputStream *input_stream_;
+  memgraph::communication::v2::OutputStream *output_stream_;
+};
+
+namespace {
+
+constexpr uint16_t kPort = 17687;
+const std::string kSafeQuery("tttt");
+const std::string kExpensiveQuery("eeee");
+
+bool ReadResponse(memgraph::io::network::Socket &socket, const std::string &query) {
+  std::string response(query.size(), '\0');
+  size_t len = 0;
+  while (len < query.size()) {
+    auto got = socket.Read(response.data() + len, query.size() - len);
+    if (got <= 0) return false;
+    len += got;
+  }
+  return response == query;
+}
+
+}  // namespace
+
+class NetworkQueryExecutor : public ::testing::Test {
+ protected:
+  static constexpr size_t kWorkers = 1;
+  static constexpr size_t kMaxLongQueries = 1;
+
+  void SetUp() override { ASSERT_TRUE(server_.Start()); }
+
+  void TearDown() override {
+    server_.Shutdown();
+    server_.AwaitShutdown();
+    executor_.Shutdown();
+  }
+
+  TestData test_data_;
+  memgraph::communication::ServerContext context_;
+  memgraph::communication::v2::ServerEndpoint endpoint_{boost::asio::ip::make_address("127.0.0.1"), kPort};
+  WorkStealingScheduler executor_{kWorkers, kMaxLongQueries, 10ms, "Test"};
+  // A single I/O thread and a single executor worker.
+  memgraph::communication::v2::Server<TestSession, TestData> server_{endpoint_, &test_data_, &context_, 60, "Test",
+                                                                     1, &executor_};
+};
+
+TEST_F(NetworkQueryExecutor, LongQueryDoesntBlockOtherSessions) {
+  memgraph::io::network::Socket long_client;
+  ASSERT_TRUE(long_client.Connect({"127.0.0.1", kPort}));
+  ASSERT_TRUE(long_client.Write(kExpensiveQuery));
+  while (executor_.LongTasksNum() != 1) std::this_thread::sleep_for(1ms);
+
+  // The expensive query gave up the only worker, so the other session is
+  // served while it is still running.
+  memgraph::utils::Timer timer;
+  memgraph::io::network::Socket short_client;
+  ASSERT_TRUE(short_client.Connect({"127.0.0.1", kPort}));
+  for (size_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(short_client.Write(kSafeQuery));
+    ASSERT_TRUE(ReadResponse(short_client, kSafeQuery));
+  }
+  ASSERT_LT(timer.Elapsed(), 500ms);
+  ASSERT_EQ(executor_.LongTasksNum(), 1);
+
+  ASSERT_TRUE(ReadResponse(long_client, kExpensiveQuery));
+}
+
+TEST_F(NetworkQueryExecutor, LongQueriesDontSpawnThreads) {
+  // More expensive queries run than are allowed to be long, the others keep
+  // their worker instead of getting a thread of their own.
+  std::vector<memgraph::io::network::Socket> clients(4);
+  for (auto &client : clients) {
+    ASSERT_TRUE(client.Connect({"127.0.0.1", kPort}));
+    ASSERT_TRUE(client.Write(kExpensiveQuery));
+  }
+  while (executor_.LongTasksNum() != kMaxLongQueries) std::this_thread::sleep_for(1ms);
+
+  for (auto &client : clients) {
+    ASSERT_LE(executor_.ThreadsNum(), kWorkers + kMaxLongQueries);
+    ASSERT_TRUE(ReadResponse(client, kExpensiveQuery));
+  }
+  while (executor_.UnfinishedTasksNum() != 0) std::this_thread::sleep_for(1ms);
+  while (executor_.ThreadsNum() != kWorkers) std::this_thread::sleep_for(1ms);
+}
@@ -106,6 +106,7 @@ TEST_F(PrintToJsonTest, ScanAllByLabelPropertyRange) {
             "value" : "20",
             "type" : "exclusive"
           },
+          "prefix_scan" : false,
           "output_symbol" : "node",
           "input" : { "name" : "Once" }
         })");
@@ -126,6 +127,7 @@ TEST_F(PrintToJsonTest, ScanAllByLabelPropertyRange) {
             "value" : "20",
             "type" : "exclusive"
           },
+          "prefix_scan" : false,
           "output_symbol" : "node",
           "input" : { "name" : "Once" }
         })");
@@ -146,6 +148,7 @@ TEST_F(PrintToJsonTest, ScanAllByLabelPropertyRange) {
             "type" : "inclusive"
           },
           "upper_bound" : null,
+          "prefix_scan" : false,
           "output_symbol" : "node",
           "input" : { "name" : "Once" }
         })");
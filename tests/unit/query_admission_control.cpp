@@ -0,0 +1,213 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "query/admission_control.hpp"
+#include "query/exceptions.hpp"
+#include "utils/memory_tracker.hpp"
+#include "utils/work_stealing_scheduler.hpp"
+
+using namespace std::chrono_literals;
+using memgraph::query::AdmissionController;
+using memgraph::query::InterpreterConfig;
+using memgraph::query::QueryAdmissionException;
+
+TEST(AdmissionControl, Disabled) {
+  AdmissionController controller{InterpreterConfig::AdmissionControl{}};
+  std::vector<AdmissionController::Ticket> tickets;
+  for (int i = 0; i < 100; ++i) {
+    tickets.push_back(controller.Admit("user", std::nullopt));
+  }
+  // Nothing is tracked without the quotas.
+  ASSERT_FALSE(controller.GetUsage("user"));
+}
+
+TEST(AdmissionControl, MaxRunningQueries) {
+  AdmissionController controller{{.max_running_queries = 2}};
+  std::optional<AdmissionController::Ticket> first{controller.Admit("user", std::nullopt)};
+  auto second = controller.Admit("user", std::nullopt);
+  ASSERT_EQ(controller.GetUsage("user")->running_queries, 2);
+  ASSERT_THROW(controller.Admit("user", std::nullopt), QueryAdmissionException);
+  // The quotas are per user.
+  {
+    auto other = controller.Admit("other", std::nullopt);
+    ASSERT_EQ(controller.GetUsage("other")->running_queries, 1);
+  }
+  ASSERT_FALSE(controller.GetUsage("other"));
+
+  first.reset();
+  auto third = controller.Admit("user", std::nullopt);
+  ASSERT_EQ(controller.GetUsage("user")->running_queries, 2);
+}
+
+TEST(AdmissionControl, MemoryReservations) {
+  AdmissionController controller{{.max_reserved_memory = 100, .default_memory_reservation = 10}};
+  auto first = controller.Admit("user", 60);
+  ASSERT_THROW(controller.Admit("user", 50), QueryAdmissionException);
+  auto second = controller.Admit("user", 30);
+  ASSERT_EQ(controller.GetUsage("user")->reserved_memory, 90);
+  // The queries without a memory limit reserve the default amount.
+  auto third = controller.Admit("user", std::nullopt);
+  ASSERT_EQ(controller.GetUsage("user")->reserved_memory, 100);
+  ASSERT_THROW(controller.Admit("user", std::nullopt), QueryAdmissionException);
+}
+
+TEST(AdmissionControl, TotalReservedMemory) {
+  // The limit is far above the memory that the test really uses.
+  static constexpr uint64_t kHardLimit = 1UL << 40U;
+  memgraph::utils::total_memory_tracker.SetHardLimit(kHardLimit);
+
+  // The memory limits of the queries don't matter unless they are enabled.
+  {
+    AdmissionController controller{InterpreterConfig::AdmissionControl{}};
+    auto first = controller.Admit("user", kHardLimit);
+    auto second = controller.Admit("other", kHardLimit);
+    ASSERT_FALSE(controller.GetUsage("user"));
+  }
+
+  AdmissionController controller{{.limit_total_reserved_memory = true}};
+  auto first = controller.Admit("user", kHardLimit / 2);
+  ASSERT_THROW(controller.Admit("other", kHardLimit), QueryAdmissionException);
+  auto second = controller.Admit("other", kHardLimit / 2);
+  ASSERT_EQ(controller.GetUsage("other")->reserved_memory, kHardLimit / 2);
+}
+
+TEST(AdmissionControl, QueueWait) {
+  AdmissionController controller{{.max_running_queries = 1, .max_queue_wait = 1h}};
+  std::optional<AdmissionController::Ticket> first{controller.Admit("user", std::nullopt)};
+
+  std::atomic<bool> admitted{false};
+  std::thread waiter([&] {
+    auto ticket = controller.Admit("user", std::nullopt);
+    admitted.store(true);
+  });
+  while (controller.GetUsage("user")->queued_queries != 1) std::this_thread::sleep_for(1ms);
+  std::this_thread::sleep_for(50ms);
+  ASSERT_FALSE(admitted.load());
+
+  first.reset();
+  waiter.join();
+  ASSERT_TRUE(admitted.load());
+  ASSERT_FALSE(controller.GetUsage("user"));
+}
+
+TEST(AdmissionControl, QueueTimeout) {
+  AdmissionController controller{{.max_running_queries = 1, .max_queue_wait = 50ms}};
+  auto first = controller.Admit("user", std::nullopt);
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_THROW(controller.Admit("user", std::nullopt), QueryAdmissionException);
+  ASSERT_GE(std::chrono::steady_clock::now() - start, 50ms);
+  ASSERT_EQ(controller.GetUsage("user")->queued_queries, 0);
+}
+
+TEST(AdmissionControl, MaxQueuedQueries) {
+  AdmissionController controller{{.max_running_queries = 1, .max_queue_wait = 1h, .max_queued_queries = 1}};
+  std::optional<AdmissionController::Ticket> first{controller.Admit("user", std::nullopt)};
+  std::thread waiter([&] { auto ticket = controller.Admit("user", std::nullopt); });
+  while (controller.GetUsage("user")->queued_queries != 1) std::this_thread::sleep_for(1ms);
+
+  // The queue of the user is full.
+  ASSERT_THROW(controller.Admit("user", std::nullopt), QueryAdmissionException);
+
+  first.reset();
+  waiter.join();
+}
+
+TEST(AdmissionControl, QueuedQueryReleasesExecutorSlot) {
+  // A single worker that would otherwise be blocked by the queued query.
+  memgraph::utils::WorkStealingScheduler executor{1, 1, 1h};
+  AdmissionController controller{{.max_running_queries = 1, .max_queue_wait = 1h}};
+  std::optional<AdmissionController::Ticket> first{controller.Admit("user", std::nullopt)};
+
+  std::atomic<bool> user_admitted{false};
+  std::atomic<bool> other_admitted{false};
+  executor.Schedule([&] {
+    auto ticket = controller.Admit("user", std::nullopt);
+    user_admitted.store(true);
+  });
+  while (!controller.GetUsage("user") || controller.GetUsage("user")->queued_queries != 1) {
+    std::this_thread::sleep_for(1ms);
+  }
+  executor.Schedule([&] {
+    auto ticket = controller.Admit("other", std::nullopt);
+    other_admitted.store(true);
+  });
+  while (!other_admitted.load()) std::this_thread::sleep_for(1ms);
+  ASSERT_FALSE(user_admitted.load());
+  ASSERT_EQ(executor.ParkedTasksNum(), 1);
+  ASSERT_EQ(executor.LongTasksNum(), 0);
+
+  first.reset();
+  while (executor.UnfinishedTasksNum() != 0) std::this_thread::sleep_for(1ms);
+  ASSERT_TRUE(user_admitted.load());
+}
+
+TEST(AdmissionControl, QueuedQueriesOverLongTasksLimit) {
+  // More queries are queued than long tasks are allowed, and none of them is
+  // counted as a long task, so the other sessions still get both workers.
+  static constexpr size_t workers_count = 2;
+  static constexpr size_t max_long_tasks = 1;
+  static constexpr size_t queued_count = workers_count + max_long_tasks;
+  memgraph::utils::WorkStealingScheduler executor{workers_count, max_long_tasks, 1h};
+  AdmissionController controller{{.max_running_queries = 1, .max_queue_wait = 1h}};
+  std::optional<AdmissionController::Ticket> first{controller.Admit("user", std::nullopt)};
+
+  std::atomic<size_t> admitted{0};
+  for (size_t i = 0; i < queued_count; ++i) {
+    executor.Schedule([&] {
+      auto ticket = controller.Admit("user", std::nullopt);
+      admitted.fetch_add(1);
+    });
+  }
+  while (controller.GetUsage("user")->queued_queries != queued_count) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(executor.ParkedTasksNum(), queued_count);
+  ASSERT_EQ(executor.LongTasksNum(), 0);
+
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 100; ++i) {
+    executor.Schedule([&] {
+      auto ticket = controller.Admit("other", std::nullopt);
+      count.fetch_add(1);
+    });
+  }
+  while (count.load() != 100) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(admitted.load(), 0);
+
+  first.reset();
+  while (executor.UnfinishedTasksNum() != 0) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(admitted.load(), queued_count);
+  ASSERT_EQ(executor.ParkedTasksNum(), 0);
+}
+
+TEST(AdmissionControl, CpuTime) {
+  AdmissionController controller{{.max_cpu_time = 5ms, .cpu_time_window = 200ms, .max_queue_wait = 1h}};
+  {
+    auto ticket = controller.Admit("user", std::nullopt);
+    auto measure = ticket.MeasureCpuTime();
+    const auto start = AdmissionController::ThreadCpuTime();
+    while (AdmissionController::ThreadCpuTime() - start < 10ms) {
+    }
+  }
+  ASSERT_GE(controller.GetUsage("user")->cpu_time, 10ms);
+
+  // The query waits until the CPU time is renewed at the end of the window.
+  const auto start = std::chrono::steady_clock::now();
+  auto ticket = controller.Admit("user", std::nullopt);
+  ASSERT_GE(std::chrono::steady_clock::now() - start, 100ms);
+  ASSERT_EQ(controller.GetUsage("user")->cpu_time, 0ns);
+}
@@ -220,7 +220,7 @@ memgraph::storage::VertexAccessor CreateVertex(memgraph::storage::Storage::Acces
                                                const std::map<std::string, memgraph::storage::PropertyValue> &props,
                                                bool add_property_id = true) {
   MG_ASSERT(dba);
-  auto vertex = dba->CreateVertex();
+  auto vertex = dba->CreateVertex().GetValue();
   for (const auto &label_name : labels) {
     MG_ASSERT(vertex.AddLabel(dba->NameToLabel(label_name)).HasValue());
   }
@@ -1161,6 +1161,46 @@ TEST_F(ExpressionEvaluatorPropertyLookup, MapLiteral) {
   EXPECT_TRUE(Value(prop_height).IsNull());
 }
 
+TEST_F(ExpressionEvaluatorPropertyLookup, EqualToLiteral) {
+  auto v1 = dba.InsertVertex();
+  ASSERT_TRUE(v1.SetProperty(prop_age.second, memgraph::storage::PropertyValue(10)).HasValue());
+  dba.AdvanceCommand();
+  frame[symbol] = TypedValue(v1);
+  auto equal = [this](const auto &property, Expression *literal) {
+    auto *lookup = storage.Create<PropertyLookup>(identifier, storage.GetPropertyIx(property.first));
+    return Eval(storage.Create<EqualOperator>(lookup, literal));
+  };
+  EXPECT_TRUE(equal(prop_age, storage.Create<PrimitiveLiteral>(10)).ValueBool());
+  EXPECT_TRUE(equal(prop_age, storage.Create<PrimitiveLiteral>(10.0)).ValueBool());
+  EXPECT_FALSE(equal(prop_age, storage.Create<PrimitiveLiteral>(11)).ValueBool());
+  EXPECT_FALSE(equal(prop_age, storage.Create<PrimitiveLiteral>("10")).ValueBool());
+  EXPECT_TRUE(equal(prop_height, storage.Create<PrimitiveLiteral>(10)).IsNull());
+  ctx.parameters.Add(0, memgraph::storage::PropertyValue(10));
+  EXPECT_TRUE(equal(prop_age, storage.Create<ParameterLookup>(0)).ValueBool());
+  // The literal can be on either side of the operator.
+  auto *lookup = storage.Create<PropertyLookup>(identifier, storage.GetPropertyIx(prop_age.first));
+  EXPECT_FALSE(Eval(storage.Create<NotEqualOperator>(storage.Create<PrimitiveLiteral>(10), lookup)).ValueBool());
+  // The value seen by the comparison must respect the view.
+  ASSERT_TRUE(v1.SetProperty(prop_age.second, memgraph::storage::PropertyValue(20)).HasValue());
+  EXPECT_TRUE(equal(prop_age, storage.Create<PrimitiveLiteral>(10)).ValueBool());
+  EXPECT_FALSE(equal(prop_age, storage.Create<PrimitiveLiteral>(20)).ValueBool());
+  frame[symbol] = TypedValue();
+  EXPECT_TRUE(equal(prop_age, storage.Create<PrimitiveLiteral>(10)).IsNull());
+}
+
+TEST_F(ExpressionEvaluatorPropertyLookup, EdgeEqualToLiteral) {
+  auto v1 = dba.InsertVertex();
+  auto v2 = dba.InsertVertex();
+  auto e12 = dba.InsertEdge(&v1, &v2, dba.NameToEdgeType("edge_type"));
+  ASSERT_TRUE(e12.HasValue());
+  ASSERT_TRUE(e12->SetProperty(prop_age.second, memgraph::storage::PropertyValue("ten")).HasValue());
+  dba.AdvanceCommand();
+  frame[symbol] = TypedValue(*e12);
+  auto *lookup = storage.Create<PropertyLookup>(identifier, storage.GetPropertyIx(prop_age.first));
+  EXPECT_TRUE(Eval(storage.Create<EqualOperator>(lookup, storage.Create<PrimitiveLiteral>("ten"))).ValueBool());
+  EXPECT_TRUE(Eval(storage.Create<NotEqualOperator>(lookup, storage.Create<PrimitiveLiteral>(true))).ValueBool());
+}
+
 class FunctionTest : public ExpressionEvaluatorTest {
  protected:
   std::vector<Expression *> ExpressionsFromTypedValues(const std::vector<TypedValue> &tvs) {
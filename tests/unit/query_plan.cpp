@@ -196,6 +196,43 @@ TYPED_TEST(TestPlanner, MatchPathReturn) {
   CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchEdgeTypeIndex) {
+  // Test MATCH (n) -[r :relationship]-> (m) RETURN r
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto relationship = "relationship";
+  auto edge_type = dba.NameToEdgeType(relationship);
+  auto *as_r = NEXPR("r", IDENT("r"));
+  auto *query = QUERY(
+      SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT, {relationship}), NODE("m"))), RETURN(as_r)));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  {
+    // Without the index the edges are found by expanding every vertex.
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
+  }
+  dba.SetIndexCount(edge_type, 1);
+  {
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAllByEdgeType(edge_type), ExpectProduce());
+  }
+}
+
+TYPED_TEST(TestPlanner, MatchEdgeTypeIndexBothDirections) {
+  // Test MATCH (n) -[r :relationship]- (m) RETURN r
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto relationship = "relationship";
+  dba.SetIndexCount(dba.NameToEdgeType(relationship), 1);
+  auto *as_r = NEXPR("r", IDENT("r"));
+  auto *query = QUERY(
+      SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::BOTH, {relationship}), NODE("m"))), RETURN(as_r)));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  // The index only holds each edge once, so it can't produce both directions.
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, MatchNamedPatternReturn) {
   // Test MATCH p = (n) -[r :relationship]- (m) RETURN p
   AstStorage storage;
@@ -996,6 +1033,51 @@ TYPED_TEST(TestPlanner, BestPropertyIndexed) {
             ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, LabelPropertiesIndexed) {
+  // Test MATCH (n :label) WHERE n.a = 1 AND n.b = 2 RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto a = PROPERTY_PAIR("a");
+  auto b = PROPERTY_PAIR("b");
+  // The composite index matches both properties, so it's preferred even
+  // though the label+property index has fewer vertices.
+  dba.SetIndexCount(label, a.second, 1);
+  dba.SetIndexCount(label, {a.second, b.second}, 10);
+  auto lit_1 = LITERAL(1);
+  auto lit_2 = LITERAL(2);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))),
+                                   WHERE(AND(EQ(PROPERTY_LOOKUP("n", a), lit_1), EQ(PROPERTY_LOOKUP("n", b), lit_2))),
+                                   RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table,
+            ExpectScanAllByLabelProperties(label, {a.second, b.second}, {lit_1, lit_2}), ExpectProduce());
+}
+
+TYPED_TEST(TestPlanner, LabelPropertiesIndexedPrefix) {
+  // Test MATCH (n :label) WHERE n.b = 2 AND n.c = 3 RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto a = PROPERTY_PAIR("a");
+  auto b = PROPERTY_PAIR("b");
+  auto c = PROPERTY_PAIR("c");
+  // Only the index whose leading properties are filtered can be used.
+  dba.SetIndexCount(label, {a.second, b.second}, 1);
+  dba.SetIndexCount(label, {b.second, a.second, c.second}, 10);
+  auto lit_2 = LITERAL(2);
+  auto lit_3 = LITERAL(3);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))),
+                                   WHERE(AND(EQ(PROPERTY_LOOKUP("n", b), lit_2), EQ(PROPERTY_LOOKUP("n", c), lit_3))),
+                                   RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table,
+            ExpectScanAllByLabelProperties(label, {b.second, a.second, c.second}, {lit_2}), ExpectFilter(),
+            ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, MultiPropertyIndexScan) {
   // Test MATCH (n :label1), (m :label2) WHERE n.prop1 = 1 AND m.prop2 = 2
   //      RETURN n, m
@@ -1384,6 +1466,65 @@ TYPED_TEST(TestPlanner, FilterRegexMatchPreferRangeIndex) {
             ExpectFilter(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, FilterStartsWithIndex) {
+  // Test MATCH (n :label) WHERE n.prop STARTS WITH "pre" RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto label = dba.Label("label");
+  dba.SetIndexCount(label, 0);
+  dba.SetIndexCount(label, prop, 0);
+  auto *lit_pre = LITERAL("pre");
+  auto *starts_with = FN("STARTSWITH", PROPERTY_LOOKUP("n", prop), lit_pre);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))), WHERE(starts_with), RETURN("n")));
+  // We expect a prefix scan of the index by property range from the prefix
+  // (inclusive), the upper bound is computed from the prefix by the scan.
+  // Filter must still remain in place.
+  Bound lower_bound(lit_pre, Bound::Type::INCLUSIVE);
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table,
+            ExpectScanAllByLabelPropertyRange(label, prop, lower_bound, std::nullopt, true), ExpectFilter(),
+            ExpectProduce());
+}
+
+TYPED_TEST(TestPlanner, FilterContainsTextIndex) {
+  // Test MATCH (n :label) WHERE n.prop CONTAINS "needle" RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto label = dba.Label("label");
+  dba.SetIndexCount(label, 0);
+  dba.SetIndexCount(label, prop, 0);
+  dba.SetTextIndexCount(label, prop, 0);
+  auto *lit_needle = LITERAL("needle");
+  auto *contains = FN("CONTAINS", PROPERTY_LOOKUP("n", prop), lit_needle);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))), WHERE(contains), RETURN("n")));
+  // The label+property index can't be used for CONTAINS, so we expect the
+  // text index. Filter must still remain in place, because the text index
+  // only returns candidates.
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByText(label, prop, lit_needle), ExpectFilter(),
+            ExpectProduce());
+}
+
+TYPED_TEST(TestPlanner, FilterEndsWithNoTextIndex) {
+  // Test MATCH (n :label) WHERE n.prop ENDS WITH "suffix" RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto label = dba.Label("label");
+  dba.SetIndexCount(label, 0);
+  dba.SetIndexCount(label, prop, 0);
+  auto *ends_with = FN("ENDSWITH", PROPERTY_LOOKUP("n", prop), LITERAL("suffix"));
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))), WHERE(ends_with), RETURN("n")));
+  // Without a text index we expect the label index to be used.
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabel(), ExpectFilter(), ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, CallProcedureStandalone) {
   // Test CALL proc(1,2,3) YIELD field AS result
   AstStorage storage;
@@ -1607,4 +1748,23 @@ TYPED_TEST(TestPlanner, Foreach) {
     CheckPlan<TypeParam>(query, storage, ExpectForeach(input, updates));
   }
 }
+
+TYPED_TEST(TestPlanner, LoadCsvPeriodicCommit) {
+  // Test USING PERIODIC COMMIT 10 LOAD CSV FROM "file.csv" NO HEADER AS row CREATE (n)
+  // The LoadCsv operator doesn't accept visitors, so it can't be checked.
+  AstStorage storage;
+  auto make_load_csv = [&] {
+    return storage.Create<memgraph::query::LoadCsv>(LITERAL("file.csv"), false, false, nullptr, nullptr,
+                                                    IDENT("row"));
+  };
+  {
+    auto *query = QUERY(SINGLE_QUERY(make_load_csv(), CREATE(PATTERN(NODE("n")))));
+    query->periodic_commit_frequency_ = LITERAL(10);
+    CheckPlan<TypeParam>(query, storage, ExpectPeriodicCommit(), ExpectCreateNode());
+  }
+  {
+    auto *query = QUERY(SINGLE_QUERY(make_load_csv(), CREATE(PATTERN(NODE("n")))));
+    CheckPlan<TypeParam>(query, storage, ExpectCreateNode());
+  }
+}
 }  // namespace
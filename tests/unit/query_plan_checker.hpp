@@ -61,7 +61,10 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
   PRE_VISIT(ScanAllByLabelPropertyValue);
   PRE_VISIT(ScanAllByLabelPropertyRange);
   PRE_VISIT(ScanAllByLabelProperty);
+  PRE_VISIT(ScanAllByLabelProperties);
+  PRE_VISIT(ScanAllByText);
   PRE_VISIT(ScanAllById);
+  PRE_VISIT(ScanAllByEdgeType);
   PRE_VISIT(Expand);
   PRE_VISIT(ExpandVariable);
   PRE_VISIT(Filter);
@@ -107,6 +110,7 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
   }
 
   PRE_VISIT(CallProcedure);
+  PRE_VISIT(PeriodicCommit);
 
 #undef PRE_VISIT
 #undef VISIT
@@ -154,6 +158,7 @@ using ExpectLimit = OpChecker<Limit>;
 using ExpectOrderBy = OpChecker<OrderBy>;
 using ExpectUnwind = OpChecker<Unwind>;
 using ExpectDistinct = OpChecker<Distinct>;
+using ExpectPeriodicCommit = OpChecker<PeriodicCommit>;
 
 class ExpectForeach : public OpChecker<Foreach> {
  public:
@@ -289,16 +294,71 @@ class ExpectScanAllByLabelPropertyValue : public OpChecker<ScanAllByLabelPropert
   memgraph::query::Expression *expression_;
 };
 
+class ExpectScanAllByLabelProperties : public OpChecker<ScanAllByLabelProperties> {
+ public:
+  ExpectScanAllByLabelProperties(memgraph::storage::LabelId label,
+                                 const std::vector<memgraph::storage::PropertyId> &properties,
+                                 const std::vector<memgraph::query::Expression *> &expressions)
+      : label_(label), properties_(properties), expressions_(expressions) {}
+
+  void ExpectOp(ScanAllByLabelProperties &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.properties_, properties_);
+    EXPECT_EQ(scan_all.expressions_, expressions_);
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  std::vector<memgraph::storage::PropertyId> properties_;
+  std::vector<memgraph::query::Expression *> expressions_;
+};
+
+class ExpectScanAllByText : public OpChecker<ScanAllByText> {
+ public:
+  ExpectScanAllByText(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
+                      memgraph::query::Expression *expression)
+      : label_(label), property_(property), expression_(expression) {}
+
+  void ExpectOp(ScanAllByText &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.property_, property_);
+    EXPECT_EQ(scan_all.expression_, expression_);
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  memgraph::storage::PropertyId property_;
+  memgraph::query::Expression *expression_;
+};
+
+class ExpectScanAllByEdgeType : public OpChecker<ScanAllByEdgeType> {
+ public:
+  explicit ExpectScanAllByEdgeType(memgraph::storage::EdgeTypeId edge_type) : edge_type_(edge_type) {}
+
+  void ExpectOp(ScanAllByEdgeType &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.edge_type_, edge_type_);
+  }
+
+ private:
+  memgraph::storage::EdgeTypeId edge_type_;
+};
+
 class ExpectScanAllByLabelPropertyRange : public OpChecker<ScanAllByLabelPropertyRange> {
  public:
   ExpectScanAllByLabelPropertyRange(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
                                     std::optional<ScanAllByLabelPropertyRange::Bound> lower_bound,
-                                    std::optional<ScanAllByLabelPropertyRange::Bound> upper_bound)
-      : label_(label), property_(property), lower_bound_(lower_bound), upper_bound_(upper_bound) {}
+                                    std::optional<ScanAllByLabelPropertyRange::Bound> upper_bound,
+                                    bool prefix_scan = false)
+      : label_(label),
+        property_(property),
+        lower_bound_(lower_bound),
+        upper_bound_(upper_bound),
+        prefix_scan_(prefix_scan) {}
 
   void ExpectOp(ScanAllByLabelPropertyRange &scan_all, const SymbolTable &) override {
     EXPECT_EQ(scan_all.label_, label_);
     EXPECT_EQ(scan_all.property_, property_);
+    EXPECT_EQ(scan_all.prefix_scan_, prefix_scan_);
     if (lower_bound_) {
       ASSERT_TRUE(scan_all.lower_bound_);
       // TODO: Proper expression equality
@@ -318,6 +378,7 @@ class ExpectScanAllByLabelPropertyRange : public OpChecker<ScanAllByLabelPropert
   memgraph::storage::PropertyId property_;
   std::optional<ScanAllByLabelPropertyRange::Bound> lower_bound_;
   std::optional<ScanAllByLabelPropertyRange::Bound> upper_bound_;
+  bool prefix_scan_;
 };
 
 class ExpectScanAllByLabelProperty : public OpChecker<ScanAllByLabelProperty> {
@@ -434,8 +495,61 @@ class FakeDbAccessor {
     return false;
   }
 
+  int64_t VerticesCount(memgraph::storage::LabelId label,
+                        const std::vector<memgraph::storage::PropertyId> &properties) const {
+    auto found = label_properties_index_.find(std::make_pair(label, properties));
+    if (found != label_properties_index_.end()) return found->second;
+    return 0;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId label, const std::vector<memgraph::storage::PropertyId> &properties,
+                        const std::vector<memgraph::storage::PropertyValue> &) const {
+    return VerticesCount(label, properties);
+  }
+
+  bool LabelPropertiesIndexExists(memgraph::storage::LabelId label,
+                                  const std::vector<memgraph::storage::PropertyId> &properties) const {
+    return label_properties_index_.find(std::make_pair(label, properties)) != label_properties_index_.end();
+  }
+
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertiesIndices(
+      memgraph::storage::LabelId label) const {
+    std::vector<std::vector<memgraph::storage::PropertyId>> indices;
+    for (const auto &[key, count] : label_properties_index_) {
+      if (key.first == label) indices.push_back(key.second);
+    }
+    return indices;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type) const {
+    auto found = edge_type_index_.find(edge_type);
+    if (found != edge_type_index_.end()) return found->second;
+    return 0;
+  }
+
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId edge_type) const {
+    return edge_type_index_.find(edge_type) != edge_type_index_.end();
+  }
+
+  bool TextIndexExists(memgraph::storage::LabelId label, memgraph::storage::PropertyId property) const {
+    return text_index_.find(std::make_pair(label, property)) != text_index_.end();
+  }
+
+  int64_t TextVerticesCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property) const {
+    auto found = text_index_.find(std::make_pair(label, property));
+    if (found != text_index_.end()) return found->second;
+    return 0;
+  }
+
+  int64_t TextVerticesCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property,
+                            std::string_view) const {
+    return TextVerticesCount(label, property);
+  }
+
   void SetIndexCount(memgraph::storage::LabelId label, int64_t count) { label_index_[label] = count; }
 
+  void SetIndexCount(memgraph::storage::EdgeTypeId edge_type, int64_t count) { edge_type_index_[edge_type] = count; }
+
   void SetIndexCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property, int64_t count) {
     for (auto &index : label_property_index_) {
       if (std::get<0>(index) == label && std::get<1>(index) == property) {
@@ -446,6 +560,15 @@ class FakeDbAccessor {
     label_property_index_.emplace_back(label, property, count);
   }
 
+  void SetIndexCount(memgraph::storage::LabelId label, const std::vector<memgraph::storage::PropertyId> &properties,
+                     int64_t count) {
+    label_properties_index_[std::make_pair(label, properties)] = count;
+  }
+
+  void SetTextIndexCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property, int64_t count) {
+    text_index_[std::make_pair(label, property)] = count;
+  }
+
   memgraph::storage::LabelId NameToLabel(const std::string &name) {
     auto found = labels_.find(name);
     if (found != labels_.end()) return found->second;
@@ -483,7 +606,11 @@ class FakeDbAccessor {
   std::unordered_map<std::string, memgraph::storage::PropertyId> properties_;
 
   std::unordered_map<memgraph::storage::LabelId, int64_t> label_index_;
+  std::unordered_map<memgraph::storage::EdgeTypeId, int64_t> edge_type_index_;
   std::vector<std::tuple<memgraph::storage::LabelId, memgraph::storage::PropertyId, int64_t>> label_property_index_;
+  std::map<std::pair<memgraph::storage::LabelId, std::vector<memgraph::storage::PropertyId>>, int64_t>
+      label_properties_index_;
+  std::map<std::pair<memgraph::storage::LabelId, memgraph::storage::PropertyId>, int64_t> text_index_;
 };
 
 }  // namespace memgraph::query::plan
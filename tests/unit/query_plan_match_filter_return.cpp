@@ -9,6 +9,7 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -1955,6 +1956,70 @@ TEST(QueryPlan, ScanAllByLabelPropertyRangeNull) {
   EXPECT_EQ(results.size(), 0);
 }
 
+TEST(QueryPlan, ScanAllByLabelPropertyRangePrefix) {
+  memgraph::storage::Storage db;
+  auto label = db.NameToLabel("label");
+  auto prop = db.NameToProperty("prop");
+  // Strings that aren't valid UTF-8 can contain the 0xFF byte anywhere.
+  std::vector<std::string> strings{"",   "a", "ab",   "ab\xff",     "ab\xff\x01", "ab\xff\xff",
+                                   "ac", "b", "\xff", "\xff\xff", "\xff\x01"};
+  {
+    auto storage_dba = db.Access();
+    memgraph::query::DbAccessor dba(&storage_dba);
+    for (const auto &value : strings) {
+      auto vertex = dba.InsertVertex();
+      ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+      ASSERT_TRUE(vertex.SetProperty(prop, memgraph::storage::PropertyValue(value)).HasValue());
+    }
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+    ASSERT_TRUE(vertex.SetProperty(prop, memgraph::storage::PropertyValue(42)).HasValue());
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+  db.CreateIndex(label, prop);
+
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+
+  // MATCH (n :label) WHERE n.prop STARTS WITH prefix RETURN n.prop, without
+  // the filter that the planner keeps after the scan.
+  auto run_scan_all = [&](const TypedValue &prefix) {
+    AstStorage storage;
+    SymbolTable symbol_table;
+    auto symbol = symbol_table.CreateSymbol("n", true);
+    auto scan_all = std::make_shared<ScanAllByLabelPropertyRange>(
+        nullptr, symbol, label, prop, "prop", Bound{LITERAL(prefix), Bound::Type::INCLUSIVE}, std::nullopt,
+        memgraph::storage::View::OLD, true);
+    auto output = NEXPR("n", IDENT("n")->MapTo(symbol))->MapTo(symbol_table.CreateSymbol("n", true));
+    auto produce = MakeProduce(scan_all, output);
+    auto context = MakeContext(storage, symbol_table, &dba);
+    std::vector<std::string> values;
+    for (const auto &row : CollectProduce(*produce, &context)) {
+      auto value = row[0].ValueVertex().GetProperty(memgraph::storage::View::OLD, prop);
+      values.push_back(value->ValueString());
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+  };
+  auto starting_with = [&](const std::string &prefix) {
+    std::vector<std::string> values;
+    for (const auto &value : strings) {
+      if (memgraph::utils::StartsWith(value, prefix)) values.push_back(value);
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+  };
+
+  for (const auto &prefix : {"", "a", "ab", "ab\xff", "ab\xff\xff", "ac", "b", "c", "\xff", "\xff\xff"}) {
+    SCOPED_TRACE(prefix);
+    EXPECT_EQ(run_scan_all(TypedValue(prefix)), starting_with(prefix));
+  }
+  // STARTS WITH null is null, so nothing is returned.
+  EXPECT_TRUE(run_scan_all(TypedValue()).empty());
+  // STARTS WITH fails for anything that isn't a string.
+  EXPECT_THROW(run_scan_all(TypedValue(42)), QueryRuntimeException);
+}
+
 TEST(QueryPlan, ScanAllByLabelPropertyNoValueInIndexContinuation) {
   memgraph::storage::Storage db;
   auto label = db.NameToLabel("label");
@@ -85,7 +85,7 @@ TEST(QueryPlan, ScanAll) {
   memgraph::storage::Storage db;
   {
     auto dba = db.Access();
-    for (int i = 0; i < 42; ++i) dba.CreateVertex();
+    for (int i = 0; i < 42; ++i) dba.CreateVertex().GetValue();
     EXPECT_FALSE(dba.Commit().HasError());
   }
   memgraph::query::AstStorage ast;
@@ -109,10 +109,10 @@ TEST(QueryPlan, ScanAllByLabel) {
   {
     auto dba = db.Access();
     // Add some unlabeled vertices
-    for (int i = 0; i < 12; ++i) dba.CreateVertex();
+    for (int i = 0; i < 12; ++i) dba.CreateVertex().GetValue();
     // Add labeled vertices
     for (int i = 0; i < 42; ++i) {
-      auto v = dba.CreateVertex();
+      auto v = dba.CreateVertex().GetValue();
       ASSERT_TRUE(v.AddLabel(label).HasValue());
     }
     EXPECT_FALSE(dba.Commit().HasError());
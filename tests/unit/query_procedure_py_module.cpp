@@ -98,8 +98,8 @@ TEST(PyModule, PyVertex) {
   memgraph::storage::Storage db;
   {
     auto dba = db.Access();
-    auto v1 = dba.CreateVertex();
-    auto v2 = dba.CreateVertex();
+    auto v1 = dba.CreateVertex().GetValue();
+    auto v2 = dba.CreateVertex().GetValue();
 
     ASSERT_TRUE(v1.SetProperty(dba.NameToProperty("key1"), memgraph::storage::PropertyValue("value1")).HasValue());
     ASSERT_TRUE(v1.SetProperty(dba.NameToProperty("key2"), memgraph::storage::PropertyValue(1337)).HasValue());
@@ -148,8 +148,8 @@ TEST(PyModule, PyEdge) {
   memgraph::storage::Storage db;
   {
     auto dba = db.Access();
-    auto v1 = dba.CreateVertex();
-    auto v2 = dba.CreateVertex();
+    auto v1 = dba.CreateVertex().GetValue();
+    auto v2 = dba.CreateVertex().GetValue();
 
     auto e = dba.CreateEdge(&v1, &v2, dba.NameToEdgeType("type"));
     ASSERT_TRUE(e.HasValue());
@@ -201,8 +201,8 @@ TEST(PyModule, PyPath) {
   memgraph::storage::Storage db;
   {
     auto dba = db.Access();
-    auto v1 = dba.CreateVertex();
-    auto v2 = dba.CreateVertex();
+    auto v1 = dba.CreateVertex().GetValue();
+    auto v2 = dba.CreateVertex().GetValue();
     ASSERT_TRUE(dba.CreateEdge(&v1, &v2, dba.NameToEdgeType("type")).HasValue());
     ASSERT_FALSE(dba.Commit().HasError());
   }
@@ -0,0 +1,83 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "query/stream/batched_query.hpp"
+
+using testing::ElementsAre;
+
+namespace {
+std::optional<memgraph::query::stream::BatchedQuery> MakeBatchedQuery(const std::string &query) {
+  static memgraph::utils::SpinLock antlr_lock;
+  return memgraph::query::stream::MakeBatchedQuery(query, &antlr_lock);
+}
+}  // namespace
+
+TEST(StreamBatchedQuery, RewritesParameters) {
+  auto batched = MakeBatchedQuery("CREATE (n:Node {id: $id, name: $name, other_id: $id})");
+  ASSERT_TRUE(batched);
+  EXPECT_EQ(batched->query,
+            "UNWIND $__mg_stream_batch AS __mg_stream_row CREATE (n:Node {id: __mg_stream_row.id, name: "
+            "__mg_stream_row.name, other_id: __mg_stream_row.id})");
+  EXPECT_THAT(batched->parameters, ElementsAre("id", "name"));
+}
+
+TEST(StreamBatchedQuery, Merge) {
+  auto batched = MakeBatchedQuery("MERGE (n:User {id: $id}) ON CREATE SET n += $props SET n.count = toInteger($c)");
+  ASSERT_TRUE(batched);
+  EXPECT_EQ(batched->query,
+            "UNWIND $__mg_stream_batch AS __mg_stream_row MERGE (n:User {id: __mg_stream_row.id}) ON CREATE SET n += "
+            "__mg_stream_row.props SET n.count = toInteger(__mg_stream_row.c)");
+  EXPECT_THAT(batched->parameters, ElementsAre("id", "props", "c"));
+}
+
+TEST(StreamBatchedQuery, WithoutParameters) {
+  auto batched = MakeBatchedQuery("CREATE (:Node)");
+  ASSERT_TRUE(batched);
+  EXPECT_EQ(batched->query, "UNWIND $__mg_stream_batch AS __mg_stream_row CREATE (:Node)");
+  EXPECT_TRUE(batched->parameters.empty());
+}
+
+TEST(StreamBatchedQuery, KeywordsAsNames) {
+  // Names which are keywords elsewhere don't make a query a reading one.
+  auto batched = MakeBatchedQuery("CREATE (n:Order {skip: $skip, `match`: 'return'}) SET n:Limit REMOVE n.with");
+  ASSERT_TRUE(batched);
+  EXPECT_EQ(batched->query,
+            "UNWIND $__mg_stream_batch AS __mg_stream_row CREATE (n:Order {skip: __mg_stream_row.skip, `match`: "
+            "'return'}) SET n:Limit REMOVE n.with");
+  EXPECT_THAT(batched->parameters, ElementsAre("skip"));
+}
+
+TEST(StreamBatchedQuery, NotBatchable) {
+  // Reading or projecting clauses change the semantics when executed in an UNWIND.
+  EXPECT_FALSE(MakeBatchedQuery("MATCH (n {id: $id}) SET n.x = $x"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $id}) RETURN n"));
+  EXPECT_FALSE(MakeBatchedQuery("MERGE (n {id: $id}) WITH n DETACH DELETE n"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE INDEX ON :Node(id)"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $id}) UNION CREATE (m {id: $id})"));
+  EXPECT_FALSE(MakeBatchedQuery("EXPLAIN CREATE (n {id: $id})"));
+  EXPECT_FALSE(MakeBatchedQuery("SET n.x = $x"));
+  // Parameters used as the properties of a pattern can't be replaced with an expression.
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n $props)"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n:Node $props)"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE ($props)"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE ()-[:EDGE $props]->()"));
+  // A `$` which doesn't start a parameter.
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {name: '$name', id: $id})"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $id}) // $comment"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $0})"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $__mg_stream_batch})"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $`id`})"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: 'unterminated)"));
+  EXPECT_FALSE(MakeBatchedQuery("CREATE (n {id: $id}"));
+}
@@ -890,7 +890,7 @@ class TriggerStoreTest : public ::testing::Test {
 
   std::optional<memgraph::query::DbAccessor> dba;
 
-  memgraph::utils::SkipList<memgraph::query::QueryCacheEntry> ast_cache;
+  memgraph::query::AstCache ast_cache;
   memgraph::utils::SpinLock antlr_lock;
   memgraph::query::AllowEverythingAuthChecker auth_checker;
 
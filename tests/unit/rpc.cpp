@@ -292,3 +292,201 @@ TEST(Rpc, StreamJumbo) {
   server.Shutdown();
   server.AwaitShutdown();
 }
+
+TEST(Rpc, Pipelined) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Sum>([](auto *req_reader, auto *res_builder) {
+    SumReq req;
+    memgraph::slk::Load(&req, req_reader);
+    SumRes res(req.x + req.y);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  memgraph::communication::ClientContext client_context;
+  Client client(server.endpoint(), &client_context);
+
+  // All requests are sent before any response is awaited and the responses are
+  // awaited in the reverse order.
+  std::vector<Client::StreamHandler<Sum>> handlers;
+  for (int i = 0; i < 32; ++i) {
+    handlers.push_back(client.AsyncCall<Sum>(i, 100));
+  }
+  for (int i = 31; i >= 0; --i) {
+    EXPECT_EQ(handlers[i].AwaitResponse().sum, i + 100);
+  }
+  handlers.clear();
+
+  // Responses that nobody waits for are dropped.
+  for (int i = 0; i < 8; ++i) {
+    client.AsyncCall<Sum>(i, i);
+  }
+  EXPECT_EQ(client.Call<Sum>(10, 20).sum, 30);
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(Rpc, PipelinedConcurrent) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Sum>([](auto *req_reader, auto *res_builder) {
+    SumReq req;
+    memgraph::slk::Load(&req, req_reader);
+    SumRes res(req.x + req.y);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  memgraph::communication::ClientContext client_context;
+  Client client(server.endpoint(), &client_context);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&client, t] {
+      for (int i = 0; i < 200; ++i) {
+        if (i % 2 == 0) {
+          EXPECT_EQ(client.Call<Sum>(t, i).sum, t + i);
+        } else {
+          auto first = client.AsyncCall<Sum>(t, i);
+          auto second = client.AsyncCall<Sum>(i, i);
+          EXPECT_EQ(second.AwaitResponse().sum, 2 * i);
+          EXPECT_EQ(first.AwaitResponse().sum, t + i);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(Rpc, PipelinedManyResponses) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Echo>([](auto *req_reader, auto *res_builder) {
+    EchoMessage res;
+    memgraph::slk::Load(&res, req_reader);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  memgraph::communication::ClientContext client_context;
+  Client client(server.endpoint(), &client_context);
+
+  // All responses together don't fit into the socket buffers. The client must
+  // read responses while it is sending the requests, otherwise both sides
+  // block on writing.
+  const std::string testdata(65536, 'a');
+  std::vector<Client::StreamHandler<Echo>> handlers;
+  for (uint64_t i = 0; i < 16 * Client::kMaxInFlightRequests; ++i) {
+    handlers.push_back(client.AsyncCall<Echo>(testdata + std::to_string(i)));
+  }
+  for (uint64_t i = 0; i < handlers.size(); ++i) {
+    EXPECT_EQ(handlers[i].AwaitResponse().data, testdata + std::to_string(i));
+  }
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(Rpc, ProtocolVersionMismatch) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Sum>([](auto *req_reader, auto *res_builder) {
+    SumReq req;
+    memgraph::slk::Load(&req, req_reader);
+    SumRes res(req.x + req.y);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  // A request in the layout without the version, which started with the
+  // request type ID.
+  memgraph::communication::ClientContext client_context;
+  memgraph::communication::Client client(&client_context);
+  ASSERT_TRUE(client.Connect(server.endpoint()));
+  memgraph::slk::Builder builder(
+      [&client](const uint8_t *data, size_t size, bool have_more) { client.Write(data, size, have_more); });
+  memgraph::slk::Save(Sum::Request::kType.id, &builder);
+  memgraph::slk::Save(SumReq(1, 2), &builder);
+  builder.Finalize();
+
+  // The server closes the connection instead of answering.
+  EXPECT_FALSE(client.Read(1));
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(Rpc, StreamNotSent) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Echo>([](auto *req_reader, auto *res_builder) {
+    EchoMessage res;
+    memgraph::slk::Load(&res, req_reader);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  memgraph::communication::ClientContext client_context;
+  Client client(server.endpoint(), &client_context);
+  auto in_flight = client.AsyncCall<Echo>("first");
+
+  // A partially written request breaks the connection, so the request that
+  // was in flight fails and the client reconnects for the next call.
+  { auto stream = client.Stream<Echo>(std::string(100000, 'a')); }
+  EXPECT_THROW(in_flight.AwaitResponse(), RpcFailedException);
+  EXPECT_EQ(client.Call<Echo>("second").data, "second");
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
+
+TEST(Rpc, TryStreamInFlightLimit) {
+  memgraph::communication::ServerContext server_context;
+  Server server({"127.0.0.1", 0}, &server_context);
+  server.Register<Sum>([](auto *req_reader, auto *res_builder) {
+    SumReq req;
+    memgraph::slk::Load(&req, req_reader);
+    SumRes res(req.x + req.y);
+    memgraph::slk::Save(res, res_builder);
+  });
+  ASSERT_TRUE(server.Start());
+  std::this_thread::sleep_for(100ms);
+
+  memgraph::communication::ClientContext client_context;
+  Client client(server.endpoint(), &client_context);
+
+  // Once the limit is reached, nothing is sent instead of waiting for the
+  // responses.
+  std::vector<Client::StreamHandler<Sum>> handlers;
+  for (uint64_t i = 0; i < Client::kMaxInFlightRequests; ++i) {
+    auto stream = client.TryStream<Sum>(i, 1);
+    ASSERT_TRUE(stream);
+    stream->Send();
+    handlers.push_back(std::move(*stream));
+  }
+  EXPECT_FALSE(client.TryStream<Sum>(1, 1));
+
+  // A collected response makes room for the next request.
+  EXPECT_EQ(handlers.front().AwaitResponse().sum, 1);
+  auto stream = client.TryStream<Sum>(10, 20);
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(stream->AwaitResponse().sum, 30);
+  for (uint64_t i = 1; i < handlers.size(); ++i) {
+    EXPECT_EQ(handlers[i].AwaitResponse().sum, i + 1);
+  }
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
@@ -27,7 +27,7 @@ TEST(StorageV2, Commit) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -75,7 +75,7 @@ TEST(StorageV2, Abort) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -93,6 +93,45 @@ TEST(StorageV2, Abort) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2, CommitAndRestart) {
+  memgraph::storage::Storage store;
+  memgraph::storage::Gid gid1 = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  memgraph::storage::Gid gid2 = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  {
+    auto acc = store.Access();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    gid1 = vertex1.Gid();
+    ASSERT_FALSE(acc.CommitAndRestart().HasError());
+
+    // The changes are visible to other transactions after the commit.
+    {
+      auto other_acc = store.Access();
+      ASSERT_TRUE(other_acc.FindVertex(gid1, memgraph::storage::View::OLD).has_value());
+      other_acc.Abort();
+    }
+
+    // The accessors from the committed transaction can still be used.
+    auto vertex2 = acc.CreateVertex().GetValue();
+    gid2 = vertex2.Gid();
+    ASSERT_FALSE(vertex1.AddLabel(acc.NameToLabel("label")).HasError());
+    EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 1U);
+    EXPECT_EQ(CountVertices(acc, memgraph::storage::View::NEW), 2U);
+    acc.Abort();
+  }
+  {
+    // Only the changes made after the restart were aborted.
+    auto acc = store.Access();
+    auto vertex1 = acc.FindVertex(gid1, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex1);
+    auto labels = vertex1->Labels(memgraph::storage::View::OLD);
+    ASSERT_TRUE(labels.HasValue());
+    EXPECT_TRUE(labels->empty());
+    ASSERT_FALSE(acc.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
+    acc.Abort();
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST(StorageV2, AdvanceCommandCommit) {
   memgraph::storage::Storage store;
@@ -101,7 +140,7 @@ TEST(StorageV2, AdvanceCommandCommit) {
   {
     auto acc = store.Access();
 
-    auto vertex1 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     ASSERT_FALSE(acc.FindVertex(gid1, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -110,7 +149,7 @@ TEST(StorageV2, AdvanceCommandCommit) {
 
     acc.AdvanceCommand();
 
-    auto vertex2 = acc.CreateVertex();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid2 = vertex2.Gid();
     ASSERT_FALSE(acc.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 1U);
@@ -142,7 +181,7 @@ TEST(StorageV2, AdvanceCommandAbort) {
   {
     auto acc = store.Access();
 
-    auto vertex1 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     ASSERT_FALSE(acc.FindVertex(gid1, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -151,7 +190,7 @@ TEST(StorageV2, AdvanceCommandAbort) {
 
     acc.AdvanceCommand();
 
-    auto vertex2 = acc.CreateVertex();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid2 = vertex2.Gid();
     ASSERT_FALSE(acc.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 1U);
@@ -182,7 +221,7 @@ TEST(StorageV2, SnapshotIsolation) {
   auto acc1 = store.Access();
   auto acc2 = store.Access();
 
-  auto vertex = acc1.CreateVertex();
+  auto vertex = acc1.CreateVertex().GetValue();
   auto gid = vertex.Gid();
 
   ASSERT_FALSE(acc2.FindVertex(gid, memgraph::storage::View::OLD).has_value());
@@ -209,13 +248,142 @@ TEST(StorageV2, SnapshotIsolation) {
   acc3.Abort();
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2, ReadOnlySnapshotIsolation) {
+  memgraph::storage::Storage store;
+
+  memgraph::storage::Gid gid1;
+  {
+    auto acc = store.Access();
+    gid1 = acc.CreateVertex().GetValue().Gid();
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  auto acc1 = store.Access();
+  auto gid2 = acc1.CreateVertex().GetValue().Gid();
+
+  auto acc2 = store.ReadOnlyAccess();
+  ASSERT_TRUE(acc2.IsReadOnly());
+  ASSERT_TRUE(acc2.FindVertex(gid1, memgraph::storage::View::OLD).has_value());
+  ASSERT_FALSE(acc2.FindVertex(gid2, memgraph::storage::View::NEW).has_value());
+
+  ASSERT_FALSE(acc1.Commit().HasError());
+
+  ASSERT_FALSE(acc2.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
+  ASSERT_FALSE(acc2.FindVertex(gid2, memgraph::storage::View::NEW).has_value());
+  EXPECT_EQ(CountVertices(acc2, memgraph::storage::View::NEW), 1U);
+  ASSERT_FALSE(acc2.Commit().HasError());
+
+  auto acc3 = store.ReadOnlyAccess();
+  ASSERT_TRUE(acc3.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
+  EXPECT_EQ(CountVertices(acc3, memgraph::storage::View::OLD), 2U);
+
+  // The read-only transaction can be turned into a regular one before it is
+  // used for writing.
+  acc3.UpgradeToReadWrite();
+  ASSERT_FALSE(acc3.IsReadOnly());
+  acc3.CreateVertex().GetValue();
+  ASSERT_FALSE(acc3.Commit().HasError());
+
+  auto acc4 = store.ReadOnlyAccess();
+  EXPECT_EQ(CountVertices(acc4, memgraph::storage::View::OLD), 3U);
+  acc4.Abort();
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2, ReadOnlyAccessWithoutFreeSlots) {
+  memgraph::storage::Storage store;
+
+  // All read-only slots are taken, so the last transaction falls back to a
+  // regular one, which must behave the same way.
+  std::vector<memgraph::storage::Storage::Accessor> readers;
+  for (uint64_t i = 0; i <= memgraph::storage::ReadOnlyTransactions::kNumSlots; ++i) {
+    readers.push_back(store.ReadOnlyAccess());
+  }
+
+  auto acc = store.Access();
+  auto gid = acc.CreateVertex().GetValue().Gid();
+  ASSERT_FALSE(acc.Commit().HasError());
+
+  for (auto &reader : readers) {
+    ASSERT_FALSE(reader.FindVertex(gid, memgraph::storage::View::OLD).has_value());
+    ASSERT_FALSE(reader.Commit().HasError());
+  }
+  readers.clear();
+
+  auto reader = store.ReadOnlyAccess();
+  ASSERT_TRUE(reader.FindVertex(gid, memgraph::storage::View::OLD).has_value());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2, ReadOnlyAccessRejectsWrites) {
+  memgraph::storage::Storage store({.items = {.properties_on_edges = true}});
+  auto label = store.NameToLabel("Label");
+  auto property = store.NameToProperty("property");
+  auto edge_type = store.NameToEdgeType("EdgeType");
+
+  memgraph::storage::Gid vertex_gid;
+  {
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex().GetValue();
+    vertex_gid = vertex.Gid();
+    ASSERT_TRUE(acc.CreateEdge(&vertex, &vertex, edge_type).HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  auto check_writes = [&](memgraph::storage::Storage::Accessor &acc) {
+    constexpr auto kReadOnly = memgraph::storage::Error::READ_ONLY_TRANSACTION;
+    ASSERT_TRUE(acc.IsReadOnly());
+    auto vertex = acc.FindVertex(vertex_gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    auto edges = vertex->OutEdges(memgraph::storage::View::OLD);
+    ASSERT_TRUE(edges.HasValue());
+    ASSERT_EQ(edges->size(), 1);
+    auto *edge = &edges->front();
+
+    ASSERT_EQ(vertex->AddLabel(label).GetError(), kReadOnly);
+    ASSERT_EQ(vertex->RemoveLabel(label).GetError(), kReadOnly);
+    ASSERT_EQ(vertex->SetProperty(property, memgraph::storage::PropertyValue(1)).GetError(), kReadOnly);
+    ASSERT_EQ(vertex->ClearProperties().GetError(), kReadOnly);
+    ASSERT_EQ(edge->SetProperty(property, memgraph::storage::PropertyValue(1)).GetError(), kReadOnly);
+    ASSERT_EQ(edge->ClearProperties().GetError(), kReadOnly);
+    ASSERT_EQ(acc.CreateVertex().GetError(), kReadOnly);
+    ASSERT_EQ(acc.CreateEdge(&*vertex, &*vertex, edge_type).GetError(), kReadOnly);
+    ASSERT_EQ(acc.DeleteEdge(edge).GetError(), kReadOnly);
+    ASSERT_EQ(acc.DeleteVertex(&*vertex).GetError(), kReadOnly);
+    ASSERT_EQ(acc.DetachDeleteVertex(&*vertex).GetError(), kReadOnly);
+    ASSERT_FALSE(acc.Commit().HasError());
+  };
+
+  {
+    auto acc = store.ReadOnlyAccess();
+    check_writes(acc);
+  }
+
+  {
+    // A read-only transaction that didn't get a slot must reject writes too.
+    std::vector<memgraph::storage::Storage::Accessor> readers;
+    for (uint64_t i = 0; i < memgraph::storage::ReadOnlyTransactions::kNumSlots; ++i) {
+      readers.push_back(store.ReadOnlyAccess());
+    }
+    auto acc = store.ReadOnlyAccess();
+    check_writes(acc);
+  }
+
+  auto acc = store.Access();
+  auto vertex = acc.FindVertex(vertex_gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex);
+  ASSERT_FALSE(*vertex->HasLabel(label, memgraph::storage::View::NEW));
+  ASSERT_TRUE(vertex->GetProperty(property, memgraph::storage::View::NEW)->IsNull());
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST(StorageV2, AccessorMove) {
   memgraph::storage::Storage store;
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
 
     ASSERT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD).has_value());
@@ -252,7 +420,7 @@ TEST(StorageV2, VertexDeleteCommit) {
 
   // Create the vertex in transaction 2
   {
-    auto vertex = acc2.CreateVertex();
+    auto vertex = acc2.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc2.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc2, memgraph::storage::View::OLD), 0U);
@@ -326,7 +494,7 @@ TEST(StorageV2, VertexDeleteAbort) {
 
   // Create the vertex in transaction 2
   {
-    auto vertex = acc2.CreateVertex();
+    auto vertex = acc2.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc2.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc2, memgraph::storage::View::OLD), 0U);
@@ -450,7 +618,7 @@ TEST(StorageV2, VertexDeleteSerializationError) {
   // Create vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -527,7 +695,7 @@ TEST(StorageV2, VertexDeleteSpecialCases) {
   // transaction
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid1 = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid1, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -547,7 +715,7 @@ TEST(StorageV2, VertexDeleteSpecialCases) {
   // Create vertex and delete it in the same transaction
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid2 = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid2, memgraph::storage::View::OLD).has_value());
     EXPECT_EQ(CountVertices(acc, memgraph::storage::View::OLD), 0U);
@@ -585,7 +753,7 @@ TEST(StorageV2, VertexDeleteLabel) {
   // Create the vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     ASSERT_TRUE(acc.FindVertex(gid, memgraph::storage::View::NEW).has_value());
@@ -741,7 +909,7 @@ TEST(StorageV2, VertexDeleteProperty) {
   // Create the vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD).has_value());
     ASSERT_TRUE(acc.FindVertex(gid, memgraph::storage::View::NEW).has_value());
@@ -882,7 +1050,7 @@ TEST(StorageV2, VertexLabelCommit) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
 
     auto label = acc.NameToLabel("label5");
@@ -999,7 +1167,7 @@ TEST(StorageV2, VertexLabelAbort) {
   // Create the vertex.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1245,7 +1413,7 @@ TEST(StorageV2, VertexLabelSerializationError) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1353,7 +1521,7 @@ TEST(StorageV2, VertexPropertyCommit) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
 
     auto property = acc.NameToProperty("property5");
@@ -1477,7 +1645,7 @@ TEST(StorageV2, VertexPropertyAbort) {
   // Create the vertex.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1753,7 +1921,7 @@ TEST(StorageV2, VertexPropertySerializationError) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1853,7 +2021,7 @@ TEST(StorageV2, VertexPropertySerializationError) {
 TEST(StorageV2, VertexLabelPropertyMixed) {
   memgraph::storage::Storage store;
   auto acc = store.Access();
-  auto vertex = acc.CreateVertex();
+  auto vertex = acc.CreateVertex().GetValue();
 
   auto label = acc.NameToLabel("label5");
   auto property = acc.NameToProperty("property5");
@@ -2096,7 +2264,7 @@ TEST(StorageV2, VertexPropertyClear) {
   auto property2 = store.NameToProperty("property2");
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
 
     auto old_value = vertex.SetProperty(property1, memgraph::storage::PropertyValue("value"));
@@ -2201,7 +2369,7 @@ TEST(StorageV2, VertexNonexistentLabelPropertyEdgeAPI) {
   auto property = store.NameToProperty("property");
 
   auto acc = store.Access();
-  auto vertex = acc.CreateVertex();
+  auto vertex = acc.CreateVertex().GetValue();
 
   // Check state before (OLD view).
   ASSERT_EQ(vertex.Labels(memgraph::storage::View::OLD).GetError(), memgraph::storage::Error::NONEXISTENT_OBJECT);
@@ -2261,7 +2429,7 @@ TEST(StorageV2, VertexVisibilitySingleTransaction) {
   auto acc1 = store.Access();
   auto acc2 = store.Access();
 
-  auto vertex = acc1.CreateVertex();
+  auto vertex = acc1.CreateVertex().GetValue();
   auto gid = vertex.Gid();
 
   EXPECT_FALSE(acc1.FindVertex(gid, memgraph::storage::View::OLD));
@@ -2319,7 +2487,7 @@ TEST(StorageV2, VertexVisibilityMultipleTransactions) {
     auto acc1 = store.Access();
     auto acc2 = store.Access();
 
-    auto vertex = acc1.CreateVertex();
+    auto vertex = acc1.CreateVertex().GetValue();
     gid = vertex.Gid();
 
     EXPECT_FALSE(acc1.FindVertex(gid, memgraph::storage::View::OLD));
@@ -2561,7 +2729,7 @@ TEST(StorageV2, DeletedVertexAccessor) {
   // Create the vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_FALSE(vertex.SetProperty(property, property_value).HasError());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -73,7 +73,7 @@ TEST_F(ConstraintsTest, ExistenceConstraintsCreateAndDrop) {
 TEST_F(ConstraintsTest, ExistenceConstraintsCreateFailure1) {
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(acc.Commit());
   }
@@ -100,7 +100,7 @@ TEST_F(ConstraintsTest, ExistenceConstraintsCreateFailure1) {
 TEST_F(ConstraintsTest, ExistenceConstraintsCreateFailure2) {
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(acc.Commit());
   }
@@ -132,7 +132,7 @@ TEST_F(ConstraintsTest, ExistenceConstraintsViolationOnCommit) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
 
     auto res = acc.Commit();
@@ -143,7 +143,7 @@ TEST_F(ConstraintsTest, ExistenceConstraintsViolationOnCommit) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(acc.Commit());
@@ -177,7 +177,7 @@ TEST_F(ConstraintsTest, ExistenceConstraintsViolationOnCommit) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(acc.Commit());
   }
@@ -229,7 +229,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsCreateFailure1) {
   {
     auto acc = storage.Access();
     for (int i = 0; i < 2; ++i) {
-      auto vertex1 = acc.CreateVertex();
+      auto vertex1 = acc.CreateVertex().GetValue();
       ASSERT_NO_ERROR(vertex1.AddLabel(label1));
       ASSERT_NO_ERROR(vertex1.SetProperty(prop1, PropertyValue(1)));
     }
@@ -263,7 +263,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsCreateFailure2) {
   {
     auto acc = storage.Access();
     for (int i = 0; i < 2; ++i) {
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       ASSERT_NO_ERROR(vertex.AddLabel(label1));
       ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     }
@@ -300,8 +300,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation1) {
   Gid gid2;
   {
     auto acc = storage.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     gid2 = vertex2.Gid();
 
@@ -352,8 +352,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation2) {
 
     auto acc1 = storage.Access();
     auto acc2 = storage.Access();
-    auto vertex1 = acc1.CreateVertex();
-    auto vertex2 = acc2.CreateVertex();
+    auto vertex1 = acc1.CreateVertex().GetValue();
+    auto vertex2 = acc2.CreateVertex().GetValue();
 
     ASSERT_NO_ERROR(vertex1.AddLabel(label1));
     ASSERT_NO_ERROR(vertex1.SetProperty(prop1, PropertyValue(1)));
@@ -382,7 +382,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation3) {
     // tx3: ---------------------B---SP(v2, 1)---OK-
 
     auto acc1 = storage.Access();
-    auto vertex1 = acc1.CreateVertex();
+    auto vertex1 = acc1.CreateVertex().GetValue();
     auto gid = vertex1.Gid();
 
     ASSERT_NO_ERROR(vertex1.AddLabel(label1));
@@ -393,7 +393,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation3) {
     auto acc2 = storage.Access();
     auto acc3 = storage.Access();
     auto vertex2 = acc2.FindVertex(gid, View::NEW);  // vertex1 == vertex2
-    auto vertex3 = acc3.CreateVertex();
+    auto vertex3 = acc3.CreateVertex().GetValue();
 
     ASSERT_NO_ERROR(vertex2->SetProperty(prop1, PropertyValue(2)));
     ASSERT_NO_ERROR(vertex3.AddLabel(label1));
@@ -418,7 +418,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation4) {
     // tx3: ---------------------B---SP(v1, 2)---OK--
 
     auto acc1 = storage.Access();
-    auto vertex1 = acc1.CreateVertex();
+    auto vertex1 = acc1.CreateVertex().GetValue();
     auto gid = vertex1.Gid();
 
     ASSERT_NO_ERROR(vertex1.AddLabel(label1));
@@ -428,7 +428,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsNoViolation4) {
 
     auto acc2 = storage.Access();
     auto acc3 = storage.Access();
-    auto vertex2 = acc2.CreateVertex();
+    auto vertex2 = acc2.CreateVertex().GetValue();
     auto vertex3 = acc3.FindVertex(gid, View::NEW);
 
     ASSERT_NO_ERROR(vertex2.AddLabel(label1));
@@ -450,8 +450,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsViolationOnCommit1) {
 
   {
     auto acc = storage.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex1.AddLabel(label1));
     ASSERT_NO_ERROR(vertex1.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex2.AddLabel(label1));
@@ -477,8 +477,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsViolationOnCommit2) {
     // tx3: --------------------------------B---SP(v2, 3)---FAIL-
 
     auto acc1 = storage.Access();
-    auto vertex1 = acc1.CreateVertex();
-    auto vertex2 = acc1.CreateVertex();
+    auto vertex1 = acc1.CreateVertex().GetValue();
+    auto vertex2 = acc1.CreateVertex().GetValue();
     auto gid1 = vertex1.Gid();
     auto gid2 = vertex2.Gid();
 
@@ -519,8 +519,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsViolationOnCommit3) {
     // tx3: --------------------------------B---SP(v2, 1)---FAIL-
 
     auto acc1 = storage.Access();
-    auto vertex1 = acc1.CreateVertex();
-    auto vertex2 = acc1.CreateVertex();
+    auto vertex1 = acc1.CreateVertex().GetValue();
+    auto vertex2 = acc1.CreateVertex().GetValue();
     auto gid1 = vertex1.Gid();
     auto gid2 = vertex2.Gid();
 
@@ -568,8 +568,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsLabelAlteration) {
     // B---AL(v2)---SP(v1, 1)---SP(v2, 1)---OK
 
     auto acc = storage.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     gid2 = vertex2.Gid();
 
@@ -725,8 +725,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsMultipleProperties) {
   Gid gid2;
   {
     auto acc = storage.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     gid2 = vertex2.Gid();
 
@@ -775,7 +775,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertAbortInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
@@ -784,7 +784,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertAbortInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
@@ -802,7 +802,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertRemoveInsert) {
   Gid gid;
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
@@ -819,7 +819,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertRemoveInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
@@ -837,7 +837,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertRemoveAbortInsert) {
   Gid gid;
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(2)));
@@ -854,7 +854,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertRemoveAbortInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(2)));
@@ -876,8 +876,8 @@ TEST_F(ConstraintsTest, UniqueConstraintsDeleteVertexSetProperty) {
   Gid gid2;
   {
     auto acc = storage.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     gid1 = vertex1.Gid();
     gid2 = vertex2.Gid();
 
@@ -915,7 +915,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertDropInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
@@ -926,7 +926,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsInsertDropInsert) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
@@ -946,7 +946,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsComparePropertyValues) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(2)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(1)));
@@ -955,7 +955,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsComparePropertyValues) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(1)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(2)));
@@ -964,7 +964,7 @@ TEST_F(ConstraintsTest, UniqueConstraintsComparePropertyValues) {
 
   {
     auto acc = storage.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     ASSERT_NO_ERROR(vertex.AddLabel(label1));
     ASSERT_NO_ERROR(vertex.SetProperty(prop2, PropertyValue(0)));
     ASSERT_NO_ERROR(vertex.SetProperty(prop1, PropertyValue(3)));
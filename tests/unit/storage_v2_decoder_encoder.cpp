@@ -337,6 +337,9 @@ TEST_F(DecoderEncoderTest, PropertyValueInvalidMarker) {
         case memgraph::storage::durability::Marker::SECTION_CONSTRAINTS:
         case memgraph::storage::durability::Marker::SECTION_DELTA:
         case memgraph::storage::durability::Marker::SECTION_EPOCH_HISTORY:
+        case memgraph::storage::durability::Marker::SECTION_BLOCK:
+        case memgraph::storage::durability::Marker::SECTION_BLOCK_INDEX:
+        case memgraph::storage::durability::Marker::SECTION_DELETED:
         case memgraph::storage::durability::Marker::SECTION_OFFSETS:
         case memgraph::storage::durability::Marker::DELTA_VERTEX_CREATE:
         case memgraph::storage::durability::Marker::DELTA_VERTEX_DELETE:
@@ -355,6 +358,12 @@ TEST_F(DecoderEncoderTest, PropertyValueInvalidMarker) {
         case memgraph::storage::durability::Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTIES_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTIES_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_TEXT_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_TEXT_INDEX_DROP:
         case memgraph::storage::durability::Marker::VALUE_FALSE:
         case memgraph::storage::durability::Marker::VALUE_TRUE:
           valid_marker = false;
@@ -459,3 +468,41 @@ TEST_F(DecoderEncoderTest, EncoderPosition) {
     ASSERT_EQ(pos, decoder.GetSize());
   }
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, BufferDecoder) {
+  const auto value = memgraph::storage::PropertyValue(std::vector<memgraph::storage::PropertyValue>{
+      memgraph::storage::PropertyValue(), memgraph::storage::PropertyValue(true),
+      memgraph::storage::PropertyValue(123L), memgraph::storage::PropertyValue("nandare"),
+      memgraph::storage::PropertyValue{
+          std::map<std::string, memgraph::storage::PropertyValue>{{"haihai", memgraph::storage::PropertyValue()}}}});
+  memgraph::storage::durability::BufferEncoder encoder;
+  encoder.WriteMarker(memgraph::storage::durability::Marker::SECTION_BLOCK);
+  encoder.WriteUint(123123123);
+  encoder.WriteString("nandare");
+  encoder.WritePropertyValue(value);
+  encoder.WritePropertyValue(value);
+  {
+    memgraph::storage::durability::BufferDecoder decoder(encoder.data(), encoder.size());
+    auto marker = decoder.ReadMarker();
+    ASSERT_TRUE(marker);
+    ASSERT_EQ(*marker, memgraph::storage::durability::Marker::SECTION_BLOCK);
+    auto uint = decoder.ReadUint();
+    ASSERT_TRUE(uint);
+    ASSERT_EQ(*uint, 123123123);
+    ASSERT_TRUE(decoder.SkipString());
+    auto decoded = decoder.ReadPropertyValue();
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(*decoded, value);
+    ASSERT_TRUE(decoder.SkipPropertyValue());
+    ASSERT_EQ(decoder.GetPosition(), decoder.GetSize());
+    ASSERT_FALSE(decoder.ReadMarker());
+  }
+  // Decoding must fail instead of reading past the end of a truncated buffer.
+  for (size_t size = 0; size < encoder.size(); ++size) {
+    memgraph::storage::durability::BufferDecoder decoder(encoder.data(), size);
+    bool success = decoder.ReadMarker() && decoder.ReadUint() && decoder.SkipString() && decoder.ReadPropertyValue() &&
+                   decoder.SkipPropertyValue();
+    ASSERT_FALSE(success);
+  }
+}
@@ -25,6 +25,7 @@
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/snapshot.hpp"
 #include "storage/v2/durability/version.hpp"
+#include "storage/v2/durability/wal.hpp"
 #include "storage/v2/storage.hpp"
 #include "utils/file.hpp"
 #include "utils/logging.hpp"
@@ -88,7 +89,7 @@ class DurabilityTest : public ::testing::TestWithParam<bool> {
     // Create vertices.
     for (uint64_t i = 0; i < kNumBaseVertices; ++i) {
       auto acc = store->Access();
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       base_vertex_gids_[i] = vertex.Gid();
       if (i < kNumBaseVertices / 2) {
         ASSERT_TRUE(vertex.AddLabel(label_indexed).HasValue());
@@ -156,7 +157,7 @@ class DurabilityTest : public ::testing::TestWithParam<bool> {
     // Create vertices.
     for (uint64_t i = 0; i < kNumExtendedVertices; ++i) {
       if (!single_transaction) acc.emplace(store->Access());
-      auto vertex = acc->CreateVertex();
+      auto vertex = acc->CreateVertex().GetValue();
       extended_vertex_gids_[i] = vertex.Gid();
       if (i < kNumExtendedVertices / 2) {
         ASSERT_TRUE(vertex.AddLabel(label_indexed).HasValue());
@@ -686,13 +687,212 @@ TEST_P(DurabilityTest, SnapshotOnExit) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotParallelRecovery) {
+  // The dataset spans multiple snapshot blocks so that the blocks are
+  // recovered concurrently.
+  const uint64_t kNumVertices = 25000;
+
+  // Create snapshot.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {.storage_directory = storage_directory, .snapshot_thread_count = 4, .snapshot_on_exit = true}});
+    auto label = store.NameToLabel("label");
+    auto property = store.NameToProperty("property");
+    auto et = store.NameToEdgeType("et");
+    auto acc = store.Access();
+    std::vector<memgraph::storage::VertexAccessor> vertices;
+    vertices.reserve(kNumVertices);
+    for (uint64_t i = 0; i < kNumVertices; ++i) {
+      auto vertex = acc.CreateVertex().GetValue();
+      ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+      ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(static_cast<int64_t>(i))).HasValue());
+      vertices.push_back(vertex);
+    }
+    for (uint64_t i = 0; i < kNumVertices; ++i) {
+      auto edge = acc.CreateEdge(&vertices[i], &vertices[(i + 1) % kNumVertices], et);
+      ASSERT_TRUE(edge.HasValue());
+      if (GetParam()) {
+        ASSERT_TRUE(edge->SetProperty(property, memgraph::storage::PropertyValue(static_cast<int64_t>(i))).HasValue());
+      }
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 1);
+
+  // Recover snapshot.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true, .recovery_thread_count = 4}});
+  auto label = store.NameToLabel("label");
+  auto property = store.NameToProperty("property");
+  auto acc = store.Access();
+  uint64_t count = 0;
+  for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+    ASSERT_TRUE(*vertex.HasLabel(label, memgraph::storage::View::OLD));
+    auto value = vertex.GetProperty(property, memgraph::storage::View::OLD);
+    ASSERT_TRUE(value.HasValue());
+    auto id = value->ValueInt();
+    auto out_edges = vertex.OutEdges(memgraph::storage::View::OLD);
+    ASSERT_TRUE(out_edges.HasValue());
+    ASSERT_EQ(out_edges->size(), 1);
+    auto to_value = out_edges->front().ToVertex().GetProperty(property, memgraph::storage::View::OLD);
+    ASSERT_TRUE(to_value.HasValue());
+    ASSERT_EQ(to_value->ValueInt(), (id + 1) % static_cast<int64_t>(kNumVertices));
+    if (GetParam()) {
+      auto edge_value = out_edges->front().GetProperty(property, memgraph::storage::View::OLD);
+      ASSERT_TRUE(edge_value.HasValue());
+      ASSERT_EQ(edge_value->ValueInt(), id);
+    }
+    auto in_edges = vertex.InEdges(memgraph::storage::View::OLD);
+    ASSERT_TRUE(in_edges.HasValue());
+    ASSERT_EQ(in_edges->size(), 1);
+    ++count;
+  }
+  ASSERT_EQ(count, kNumVertices);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotDifferential) {
+  const int64_t kNumVertices = 100;
+  const memgraph::storage::Config config{
+      .items = {.properties_on_edges = GetParam()},
+      .durability = {.storage_directory = storage_directory,
+                     .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT,
+                     .snapshot_interval = std::chrono::hours(1),
+                     .snapshot_retention_count = 1,
+                     .snapshot_differential_count = 2}};
+  std::vector<memgraph::storage::Gid> gids;
+
+  // Create a full snapshot followed by two differential snapshots.
+  {
+    memgraph::storage::Storage store(config);
+    auto property = store.NameToProperty("id");
+    auto et = store.NameToEdgeType("et");
+    {
+      auto acc = store.Access();
+      std::vector<memgraph::storage::VertexAccessor> vertices;
+      for (int64_t i = 0; i < kNumVertices; ++i) {
+        auto vertex = acc.CreateVertex().GetValue();
+        ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(i)).HasValue());
+        gids.push_back(vertex.Gid());
+        vertices.push_back(vertex);
+      }
+      for (int64_t i = 0; i < kNumVertices; ++i) {
+        auto edge = acc.CreateEdge(&vertices[i], &vertices[(i + 1) % kNumVertices], et);
+        ASSERT_TRUE(edge.HasValue());
+        if (GetParam()) ASSERT_TRUE(edge->SetProperty(property, memgraph::storage::PropertyValue(i)).HasValue());
+      }
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+
+    {
+      auto acc = store.Access();
+      auto first = acc.FindVertex(gids[0], memgraph::storage::View::OLD);
+      ASSERT_TRUE(first);
+      ASSERT_TRUE(first->SetProperty(property, memgraph::storage::PropertyValue(kNumVertices)).HasValue());
+      auto last = acc.FindVertex(gids[kNumVertices - 1], memgraph::storage::View::OLD);
+      ASSERT_TRUE(last);
+      ASSERT_TRUE(acc.DetachDeleteVertex(&*last).HasValue());
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+
+    {
+      auto acc = store.Access();
+      auto second = acc.FindVertex(gids[1], memgraph::storage::View::OLD);
+      ASSERT_TRUE(second);
+      auto vertex = acc.CreateVertex().GetValue();
+      ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(2 * kNumVertices)).HasValue());
+      auto edge = acc.CreateEdge(&*second, &vertex, et);
+      ASSERT_TRUE(edge.HasValue());
+      if (GetParam()) {
+        ASSERT_TRUE(edge->SetProperty(property, memgraph::storage::PropertyValue(2 * kNumVertices)).HasValue());
+      }
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+  }
+
+  // Check the chain of snapshots.
+  {
+    auto snapshots = GetSnapshotsList();
+    ASSERT_EQ(snapshots.size(), 3);
+    std::reverse(snapshots.begin(), snapshots.end());
+    auto full = memgraph::storage::durability::ReadSnapshotInfo(snapshots[0]);
+    auto first_differential = memgraph::storage::durability::ReadSnapshotInfo(snapshots[1]);
+    auto second_differential = memgraph::storage::durability::ReadSnapshotInfo(snapshots[2]);
+    ASSERT_FALSE(full.base_start_timestamp);
+    ASSERT_EQ(full.vertices_count, kNumVertices);
+    ASSERT_EQ(first_differential.base_start_timestamp, full.start_timestamp);
+    ASSERT_EQ(first_differential.vertices_count, 2);
+    ASSERT_EQ(second_differential.base_start_timestamp, first_differential.start_timestamp);
+    ASSERT_EQ(second_differential.vertices_count, 2);
+  }
+
+  // Recover the full snapshot with the differential snapshots applied on top.
+  memgraph::storage::Storage store(
+      {.items = config.items,
+       .durability = {.storage_directory = storage_directory,
+                      .recover_on_startup = true,
+                      .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT,
+                      .snapshot_interval = std::chrono::hours(1),
+                      .snapshot_retention_count = 1,
+                      .snapshot_differential_count = 2}});
+  auto property = store.NameToProperty("id");
+  {
+    auto acc = store.Access();
+    auto get_id = [&](const auto &object) {
+      auto value = object.GetProperty(property, memgraph::storage::View::OLD);
+      MG_ASSERT(value.HasValue() && value->IsInt());
+      return value->ValueInt();
+    };
+    ASSERT_FALSE(acc.FindVertex(gids[kNumVertices - 1], memgraph::storage::View::OLD));
+    ASSERT_EQ(acc.ApproximateEdgeCount(), kNumVertices - 1);
+    int64_t count = 0;
+    for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+      auto id = get_id(vertex);
+      auto in_edges = vertex.InEdges(memgraph::storage::View::OLD);
+      auto out_edges = vertex.OutEdges(memgraph::storage::View::OLD);
+      ASSERT_TRUE(in_edges.HasValue() && out_edges.HasValue());
+      if (id == kNumVertices) {
+        ASSERT_EQ(vertex.Gid(), gids[0]);
+        ASSERT_EQ(in_edges->size(), 0);
+        ASSERT_EQ(out_edges->size(), 1);
+      } else if (id == 2 * kNumVertices) {
+        ASSERT_EQ(in_edges->size(), 1);
+        ASSERT_EQ(out_edges->size(), 0);
+        ASSERT_EQ(in_edges->front().FromVertex().Gid(), gids[1]);
+        if (GetParam()) ASSERT_EQ(get_id(in_edges->front()), 2 * kNumVertices);
+      } else {
+        ASSERT_EQ(vertex.Gid(), gids[id]);
+        ASSERT_EQ(in_edges->size(), 1);
+        ASSERT_EQ(out_edges->size(), id == 1 ? 2 : (id == kNumVertices - 2 ? 0 : 1));
+        if (GetParam()) ASSERT_EQ(get_id(in_edges->front()), id - 1);
+      }
+      ++count;
+    }
+    ASSERT_EQ(count, kNumVertices);
+  }
+
+  // The first snapshot after recovery is a full snapshot, so the old chain of
+  // snapshots is deleted.
+  ASSERT_FALSE(store.CreateSnapshot().HasError());
+  auto snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 1);
+  ASSERT_FALSE(memgraph::storage::durability::ReadSnapshotInfo(snapshots[0]).base_start_timestamp);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, SnapshotPeriodic) {
   // Create snapshot.
@@ -720,7 +920,7 @@ TEST_P(DurabilityTest, SnapshotPeriodic) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -764,7 +964,7 @@ TEST_P(DurabilityTest, SnapshotFallback) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -780,7 +980,7 @@ TEST_P(DurabilityTest, SnapshotEverythingCorrupt) {
          .durability = {.storage_directory = storage_directory, .snapshot_on_exit = true}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -858,7 +1058,7 @@ TEST_P(DurabilityTest, SnapshotRetention) {
          .durability = {.storage_directory = storage_directory, .snapshot_on_exit = true}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -915,7 +1115,7 @@ TEST_P(DurabilityTest, SnapshotRetention) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -979,7 +1179,7 @@ TEST_P(DurabilityTest, SnapshotMixedUUID) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -995,7 +1195,7 @@ TEST_P(DurabilityTest, SnapshotBackup) {
          .durability = {.storage_directory = storage_directory, .snapshot_on_exit = true}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1047,7 +1247,7 @@ TEST_F(DurabilityTest, SnapshotWithoutPropertiesOnEdgesRecoveryWithPropertiesOnE
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1136,7 +1336,7 @@ TEST_F(DurabilityTest, SnapshotWithPropertiesOnEdgesButUnusedRecoveryWithoutProp
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1172,7 +1372,48 @@ TEST_P(DurabilityTest, WalBasic) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
+    auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, WalCompressedParallelRecovery) {
+  // Create WALs.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_size_kibibytes = 1,
+             .wal_file_flush_every_n_tx = kFlushWalEvery,
+             .wal_compression = true}});
+    CreateBaseDataset(&store, GetParam());
+    CreateExtendedDataset(&store);
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 0);
+  ASSERT_EQ(GetBackupSnapshotsList().size(), 0);
+  auto wals = GetWalsList();
+  ASSERT_GE(wals.size(), 2);
+  for (const auto &wal : wals) {
+    ASSERT_TRUE(memgraph::storage::durability::ReadWalInfo(wal).compressed);
+  }
+
+  // Recover WALs.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true, .recovery_thread_count = 4}});
+  VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+
+  // Try to use the storage.
+  {
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1193,7 +1434,7 @@ TEST_P(DurabilityTest, WalBackup) {
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1274,7 +1515,7 @@ TEST_P(DurabilityTest, WalAppendToExisting) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1296,9 +1537,9 @@ TEST_P(DurabilityTest, WalCreateInSingleTransaction) {
              .snapshot_interval = std::chrono::minutes(20),
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
-    auto v1 = acc.CreateVertex();
+    auto v1 = acc.CreateVertex().GetValue();
     gid_v1 = v1.Gid();
-    auto v2 = acc.CreateVertex();
+    auto v2 = acc.CreateVertex().GetValue();
     gid_v2 = v2.Gid();
     auto e1 = acc.CreateEdge(&v1, &v2, store.NameToEdgeType("e1"));
     ASSERT_TRUE(e1.HasValue());
@@ -1312,7 +1553,7 @@ TEST_P(DurabilityTest, WalCreateInSingleTransaction) {
     }
     ASSERT_TRUE(v2.AddLabel(store.NameToLabel("l21")).HasValue());
     ASSERT_TRUE(v2.SetProperty(store.NameToProperty("hello"), memgraph::storage::PropertyValue("world")).HasValue());
-    auto v3 = acc.CreateVertex();
+    auto v3 = acc.CreateVertex().GetValue();
     gid_v3 = v3.Gid();
     ASSERT_TRUE(v3.SetProperty(store.NameToProperty("v3"), memgraph::storage::PropertyValue(42)).HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1411,7 +1652,7 @@ TEST_P(DurabilityTest, WalCreateInSingleTransaction) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1481,7 +1722,7 @@ TEST_P(DurabilityTest, WalCreateAndRemoveEverything) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1509,7 +1750,7 @@ TEST_P(DurabilityTest, WalTransactionOrdering) {
 
     // Create vertex in transaction 2.
     {
-      auto vertex2 = acc2.CreateVertex();
+      auto vertex2 = acc2.CreateVertex().GetValue();
       gid2 = vertex2.Gid();
       ASSERT_TRUE(vertex2.SetProperty(store.NameToProperty("id"), memgraph::storage::PropertyValue(2)).HasValue());
     }
@@ -1518,14 +1759,14 @@ TEST_P(DurabilityTest, WalTransactionOrdering) {
 
     // Create vertex in transaction 3.
     {
-      auto vertex3 = acc3.CreateVertex();
+      auto vertex3 = acc3.CreateVertex().GetValue();
       gid3 = vertex3.Gid();
       ASSERT_TRUE(vertex3.SetProperty(store.NameToProperty("id"), memgraph::storage::PropertyValue(3)).HasValue());
     }
 
     // Create vertex in transaction 1.
     {
-      auto vertex1 = acc1.CreateVertex();
+      auto vertex1 = acc1.CreateVertex().GetValue();
       gid1 = vertex1.Gid();
       ASSERT_TRUE(vertex1.SetProperty(store.NameToProperty("id"), memgraph::storage::PropertyValue(1)).HasValue());
     }
@@ -1611,7 +1852,7 @@ TEST_P(DurabilityTest, WalTransactionOrdering) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1658,7 +1899,7 @@ TEST_P(DurabilityTest, WalCreateAndRemoveOnlyBaseDataset) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1681,7 +1922,7 @@ TEST_P(DurabilityTest, WalDeathResilience) {
       // Create one million vertices.
       for (uint64_t i = 0; i < 1000000; ++i) {
         auto acc = store.Access();
-        acc.CreateVertex();
+        acc.CreateVertex().GetValue();
         MG_ASSERT(!acc.Commit().HasError(), "Couldn't commit transaction!");
       }
     }
@@ -1727,7 +1968,7 @@ TEST_P(DurabilityTest, WalDeathResilience) {
     {
       auto acc = store.Access();
       for (uint64_t i = 0; i < kExtraItems; ++i) {
-        acc.CreateVertex();
+        acc.CreateVertex().GetValue();
       }
       ASSERT_FALSE(acc.Commit().HasError());
     }
@@ -1755,7 +1996,7 @@ TEST_P(DurabilityTest, WalDeathResilience) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1776,7 +2017,7 @@ TEST_P(DurabilityTest, WalMissingSecond) {
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1803,7 +2044,7 @@ TEST_P(DurabilityTest, WalMissingSecond) {
     gids.reserve(kNumVertices);
     for (uint64_t i = 0; i < kNumVertices; ++i) {
       auto acc = store.Access();
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       gids.push_back(vertex.Gid());
       ASSERT_FALSE(acc.Commit().HasError());
     }
@@ -1863,7 +2104,7 @@ TEST_P(DurabilityTest, WalCorruptSecond) {
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1890,7 +2131,7 @@ TEST_P(DurabilityTest, WalCorruptSecond) {
     gids.reserve(kNumVertices);
     for (uint64_t i = 0; i < kNumVertices; ++i) {
       auto acc = store.Access();
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       gids.push_back(vertex.Gid());
       ASSERT_FALSE(acc.Commit().HasError());
     }
@@ -1975,7 +2216,7 @@ TEST_P(DurabilityTest, WalCorruptLastTransaction) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1995,15 +2236,15 @@ TEST_P(DurabilityTest, WalAllOperationsInSingleTransaction) {
              .wal_file_size_kibibytes = 1,
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
     ASSERT_TRUE(vertex1.AddLabel(acc.NameToLabel("nandare")).HasValue());
     ASSERT_TRUE(vertex2.SetProperty(acc.NameToProperty("haihai"), memgraph::storage::PropertyValue(42)).HasValue());
     ASSERT_TRUE(vertex1.RemoveLabel(acc.NameToLabel("nandare")).HasValue());
     auto edge1 = acc.CreateEdge(&vertex1, &vertex2, acc.NameToEdgeType("et1"));
     ASSERT_TRUE(edge1.HasValue());
     ASSERT_TRUE(vertex2.SetProperty(acc.NameToProperty("haihai"), memgraph::storage::PropertyValue()).HasValue());
-    auto vertex3 = acc.CreateVertex();
+    auto vertex3 = acc.CreateVertex().GetValue();
     auto edge2 = acc.CreateEdge(&vertex3, &vertex3, acc.NameToEdgeType("et2"));
     ASSERT_TRUE(edge2.HasValue());
     if (GetParam()) {
@@ -2048,7 +2289,7 @@ TEST_P(DurabilityTest, WalAllOperationsInSingleTransaction) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2085,7 +2326,7 @@ TEST_P(DurabilityTest, WalAndSnapshot) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2142,7 +2383,7 @@ TEST_P(DurabilityTest, WalAndSnapshotAppendToExistingSnapshot) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2203,7 +2444,7 @@ TEST_P(DurabilityTest, WalAndSnapshotAppendToExistingSnapshotAndWal) {
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     vertex_gid = vertex.Gid();
     if (GetParam()) {
       ASSERT_TRUE(vertex.SetProperty(store.NameToProperty("meaning"), memgraph::storage::PropertyValue(42)).HasValue());
@@ -2242,7 +2483,7 @@ TEST_P(DurabilityTest, WalAndSnapshotAppendToExistingSnapshotAndWal) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2263,7 +2504,7 @@ TEST_P(DurabilityTest, WalAndSnapshotWalRetention) {
              .wal_file_flush_every_n_tx = kFlushWalEvery}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -2293,7 +2534,7 @@ TEST_P(DurabilityTest, WalAndSnapshotWalRetention) {
     // Allow at least 6 snapshots to be created.
     while (timer.Elapsed().count() < 13.0) {
       auto acc = store.Access();
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
       ASSERT_FALSE(acc.Commit().HasError());
       ++items_created;
     }
@@ -2349,7 +2590,7 @@ TEST_P(DurabilityTest, SnapshotAndWalMixedUUID) {
              .snapshot_interval = std::chrono::seconds(2)}});
     auto acc = store.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      acc.CreateVertex();
+      acc.CreateVertex().GetValue();
     }
     ASSERT_FALSE(acc.Commit().HasError());
     std::this_thread::sleep_for(std::chrono::milliseconds(2500));
@@ -2396,7 +2637,7 @@ TEST_P(DurabilityTest, SnapshotAndWalMixedUUID) {
   // Try to use the storage.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
     ASSERT_TRUE(edge.HasValue());
     ASSERT_FALSE(acc.Commit().HasError());
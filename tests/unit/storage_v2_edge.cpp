@@ -32,8 +32,8 @@ TEST_P(StorageEdgeTest, EdgeCreateFromSmallerCommit) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -222,8 +222,8 @@ TEST_P(StorageEdgeTest, EdgeCreateFromLargerCommit) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_to = acc.CreateVertex();
-    auto vertex_from = acc.CreateVertex();
+    auto vertex_to = acc.CreateVertex().GetValue();
+    auto vertex_from = acc.CreateVertex().GetValue();
     gid_to = vertex_to.Gid();
     gid_from = vertex_from.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -393,7 +393,7 @@ TEST_P(StorageEdgeTest, EdgeCreateFromSameCommit) {
   // Create vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid_vertex = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -539,8 +539,8 @@ TEST_P(StorageEdgeTest, EdgeCreateFromSmallerAbort) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -808,8 +808,8 @@ TEST_P(StorageEdgeTest, EdgeCreateFromLargerAbort) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_to = acc.CreateVertex();
-    auto vertex_from = acc.CreateVertex();
+    auto vertex_to = acc.CreateVertex().GetValue();
+    auto vertex_from = acc.CreateVertex().GetValue();
     gid_to = vertex_to.Gid();
     gid_from = vertex_from.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1076,7 +1076,7 @@ TEST_P(StorageEdgeTest, EdgeCreateFromSameAbort) {
   // Create vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid_vertex = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -1303,8 +1303,8 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromSmallerCommit) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1571,8 +1571,8 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromLargerCommit) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_to = acc.CreateVertex();
-    auto vertex_from = acc.CreateVertex();
+    auto vertex_to = acc.CreateVertex().GetValue();
+    auto vertex_from = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -1838,7 +1838,7 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromSameCommit) {
   // Create vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid_vertex = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -2064,8 +2064,8 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromSmallerAbort) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2486,8 +2486,8 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromLargerAbort) {
   // Create vertices
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
     gid_from = vertex_from.Gid();
     gid_to = vertex_to.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
@@ -2908,7 +2908,7 @@ TEST_P(StorageEdgeTest, EdgeDeleteFromSameAbort) {
   // Create vertex
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid_vertex = vertex.Gid();
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -3268,8 +3268,8 @@ TEST_P(StorageEdgeTest, VertexDetachDeleteSingleCommit) {
   // Create dataset
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
 
     auto et = acc.NameToEdgeType("et5");
 
@@ -3407,8 +3407,8 @@ TEST_P(StorageEdgeTest, VertexDetachDeleteMultipleCommit) {
   // Create dataset
   {
     auto acc = store.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
 
     gid_vertex1 = vertex1.Gid();
     gid_vertex2 = vertex2.Gid();
@@ -3736,8 +3736,8 @@ TEST_P(StorageEdgeTest, VertexDetachDeleteSingleAbort) {
   // Create dataset
   {
     auto acc = store.Access();
-    auto vertex_from = acc.CreateVertex();
-    auto vertex_to = acc.CreateVertex();
+    auto vertex_from = acc.CreateVertex().GetValue();
+    auto vertex_to = acc.CreateVertex().GetValue();
 
     auto et = acc.NameToEdgeType("et5");
 
@@ -3980,8 +3980,8 @@ TEST_P(StorageEdgeTest, VertexDetachDeleteMultipleAbort) {
   // Create dataset
   {
     auto acc = store.Access();
-    auto vertex1 = acc.CreateVertex();
-    auto vertex2 = acc.CreateVertex();
+    auto vertex1 = acc.CreateVertex().GetValue();
+    auto vertex2 = acc.CreateVertex().GetValue();
 
     gid_vertex1 = vertex1.Gid();
     gid_vertex2 = vertex2.Gid();
@@ -4622,7 +4622,7 @@ TEST(StorageWithProperties, EdgePropertyCommit) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -4754,7 +4754,7 @@ TEST(StorageWithProperties, EdgePropertyAbort) {
   // Create the vertex.
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -5043,7 +5043,7 @@ TEST(StorageWithProperties, EdgePropertySerializationError) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -5154,7 +5154,7 @@ TEST(StorageWithProperties, EdgePropertyClear) {
   auto property2 = store.NameToProperty("property2");
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -5267,7 +5267,7 @@ TEST(StorageWithoutProperties, EdgePropertyAbort) {
   memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -5335,7 +5335,7 @@ TEST(StorageWithoutProperties, EdgePropertyClear) {
   memgraph::storage::Gid gid;
   {
     auto acc = store.Access();
-    auto vertex = acc.CreateVertex();
+    auto vertex = acc.CreateVertex().GetValue();
     gid = vertex.Gid();
     auto et = acc.NameToEdgeType("et5");
     auto edge = acc.CreateEdge(&vertex, &vertex, et).GetValue();
@@ -5362,7 +5362,7 @@ TEST(StorageWithProperties, EdgeNonexistentPropertyAPI) {
   auto property = store.NameToProperty("property");
 
   auto acc = store.Access();
-  auto vertex = acc.CreateVertex();
+  auto vertex = acc.CreateVertex().GetValue();
   auto edge = acc.CreateEdge(&vertex, &vertex, acc.NameToEdgeType("edge"));
   ASSERT_TRUE(edge.HasValue());
 
@@ -33,7 +33,7 @@ TEST(StorageV2Gc, Sanity) {
     auto acc = storage.Access();
     // Create some vertices, but delete some of them immediately.
     for (uint64_t i = 0; i < 1000; ++i) {
-      auto vertex = acc.CreateVertex();
+      auto vertex = acc.CreateVertex().GetValue();
       vertices.push_back(vertex.Gid());
     }
 
@@ -174,7 +174,7 @@ TEST(StorageV2Gc, Indices) {
   {
     auto acc0 = storage.Access();
     for (uint64_t i = 0; i < 1000; ++i) {
-      auto vertex = acc0.CreateVertex();
+      auto vertex = acc0.CreateVertex().GetValue();
       ASSERT_TRUE(*vertex.AddLabel(acc0.NameToLabel("label")));
     }
     ASSERT_FALSE(acc0.Commit().HasError());
@@ -198,3 +198,54 @@ TEST(StorageV2Gc, Indices) {
     EXPECT_EQ(gids.size(), 1000);
   }
 }
+
+// Verify that the GC doesn't free the old versions of objects while a
+// read-only transaction that needs them is active, even though read-only
+// transactions aren't tracked in the commit log.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, ReadOnlyTransaction) {
+  memgraph::storage::Storage storage(memgraph::storage::Config{
+      .gc = {.type = memgraph::storage::Config::Gc::Type::PERIODIC, .interval = std::chrono::milliseconds(100)}});
+  auto property = storage.NameToProperty("property");
+
+  memgraph::storage::Gid gid;
+  {
+    auto acc = storage.Access();
+    auto vertex = acc.CreateVertex().GetValue();
+    gid = vertex.Gid();
+    ASSERT_FALSE(vertex.SetProperty(property, memgraph::storage::PropertyValue(0)).HasError());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  auto reader = storage.ReadOnlyAccess();
+
+  for (int64_t i = 1; i <= 10; ++i) {
+    auto acc = storage.Access();
+    auto vertex = acc.FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_FALSE(vertex->SetProperty(property, memgraph::storage::PropertyValue(i)).HasError());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  {
+    auto acc = storage.Access();
+    auto vertex = acc.FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_FALSE(acc.DeleteVertex(&*vertex).HasError());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  // Wait for GC.
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  auto vertex = reader.FindVertex(gid, memgraph::storage::View::OLD);
+  ASSERT_TRUE(vertex);
+  auto value = vertex->GetProperty(property, memgraph::storage::View::OLD);
+  ASSERT_TRUE(value.HasValue());
+  EXPECT_EQ(*value, memgraph::storage::PropertyValue(0));
+  ASSERT_FALSE(reader.Commit().HasError());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  auto acc = storage.ReadOnlyAccess();
+  EXPECT_FALSE(acc.FindVertex(gid, memgraph::storage::View::OLD));
+}
@@ -43,7 +43,7 @@ class IndexTest : public testing::Test {
   LabelId label2;
 
   VertexAccessor CreateVertex(Storage::Accessor *accessor) {
-    VertexAccessor vertex = accessor->CreateVertex();
+    VertexAccessor vertex = accessor->CreateVertex().GetValue();
     MG_ASSERT(!vertex.SetProperty(prop_id, PropertyValue(vertex_id++)).HasError());
     return vertex;
   }
@@ -57,6 +57,16 @@ class IndexTest : public testing::Test {
     return ret;
   }
 
+  // Returns the ids of the destination vertices of the edges.
+  template <class TIterable>
+  std::vector<int64_t> GetEdgeIds(TIterable iterable, View view = View::OLD) {
+    std::vector<int64_t> ret;
+    for (auto edge : iterable) {
+      ret.push_back(edge.ToVertex().GetProperty(prop_id, view)->ValueInt());
+    }
+    return ret;
+  }
+
  private:
   int vertex_id;
 };
@@ -663,7 +673,7 @@ TEST_F(IndexTest, LabelPropertyIndexMixedIteration) {
   {
     auto acc = storage.Access();
     for (const auto &value : values) {
-      auto v = acc.CreateVertex();
+      auto v = acc.CreateVertex().GetValue();
       ASSERT_TRUE(v.AddLabel(label1).HasValue());
       ASSERT_TRUE(v.SetProperty(prop_val, value).HasValue());
     }
@@ -830,3 +840,272 @@ TEST_F(IndexTest, LabelPropertyIndexMixedIteration) {
   // Iteration without any bounds should return all items of the index.
   verify(std::nullopt, std::nullopt, values);
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, EdgeTypeIndexCreateAndDrop) {
+  auto edge_type1 = storage.NameToEdgeType("edge_type1");
+  auto edge_type2 = storage.NameToEdgeType("edge_type2");
+  {
+    auto acc = storage.Access();
+    auto from = CreateVertex(&acc);
+    for (int i = 0; i < 4; ++i) {
+      auto to = CreateVertex(&acc);
+      ASSERT_NO_ERROR(acc.CreateEdge(&from, &to, i % 2 ? edge_type1 : edge_type2));
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  EXPECT_TRUE(storage.CreateIndex(edge_type1));
+  EXPECT_FALSE(storage.CreateIndex(edge_type1));
+  EXPECT_THAT(storage.ListAllIndices().edge_type, UnorderedElementsAre(edge_type1));
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.EdgeTypeIndexExists(edge_type1));
+    EXPECT_FALSE(acc.EdgeTypeIndexExists(edge_type2));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), View::OLD), UnorderedElementsAre(2, 4));
+    EXPECT_EQ(acc.ApproximateEdgeCount(edge_type1), 2);
+  }
+
+  EXPECT_TRUE(storage.DropIndex(edge_type1));
+  EXPECT_FALSE(storage.DropIndex(edge_type1));
+  EXPECT_THAT(storage.ListAllIndices().edge_type, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, EdgeTypeIndexBasic) {
+  auto edge_type1 = storage.NameToEdgeType("edge_type1");
+  auto edge_type2 = storage.NameToEdgeType("edge_type2");
+  EXPECT_TRUE(storage.CreateIndex(edge_type1));
+
+  auto acc = storage.Access();
+  auto from = CreateVertex(&acc);
+  for (int i = 0; i < 6; ++i) {
+    auto to = CreateVertex(&acc);
+    ASSERT_NO_ERROR(acc.CreateEdge(&from, &to, i % 2 ? edge_type1 : edge_type2));
+  }
+
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), View::OLD), IsEmpty());
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::NEW), View::NEW), UnorderedElementsAre(2, 4, 6));
+
+  acc.AdvanceCommand();
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), View::OLD), UnorderedElementsAre(2, 4, 6));
+
+  // Delete one of the indexed edges and detach delete the endpoint of another.
+  for (auto edge : from.OutEdges(View::OLD, {edge_type1}).GetValue()) {
+    auto id = edge.ToVertex().GetProperty(prop_id, View::OLD)->ValueInt();
+    if (id == 2) {
+      ASSERT_NO_ERROR(acc.DeleteEdge(&edge));
+    } else if (id == 4) {
+      auto to = edge.ToVertex();
+      ASSERT_NO_ERROR(acc.DetachDeleteVertex(&to));
+    }
+  }
+
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), View::OLD), UnorderedElementsAre(2, 4, 6));
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::NEW), View::NEW), UnorderedElementsAre(6));
+
+  acc.AdvanceCommand();
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), View::OLD), UnorderedElementsAre(6));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, EdgeTypeIndexTransactionalIsolation) {
+  auto edge_type1 = storage.NameToEdgeType("edge_type1");
+  EXPECT_TRUE(storage.CreateIndex(edge_type1));
+
+  auto acc_before = storage.Access();
+  auto acc = storage.Access();
+  auto acc_after = storage.Access();
+
+  auto from = CreateVertex(&acc);
+  for (int i = 0; i < 3; ++i) {
+    auto to = CreateVertex(&acc);
+    ASSERT_NO_ERROR(acc.CreateEdge(&from, &to, edge_type1));
+  }
+
+  EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::NEW), View::NEW), UnorderedElementsAre(1, 2, 3));
+  EXPECT_THAT(GetEdgeIds(acc_before.Edges(edge_type1, View::NEW), View::NEW), IsEmpty());
+  EXPECT_THAT(GetEdgeIds(acc_after.Edges(edge_type1, View::NEW), View::NEW), IsEmpty());
+
+  ASSERT_NO_ERROR(acc.Commit());
+
+  auto acc_after_commit = storage.Access();
+
+  EXPECT_THAT(GetEdgeIds(acc_before.Edges(edge_type1, View::NEW), View::NEW), IsEmpty());
+  EXPECT_THAT(GetEdgeIds(acc_after.Edges(edge_type1, View::NEW), View::NEW), IsEmpty());
+  EXPECT_THAT(GetEdgeIds(acc_after_commit.Edges(edge_type1, View::NEW), View::NEW), UnorderedElementsAre(1, 2, 3));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelPropertiesIndexCreateAndDrop) {
+  const std::vector<PropertyId> properties{prop_id, prop_val};
+  EXPECT_TRUE(storage.CreateIndex(label1, properties));
+  EXPECT_FALSE(storage.CreateIndex(label1, properties));
+  // The order of the properties is a part of the index key.
+  EXPECT_TRUE(storage.CreateIndex(label1, std::vector<PropertyId>{prop_val, prop_id}));
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.LabelPropertiesIndexExists(label1, properties));
+    EXPECT_FALSE(acc.LabelPropertiesIndexExists(label2, properties));
+    EXPECT_EQ(acc.LabelPropertiesIndices(label1).size(), 2);
+  }
+  EXPECT_EQ(storage.ListAllIndices().label_properties.size(), 2);
+
+  EXPECT_TRUE(storage.DropIndex(label1, properties));
+  EXPECT_FALSE(storage.DropIndex(label1, properties));
+  EXPECT_TRUE(storage.DropIndex(label1, std::vector<PropertyId>{prop_val, prop_id}));
+  EXPECT_THAT(storage.ListAllIndices().label_properties, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelPropertiesIndexPrefixLookup) {
+  const std::vector<PropertyId> properties{prop_val, prop_id};
+  {
+    auto acc = storage.Access();
+    for (int i = 0; i < 10; ++i) {
+      auto vertex = CreateVertex(&acc);
+      ASSERT_NO_ERROR(vertex.AddLabel(i < 8 ? label1 : label2));
+      if (i != 0) {
+        ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(i % 2)));
+      }
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  // The index is created over the existing vertices. Vertex 0 doesn't have
+  // all of the properties and vertices 8 and 9 don't have the label.
+  EXPECT_TRUE(storage.CreateIndex(label1, properties));
+  {
+    auto acc = storage.Access();
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, View::OLD)),
+                UnorderedElementsAre(1, 2, 3, 4, 5, 6, 7));
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, View::OLD)),
+                UnorderedElementsAre(1, 3, 5, 7));
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(0), PropertyValue(4)}, View::OLD)),
+                UnorderedElementsAre(4));
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1), PropertyValue(4)}, View::OLD)),
+                IsEmpty());
+    EXPECT_EQ(acc.ApproximateVertexCount(label1, properties), 7);
+  }
+
+  // Changes are visible in the NEW view before they are committed.
+  {
+    auto acc = storage.Access();
+    for (auto vertex : acc.Vertices(View::OLD)) {
+      auto id = vertex.GetProperty(prop_id, View::OLD)->ValueInt();
+      if (id == 0) {
+        ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(1)));
+      } else if (id == 1) {
+        ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(0)));
+      } else if (id == 3) {
+        ASSERT_NO_ERROR(vertex.RemoveLabel(label1));
+      } else if (id == 8) {
+        ASSERT_NO_ERROR(vertex.AddLabel(label1));
+      }
+    }
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, View::OLD), View::OLD),
+                UnorderedElementsAre(1, 3, 5, 7));
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, View::NEW), View::NEW),
+                UnorderedElementsAre(0, 5, 7));
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(0)}, View::NEW), View::NEW),
+                UnorderedElementsAre(1, 2, 4, 6, 8));
+    acc.Abort();
+  }
+
+  {
+    auto acc = storage.Access();
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, View::NEW), View::NEW),
+                UnorderedElementsAre(1, 3, 5, 7));
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, TextIndexCreateAndDrop) {
+  EXPECT_TRUE(storage.CreateTextIndex(label1, prop_val));
+  EXPECT_FALSE(storage.CreateTextIndex(label1, prop_val));
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.TextIndexExists(label1, prop_val));
+    EXPECT_FALSE(acc.TextIndexExists(label2, prop_val));
+    EXPECT_FALSE(acc.TextIndexExists(label1, prop_id));
+  }
+  EXPECT_THAT(storage.ListAllIndices().text, UnorderedElementsAre(std::make_pair(label1, prop_val)));
+  // The text index is independent of the label+property index.
+  EXPECT_THAT(storage.ListAllIndices().label_property, IsEmpty());
+
+  EXPECT_TRUE(storage.DropTextIndex(label1, prop_val));
+  EXPECT_FALSE(storage.DropTextIndex(label1, prop_val));
+  EXPECT_THAT(storage.ListAllIndices().text, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, TextIndexCandidates) {
+  const std::vector<std::string> values{"memgraph", "graph", "paragraph", "grape", "gr", "photograph"};
+  {
+    auto acc = storage.Access();
+    for (const auto &value : values) {
+      auto vertex = CreateVertex(&acc);
+      ASSERT_NO_ERROR(vertex.AddLabel(label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(value)));
+    }
+    // Vertices without the label or with a non-string value aren't indexed.
+    auto vertex = CreateVertex(&acc);
+    ASSERT_NO_ERROR(vertex.AddLabel(label2));
+    ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue("graph")));
+    vertex = CreateVertex(&acc);
+    ASSERT_NO_ERROR(vertex.AddLabel(label1));
+    ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(42)));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  EXPECT_TRUE(storage.CreateTextIndex(label1, prop_val));
+  {
+    auto acc = storage.Access();
+    // The candidates are the vertices which contain the rarest trigram of
+    // the needle, so they are a superset of the actual matches.
+    auto candidates = GetIds(acc.TextVertices(label1, prop_val, "graph", View::OLD));
+    EXPECT_THAT(candidates, testing::IsSupersetOf({0, 1, 2, 5}));
+    EXPECT_THAT(candidates, testing::Not(testing::Contains(4)));
+    EXPECT_THAT(GetIds(acc.TextVertices(label1, prop_val, "xyz", View::OLD)), IsEmpty());
+    // Needles shorter than a trigram return all of the indexed vertices.
+    EXPECT_THAT(GetIds(acc.TextVertices(label1, prop_val, "gr", View::OLD)), UnorderedElementsAre(0, 1, 2, 3, 4, 5));
+    EXPECT_EQ(acc.ApproximateTextVertexCount(label1, prop_val), 6);
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, TextIndexTransactionalIsolation) {
+  EXPECT_TRUE(storage.CreateTextIndex(label1, prop_val));
+
+  auto acc_before = storage.Access();
+  auto acc = storage.Access();
+  auto acc_after = storage.Access();
+
+  for (int i = 0; i < 5; ++i) {
+    auto vertex = CreateVertex(&acc);
+    ASSERT_NO_ERROR(vertex.AddLabel(label1));
+    ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(i % 2 ? "odd value" : "even value")));
+  }
+
+  EXPECT_THAT(GetIds(acc.TextVertices(label1, prop_val, "odd", View::NEW), View::NEW), UnorderedElementsAre(1, 3));
+  EXPECT_THAT(GetIds(acc_before.TextVertices(label1, prop_val, "odd", View::NEW)), IsEmpty());
+  EXPECT_THAT(GetIds(acc_after.TextVertices(label1, prop_val, "odd", View::NEW)), IsEmpty());
+
+  ASSERT_NO_ERROR(acc.Commit());
+
+  auto acc_after_commit = storage.Access();
+  EXPECT_THAT(GetIds(acc_before.TextVertices(label1, prop_val, "odd", View::NEW)), IsEmpty());
+  EXPECT_THAT(GetIds(acc_after_commit.TextVertices(label1, prop_val, "odd", View::NEW), View::NEW),
+              UnorderedElementsAre(1, 3));
+
+  // Changing the value moves the vertex to the new trigrams.
+  for (auto vertex : acc_after_commit.Vertices(View::OLD)) {
+    if (vertex.GetProperty(prop_id, View::OLD)->ValueInt() == 1) {
+      ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue("even value")));
+    }
+  }
+  EXPECT_THAT(GetIds(acc_after_commit.TextVertices(label1, prop_val, "odd", View::NEW), View::NEW),
+              UnorderedElementsAre(3));
+  EXPECT_THAT(GetIds(acc_after_commit.TextVertices(label1, prop_val, "odd", View::OLD), View::OLD),
+              UnorderedElementsAre(1, 3));
+}
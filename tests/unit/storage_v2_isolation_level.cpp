@@ -69,7 +69,7 @@ TEST_P(StorageIsolationLevelTest, Visibility) {
           "(default isolation level = {}, override isolation level = {})",
           IsolationLevelToString(default_isolation_level), IsolationLevelToString(override_isolation_level)));
       for (size_t i = 1; i <= iteration_count; ++i) {
-        creator.CreateVertex();
+        creator.CreateVertex().GetValue();
 
         const auto check_vertices_count = [i](auto &accessor, const auto isolation_level) {
           const auto expected_count = isolation_level == memgraph::storage::IsolationLevel::READ_UNCOMMITTED ? i : 0;
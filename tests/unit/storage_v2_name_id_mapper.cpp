@@ -11,6 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "storage/v2/name_id_mapper.hpp"
 
 // NOLINTNEXTLINE(hicpp-special-member-functions)
@@ -45,3 +49,76 @@ TEST(NameIdMapper, Correctness) {
   ASSERT_EQ(mapper.IdToName(1), "n2");
   ASSERT_EQ(mapper.IdToName(0), "n1");
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(NameIdMapper, ManyNames) {
+  // Enough names to grow both the hash table and the ID to name array a few
+  // times.
+  constexpr uint64_t kNumNames = 10000;
+  memgraph::storage::NameIdMapper mapper;
+
+  for (uint64_t i = 0; i < kNumNames; ++i) {
+    ASSERT_EQ(mapper.NameToId("name" + std::to_string(i)), i);
+  }
+  for (uint64_t i = 0; i < kNumNames; ++i) {
+    ASSERT_EQ(mapper.NameToId("name" + std::to_string(i)), i);
+    ASSERT_EQ(mapper.IdToName(i), "name" + std::to_string(i));
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(NameIdMapper, SeparateMappers) {
+  // The cached lookups of one mapper mustn't be visible to another mapper,
+  // even if it's created at the same address.
+  for (int i = 0; i < 3; ++i) {
+    memgraph::storage::NameIdMapper mapper;
+    ASSERT_EQ(mapper.NameToId(std::to_string(i)), 0);
+    ASSERT_EQ(mapper.NameToId("n"), 1);
+    ASSERT_EQ(mapper.IdToName(1), "n");
+  }
+  memgraph::storage::NameIdMapper first;
+  memgraph::storage::NameIdMapper second;
+  ASSERT_EQ(first.NameToId("a"), 0);
+  ASSERT_EQ(second.NameToId("b"), 0);
+  ASSERT_EQ(second.NameToId("a"), 1);
+  ASSERT_EQ(first.NameToId("a"), 0);
+  ASSERT_EQ(first.IdToName(0), "a");
+  ASSERT_EQ(second.IdToName(0), "b");
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(NameIdMapper, Concurrent) {
+  constexpr auto kNumThreads = 8;
+  constexpr uint64_t kNumNames = 5000;
+  memgraph::storage::NameIdMapper mapper;
+
+  std::vector<std::vector<uint64_t>> ids(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kNumThreads; ++thread) {
+    threads.emplace_back([&, thread] {
+      for (uint64_t i = 0; i < kNumNames; ++i) {
+        // Every thread inserts the names in a different order.
+        const auto name = "name" + std::to_string((i * (thread + 1)) % kNumNames);
+        const auto id = mapper.NameToId(name);
+        ASSERT_EQ(mapper.IdToName(id), name);
+      }
+      for (uint64_t i = 0; i < kNumNames; ++i) {
+        ids[thread].push_back(mapper.NameToId("name" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int thread = 1; thread < kNumThreads; ++thread) {
+    ASSERT_EQ(ids[thread], ids[0]);
+  }
+  std::vector<bool> used(kNumNames, false);
+  for (uint64_t i = 0; i < kNumNames; ++i) {
+    ASSERT_LT(ids[0][i], kNumNames);
+    ASSERT_FALSE(used[ids[0][i]]);
+    used[ids[0][i]] = true;
+    ASSERT_EQ(mapper.IdToName(ids[0][i]), "name" + std::to_string(i));
+  }
+}
@@ -563,6 +563,31 @@ TEST(PropertyStore, IsPropertyEqualString) {
   ASSERT_FALSE(props.IsPropertyEqual(prop, memgraph::storage::PropertyValue("testt")));
 }
 
+TEST(PropertyStore, CompareProperty) {
+  memgraph::storage::PropertyStore props;
+  auto prop = memgraph::storage::PropertyId::FromInt(42);
+  auto other = memgraph::storage::PropertyId::FromInt(7);
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue(5)),
+            memgraph::storage::PropertyComparison::ABSENT);
+
+  ASSERT_TRUE(props.SetProperty(prop, memgraph::storage::PropertyValue(5)));
+  ASSERT_TRUE(props.SetProperty(other, memgraph::storage::PropertyValue("five")));
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue(5)),
+            memgraph::storage::PropertyComparison::EQUAL);
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue(5.0)),
+            memgraph::storage::PropertyComparison::EQUAL);
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue(6)),
+            memgraph::storage::PropertyComparison::UNEQUAL);
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue("five")),
+            memgraph::storage::PropertyComparison::UNEQUAL);
+  ASSERT_EQ(props.CompareProperty(memgraph::storage::PropertyId::FromInt(1), memgraph::storage::PropertyValue(5)),
+            memgraph::storage::PropertyComparison::ABSENT);
+
+  ASSERT_FALSE(props.SetProperty(prop, memgraph::storage::PropertyValue()));
+  ASSERT_EQ(props.CompareProperty(prop, memgraph::storage::PropertyValue(5)),
+            memgraph::storage::PropertyComparison::ABSENT);
+}
+
 TEST(PropertyStore, IsPropertyEqualList) {
   memgraph::storage::PropertyStore props;
   auto prop = memgraph::storage::PropertyId::FromInt(42);
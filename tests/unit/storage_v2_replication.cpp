@@ -69,7 +69,7 @@ TEST_F(ReplicationTest, BasicSynchronousReplicationTest) {
   std::optional<memgraph::storage::Gid> vertex_gid;
   {
     auto acc = main_store.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     ASSERT_TRUE(v.AddLabel(main_store.NameToLabel(vertex_label)).HasValue());
     ASSERT_TRUE(v.SetProperty(main_store.NameToProperty(vertex_property),
@@ -140,7 +140,7 @@ TEST_F(ReplicationTest, BasicSynchronousReplicationTest) {
   std::optional<memgraph::storage::Gid> edge_gid;
   {
     auto acc = main_store.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     auto edge = acc.CreateEdge(&v, &v, main_store.NameToEdgeType(edge_type));
     ASSERT_TRUE(edge.HasValue());
@@ -295,7 +295,7 @@ TEST_F(ReplicationTest, MultipleSynchronousReplicationTest) {
   std::optional<memgraph::storage::Gid> vertex_gid;
   {
     auto acc = main_store.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     ASSERT_TRUE(v.AddLabel(main_store.NameToLabel(vertex_label)).HasValue());
     ASSERT_TRUE(v.SetProperty(main_store.NameToProperty(vertex_property),
                               memgraph::storage::PropertyValue(vertex_property_value))
@@ -320,7 +320,7 @@ TEST_F(ReplicationTest, MultipleSynchronousReplicationTest) {
   main_store.UnregisterReplica("REPLICA2");
   {
     auto acc = main_store.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -356,7 +356,7 @@ TEST_F(ReplicationTest, RecoveryProcess) {
     {
       auto acc = main_store.Access();
       // Create the vertex before registering a replica
-      auto v = acc.CreateVertex();
+      auto v = acc.CreateVertex().GetValue();
       vertex_gids.emplace_back(v.Gid());
       ASSERT_FALSE(acc.Commit().HasError());
     }
@@ -372,13 +372,13 @@ TEST_F(ReplicationTest, RecoveryProcess) {
     // Create vertices in 2 different transactions
     {
       auto acc = main_store.Access();
-      auto v = acc.CreateVertex();
+      auto v = acc.CreateVertex().GetValue();
       vertex_gids.emplace_back(v.Gid());
       ASSERT_FALSE(acc.Commit().HasError());
     }
     {
       auto acc = main_store.Access();
-      auto v = acc.CreateVertex();
+      auto v = acc.CreateVertex().GetValue();
       vertex_gids.emplace_back(v.Gid());
       ASSERT_FALSE(acc.Commit().HasError());
     }
@@ -508,7 +508,7 @@ TEST_F(ReplicationTest, BasicAsynchronousReplicationTest) {
   std::vector<memgraph::storage::Gid> created_vertices;
   for (size_t i = 0; i < vertices_create_num; ++i) {
     auto acc = main_store.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     created_vertices.push_back(v.Gid());
     ASSERT_FALSE(acc.Commit().HasError());
 
@@ -571,7 +571,7 @@ TEST_F(ReplicationTest, EpochTest) {
   std::optional<memgraph::storage::Gid> vertex_gid;
   {
     auto acc = main_store.Access();
-    const auto v = acc.CreateVertex();
+    const auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -599,12 +599,12 @@ TEST_F(ReplicationTest, EpochTest) {
 
   {
     auto acc = main_store.Access();
-    acc.CreateVertex();
+    acc.CreateVertex().GetValue();
     ASSERT_FALSE(acc.Commit().HasError());
   }
   {
     auto acc = replica_store1.Access();
-    auto v = acc.CreateVertex();
+    auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     ASSERT_FALSE(acc.Commit().HasError());
   }
@@ -624,7 +624,7 @@ TEST_F(ReplicationTest, EpochTest) {
 
   {
     auto acc = main_store.Access();
-    const auto v = acc.CreateVertex();
+    const auto v = acc.CreateVertex().GetValue();
     vertex_gid.emplace(v.Gid());
     ASSERT_FALSE(acc.Commit().HasError());
   }
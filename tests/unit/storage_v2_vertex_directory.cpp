@@ -0,0 +1,171 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "storage/v2/vertex_directory.hpp"
+
+using memgraph::storage::Gid;
+using memgraph::storage::Vertex;
+using memgraph::storage::VertexDirectory;
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VertexDirectory, Basic) {
+  VertexDirectory directory;
+  Vertex first{Gid::FromUint(0), nullptr};
+  Vertex second{Gid::FromUint(1), nullptr};
+
+  ASSERT_EQ(directory.Find(Gid::FromUint(0)), nullptr);
+  ASSERT_EQ(directory.MemoryUsage(), 0);
+
+  directory.Insert(first.gid, &first);
+  directory.Insert(second.gid, &second);
+  ASSERT_EQ(directory.Find(Gid::FromUint(0)), &first);
+  ASSERT_EQ(directory.Find(Gid::FromUint(1)), &second);
+  ASSERT_EQ(directory.Find(Gid::FromUint(2)), nullptr);
+  ASSERT_GT(directory.MemoryUsage(), 0);
+
+  directory.Remove(first.gid);
+  ASSERT_EQ(directory.Find(Gid::FromUint(0)), nullptr);
+  ASSERT_EQ(directory.Find(Gid::FromUint(1)), &second);
+
+  // Removing a GID from a page that doesn't exist is a no-op.
+  directory.Remove(Gid::FromUint(1000000));
+
+  directory.Clear();
+  ASSERT_EQ(directory.Find(Gid::FromUint(1)), nullptr);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VertexDirectory, SparseGids) {
+  VertexDirectory directory;
+  std::vector<Vertex> vertices;
+  for (uint64_t shift = 0; shift < 32; ++shift) {
+    vertices.emplace_back(Gid::FromUint(uint64_t{1} << shift), nullptr);
+  }
+  for (auto &vertex : vertices) {
+    directory.Insert(vertex.gid, &vertex);
+  }
+  for (auto &vertex : vertices) {
+    ASSERT_EQ(directory.Find(vertex.gid), &vertex);
+    ASSERT_EQ(directory.Find(Gid::FromUint(vertex.gid.AsUint() + 5)), nullptr);
+  }
+  ASSERT_EQ(directory.Find(Gid::FromUint(0)), nullptr);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VertexDirectory, Rebuild) {
+  VertexDirectory directory;
+  memgraph::storage::VerticesContainer vertices;
+  {
+    auto acc = vertices.access();
+    for (uint64_t i = 0; i < 10000; i += 3) {
+      acc.insert(Vertex{Gid::FromUint(i), nullptr});
+    }
+  }
+  Vertex stale{Gid::FromUint(1), nullptr};
+  directory.Insert(stale.gid, &stale);
+
+  directory.Rebuild(&vertices);
+  auto acc = vertices.access();
+  for (uint64_t i = 0; i < 10000; ++i) {
+    auto it = acc.find(Gid::FromUint(i));
+    if (it == acc.end()) {
+      ASSERT_EQ(directory.Find(Gid::FromUint(i)), nullptr);
+    } else {
+      ASSERT_EQ(directory.Find(Gid::FromUint(i)), &*it);
+    }
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VertexDirectory, UnlinkEmptyPages) {
+  // Number of GIDs that are covered by a single page.
+  constexpr uint64_t kPageSize = 4096;
+  VertexDirectory directory;
+  std::vector<Vertex> vertices;
+  vertices.reserve(3 * kPageSize);
+  for (uint64_t i = 0; i < 3 * kPageSize; ++i) {
+    vertices.emplace_back(Gid::FromUint(i), nullptr);
+    directory.Insert(vertices.back().gid, &vertices.back());
+  }
+  const auto full_usage = directory.MemoryUsage();
+  ASSERT_TRUE(directory.UnlinkEmptyPages(3 * kPageSize).empty());
+
+  // The first page is empty, the second one still has a vertex.
+  for (uint64_t i = 0; i < 2 * kPageSize - 1; ++i) {
+    directory.Remove(vertices[i].gid);
+  }
+  auto unlinked = directory.UnlinkEmptyPages(3 * kPageSize);
+  ASSERT_EQ(unlinked.size(), 1);
+  ASSERT_EQ(directory.MemoryUsage(), full_usage - sizeof(VertexDirectory::Page));
+  ASSERT_EQ(directory.Find(Gid::FromUint(0)), nullptr);
+  ASSERT_EQ(directory.Find(Gid::FromUint(2 * kPageSize - 1)), &vertices[2 * kPageSize - 1]);
+  ASSERT_TRUE(directory.UnlinkEmptyPages(3 * kPageSize).empty());
+
+  // The last page isn't unlinked while new vertices could still be inserted
+  // into it.
+  for (uint64_t i = 2 * kPageSize - 1; i < 3 * kPageSize; ++i) {
+    directory.Remove(vertices[i].gid);
+  }
+  ASSERT_EQ(directory.UnlinkEmptyPages(3 * kPageSize - 1).size(), 1);
+  ASSERT_EQ(directory.UnlinkEmptyPages(3 * kPageSize).size(), 1);
+  ASSERT_EQ(directory.MemoryUsage(), full_usage - 3 * sizeof(VertexDirectory::Page));
+
+  // An unlinked page is allocated again if a vertex is inserted into it.
+  directory.Insert(vertices[5].gid, &vertices[5]);
+  ASSERT_EQ(directory.Find(vertices[5].gid), &vertices[5]);
+  ASSERT_EQ(directory.MemoryUsage(), full_usage - 2 * sizeof(VertexDirectory::Page));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(VertexDirectory, Concurrent) {
+  constexpr uint64_t kNumThreads = 4;
+  constexpr uint64_t kNumVertices = 100000;
+  VertexDirectory directory;
+  std::vector<Vertex> vertices;
+  vertices.reserve(kNumVertices);
+  for (uint64_t i = 0; i < kNumVertices; ++i) {
+    vertices.emplace_back(Gid::FromUint(i), nullptr);
+  }
+
+  std::atomic<bool> done{false};
+  std::thread reader([&] {
+    while (!done.load()) {
+      for (uint64_t i = 0; i < kNumVertices; i += 997) {
+        auto *vertex = directory.Find(Gid::FromUint(i));
+        ASSERT_TRUE(vertex == nullptr || vertex == &vertices[i]);
+      }
+    }
+  });
+  std::vector<std::thread> writers;
+  for (uint64_t thread = 0; thread < kNumThreads; ++thread) {
+    writers.emplace_back([&, thread] {
+      for (uint64_t i = thread; i < kNumVertices; i += kNumThreads) {
+        directory.Insert(vertices[i].gid, &vertices[i]);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  done.store(true);
+  reader.join();
+
+  for (uint64_t i = 0; i < kNumVertices; ++i) {
+    ASSERT_EQ(directory.Find(Gid::FromUint(i)), &vertices[i]);
+  }
+}
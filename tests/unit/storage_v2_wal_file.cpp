@@ -46,6 +46,18 @@ memgraph::storage::durability::WalDeltaData::Type StorageGlobalOperationToWalDel
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTIES_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTIES_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::TEXT_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::TEXT_INDEX_DROP;
   }
 }
 
@@ -200,12 +212,26 @@ class DeltaGenerator final {
 
   void AppendOperation(memgraph::storage::durability::StorageGlobalOperation operation, const std::string &label,
                        const std::set<std::string> properties = {}) {
-    auto label_id = memgraph::storage::LabelId::FromUint(mapper_.NameToId(label));
-    std::set<memgraph::storage::PropertyId> property_ids;
-    for (const auto &property : properties) {
-      property_ids.insert(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+    if (operation == memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE ||
+        operation == memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP) {
+      auto edge_type_id = memgraph::storage::EdgeTypeId::FromUint(mapper_.NameToId(label));
+      wal_file_.AppendOperation(operation, edge_type_id, timestamp_);
+    } else if (operation == memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE ||
+               operation == memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP) {
+      auto label_id = memgraph::storage::LabelId::FromUint(mapper_.NameToId(label));
+      std::vector<memgraph::storage::PropertyId> property_ids;
+      for (const auto &property : properties) {
+        property_ids.push_back(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+      }
+      wal_file_.AppendOperation(operation, label_id, property_ids, timestamp_);
+    } else {
+      auto label_id = memgraph::storage::LabelId::FromUint(mapper_.NameToId(label));
+      std::set<memgraph::storage::PropertyId> property_ids;
+      for (const auto &property : properties) {
+        property_ids.insert(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+      }
+      wal_file_.AppendOperation(operation, label_id, property_ids, timestamp_);
     }
-    wal_file_.AppendOperation(operation, label_id, property_ids, timestamp_);
     if (valid_) {
       UpdateStats(timestamp_, 1);
       memgraph::storage::durability::WalDeltaData data;
@@ -217,6 +243,8 @@ class DeltaGenerator final {
           break;
         case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE:
         case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP:
+        case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::TEXT_INDEX_DROP:
         case memgraph::storage::durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP:
           data.operation_label_property.label = label;
@@ -225,6 +253,16 @@ class DeltaGenerator final {
         case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
           data.operation_label_properties.label = label;
           data.operation_label_properties.properties = properties;
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+          data.operation_edge_type.edge_type = label;
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTIES_INDEX_DROP:
+          data.operation_label_property_list.label = label;
+          data.operation_label_property_list.properties = {properties.begin(), properties.end()};
+          break;
       }
       data_.emplace_back(timestamp_, data);
     }
@@ -232,6 +270,8 @@ class DeltaGenerator final {
 
   uint64_t GetPosition() { return wal_file_.GetSize(); }
 
+  void FinalizeWal() { wal_file_.FinalizeWal(); }
+
   memgraph::storage::durability::WalInfo GetInfo() {
     return {.offset_metadata = 0,
             .offset_deltas = 0,
@@ -299,9 +339,7 @@ void AssertWalInfoEqual(const memgraph::storage::durability::WalInfo &a,
 
 void AssertWalDataEqual(const DeltaGenerator::DataT &data, const std::filesystem::path &path) {
   auto info = memgraph::storage::durability::ReadWalInfo(path);
-  memgraph::storage::durability::Decoder wal;
-  wal.Initialize(path, memgraph::storage::durability::kWalMagic);
-  wal.SetPosition(info.offset_deltas);
+  memgraph::storage::durability::WalDeltaDecoder wal(path, info);
   DeltaGenerator::DataT current;
   for (uint64_t i = 0; i < info.num_deltas; ++i) {
     auto timestamp = memgraph::storage::durability::ReadWalDeltaHeader(&wal);
@@ -514,6 +552,12 @@ GENERATE_SIMPLE_TEST(AllGlobalOperations, {
   OPERATION(EXISTENCE_CONSTRAINT_DROP, "hello", {"world"});
   OPERATION(UNIQUE_CONSTRAINT_CREATE, "hello", {"world", "and", "universe"});
   OPERATION(UNIQUE_CONSTRAINT_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(EDGE_TYPE_INDEX_CREATE, "hello");
+  OPERATION(EDGE_TYPE_INDEX_DROP, "hello");
+  OPERATION(LABEL_PROPERTIES_INDEX_CREATE, "hello", {"world", "and", "universe"});
+  OPERATION(LABEL_PROPERTIES_INDEX_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(TEXT_INDEX_CREATE, "hello", {"world"});
+  OPERATION(TEXT_INDEX_DROP, "hello", {"world"});
 });
 
 // NOLINTNEXTLINE(hicpp-special-member-functions)
@@ -525,6 +569,70 @@ GENERATE_SIMPLE_TEST(InvalidTransactionOrdering, {
   TRANSACTION(true, { tx.CreateVertex(); });
 });
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(WalFileTest, Compression) {
+  memgraph::storage::durability::WalInfo info;
+  DeltaGenerator::DataT data;
+
+  {
+    DeltaGenerator gen(storage_directory, GetParam(), 5);
+    for (int i = 0; i < 1000; ++i) {
+      TRANSACTION(true, {
+        auto vertex1 = tx.CreateVertex();
+        auto vertex2 = tx.CreateVertex();
+        tx.AddLabel(vertex1, "test");
+        tx.SetProperty(vertex2, "hello", memgraph::storage::PropertyValue(std::string(100, 'x')));
+      });
+    }
+    OPERATION(LABEL_INDEX_CREATE, "test");
+    info = gen.GetInfo();
+    data = gen.GetData();
+    gen.FinalizeWal();
+  }
+
+  auto wal_files = GetFilesList();
+  ASSERT_EQ(wal_files.size(), 1);
+  ASSERT_FALSE(memgraph::storage::durability::ReadWalInfo(wal_files.front()).compressed);
+
+  memgraph::utils::FileRetainer file_retainer;
+  ASSERT_TRUE(memgraph::storage::durability::CompressWalFile(wal_files.front(), &file_retainer));
+  ASSERT_EQ(GetFilesList(), wal_files);
+  auto read_info = memgraph::storage::durability::ReadWalInfo(wal_files.front());
+  ASSERT_TRUE(read_info.compressed);
+  AssertWalInfoEqual(info, read_info);
+  AssertWalDataEqual(data, wal_files.front());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(WalFileTest, CompressionFailureKeepsFile) {
+  DeltaGenerator::DataT data;
+  {
+    DeltaGenerator gen(storage_directory, GetParam(), 5);
+    TRANSACTION(true, { tx.CreateVertex(); });
+    data = gen.GetData();
+    gen.FinalizeWal();
+  }
+
+  auto wal_files = GetFilesList();
+  ASSERT_EQ(wal_files.size(), 1);
+  auto size = std::filesystem::file_size(wal_files.front());
+
+  // A file that isn't a WAL file can't be compressed and is left untouched.
+  auto invalid_path = storage_directory / "invalid";
+  memgraph::utils::CopyFile(wal_files.front(), invalid_path);
+  std::filesystem::resize_file(invalid_path, 10);
+
+  memgraph::utils::FileRetainer file_retainer;
+  ASSERT_FALSE(memgraph::storage::durability::CompressWalFile(invalid_path, &file_retainer));
+  ASSERT_EQ(std::filesystem::file_size(invalid_path), 10);
+  ASSERT_FALSE(memgraph::storage::durability::CompressWalFile(storage_directory / "missing", &file_retainer));
+  ASSERT_EQ(GetFilesList().size(), 2);
+
+  ASSERT_EQ(std::filesystem::file_size(wal_files.front()), size);
+  ASSERT_FALSE(memgraph::storage::durability::ReadWalInfo(wal_files.front()).compressed);
+  AssertWalDataEqual(data, wal_files.front());
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(WalFileTest, InvalidMarker) {
   memgraph::storage::durability::WalInfo info;
@@ -9,6 +9,10 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <sys/stat.h>
+
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "utils/csv_parsing.hpp"
@@ -330,4 +334,171 @@ TEST_P(CsvReaderTest, EmptyColumns) {
   }
 }
 
+TEST_P(CsvReaderTest, RowsAcrossBlockBoundaries) {
+  // create a file that is larger than a single tokenizer block, with fields
+  // that are wider than the SIMD stride and quoted fields that contain
+  // delimiters and escaped quotes;
+  // parser should return all rows unchanged
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam());
+
+  memgraph::utils::MemoryResource *mem(memgraph::utils::NewDeleteResource());
+
+  const memgraph::utils::pmr::string delimiter{"::", mem};
+  const memgraph::utils::pmr::string quote{"'", mem};
+
+  const std::string wide(100, 'x');
+  const uint64_t num_rows = 20000;
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    writer.WriteLine(
+        CreateRow({std::to_string(i), wide, "'a::b''" + std::to_string(i) + "'", "", "tail"}, delimiter));
+  }
+
+  writer.Close();
+
+  const bool with_header = false;
+  const bool ignore_bad = false;
+  const memgraph::csv::Reader::Config cfg{with_header, ignore_bad, delimiter, quote};
+  auto reader = memgraph::csv::Reader(filepath, cfg);
+
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    const auto parsed_row = reader.GetNextRow(mem);
+    ASSERT_TRUE(parsed_row.has_value());
+    ASSERT_EQ(*parsed_row, ToPmrColumns({std::to_string(i), wide, "a::b'" + std::to_string(i), "", "tail"}));
+  }
+  ASSERT_FALSE(reader.GetNextRow(mem).has_value());
+}
+
+TEST_P(CsvReaderTest, TokenizerStartsFromOffset) {
+  // create a file and start tokenizing it from the beginning of the second
+  // line;
+  // tokenizer should return the rows after the offset and track the position
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam());
+
+  const std::string first_line = "A,B,C";
+  writer.WriteLine(first_line);
+  writer.WriteLine("D,\"E\"\"F\",G");
+  writer.Close();
+
+  const auto newline_size = std::string_view(GetParam()).size();
+  memgraph::csv::Tokenizer tokenizer(filepath, ",", "\"", first_line.size() + newline_size);
+  std::vector<std::string_view> fields;
+
+  auto result = tokenizer.ReadRow(&fields);
+  ASSERT_FALSE(result.HasError());
+  ASSERT_TRUE(*result);
+  ASSERT_EQ(fields, (std::vector<std::string_view>{"D", "E\"F", "G"}));
+  ASSERT_EQ(tokenizer.Position(), std::filesystem::file_size(filepath));
+
+  result = tokenizer.ReadRow(&fields);
+  ASSERT_FALSE(result.HasError());
+  ASSERT_FALSE(*result);
+}
+
+TEST_P(CsvReaderTest, CarriageReturnsInUnquotedFields) {
+  // create a file with carriage returns inside an unquoted and a quoted field;
+  // LOAD CSV should keep the ones inside unquoted fields while the tokenizer
+  // drops all of them by default
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam());
+  writer.WriteLine("A\rB,\"Q\rR\",C");
+  writer.Close();
+
+  memgraph::utils::MemoryResource *mem(memgraph::utils::NewDeleteResource());
+
+  const memgraph::utils::pmr::string delimiter{",", mem};
+  const memgraph::utils::pmr::string quote{"\"", mem};
+
+  const bool with_header = false;
+  const bool ignore_bad = false;
+  const memgraph::csv::Reader::Config cfg{with_header, ignore_bad, delimiter, quote};
+  auto reader = memgraph::csv::Reader(filepath, cfg);
+
+  const auto parsed_row = reader.GetNextRow(mem);
+  ASSERT_TRUE(parsed_row.has_value());
+  ASSERT_EQ(*parsed_row, ToPmrColumns({"A\rB", "QR", "C"}));
+  ASSERT_FALSE(reader.GetNextRow(mem).has_value());
+
+  memgraph::csv::Tokenizer tokenizer(filepath, ",", "\"");
+  std::vector<std::string_view> fields;
+  auto result = tokenizer.ReadRow(&fields);
+  ASSERT_FALSE(result.HasError());
+  ASSERT_TRUE(*result);
+  ASSERT_EQ(fields, (std::vector<std::string_view>{"AB", "QR", "C"}));
+}
+
+TEST_P(CsvReaderTest, ReadFromFifo) {
+  // write the rows into a FIFO from another thread;
+  // parser should read the FIFO until the writer closes it
+  const auto filepath = csv_directory / "bla.csv";
+  ASSERT_EQ(mkfifo(filepath.c_str(), 0600), 0);
+
+  const uint64_t num_rows = 20000;
+  std::thread writer_thread([&] {
+    auto writer = FileWriter(filepath, GetParam());
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      writer.WriteLine(CreateRow({std::to_string(i), "a", "b"}, ","));
+    }
+    writer.Close();
+  });
+
+  memgraph::utils::MemoryResource *mem(memgraph::utils::NewDeleteResource());
+
+  const memgraph::utils::pmr::string delimiter{",", mem};
+  const memgraph::utils::pmr::string quote{"\"", mem};
+
+  const bool with_header = false;
+  const bool ignore_bad = false;
+  const memgraph::csv::Reader::Config cfg{with_header, ignore_bad, delimiter, quote};
+  auto reader = memgraph::csv::Reader(filepath, cfg);
+
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    const auto parsed_row = reader.GetNextRow(mem);
+    ASSERT_TRUE(parsed_row.has_value());
+    ASSERT_EQ(*parsed_row, ToPmrColumns({std::to_string(i), "a", "b"}));
+  }
+  ASSERT_FALSE(reader.GetNextRow(mem).has_value());
+  writer_thread.join();
+}
+
+TEST_P(CsvReaderTest, FileTruncatedWhileReading) {
+  // create a file that is larger than a single tokenizer block and truncate it
+  // after the first row is read;
+  // tokenizer should return the rows that are left in the file
+  const auto filepath = csv_directory / "bla.csv";
+  auto writer = FileWriter(filepath, GetParam());
+
+  const auto newline_size = std::string_view(GetParam()).size();
+  const std::string wide(100, 'x');
+  const uint64_t num_rows = 20000;
+  const uint64_t kept_rows = 15000;
+  uint64_t kept_size = 0;
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    const auto row = CreateRow({std::to_string(i), wide}, ",");
+    writer.WriteLine(row);
+    if (i < kept_rows) kept_size += row.size() + newline_size;
+  }
+  writer.Close();
+
+  memgraph::csv::Tokenizer tokenizer(filepath, ",", "\"");
+  std::vector<std::string_view> fields;
+  auto result = tokenizer.ReadRow(&fields);
+  ASSERT_FALSE(result.HasError());
+  ASSERT_TRUE(*result);
+  ASSERT_GT(kept_size, tokenizer.Position());
+  std::filesystem::resize_file(filepath, kept_size);
+
+  uint64_t rows = 1;
+  while (true) {
+    result = tokenizer.ReadRow(&fields);
+    ASSERT_FALSE(result.HasError());
+    if (!*result) break;
+    ASSERT_EQ(fields, (std::vector<std::string_view>{std::to_string(rows), wide}));
+    ++rows;
+  }
+  ASSERT_EQ(rows, kept_rows);
+  ASSERT_EQ(tokenizer.Position(), kept_size);
+}
+
 INSTANTIATE_TEST_CASE_P(NewlineParameterizedTest, CsvReaderTest, ::testing::Values("\n", "\r\n"));
@@ -16,6 +16,7 @@
 #include <thread>
 #include <vector>
 
+#include <fmt/format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -364,3 +365,48 @@ TEST_F(UtilsFileTest, ConcurrentReadingAndWritting) {
                        [](const auto read_count) { return read_count == number_of_writes; });
   }));
 }
+
+TEST_F(UtilsFileTest, OutputFileIoUring) {
+  const auto file_path = storage / "existing_dir_777" / "existing_file_777";
+  std::string expected;
+  {
+    memgraph::utils::OutputFile handle;
+    handle.Open(file_path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING,
+                memgraph::utils::OutputFile::IoBackend::IO_URING);
+    // Write more than the internal buffer so that it is flushed a few times.
+    for (size_t i = 0; i < 3 * memgraph::utils::kFileBufferSize / 10; ++i) {
+      auto data = fmt::format("{:09}\n", i);
+      handle.Write(data);
+      expected += data;
+      if (i % 10000 == 0) handle.Sync();
+    }
+    ASSERT_EQ(handle.GetSize(), expected.size());
+
+    // Positions are tracked in the same way as with the regular system calls.
+    auto end = handle.GetPosition();
+    ASSERT_EQ(end, expected.size());
+    handle.SetPosition(memgraph::utils::OutputFile::Position::SET, 0);
+    handle.Write("X");
+    expected[0] = 'X';
+    handle.SetPosition(memgraph::utils::OutputFile::Position::SET, end);
+
+    // Moving the file registers the buffer of the new object.
+    memgraph::utils::OutputFile moved(std::move(handle));
+    moved.Write("end");
+    expected += "end";
+    moved.Sync();
+    moved.Close();
+  }
+  {
+    memgraph::utils::OutputFile handle;
+    handle.Open(file_path, memgraph::utils::OutputFile::Mode::APPEND_TO_EXISTING,
+                memgraph::utils::OutputFile::IoBackend::IO_URING);
+    handle.Write("appended");
+    expected += "appended";
+    handle.Close();
+  }
+
+  std::ifstream stream(file_path);
+  std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(content, expected);
+}
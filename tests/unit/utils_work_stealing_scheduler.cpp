@@ -0,0 +1,251 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "utils/work_stealing_scheduler.hpp"
+
+using namespace std::chrono_literals;
+using memgraph::utils::TaskClass;
+using memgraph::utils::WorkStealingScheduler;
+
+namespace {
+
+void WaitForTasks(const WorkStealingScheduler &scheduler) {
+  while (scheduler.UnfinishedTasksNum() != 0) {
+    std::this_thread::sleep_for(10ms);
+  }
+}
+
+// Runs a task that calls the checkpoint until `done` is set.
+void RunUntil(const std::atomic<bool> &done) {
+  while (!done.load()) {
+    WorkStealingScheduler::Checkpoint();
+    std::this_thread::sleep_for(10us);
+  }
+}
+
+}  // namespace
+
+TEST(WorkStealingScheduler, Basic) {
+  static constexpr size_t adder_count = 500000;
+  static constexpr std::array<size_t, 4> workers_counts{1, 2, 4, 8};
+
+  for (const auto workers_count : workers_counts) {
+    WorkStealingScheduler scheduler{workers_count, 1, 1s};
+
+    std::atomic<size_t> count{0};
+    for (size_t i = 0; i < adder_count; ++i) {
+      scheduler.Schedule([&] { count.fetch_add(1); });
+    }
+    WaitForTasks(scheduler);
+
+    ASSERT_EQ(count.load(), adder_count);
+  }
+}
+
+TEST(WorkStealingScheduler, Stealing) {
+  // The first task blocks its worker, so the tasks that were queued behind it
+  // have to be stolen by the other worker.
+  WorkStealingScheduler scheduler{2, 1, 1h};
+  std::atomic<bool> release{false};
+  std::atomic<size_t> count{0};
+  scheduler.Schedule([&] {
+    while (!release.load()) std::this_thread::sleep_for(1ms);
+  });
+  for (size_t i = 0; i < 100; ++i) {
+    scheduler.Schedule([&] { count.fetch_add(1); });
+  }
+
+  while (count.load() != 100) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(scheduler.UnfinishedTasksNum(), 1);
+  release.store(true);
+  WaitForTasks(scheduler);
+}
+
+TEST(WorkStealingScheduler, ShortTasksProgressWhileLongTasksRun) {
+  // Both workers get a task that is demoted to a long one, and the short
+  // tasks are still executed on both slots.
+  WorkStealingScheduler scheduler{2, 2, 1ms};
+  std::atomic<bool> done{false};
+  std::atomic<size_t> long_tasks{0};
+  for (size_t i = 0; i < 2; ++i) {
+    scheduler.Schedule([&] {
+      RunUntil(done);
+      if (WorkStealingScheduler::CurrentTaskClass() == TaskClass::LONG) long_tasks.fetch_add(1);
+    });
+  }
+  while (scheduler.LongTasksNum() != 2) std::this_thread::sleep_for(1ms);
+
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 1000; ++i) {
+    scheduler.Schedule([&] {
+      ASSERT_EQ(WorkStealingScheduler::CurrentTaskClass(), TaskClass::SHORT);
+      count.fetch_add(1);
+    });
+  }
+  while (count.load() != 1000) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(scheduler.UnfinishedTasksNum(), 2);
+
+  done.store(true);
+  WaitForTasks(scheduler);
+  ASSERT_EQ(long_tasks.load(), 2);
+  ASSERT_EQ(scheduler.LongTasksNum(), 0);
+}
+
+TEST(WorkStealingScheduler, LongTasksLimit) {
+  // Only one long task can run at a time, so the second task waits in the
+  // checkpoint and is demoted only after the first one finishes.
+  WorkStealingScheduler scheduler{2, 1, 1ms};
+  std::atomic<bool> first_done{false};
+  std::atomic<bool> first_finished{false};
+  std::atomic<bool> second_finished{false};
+  scheduler.Schedule([&] {
+    RunUntil(first_done);
+    first_finished.store(true);
+  });
+  while (scheduler.LongTasksNum() != 1) std::this_thread::sleep_for(1ms);
+  scheduler.Schedule([&] {
+    while (WorkStealingScheduler::CurrentTaskClass() != TaskClass::LONG) {
+      WorkStealingScheduler::Checkpoint();
+      std::this_thread::sleep_for(10us);
+    }
+    second_finished.store(true);
+  });
+
+  std::this_thread::sleep_for(100ms);
+  ASSERT_FALSE(second_finished.load());
+  ASSERT_EQ(scheduler.LongTasksNum(), 1);
+
+  first_done.store(true);
+  WaitForTasks(scheduler);
+  ASSERT_TRUE(first_finished.load());
+  ASSERT_TRUE(second_finished.load());
+}
+
+TEST(WorkStealingScheduler, ShortTasksProgressOverLongTasksLimit) {
+  // As many tasks become long as there are workers and long tasks together.
+  // The ones over the limit give up their worker slots and stop running until
+  // the long task finishes, so the short tasks still get the workers.
+  static constexpr size_t workers_count = 2;
+  static constexpr size_t max_long_tasks = 1;
+  static constexpr size_t heavy_tasks = workers_count + max_long_tasks;
+  WorkStealingScheduler scheduler{workers_count, max_long_tasks, 1ms};
+  std::atomic<bool> done{false};
+  std::array<std::atomic<size_t>, heavy_tasks> progress{};
+  for (auto &task_progress : progress) {
+    scheduler.Schedule([&] {
+      while (!done.load()) {
+        task_progress.fetch_add(1);
+        WorkStealingScheduler::Checkpoint();
+        std::this_thread::sleep_for(10us);
+      }
+    });
+  }
+  while (scheduler.LongTasksNum() != max_long_tasks || scheduler.WaitingTasksNum() != heavy_tasks - max_long_tasks) {
+    std::this_thread::sleep_for(1ms);
+  }
+
+  std::array<size_t, heavy_tasks> before{};
+  for (size_t i = 0; i < heavy_tasks; ++i) before[i] = progress[i].load();
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 1000; ++i) {
+    scheduler.Schedule([&] { count.fetch_add(1); });
+  }
+  while (count.load() != 1000) std::this_thread::sleep_for(1ms);
+  std::this_thread::sleep_for(50ms);
+  size_t running = 0;
+  for (size_t i = 0; i < heavy_tasks; ++i) {
+    if (progress[i].load() != before[i]) ++running;
+  }
+  ASSERT_EQ(running, max_long_tasks);
+  ASSERT_LE(scheduler.ThreadsNum(), workers_count + heavy_tasks);
+
+  done.store(true);
+  WaitForTasks(scheduler);
+  ASSERT_EQ(scheduler.LongTasksNum(), 0);
+  ASSERT_EQ(scheduler.WaitingTasksNum(), 0);
+}
+
+TEST(WorkStealingScheduler, ThreadsAreBounded) {
+  static constexpr size_t workers_count = 2;
+  static constexpr size_t max_long_tasks = 2;
+  WorkStealingScheduler scheduler{workers_count, max_long_tasks, 1ms};
+  ASSERT_EQ(scheduler.ThreadsNum(), workers_count);
+
+  for (size_t round = 0; round < 3; ++round) {
+    // More tasks become long than are allowed to run. The rest waits and only
+    // keeps the thread it waits on.
+    std::atomic<bool> done{false};
+    for (size_t i = 0; i < 8; ++i) {
+      scheduler.Schedule([&] { RunUntil(done); });
+    }
+    while (scheduler.LongTasksNum() != max_long_tasks) std::this_thread::sleep_for(1ms);
+    std::this_thread::sleep_for(50ms);
+    ASSERT_EQ(scheduler.LongTasksNum(), max_long_tasks);
+    ASSERT_LE(scheduler.ThreadsNum(), workers_count + max_long_tasks + scheduler.WaitingTasksNum());
+
+    done.store(true);
+    WaitForTasks(scheduler);
+    // The threads of the finished long tasks exit.
+    while (scheduler.ThreadsNum() != workers_count) std::this_thread::sleep_for(1ms);
+  }
+}
+
+TEST(WorkStealingScheduler, ParkedTasks) {
+  // The parked tasks don't hold the worker and aren't counted as long tasks.
+  // After they resume, they take the worker back from the short tasks.
+  WorkStealingScheduler scheduler{1, 1, 1h};
+  std::atomic<bool> release{false};
+  std::atomic<size_t> resumed{0};
+  for (size_t i = 0; i < 3; ++i) {
+    scheduler.Schedule([&] {
+      ASSERT_TRUE(WorkStealingScheduler::Park());
+      while (!release.load()) std::this_thread::sleep_for(1ms);
+      WorkStealingScheduler::Unpark();
+      ASSERT_EQ(WorkStealingScheduler::CurrentTaskClass(), TaskClass::SHORT);
+      resumed.fetch_add(1);
+    });
+  }
+  while (scheduler.ParkedTasksNum() != 3) std::this_thread::sleep_for(1ms);
+  ASSERT_EQ(scheduler.LongTasksNum(), 0);
+
+  std::atomic<size_t> count{0};
+  for (size_t i = 0; i < 100; ++i) {
+    scheduler.Schedule([&] { count.fetch_add(1); });
+  }
+  while (count.load() != 100) std::this_thread::sleep_for(1ms);
+
+  release.store(true);
+  WaitForTasks(scheduler);
+  ASSERT_EQ(resumed.load(), 3);
+  ASSERT_EQ(scheduler.ParkedTasksNum(), 0);
+  // The threads of the resumed tasks exit.
+  while (scheduler.ThreadsNum() != 1) std::this_thread::sleep_for(1ms);
+}
+
+TEST(WorkStealingScheduler, ParkOutsideOfScheduler) {
+  ASSERT_TRUE(WorkStealingScheduler::Park());
+  WorkStealingScheduler::Unpark();
+}
+
+TEST(WorkStealingScheduler, CheckpointOutsideOfScheduler) {
+  for (size_t i = 0; i < 1000; ++i) {
+    WorkStealingScheduler::Checkpoint();
+  }
+  ASSERT_EQ(WorkStealingScheduler::CurrentTaskClass(), TaskClass::SHORT);
+}